@@ -37,6 +37,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CvodeAdaptor.hpp"
 #include "Exception.hpp"
 
+CHASTE_THREAD_LOCAL AbstractCellCycleModelOdeSolver::InstanceMap* AbstractCellCycleModelOdeSolver::mpThreadInstances = NULL;
+
 AbstractCellCycleModelOdeSolver::AbstractCellCycleModelOdeSolver()
     : mSizeOfOdeSystem(UNSIGNED_UNSET)
 {
@@ -46,6 +48,22 @@ AbstractCellCycleModelOdeSolver::~AbstractCellCycleModelOdeSolver()
 {
 }
 
+AbstractCellCycleModelOdeSolver::InstanceMap* AbstractCellCycleModelOdeSolver::SetThreadInstanceLocation(InstanceMap* pInstances)
+{
+    InstanceMap* p_previous_instances = mpThreadInstances;
+    mpThreadInstances = pInstances;
+    return p_previous_instances;
+}
+
+boost::shared_ptr<void>* AbstractCellCycleModelOdeSolver::GetThreadInstanceEntry(const void* pKey)
+{
+    if (mpThreadInstances == NULL)
+    {
+        return NULL;
+    }
+    return &((*mpThreadInstances)[pKey]);
+}
+
 void AbstractCellCycleModelOdeSolver::Reset()
 {
 }
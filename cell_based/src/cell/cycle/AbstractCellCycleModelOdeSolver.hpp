@@ -40,9 +40,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ClassIsAbstract.hpp"
 #include <boost/serialization/base_object.hpp>
 
+#include <map>
 #include <boost/shared_ptr.hpp>
 
 #include "AbstractIvpOdeSolver.hpp"
+#include "ChasteThreadLocal.hpp"
 
 /**
  * This provides a wrapper around any ODE solver class, exposing roughly the same interface,
@@ -52,11 +54,31 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * The recommended way to use this wrapper is via the CellCycleModelOdeSolver subclass, which
  * is templated over cell-cycle model class and ODE solver class, providing a singleton
  * instance for each combination of template parameters.
+ *
+ * A thread may keep its own set of these instances in place of the shared ones by
+ * calling SetThreadInstanceLocation(); this is how each SimulationContext gets its
+ * own ODE solvers, so that simulations running on different threads do not share
+ * solver working memory.
  */
 class AbstractCellCycleModelOdeSolver
 {
+public:
+
+    /**
+     * A set of instances of CellCycleModelOdeSolver classes. Each class's entry is keyed
+     * by the address of its shared instance pointer, and points to a boost::shared_ptr
+     * to that class.
+     */
+    typedef std::map<const void*, boost::shared_ptr<void> > InstanceMap;
+
 private:
 
+    /**
+     * If not NULL, the set of instances used by this thread in place of the
+     * shared instances.
+     */
+    static CHASTE_THREAD_LOCAL InstanceMap* mpThreadInstances;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -80,6 +102,14 @@ protected:
     /** The size of the ODE system to be solved. */
     unsigned mSizeOfOdeSystem;
 
+    /**
+     * @return the entry for a CellCycleModelOdeSolver class in the set of instances used
+     * by the calling thread, or NULL if the thread uses the shared instances.
+     *
+     * @param pKey the address of the class's shared instance pointer
+     */
+    static boost::shared_ptr<void>* GetThreadInstanceEntry(const void* pKey);
+
 public:
 
     /**
@@ -92,6 +122,16 @@ public:
      */
     virtual ~AbstractCellCycleModelOdeSolver();
 
+    /**
+     * Make the calling thread use the given set of instances in place of those it
+     * currently uses. Instances are added to the set as they are first requested.
+     *
+     * @param pInstances the set of instances to use, or NULL to use the shared instances
+     * @return the set of instances used by the thread before this call (NULL if the
+     *     shared instances were in use)
+     */
+    static InstanceMap* SetThreadInstanceLocation(InstanceMap* pInstances);
+
     /**
      * @return whether the instance in existence and fully set up.
      *
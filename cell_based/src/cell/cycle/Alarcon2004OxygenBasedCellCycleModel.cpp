@@ -106,7 +106,8 @@ void Alarcon2004OxygenBasedCellCycleModel::Initialise()
 void Alarcon2004OxygenBasedCellCycleModel::AdjustOdeParameters(double currentTime)
 {
     // Pass this time step's oxygen concentration into the solver as a constant over this time step
-    mpOdeSystem->rGetStateVariables()[5] = mpCell->GetCellData()->GetItem("oxygen");
+    static const CellDataKey oxygen_key("oxygen");
+    mpOdeSystem->rGetStateVariables()[5] = mpCell->GetCellData()->GetItem(oxygen_key);
 
     // Use whether the cell is currently labelled as another input
     bool is_labelled = mpCell->HasCellProperty<CellLabel>();
@@ -36,6 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef CELLCYCLEMODELODESOLVER_HPP_
 #define CELLCYCLEMODELODESOLVER_HPP_
 
+#include <pthread.h>
 #include <boost/utility.hpp>
 
 #include "ChasteSerialization.hpp"
@@ -52,15 +53,24 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *   mpOdeSolver = CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::Instance();
  *
  * This class contains all the machinery to make it a singleton, hence providing
- * exactly one instance per pair of values of the template parameters.
+ * exactly one instance per pair of values of the template parameters, or one per
+ * pair for each SimulationContext (see AbstractCellCycleModelOdeSolver::SetThreadInstanceLocation).
  */
 template <class CELL_CYCLE_MODEL, class ODE_SOLVER>
 class CellCycleModelOdeSolver : public AbstractCellCycleModelOdeSolver, private boost::noncopyable
 {
 private:
-    /** The single instance of this class, for this ODE_SOLVER. */
+    /**
+     * The single instance of this class, for this ODE_SOLVER, shared by all threads
+     * that have not called SetThreadInstanceLocation().
+     */
     static boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> > mpInstance;
 
+    /**
+     * @return a reference to the pointer to the instance used by the calling thread.
+     */
+    static boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> >& rGetInstancePointer();
+
     /** Default constructor. Not user accessible; to obtain an instance of this class use the Instance method. */
     CellCycleModelOdeSolver();
 
@@ -76,7 +86,7 @@ private:
     void serialize(Archive & archive, const unsigned int version)
     {
         archive & boost::serialization::base_object<AbstractCellCycleModelOdeSolver>(*this);
-        archive & mpInstance;
+        archive & rGetInstancePointer();
     }
 
 public:
@@ -117,14 +127,35 @@ CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::CellCycleModelOdeSolver()
      */
 }
 
+template<class CELL_CYCLE_MODEL, class ODE_SOLVER>
+boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> >& CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::rGetInstancePointer()
+{
+    boost::shared_ptr<void>* p_entry = GetThreadInstanceEntry(&mpInstance);
+    if (p_entry == NULL)
+    {
+        return mpInstance;
+    }
+    if (!(*p_entry))
+    {
+        p_entry->reset(new boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> >);
+    }
+    return *static_cast<boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> >*>(p_entry->get());
+}
+
 template<class CELL_CYCLE_MODEL, class ODE_SOLVER>
 boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> > CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>::Instance()
 {
-    if (!mpInstance)
+    // The shared instance may be requested from several threads at once
+    static pthread_mutex_t instance_mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_mutex_lock(&instance_mutex);
+    boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> >& rp_instance = rGetInstancePointer();
+    if (!rp_instance)
     {
-        mpInstance.reset(new CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>);
+        rp_instance.reset(new CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER>);
     }
-    return mpInstance;
+    boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, ODE_SOLVER> > p_instance = rp_instance;
+    pthread_mutex_unlock(&instance_mutex);
+    return p_instance;
 }
 
 template<class CELL_CYCLE_MODEL, class ODE_SOLVER>
@@ -163,9 +194,17 @@ template<class CELL_CYCLE_MODEL>
 class CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> : public AbstractCellCycleModelOdeSolver, private boost::noncopyable
 {
 private:
-    /** The single instance of this class, for this ODE_SOLVER. */
+    /**
+     * The single instance of this class, for this ODE_SOLVER, shared by all threads
+     * that have not called SetThreadInstanceLocation().
+     */
     static boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> > mpInstance;
 
+    /**
+     * @return a reference to the pointer to the instance used by the calling thread.
+     */
+    static boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> >& rGetInstancePointer();
+
     /** Default constructor. Not user accessible; to obtain an instance of this class use the Instance method. */
     CellCycleModelOdeSolver();
 
@@ -181,7 +220,7 @@ private:
     void serialize(Archive & archive, const unsigned int version)
     {
         archive & boost::serialization::base_object<AbstractCellCycleModelOdeSolver>(*this);
-        archive & mpInstance;
+        archive & rGetInstancePointer();
     }
 
 public:
@@ -207,14 +246,35 @@ CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::CellCycleM
 {
 }
 
+template<class CELL_CYCLE_MODEL>
+boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> >& CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::rGetInstancePointer()
+{
+    boost::shared_ptr<void>* p_entry = GetThreadInstanceEntry(&mpInstance);
+    if (p_entry == NULL)
+    {
+        return mpInstance;
+    }
+    if (!(*p_entry))
+    {
+        p_entry->reset(new boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> >);
+    }
+    return *static_cast<boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> >*>(p_entry->get());
+}
+
 template<class CELL_CYCLE_MODEL>
 boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> > CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>::Instance()
 {
-    if (!mpInstance)
+    // The shared instance may be requested from several threads at once
+    static pthread_mutex_t instance_mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_mutex_lock(&instance_mutex);
+    boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> >& rp_instance = rGetInstancePointer();
+    if (!rp_instance)
     {
-        mpInstance.reset(new CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>);
+        rp_instance.reset(new CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver>);
     }
-    return mpInstance;
+    boost::shared_ptr<CellCycleModelOdeSolver<CELL_CYCLE_MODEL, BackwardEulerIvpOdeSolver> > p_instance = rp_instance;
+    pthread_mutex_unlock(&instance_mutex);
+    return p_instance;
 }
 
 template<class CELL_CYCLE_MODEL>
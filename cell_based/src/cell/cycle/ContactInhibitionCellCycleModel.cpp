@@ -77,7 +77,8 @@ void ContactInhibitionCellCycleModel::UpdateCellCyclePhase()
     }
 
     // Get cell volume
-    double cell_volume = mpCell->GetCellData()->GetItem("volume");
+    static const CellDataKey volume_key("volume");
+    double cell_volume = mpCell->GetCellData()->GetItem(volume_key);
 
     // Removes the cell label
     mpCell->RemoveCellProperty<CellLabel>();
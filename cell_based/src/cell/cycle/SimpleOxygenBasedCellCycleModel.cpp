@@ -69,7 +69,8 @@ void SimpleOxygenBasedCellCycleModel::UpdateCellCyclePhase()
         UpdateHypoxicDuration();
 
         // Get cell's oxygen concentration
-        double oxygen_concentration = mpCell->GetCellData()->GetItem("oxygen");
+        static const CellDataKey oxygen_key("oxygen");
+        double oxygen_concentration = mpCell->GetCellData()->GetItem(oxygen_key);
 
         AbstractSimplePhaseBasedCellCycleModel::UpdateCellCyclePhase();
 
@@ -121,7 +122,8 @@ void SimpleOxygenBasedCellCycleModel::UpdateHypoxicDuration()
     assert(!mpCell->HasApoptosisBegun());
 
     // Get cell's oxygen concentration
-    double oxygen_concentration = mpCell->GetCellData()->GetItem("oxygen");
+    static const CellDataKey oxygen_key("oxygen");
+    double oxygen_concentration = mpCell->GetCellData()->GetItem(oxygen_key);
 
     if (oxygen_concentration < mHypoxicConcentration)
     {
@@ -34,12 +34,15 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "AbstractCellProperty.hpp"
+#include "CellPropertyRegistry.hpp"
 #include "Exception.hpp"
 
 #include <typeinfo>
+#include <climits>
 
 AbstractCellProperty::AbstractCellProperty()
-    : mCellCount(0)
+    : mCellCount(0),
+      mTypeId(UINT_MAX)
 {
 }
 
@@ -59,6 +62,15 @@ bool AbstractCellProperty::IsSame(boost::shared_ptr<const AbstractCellProperty>
     return IsSame(pOther.get());
 }
 
+unsigned AbstractCellProperty::GetTypeId() const
+{
+    if (mTypeId == UINT_MAX)
+    {
+        mTypeId = CellPropertyRegistry::GetTypeId(typeid(*this));
+    }
+    return mTypeId;
+}
+
 void AbstractCellProperty::IncrementCellCount()
 {
     mCellCount++;
@@ -55,6 +55,12 @@ private:
      */
     unsigned mCellCount;
 
+    /**
+     * The type ID of this property's run-time class, allocated by CellPropertyRegistry.
+     * Looked up on the first call to GetTypeId() and not archived.
+     */
+    mutable unsigned mTypeId;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -126,6 +132,13 @@ public:
      */
     bool IsSame(boost::shared_ptr<const AbstractCellProperty> pOther) const;
 
+    /**
+     * @return the type ID of this property's exact run-time class, as allocated by
+     * CellPropertyRegistry::GetTypeId(). Two properties have the same type ID if
+     * and only if IsSame() is true for them.
+     */
+    unsigned GetTypeId() const;
+
     /**
      * Increment #mCellCount.
      */
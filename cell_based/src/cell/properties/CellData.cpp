@@ -34,6 +34,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "CellData.hpp"
+#include <algorithm>
+
+CellData::CellData()
+    : mNumItems(0)
+{
+}
 
 CellData::~CellData()
 {
@@ -41,39 +47,84 @@ CellData::~CellData()
 
 void CellData::SetItem(const std::string& rVariableName, double data)
 {
-    mCellData[rVariableName] = data;
+    SetItem(CellDataKey(rVariableName), data);
 }
 
 double CellData::GetItem(const std::string& rVariableName) const
 {
     /*
-     * Note that mCellData[rVariableName] is not const. If rVariableName is not
-     * a key, then mCellData[rVariableName] will create a new item in the map
-     * and increase the size by one.  Using a const_iterator ensures that the
-     * map remains const.
+     * Note that constructing a CellDataKey would intern rVariableName. We avoid
+     * this here so that asking for an item that is not stored has no side effects.
      */
-    std::map<std::string, double>::const_iterator it = mCellData.find(rVariableName);
-    if (it == mCellData.end())
+    unsigned index;
+    if (!CellDataKey::FindIndex(rVariableName, index) || index >= mCellData.size() || !mIsItemStored[index])
     {
         EXCEPTION("The item " << rVariableName << " is not stored");
     }
-    return(it->second);
+    return mCellData[index];
+}
+
+void CellData::SetItem(const CellDataKey& rKey, double data)
+{
+    unsigned index = rKey.GetIndex();
+    if (index >= mCellData.size())
+    {
+        // Make room for every key interned so far, to avoid resizing again for each new item
+        unsigned new_size = std::max(index + 1, CellDataKey::GetNumKeys());
+        mCellData.resize(new_size, 0.0);
+        mIsItemStored.resize(new_size, false);
+    }
+    if (!mIsItemStored[index])
+    {
+        mIsItemStored[index] = true;
+        mNumItems++;
+    }
+    mCellData[index] = data;
+}
+
+double CellData::GetItem(const CellDataKey& rKey) const
+{
+    unsigned index = rKey.GetIndex();
+    if (index >= mCellData.size() || !mIsItemStored[index])
+    {
+        EXCEPTION("The item " << rKey.rGetName() << " is not stored");
+    }
+    return mCellData[index];
 }
 
 unsigned CellData::GetNumItems() const
 {
-    return mCellData.size();
+    return mNumItems;
+}
+
+unsigned CellData::GetKeySignature() const
+{
+    // FNV-1a hash of the stored indices, without sorting or looking up the names of the keys
+    unsigned signature = 2166136261u;
+    for (unsigned index=0; index<mCellData.size(); index++)
+    {
+        if (mIsItemStored[index])
+        {
+            signature = (signature ^ index)*16777619u;
+        }
+    }
+    return signature;
 }
 
 std::vector<std::string> CellData::GetKeys() const
 {
     std::vector<std::string> keys;
-    for (std::map<std::string, double>::const_iterator it = mCellData.begin(); it != mCellData.end(); ++it)
+    keys.reserve(mNumItems);
+    for (unsigned index=0; index<mCellData.size(); index++)
     {
-        keys.push_back(it->first);
+        if (mIsItemStored[index])
+        {
+            keys.push_back(CellDataKey::rGetNameOfIndex(index));
+        }
     }
 
-    // From STL documentation we assume that the iterator is returning sorted keys sort(keys.begin(), keys.end());
+    // Keys are interned in the order they are first used, so sort them into lexicographical/alphabetic order
+    std::sort(keys.begin(), keys.end());
     return keys;
 }
 
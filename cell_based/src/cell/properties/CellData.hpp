@@ -45,6 +45,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/split_member.hpp>
+#include "CellDataKey.hpp"
 #include "Exception.hpp"
 
 /**
@@ -56,33 +58,83 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  * Within the Cell constructor, an empty CellData object is created and passed to the Cell
  * (unless there is already a CellData object present in mCellPropertyCollection).
+ *
+ * Items are stored in a dense array indexed by CellDataKey, so code that accesses the same
+ * item for many cells should construct a CellDataKey once and use the overloaded GetItem()
+ * and SetItem() methods, rather than looking up the item by name for each cell.
  */
 class CellData : public AbstractCellProperty
 {
 private:
 
     /**
-     * The cell data.
+     * The cell data, indexed by CellDataKey::GetIndex(). May be shorter than the
+     * number of interned keys, in which case the remaining items are not stored.
      */
-    std::map<std::string, double> mCellData;
+    std::vector<double> mCellData;
+
+    /** Whether each entry of mCellData has been set. */
+    std::vector<bool> mIsItemStored;
+
+    /** The number of items that have been set. */
+    unsigned mNumItems;
 
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
-     * Archive the member variables.
+     * Archive the member variables. Items are archived by name, as a map, so that
+     * archives do not depend on the order in which names are interned.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void save(Archive & archive, const unsigned int version) const
+    {
+        archive & boost::serialization::base_object<AbstractCellProperty>(*this);
+
+        std::map<std::string, double> cell_data;
+        for (unsigned index=0; index<mCellData.size(); index++)
+        {
+            if (mIsItemStored[index])
+            {
+                cell_data[CellDataKey::rGetNameOfIndex(index)] = mCellData[index];
+            }
+        }
+        archive & cell_data;
+    }
+
+    /**
+     * Load the member variables.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void load(Archive & archive, const unsigned int version)
     {
         archive & boost::serialization::base_object<AbstractCellProperty>(*this);
-        archive & mCellData;
+
+        std::map<std::string, double> cell_data;
+        archive & cell_data;
+
+        mCellData.clear();
+        mIsItemStored.clear();
+        mNumItems = 0;
+        for (std::map<std::string, double>::const_iterator it = cell_data.begin(); it != cell_data.end(); ++it)
+        {
+            SetItem(it->first, it->second);
+        }
     }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
 
 public:
 
+    /**
+     * Default constructor.
+     */
+    CellData();
+
     /**
      * We need the empty virtual destructor in this class to ensure Boost
      * serialization works correctly with static libraries.
@@ -105,11 +157,34 @@ public:
      */
     double GetItem(const std::string& rVariableName) const;
 
+    /**
+     * This assigns the cell data, without looking up the name of the item.
+     *
+     * @param rKey the key of the data to be set.
+     * @param data the value to set it to.
+     */
+    void SetItem(const CellDataKey& rKey, double data);
+
+    /**
+     * @return data, without looking up the name of the item.
+     *
+     * @param rKey the key of the data required.
+     * throws if the item has not been stored
+     */
+    double GetItem(const CellDataKey& rKey) const;
+
     /**
      * @return number of data items
      */
     unsigned GetNumItems() const;
 
+    /**
+     * @return a hash of the CellDataKey indices of the items stored, which almost certainly
+     * differs between different sets of keys. The indices, and hence the hash, are only
+     * meaningful within one process.
+     */
+    unsigned GetKeySignature() const;
+
     /**
      * @return all keys.
      *
@@ -0,0 +1,112 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "CellDataKey.hpp"
+#include <cassert>
+#include <pthread.h>
+
+/** Guards the interned names, which are shared by all threads */
+static pthread_mutex_t cell_data_keys_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+std::map<std::string, unsigned>& CellDataKey::rGetIndices()
+{
+    static std::map<std::string, unsigned> indices;
+    return indices;
+}
+
+std::deque<std::string>& CellDataKey::rGetNames()
+{
+    static std::deque<std::string> names;
+    return names;
+}
+
+CellDataKey::CellDataKey(const std::string& rName)
+{
+    pthread_mutex_lock(&cell_data_keys_mutex);
+    std::map<std::string, unsigned>& r_indices = rGetIndices();
+    std::map<std::string, unsigned>::iterator it = r_indices.find(rName);
+    if (it == r_indices.end())
+    {
+        mIndex = rGetNames().size();
+        r_indices[rName] = mIndex;
+        rGetNames().push_back(rName);
+    }
+    else
+    {
+        mIndex = it->second;
+    }
+    pthread_mutex_unlock(&cell_data_keys_mutex);
+}
+
+unsigned CellDataKey::GetIndex() const
+{
+    return mIndex;
+}
+
+const std::string& CellDataKey::rGetName() const
+{
+    return rGetNameOfIndex(mIndex);
+}
+
+bool CellDataKey::FindIndex(const std::string& rName, unsigned& rIndex)
+{
+    pthread_mutex_lock(&cell_data_keys_mutex);
+    std::map<std::string, unsigned>::const_iterator it = rGetIndices().find(rName);
+    bool found = (it != rGetIndices().end());
+    if (found)
+    {
+        rIndex = it->second;
+    }
+    pthread_mutex_unlock(&cell_data_keys_mutex);
+    return found;
+}
+
+const std::string& CellDataKey::rGetNameOfIndex(unsigned index)
+{
+    pthread_mutex_lock(&cell_data_keys_mutex);
+    assert(index < rGetNames().size());
+    const std::string& r_name = rGetNames()[index];
+    pthread_mutex_unlock(&cell_data_keys_mutex);
+    return r_name;
+}
+
+unsigned CellDataKey::GetNumKeys()
+{
+    pthread_mutex_lock(&cell_data_keys_mutex);
+    unsigned num_keys = rGetNames().size();
+    pthread_mutex_unlock(&cell_data_keys_mutex);
+    return num_keys;
+}
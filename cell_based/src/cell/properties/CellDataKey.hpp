@@ -0,0 +1,117 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef CELLDATAKEY_HPP_
+#define CELLDATAKEY_HPP_
+
+#include <deque>
+#include <map>
+#include <string>
+
+/**
+ * A handle to a named item of CellData.
+ *
+ * Each distinct name is interned, the first time it is used, to a small integer
+ * index that is shared by all cells. CellData stores its values in a dense array
+ * indexed in this way, so that a CellDataKey constructed once (for example outside
+ * a loop over cells) gives constant-time access to the item for every cell without
+ * comparing any strings.
+ *
+ * The mapping from names to indices lasts for the lifetime of the program and is
+ * not archived; CellData archives its items by name. It is shared by all threads,
+ * and is only accessed under a lock, so keys should be constructed once rather
+ * than in loops over cells.
+ */
+class CellDataKey
+{
+private:
+
+    /** The index to which the name of this item is interned. */
+    unsigned mIndex;
+
+    /**
+     * @return the map from each interned name to its index. This is a function-local
+     * static so that keys may safely be constructed during static initialisation.
+     */
+    static std::map<std::string, unsigned>& rGetIndices();
+
+    /**
+     * @return the interned names, in order of index. A deque is used so that
+     * references to names remain valid as further names are interned.
+     */
+    static std::deque<std::string>& rGetNames();
+
+public:
+
+    /**
+     * Constructor. Interns the name if it has not been used before.
+     *
+     * @param rName the name of the item
+     */
+    explicit CellDataKey(const std::string& rName);
+
+    /**
+     * @return the index to which the name of this item is interned
+     */
+    unsigned GetIndex() const;
+
+    /**
+     * @return the name of this item
+     */
+    const std::string& rGetName() const;
+
+    /**
+     * Look up the index of a name without interning it.
+     *
+     * @param rName the name of an item
+     * @param rIndex set to the index of the name, if it has been interned
+     * @return whether the name has been interned
+     */
+    static bool FindIndex(const std::string& rName, unsigned& rIndex);
+
+    /**
+     * @param index the index of an interned name
+     * @return the name
+     */
+    static const std::string& rGetNameOfIndex(unsigned index);
+
+    /**
+     * @return the number of names interned so far
+     */
+    static unsigned GetNumKeys();
+};
+
+#endif /* CELLDATAKEY_HPP_ */
@@ -37,6 +37,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 unsigned CellId::mMaxCellId = 0;
 
+CHASTE_THREAD_LOCAL unsigned* CellId::mpThreadMaxCellId = NULL;
+
 
 CellId::CellId()
     : AbstractCellProperty()
@@ -50,8 +52,9 @@ CellId::~CellId()
 
 void CellId::AssignCellId()
 {
-    mCellId = PetscTools::GetNumProcs() * mMaxCellId + PetscTools::GetMyRank();
-    mMaxCellId++;
+    unsigned& r_max_cell_id = rGetMaxCellId();
+    mCellId = PetscTools::GetNumProcs() * r_max_cell_id + PetscTools::GetMyRank();
+    r_max_cell_id++;
 }
 
 unsigned CellId::GetCellId() const
@@ -69,12 +72,24 @@ unsigned CellId::GetMaxCellId() const
     {
         EXCEPTION("AssignCellId must be called before using the CellID");
     }
-    return mMaxCellId;
+    return rGetMaxCellId();
 }
 
 void CellId::ResetMaxCellId()
 {
-    mMaxCellId = 0;
+    rGetMaxCellId() = 0;
+}
+
+unsigned& CellId::rGetMaxCellId()
+{
+    return (mpThreadMaxCellId == NULL) ? mMaxCellId : *mpThreadMaxCellId;
+}
+
+unsigned* CellId::SetThreadMaxCellIdLocation(unsigned* pMaxCellId)
+{
+    unsigned* p_previous_max_cell_id = mpThreadMaxCellId;
+    mpThreadMaxCellId = pMaxCellId;
+    return p_previous_max_cell_id;
 }
 
 #include "SerializationExportWrapperForCpp.hpp"
@@ -42,6 +42,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/base_object.hpp>
 #include "Exception.hpp"
 #include "PetscTools.hpp"
+#include "ChasteThreadLocal.hpp"
 
 class CellId;
 
@@ -63,9 +64,17 @@ private:
      */
     unsigned mCellId;
 
-    /** maximum cell identifier. */
+    /** maximum cell identifier, shared by all threads that have not called SetThreadMaxCellIdLocation(). */
     static unsigned mMaxCellId;
 
+    /** If not NULL, the location of the maximum cell identifier used by this thread in place of mMaxCellId. */
+    static CHASTE_THREAD_LOCAL unsigned* mpThreadMaxCellId;
+
+    /**
+     * @return a reference to the maximum cell identifier used by the calling thread.
+     */
+    static unsigned& rGetMaxCellId();
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -81,7 +90,8 @@ private:
         archive & mCellId;
         if (!PetscTools::IsParallel()) // This is to avoid changing the static i.d. in parallel simulations
         {
-            archive & mMaxCellId;
+            unsigned& r_max_cell_id = rGetMaxCellId();
+            archive & r_max_cell_id;
         }
     }
 
@@ -101,7 +111,7 @@ public:
 
     /**
      * This assigns the cell id to be the maximum current cell id.
-     * It then increments mMaxCellId.
+     * It then increments the maximum cell id.
      */
     void AssignCellId();
 
@@ -119,6 +129,17 @@ public:
      * Reset the maximum cell id to zero.
      */
     static void ResetMaxCellId();
+
+    /**
+     * Make the calling thread use the maximum cell id stored at the given location,
+     * instead of the shared one. This allows several simulations to be run at once
+     * in one process, each numbering its cells from zero; see SimulationContext.
+     *
+     * @param pMaxCellId the location of this thread's maximum cell id, or NULL to
+     *     use the shared one again
+     * @return the location previously used by this thread, or NULL
+     */
+    static unsigned* SetThreadMaxCellIdLocation(unsigned* pMaxCellId);
 };
 
 #include "SerializationExportWrapper.hpp"
@@ -36,7 +36,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellPropertyCollection.hpp"
 
 CellPropertyCollection::CellPropertyCollection()
-    : mpCellPropertyRegistry(NULL)
+    : mHasUncachedTypes(false),
+      mpCellPropertyRegistry(NULL)
 {
 }
 
@@ -65,6 +66,7 @@ void CellPropertyCollection::AddProperty(const boost::shared_ptr<AbstractCellPro
         EXCEPTION("That property object is already in the collection.");
     }
     mProperties.insert(rProp);
+    SetTypeBit(rProp->GetTypeId());
 }
 
 bool CellPropertyCollection::HasProperty(const boost::shared_ptr<AbstractCellProperty>& rProp) const
@@ -82,6 +84,7 @@ void CellPropertyCollection::RemoveProperty(const boost::shared_ptr<AbstractCell
     else
     {
         mProperties.erase(it);
+        UpdateTypeBits();
     }
 }
 
@@ -111,3 +114,25 @@ boost::shared_ptr<AbstractCellProperty> CellPropertyCollection::GetProperty() co
         EXCEPTION("Can only call GetProperty on a collection of size 1.");
     }
 }
+
+void CellPropertyCollection::UpdateTypeBits()
+{
+    mTypeBits.reset();
+    mHasUncachedTypes = false;
+    for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
+    {
+        SetTypeBit((*it)->GetTypeId());
+    }
+}
+
+void CellPropertyCollection::SetTypeBit(unsigned typeId)
+{
+    if (typeId < CellPropertyRegistry::MAX_NUM_CACHED_TYPE_IDS)
+    {
+        mTypeBits.set(typeId);
+    }
+    else
+    {
+        mHasUncachedTypes = true;
+    }
+}
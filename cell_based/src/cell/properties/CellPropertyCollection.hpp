@@ -36,21 +36,29 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef CELLPROPERTYCOLLECTION_HPP_
 #define CELLPROPERTYCOLLECTION_HPP_
 
+#include <bitset>
 #include <set>
 #include <boost/shared_ptr.hpp>
 
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/set.hpp>
+#include <boost/serialization/split_member.hpp>
 
 #include "AbstractCellProperty.hpp"
 #include "CellPropertyRegistry.hpp"
+#include "ChasteThreadLocal.hpp"
 #include "Exception.hpp"
 
 /**
  * Cell property collection class.
  *
  * Contains methods for accessing and interrogating a set of cell properties.
+ *
+ * Alongside the set of properties, the collection keeps a bitset recording which
+ * property types (as numbered by CellPropertyRegistry::GetTypeId()) it contains,
+ * so that asking whether a cell has a property of a given type does not need to
+ * search the set.
  */
 class CellPropertyCollection
 {
@@ -64,27 +72,123 @@ private:
     /** Type of an iterator over the container */
     typedef CollectionType::iterator IteratorType;
 
+    /** Type of a bitset over cell property type IDs */
+    typedef std::bitset<CellPropertyRegistry::MAX_NUM_CACHED_TYPE_IDS> TypeBitsetType;
+
     /** The properties stored in this collection. */
     CollectionType mProperties;
 
+    /**
+     * Which property types this collection contains, indexed by type ID.
+     * Not archived, as it is rebuilt from #mProperties on loading.
+     */
+    TypeBitsetType mTypeBits;
+
+    /**
+     * Whether this collection contains a property whose type ID is too large to
+     * be recorded in #mTypeBits.
+     */
+    bool mHasUncachedTypes;
+
     /** Cell property registry. */
     CellPropertyRegistry* mpCellPropertyRegistry;
 
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
-     * Save/load our member variables.
+     * Save our member variables.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void save(Archive & archive, const unsigned int version) const
     {
         archive & mProperties;
         // archive & mpCellPropertyRegistry; Not required as archived by the CellPopulation.
     }
 
+    /**
+     * Load our member variables, and rebuild #mTypeBits.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void load(Archive & archive, const unsigned int version)
+    {
+        archive & mProperties;
+        UpdateTypeBits();
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+    /**
+     * Recompute #mTypeBits and #mHasUncachedTypes from #mProperties.
+     */
+    void UpdateTypeBits();
+
+    /**
+     * Record that the collection contains a property with the given type ID.
+     *
+     * @param typeId  the type ID
+     */
+    void SetTypeBit(unsigned typeId);
+
+    /**
+     * @return whether the given property is an instance of BASECLASS or any of its
+     * subclasses.
+     *
+     * The answer depends only on the property's type, so it is remembered for each
+     * cached type ID, and the dynamic_cast in AbstractCellProperty::IsSubType() is
+     * done at most once per property type for each BASECLASS on each thread.
+     *
+     * @param rProp  the property
+     * @param rKnownTypes  the type IDs for which the answer has been remembered
+     * @param rSubTypes  the type IDs for which the answer is true
+     */
+    template<typename BASECLASS>
+    static bool IsSubType(const boost::shared_ptr<AbstractCellProperty>& rProp,
+                          TypeBitsetType& rKnownTypes,
+                          TypeBitsetType& rSubTypes)
+    {
+        unsigned type_id = rProp->GetTypeId();
+        if (type_id < CellPropertyRegistry::MAX_NUM_CACHED_TYPE_IDS)
+        {
+            if (!rKnownTypes[type_id])
+            {
+                rSubTypes[type_id] = rProp->IsSubType<BASECLASS>();
+                rKnownTypes.set(type_id);
+            }
+            return rSubTypes[type_id];
+        }
+        return rProp->IsSubType<BASECLASS>();
+    }
+
+    /**
+     * @return the type IDs known to be or not to be BASECLASS or its subclasses,
+     * for use with IsSubType().
+     *
+     * Each thread fills its own copy, so that collections may be queried from
+     * several threads at once without locking.
+     */
+    template<typename BASECLASS>
+    static TypeBitsetType& rGetKnownTypes()
+    {
+        static CHASTE_THREAD_LOCAL TypeBitsetType known_types;
+        return known_types;
+    }
+
+    /**
+     * @return the type IDs known to be BASECLASS or its subclasses, for use with
+     * IsSubType(). Each thread fills its own copy, as for rGetKnownTypes().
+     */
+    template<typename BASECLASS>
+    static TypeBitsetType& rGetSubTypes()
+    {
+        static CHASTE_THREAD_LOCAL TypeBitsetType sub_types;
+        return sub_types;
+    }
+
 public:
     /**
      * Create an empty collection of cell properties.
@@ -126,9 +230,14 @@ public:
     template<typename CLASS>
     bool HasProperty() const
     {
+        unsigned type_id = CellPropertyRegistry::GetTypeId<CLASS>();
+        if (type_id < CellPropertyRegistry::MAX_NUM_CACHED_TYPE_IDS)
+        {
+            return mTypeBits[type_id];
+        }
         for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
         {
-            if ((*it)->IsType<CLASS>())
+            if ((*it)->GetTypeId() == type_id)
             {
                 return true;
             }
@@ -145,9 +254,18 @@ public:
     template<typename BASECLASS>
     bool HasPropertyType() const
     {
+        TypeBitsetType& r_known_types = rGetKnownTypes<BASECLASS>();
+        TypeBitsetType& r_sub_types = rGetSubTypes<BASECLASS>();
+
+        // If every type in this collection has been classified already, a single AND suffices
+        if (!mHasUncachedTypes && (mTypeBits & ~r_known_types).none())
+        {
+            return (mTypeBits & r_sub_types).any();
+        }
+
         for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
         {
-            if ((*it)->IsSubType<BASECLASS>())
+            if (IsSubType<BASECLASS>(*it, r_known_types, r_sub_types))
             {
                 return true;
             }
@@ -161,11 +279,13 @@ public:
     template<typename CLASS>
     void RemoveProperty()
     {
+        unsigned type_id = CellPropertyRegistry::GetTypeId<CLASS>();
         for (IteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
         {
-            if ((*it)->IsType<CLASS>())
+            if ((*it)->GetTypeId() == type_id)
             {
                 mProperties.erase(it);
+                UpdateTypeBits();
                 return;
             }
         }
@@ -214,11 +334,15 @@ public:
     CellPropertyCollection GetProperties() const
     {
         CellPropertyCollection result;
-        for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
+        if (HasProperty<CLASS>())
         {
-            if ((*it)->IsType<CLASS>())
+            unsigned type_id = CellPropertyRegistry::GetTypeId<CLASS>();
+            for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
             {
-                result.AddProperty(*it);
+                if ((*it)->GetTypeId() == type_id)
+                {
+                    result.AddProperty(*it);
+                }
             }
         }
         return result;
@@ -231,10 +355,13 @@ public:
     template<typename BASECLASS>
     CellPropertyCollection GetPropertiesType() const
     {
+        TypeBitsetType& r_known_types = rGetKnownTypes<BASECLASS>();
+        TypeBitsetType& r_sub_types = rGetSubTypes<BASECLASS>();
+
         CellPropertyCollection result;
         for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
         {
-            if ((*it)->IsSubType<BASECLASS>())
+            if (IsSubType<BASECLASS>(*it, r_known_types, r_sub_types))
             {
                 result.AddProperty(*it);
             }
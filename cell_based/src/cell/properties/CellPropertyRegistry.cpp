@@ -34,19 +34,31 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <algorithm>
+#include <pthread.h>
 
 #include "CellPropertyRegistry.hpp"
 #include "Exception.hpp"
 
 CellPropertyRegistry* CellPropertyRegistry::mpInstance = NULL;
 
+CHASTE_THREAD_LOCAL CellPropertyRegistry** CellPropertyRegistry::mppThreadInstance = NULL;
+
+/** Guards the allocation of type IDs, which are shared by all threads */
+static pthread_mutex_t registered_types_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+CellPropertyRegistry*& CellPropertyRegistry::rGetInstancePointer()
+{
+    return (mppThreadInstance == NULL) ? mpInstance : *mppThreadInstance;
+}
+
 CellPropertyRegistry* CellPropertyRegistry::Instance()
 {
-    if (mpInstance == NULL)
+    CellPropertyRegistry*& rp_instance = rGetInstancePointer();
+    if (rp_instance == NULL)
     {
-        mpInstance = new CellPropertyRegistry;
+        rp_instance = new CellPropertyRegistry;
     }
-    return mpInstance;
+    return rp_instance;
 }
 
 const std::vector<boost::shared_ptr<AbstractCellProperty> >& CellPropertyRegistry::rGetAllCellProperties()
@@ -67,10 +79,17 @@ CellPropertyRegistry::CellPropertyRegistry()
 
 CellPropertyRegistry* CellPropertyRegistry::TakeOwnership()
 {
-    mpInstance = NULL;
+    rGetInstancePointer() = NULL;
     return this;
 }
 
+CellPropertyRegistry** CellPropertyRegistry::SetThreadInstanceLocation(CellPropertyRegistry** ppInstance)
+{
+    CellPropertyRegistry** pp_previous_instance = mppThreadInstance;
+    mppThreadInstance = ppInstance;
+    return pp_previous_instance;
+}
+
 void CellPropertyRegistry::SpecifyOrdering(const std::vector<boost::shared_ptr<AbstractCellProperty> >& rOrdering)
 {
     if (mOrderingHasBeenSpecified)
@@ -97,3 +116,36 @@ bool CellPropertyRegistry::HasOrderingBeenSpecified()
 {
     return mOrderingHasBeenSpecified;
 }
+
+std::vector<const std::type_info*>& CellPropertyRegistry::rGetRegisteredTypes()
+{
+    static std::vector<const std::type_info*> registered_types;
+    return registered_types;
+}
+
+unsigned CellPropertyRegistry::GetTypeId(const std::type_info& rType)
+{
+    std::vector<const std::type_info*>& r_types = rGetRegisteredTypes();
+
+    // This search only happens the first time each type is looked up, as callers cache the result
+    pthread_mutex_lock(&registered_types_mutex);
+    unsigned type_id = 0;
+    while (type_id<r_types.size() && *(r_types[type_id]) != rType)
+    {
+        type_id++;
+    }
+    if (type_id == r_types.size())
+    {
+        r_types.push_back(&rType);
+    }
+    pthread_mutex_unlock(&registered_types_mutex);
+    return type_id;
+}
+
+unsigned CellPropertyRegistry::GetNumTypeIds()
+{
+    pthread_mutex_lock(&registered_types_mutex);
+    unsigned num_type_ids = rGetRegisteredTypes().size();
+    pthread_mutex_unlock(&registered_types_mutex);
+    return num_type_ids;
+}
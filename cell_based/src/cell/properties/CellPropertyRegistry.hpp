@@ -37,11 +37,13 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CELLPROPERTYREGISTRY_HPP_
 
 #include <boost/shared_ptr.hpp>
+#include <typeinfo>
 #include <vector>
 
 #include "AbstractCellProperty.hpp"
 
 #include "ChasteSerialization.hpp"
+#include "ChasteThreadLocal.hpp"
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/vector.hpp>
 
@@ -87,6 +89,20 @@ public:
      */
     CellPropertyRegistry* TakeOwnership();
 
+    /**
+     * Make the calling thread use the registry pointed to from the given location,
+     * instead of the shared registry. This is intended for use by SimulationContext,
+     * so that cells created within a context use that context's registry, even while
+     * other contexts are active on other threads. Instance() and TakeOwnership()
+     * called on this thread then act on the pointer at this location, which may be
+     * NULL (in which case the next call to Instance will create a new registry there).
+     *
+     * @param ppInstance the location of this thread's registry pointer, or NULL to
+     *     use the shared registry again
+     * @return the location previously used by this thread, or NULL
+     */
+    static CellPropertyRegistry** SetThreadInstanceLocation(CellPropertyRegistry** ppInstance);
+
     /**
      * Specify the ordering in which cell properties should be returned by rGetAllCellProperties().
      * The provided ordering must include all cell properties in the registry. Once an ordering
@@ -102,6 +118,44 @@ public:
      */
     bool HasOrderingBeenSpecified();
 
+    /**
+     * The number of cell property type IDs for which CellPropertyCollection keeps
+     * a bitset recording which types it contains. Types registered after this many
+     * are still supported, but queries about them fall back to a search.
+     */
+    static const unsigned MAX_NUM_CACHED_TYPE_IDS = 64;
+
+    /**
+     * @return the type ID of the exact run-time type of a cell property, registering
+     * the type if it has not been seen before.
+     *
+     * Type IDs are small integers, allocated in the order in which types are first
+     * seen. They are shared by all registries, last for the lifetime of the program
+     * and are never archived.
+     *
+     * @param rType  the type_info of the property class
+     */
+    static unsigned GetTypeId(const std::type_info& rType);
+
+    /**
+     * @return the type ID of the cell property class SUBCLASS. The ID is looked up
+     * only on the first call for each class.
+     *
+     * Use like:
+     *    unsigned type_id = CellPropertyRegistry::GetTypeId<ApoptoticCellProperty>();
+     */
+    template<class SUBCLASS>
+    static unsigned GetTypeId()
+    {
+        static const unsigned type_id = GetTypeId(typeid(SUBCLASS));
+        return type_id;
+    }
+
+    /**
+     * @return the number of cell property type IDs allocated so far.
+     */
+    static unsigned GetNumTypeIds();
+
 private:
 
     /**
@@ -121,10 +175,22 @@ private:
     CellPropertyRegistry& operator= (const CellPropertyRegistry&);
 
     /**
-     * A pointer to the singleton instance of this class.
+     * A pointer to the singleton instance of this class, shared by all threads
+     * that have not called SetThreadInstanceLocation().
      */
     static CellPropertyRegistry* mpInstance;
 
+    /**
+     * If not NULL, the location of the pointer to the registry used by this
+     * thread in place of mpInstance.
+     */
+    static CHASTE_THREAD_LOCAL CellPropertyRegistry** mppThreadInstance;
+
+    /**
+     * @return a reference to the pointer to the registry used by the calling thread.
+     */
+    static CellPropertyRegistry*& rGetInstancePointer();
+
     /**
      * The cell properties in the registry.
      */
@@ -133,6 +199,13 @@ private:
     /** Whether an ordering has been set up */
     bool mOrderingHasBeenSpecified;
 
+    /**
+     * @return the types to which IDs have been allocated, indexed by ID. This is a
+     * function-local static so that IDs may safely be allocated during static
+     * initialisation.
+     */
+    static std::vector<const std::type_info*>& rGetRegisteredTypes();
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -36,6 +36,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "DeltaNotchSrnModel.hpp"
 
 #include <cassert>
+#include <map>
+#include <typeinfo>
+#include <utility>
+
+#include "DeltaNotchOdeBatch.hpp"
 
 DeltaNotchSrnModel::DeltaNotchSrnModel(boost::shared_ptr<AbstractCellCycleModelOdeSolver> pOdeSolver)
     : AbstractOdeSrnModel(2, pOdeSolver)
@@ -91,6 +96,65 @@ void DeltaNotchSrnModel::SimulateToCurrentTime()
     AbstractOdeSrnModel::SimulateToCurrentTime();
 }
 
+void DeltaNotchSrnModel::SimulateModelsToCurrentTime(const std::vector<DeltaNotchSrnModel*>& rModels)
+{
+    assert(SimulationTime::Instance()->IsStartTimeSetUp());
+    double current_time = SimulationTime::Instance()->GetTime();
+
+    // Group the models that take the same sequence of time steps, keyed by start time and time step
+    typedef std::map<std::pair<double, double>, std::vector<DeltaNotchSrnModel*> > BatchMap;
+    BatchMap batches;
+    for (unsigned i=0; i<rModels.size(); i++)
+    {
+        DeltaNotchSrnModel* p_model = rModels[i];
+        if (p_model->CanBeSimulatedInBatch() && (p_model->mLastTime < current_time) && !p_model->mFinishedRunningOdes)
+        {
+            p_model->UpdateDeltaNotch();
+            batches[std::make_pair(p_model->mLastTime, p_model->GetDt())].push_back(p_model);
+        }
+        else
+        {
+            p_model->SimulateToCurrentTime();
+        }
+    }
+
+    for (BatchMap::iterator batch_iter = batches.begin();
+         batch_iter != batches.end();
+         ++batch_iter)
+    {
+        const std::vector<DeltaNotchSrnModel*>& r_models = batch_iter->second;
+
+        DeltaNotchOdeBatch batch(batch_iter->first.first, current_time, batch_iter->first.second);
+        for (unsigned i=0; i<r_models.size(); i++)
+        {
+            AbstractOdeSystem* p_ode_system = r_models[i]->mpOdeSystem;
+            const std::vector<double>& r_state = p_ode_system->rGetStateVariables();
+            batch.AddSystem(r_state[0], r_state[1], p_ode_system->GetParameter(0u));
+        }
+
+        batch.Solve();
+
+        // DeltaNotchOdeSystem has no stopping event, so every model reaches the current time
+        for (unsigned i=0; i<r_models.size(); i++)
+        {
+            DeltaNotchSrnModel* p_model = r_models[i];
+            std::vector<double>& r_state = p_model->mpOdeSystem->rGetStateVariables();
+            r_state[0] = batch.GetNotch(i);
+            r_state[1] = batch.GetDelta(i);
+
+            p_model->mLastTime = current_time;
+            p_model->SetSimulatedToTime(current_time);
+        }
+    }
+}
+
+bool DeltaNotchSrnModel::CanBeSimulatedInBatch() const
+{
+    return (typeid(*this) == typeid(DeltaNotchSrnModel))
+        && (dynamic_cast<DeltaNotchOdeSystem*>(mpOdeSystem) != NULL)
+        && (dynamic_cast<CellCycleModelOdeSolver<DeltaNotchSrnModel, RungeKutta4IvpOdeSolver>*>(mpOdeSolver.get()) != NULL);
+}
+
 void DeltaNotchSrnModel::Initialise()
 {
     AbstractOdeSrnModel::Initialise(new DeltaNotchOdeSystem);
@@ -101,7 +165,8 @@ void DeltaNotchSrnModel::UpdateDeltaNotch()
     assert(mpOdeSystem != NULL);
     assert(mpCell != NULL);
 
-    double mean_delta = mpCell->GetCellData()->GetItem("mean delta");
+    static const CellDataKey mean_delta_key("mean delta");
+    double mean_delta = mpCell->GetCellData()->GetItem(mean_delta_key);
     mpOdeSystem->SetParameter("Mean Delta", mean_delta);
 }
 
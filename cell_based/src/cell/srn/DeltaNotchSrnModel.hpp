@@ -39,6 +39,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 
+#include <vector>
+
 #include "DeltaNotchOdeSystem.hpp"
 #include "AbstractOdeSrnModel.hpp"
 
@@ -80,6 +82,13 @@ protected:
      */
     DeltaNotchSrnModel(const DeltaNotchSrnModel& rModel);
 
+    /**
+     * @return whether this model can be integrated in a DeltaNotchOdeBatch, that is,
+     * whether it is exactly a DeltaNotchSrnModel solving a DeltaNotchOdeSystem with the
+     * Runge-Kutta solver.
+     */
+    bool CanBeSimulatedInBatch() const;
+
 public:
 
     /**
@@ -111,6 +120,18 @@ public:
      */
     void SimulateToCurrentTime();
 
+    /**
+     * Simulate a number of Delta-Notch SRN models to the current time together.
+     *
+     * Models that use the default Runge-Kutta solver and were last simulated at the same
+     * time with the same time step are integrated in one DeltaNotchOdeBatch. Any other
+     * model, for example one using CVODE or an instance of a subclass, is simulated on
+     * its own by SimulateToCurrentTime().
+     *
+     * @param rModels the models
+     */
+    static void SimulateModelsToCurrentTime(const std::vector<DeltaNotchSrnModel*>& rModels);
+
     /**
      * Update the current levels of Delta and Notch in the cell.
      */
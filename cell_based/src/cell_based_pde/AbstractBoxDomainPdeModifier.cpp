@@ -35,9 +35,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractBoxDomainPdeModifier.hpp"
 #include "AbstractCellPopulation.hpp"
+#include "CellDataKey.hpp"
 #include "TetrahedralMesh.hpp"
 #include "ReplicatableVector.hpp"
 #include "LinearBasisFunction.hpp"
+#include "ApoptoticCellProperty.hpp"
 #include <boost/make_shared.hpp>
 
 template<unsigned DIM>
@@ -53,7 +55,9 @@ AbstractBoxDomainPdeModifier<DIM>::AbstractBoxDomainPdeModifier(boost::shared_pt
     		                   solution),
       mpMeshCuboid(pMeshCuboid),
       mStepSize(stepSize),
-      mSetBcsOnBoxBoundary(true)
+      mSetBcsOnBoxBoundary(true),
+      mUsePersistentSolver(false),
+      mUseStructuredGridSolver(false)
 {
     if (pMeshCuboid)
     {
@@ -85,6 +89,171 @@ bool AbstractBoxDomainPdeModifier<DIM>::AreBcsSetOnBoxBoundary()
     return mSetBcsOnBoxBoundary;
 }
 
+template<unsigned DIM>
+void AbstractBoxDomainPdeModifier<DIM>::SetUsePersistentSolver(bool usePersistentSolver)
+{
+    mUsePersistentSolver = usePersistentSolver;
+}
+
+template<unsigned DIM>
+bool AbstractBoxDomainPdeModifier<DIM>::GetUsePersistentSolver()
+{
+    return mUsePersistentSolver;
+}
+
+template<unsigned DIM>
+void AbstractBoxDomainPdeModifier<DIM>::SetUseStructuredGridSolver(bool useStructuredGridSolver)
+{
+    mUseStructuredGridSolver = useStructuredGridSolver;
+}
+
+template<unsigned DIM>
+bool AbstractBoxDomainPdeModifier<DIM>::GetUseStructuredGridSolver()
+{
+    return mUseStructuredGridSolver;
+}
+
+template<unsigned DIM>
+RegularGridMultigridSolver<DIM>& AbstractBoxDomainPdeModifier<DIM>::rGetGridSolver()
+{
+    if (!mpGridSolver)
+    {
+        // The nodes of the FE mesh form a regular lattice, ordered with x varying fastest
+        ChasteCuboid<DIM> bounding_box = this->mpFeMesh->CalculateBoundingBox();
+        c_vector<unsigned, DIM> num_nodes;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            num_nodes[d] = (unsigned)((bounding_box.GetWidth(d) + 0.5*mStepSize)/mStepSize) + 1;
+        }
+        mpGridSolver.reset(new RegularGridMultigridSolver<DIM>(num_nodes, mStepSize));
+        assert(mpGridSolver->GetNumNodes() == this->mpFeMesh->GetNumNodes());
+    }
+    return *mpGridSolver;
+}
+
+template<unsigned DIM>
+bool AbstractBoxDomainPdeModifier<DIM>::IsIsotropicDiffusionTerm(const c_matrix<double,DIM,DIM>& rDiffusionTerm, double diffusionCoefficient)
+{
+    if (!(diffusionCoefficient > 0.0))
+    {
+        return false;
+    }
+
+    double tolerance = 1e-12*diffusionCoefficient;
+    for (unsigned i=0; i<DIM; i++)
+    {
+        for (unsigned j=0; j<DIM; j++)
+        {
+            double expected = (i == j) ? diffusionCoefficient : 0.0;
+            if (fabs(rDiffusionTerm(i,j) - expected) > tolerance)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<unsigned DIM>
+void AbstractBoxDomainPdeModifier<DIM>::CalculateCellDensityOnGridNodes(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::vector<double>& rDensity)
+{
+    ChasteCuboid<DIM> bounding_box = this->mpFeMesh->CalculateBoundingBox();
+    const c_vector<double, DIM>& r_origin = bounding_box.rGetLowerCorner().rGetLocation();
+
+    c_vector<unsigned, DIM> num_nodes;
+    c_vector<unsigned, DIM> strides;
+    unsigned total_num_nodes = 1;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        num_nodes[d] = (unsigned)((bounding_box.GetWidth(d) + 0.5*mStepSize)/mStepSize) + 1;
+        strides[d] = total_num_nodes;
+        total_num_nodes *= num_nodes[d];
+    }
+    rDensity.assign(total_num_nodes, 0.0);
+
+    unsigned num_corners = 1u << DIM;
+    for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
+         cell_iter != rCellPopulation.End();
+         ++cell_iter)
+    {
+        if (cell_iter->template HasCellProperty<ApoptoticCellProperty>())
+        {
+            continue;
+        }
+
+        // Find the lattice cell containing this cell, and the cell's position within it
+        c_vector<double, DIM> location = rCellPopulation.GetLocationOfCellCentre(*cell_iter);
+        c_vector<unsigned, DIM> base_coords;
+        c_vector<double, DIM> fractions;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            double scaled = (location[d] - r_origin[d])/mStepSize;
+            double max_base = (double)(num_nodes[d] - 2);
+            double base = std::max(0.0, std::min(floor(scaled), max_base));
+            base_coords[d] = (unsigned)base;
+            fractions[d] = std::max(0.0, std::min(scaled - base, 1.0));
+        }
+
+        for (unsigned corner=0; corner<num_corners; corner++)
+        {
+            double weight = 1.0;
+            unsigned node_index = 0;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                unsigned upper = (corner >> d) & 1u;
+                weight *= upper ? fractions[d] : 1.0 - fractions[d];
+                node_index += (base_coords[d] + upper)*strides[d];
+            }
+            rDensity[node_index] += weight;
+        }
+    }
+
+    // Divide by the volume associated with each node, which is halved along each direction in which the node lies on the edge
+    double interior_volume = 1.0;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        interior_volume *= mStepSize;
+    }
+    for (unsigned node_index=0; node_index<total_num_nodes; node_index++)
+    {
+        double volume = interior_volume;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            unsigned coord = (node_index/strides[d])%num_nodes[d];
+            if (coord == 0 || coord == num_nodes[d] - 1)
+            {
+                volume *= 0.5;
+            }
+        }
+        rDensity[node_index] /= volume;
+    }
+}
+
+template<unsigned DIM>
+void AbstractBoxDomainPdeModifier<DIM>::GetGridValuesFromSolution(std::vector<double>& rValues)
+{
+    unsigned num_nodes = this->mpFeMesh->GetNumNodes();
+    rValues.assign(num_nodes, 0.0);
+    if (this->mSolution != NULL)
+    {
+        ReplicatableVector solution_repl(this->mSolution);
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            rValues[i] = solution_repl[i];
+        }
+    }
+}
+
+template<unsigned DIM>
+void AbstractBoxDomainPdeModifier<DIM>::SetSolutionFromGridValues(const std::vector<double>& rValues)
+{
+    if (this->mSolution != NULL)
+    {
+        PetscTools::Destroy(this->mSolution);
+    }
+    this->mSolution = PetscTools::CreateVec(rValues);
+}
+
 template<unsigned DIM>
 void AbstractBoxDomainPdeModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
 {
@@ -136,6 +305,18 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
     // Store the PDE solution in an accessible form
     ReplicatableVector solution_repl(this->mSolution);
 
+    // Look up the keys of the cell data items once, rather than for every cell
+    CellDataKey solution_key(this->mDependentVariableName);
+    std::vector<CellDataKey> gradient_keys;
+    if (this->mOutputGradient)
+    {
+        const char* gradient_suffixes[3] = {"_grad_x", "_grad_y", "_grad_z"};
+        for (unsigned j=0; j<DIM; j++)
+        {
+            gradient_keys.push_back(CellDataKey(this->mDependentVariableName + gradient_suffixes[j]));
+        }
+    }
+
     for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
          cell_iter != rCellPopulation.End();
          ++cell_iter)
@@ -157,7 +338,7 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
             solution_at_cell += nodal_value * weights(i);
         }
 
-        cell_iter->GetCellData()->SetItem(this->mDependentVariableName, solution_at_cell);
+        cell_iter->GetCellData()->SetItem(solution_key, solution_at_cell);
 
         if (this->mOutputGradient)
         {
@@ -182,22 +363,9 @@ void AbstractBoxDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulation<DI
                 }
             }
 
-            switch (DIM)
+            for (unsigned j=0; j<DIM; j++)
             {
-                case 1:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    break;
-                case 2:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    break;
-                case 3:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_z", solution_gradient(2));
-                    break;
-                default:
-                    NEVER_REACHED;
+                cell_iter->GetCellData()->SetItem(gradient_keys[j], solution_gradient(j));
             }
         }
     }
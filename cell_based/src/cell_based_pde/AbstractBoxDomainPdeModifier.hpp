@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/base_object.hpp>
 
 #include "AbstractPdeModifier.hpp"
+#include "RegularGridMultigridSolver.hpp"
 
 /**
  * An abstract modifier class containing functionality common to EllipticBoxDomainPdeModifier
@@ -71,6 +72,8 @@ private:
         archive & mpMeshCuboid;
         archive & mStepSize;
         archive & mSetBcsOnBoxBoundary;
+        archive & mUsePersistentSolver;
+        archive & mUseStructuredGridSolver;
     }
 
 protected:
@@ -96,6 +99,68 @@ protected:
      */
     bool mSetBcsOnBoxBoundary;
 
+    /**
+     * Whether to keep the PDE solver, and with it the linear system, assembled matrices
+     * and KSP solver, from one time step to the next rather than constructing it afresh.
+     * This is valid as long as the box mesh, the boundary conditions and the PDE
+     * coefficients other than the source terms do not change during the simulation.
+     * Defaults to false.
+     */
+    bool mUsePersistentSolver;
+
+    /**
+     * Whether to solve the PDE by finite differences on the regular lattice formed by the
+     * nodes of the FE mesh, using a geometric multigrid solver, rather than by finite elements.
+     * In this case the source terms of averaged source PDEs are computed by depositing each
+     * cell onto the surrounding lattice nodes, rather than by finding the element containing it.
+     * The diffusion term of the PDE must be isotropic and uniform; if it is not, the FE
+     * solver is used instead, with a warning.
+     * Defaults to false.
+     */
+    bool mUseStructuredGridSolver;
+
+    /** The structured grid solver, created when first needed. */
+    boost::shared_ptr<RegularGridMultigridSolver<DIM> > mpGridSolver;
+
+    /**
+     * @return the structured grid solver, creating it if necessary.
+     */
+    RegularGridMultigridSolver<DIM>& rGetGridSolver();
+
+    /**
+     * @return whether a diffusion term is a given positive multiple of the identity, as the
+     *     structured grid solver requires.
+     *
+     * @param rDiffusionTerm the diffusion term of the PDE at some point
+     * @param diffusionCoefficient the multiple
+     */
+    static bool IsIsotropicDiffusionTerm(const c_matrix<double,DIM,DIM>& rDiffusionTerm, double diffusionCoefficient);
+
+    /**
+     * Compute the density of non-apoptotic cells at each node of the FE mesh, using
+     * cloud-in-cell weights to share each cell between the corners of the lattice cell
+     * containing it and dividing by the volume associated with each node.
+     *
+     * @param rCellPopulation reference to the cell population
+     * @param rDensity filled in with the density at each node
+     */
+    void CalculateCellDensityOnGridNodes(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::vector<double>& rDensity);
+
+    /**
+     * Copy the current solution into a vector of nodal values, or fill it with zeros
+     * if there is no solution yet.
+     *
+     * @param rValues filled in with the value at each node
+     */
+    void GetGridValuesFromSolution(std::vector<double>& rValues);
+
+    /**
+     * Replace the current solution with a vector of nodal values.
+     *
+     * @param rValues the value at each node
+     */
+    void SetSolutionFromGridValues(const std::vector<double>& rValues);
+
 public:
 
     /**
@@ -138,6 +203,30 @@ public:
      */
     bool AreBcsSetOnBoxBoundary();
 
+    /**
+     * Set mUsePersistentSolver.
+     *
+     * @param usePersistentSolver whether to keep the PDE solver between time steps
+     */
+    void SetUsePersistentSolver(bool usePersistentSolver);
+
+    /**
+     * @return mUsePersistentSolver.
+     */
+    bool GetUsePersistentSolver();
+
+    /**
+     * Set mUseStructuredGridSolver.
+     *
+     * @param useStructuredGridSolver whether to solve the PDE on a structured grid by multigrid
+     */
+    void SetUseStructuredGridSolver(bool useStructuredGridSolver);
+
+    /**
+     * @return mUseStructuredGridSolver.
+     */
+    bool GetUseStructuredGridSolver();
+
     /**
      * Overridden SetupSolve() method.
      *
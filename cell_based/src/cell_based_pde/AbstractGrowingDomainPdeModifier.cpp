@@ -37,6 +37,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VertexBasedCellPopulation.hpp"
 #include "MeshBasedCellPopulation.hpp"
 #include "CaBasedCellPopulation.hpp"
+#include "MutableMesh.hpp"
+#include "CellDataKey.hpp"
 #include "ReplicatableVector.hpp"
 #include "LinearBasisFunction.hpp"
 
@@ -49,7 +51,10 @@ AbstractGrowingDomainPdeModifier<DIM>::AbstractGrowingDomainPdeModifier(boost::s
     		                   pBoundaryCondition,
     		                   isNeumannBoundaryCondition,
     		                   solution),
-      mDeleteMesh(false)
+      mDeleteMesh(false),
+      mUseIncrementalFeMesh(false),
+      mFeMeshNumConnectivityChanges(0),
+      mFeMeshConnectivityChanged(true)
 {
 }
 
@@ -67,14 +72,52 @@ void AbstractGrowingDomainPdeModifier<DIM>::GenerateFeMesh(AbstractCellPopulatio
 {
     if (mDeleteMesh)
     {
-        // If a mesh has been created on a previous time-step then we need to tidy it up
+        // If a mesh has been created on a previous time-step, try to update it in place
         assert(this->mpFeMesh != NULL);
+        if (mUseIncrementalFeMesh && rCellPopulation.UpdateTetrahedralMeshForPdeModifier(this->mpFeMesh))
+        {
+            UpdateFeMeshConnectivityChanged(false);
+            return;
+        }
+
+        // Otherwise we need to tidy it up
         delete this->mpFeMesh;
     }
     mDeleteMesh = (dynamic_cast<MeshBasedCellPopulation<DIM>*>(&rCellPopulation) == NULL);
 
     // Get the finite element mesh via the cell population
     this->mpFeMesh = rCellPopulation.GetTetrahedralMeshForPdeModifier();
+
+    // A MeshBasedCellPopulation returns its own mesh, which is only new on the first call
+    UpdateFeMeshConnectivityChanged(mDeleteMesh);
+}
+
+template<unsigned DIM>
+void AbstractGrowingDomainPdeModifier<DIM>::UpdateFeMeshConnectivityChanged(bool isNewMesh)
+{
+    MutableMesh<DIM,DIM>* p_mutable_mesh = dynamic_cast<MutableMesh<DIM,DIM>*>(this->mpFeMesh);
+    if (p_mutable_mesh == NULL)
+    {
+        mFeMeshConnectivityChanged = true;
+    }
+    else
+    {
+        unsigned num_connectivity_changes = p_mutable_mesh->GetNumConnectivityChanges();
+        mFeMeshConnectivityChanged = isNewMesh || (num_connectivity_changes != mFeMeshNumConnectivityChanges);
+        mFeMeshNumConnectivityChanges = num_connectivity_changes;
+    }
+}
+
+template<unsigned DIM>
+void AbstractGrowingDomainPdeModifier<DIM>::SetUseIncrementalFeMesh(bool useIncrementalFeMesh)
+{
+    mUseIncrementalFeMesh = useIncrementalFeMesh;
+}
+
+template<unsigned DIM>
+bool AbstractGrowingDomainPdeModifier<DIM>::GetUseIncrementalFeMesh() const
+{
+    return mUseIncrementalFeMesh;
 }
 
 template<unsigned DIM>
@@ -83,6 +126,18 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
     // Store the PDE solution in an accessible form
     ReplicatableVector solution_repl(this->mSolution);
 
+    // Look up the keys of the cell data items once, rather than for every cell
+    CellDataKey solution_key(this->mDependentVariableName);
+    std::vector<CellDataKey> gradient_keys;
+    if (this->mOutputGradient)
+    {
+        const char* gradient_suffixes[3] = {"_grad_x", "_grad_y", "_grad_z"};
+        for (unsigned j=0; j<DIM; j++)
+        {
+            gradient_keys.push_back(CellDataKey(this->mDependentVariableName + gradient_suffixes[j]));
+        }
+    }
+
     // Local cell index used by the CA simulation
     unsigned cell_index = 0;
 
@@ -108,7 +163,7 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
 
         double solution_at_node = solution_repl[tet_node_index];
 
-        cell_iter->GetCellData()->SetItem(this->mDependentVariableName, solution_at_node);
+        cell_iter->GetCellData()->SetItem(solution_key, solution_at_node);
 
         if (this->mOutputGradient)
         {
@@ -145,22 +200,9 @@ void AbstractGrowingDomainPdeModifier<DIM>::UpdateCellData(AbstractCellPopulatio
             // Divide by number of containing elements
             solution_gradient /= p_tet_node->GetNumContainingElements();
 
-            switch (DIM)
+            for (unsigned j=0; j<DIM; j++)
             {
-                case 1:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    break;
-                case 2:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    break;
-                case 3:
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_x", solution_gradient(0));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_y", solution_gradient(1));
-                    cell_iter->GetCellData()->SetItem(this->mDependentVariableName+"_grad_z", solution_gradient(2));
-                    break;
-                default:
-                    NEVER_REACHED;
+                cell_iter->GetCellData()->SetItem(gradient_keys[j], solution_gradient(j));
             }
         }
     }
@@ -67,6 +67,7 @@ private:
     void serialize(Archive & archive, const unsigned int version)
     {
         archive & boost::serialization::base_object<AbstractPdeModifier<DIM> >(*this);
+        archive & mUseIncrementalFeMesh;
     }
 
     /**
@@ -75,6 +76,37 @@ private:
      */
     bool mDeleteMesh;
 
+    /**
+     * Whether to update the mesh created on the previous time step, where the
+     * cell population supports this, rather than creating a new mesh each time
+     * GenerateFeMesh() is called. Defaults to false.
+     */
+    bool mUseIncrementalFeMesh;
+
+    /**
+     * The number of connectivity changes of mpFeMesh, as given by
+     * MutableMesh::GetNumConnectivityChanges(), when GenerateFeMesh() was last called.
+     */
+    unsigned mFeMeshNumConnectivityChanges;
+
+    /**
+     * Helper method called by GenerateFeMesh() to set mFeMeshConnectivityChanged.
+     *
+     * @param isNewMesh whether mpFeMesh has just been created
+     */
+    void UpdateFeMeshConnectivityChanged(bool isNewMesh);
+
+protected:
+
+    /**
+     * Whether the connectivity of mpFeMesh was changed by the last call to GenerateFeMesh(),
+     * either because a new mesh was created or because the mesh was remeshed with edge flips,
+     * node insertions or node deletions. This is always true for meshes that are not a
+     * MutableMesh. While it is false, subclasses may keep the finite element solver from the
+     * previous time step, together with the sparsity pattern of its linear system.
+     */
+    bool mFeMeshConnectivityChanged;
+
 public:
 
     /**
@@ -103,6 +135,25 @@ public:
      */
     void GenerateFeMesh(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
 
+    /**
+     * Set mUseIncrementalFeMesh.
+     *
+     * If true, GenerateFeMesh() moves the nodes of the existing mesh to the new cell
+     * locations and updates its triangulation by node insertion and edge flips, via
+     * AbstractCellPopulation::UpdateTetrahedralMeshForPdeModifier(). The mesh is only
+     * created from scratch if this is not possible, for example after cell death. While
+     * no edges are flipped and no nodes are inserted, the finite element solver and the
+     * sparsity pattern of its linear system are also kept (see mFeMeshConnectivityChanged).
+     *
+     * @param useIncrementalFeMesh whether to update the mesh incrementally where possible
+     */
+    void SetUseIncrementalFeMesh(bool useIncrementalFeMesh);
+
+    /**
+     * @return mUseIncrementalFeMesh.
+     */
+    bool GetUseIncrementalFeMesh() const;
+
     /**
      * Helper method to copy the PDE solution to CellData
      *
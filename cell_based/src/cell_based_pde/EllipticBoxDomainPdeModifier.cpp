@@ -34,7 +34,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "EllipticBoxDomainPdeModifier.hpp"
-#include "SimpleLinearEllipticSolver.hpp"
+#include "Warnings.hpp"
+#include "AveragedSourceEllipticPde.hpp"
 
 template<unsigned DIM>
 EllipticBoxDomainPdeModifier<DIM>::EllipticBoxDomainPdeModifier(boost::shared_ptr<AbstractLinearPde<DIM,DIM> > pPde,
@@ -65,8 +66,31 @@ EllipticBoxDomainPdeModifier<DIM>::~EllipticBoxDomainPdeModifier()
 template<unsigned DIM>
 void EllipticBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
 {
-    // Set up boundary conditions
-    std::auto_ptr<BoundaryConditionsContainer<DIM,DIM,1> > p_bcc = ConstructBoundaryConditionsContainer(rCellPopulation);
+    if (this->mUseStructuredGridSolver)
+    {
+        this->UpdateCellPdeElementMap(rCellPopulation);
+        if (SolveOnStructuredGrid(rCellPopulation))
+        {
+            this->UpdateCellData(rCellPopulation);
+            return;
+        }
+        WARN_ONCE_ONLY("The structured grid solver requires a uniform and isotropic diffusion term, so the FE solver is used instead");
+    }
+
+    /*
+     * The boundary conditions only need to be reconstructed if they are imposed on
+     * the boundary of the cell population, which changes over time.
+     */
+    if (!this->mUsePersistentSolver || !mpSolver || !this->mSetBcsOnBoxBoundary)
+    {
+        // Set up boundary conditions
+        mpBoundaryConditionsContainer.reset(ConstructBoundaryConditionsContainer(rCellPopulation).release());
+
+        // Use SimpleLinearEllipticSolver as Averaged Source PDE
+        mpSolver.reset(new SimpleLinearEllipticSolver<DIM,DIM>(this->mpFeMesh,
+                                                               boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
+                                                               mpBoundaryConditionsContainer.get()));
+    }
 
     this->UpdateCellPdeElementMap(rCellPopulation);
 
@@ -74,23 +98,25 @@ void EllipticBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopula
     // Pass in already updated CellPdeElementMap to speed up finding cells.
     this->SetUpSourceTermsForAveragedSourcePde(this->mpFeMesh, &this->mCellPdeElementMap);
 
-    // Use SimpleLinearEllipticSolver as Averaged Source PDE
-    SimpleLinearEllipticSolver<DIM,DIM> solver(this->mpFeMesh,
-                                               boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
-                                               p_bcc.get());
-
-    ///\todo Use initial guess when solving the system
+    // If the solver is kept between time steps, use the previous solution as the initial guess
     Vec old_solution_copy = this->mSolution;
-    this->mSolution = solver.Solve();
+    Vec initial_guess = this->mUsePersistentSolver ? old_solution_copy : NULL;
+    this->mSolution = mpSolver->Solve(initial_guess);
 
     // Note that the linear solver creates a vector, so we have to keep a handle on the old one
     // in order to destroy it.
-    ///\todo This will change when initial guess is used.
     /// On the first go round the vector has yet to be initialised, so we don't destroy it.
     if (old_solution_copy != NULL)
     {
         PetscTools::Destroy(old_solution_copy);
     }
+
+    if (!this->mUsePersistentSolver)
+    {
+        mpSolver.reset();
+        mpBoundaryConditionsContainer.reset();
+    }
+
     this->UpdateCellData(rCellPopulation);
 }
 
@@ -160,6 +186,73 @@ std::auto_ptr<BoundaryConditionsContainer<DIM,DIM,1> > EllipticBoxDomainPdeModif
     return p_bcc;
 }
 
+template<unsigned DIM>
+bool EllipticBoxDomainPdeModifier<DIM>::SolveOnStructuredGrid(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    RegularGridMultigridSolver<DIM>& r_solver = this->rGetGridSolver();
+    unsigned num_nodes = this->mpFeMesh->GetNumNodes();
+
+    boost::shared_ptr<AbstractLinearEllipticPde<DIM,DIM> > p_pde = boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde());
+    boost::shared_ptr<AveragedSourceEllipticPde<DIM> > p_averaged_pde = boost::dynamic_pointer_cast<AveragedSourceEllipticPde<DIM> >(this->GetPde());
+
+    // For an averaged source PDE, deposit the cells directly onto the lattice nodes
+    std::vector<double> cell_density;
+    if (p_averaged_pde)
+    {
+        this->CalculateCellDensityOnGridNodes(rCellPopulation, cell_density);
+    }
+
+    std::auto_ptr<BoundaryConditionsContainer<DIM,DIM,1> > p_bcc = ConstructBoundaryConditionsContainer(rCellPopulation);
+
+    // Use the previous solution, if any, as the initial guess
+    std::vector<double> solution;
+    this->GetGridValuesFromSolution(solution);
+
+    // The lattice operator has a single diffusion coefficient, so D must be the same multiple of the identity everywhere
+    double diffusion_coefficient = p_pde->ComputeDiffusionTerm(this->mpFeMesh->GetNode(0)->GetPoint())(0,0);
+
+    // Div(D Grad u) + f(x)u + g(x) = 0 becomes (-f(x))u - D Laplacian(u) = g(x)
+    std::vector<double> diagonal_term(num_nodes);
+    std::vector<double> rhs(num_nodes);
+    std::vector<bool> is_dirichlet_node(num_nodes);
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        Node<DIM>* p_node = this->mpFeMesh->GetNode(i);
+
+        if (!this->IsIsotropicDiffusionTerm(p_pde->ComputeDiffusionTerm(p_node->GetPoint()), diffusion_coefficient))
+        {
+            return false;
+        }
+
+        double linear_in_u_coeff = 0.0;
+        double constant_in_u_term = 0.0;
+        if (p_averaged_pde)
+        {
+            linear_in_u_coeff = p_averaged_pde->GetCoefficient()*cell_density[i];
+        }
+        else
+        {
+            Element<DIM,DIM>* p_element = this->mpFeMesh->GetElement(*(p_node->ContainingElementsBegin()));
+            linear_in_u_coeff = p_pde->ComputeLinearInUCoeffInSourceTerm(p_node->GetPoint(), p_element);
+            constant_in_u_term = p_pde->ComputeConstantInUSourceTerm(p_node->GetPoint(), p_element);
+        }
+        diagonal_term[i] = -linear_in_u_coeff;
+        rhs[i] = constant_in_u_term;
+
+        is_dirichlet_node[i] = p_bcc->HasDirichletBoundaryCondition(p_node);
+        if (is_dirichlet_node[i])
+        {
+            solution[i] = p_bcc->GetDirichletBCValue(p_node);
+        }
+    }
+
+    r_solver.SetUpOperator(diffusion_coefficient, diagonal_term, is_dirichlet_node);
+    r_solver.Solve(rhs, solution);
+
+    this->SetSolutionFromGridValues(solution);
+    return true;
+}
+
 template<unsigned DIM>
 void EllipticBoxDomainPdeModifier<DIM>::OutputSimulationModifierParameters(out_stream& rParamsFile)
 {
@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractBoxDomainPdeModifier.hpp"
 #include "BoundaryConditionsContainer.hpp"
+#include "SimpleLinearEllipticSolver.hpp"
 #include "PetscTools.hpp"
 #include "FileFinder.hpp"
 
@@ -84,6 +85,21 @@ private:
         archive & boost::serialization::base_object<AbstractBoxDomainPdeModifier<DIM> >(*this);
     }
 
+    /**
+     * The boundary conditions used by #mpSolver.
+     * Not archived, as it is reconstructed when needed.
+     */
+    boost::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > mpBoundaryConditionsContainer;
+
+    /**
+     * The PDE solver. If mUsePersistentSolver is true this is kept between time steps, so
+     * that the linear system and KSP solver are reused, and the previous solution is used
+     * as the initial guess. The matrix is still reassembled at each time step, since it
+     * contains the linear-in-u source term, which changes with the cells. Not archived,
+     * as it is reconstructed when needed.
+     */
+    boost::shared_ptr<SimpleLinearEllipticSolver<DIM,DIM> > mpSolver;
+
 public:
 
     /**
@@ -137,6 +153,16 @@ public:
      */
     virtual std::auto_ptr<BoundaryConditionsContainer<DIM,DIM,1> > ConstructBoundaryConditionsContainer(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
 
+    /**
+     * Helper method to solve the PDE by finite differences on the regular lattice formed by
+     * the nodes of the FE mesh, used when mUseStructuredGridSolver is true. The Dirichlet nodes
+     * are those given a boundary condition by ConstructBoundaryConditionsContainer().
+     *
+     * @param rCellPopulation reference to the cell population
+     * @return whether the PDE was solved, which requires its diffusion term to be uniform and isotropic
+     */
+    bool SolveOnStructuredGrid(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
     /**
      * Overridden OutputSimulationModifierParameters() method.
      * Output any simulation modifier parameters to file.
@@ -85,18 +85,24 @@ void EllipticGrowingDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPo
         PetscTools::Destroy(this->mSolution);
     }
 
-    // Add the BCs to the BCs container
-    std::auto_ptr<BoundaryConditionsContainer<DIM,DIM,1> > p_bcc = this->ConstructBoundaryConditionsContainer();
+    // Reuse the solver from the previous time step unless the connectivity of the mesh has changed
+    if (this->mFeMeshConnectivityChanged || !mpSolver)
+    {
+        mpSolver.reset();
+
+        // Add the BCs to the BCs container
+        mpBoundaryConditionsContainer.reset(this->ConstructBoundaryConditionsContainer().release());
 
-    // Use CellBasedEllipticPdeSolver as cell wise PDE
-    CellBasedEllipticPdeSolver<DIM> solver(this->mpFeMesh,
-                                           boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
-                                           p_bcc.get());
+        // Use CellBasedEllipticPdeSolver as cell wise PDE
+        mpSolver.reset(new CellBasedEllipticPdeSolver<DIM>(this->mpFeMesh,
+                                                           boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
+                                                           mpBoundaryConditionsContainer.get()));
+    }
 
     // If we have an initial guess, use this when solving the system...
     if (is_previous_solution_size_correct)
     {
-        this->mSolution = solver.Solve(initial_guess);
+        this->mSolution = mpSolver->Solve(initial_guess);
         PetscTools::Destroy(initial_guess);
     }
     else // ...otherwise do not supply one
@@ -104,7 +110,7 @@ void EllipticGrowingDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPo
         // The solver creates a Vec, so we have to keep a handle on the old one to destroy it
         Vec old_solution_copy = this->mSolution;
 
-        this->mSolution = solver.Solve();
+        this->mSolution = mpSolver->Solve();
 
         // On the first go round the vector has yet to be initialised, so we don't destroy it
         if (old_solution_copy != NULL)
@@ -34,7 +34,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "ParabolicBoxDomainPdeModifier.hpp"
-#include "SimpleLinearParabolicSolver.hpp"
+#include "Warnings.hpp"
+#include "AveragedSourceParabolicPde.hpp"
 
 template<unsigned DIM>
 ParabolicBoxDomainPdeModifier<DIM>::ParabolicBoxDomainPdeModifier(boost::shared_ptr<AbstractLinearPde<DIM,DIM> > pPde,
@@ -48,7 +49,8 @@ ParabolicBoxDomainPdeModifier<DIM>::ParabolicBoxDomainPdeModifier(boost::shared_
     		                            isNeumannBoundaryCondition,
     		                            pMeshCuboid,
     		                            stepSize,
-    		                            solution)
+    		                            solution),
+      mSolverTimeStep(DOUBLE_UNSET)
 {
 }
 
@@ -65,8 +67,38 @@ ParabolicBoxDomainPdeModifier<DIM>::~ParabolicBoxDomainPdeModifier()
 template<unsigned DIM>
 void ParabolicBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
 {
-    // Set up boundary conditions
-    std::auto_ptr<BoundaryConditionsContainer<DIM,DIM,1> > p_bcc = ConstructBoundaryConditionsContainer(rCellPopulation);
+    if (this->mUseStructuredGridSolver)
+    {
+        this->UpdateCellPdeElementMap(rCellPopulation);
+        if (SolveOnStructuredGrid(rCellPopulation))
+        {
+            this->UpdateCellData(rCellPopulation);
+            return;
+        }
+        WARN_ONCE_ONLY("The structured grid solver requires a uniform and isotropic diffusion term, so the FE solver is used instead");
+    }
+
+    ///\todo Investigate more than one PDE time step per spatial step
+    SimulationTime* p_simulation_time = SimulationTime::Instance();
+    double current_time = p_simulation_time->GetTime();
+    double dt = p_simulation_time->GetTimeStep();
+
+    if (!this->mUsePersistentSolver || !mpSolver)
+    {
+        // Set up boundary conditions
+        mpBoundaryConditionsContainer.reset(ConstructBoundaryConditionsContainer(rCellPopulation).release());
+
+        // Use SimpleLinearParabolicSolver as averaged Source PDE
+        mpSolver.reset(new SimpleLinearParabolicSolver<DIM,DIM>(this->mpFeMesh,
+                                                                boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->GetPde()).get(),
+                                                                mpBoundaryConditionsContainer.get()));
+    }
+    else if (dt != mSolverTimeStep)
+    {
+        // The matrix depends on the time step, so must be reassembled if this has changed
+        mpSolver->SetMatrixIsNotAssembled();
+    }
+    mSolverTimeStep = dt;
 
     this->UpdateCellPdeElementMap(rCellPopulation);
 
@@ -74,26 +106,24 @@ void ParabolicBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopul
     // Pass in already updated CellPdeElementMap to speed up finding cells.
     this->SetUpSourceTermsForAveragedSourcePde(this->mpFeMesh, &this->mCellPdeElementMap);
 
-    // Use SimpleLinearParabolicSolver as averaged Source PDE
-    SimpleLinearParabolicSolver<DIM,DIM> solver(this->mpFeMesh,
-                                                boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->GetPde()).get(),
-                                                p_bcc.get());
-
-    ///\todo Investigate more than one PDE time step per spatial step
-    SimulationTime* p_simulation_time = SimulationTime::Instance();
-    double current_time = p_simulation_time->GetTime();
-    double dt = p_simulation_time->GetTimeStep();
-    solver.SetTimes(current_time,current_time + dt);
-    solver.SetTimeStep(dt);
+    mpSolver->SetTimes(current_time,current_time + dt);
+    mpSolver->SetTimeStep(dt);
 
     // Use previous solution as the initial condition
     Vec previous_solution = this->mSolution;
-    solver.SetInitialCondition(previous_solution);
+    mpSolver->SetInitialCondition(previous_solution);
 
     // Note that the linear solver creates a vector, so we have to keep a handle on the old one
     // in order to destroy it
-    this->mSolution = solver.Solve();
+    this->mSolution = mpSolver->Solve();
     PetscTools::Destroy(previous_solution);
+
+    if (!this->mUsePersistentSolver)
+    {
+        mpSolver.reset();
+        mpBoundaryConditionsContainer.reset();
+    }
+
     this->UpdateCellData(rCellPopulation);
 }
 
@@ -145,6 +175,84 @@ std::auto_ptr<BoundaryConditionsContainer<DIM,DIM,1> > ParabolicBoxDomainPdeModi
     return p_bcc;
 }
 
+template<unsigned DIM>
+bool ParabolicBoxDomainPdeModifier<DIM>::SolveOnStructuredGrid(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    if (!this->mSetBcsOnBoxBoundary)
+    {
+        EXCEPTION("Boundary conditions cannot yet be set on the cell population boundary for a ParabolicBoxDomainPdeModifier");
+    }
+
+    RegularGridMultigridSolver<DIM>& r_solver = this->rGetGridSolver();
+    unsigned num_nodes = this->mpFeMesh->GetNumNodes();
+    double dt = SimulationTime::Instance()->GetTimeStep();
+
+    boost::shared_ptr<AbstractLinearParabolicPde<DIM,DIM> > p_pde = boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->GetPde());
+    boost::shared_ptr<AveragedSourceParabolicPde<DIM> > p_averaged_pde = boost::dynamic_pointer_cast<AveragedSourceParabolicPde<DIM> >(this->GetPde());
+
+    // For an averaged source PDE, deposit the cells directly onto the lattice nodes
+    std::vector<double> cell_density;
+    if (p_averaged_pde)
+    {
+        this->CalculateCellDensityOnGridNodes(rCellPopulation, cell_density);
+    }
+
+    std::vector<double> previous_solution;
+    this->GetGridValuesFromSolution(previous_solution);
+    std::vector<double> solution = previous_solution;
+
+    // The lattice operator has a single diffusion coefficient, so D must be the same multiple of the identity everywhere
+    double diffusion_coefficient = p_pde->ComputeDiffusionTerm(this->mpFeMesh->GetNode(0)->GetPoint())(0,0);
+
+    // c(x) du/dt = Div(D Grad u) + s(x,u) becomes (c(x)/dt)u - D Laplacian(u) = (c(x)/dt)u_old + s(x,u_old)
+    std::vector<double> diagonal_term(num_nodes);
+    std::vector<double> rhs(num_nodes);
+    std::vector<bool> is_dirichlet_node(num_nodes, false);
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        Node<DIM>* p_node = this->mpFeMesh->GetNode(i);
+        ChastePoint<DIM> point = p_node->GetPoint();
+
+        if (!this->IsIsotropicDiffusionTerm(p_pde->ComputeDiffusionTerm(point), diffusion_coefficient))
+        {
+            return false;
+        }
+
+        double source_term = 0.0;
+        if (p_averaged_pde)
+        {
+            source_term = p_averaged_pde->GetCoefficient()*cell_density[i]*previous_solution[i];
+        }
+        else
+        {
+            Element<DIM,DIM>* p_element = this->mpFeMesh->GetElement(*(p_node->ContainingElementsBegin()));
+            source_term = p_pde->ComputeSourceTerm(point, previous_solution[i], p_element);
+        }
+        diagonal_term[i] = p_pde->ComputeDuDtCoefficientFunction(point)/dt;
+        rhs[i] = diagonal_term[i]*previous_solution[i] + source_term;
+
+        if (p_node->IsBoundaryNode())
+        {
+            double boundary_value = this->mpBoundaryCondition->GetValue(point);
+            if (this->IsNeumannBoundaryCondition())
+            {
+                rhs[i] += r_solver.GetNeumannBoundaryFactor(i)*boundary_value;
+            }
+            else
+            {
+                is_dirichlet_node[i] = true;
+                solution[i] = boundary_value;
+            }
+        }
+    }
+
+    r_solver.SetUpOperator(diffusion_coefficient, diagonal_term, is_dirichlet_node);
+    r_solver.Solve(rhs, solution);
+
+    this->SetSolutionFromGridValues(solution);
+    return true;
+}
+
 template<unsigned DIM>
 void ParabolicBoxDomainPdeModifier<DIM>::SetupInitialSolutionVector(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
 {
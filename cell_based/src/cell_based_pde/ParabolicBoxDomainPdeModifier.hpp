@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractBoxDomainPdeModifier.hpp"
 #include "BoundaryConditionsContainer.hpp"
+#include "SimpleLinearParabolicSolver.hpp"
 
 /**
  * A modifier class in which a linear parabolic PDE coupled to a cell-based simulation
@@ -82,6 +83,23 @@ private:
         archive & boost::serialization::base_object<AbstractBoxDomainPdeModifier<DIM> >(*this);
     }
 
+    /**
+     * The boundary conditions used by #mpSolver.
+     * Not archived, as it is reconstructed when needed.
+     */
+    boost::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > mpBoundaryConditionsContainer;
+
+    /**
+     * The PDE solver. If mUsePersistentSolver is true this is kept between time steps, so
+     * that the matrix (which does not depend on the source terms) is assembled and the
+     * preconditioner set up only once, and just the right-hand side is reassembled at
+     * each time step. Not archived, as it is reconstructed when needed.
+     */
+    boost::shared_ptr<SimpleLinearParabolicSolver<DIM,DIM> > mpSolver;
+
+    /** The time step with which the matrix held by #mpSolver was assembled. */
+    double mSolverTimeStep;
+
 public:
 
     /**
@@ -135,6 +153,16 @@ public:
      */
     virtual std::auto_ptr<BoundaryConditionsContainer<DIM,DIM,1> > ConstructBoundaryConditionsContainer(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
 
+    /**
+     * Helper method to solve the PDE by finite differences on the regular lattice formed by
+     * the nodes of the FE mesh, used when mUseStructuredGridSolver is true. As for the FE solver,
+     * diffusion is treated implicitly and the source term explicitly.
+     *
+     * @param rCellPopulation reference to the cell population
+     * @return whether the PDE was solved, which requires its diffusion term to be uniform and isotropic
+     */
+    bool SolveOnStructuredGrid(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
     /**
      * Helper method to initialise the PDE solution using the CellData.
      *
@@ -65,31 +65,37 @@ void ParabolicGrowingDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellP
 {
     this->GenerateFeMesh(rCellPopulation);
 
-    // Set up boundary conditions
-    std::auto_ptr<BoundaryConditionsContainer<DIM,DIM,1> > p_bcc = ConstructBoundaryConditionsContainer();
+    // Reuse the solver from the previous time step unless the connectivity of the mesh has changed
+    if (this->mFeMeshConnectivityChanged || !mpSolver)
+    {
+        mpSolver.reset();
+
+        // Set up boundary conditions
+        mpBoundaryConditionsContainer.reset(ConstructBoundaryConditionsContainer().release());
+
+        // Use CellBasedParabolicPdeSolver as cell wise PDE
+        mpSolver.reset(new CellBasedParabolicPdeSolver<DIM>(this->mpFeMesh,
+                                                            boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->mpPde).get(),
+                                                            mpBoundaryConditionsContainer.get()));
+    }
 
     // Construct the solution vector from cell data (takes care of cells dividing);
     UpdateSolutionVector(rCellPopulation);
 
-    // Use CellBasedParabolicPdeSolver as cell wise PDE
-    CellBasedParabolicPdeSolver<DIM> solver(this->mpFeMesh,
-                                            boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->mpPde).get(),
-                                            p_bcc.get());
-
     ///\todo Investigate more than one PDE time step per spatial step
     SimulationTime* p_simulation_time = SimulationTime::Instance();
     double current_time = p_simulation_time->GetTime();
     double dt = p_simulation_time->GetTimeStep();
-    solver.SetTimes(current_time,current_time + dt);
-    solver.SetTimeStep(dt);
+    mpSolver->SetTimes(current_time,current_time + dt);
+    mpSolver->SetTimeStep(dt);
 
     // Use previous solution as the initial condition
     Vec previous_solution = this->mSolution;
-    solver.SetInitialCondition(previous_solution);
+    mpSolver->SetInitialCondition(previous_solution);
 
     // Note that the linear solver creates a vector, so we have to keep a handle on the old one
     // in order to destroy it
-    this->mSolution = solver.Solve();
+    this->mSolution = mpSolver->Solve();
     PetscTools::Destroy(previous_solution);
     this->UpdateCellData(rCellPopulation);
 }
@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractGrowingDomainPdeModifier.hpp"
 #include "BoundaryConditionsContainer.hpp"
+#include "CellBasedParabolicPdeSolver.hpp"
 
 /**
  * A modifier class in which a linear parabolic PDE coupled to a cell-based simulation
@@ -79,6 +80,19 @@ private:
         archive & boost::serialization::base_object<AbstractGrowingDomainPdeModifier<DIM> >(*this);
     }
 
+    /**
+     * The boundary conditions container used by mpSolver. Declared before mpSolver, which
+     * refers to it, so that it is destroyed after it.
+     */
+    boost::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > mpBoundaryConditionsContainer;
+
+    /**
+     * The finite element solver, which is kept between time steps while the connectivity of
+     * the finite element mesh is unchanged, so that its linear system and sparsity pattern
+     * are reused. Not archived, since it is reconstructed on the first time step after loading.
+     */
+    boost::shared_ptr<CellBasedParabolicPdeSolver<DIM> > mpSolver;
+
 public:
 
     /**
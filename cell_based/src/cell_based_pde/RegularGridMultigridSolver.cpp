@@ -0,0 +1,726 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "RegularGridMultigridSolver.hpp"
+#include <cmath>
+#include "Exception.hpp"
+#include "ThreadPool.hpp"
+#include "ThreadPoolMemberTask.hpp"
+
+template<unsigned DIM>
+RegularGridMultigridSolver<DIM>::RegularGridMultigridSolver(const c_vector<unsigned, DIM>& rNumNodes, double stepSize)
+    : mDiffusionCoefficient(1.0),
+      mTolerance(1e-10),
+      mMaxNumCycles(100),
+      mNumSmoothingSweeps(2),
+      mNumCyclesOfLastSolve(0),
+      mCoarsestLevelIsFactorised(false),
+      mTaskLevelIndex(0),
+      mTaskColour(0),
+      mpTaskFineValues(NULL),
+      mpTaskCoarseValues(NULL)
+{
+    assert(stepSize > 0.0);
+
+    c_vector<unsigned, DIM> num_nodes = rNumNodes;
+    c_vector<double, DIM> step_sizes;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        step_sizes[d] = stepSize;
+    }
+
+    while (true)
+    {
+        GridLevel level;
+        level.mNumNodes = num_nodes;
+        level.mStepSizes = step_sizes;
+        level.mTotalNumNodes = 1;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            assert(num_nodes[d] > 1);
+            level.mStrides[d] = level.mTotalNumNodes;
+            level.mTotalNumNodes *= num_nodes[d];
+        }
+        level.mDiagonalTerm.resize(level.mTotalNumNodes, 0.0);
+        level.mIsDirichletNode.resize(level.mTotalNumNodes, false);
+        level.mSolution.resize(level.mTotalNumNodes, 0.0);
+        level.mRightHandSide.resize(level.mTotalNumNodes, 0.0);
+        level.mResidual.resize(level.mTotalNumNodes, 0.0);
+        mLevels.push_back(level);
+
+        /*
+         * Halve (rounding up) the number of intervals in every direction that has more than two,
+         * until the lattice is small enough to factorise. The coarse lattice covers the same box,
+         * so its nodes only coincide with fine nodes when the number of intervals is even.
+         */
+        bool can_coarsen = false;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            if (num_nodes[d] - 1 > 2)
+            {
+                can_coarsen = true;
+            }
+        }
+        if (level.mTotalNumNodes <= MAX_NUM_COARSEST_NODES || !can_coarsen)
+        {
+            break;
+        }
+
+        GridLevel& r_fine = mLevels.back();
+        r_fine.mCoarseLowerCoords.resize(DIM);
+        r_fine.mCoarseUpperWeights.resize(DIM);
+        r_fine.mRestrictionFineCoords.resize(DIM);
+        r_fine.mRestrictionWeights.resize(DIM);
+        for (unsigned d=0; d<DIM; d++)
+        {
+            unsigned num_fine_intervals = num_nodes[d] - 1;
+            unsigned num_coarse_intervals = (num_fine_intervals > 2) ? (num_fine_intervals + 1)/2 : num_fine_intervals;
+
+            // Fine node i lies at i*num_coarse_intervals/num_fine_intervals in coarse lattice coordinates
+            r_fine.mCoarseLowerCoords[d].resize(num_nodes[d]);
+            r_fine.mCoarseUpperWeights[d].resize(num_nodes[d]);
+            for (unsigned i=0; i<num_nodes[d]; i++)
+            {
+                unsigned scaled_coord = i*num_coarse_intervals;
+                unsigned lower = scaled_coord/num_fine_intervals;
+                r_fine.mCoarseLowerCoords[d][i] = lower;
+                r_fine.mCoarseUpperWeights[d][i] = (scaled_coord - lower*num_fine_intervals)/(double)num_fine_intervals;
+            }
+
+            /*
+             * Restriction is the transpose of interpolation, scaled by the ratio of the spacings.
+             * A node on an edge of the lattice has half the control volume of an interior node,
+             * which the ghost node formulation makes up for by doubling its equation, so the weight
+             * is also scaled by the ratio of the control volumes of the fine and coarse nodes. The
+             * weights are stored for each coarse coordinate, so that restriction gathers values.
+             */
+            unsigned num_coarse_nodes = num_coarse_intervals + 1;
+            r_fine.mRestrictionFineCoords[d].resize(num_coarse_nodes);
+            r_fine.mRestrictionWeights[d].resize(num_coarse_nodes);
+            for (unsigned i=0; i<num_nodes[d]; i++)
+            {
+                for (unsigned is_upper=0; is_upper<2; is_upper++)
+                {
+                    unsigned coarse_coord = r_fine.mCoarseLowerCoords[d][i] + is_upper;
+                    double upper_weight = r_fine.mCoarseUpperWeights[d][i];
+                    double weight = is_upper ? upper_weight : 1.0 - upper_weight;
+                    if (weight == 0.0)
+                    {
+                        continue;
+                    }
+
+                    weight *= num_coarse_intervals/(double)num_fine_intervals;
+                    bool fine_is_on_edge = (i == 0 || i + 1 == num_nodes[d]);
+                    bool coarse_is_on_edge = (coarse_coord == 0 || coarse_coord + 1 == num_coarse_nodes);
+                    if (fine_is_on_edge && !coarse_is_on_edge)
+                    {
+                        weight *= 0.5;
+                    }
+                    else if (coarse_is_on_edge && !fine_is_on_edge)
+                    {
+                        weight *= 2.0;
+                    }
+                    r_fine.mRestrictionFineCoords[d][coarse_coord].push_back(i);
+                    r_fine.mRestrictionWeights[d][coarse_coord].push_back(weight);
+                }
+            }
+
+            step_sizes[d] *= num_fine_intervals/(double)num_coarse_intervals;
+            num_nodes[d] = num_coarse_intervals + 1;
+        }
+    }
+}
+
+template<unsigned DIM>
+unsigned RegularGridMultigridSolver<DIM>::GetNumNodes() const
+{
+    return mLevels[0].mTotalNumNodes;
+}
+
+template<unsigned DIM>
+unsigned RegularGridMultigridSolver<DIM>::GetNumLevels() const
+{
+    return mLevels.size();
+}
+
+template<unsigned DIM>
+unsigned RegularGridMultigridSolver<DIM>::GetNumCyclesOfLastSolve() const
+{
+    return mNumCyclesOfLastSolve;
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::SetTolerance(double tolerance)
+{
+    assert(tolerance > 0.0);
+    mTolerance = tolerance;
+}
+
+template<unsigned DIM>
+double RegularGridMultigridSolver<DIM>::GetNeumannBoundaryFactor(unsigned nodeIndex) const
+{
+    const GridLevel& r_level = mLevels[0];
+    assert(nodeIndex < r_level.mTotalNumNodes);
+
+    // Each edge of the lattice on which the node lies contributes a ghost node term
+    double factor = 0.0;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        unsigned coord = (nodeIndex/r_level.mStrides[d])%r_level.mNumNodes[d];
+        if (coord == 0 || coord == r_level.mNumNodes[d] - 1)
+        {
+            factor += 2.0/r_level.mStepSizes[d];
+        }
+    }
+    return factor;
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::SetUpOperator(double diffusionCoefficient,
+                                                    const std::vector<double>& rDiagonalTerm,
+                                                    const std::vector<bool>& rIsDirichletNode)
+{
+    assert(diffusionCoefficient > 0.0);
+    assert(rDiagonalTerm.size() == GetNumNodes());
+    assert(rIsDirichletNode.size() == GetNumNodes());
+
+    mDiffusionCoefficient = diffusionCoefficient;
+    mLevels[0].mDiagonalTerm = rDiagonalTerm;
+    mLevels[0].mIsDirichletNode = rIsDirichletNode;
+
+    for (unsigned level_index=1; level_index<mLevels.size(); level_index++)
+    {
+        GridLevel& r_fine = mLevels[level_index-1];
+        GridLevel& r_coarse = mLevels[level_index];
+
+        ApplyFullWeighting(level_index-1, r_fine.mDiagonalTerm, r_coarse.mDiagonalTerm);
+
+        // A coarse node is held fixed if the nearest fine node is
+        c_vector<unsigned, DIM> coords = zero_vector<unsigned>(DIM);
+        for (unsigned i=0; i<r_coarse.mTotalNumNodes; i++)
+        {
+            unsigned fine_index = 0;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                unsigned num_fine_intervals = r_fine.mNumNodes[d] - 1;
+                unsigned num_coarse_intervals = r_coarse.mNumNodes[d] - 1;
+                unsigned fine_coord = (2*coords[d]*num_fine_intervals + num_coarse_intervals)/(2*num_coarse_intervals);
+                fine_index += fine_coord*r_fine.mStrides[d];
+            }
+            r_coarse.mIsDirichletNode[i] = r_fine.mIsDirichletNode[fine_index];
+            IncrementCoordinates(coords, r_coarse.mNumNodes);
+        }
+    }
+
+    FactoriseCoarsestOperator();
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::Solve(const std::vector<double>& rRightHandSide, std::vector<double>& rSolution)
+{
+    GridLevel& r_finest = mLevels[0];
+    assert(rRightHandSide.size() == r_finest.mTotalNumNodes);
+    assert(rSolution.size() == r_finest.mTotalNumNodes);
+
+    r_finest.mRightHandSide = rRightHandSide;
+
+    /*
+     * Measure convergence against the residual of the initial guess with its free values
+     * set to zero, so that a good initial guess is not asked for an unattainable reduction.
+     */
+    r_finest.mSolution.assign(r_finest.mTotalNumNodes, 0.0);
+    for (unsigned i=0; i<r_finest.mTotalNumNodes; i++)
+    {
+        if (r_finest.mIsDirichletNode[i])
+        {
+            r_finest.mSolution[i] = rSolution[i];
+        }
+    }
+    double reference_norm = ComputeResidual(0);
+
+    mNumCyclesOfLastSolve = 0;
+    if (reference_norm == 0.0)
+    {
+        rSolution = r_finest.mSolution;
+        return;
+    }
+
+    r_finest.mSolution = rSolution;
+    double residual_norm = ComputeResidual(0);
+    while (residual_norm > mTolerance*reference_norm)
+    {
+        if (mNumCyclesOfLastSolve == mMaxNumCycles)
+        {
+            EXCEPTION("Multigrid solver did not converge within the maximum number of V-cycles");
+        }
+        VCycle(0);
+        mNumCyclesOfLastSolve++;
+        residual_norm = ComputeResidual(0);
+    }
+
+    rSolution = r_finest.mSolution;
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::IncrementCoordinates(c_vector<unsigned, DIM>& rCoords, const c_vector<unsigned, DIM>& rNumNodes)
+{
+    for (unsigned d=0; d<DIM; d++)
+    {
+        rCoords[d]++;
+        if (rCoords[d] < rNumNodes[d])
+        {
+            return;
+        }
+        rCoords[d] = 0;
+    }
+}
+
+template<unsigned DIM>
+c_vector<unsigned, DIM> RegularGridMultigridSolver<DIM>::GetCoordinates(const GridLevel& rLevel, unsigned nodeIndex)
+{
+    c_vector<unsigned, DIM> coords;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        coords[d] = (nodeIndex/rLevel.mStrides[d])%rLevel.mNumNodes[d];
+    }
+    return coords;
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::ShareLoopOverNodes(unsigned numNodes, void (RegularGridMultigridSolver<DIM>::*pMethod)(unsigned, unsigned))
+{
+    // Small loops, such as those on coarse levels, are not worth handing to other threads
+    if (numNodes < MIN_NUM_NODES_TO_SHARE)
+    {
+        (this->*pMethod)(0, numNodes);
+    }
+    else
+    {
+        ThreadPoolMemberTask<RegularGridMultigridSolver<DIM> > task(this, pMethod);
+        ThreadPool::Instance()->ParallelFor(numNodes, task);
+    }
+}
+
+template<unsigned DIM>
+c_vector<double, DIM> RegularGridMultigridSolver<DIM>::GetOffDiagonalTerms(const GridLevel& rLevel) const
+{
+    c_vector<double, DIM> off_diagonal_terms;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        off_diagonal_terms[d] = mDiffusionCoefficient/(rLevel.mStepSizes[d]*rLevel.mStepSizes[d]);
+    }
+    return off_diagonal_terms;
+}
+
+template<unsigned DIM>
+double RegularGridMultigridSolver<DIM>::SumNeighbourValues(const GridLevel& rLevel,
+                                                           unsigned nodeIndex,
+                                                           const c_vector<unsigned, DIM>& rCoords,
+                                                           const c_vector<double, DIM>& rOffDiagonalTerms,
+                                                           const std::vector<double>& rValues) const
+{
+    double sum = 0.0;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        unsigned stride = rLevel.mStrides[d];
+
+        // A neighbour missing off the edge of the lattice is replaced by its mirror image
+        unsigned lower = (rCoords[d] > 0) ? nodeIndex - stride : nodeIndex + stride;
+        unsigned upper = (rCoords[d] + 1 < rLevel.mNumNodes[d]) ? nodeIndex + stride : nodeIndex - stride;
+        sum += rOffDiagonalTerms[d]*(rValues[lower] + rValues[upper]);
+    }
+    return sum;
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::Smooth(unsigned levelIndex, unsigned numSweeps)
+{
+    mTaskLevelIndex = levelIndex;
+    for (unsigned sweep=0; sweep<numSweeps; sweep++)
+    {
+        for (unsigned colour=0; colour<2; colour++)
+        {
+            mTaskColour = colour;
+            ShareLoopOverNodes(mLevels[levelIndex].mTotalNumNodes, &RegularGridMultigridSolver<DIM>::SmoothNodes);
+        }
+    }
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::SmoothNodes(unsigned firstNodeIndex, unsigned endNodeIndex)
+{
+    GridLevel& r_level = mLevels[mTaskLevelIndex];
+    c_vector<double, DIM> off_diagonal_terms = GetOffDiagonalTerms(r_level);
+    double sum_off_diagonal_terms = 2.0*sum(off_diagonal_terms);
+    std::vector<double>& r_u = r_level.mSolution;
+
+    c_vector<unsigned, DIM> coords = GetCoordinates(r_level, firstNodeIndex);
+    for (unsigned i=firstNodeIndex; i<endNodeIndex; i++)
+    {
+        unsigned parity = 0;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            parity += coords[d];
+        }
+
+        if (parity%2 == mTaskColour && !r_level.mIsDirichletNode[i])
+        {
+            double neighbour_sum = SumNeighbourValues(r_level, i, coords, off_diagonal_terms, r_u);
+            r_u[i] = (r_level.mRightHandSide[i] + neighbour_sum)/(r_level.mDiagonalTerm[i] + sum_off_diagonal_terms);
+        }
+        IncrementCoordinates(coords, r_level.mNumNodes);
+    }
+}
+
+template<unsigned DIM>
+double RegularGridMultigridSolver<DIM>::ComputeResidual(unsigned levelIndex)
+{
+    mTaskLevelIndex = levelIndex;
+    ShareLoopOverNodes(mLevels[levelIndex].mTotalNumNodes, &RegularGridMultigridSolver<DIM>::ComputeResidualAtNodes);
+
+    // The norm is summed in index order on this thread, so it does not depend on the number of threads
+    const std::vector<double>& r_residual = mLevels[levelIndex].mResidual;
+    double norm_squared = 0.0;
+    for (unsigned i=0; i<r_residual.size(); i++)
+    {
+        norm_squared += r_residual[i]*r_residual[i];
+    }
+    return sqrt(norm_squared);
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::ComputeResidualAtNodes(unsigned firstNodeIndex, unsigned endNodeIndex)
+{
+    GridLevel& r_level = mLevels[mTaskLevelIndex];
+    c_vector<double, DIM> off_diagonal_terms = GetOffDiagonalTerms(r_level);
+    double sum_off_diagonal_terms = 2.0*sum(off_diagonal_terms);
+    const std::vector<double>& r_u = r_level.mSolution;
+
+    c_vector<unsigned, DIM> coords = GetCoordinates(r_level, firstNodeIndex);
+    for (unsigned i=firstNodeIndex; i<endNodeIndex; i++)
+    {
+        if (r_level.mIsDirichletNode[i])
+        {
+            r_level.mResidual[i] = 0.0;
+        }
+        else
+        {
+            double neighbour_sum = SumNeighbourValues(r_level, i, coords, off_diagonal_terms, r_u);
+            double a_u = (r_level.mDiagonalTerm[i] + sum_off_diagonal_terms)*r_u[i] - neighbour_sum;
+            r_level.mResidual[i] = r_level.mRightHandSide[i] - a_u;
+        }
+        IncrementCoordinates(coords, r_level.mNumNodes);
+    }
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::ApplyFullWeighting(unsigned fineLevelIndex,
+                                                         const std::vector<double>& rFineValues,
+                                                         std::vector<double>& rCoarseValues)
+{
+    rCoarseValues.resize(mLevels[fineLevelIndex+1].mTotalNumNodes);
+
+    // Each coarse node gathers from the fine nodes around it, so coarse nodes may be shared between threads
+    mTaskLevelIndex = fineLevelIndex;
+    mpTaskFineValues = &rFineValues;
+    mpTaskCoarseValues = &rCoarseValues;
+    ShareLoopOverNodes(rCoarseValues.size(), &RegularGridMultigridSolver<DIM>::RestrictToNodes);
+    mpTaskFineValues = NULL;
+    mpTaskCoarseValues = NULL;
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::RestrictToNodes(unsigned firstNodeIndex, unsigned endNodeIndex)
+{
+    const GridLevel& r_fine = mLevels[mTaskLevelIndex];
+    const GridLevel& r_coarse = mLevels[mTaskLevelIndex+1];
+    const std::vector<double>& r_fine_values = *mpTaskFineValues;
+    std::vector<double>& r_coarse_values = *mpTaskCoarseValues;
+
+    c_vector<unsigned, DIM> coords = GetCoordinates(r_coarse, firstNodeIndex);
+    for (unsigned i=firstNodeIndex; i<endNodeIndex; i++)
+    {
+        // The weights are a product over directions, so sum over every combination of fine coordinates
+        c_vector<unsigned, DIM> num_terms_in_direction;
+        unsigned num_terms = 1;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            num_terms_in_direction[d] = r_fine.mRestrictionFineCoords[d][coords[d]].size();
+            num_terms *= num_terms_in_direction[d];
+        }
+
+        double value = 0.0;
+        c_vector<unsigned, DIM> term = zero_vector<unsigned>(DIM);
+        for (unsigned t=0; t<num_terms; t++)
+        {
+            double weight = 1.0;
+            unsigned fine_index = 0;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                weight *= r_fine.mRestrictionWeights[d][coords[d]][term[d]];
+                fine_index += r_fine.mRestrictionFineCoords[d][coords[d]][term[d]]*r_fine.mStrides[d];
+            }
+            value += weight*r_fine_values[fine_index];
+            IncrementCoordinates(term, num_terms_in_direction);
+        }
+        r_coarse_values[i] = value;
+        IncrementCoordinates(coords, r_coarse.mNumNodes);
+    }
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::Restrict(unsigned levelIndex)
+{
+    GridLevel& r_fine = mLevels[levelIndex];
+    GridLevel& r_coarse = mLevels[levelIndex+1];
+
+    ApplyFullWeighting(levelIndex, r_fine.mResidual, r_coarse.mRightHandSide);
+    for (unsigned i=0; i<r_coarse.mTotalNumNodes; i++)
+    {
+        if (r_coarse.mIsDirichletNode[i])
+        {
+            r_coarse.mRightHandSide[i] = 0.0;
+        }
+    }
+    r_coarse.mSolution.assign(r_coarse.mTotalNumNodes, 0.0);
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::ProlongateAndCorrect(unsigned levelIndex)
+{
+    mTaskLevelIndex = levelIndex;
+    ShareLoopOverNodes(mLevels[levelIndex].mTotalNumNodes, &RegularGridMultigridSolver<DIM>::ProlongateToNodes);
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::ProlongateToNodes(unsigned firstNodeIndex, unsigned endNodeIndex)
+{
+    GridLevel& r_fine = mLevels[mTaskLevelIndex];
+    const GridLevel& r_coarse = mLevels[mTaskLevelIndex+1];
+
+    unsigned num_corners = 1u << DIM;
+
+    c_vector<unsigned, DIM> coords = GetCoordinates(r_fine, firstNodeIndex);
+    for (unsigned i=firstNodeIndex; i<endNodeIndex; i++)
+    {
+        if (!r_fine.mIsDirichletNode[i])
+        {
+            // Interpolate linearly in each direction between the surrounding coarse nodes
+            double correction = 0.0;
+            for (unsigned corner=0; corner<num_corners; corner++)
+            {
+                double weight = 1.0;
+                unsigned coarse_index = 0;
+                for (unsigned d=0; d<DIM; d++)
+                {
+                    unsigned coarse_coord = r_fine.mCoarseLowerCoords[d][coords[d]];
+                    double upper_weight = r_fine.mCoarseUpperWeights[d][coords[d]];
+                    if ((corner >> d) & 1u)
+                    {
+                        weight *= upper_weight;
+                        coarse_coord++;
+                    }
+                    else
+                    {
+                        weight *= 1.0 - upper_weight;
+                    }
+                    if (weight == 0.0)
+                    {
+                        break;
+                    }
+                    coarse_index += coarse_coord*r_coarse.mStrides[d];
+                }
+                if (weight > 0.0)
+                {
+                    correction += weight*r_coarse.mSolution[coarse_index];
+                }
+            }
+            r_fine.mSolution[i] += correction;
+        }
+        IncrementCoordinates(coords, r_fine.mNumNodes);
+    }
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::FactoriseCoarsestOperator()
+{
+    const GridLevel& r_level = mLevels.back();
+    unsigned n = r_level.mTotalNumNodes;
+    c_vector<double, DIM> off_diagonal_terms = GetOffDiagonalTerms(r_level);
+    double sum_off_diagonal_terms = 2.0*sum(off_diagonal_terms);
+
+    // Assemble the operator densely, with an identity row for each Dirichlet node
+    mCoarsestFactors.assign(n*n, 0.0);
+    double largest_diagonal = 0.0;
+    c_vector<unsigned, DIM> coords = zero_vector<unsigned>(DIM);
+    for (unsigned i=0; i<n; i++)
+    {
+        double* p_row = &mCoarsestFactors[i*n];
+        if (r_level.mIsDirichletNode[i])
+        {
+            p_row[i] = 1.0;
+        }
+        else
+        {
+            p_row[i] = r_level.mDiagonalTerm[i] + sum_off_diagonal_terms;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                unsigned stride = r_level.mStrides[d];
+                unsigned lower = (coords[d] > 0) ? i - stride : i + stride;
+                unsigned upper = (coords[d] + 1 < r_level.mNumNodes[d]) ? i + stride : i - stride;
+                p_row[lower] -= off_diagonal_terms[d];
+                p_row[upper] -= off_diagonal_terms[d];
+            }
+        }
+        largest_diagonal = std::max(largest_diagonal, fabs(p_row[i]));
+        IncrementCoordinates(coords, r_level.mNumNodes);
+    }
+
+    // LU factorisation with partial pivoting
+    mCoarsestPivots.resize(n);
+    mCoarsestLevelIsFactorised = true;
+    for (unsigned k=0; k<n; k++)
+    {
+        unsigned pivot_row = k;
+        for (unsigned i=k+1; i<n; i++)
+        {
+            if (fabs(mCoarsestFactors[i*n+k]) > fabs(mCoarsestFactors[pivot_row*n+k]))
+            {
+                pivot_row = i;
+            }
+        }
+        mCoarsestPivots[k] = pivot_row;
+
+        if (fabs(mCoarsestFactors[pivot_row*n+k]) <= 1e-12*largest_diagonal)
+        {
+            mCoarsestLevelIsFactorised = false;
+            return;
+        }
+        if (pivot_row != k)
+        {
+            std::swap_ranges(mCoarsestFactors.begin() + k*n, mCoarsestFactors.begin() + (k+1)*n, mCoarsestFactors.begin() + pivot_row*n);
+        }
+
+        double pivot = mCoarsestFactors[k*n+k];
+        for (unsigned i=k+1; i<n; i++)
+        {
+            double multiplier = mCoarsestFactors[i*n+k]/pivot;
+            mCoarsestFactors[i*n+k] = multiplier;
+            if (multiplier != 0.0)
+            {
+                for (unsigned j=k+1; j<n; j++)
+                {
+                    mCoarsestFactors[i*n+j] -= multiplier*mCoarsestFactors[k*n+j];
+                }
+            }
+        }
+    }
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::SolveCoarsestLevelDirectly()
+{
+    GridLevel& r_level = mLevels.back();
+    unsigned n = r_level.mTotalNumNodes;
+
+    // The residual is zero at Dirichlet nodes, so the correction leaves them unchanged
+    ComputeResidual(mLevels.size() - 1);
+    std::vector<double> correction = r_level.mResidual;
+
+    for (unsigned k=0; k<n; k++)
+    {
+        std::swap(correction[k], correction[mCoarsestPivots[k]]);
+    }
+    for (unsigned i=0; i<n; i++)
+    {
+        for (unsigned j=0; j<i; j++)
+        {
+            correction[i] -= mCoarsestFactors[i*n+j]*correction[j];
+        }
+    }
+    for (unsigned i=n; i-- > 0;)
+    {
+        for (unsigned j=i+1; j<n; j++)
+        {
+            correction[i] -= mCoarsestFactors[i*n+j]*correction[j];
+        }
+        correction[i] /= mCoarsestFactors[i*n+i];
+    }
+
+    for (unsigned i=0; i<n; i++)
+    {
+        r_level.mSolution[i] += correction[i];
+    }
+}
+
+template<unsigned DIM>
+void RegularGridMultigridSolver<DIM>::VCycle(unsigned levelIndex)
+{
+    GridLevel& r_level = mLevels[levelIndex];
+
+    if (levelIndex + 1 == mLevels.size())
+    {
+        if (mCoarsestLevelIsFactorised)
+        {
+            SolveCoarsestLevelDirectly();
+        }
+        else
+        {
+            // A singular coarsest operator is only smoothed, until the residual has been reduced substantially
+            double initial_norm = ComputeResidual(levelIndex);
+            double norm = initial_norm;
+            unsigned max_num_sweeps = 2*r_level.mTotalNumNodes + 10;
+            for (unsigned num_sweeps=0; norm > 1e-3*initial_norm && num_sweeps < max_num_sweeps; num_sweeps += 10)
+            {
+                Smooth(levelIndex, 10);
+                norm = ComputeResidual(levelIndex);
+            }
+        }
+    }
+    else
+    {
+        Smooth(levelIndex, mNumSmoothingSweeps);
+        ComputeResidual(levelIndex);
+        Restrict(levelIndex);
+        VCycle(levelIndex + 1);
+        ProlongateAndCorrect(levelIndex);
+        Smooth(levelIndex, mNumSmoothingSweeps);
+    }
+}
+
+// Explicit instantiation
+template class RegularGridMultigridSolver<1>;
+template class RegularGridMultigridSolver<2>;
+template class RegularGridMultigridSolver<3>;
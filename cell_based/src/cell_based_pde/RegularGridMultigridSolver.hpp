@@ -0,0 +1,393 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef REGULARGRIDMULTIGRIDSOLVER_HPP_
+#define REGULARGRIDMULTIGRIDSOLVER_HPP_
+
+#include <vector>
+#include "UblasVectorInclude.hpp"
+
+/**
+ * A matrix-free geometric multigrid solver for the linear finite difference problem
+ *
+ *   a(x) u - D Laplacian(u) = f(x)
+ *
+ * on a regular lattice of nodes with equal spacing in each direction, as used by the
+ * box domain PDE modifiers. The nodes are indexed with x varying fastest, then y, then z,
+ * matching the node ordering of the meshes generated by ConstructRegularSlabMesh().
+ *
+ * Nodes may be marked as Dirichlet nodes, whose values are held fixed. All other nodes on
+ * the edge of the lattice are given zero-flux conditions using a reflected ghost node;
+ * a non-zero flux may be imposed by adding GetNeumannBoundaryFactor() times the flux to
+ * the right-hand side.
+ *
+ * The solver uses V-cycles with red-black Gauss-Seidel smoothing, linear interpolation and
+ * its transpose for restriction, which is full weighting when a direction has an even number
+ * of intervals. Each coarser lattice covers the same box with about half as many intervals in
+ * every direction that has more than two, so any number of nodes can be coarsened; the
+ * spacing on coarse lattices may differ between directions. Coarsening stops once a lattice
+ * has at most MAX_NUM_COARSEST_NODES nodes, and the correction on that lattice is found by
+ * a dense LU factorisation.
+ *
+ * Each colour of a smoothing sweep, the residual, restriction and interpolation are loops
+ * over nodes in which each node is only written by its own iteration, so on lattices with
+ * at least MIN_NUM_NODES_TO_SHARE nodes they are shared between the threads of the
+ * ThreadPool singleton, if it has more than one. The result does not depend on the number
+ * of threads.
+ */
+template<unsigned DIM>
+class RegularGridMultigridSolver
+{
+    friend class TestRegularGridMultigridSolver;
+
+private:
+
+    /** The operator, unknowns and work vectors on one level of the multigrid hierarchy. */
+    struct GridLevel
+    {
+        /** The number of nodes in each direction. */
+        c_vector<unsigned, DIM> mNumNodes;
+
+        /** The offset in index between neighbouring nodes in each direction. */
+        c_vector<unsigned, DIM> mStrides;
+
+        /** The total number of nodes. */
+        unsigned mTotalNumNodes;
+
+        /** The spacing between neighbouring nodes in each direction. */
+        c_vector<double, DIM> mStepSizes;
+
+        /** The term a(x) at each node. */
+        std::vector<double> mDiagonalTerm;
+
+        /** Whether each node is held fixed. */
+        std::vector<bool> mIsDirichletNode;
+
+        /** The unknowns at each node. On coarse levels these are corrections. */
+        std::vector<double> mSolution;
+
+        /** The right-hand side at each node. */
+        std::vector<double> mRightHandSide;
+
+        /** The residual at each node. */
+        std::vector<double> mResidual;
+
+        /**
+         * For each direction and each coordinate on this level, the coordinate of the
+         * coarse node at or below it on the next coarser level. Empty on the coarsest level.
+         */
+        std::vector<std::vector<unsigned> > mCoarseLowerCoords;
+
+        /**
+         * For each direction and each coordinate on this level, the weight given to the coarse
+         * node above it when interpolating from the next coarser level. Empty on the coarsest level.
+         */
+        std::vector<std::vector<double> > mCoarseUpperWeights;
+
+        /**
+         * For each direction and each coordinate on the next coarser level, the coordinates on
+         * this level whose values are restricted to it. Empty on the coarsest level.
+         */
+        std::vector<std::vector<std::vector<unsigned> > > mRestrictionFineCoords;
+
+        /**
+         * For each direction and each coordinate on the next coarser level, the weights given
+         * to the values at mRestrictionFineCoords when restricting. Empty on the coarsest level.
+         */
+        std::vector<std::vector<std::vector<double> > > mRestrictionWeights;
+    };
+
+    /** The largest number of nodes on the coarsest level, where the correction is found directly. */
+    static const unsigned MAX_NUM_COARSEST_NODES = 125;
+
+    /** The smallest number of nodes in a loop for it to be shared between threads. */
+    static const unsigned MIN_NUM_NODES_TO_SHARE = 4096;
+
+    /** The levels of the multigrid hierarchy, finest first. */
+    std::vector<GridLevel> mLevels;
+
+    /** The diffusion coefficient D. */
+    double mDiffusionCoefficient;
+
+    /** The relative reduction in the residual norm at which to stop iterating. */
+    double mTolerance;
+
+    /** The maximum number of V-cycles before giving up. */
+    unsigned mMaxNumCycles;
+
+    /** The number of smoothing sweeps before and after each coarse grid correction. */
+    unsigned mNumSmoothingSweeps;
+
+    /** The number of V-cycles used in the last call to Solve(). */
+    unsigned mNumCyclesOfLastSolve;
+
+    /** The LU factors of the operator on the coarsest level, stored by row. */
+    std::vector<double> mCoarsestFactors;
+
+    /** The row interchanges made when factorising the operator on the coarsest level. */
+    std::vector<unsigned> mCoarsestPivots;
+
+    /**
+     * Whether the operator on the coarsest level was factorised. If it is singular, as it is
+     * with no Dirichlet nodes and a(x) = 0, the coarsest level is smoothed instead.
+     */
+    bool mCoarsestLevelIsFactorised;
+
+    /** The index of the level worked on by the loop being shared between threads. */
+    unsigned mTaskLevelIndex;
+
+    /** The colour of the nodes updated by the smoothing loop being shared between threads. */
+    unsigned mTaskColour;
+
+    /** The fine values restricted by the loop being shared between threads, or NULL between loops. */
+    const std::vector<double>* mpTaskFineValues;
+
+    /** The coarse values filled in by the restriction loop being shared between threads, or NULL between loops. */
+    std::vector<double>* mpTaskCoarseValues;
+
+    /**
+     * @return the off-diagonal entries D/h^2 of the operator on a given level in each direction.
+     *
+     * @param rLevel the level
+     */
+    c_vector<double, DIM> GetOffDiagonalTerms(const GridLevel& rLevel) const;
+
+    /**
+     * Assemble and factorise the operator on the coarsest level, setting mCoarsestLevelIsFactorised.
+     */
+    void FactoriseCoarsestOperator();
+
+    /**
+     * Add the solution of the coarsest level operator with the current residual as right-hand side
+     * to the unknowns on the coarsest level.
+     */
+    void SolveCoarsestLevelDirectly();
+
+    /**
+     * Run a loop over nodes, sharing it between the threads of the ThreadPool if it has at
+     * least MIN_NUM_NODES_TO_SHARE nodes. Any state used by the loop must be held in the
+     * members mTaskLevelIndex, mTaskColour, mpTaskFineValues and mpTaskCoarseValues.
+     *
+     * @param numNodes the number of nodes
+     * @param pMethod the member function that runs the loop over a contiguous range of nodes
+     */
+    void ShareLoopOverNodes(unsigned numNodes, void (RegularGridMultigridSolver<DIM>::*pMethod)(unsigned, unsigned));
+
+    /**
+     * Apply red-black Gauss-Seidel sweeps on a given level.
+     *
+     * @param levelIndex the index of the level
+     * @param numSweeps the number of sweeps (each sweep updates both colours)
+     */
+    void Smooth(unsigned levelIndex, unsigned numSweeps);
+
+    /**
+     * Update the nodes of colour mTaskColour in a contiguous range on level mTaskLevelIndex.
+     * Their neighbours all have the other colour, so different ranges may be updated concurrently.
+     *
+     * @param firstNodeIndex the index of the first node in the range
+     * @param endNodeIndex one past the index of the last node in the range
+     */
+    void SmoothNodes(unsigned firstNodeIndex, unsigned endNodeIndex);
+
+    /**
+     * Compute the residual f - A u on a given level, storing it in mResidual.
+     *
+     * @param levelIndex the index of the level
+     * @return the 2-norm of the residual
+     */
+    double ComputeResidual(unsigned levelIndex);
+
+    /**
+     * Compute the residual at a contiguous range of nodes on level mTaskLevelIndex.
+     *
+     * @param firstNodeIndex the index of the first node in the range
+     * @param endNodeIndex one past the index of the last node in the range
+     */
+    void ComputeResidualAtNodes(unsigned firstNodeIndex, unsigned endNodeIndex);
+
+    /**
+     * @return the lattice coordinates of a node.
+     *
+     * @param rLevel the level
+     * @param nodeIndex the index of the node
+     */
+    static c_vector<unsigned, DIM> GetCoordinates(const GridLevel& rLevel, unsigned nodeIndex);
+
+    /**
+     * Advance a set of lattice coordinates to those of the next node in index order.
+     *
+     * @param rCoords the lattice coordinates
+     * @param rNumNodes the number of nodes in each direction
+     */
+    static void IncrementCoordinates(c_vector<unsigned, DIM>& rCoords, const c_vector<unsigned, DIM>& rNumNodes);
+
+    /**
+     * Compute the sum of the values at the neighbours of a node, each weighted by the
+     * off-diagonal entry for its direction, reflecting across the edges of the lattice.
+     *
+     * @param rLevel the level
+     * @param nodeIndex the index of the node
+     * @param rCoords the lattice coordinates of the node
+     * @param rOffDiagonalTerms the off-diagonal entries in each direction
+     * @param rValues the nodal values
+     * @return the weighted sum of neighbouring values
+     */
+    double SumNeighbourValues(const GridLevel& rLevel,
+                              unsigned nodeIndex,
+                              const c_vector<unsigned, DIM>& rCoords,
+                              const c_vector<double, DIM>& rOffDiagonalTerms,
+                              const std::vector<double>& rValues) const;
+
+    /**
+     * Restrict nodal values from one level to the next coarser level with the transpose of
+     * interpolation, weighted so that a node on an edge of the lattice, whose equation comes
+     * from a reflected ghost node, is treated consistently. When the number of intervals is
+     * even this is full weighting.
+     *
+     * @param fineLevelIndex the index of the fine level
+     * @param rFineValues the values on the fine level
+     * @param rCoarseValues filled in with the values on the next coarser level
+     */
+    void ApplyFullWeighting(unsigned fineLevelIndex,
+                            const std::vector<double>& rFineValues,
+                            std::vector<double>& rCoarseValues);
+
+    /**
+     * Gather the values of mpTaskFineValues on level mTaskLevelIndex into a contiguous range
+     * of nodes of mpTaskCoarseValues on the next coarser level.
+     *
+     * @param firstNodeIndex the index of the first coarse node in the range
+     * @param endNodeIndex one past the index of the last coarse node in the range
+     */
+    void RestrictToNodes(unsigned firstNodeIndex, unsigned endNodeIndex);
+
+    /**
+     * Restrict the residual on level levelIndex onto the right-hand side of the next coarser level,
+     * and zero the coarse unknowns.
+     *
+     * @param levelIndex the index of the fine level
+     */
+    void Restrict(unsigned levelIndex);
+
+    /**
+     * Interpolate the coarse correction on level levelIndex+1 and add it to the unknowns on
+     * level levelIndex.
+     *
+     * @param levelIndex the index of the fine level
+     */
+    void ProlongateAndCorrect(unsigned levelIndex);
+
+    /**
+     * Interpolate the coarse correction on level mTaskLevelIndex+1 and add it to a contiguous
+     * range of nodes on level mTaskLevelIndex.
+     *
+     * @param firstNodeIndex the index of the first fine node in the range
+     * @param endNodeIndex one past the index of the last fine node in the range
+     */
+    void ProlongateToNodes(unsigned firstNodeIndex, unsigned endNodeIndex);
+
+    /**
+     * Perform one V-cycle starting at a given level.
+     *
+     * @param levelIndex the index of the level
+     */
+    void VCycle(unsigned levelIndex);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rNumNodes the number of nodes in each direction; each must be at least 2
+     * @param stepSize the spacing between neighbouring nodes
+     */
+    RegularGridMultigridSolver(const c_vector<unsigned, DIM>& rNumNodes, double stepSize);
+
+    /**
+     * @return the total number of nodes in the finest lattice.
+     */
+    unsigned GetNumNodes() const;
+
+    /**
+     * @return the number of levels in the multigrid hierarchy.
+     */
+    unsigned GetNumLevels() const;
+
+    /**
+     * @return the number of V-cycles used in the last call to Solve().
+     */
+    unsigned GetNumCyclesOfLastSolve() const;
+
+    /**
+     * Set mTolerance.
+     *
+     * @param tolerance the relative reduction in the residual norm at which to stop iterating
+     */
+    void SetTolerance(double tolerance);
+
+    /**
+     * Get the factor by which a prescribed outward flux D du/dn at a node must be multiplied
+     * before adding it to the right-hand side. This is zero for nodes in the interior of the lattice.
+     *
+     * @param nodeIndex the index of the node
+     * @return the factor
+     */
+    double GetNeumannBoundaryFactor(unsigned nodeIndex) const;
+
+    /**
+     * Set up the operator on every level of the hierarchy. This must be called before Solve()
+     * and whenever the coefficients or the set of Dirichlet nodes change.
+     *
+     * @param diffusionCoefficient the diffusion coefficient D
+     * @param rDiagonalTerm the term a(x) at each node
+     * @param rIsDirichletNode whether each node is held fixed
+     */
+    void SetUpOperator(double diffusionCoefficient,
+                       const std::vector<double>& rDiagonalTerm,
+                       const std::vector<bool>& rIsDirichletNode);
+
+    /**
+     * Solve the linear system.
+     *
+     * @param rRightHandSide the right-hand side f(x) at each node
+     * @param rSolution on entry, the initial guess, which must hold the prescribed values
+     *     at the Dirichlet nodes; on exit, the solution
+     */
+    void Solve(const std::vector<double>& rRightHandSide, std::vector<double>& rSolution);
+};
+
+#endif /*REGULARGRIDMULTIGRIDSOLVER_HPP_*/
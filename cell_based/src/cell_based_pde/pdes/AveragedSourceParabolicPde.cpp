@@ -55,6 +55,12 @@ const AbstractCellPopulation<DIM,DIM>& AveragedSourceParabolicPde<DIM>::rGetCell
     return mrCellPopulation;
 }
 
+template<unsigned DIM>
+double AveragedSourceParabolicPde<DIM>::GetCoefficient() const
+{
+    return mSourceCoefficient;
+}
+
 template<unsigned DIM>
 void AveragedSourceParabolicPde<DIM>::SetupSourceTerms(TetrahedralMesh<DIM,DIM>& rCoarseMesh, std::map<CellPtr, unsigned>* pCellPdeElementMap) // must be called before solve
 {
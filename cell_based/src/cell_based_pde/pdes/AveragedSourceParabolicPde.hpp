@@ -124,6 +124,11 @@ public:
      */
     const AbstractCellPopulation<DIM>& rGetCellPopulation() const;
 
+    /**
+     * @return mSourceCoefficient
+     */
+    double GetCoefficient() const;
+
     /**
      * Set up the source terms.
      *
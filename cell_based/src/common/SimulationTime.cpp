@@ -40,18 +40,27 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /** Pointer to the single instance */
 SimulationTime* SimulationTime::mpInstance = NULL;
 
-/** Shared pointer to the delegated class */
-boost::shared_ptr<TimeStepper> SimulationTime::mpTimeStepper;
+/** The location of the pointer to this thread's instance, if it does not use the shared one */
+CHASTE_THREAD_LOCAL SimulationTime** SimulationTime::mppThreadInstance = NULL;
+
+SimulationTime*& SimulationTime::rGetInstancePointer()
+{
+    return (mppThreadInstance == NULL) ? mpInstance : *mppThreadInstance;
+}
 
 SimulationTime* SimulationTime::Instance()
 {
-    if (mpInstance == NULL)
+    SimulationTime*& rp_instance = rGetInstancePointer();
+    if (rp_instance == NULL)
     {
-        mpInstance = new SimulationTime;
-        mpTimeStepper.reset();
-        std::atexit(Destroy);
+        rp_instance = new SimulationTime;
+        if (mppThreadInstance == NULL)
+        {
+            // Instances used by a single thread are freed by their owner
+            std::atexit(Destroy);
+        }
     }
-    return mpInstance;
+    return rp_instance;
 }
 
 SimulationTime::SimulationTime()
@@ -59,18 +68,26 @@ SimulationTime::SimulationTime()
       mStartTime(DOUBLE_UNSET)
 {
     // Make sure there's only one instance - enforces correct serialization
-    assert(mpInstance == NULL);
+    assert(rGetInstancePointer() == NULL);
 }
 
 void SimulationTime::Destroy()
 {
-    if (mpInstance)
+    SimulationTime*& rp_instance = rGetInstancePointer();
+    if (rp_instance)
     {
-        delete mpInstance;
-        mpInstance = NULL;
+        delete rp_instance;
+        rp_instance = NULL;
     }
 }
 
+SimulationTime** SimulationTime::SetThreadInstanceLocation(SimulationTime** ppInstance)
+{
+    SimulationTime** pp_previous_instance = mppThreadInstance;
+    mppThreadInstance = ppInstance;
+    return pp_previous_instance;
+}
+
 double SimulationTime::GetTimeStep() const
 {
     assert(mpTimeStepper);
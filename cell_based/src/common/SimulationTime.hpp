@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/shared_ptr.hpp>
 #include "SerializableSingleton.hpp"
+#include "ChasteThreadLocal.hpp"
 #include "TimeStepper.hpp"
 
 /**
@@ -121,6 +122,20 @@ public:
      */
     static void Destroy();
 
+    /**
+     * Make the calling thread use the instance pointed to from the given location,
+     * instead of the shared instance. This allows several simulations to be run at
+     * once in one process, each with its own simulation time; see SimulationContext.
+     * Instance() and Destroy() called on this thread then act on the pointer at this
+     * location, which may be NULL (in which case the next call to Instance will
+     * create a new instance there).
+     *
+     * @param ppInstance the location of this thread's instance pointer, or NULL to
+     *     use the shared instance again
+     * @return the location previously used by this thread, or NULL
+     */
+    static SimulationTime** SetThreadInstanceLocation(SimulationTime** ppInstance);
+
     /**
      * Allows lower classes to check whether the simulation time class has been set up before using it
      *
@@ -158,14 +173,26 @@ protected:
 
 private:
     /**
-     * A pointer to the singleton instance of this class.
+     * A pointer to the singleton instance of this class, shared by all threads
+     * that have not called SetThreadInstanceLocation().
      */
     static SimulationTime* mpInstance;
 
+    /**
+     * If not NULL, the location of the pointer to the instance used by this
+     * thread in place of mpInstance.
+     */
+    static CHASTE_THREAD_LOCAL SimulationTime** mppThreadInstance;
+
+    /**
+     * @return a reference to the pointer to the instance used by the calling thread.
+     */
+    static SimulationTime*& rGetInstancePointer();
+
     /**
      * Delegate all time stepping to a TimeStepper class
      */
-    static boost::shared_ptr<TimeStepper> mpTimeStepper;
+    boost::shared_ptr<TimeStepper> mpTimeStepper;
 
     /**
      * Stores the time at which the simulation started
@@ -0,0 +1,173 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "BenchmarkStepTimerModifier.hpp"
+
+#include <cassert>
+
+#include "CellBasedBenchmark.hpp"
+#include "CellBasedEventHandler.hpp"
+#include "Timer.hpp"
+
+template<unsigned DIM>
+BenchmarkStepTimerModifier<DIM>::BenchmarkStepTimerModifier(unsigned numWarmUpSteps, unsigned numMeasuredSteps)
+    : AbstractCellBasedSimulationModifier<DIM>(),
+      mNumWarmUpSteps(numWarmUpSteps),
+      mNumMeasuredSteps(numMeasuredSteps),
+      mNumStepsTaken(0),
+      mWallTime(0.0),
+      mNumCells(0.0),
+      mPeakMemory(0.0),
+      mPeakMemoryIsPerBenchmark(false)
+{
+    assert(mNumMeasuredSteps > 0);
+}
+
+template<unsigned DIM>
+BenchmarkStepTimerModifier<DIM>::~BenchmarkStepTimerModifier()
+{
+}
+
+template<unsigned DIM>
+void BenchmarkStepTimerModifier<DIM>::GetEventTimes(std::vector<double>& rEventTimes) const
+{
+    rEventTimes.resize(CellBasedEventHandler::EVERYTHING + 1);
+    for (unsigned event=0; event<rEventTimes.size(); event++)
+    {
+        // This includes the time so far in events that are still going on, such as EVERYTHING
+        rEventTimes[event] = CellBasedEventHandler::GetElapsedTime(event)/1000.0;
+    }
+}
+
+template<unsigned DIM>
+void BenchmarkStepTimerModifier<DIM>::StartTiming(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    mNumCells = rCellPopulation.GetNumRealCells();
+    GetEventTimes(mEventTimes);
+    mPeakMemoryIsPerBenchmark = CellBasedBenchmark::ResetPeakMemoryUsage();
+    mWallTime = Timer::GetWallTime();
+}
+
+template<unsigned DIM>
+void BenchmarkStepTimerModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    mNumStepsTaken++;
+
+    if (mNumStepsTaken == mNumWarmUpSteps)
+    {
+        StartTiming(rCellPopulation);
+    }
+    else if (mNumStepsTaken == mNumWarmUpSteps + mNumMeasuredSteps)
+    {
+        mWallTime = Timer::GetWallTime() - mWallTime;
+        mPeakMemory = CellBasedBenchmark::GetPeakMemoryUsage();
+
+        std::vector<double> event_times;
+        GetEventTimes(event_times);
+        for (unsigned event=0; event<event_times.size(); event++)
+        {
+            mEventTimes[event] = event_times[event] - mEventTimes[event];
+        }
+        mNumCells = 0.5*(mNumCells + rCellPopulation.GetNumRealCells());
+    }
+}
+
+template<unsigned DIM>
+void BenchmarkStepTimerModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
+{
+    mNumStepsTaken = 0;
+
+    // With no warm-up time steps, time from the start of the time loop
+    if (mNumWarmUpSteps == 0)
+    {
+        StartTiming(rCellPopulation);
+    }
+}
+
+template<unsigned DIM>
+bool BenchmarkStepTimerModifier<DIM>::HasFinished() const
+{
+    return mNumStepsTaken >= mNumWarmUpSteps + mNumMeasuredSteps;
+}
+
+template<unsigned DIM>
+double BenchmarkStepTimerModifier<DIM>::GetWallTime() const
+{
+    return mWallTime;
+}
+
+template<unsigned DIM>
+const std::vector<double>& BenchmarkStepTimerModifier<DIM>::rGetEventTimes() const
+{
+    return mEventTimes;
+}
+
+template<unsigned DIM>
+double BenchmarkStepTimerModifier<DIM>::GetNumCells() const
+{
+    return mNumCells;
+}
+
+template<unsigned DIM>
+double BenchmarkStepTimerModifier<DIM>::GetPeakMemory() const
+{
+    return mPeakMemory;
+}
+
+template<unsigned DIM>
+bool BenchmarkStepTimerModifier<DIM>::GetPeakMemoryIsPerBenchmark() const
+{
+    return mPeakMemoryIsPerBenchmark;
+}
+
+template<unsigned DIM>
+void BenchmarkStepTimerModifier<DIM>::OutputSimulationModifierParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<NumWarmUpSteps>" << mNumWarmUpSteps << "</NumWarmUpSteps>\n";
+    *rParamsFile << "\t\t\t<NumMeasuredSteps>" << mNumMeasuredSteps << "</NumMeasuredSteps>\n";
+
+    // Call method on direct parent class
+    AbstractCellBasedSimulationModifier<DIM>::OutputSimulationModifierParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class BenchmarkStepTimerModifier<1>;
+template class BenchmarkStepTimerModifier<2>;
+template class BenchmarkStepTimerModifier<3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(BenchmarkStepTimerModifier)
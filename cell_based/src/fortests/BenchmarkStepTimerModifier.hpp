@@ -0,0 +1,194 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef BENCHMARKSTEPTIMERMODIFIER_HPP_
+#define BENCHMARKSTEPTIMERMODIFIER_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include <vector>
+
+#include "AbstractCellBasedSimulationModifier.hpp"
+
+/**
+ * A modifier used by CellBasedBenchmark to time the main time loop of a simulation alone.
+ *
+ * It must be the last modifier of the simulation. At the end of a given number of warm-up
+ * time steps it records the wall time, the time spent so far in each CellBasedEventHandler
+ * event and the number of cells, and resets the record of the peak resident memory. It
+ * records them again at the end of a given number of further (measured) time steps, so that
+ * the differences cover exactly the measured time steps, excluding the setup of the
+ * simulation before the time loop and the tidying up after it.
+ */
+template<unsigned DIM>
+class BenchmarkStepTimerModifier : public AbstractCellBasedSimulationModifier<DIM,DIM>
+{
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Boost Serialization method for archiving/checkpointing.
+     * Archives the object and its member variables.
+     *
+     * @param archive  The boost archive.
+     * @param version  The current version of this class.
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractCellBasedSimulationModifier<DIM,DIM> >(*this);
+    }
+
+    /** The number of time steps before timing starts. */
+    unsigned mNumWarmUpSteps;
+
+    /** The number of time steps to time. */
+    unsigned mNumMeasuredSteps;
+
+    /** The number of time steps taken since SetupSolve() was called. */
+    unsigned mNumStepsTaken;
+
+    /** The wall time (in seconds) at the end of the warm-up time steps, and then the wall time of the measured time steps. */
+    double mWallTime;
+
+    /**
+     * The time (in seconds) spent in each CellBasedEventHandler event up to the end of the
+     * warm-up time steps, and then during the measured time steps.
+     */
+    std::vector<double> mEventTimes;
+
+    /** The mean number of cells at the start and end of the measured time steps. */
+    double mNumCells;
+
+    /** The peak resident memory (in megabytes) during the measured time steps. */
+    double mPeakMemory;
+
+    /** Whether mPeakMemory covers the measured time steps alone, rather than the life of the process. */
+    bool mPeakMemoryIsPerBenchmark;
+
+    /**
+     * Fill rEventTimes with the time (in seconds) spent so far in each CellBasedEventHandler event.
+     *
+     * @param rEventTimes the vector to fill
+     */
+    void GetEventTimes(std::vector<double>& rEventTimes) const;
+
+    /**
+     * Record the number of cells, the wall time and the time spent so far in each event,
+     * and reset the record of the peak resident memory, at the start of the measured time steps.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    void StartTiming(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param numWarmUpSteps the number of time steps before timing starts (defaults to 1)
+     * @param numMeasuredSteps the number of time steps to time (defaults to 1)
+     */
+    BenchmarkStepTimerModifier(unsigned numWarmUpSteps=1, unsigned numMeasuredSteps=1);
+
+    /**
+     * Destructor.
+     */
+    virtual ~BenchmarkStepTimerModifier();
+
+    /**
+     * Overridden UpdateAtEndOfTimeStep() method.
+     *
+     * Record the timings at the end of the warm-up and measured time steps.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Overridden SetupSolve() method.
+     *
+     * Start counting time steps.
+     *
+     * @param rCellPopulation reference to the cell population
+     * @param outputDirectory the output directory, relative to where Chaste output is stored
+     */
+    virtual void SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory);
+
+    /**
+     * @return whether the measured time steps have been completed since SetupSolve() was called.
+     */
+    bool HasFinished() const;
+
+    /**
+     * @return the wall time (in seconds) taken by the measured time steps.
+     */
+    double GetWallTime() const;
+
+    /**
+     * @return the time (in seconds) spent in each CellBasedEventHandler event during the measured time steps.
+     */
+    const std::vector<double>& rGetEventTimes() const;
+
+    /**
+     * @return the mean number of cells at the start and end of the measured time steps.
+     */
+    double GetNumCells() const;
+
+    /**
+     * @return the peak resident memory (in megabytes) during the measured time steps.
+     */
+    double GetPeakMemory() const;
+
+    /**
+     * @return whether GetPeakMemory() covers the measured time steps alone, rather than
+     * the life of the process.
+     */
+    bool GetPeakMemoryIsPerBenchmark() const;
+
+    /**
+     * Overridden OutputSimulationModifierParameters() method.
+     * Output any simulation modifier parameters to file.
+     *
+     * @param rParamsFile the file stream to which the parameters are output
+     */
+    void OutputSimulationModifierParameters(out_stream& rParamsFile);
+};
+
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(BenchmarkStepTimerModifier)
+
+#endif /*BENCHMARKSTEPTIMERMODIFIER_HPP_*/
@@ -0,0 +1,219 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "CellBasedBenchmark.hpp"
+
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#ifndef _MSC_VER
+#include <sys/resource.h> // For memory profiling
+#endif //_MSC_VER
+
+#include "BenchmarkStepTimerModifier.hpp"
+#include "CellBasedEventHandler.hpp"
+#include "Exception.hpp"
+#include "OutputFileHandler.hpp"
+#include "PetscTools.hpp"
+#include "SimulationTime.hpp"
+
+CellBasedBenchmark::CellBasedBenchmark(const std::string& rOutputDirectory,
+                                       unsigned numWarmUpSteps,
+                                       unsigned numMeasuredSteps)
+    : mOutputDirectory(rOutputDirectory),
+      mNumWarmUpSteps(numWarmUpSteps),
+      mNumMeasuredSteps(numMeasuredSteps),
+      mResultsHeaderWritten(false),
+      mNumCells(0.0),
+      mWallTime(0.0),
+      mPeakMemory(0.0),
+      mPeakMemoryIsPerBenchmark(false)
+{
+    assert(mNumWarmUpSteps > 0);
+    assert(mNumMeasuredSteps > 0);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellBasedBenchmark::Run(const std::string& rName, AbstractCellBasedSimulation<ELEMENT_DIM, SPACE_DIM>& rSimulator)
+{
+    double dt = rSimulator.GetDt();
+    double start_time = SimulationTime::Instance()->GetTime();
+
+    /*
+     * Solve once, timing the measured time steps with a modifier that runs after any others
+     * at the end of each time step, so that neither setting up the simulation before the
+     * time loop nor tidying up after it is timed.
+     */
+    boost::shared_ptr<BenchmarkStepTimerModifier<SPACE_DIM> > p_timer(
+        new BenchmarkStepTimerModifier<SPACE_DIM>(mNumWarmUpSteps, mNumMeasuredSteps));
+    rSimulator.AddSimulationModifier(p_timer);
+    rSimulator.SetEndTime(start_time + (mNumWarmUpSteps + mNumMeasuredSteps)*dt);
+    try
+    {
+        rSimulator.Solve();
+    }
+    catch (Exception&)
+    {
+        rSimulator.GetSimulationModifiers()->pop_back();
+        throw;
+    }
+    rSimulator.GetSimulationModifiers()->pop_back();
+
+    if (!p_timer->HasFinished())
+    {
+        EXCEPTION("The simulation stopped before the measured time steps of benchmark " + rName + " were completed.");
+    }
+
+    mWallTime = p_timer->GetWallTime();
+    mEventTimes = p_timer->rGetEventTimes();
+    mNumCells = p_timer->GetNumCells();
+    mPeakMemory = p_timer->GetPeakMemory();
+    mPeakMemoryIsPerBenchmark = p_timer->GetPeakMemoryIsPerBenchmark();
+
+    std::cout << rName << ": " << mNumCells << " cells, " << GetCellStepsPerSecond()
+              << " cell steps per second, " << mPeakMemory << " Mb peak memory\n" << std::flush;
+
+    WriteResults(rName);
+}
+
+void CellBasedBenchmark::WriteResults(const std::string& rName)
+{
+    if (!PetscTools::AmMaster())
+    {
+        return;
+    }
+
+    OutputFileHandler output_file_handler(mOutputDirectory, false);
+    out_stream p_file;
+    if (mResultsHeaderWritten)
+    {
+        p_file = output_file_handler.OpenOutputFile("benchmark_results.csv", std::ios::app);
+    }
+    else
+    {
+        p_file = output_file_handler.OpenOutputFile("benchmark_results.csv");
+        *p_file << "name,num_cells,warm_up_steps,measured_steps,wall_time_s,cell_steps_per_second,peak_memory_mb,peak_memory_scope";
+        for (unsigned event=0; event<mEventTimes.size(); event++)
+        {
+            *p_file << "," << CellBasedEventHandler::EventName[event] << "_s";
+        }
+        *p_file << "\n";
+        mResultsHeaderWritten = true;
+    }
+
+    *p_file << rName << "," << mNumCells << "," << mNumWarmUpSteps << "," << mNumMeasuredSteps << ","
+            << mWallTime << "," << GetCellStepsPerSecond() << "," << mPeakMemory << ","
+            << (mPeakMemoryIsPerBenchmark ? "benchmark" : "process");
+    for (unsigned event=0; event<mEventTimes.size(); event++)
+    {
+        *p_file << "," << mEventTimes[event];
+    }
+    *p_file << "\n";
+    p_file->close();
+}
+
+double CellBasedBenchmark::GetNumCells() const
+{
+    return mNumCells;
+}
+
+double CellBasedBenchmark::GetWallTime() const
+{
+    return mWallTime;
+}
+
+double CellBasedBenchmark::GetCellStepsPerSecond() const
+{
+    return (mWallTime > 0.0) ? mNumCells*mNumMeasuredSteps/mWallTime : 0.0;
+}
+
+const std::vector<double>& CellBasedBenchmark::rGetEventTimes() const
+{
+    return mEventTimes;
+}
+
+double CellBasedBenchmark::GetPeakMemory() const
+{
+    return mPeakMemory;
+}
+
+bool CellBasedBenchmark::GetPeakMemoryIsPerBenchmark() const
+{
+    return mPeakMemoryIsPerBenchmark;
+}
+
+bool CellBasedBenchmark::ResetPeakMemoryUsage()
+{
+    // Writing 5 to clear_refs resets the peak resident set size (Linux 4.0 and later)
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (!clear_refs.is_open())
+    {
+        return false;
+    }
+    clear_refs << "5";
+    clear_refs.close();
+    return !clear_refs.fail();
+}
+
+double CellBasedBenchmark::GetPeakMemoryUsage()
+{
+    // On Linux, the peak resident set size (which may have been reset) is given as VmHWM in kB
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+        {
+            std::istringstream value(line.substr(6));
+            double memory_kb = 0.0;
+            value >> memory_kb;
+            return memory_kb/1024.0;
+        }
+    }
+
+    // Otherwise use the peak over the life of the process
+    double memory = 0.0;
+#ifndef _MSC_VER
+    struct rusage rusage;
+    getrusage(RUSAGE_SELF, &rusage);
+    memory = double(rusage.ru_maxrss)/1024.0;
+#endif //_MSC_VER
+    return memory;
+}
+
+// Explicit instantiation
+template void CellBasedBenchmark::Run(const std::string&, AbstractCellBasedSimulation<1,1>&);
+template void CellBasedBenchmark::Run(const std::string&, AbstractCellBasedSimulation<2,2>&);
+template void CellBasedBenchmark::Run(const std::string&, AbstractCellBasedSimulation<3,3>&);
@@ -0,0 +1,180 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLBASEDBENCHMARK_HPP_
+#define CELLBASEDBENCHMARK_HPP_
+
+#include <string>
+#include <vector>
+
+#include "AbstractCellBasedSimulation.hpp"
+
+/**
+ * A helper class for benchmarking cell-based simulations, used by TestCellBasedBenchmarks.
+ *
+ * Each call to Run() solves a simulation for a number of warm-up time steps, which
+ * are not timed, and then for a number of measured time steps. Only the main time loop
+ * is timed, using a BenchmarkStepTimerModifier, so setting up the simulation and tidying
+ * up after it are excluded. The throughput (cells times time steps per second of wall
+ * time), the peak resident memory and the time spent in each CellBasedEventHandler
+ * event during the measured time steps are recorded, and
+ * appended as a line to the CSV file benchmark_results.csv in the output
+ * directory. The file is rewritten, with a header line, by the first call to Run() on
+ * each object. The script python/utils/CompareCellBasedBenchmarks.py compares two such
+ * files.
+ *
+ * The peak memory is the high-water mark of the resident set size over the measured time
+ * steps alone, which is obtained on Linux by resetting the kernel's record of the peak at
+ * the end of the warm-up time steps. Where this is not possible the peak over the life of
+ * the process is reported instead, which also covers any earlier benchmarks run by the
+ * same process. The column peak_memory_scope of the results file says which ("benchmark"
+ * or "process").
+ */
+class CellBasedBenchmark
+{
+private:
+
+    /** The output directory for the results file, relative to CHASTE_TEST_OUTPUT. */
+    std::string mOutputDirectory;
+
+    /** The number of time steps to solve for before timing. */
+    unsigned mNumWarmUpSteps;
+
+    /** The number of time steps to time. */
+    unsigned mNumMeasuredSteps;
+
+    /**
+     * Whether this object has written the header line of the results file, so that
+     * further results are appended to it.
+     */
+    bool mResultsHeaderWritten;
+
+    /** The mean number of cells over the measured time steps of the last run. */
+    double mNumCells;
+
+    /** The wall time (in seconds) taken by the measured time steps of the last run. */
+    double mWallTime;
+
+    /** The time (in seconds) spent in each CellBasedEventHandler event in the last run. */
+    std::vector<double> mEventTimes;
+
+    /** The peak resident memory (in megabytes) during the measured time steps of the last run. */
+    double mPeakMemory;
+
+    /**
+     * Whether mPeakMemory covers the measured time steps of the last run alone, rather
+     * than the life of the process.
+     */
+    bool mPeakMemoryIsPerBenchmark;
+
+    /**
+     * Append the results of the last run to the results file.
+     *
+     * @param rName the name of the benchmark
+     */
+    void WriteResults(const std::string& rName);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rOutputDirectory the output directory for the results file
+     * @param numWarmUpSteps the number of time steps to solve for before timing (must be positive)
+     * @param numMeasuredSteps the number of time steps to time (must be positive)
+     */
+    CellBasedBenchmark(const std::string& rOutputDirectory,
+                       unsigned numWarmUpSteps=5,
+                       unsigned numMeasuredSteps=25);
+
+    /**
+     * Run a benchmark. The simulation must be set up, including its output directory and
+     * time step, but must not have been solved. Its end time is set by this method, and a
+     * BenchmarkStepTimerModifier is added to it while it is solved.
+     *
+     * @param rName the name of the benchmark, which must not contain commas
+     * @param rSimulator the simulation
+     */
+    template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+    void Run(const std::string& rName, AbstractCellBasedSimulation<ELEMENT_DIM, SPACE_DIM>& rSimulator);
+
+    /**
+     * @return the mean number of cells over the measured time steps of the last run.
+     */
+    double GetNumCells() const;
+
+    /**
+     * @return the wall time (in seconds) taken by the measured time steps of the last run.
+     */
+    double GetWallTime() const;
+
+    /**
+     * @return the throughput of the last run, in cells times time steps per second.
+     */
+    double GetCellStepsPerSecond() const;
+
+    /**
+     * @return the time (in seconds) spent in each CellBasedEventHandler event in the last run.
+     */
+    const std::vector<double>& rGetEventTimes() const;
+
+    /**
+     * @return the peak resident memory (in megabytes) during the measured time steps of the last run.
+     */
+    double GetPeakMemory() const;
+
+    /**
+     * @return whether GetPeakMemory() covers the measured time steps of the last run alone,
+     * rather than the life of the process.
+     */
+    bool GetPeakMemoryIsPerBenchmark() const;
+
+    /**
+     * Reset the record of the peak resident memory of this process to its current resident
+     * memory, so that GetPeakMemoryUsage() returns the peak from now on. This is only
+     * possible on Linux.
+     *
+     * @return whether the record was reset.
+     */
+    static bool ResetPeakMemoryUsage();
+
+    /**
+     * @return the peak resident memory of this process, in megabytes, since it started or
+     * ResetPeakMemoryUsage() was last called, or 0 if this is not available on this platform.
+     */
+    static double GetPeakMemoryUsage();
+};
+
+#endif /*CELLBASEDBENCHMARK_HPP_*/
@@ -137,6 +137,8 @@ void PottsMesh<DIM>::Clear()
 
     mDeletedElementIndices.clear();
 
+    InvalidateLatticeState();
+
     // Delete neighbour info
     //mVonNeumannNeighbouringNodeIndices.clear();
     //mMooreNeighbouringNodeIndices.clear();
@@ -243,12 +245,210 @@ std::set<unsigned> PottsMesh<DIM>::GetVonNeumannNeighbouringNodeIndices(unsigned
     return mVonNeumannNeighbouringNodeIndices[nodeIndex];
 }
 
+template<unsigned DIM>
+void PottsMesh<DIM>::InvalidateLatticeState()
+{
+    mLatticeStateIsValid = false;
+}
+
+template<unsigned DIM>
+void PottsMesh<DIM>::UpdateLatticeState()
+{
+    unsigned num_nodes = this->mNodes.size();
+    assert(mMooreNeighbouringNodeIndices.size() == num_nodes);
+    assert(mVonNeumannNeighbouringNodeIndices.size() == num_nodes);
+
+    // Flatten the neighbour sets into fixed-size tables, preserving their ordering
+    mMaxNumMooreNeighbours = 0;
+    mMaxNumVonNeumannNeighbours = 0;
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        mMaxNumMooreNeighbours = std::max(mMaxNumMooreNeighbours, (unsigned)mMooreNeighbouringNodeIndices[node_index].size());
+        mMaxNumVonNeumannNeighbours = std::max(mMaxNumVonNeumannNeighbours, (unsigned)mVonNeumannNeighbouringNodeIndices[node_index].size());
+    }
+
+    mMooreNeighbourTable.assign(num_nodes*mMaxNumMooreNeighbours, UINT_MAX);
+    mVonNeumannNeighbourTable.assign(num_nodes*mMaxNumVonNeumannNeighbours, UINT_MAX);
+    mNumMooreNeighbours.resize(num_nodes);
+    mNumVonNeumannNeighbours.resize(num_nodes);
+    mNodeElementIndices.assign(num_nodes, UINT_MAX);
+
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        mNumMooreNeighbours[node_index] = mMooreNeighbouringNodeIndices[node_index].size();
+        std::copy(mMooreNeighbouringNodeIndices[node_index].begin(),
+                  mMooreNeighbouringNodeIndices[node_index].end(),
+                  mMooreNeighbourTable.begin() + node_index*mMaxNumMooreNeighbours);
+
+        mNumVonNeumannNeighbours[node_index] = mVonNeumannNeighbouringNodeIndices[node_index].size();
+        std::copy(mVonNeumannNeighbouringNodeIndices[node_index].begin(),
+                  mVonNeumannNeighbouringNodeIndices[node_index].end(),
+                  mVonNeumannNeighbourTable.begin() + node_index*mMaxNumVonNeumannNeighbours);
+
+        // Each node in the mesh must be in at most one element
+        const std::set<unsigned>& r_containing_elements = this->mNodes[node_index]->rGetContainingElementIndices();
+        assert(r_containing_elements.size() <= 1);
+        if (!r_containing_elements.empty())
+        {
+            mNodeElementIndices[node_index] = *(r_containing_elements.begin());
+        }
+    }
+
+    // Each node contributes 2*DIM faces to its element, less one for each Von Neumann neighbour in the same element
+    mElementSurfaceAreas.assign(mElements.size(), 0);
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        unsigned elem_index = mNodeElementIndices[node_index];
+        if (elem_index != UINT_MAX)
+        {
+            unsigned num_faces = 2*DIM;
+            const unsigned* p_neighbours = &mVonNeumannNeighbourTable[node_index*mMaxNumVonNeumannNeighbours];
+            for (unsigned i=0; i<mNumVonNeumannNeighbours[node_index]; i++)
+            {
+                if (mNodeElementIndices[p_neighbours[i]] == elem_index && num_faces != 0)
+                {
+                    num_faces--;
+                }
+            }
+            mElementSurfaceAreas[elem_index] += num_faces;
+        }
+    }
+
+    mLatticeStateIsValid = true;
+}
+
+template<unsigned DIM>
+unsigned PottsMesh<DIM>::GetContainingElementIndexOfNode(unsigned nodeIndex)
+{
+    if (!mLatticeStateIsValid)
+    {
+        UpdateLatticeState();
+    }
+    assert(nodeIndex < mNodeElementIndices.size());
+    return mNodeElementIndices[nodeIndex];
+}
+
+template<unsigned DIM>
+unsigned PottsMesh<DIM>::GetNumMooreNeighbours(unsigned nodeIndex)
+{
+    if (!mLatticeStateIsValid)
+    {
+        UpdateLatticeState();
+    }
+    assert(nodeIndex < mNumMooreNeighbours.size());
+    return mNumMooreNeighbours[nodeIndex];
+}
+
+template<unsigned DIM>
+unsigned PottsMesh<DIM>::GetMooreNeighbour(unsigned nodeIndex, unsigned localIndex)
+{
+    if (!mLatticeStateIsValid)
+    {
+        UpdateLatticeState();
+    }
+    assert(localIndex < mNumMooreNeighbours[nodeIndex]);
+    return mMooreNeighbourTable[nodeIndex*mMaxNumMooreNeighbours + localIndex];
+}
+
+template<unsigned DIM>
+unsigned PottsMesh<DIM>::GetNumVonNeumannNeighbours(unsigned nodeIndex)
+{
+    if (!mLatticeStateIsValid)
+    {
+        UpdateLatticeState();
+    }
+    assert(nodeIndex < mNumVonNeumannNeighbours.size());
+    return mNumVonNeumannNeighbours[nodeIndex];
+}
+
+template<unsigned DIM>
+unsigned PottsMesh<DIM>::GetVonNeumannNeighbour(unsigned nodeIndex, unsigned localIndex)
+{
+    if (!mLatticeStateIsValid)
+    {
+        UpdateLatticeState();
+    }
+    assert(localIndex < mNumVonNeumannNeighbours[nodeIndex]);
+    return mVonNeumannNeighbourTable[nodeIndex*mMaxNumVonNeumannNeighbours + localIndex];
+}
+
+template<unsigned DIM>
+double PottsMesh<DIM>::GetCachedSurfaceAreaOfElement(unsigned index)
+{
+    if (!mLatticeStateIsValid)
+    {
+        UpdateLatticeState();
+    }
+    assert(index < mElementSurfaceAreas.size());
+    return (double) mElementSurfaceAreas[index];
+}
+
+template<unsigned DIM>
+void PottsMesh<DIM>::MoveNodeToElement(unsigned nodeIndex, unsigned newElementIndex)
+{
+    if (!mLatticeStateIsValid)
+    {
+        UpdateLatticeState();
+    }
+
+    unsigned old_element_index = mNodeElementIndices[nodeIndex];
+    if (old_element_index == newElementIndex)
+    {
+        return;
+    }
+
+    /*
+     * Count the Von Neumann neighbours of the node in the old and new elements. Removing
+     * a node with k such neighbours from an element changes its surface area by 2k-2*DIM,
+     * and adding it changes the surface area by 2*DIM-2k.
+     */
+    unsigned num_neighbours_in_old_element = 0;
+    unsigned num_neighbours_in_new_element = 0;
+    const unsigned* p_neighbours = &mVonNeumannNeighbourTable[nodeIndex*mMaxNumVonNeumannNeighbours];
+    for (unsigned i=0; i<mNumVonNeumannNeighbours[nodeIndex]; i++)
+    {
+        unsigned neighbour_element_index = mNodeElementIndices[p_neighbours[i]];
+        if (neighbour_element_index != UINT_MAX)
+        {
+            if (neighbour_element_index == old_element_index)
+            {
+                num_neighbours_in_old_element++;
+            }
+            else if (neighbour_element_index == newElementIndex)
+            {
+                num_neighbours_in_new_element++;
+            }
+        }
+    }
+
+    Node<DIM>* p_node = this->mNodes[nodeIndex];
+    if (old_element_index != UINT_MAX)
+    {
+        PottsElement<DIM>* p_old_element = mElements[old_element_index];
+        p_old_element->DeleteNode(p_old_element->GetNodeLocalIndex(nodeIndex));
+
+        assert(mElementSurfaceAreas[old_element_index] + 2*num_neighbours_in_old_element >= 2*DIM);
+        mElementSurfaceAreas[old_element_index] += 2*num_neighbours_in_old_element;
+        mElementSurfaceAreas[old_element_index] -= 2*DIM;
+    }
+    if (newElementIndex != UINT_MAX)
+    {
+        mElements[newElementIndex]->AddNode(p_node);
+
+        assert(mElementSurfaceAreas[newElementIndex] + 2*DIM >= 2*num_neighbours_in_new_element);
+        mElementSurfaceAreas[newElementIndex] += 2*DIM;
+        mElementSurfaceAreas[newElementIndex] -= 2*num_neighbours_in_new_element;
+    }
+    mNodeElementIndices[nodeIndex] = newElementIndex;
+}
+
 template<unsigned DIM>
 void PottsMesh<DIM>::DeleteElement(unsigned index)
 {
     // Mark this element as deleted; this also updates the nodes containing element indices
     this->mElements[index]->MarkAsDeleted();
     mDeletedElementIndices.push_back(index);
+    InvalidateLatticeState();
 }
 
 template<unsigned DIM>
@@ -268,6 +468,7 @@ void PottsMesh<DIM>::RemoveDeletedElements()
         }
     }
     mDeletedElementIndices.clear();
+    InvalidateLatticeState();
 }
 
 template<unsigned DIM>
@@ -382,6 +583,7 @@ void PottsMesh<DIM>::DeleteNode(unsigned index)
             mElements[elem_index]->ResetIndex(elem_index);
         }
     }
+    InvalidateLatticeState();
 }
 
 template<unsigned DIM>
@@ -419,7 +621,7 @@ unsigned PottsMesh<DIM>::DivideElement(PottsElement<DIM>* pElement,
         delete this->mElements[new_element_index];
     }
 
-    // Add the new element to the mesh
+    // Add the new element to the mesh (this also invalidates the lattice state)
     AddElement(new PottsElement<DIM>(new_element_index, nodes_elem));
 
     /**
@@ -525,6 +727,7 @@ unsigned PottsMesh<DIM>::AddElement(PottsElement<DIM>* pNewElement)
         this->mElements[new_element_index] = pNewElement;
     }
     pNewElement->RegisterWithNodes();
+    InvalidateLatticeState();
     return pNewElement->GetIndex();
 }
 
@@ -637,6 +840,8 @@ void PottsMesh<DIM>::ConstructFromMeshReader(AbstractMeshReader<DIM, DIM>& rMesh
     {
         mMooreNeighbouringNodeIndices.resize(num_nodes);
     }
+
+    InvalidateLatticeState();
 }
 
 // Explicit instantiation
@@ -80,6 +80,53 @@ protected:
     /** Vector of set of Moore neighbours for each node. */
     std::vector< std::set<unsigned> > mMooreNeighbouringNodeIndices;
 
+    /**
+     * Whether the flat lattice state below is consistent with the elements
+     * and neighbour sets of the mesh. This is reset whenever the mesh is
+     * modified other than through MoveNodeToElement().
+     */
+    bool mLatticeStateIsValid;
+
+    /**
+     * The index of the element containing each node, or UINT_MAX if the node
+     * is in the medium. Part of the lattice state.
+     */
+    std::vector<unsigned> mNodeElementIndices;
+
+    /** The maximum number of Moore neighbours of any node, i.e. the row length of mMooreNeighbourTable. */
+    unsigned mMaxNumMooreNeighbours;
+
+    /** The maximum number of Von Neumann neighbours of any node, i.e. the row length of mVonNeumannNeighbourTable. */
+    unsigned mMaxNumVonNeumannNeighbours;
+
+    /**
+     * Fixed-size table of Moore neighbours, stored row-wise with mMaxNumMooreNeighbours
+     * entries per node in the same (ascending) order as mMooreNeighbouringNodeIndices.
+     * Part of the lattice state.
+     */
+    std::vector<unsigned> mMooreNeighbourTable;
+
+    /** Fixed-size table of Von Neumann neighbours, laid out as mMooreNeighbourTable. */
+    std::vector<unsigned> mVonNeumannNeighbourTable;
+
+    /** The number of Moore neighbours of each node. Part of the lattice state. */
+    std::vector<unsigned> mNumMooreNeighbours;
+
+    /** The number of Von Neumann neighbours of each node. Part of the lattice state. */
+    std::vector<unsigned> mNumVonNeumannNeighbours;
+
+    /**
+     * The surface area (or perimeter in 2D) of each element, as given by
+     * GetSurfaceAreaOfElement(). Part of the lattice state.
+     */
+    std::vector<unsigned> mElementSurfaceAreas;
+
+    /**
+     * Recompute the lattice state (mNodeElementIndices, the neighbour tables and
+     * mElementSurfaceAreas) from the elements and neighbour sets of the mesh.
+     */
+    void UpdateLatticeState();
+
     /**
      * Solve node mapping method. This overridden method is required
      * as it is pure virtual in the base class.
@@ -284,6 +331,74 @@ public:
      */
     std::set<unsigned> GetVonNeumannNeighbouringNodeIndices(unsigned nodeIndex);
 
+    /**
+     * Mark the lattice state as out of date, so that it is recomputed the next time
+     * it is accessed. This must be called by any code that changes which element
+     * contains a node other than through MoveNodeToElement().
+     */
+    void InvalidateLatticeState();
+
+    /**
+     * Get the index of the element containing a given node. Unlike
+     * rGetContainingElementIndices() on the node, this does not involve a std::set.
+     *
+     * @param nodeIndex global index of the node
+     * @return the index of the element containing the node, or UINT_MAX if the node is in the medium
+     */
+    unsigned GetContainingElementIndexOfNode(unsigned nodeIndex);
+
+    /**
+     * @param nodeIndex global index of the node
+     * @return the number of Moore neighbours of the node
+     */
+    unsigned GetNumMooreNeighbours(unsigned nodeIndex);
+
+    /**
+     * Get a Moore neighbour of a node. Neighbours are ordered as in the set
+     * returned by GetMooreNeighbouringNodeIndices().
+     *
+     * @param nodeIndex global index of the node
+     * @param localIndex index of the neighbour, less than GetNumMooreNeighbours(nodeIndex)
+     * @return the global index of the neighbouring node
+     */
+    unsigned GetMooreNeighbour(unsigned nodeIndex, unsigned localIndex);
+
+    /**
+     * @param nodeIndex global index of the node
+     * @return the number of Von Neumann neighbours of the node
+     */
+    unsigned GetNumVonNeumannNeighbours(unsigned nodeIndex);
+
+    /**
+     * Get a Von Neumann neighbour of a node. Neighbours are ordered as in the set
+     * returned by GetVonNeumannNeighbouringNodeIndices().
+     *
+     * @param nodeIndex global index of the node
+     * @param localIndex index of the neighbour, less than GetNumVonNeumannNeighbours(nodeIndex)
+     * @return the global index of the neighbouring node
+     */
+    unsigned GetVonNeumannNeighbour(unsigned nodeIndex, unsigned localIndex);
+
+    /**
+     * Get the surface area (or perimeter in 2D) of a PottsElement from the lattice state.
+     * This gives the same value as GetSurfaceAreaOfElement() in constant time.
+     *
+     * @param index  the global index of a specified PottsElement
+     * @return the surface area of the element
+     */
+    double GetCachedSurfaceAreaOfElement(unsigned index);
+
+    /**
+     * Move a node from the element currently containing it (if any) to another
+     * element (or to the medium), incrementally updating the lattice state. This
+     * is used to perform a spin flip in a Monte Carlo sweep.
+     *
+     * @param nodeIndex global index of the node
+     * @param newElementIndex index of the element that should contain the node,
+     *     or UINT_MAX to move the node into the medium
+     */
+    void MoveNodeToElement(unsigned nodeIndex, unsigned newElementIndex);
+
     /**
      * Mark a node as deleted. Note that in a Potts mesh this requires the elements and connectivity to be updated accordingley.
      *
@@ -0,0 +1,124 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "DeltaNotchOdeBatch.hpp"
+
+#include <cassert>
+
+#include "ThreadPool.hpp"
+#include "TimeStepper.hpp"
+
+DeltaNotchOdeBatch::DeltaNotchOdeBatch(double startTime, double endTime, double dt)
+    : mStartTime(startTime),
+      mEndTime(endTime),
+      mDt(dt)
+{
+    assert(endTime > startTime);
+    assert(dt > 0.0);
+}
+
+unsigned DeltaNotchOdeBatch::AddSystem(double notch, double delta, double meanDelta)
+{
+    mNotch.push_back(notch);
+    mDelta.push_back(delta);
+
+    // As in DeltaNotchOdeSystem::EvaluateYDerivatives()
+    mNotchProduction.push_back(meanDelta*meanDelta/(0.01 + meanDelta*meanDelta));
+
+    return mNotch.size() - 1;
+}
+
+unsigned DeltaNotchOdeBatch::GetNumSystems() const
+{
+    return mNotch.size();
+}
+
+void DeltaNotchOdeBatch::Solve()
+{
+    ThreadPool::Instance()->ParallelFor(mNotch.size(), *this);
+}
+
+void DeltaNotchOdeBatch::Execute(unsigned begin, unsigned end)
+{
+    TimeStepper stepper(mStartTime, mEndTime, mDt);
+    while (!stepper.IsTimeAtEnd())
+    {
+        const double h = stepper.GetNextTimeStep();
+
+        for (unsigned i=begin; i<end; i++)
+        {
+            const double notch = mNotch[i];
+            const double delta = mDelta[i];
+            const double notch_production = mNotchProduction[i];
+
+            // The stages are those of RungeKutta4IvpOdeSolver::CalculateNextYValue()
+            const double k1_notch = h*(notch_production - notch);
+            const double k1_delta = h*(1.0/(1.0 + 100.0*notch*notch) - delta);
+
+            double notch_k = notch + 0.5*k1_notch;
+            double delta_k = delta + 0.5*k1_delta;
+            const double k2_notch = h*(notch_production - notch_k);
+            const double k2_delta = h*(1.0/(1.0 + 100.0*notch_k*notch_k) - delta_k);
+
+            notch_k = notch + 0.5*k2_notch;
+            delta_k = delta + 0.5*k2_delta;
+            const double k3_notch = h*(notch_production - notch_k);
+            const double k3_delta = h*(1.0/(1.0 + 100.0*notch_k*notch_k) - delta_k);
+
+            notch_k = notch + k3_notch;
+            delta_k = delta + k3_delta;
+            const double k4_notch = h*(notch_production - notch_k);
+            const double k4_delta = h*(1.0/(1.0 + 100.0*notch_k*notch_k) - delta_k);
+
+            mNotch[i] = notch + (k1_notch + 2*k2_notch + 2*k3_notch + k4_notch)/6.0;
+            mDelta[i] = delta + (k1_delta + 2*k2_delta + 2*k3_delta + k4_delta)/6.0;
+        }
+
+        stepper.AdvanceOneTimeStep();
+    }
+}
+
+double DeltaNotchOdeBatch::GetNotch(unsigned index) const
+{
+    assert(index < mNotch.size());
+    return mNotch[index];
+}
+
+double DeltaNotchOdeBatch::GetDelta(unsigned index) const
+{
+    assert(index < mDelta.size());
+    return mDelta[index];
+}
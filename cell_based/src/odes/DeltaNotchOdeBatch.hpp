@@ -0,0 +1,129 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef DELTANOTCHODEBATCH_HPP_
+#define DELTANOTCHODEBATCH_HPP_
+
+#include <vector>
+
+#include "AbstractThreadPoolTask.hpp"
+
+/**
+ * Integrates many copies of the Delta-Notch ODE system (see DeltaNotchOdeSystem) over
+ * the same time interval with the fourth-order Runge-Kutta method.
+ *
+ * The state of all systems is held as one array per variable, so each time step is a
+ * single loop over the systems with no virtual calls or per-system vectors. The
+ * systems are shared between the threads of the ThreadPool. Each step uses the same
+ * arithmetic as RungeKutta4IvpOdeSolver applied to DeltaNotchOdeSystem, and the time
+ * steps are those of a TimeStepper, so the results match solving each system on its own.
+ */
+class DeltaNotchOdeBatch : public AbstractThreadPoolTask
+{
+private:
+
+    /** The Notch concentration of each system. */
+    std::vector<double> mNotch;
+
+    /** The Delta concentration of each system. */
+    std::vector<double> mDelta;
+
+    /** The Notch production term of each system, which depends only on its mean neighbouring Delta. */
+    std::vector<double> mNotchProduction;
+
+    /** The time from which to solve. */
+    double mStartTime;
+
+    /** The time to which to solve. */
+    double mEndTime;
+
+    /** The time step. */
+    double mDt;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param startTime the time from which to solve
+     * @param endTime the time to which to solve
+     * @param dt the time step
+     */
+    DeltaNotchOdeBatch(double startTime, double endTime, double dt);
+
+    /**
+     * Add a system to the batch.
+     *
+     * @param notch the initial Notch concentration
+     * @param delta the initial Delta concentration
+     * @param meanDelta the mean Delta concentration of the neighbouring cells
+     *
+     * @return the index of the system in the batch
+     */
+    unsigned AddSystem(double notch, double delta, double meanDelta);
+
+    /**
+     * @return the number of systems in the batch
+     */
+    unsigned GetNumSystems() const;
+
+    /**
+     * Solve all the systems from the start time to the end time.
+     */
+    void Solve();
+
+    /**
+     * Solve a range of the systems. Called by the ThreadPool from Solve().
+     *
+     * @param begin the index of the first system
+     * @param end one past the index of the last system
+     */
+    void Execute(unsigned begin, unsigned end);
+
+    /**
+     * @param index the index of a system
+     * @return the Notch concentration of the system
+     */
+    double GetNotch(unsigned index) const;
+
+    /**
+     * @param index the index of a system
+     * @return the Delta concentration of the system
+     */
+    double GetDelta(unsigned index) const;
+};
+
+#endif /*DELTANOTCHODEBATCH_HPP_*/
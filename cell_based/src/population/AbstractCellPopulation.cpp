@@ -46,6 +46,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SmartPointers.hpp"
 #include "CellAncestor.hpp"
 #include "ApoptoticCellProperty.hpp"
+#include "Hdf5CellDataWriter.hpp"
+#include "AsynchronousVtkWriter.hpp"
 
 // Cell writers
 #include "BoundaryNodeWriter.hpp"
@@ -66,6 +68,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "StemCellProliferativeType.hpp"
 #include "TransitCellProliferativeType.hpp"
 #include "DifferentiatedCellProliferativeType.hpp"
+#include "CellBasedProfiler.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( AbstractMesh<ELEMENT_DIM, SPACE_DIM>& rMesh,
@@ -75,7 +78,11 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
       mCells(rCells.begin(), rCells.end()),
       mCentroid(zero_vector<double>(SPACE_DIM)),
       mpCellPropertyRegistry(CellPropertyRegistry::Instance()->TakeOwnership()),
-      mOutputResultsForChasteVisualizer(true)
+      mOutputResultsForChasteVisualizer(true),
+      mUseHdf5CellOutput(false),
+      mCompressHdf5CellOutput(false),
+      mUseAsynchronousVtkOutput(false),
+      mNeighbourAdjacencyIsStale(true)
 {
     /*
      * To avoid double-counting problems, clear the passed-in cells vector.
@@ -94,10 +101,9 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
     }
 
     // Set up the map between location indices and cells
-    mLocationCellMap.clear();
-    mCellLocationMap.clear();
+    mCellLocationRegistry.Clear();
 
-    std::list<CellPtr>::iterator it = mCells.begin();
+    std::vector<CellPtr>::iterator it = mCells.begin();
     for (unsigned i=0; it != mCells.end(); ++it, ++i)
     {
         // Give each cell a pointer to the property registry (we have taken ownership in this constructor)
@@ -107,7 +113,8 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation(AbstractMesh<ELEMENT_DIM, SPACE_DIM>& rMesh)
-    : mrMesh(rMesh)
+    : mrMesh(rMesh),
+      mNeighbourAdjacencyIsStale(true)
 {
 }
 
@@ -146,7 +153,13 @@ AbstractMesh<ELEMENT_DIM, SPACE_DIM>& AbstractCellPopulation<ELEMENT_DIM, SPACE_
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
-std::list<CellPtr>& AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::rGetCells()
+bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::UpdateTetrahedralMeshForPdeModifier(TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* pMesh)
+{
+    return false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<CellPtr>& AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::rGetCells()
 {
     return mCells;
 }
@@ -175,7 +188,7 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetCellAncestorsToLocationI
 {
     for (typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator cell_iter=this->Begin(); cell_iter!=this->End(); ++cell_iter)
     {
-        MAKE_PTR_ARGS(CellAncestor, p_cell_ancestor, (mCellLocationMap[(*cell_iter).get()]));
+        MAKE_PTR_ARGS(CellAncestor, p_cell_ancestor, (mCellLocationRegistry.GetLocationIndex((*cell_iter).get())));
         cell_iter->SetAncestor(p_cell_ancestor);
     }
 }
@@ -322,15 +335,15 @@ std::vector<unsigned> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellCyc
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 CellPtr AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellUsingLocationIndex(unsigned index)
 {
-    // Get the set of pointers to cells corresponding to this location index
-    std::set<CellPtr> cells = mLocationCellMap[index];
+    // Get the pointers to cells corresponding to this location index
+    const std::vector<CellPtr>& r_cells = mCellLocationRegistry.rGetCellsAtLocation(index);
 
     // If there is only one cell attached return the cell. Note currently only one cell per index.
-    if (cells.size() == 1)
+    if (r_cells.size() == 1)
     {
-        return *(cells.begin());
+        return r_cells[0];
     }
-    if (cells.empty())
+    if (r_cells.empty())
     {
         EXCEPTION("Location index input argument does not correspond to a Cell");
     }
@@ -344,17 +357,85 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 std::set<CellPtr> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellsUsingLocationIndex(unsigned index)
 {
     // Return the set of pointers to cells corresponding to this location index, note the set may be empty.
-    return mLocationCellMap[index];
+    const std::vector<CellPtr>& r_cells = mCellLocationRegistry.rGetCellsAtLocation(index);
+    return std::set<CellPtr>(r_cells.begin(), r_cells.end());
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
-bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsCellAttachedToLocationIndex(unsigned index)
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AppendNeighbouringLocationIndices(unsigned index, std::vector<unsigned>& rNeighbours)
+{
+    std::set<unsigned> neighbour_indices = GetNeighbouringLocationIndices(mCellLocationRegistry.rGetCellsAtLocation(index)[0]);
+    rNeighbours.insert(rNeighbours.end(), neighbour_indices.begin(), neighbour_indices.end());
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::UpdateNeighbourAdjacency()
+{
+    if (!mNeighbourAdjacencyIsStale)
+    {
+        return;
+    }
+
+    // The vectors keep their capacity, so once they have grown no memory is allocated here
+    unsigned num_locations = mCellLocationRegistry.GetNumLocations();
+    mNeighbourOffsets.resize(num_locations + 1);
+    mNeighbourIndices.clear();
+
+    for (unsigned index=0; index<num_locations; index++)
+    {
+        mNeighbourOffsets[index] = mNeighbourIndices.size();
+
+        // Locations with no cell attached have no neighbours
+        if (!mCellLocationRegistry.rGetCellsAtLocation(index).empty())
+        {
+            AppendNeighbouringLocationIndices(index, mNeighbourIndices);
+
+            // Sort this location's neighbours and remove any duplicates
+            std::vector<unsigned>::iterator row_begin = mNeighbourIndices.begin() + mNeighbourOffsets[index];
+            std::sort(row_begin, mNeighbourIndices.end());
+            mNeighbourIndices.erase(std::unique(row_begin, mNeighbourIndices.end()), mNeighbourIndices.end());
+        }
+    }
+    mNeighbourOffsets[num_locations] = mNeighbourIndices.size();
+
+    mNeighbourAdjacencyIsStale = false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::InvalidateNeighbourAdjacency()
+{
+    mNeighbourAdjacencyIsStale = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetNumNeighbouringLocations(unsigned index)
+{
+    UpdateNeighbourAdjacency();
+    assert(index + 1 < mNeighbourOffsets.size());
+    return mNeighbourOffsets[index + 1] - mNeighbourOffsets[index];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::NeighbourIterator AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetNeighbouringLocationsBegin(unsigned index)
+{
+    UpdateNeighbourAdjacency();
+    assert(index + 1 < mNeighbourOffsets.size());
+    return mNeighbourIndices.begin() + mNeighbourOffsets[index];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::NeighbourIterator AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetNeighbouringLocationsEnd(unsigned index)
 {
-    // Get the set of pointers to cells corresponding to this location index
-    std::set<CellPtr> cells = mLocationCellMap[index];
+    UpdateNeighbourAdjacency();
+    assert(index + 1 < mNeighbourOffsets.size());
+    return mNeighbourIndices.begin() + mNeighbourOffsets[index + 1];
+}
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsCellAttachedToLocationIndex(unsigned index)
+{
     // Return whether there is a cell attached to the location index
-    return !(cells.empty());
+    return !(mCellLocationRegistry.rGetCellsAtLocation(index).empty());
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -365,38 +446,23 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteDataToVisualizerSetupF
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
-    // Clear the maps
-    mLocationCellMap[index].clear();
-    mCellLocationMap.erase(pCell.get());
-
-    // Replace with new cell
-    mLocationCellMap[index].insert(pCell);
-
-    // Do other half of the map
-    mCellLocationMap[pCell.get()] = index;
+    // Replace any existing cells with the new cell
+    mCellLocationRegistry.SetCell(index, pCell);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AddCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
-    mLocationCellMap[index].insert(pCell);
-    mCellLocationMap[pCell.get()] = index;
+    mCellLocationRegistry.AddCell(index, pCell);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::RemoveCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
-    std::set<CellPtr>::iterator cell_iter = mLocationCellMap[index].find(pCell);
-
-    if (cell_iter == mLocationCellMap[index].end())
+    if (!mCellLocationRegistry.RemoveCell(index, pCell))
     {
         EXCEPTION("Tried to remove a cell which is not attached to the given location index");
     }
-    else
-    {
-        mLocationCellMap[index].erase(cell_iter);
-        mCellLocationMap.erase(pCell.get());
-    }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -413,9 +479,9 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetLocationIndexUsingCell(CellPtr pCell)
 {
     // Check the cell is in the map
-    assert(this->mCellLocationMap.find(pCell.get()) != this->mCellLocationMap.end());
+    assert(mCellLocationRegistry.HasCell(pCell.get()));
 
-    return mCellLocationMap[pCell.get()];
+    return mCellLocationRegistry.GetLocationIndex(pCell.get());
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -469,9 +535,12 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::CloseRoundRobinWritersFiles()
 {
     typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
-    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+    if (!mUseHdf5CellOutput)
     {
-        p_cell_writer->CloseFile();
+        BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+        {
+            p_cell_writer->CloseFile();
+        }
     }
 
     typedef AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> pop_writer_t;
@@ -485,9 +554,17 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::CloseWritersFiles()
 {
     typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
-    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+    if (mpHdf5CellDataWriter)
+    {
+        mpHdf5CellDataWriter->CloseFile();
+        mpHdf5CellDataWriter.reset();
+    }
+    else
     {
-        p_cell_writer->CloseFile();
+        BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+        {
+            p_cell_writer->CloseFile();
+        }
     }
 
     typedef AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> pop_writer_t;
@@ -497,6 +574,11 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::CloseWritersFiles()
     }
 
 #ifdef CHASTE_VTK
+    if (mUseAsynchronousVtkOutput)
+    {
+        AsynchronousVtkWriter::Instance()->Flush();
+    }
+
     *mpVtkMetaFile << "    </Collection>\n";
     *mpVtkMetaFile << "</VTKFile>\n";
     mpVtkMetaFile->close();
@@ -529,11 +611,19 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::OpenWritersFiles(OutputFile
         }
     }
 
-    // Open output files for any cell writers
+    // Open output files for any cell writers, or a single HDF5 file for all of them
     typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
-    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+    if (mUseHdf5CellOutput)
+    {
+        mpHdf5CellDataWriter.reset(new Hdf5CellDataWriter<ELEMENT_DIM, SPACE_DIM>("results.h5", mCompressHdf5CellOutput));
+        mpHdf5CellDataWriter->OpenOutputFile(rOutputFileHandler);
+    }
+    else
     {
-        p_cell_writer->OpenOutputFile(rOutputFileHandler);
+        BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+        {
+            p_cell_writer->OpenOutputFile(rOutputFileHandler);
+        }
     }
 
     // Open output files and write headers for any population writers
@@ -558,9 +648,12 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::OpenRoundRobinWritersFilesF
 {
     typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
     typedef AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> pop_writer_t;
-    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+    if (!mUseHdf5CellOutput)
     {
-        p_cell_writer->OpenOutputFileForAppend(rOutputFileHandler);
+        BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+        {
+            p_cell_writer->OpenOutputFileForAppend(rOutputFileHandler);
+        }
     }
     BOOST_FOREACH(boost::shared_ptr<pop_writer_t> p_pop_writer, mCellPopulationWriters)
     {
@@ -587,9 +680,12 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteResultsToFiles(const s
             // The master process writes time stamps
             if (PetscTools::AmMaster())
             {
-                BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+                if (!mUseHdf5CellOutput)
                 {
-                    p_cell_writer->WriteTimeStamp();
+                    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+                    {
+                        p_cell_writer->WriteTimeStamp();
+                    }
                 }
                 BOOST_FOREACH(boost::shared_ptr<pop_writer_t> p_pop_writer, mCellPopulationWriters)
                 {
@@ -601,17 +697,25 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteResultsToFiles(const s
                  pop_writer_iter != mCellPopulationWriters.end();
                  ++pop_writer_iter)
             {
+                unsigned timer = CellBasedProfiler::Instance()->BeginTimer("Writer", pop_writer_iter->get());
                 AcceptPopulationWriter(*pop_writer_iter);
+                CellBasedProfiler::Instance()->EndTimer(timer);
             }
 
-            AcceptCellWritersAcrossPopulation();
+            if (!mUseHdf5CellOutput)
+            {
+                AcceptCellWritersAcrossPopulation();
+            }
 
             // The top-most process adds a newline
             if (PetscTools::AmTopMost())
             {
-                BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+                if (!mUseHdf5CellOutput)
                 {
-                    p_cell_writer->WriteNewline();
+                    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+                    {
+                        p_cell_writer->WriteNewline();
+                    }
                 }
                 BOOST_FOREACH(boost::shared_ptr<pop_writer_t> p_pop_writer, mCellPopulationWriters)
                 {
@@ -622,6 +726,12 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteResultsToFiles(const s
         }
         PetscTools::EndRoundRobin();
 
+        // The HDF5 cell output is written collectively, so is kept outside the round robin
+        if (mpHdf5CellDataWriter)
+        {
+            mpHdf5CellDataWriter->WriteTimeStep(this, mCellWriters);
+        }
+
         // Outside the round robin, deal with population count writers
         typedef AbstractCellPopulationCountWriter<ELEMENT_DIM, SPACE_DIM> count_writer_t;
 
@@ -638,7 +748,9 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteResultsToFiles(const s
              count_writer_iter != mCellPopulationCountWriters.end();
              ++count_writer_iter)
         {
+            unsigned timer = CellBasedProfiler::Instance()->BeginTimer("Writer", count_writer_iter->get());
             AcceptPopulationCountWriter(*count_writer_iter);
+            CellBasedProfiler::Instance()->EndTimer(timer);
         }
 
         if (PetscTools::AmMaster())
@@ -662,16 +774,19 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteResultsToFiles(const s
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AcceptCellWritersAcrossPopulation()
 {
-    for (typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator cell_iter = this->Begin();
-         cell_iter != this->End();
-         ++cell_iter)
+    // Each writer has its own output file, so visiting the cells once per writer leaves the output unchanged
+    for (typename std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >::iterator cell_writer_iter = mCellWriters.begin();
+         cell_writer_iter != mCellWriters.end();
+         ++cell_writer_iter)
     {
-        for (typename std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >::iterator cell_writer_iter = mCellWriters.begin();
-             cell_writer_iter != mCellWriters.end();
-             ++cell_writer_iter)
+        unsigned timer = CellBasedProfiler::Instance()->BeginTimer("Writer", cell_writer_iter->get());
+        for (typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator cell_iter = this->Begin();
+             cell_iter != this->End();
+             ++cell_iter)
         {
             AcceptCellWriter(*cell_writer_iter, *cell_iter);
         }
+        CellBasedProfiler::Instance()->EndTimer(timer);
     }
 }
 
@@ -770,6 +885,37 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetOutputResultsForChasteVi
     mOutputResultsForChasteVisualizer = outputResultsForChasteVisualizer;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetUseHdf5CellOutput()
+{
+    return mUseHdf5CellOutput;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCompressHdf5CellOutput()
+{
+    return mCompressHdf5CellOutput;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetUseHdf5CellOutput(bool useHdf5CellOutput, bool compress)
+{
+    mUseHdf5CellOutput = useHdf5CellOutput;
+    mCompressHdf5CellOutput = compress;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetUseAsynchronousVtkOutput()
+{
+    return mUseAsynchronousVtkOutput;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetUseAsynchronousVtkOutput(bool useAsynchronousVtkOutput)
+{
+    mUseAsynchronousVtkOutput = useAsynchronousVtkOutput;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsRoomToDivide(CellPtr pCell)
 {
@@ -39,6 +39,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Cell.hpp"
 #include "OutputFileHandler.hpp"
 
+#include <algorithm>
 #include <list>
 #include <map>
 #include <vector>
@@ -52,12 +53,14 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/split_member.hpp>
 
 #include <boost/foreach.hpp>
 
 #include "AbstractMesh.hpp"
 #include "TetrahedralMesh.hpp"
 #include "CellPropertyRegistry.hpp"
+#include "CellLocationRegistry.hpp"
 #include "Identifiable.hpp"
 #include "AbstractCellPopulationCountWriter.hpp"
 #include "AbstractCellPopulationWriter.hpp"
@@ -65,6 +68,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Forward declaration prevents circular include chain
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM> class AbstractCellBasedSimulation;
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM> class Hdf5CellDataWriter;
 
 /**
  * An abstract facade class encapsulating a cell population.
@@ -80,23 +84,59 @@ private:
     friend class boost::serialization::access;
 
     /**
-     * Serialize the object and its member variables.
+     * Save the object and its member variables. The map between cells and
+     * location indices is archived as a pair of std::maps.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void save(Archive & archive, const unsigned int version) const
     {
+        std::map<unsigned, std::set<CellPtr> > location_cell_map;
+        std::map<Cell*, unsigned> cell_location_map;
+        mCellLocationRegistry.GetMaps(location_cell_map, cell_location_map);
+
+        archive & mCells;
+        archive & location_cell_map;
+        archive & cell_location_map;
+        archive & mpCellPropertyRegistry;
+        archive & mOutputResultsForChasteVisualizer;
+        archive & mUseHdf5CellOutput;
+        archive & mCompressHdf5CellOutput;
+        archive & mUseAsynchronousVtkOutput;
+        archive & mCellWriters;
+        archive & mCellPopulationWriters;
+        archive & mCellPopulationCountWriters;
+    }
+
+    /**
+     * Load the object and its member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void load(Archive & archive, const unsigned int version)
+    {
+        std::map<unsigned, std::set<CellPtr> > location_cell_map;
+        std::map<Cell*, unsigned> cell_location_map;
+
         archive & mCells;
-        archive & mLocationCellMap;
-        archive & mCellLocationMap;
+        archive & location_cell_map;
+        archive & cell_location_map;
         archive & mpCellPropertyRegistry;
         archive & mOutputResultsForChasteVisualizer;
+        archive & mUseHdf5CellOutput;
+        archive & mCompressHdf5CellOutput;
+        archive & mUseAsynchronousVtkOutput;
         archive & mCellWriters;
         archive & mCellPopulationWriters;
         archive & mCellPopulationCountWriters;
+
+        mCellLocationRegistry.SetMaps(location_cell_map, cell_location_map);
     }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
 
     /**
      * Open all files in mCellPopulationWriters and mCellWriters in append mode for writing.
@@ -119,17 +159,19 @@ private:
 
 protected:
 
-    /** Map location (node or VertexElement) indices back to cells. */
-    std::map<unsigned, std::set<CellPtr> > mLocationCellMap;
-
-    /** Map cells to location (node or VertexElement) indices. */
-    std::map<Cell*, unsigned> mCellLocationMap;
+    /** Map between cells and location (node or VertexElement) indices. */
+    CellLocationRegistry mCellLocationRegistry;
 
     /** Reference to the mesh. */
     AbstractMesh<ELEMENT_DIM, SPACE_DIM>& mrMesh;
 
-    /** List of cells. */
-    std::list<CellPtr> mCells;
+    /**
+     * The cells, stored densely. New cells are added at the end, and the population
+     * Iterator holds an index into this vector, so that it remains valid when cells
+     * are added during iteration (as in DoCellBirth()). RemoveDeadCells() compacts
+     * the vector in a single pass, keeping the surviving cells in order.
+     */
+    std::vector<CellPtr> mCells;
 
     /** Population centroid. */
     c_vector<double, SPACE_DIM> mCentroid;
@@ -143,6 +185,24 @@ protected:
     /** Whether to write results to file for visualization using the Chaste java visualizer (defaults to true). */
     bool mOutputResultsForChasteVisualizer;
 
+    /**
+     * Whether to write the output of mCellWriters to a single HDF5 file, using
+     * collective parallel writes, instead of one text file per writer (defaults to false).
+     */
+    bool mUseHdf5CellOutput;
+
+    /** Whether to compress the HDF5 cell output (defaults to false). */
+    bool mCompressHdf5CellOutput;
+
+    /**
+     * Whether to hand VTK output to AsynchronousVtkWriter, so that it is written on a
+     * background thread while the simulation continues (defaults to false).
+     */
+    bool mUseAsynchronousVtkOutput;
+
+    /** Writer for the HDF5 cell output, created by OpenWritersFiles() if mUseHdf5CellOutput is true. */
+    boost::shared_ptr<Hdf5CellDataWriter<ELEMENT_DIM, SPACE_DIM> > mpHdf5CellDataWriter;
+
     /** A list of cell writers. */
     std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > > mCellWriters;
 
@@ -152,6 +212,37 @@ protected:
     /** A list of cell population count writers. */
     std::vector<boost::shared_ptr<AbstractCellPopulationCountWriter<ELEMENT_DIM, SPACE_DIM> > > mCellPopulationCountWriters;
 
+    /**
+     * Neighbour adjacency in compressed sparse row form: the neighbours of the location
+     * with index i are entries mNeighbourOffsets[i] to mNeighbourOffsets[i+1]-1 of
+     * mNeighbourIndices. Not archived; rebuilt when first queried after being invalidated.
+     */
+    std::vector<unsigned> mNeighbourOffsets;
+
+    /** The neighbouring location indices of every location, in ascending order for each location. */
+    std::vector<unsigned> mNeighbourIndices;
+
+    /** Whether mNeighbourOffsets and mNeighbourIndices must be rebuilt before they are next queried. */
+    bool mNeighbourAdjacencyIsStale;
+
+    /**
+     * Append the location indices of the neighbours of the cell(s) at a given location index
+     * to a vector. Used to build the neighbour adjacency; the appended indices need not be
+     * sorted or unique.
+     *
+     * The default implementation calls GetNeighbouringLocationIndices(). This method may be
+     * overridden in subclasses to avoid constructing a std::set for each location.
+     *
+     * @param index a location index to which a cell is attached
+     * @param rNeighbours the vector to append to
+     */
+    virtual void AppendNeighbouringLocationIndices(unsigned index, std::vector<unsigned>& rNeighbours);
+
+    /**
+     * Rebuild mNeighbourOffsets and mNeighbourIndices if they are stale.
+     */
+    void UpdateNeighbourAdjacency();
+
     /**
      * Check consistency of our internal data structures.
      *
@@ -233,6 +324,20 @@ public:
      */
     virtual TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* GetTetrahedralMeshForPdeModifier()=0;
 
+    /**
+     * Update a tetrahedral mesh, previously returned by GetTetrahedralMeshForPdeModifier(),
+     * so that its nodes match the current cell population, without creating a new mesh.
+     * This method is called by AbstractGrowingDomainPdeModifier.
+     *
+     * This method may be overridden in subclasses. The default implementation
+     * does nothing and returns false.
+     *
+     * @param pMesh the mesh to update
+     * @return whether the mesh was updated; if not, it is left unchanged and
+     *         GetTetrahedralMeshForPdeModifier() should be called instead.
+     */
+    virtual bool UpdateTetrahedralMeshForPdeModifier(TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* pMesh);
+
     /**
      * @param pdeNodeIndex index of a node in a tetrahedral mesh for use with a PDE modifier
      *
@@ -269,7 +374,7 @@ public:
     /**
      * @return reference to mCells.
      */
-    std::list<CellPtr>& rGetCells();
+    std::vector<CellPtr>& rGetCells();
 
     /**
      * As this method is pure virtual, it must be overridden
@@ -505,7 +610,7 @@ public:
     virtual void RemoveCellUsingLocationIndex(unsigned index, CellPtr pCell);
 
     /**
-     * Change the location index of a cell in mLocationCellMap and mCellLocationMap
+     * Change the location index of a cell in mCellLocationRegistry
      *
      * @param pCell the cell to move
      * @param old_index the old location index
@@ -577,6 +682,40 @@ public:
      */
     virtual std::set<unsigned> GetNeighbouringLocationIndices(CellPtr pCell)=0;
 
+    /** Iterator over the neighbouring location indices of a location. */
+    typedef std::vector<unsigned>::const_iterator NeighbourIterator;
+
+    /**
+     * Mark the neighbour adjacency as out of date, so that it is rebuilt the next time
+     * it is queried. This is called by Update() and by any method that may change which
+     * locations neighbour each other, such as moving a cell.
+     */
+    void InvalidateNeighbourAdjacency();
+
+    /**
+     * Given a location index to which a cell is attached, get the number of neighbouring
+     * locations. Unlike GetNeighbouringLocationIndices(), this and the methods below do not
+     * allocate memory: the neighbours of every location are computed together the first time
+     * one is queried after InvalidateNeighbourAdjacency(), and then reused.
+     *
+     * @param index the location index
+     * @return the number of neighbouring location indices.
+     */
+    unsigned GetNumNeighbouringLocations(unsigned index);
+
+    /**
+     * @param index a location index to which a cell is attached
+     * @return an iterator to the first of the neighbouring location indices, which are in
+     *     ascending order and are the same as those returned by GetNeighbouringLocationIndices().
+     */
+    NeighbourIterator GetNeighbouringLocationsBegin(unsigned index);
+
+    /**
+     * @param index a location index to which a cell is attached
+     * @return an iterator past the last of the neighbouring location indices.
+     */
+    NeighbourIterator GetNeighbouringLocationsEnd(unsigned index);
+
     /**
      * @return the centroid of the cell population.
      */
@@ -589,7 +728,8 @@ public:
 
     /**
      * Open output files (and, if required, write headers) for any writers in the members
-     * mCellPopulationCountWriters, mCellPopulationWriters and mCellWriters.
+     * mCellPopulationCountWriters, mCellPopulationWriters and mCellWriters. If mUseHdf5CellOutput
+     * is true, a single HDF5 file is created for mCellWriters instead.
      *
      * The method also writes the header for the .pvd output file if VTK is available.
      *
@@ -606,7 +746,8 @@ public:
      * Close output files associated with any writers in the members
      * mCellPopulationCountWriters, mCellPopulationWriters and mCellWriters.
      *
-     * The method also closes the .pvd output file if VTK is available.
+     * The method also closes the .pvd output file if VTK is available, first waiting for any
+     * VTK output that is being written asynchronously.
      */
     void CloseWritersFiles();
 
@@ -686,6 +827,21 @@ public:
      */
     bool GetOutputResultsForChasteVisualizer();
 
+    /**
+     * @return mUseHdf5CellOutput
+     */
+    bool GetUseHdf5CellOutput();
+
+    /**
+     * @return mCompressHdf5CellOutput
+     */
+    bool GetCompressHdf5CellOutput();
+
+    /**
+     * @return mUseAsynchronousVtkOutput
+     */
+    bool GetUseAsynchronousVtkOutput();
+
     /**
      * Add a cell population writer based on its type. Template parameters are inferred from the population.
      * The implementation of this function must be available in the header file.
@@ -806,6 +962,27 @@ public:
      */
     void SetOutputResultsForChasteVisualizer(bool outputResultsForChasteVisualizer);
 
+    /**
+     * Set whether to write the output of the cell writers to the HDF5 file "results.h5",
+     * using Hdf5CellDataWriter, instead of to their text files. Population writers and
+     * population count writers are unaffected. Use Hdf5CellDataConverter to convert the
+     * file to text or VTK output.
+     *
+     * @param useHdf5CellOutput the new value of mUseHdf5CellOutput
+     * @param compress the new value of mCompressHdf5CellOutput (defaults to false)
+     */
+    void SetUseHdf5CellOutput(bool useHdf5CellOutput, bool compress=false);
+
+    /**
+     * Set whether WriteVtkResultsToFile() should hand each VTK snapshot to AsynchronousVtkWriter
+     * instead of writing it immediately. The snapshots are written in compressed binary form on a
+     * background thread; CloseWritersFiles() waits for them to be finished. The number of snapshots
+     * waiting to be written is bounded by AsynchronousVtkWriter::SetMaxQueueDepth().
+     *
+     * @param useAsynchronousVtkOutput the new value of mUseAsynchronousVtkOutput
+     */
+    void SetUseAsynchronousVtkOutput(bool useAsynchronousVtkOutput);
+
     /**
      * @return The width (maximum distance to centroid) of the cell population
      *     in each dimension
@@ -870,9 +1047,10 @@ public:
          * Constructor for a new iterator.
          *
          * @param rCellPopulation the cell population
-         * @param cellIter iterator over list of cells
+         * @param cellIndex the index of the cell in the population's vector of cells
+         *     (or the number of cells, for the end of the population)
          */
-        Iterator(AbstractCellPopulation& rCellPopulation, std::list<CellPtr>::iterator cellIter);
+        Iterator(AbstractCellPopulation& rCellPopulation, unsigned cellIndex);
 
         /**
          * The iterator must have a virtual destructor.
@@ -900,8 +1078,12 @@ public:
         /** The cell population member. */
         AbstractCellPopulation& mrCellPopulation;
 
-        /** Cell iterator member. */
-        std::list<CellPtr>::iterator mCellIter;
+        /**
+         * The index of the current cell in the population's vector of cells. Any
+         * index past the last cell is at the end, so that an end iterator remains
+         * valid when cells are added.
+         */
+        unsigned mCellIndex;
     };
 
     /**
@@ -925,20 +1107,21 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 CellPtr AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator::operator*()
 {
     assert(!IsAtEnd());
-    return *mCellIter;
+    return mrCellPopulation.mCells[mCellIndex];
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 CellPtr AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator::operator->()
 {
     assert(!IsAtEnd());
-    return *mCellIter;
+    return mrCellPopulation.mCells[mCellIndex];
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator::operator!=(const typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator& rOther)
 {
-    return mCellIter != rOther.mCellIter;
+    unsigned num_cells = mrCellPopulation.mCells.size();
+    return std::min(mCellIndex, num_cells) != std::min(rOther.mCellIndex, num_cells);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -946,7 +1129,7 @@ typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator& AbstractCellP
 {
     do
     {
-        ++mCellIter;
+        ++mCellIndex;
     }
     while (!IsAtEnd() && !IsRealCell());
 
@@ -956,45 +1139,38 @@ typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator& AbstractCellP
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator::IsRealCell()
 {
-    return !( mrCellPopulation.IsCellAssociatedWithADeletedLocation(*mCellIter) || (*this)->IsDead() );
+    CellPtr p_cell = mrCellPopulation.mCells[mCellIndex];
+    return !( mrCellPopulation.IsCellAssociatedWithADeletedLocation(p_cell) || p_cell->IsDead() );
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator::IsAtEnd()
 {
-    return mCellIter == mrCellPopulation.rGetCells().end();
+    return mCellIndex >= mrCellPopulation.mCells.size();
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
-AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator::Iterator(AbstractCellPopulation& rCellPopulation, std::list<CellPtr>::iterator cellIter)
+AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator::Iterator(AbstractCellPopulation& rCellPopulation, unsigned cellIndex)
     : mrCellPopulation(rCellPopulation),
-      mCellIter(cellIter)
+      mCellIndex(cellIndex)
 {
-    // The cell population can now return empty if it only has ghost nodes
-    if (mrCellPopulation.rGetCells().empty())
-    {
-        mCellIter = mrCellPopulation.rGetCells().end();
-    }
-    else
+    // Make sure we start at a real cell (the cell population may be empty if it only has ghost nodes)
+    if (mCellIndex == 0 && !IsAtEnd() && !IsRealCell())
     {
-        // Make sure we start at a real cell
-        if (mCellIter == mrCellPopulation.rGetCells().begin() && !IsRealCell())
-        {
-            ++(*this);
-        }
+        ++(*this);
     }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Begin()
 {
-    return Iterator(*this, this->mCells.begin());
+    return Iterator(*this, 0);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::End()
 {
-    return Iterator(*this, this->mCells.end());
+    return Iterator(*this, this->mCells.size());
 }
 
 #endif /*ABSTRACTCELLPOPULATION_HPP_*/
@@ -34,6 +34,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "AbstractCentreBasedCellPopulation.hpp"
+#include "CellBasedProfiler.hpp"
 #include "RandomDirectionCentreBasedDivisionRule.hpp"
 #include "RandomNumberGenerator.hpp"
 #include "StepSizeException.hpp"
@@ -51,7 +52,7 @@ AbstractCentreBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCentreBasedCe
       mMeinekeDivisionSeparation(0.3) // educated guess
 {
     // If no location indices are specified, associate with nodes from the mesh.
-    std::list<CellPtr>::iterator it = this->mCells.begin();
+    std::vector<CellPtr>::iterator it = this->mCells.begin();
     typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = rMesh.GetNodeIteratorBegin();
 
     for (unsigned i=0; it != this->mCells.end(); ++it, ++i, ++node_iter)
@@ -120,7 +121,6 @@ CellPtr AbstractCentreBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>::AddCell(CellP
 
     // Update mappings between cells and location indices
     this->SetCellUsingLocationIndex(new_node_index, pNewCell);
-    this->mCellLocationMap[pNewCell.get()] = new_node_index;
 
     return pNewCell;
 }
@@ -256,17 +256,19 @@ void AbstractCentreBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetMeinekeDivisi
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::AcceptCellWritersAcrossPopulation()
 {
-    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->rGetMesh().GetNodeIteratorBegin();
-         node_iter != this->rGetMesh().GetNodeIteratorEnd();
-         ++node_iter)
+    for (typename std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >::iterator cell_writer_iter = this->mCellWriters.begin();
+         cell_writer_iter != this->mCellWriters.end();
+         ++cell_writer_iter)
     {
-        for (typename std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >::iterator cell_writer_iter = this->mCellWriters.begin();
-             cell_writer_iter != this->mCellWriters.end();
-             ++cell_writer_iter)
+        unsigned timer = CellBasedProfiler::Instance()->BeginTimer("Writer", cell_writer_iter->get());
+        for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->rGetMesh().GetNodeIteratorEnd();
+             ++node_iter)
         {
             CellPtr cell_from_node = this->GetCellUsingLocationIndex(node_iter->GetIndex());
             this->AcceptCellWriter(*cell_writer_iter, cell_from_node);
         }
+        CellBasedProfiler::Instance()->EndTimer(timer);
     }
 }
 
@@ -33,6 +33,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <algorithm>
+#include <climits>
 #include <boost/scoped_array.hpp>
 
 #include "CaBasedCellPopulation.hpp"
@@ -40,11 +42,16 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractCaUpdateRule.hpp"
 #include "AbstractCaSwitchingUpdateRule.hpp"
 #include "RandomNumberGenerator.hpp"
+#include "CounterBasedRandomNumberGenerator.hpp"
+#include "SimulationTime.hpp"
+#include "ThreadPool.hpp"
+#include "ThreadPoolMemberTask.hpp"
 #include "CellLocationIndexWriter.hpp"
 #include "ExclusionCaBasedDivisionRule.hpp"
 #include "NodesOnlyMesh.hpp"
 #include "Exception.hpp"
 #include "ApoptoticCellProperty.hpp"
+#include "CellBasedProfiler.hpp"
 
 // Needed to convert mesh in order to write nodes to VTK (visualize as glyphs)
 #include "VtkMeshWriter.hpp"
@@ -63,7 +70,12 @@ CaBasedCellPopulation<DIM>::CaBasedCellPopulation(PottsMesh<DIM>& rMesh,
                                                         bool deleteMesh,
                                                         bool validate)
     : AbstractOnLatticeCellPopulation<DIM>(rMesh, rCells, locationIndices, deleteMesh),
-      mLatticeCarryingCapacity(latticeCarryingCapacity)
+      mLatticeCarryingCapacity(latticeCarryingCapacity),
+      mUseBatchedUpdate(false),
+      mRetryBatchConflictsSequentially(true),
+      mBatchDt(0.0),
+      mBatchTimeStep(0u),
+      mBatchSeed(0u)
 {
     mAvailableSpaces = std::vector<unsigned>(this->GetNumNodes(), latticeCarryingCapacity);
     mpCaBasedDivisionRule.reset(new ExclusionCaBasedDivisionRule<DIM>());
@@ -79,7 +91,7 @@ CaBasedCellPopulation<DIM>::CaBasedCellPopulation(PottsMesh<DIM>& rMesh,
     {
         // Create a set of node indices corresponding to empty sites.
         // Note iterating over mCells is OK as it has the same order as location indices at this point (its just coppied from rCells)
-        std::list<CellPtr>::iterator it = this->mCells.begin();
+        std::vector<CellPtr>::iterator it = this->mCells.begin();
         for (unsigned i=0; it != this->mCells.end(); ++it, ++i)
         {
             assert(i < locationIndices.size());
@@ -98,7 +110,12 @@ CaBasedCellPopulation<DIM>::CaBasedCellPopulation(PottsMesh<DIM>& rMesh,
 
 template<unsigned DIM>
 CaBasedCellPopulation<DIM>::CaBasedCellPopulation(PottsMesh<DIM>& rMesh)
-    : AbstractOnLatticeCellPopulation<DIM>(rMesh)
+    : AbstractOnLatticeCellPopulation<DIM>(rMesh),
+      mUseBatchedUpdate(false),
+      mRetryBatchConflictsSequentially(true),
+      mBatchDt(0.0),
+      mBatchTimeStep(0u),
+      mBatchSeed(0u)
 {
 }
 
@@ -154,6 +171,27 @@ TetrahedralMesh<DIM, DIM>* CaBasedCellPopulation<DIM>::GetTetrahedralMeshForPdeM
     return new MutableMesh<DIM,DIM>(temp_nodes);
 }
 
+template<unsigned DIM>
+bool CaBasedCellPopulation<DIM>::UpdateTetrahedralMeshForPdeModifier(TetrahedralMesh<DIM, DIM>* pMesh)
+{
+    // Use the same node ordering as GetTetrahedralMeshForPdeModifier()
+    std::vector<c_vector<double, DIM> > locations;
+    for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = this->Begin();
+         cell_iter != this->End();
+         ++cell_iter)
+    {
+        locations.push_back(this->GetLocationOfCellCentre(*cell_iter));
+    }
+
+    MutableMesh<DIM,DIM>* p_mesh = dynamic_cast<MutableMesh<DIM,DIM>*>(pMesh);
+    if (p_mesh == NULL)
+    {
+        return false;
+    }
+    p_mesh->SetUseIncrementalReMesh(true);
+    return p_mesh->MoveNodesAndReMesh(locations);
+}
+
 template<unsigned DIM>
 Node<DIM>* CaBasedCellPopulation<DIM>::GetNode(unsigned index)
 {
@@ -170,22 +208,39 @@ template<unsigned DIM>
 std::set<unsigned> CaBasedCellPopulation<DIM>::GetNeighbouringLocationIndices(CellPtr pCell)
 {
     unsigned index = this->GetLocationIndexUsingCell(pCell);
-    std::set<unsigned> candidates = static_cast<PottsMesh<DIM>& >((this->mrMesh)).GetMooreNeighbouringNodeIndices(index);
+    PottsMesh<DIM>& r_mesh = static_cast<PottsMesh<DIM>& >((this->mrMesh));
 
     std::set<unsigned> neighbour_indices;
-    for (std::set<unsigned>::iterator iter = candidates.begin();
-         iter != candidates.end();
-         ++iter)
+    unsigned num_neighbours = r_mesh.GetNumMooreNeighbours(index);
+    for (unsigned local_index=0; local_index<num_neighbours; local_index++)
     {
-        if (!IsSiteAvailable(*iter, pCell))
+        unsigned neighbour_index = r_mesh.GetMooreNeighbour(index, local_index);
+        if (!IsSiteAvailable(neighbour_index, pCell))
         {
-            neighbour_indices.insert(*iter);
+            neighbour_indices.insert(neighbour_index);
         }
     }
 
     return neighbour_indices;
 }
 
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::AppendNeighbouringLocationIndices(unsigned index, std::vector<unsigned>& rNeighbours)
+{
+    PottsMesh<DIM>& r_mesh = static_cast<PottsMesh<DIM>& >((this->mrMesh));
+    CellPtr p_cell = this->mCellLocationRegistry.rGetCellsAtLocation(index)[0];
+
+    unsigned num_neighbours = r_mesh.GetNumMooreNeighbours(index);
+    for (unsigned local_index=0; local_index<num_neighbours; local_index++)
+    {
+        unsigned neighbour_index = r_mesh.GetMooreNeighbour(index, local_index);
+        if (!IsSiteAvailable(neighbour_index, p_cell))
+        {
+            rNeighbours.push_back(neighbour_index);
+        }
+    }
+}
+
 template<unsigned DIM>
 c_vector<double, DIM> CaBasedCellPopulation<DIM>::GetLocationOfCellCentre(CellPtr pCell)
 {
@@ -254,124 +309,200 @@ unsigned CaBasedCellPopulation<DIM>::RemoveDeadCells()
 {
     unsigned num_removed = 0;
 
-    for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
-         cell_iter != this->mCells.end();
-         )
+    // Remove the dead cells in a single pass, moving each remaining cell down so that they stay in order
+    unsigned num_cells_kept = 0;
+    for (unsigned cell_index=0; cell_index<this->mCells.size(); cell_index++)
     {
-        if ((*cell_iter)->IsDead())
+        CellPtr p_cell = this->mCells[cell_index];
+        if (p_cell->IsDead())
         {
             // Get the location index corresponding to this cell
-            unsigned location_index = this->GetLocationIndexUsingCell(*cell_iter);
+            unsigned location_index = this->GetLocationIndexUsingCell(p_cell);
 
             // Use this to remove the cell from the population
-            RemoveCellUsingLocationIndex(location_index, (*cell_iter));
+            RemoveCellUsingLocationIndex(location_index, p_cell);
 
-            // Erase cell and update counter
-            cell_iter = this->mCells.erase(cell_iter);
+            // Update counter
             num_removed++;
         }
         else
         {
-            ++cell_iter;
+            this->mCells[num_cells_kept++] = p_cell;
         }
     }
+    this->mCells.resize(num_cells_kept);
     return num_removed;
 }
 
+template<unsigned DIM>
+unsigned CaBasedCellPopulation<DIM>::SelectMovementTarget(unsigned nodeIndex, CellPtr pCell, double dt)
+{
+    // Sample random number to specify which move to make
+    return SelectMovementTarget(nodeIndex, pCell, dt, RandomNumberGenerator::Instance()->ranf());
+}
+
+template<unsigned DIM>
+unsigned CaBasedCellPopulation<DIM>::SelectMovementTarget(unsigned nodeIndex, CellPtr pCell, double dt, double randomNumber)
+{
+    PottsMesh<DIM>& r_mesh = rGetMesh();
+    unsigned num_neighbours = r_mesh.GetNumMooreNeighbours(nodeIndex);
+
+    // Each node in the mesh must have at least one neighbour
+    assert(num_neighbours > 0);
+
+    // Loop over neighbours and calculate probability of moving (make sure all probabilities are <1)
+    std::vector<double> neighbouring_node_propensities(num_neighbours, 0.0);
+    double probability_of_not_moving = 1.0;
+
+    for (unsigned local_index=0; local_index<num_neighbours; local_index++)
+    {
+        unsigned neighbour_index = r_mesh.GetMooreNeighbour(nodeIndex, local_index);
+
+        if (IsSiteAvailable(neighbour_index, pCell))
+        {
+            double probability_of_moving = 0.0;
+
+            // Iterating over the update rule
+            for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter_rule = this->mUpdateRuleCollection.begin();
+                 iter_rule != this->mUpdateRuleCollection.end();
+                 ++iter_rule)
+            {
+                // This static cast is fine, since we assert the update rule must be a CA update rule in AddUpdateRule()
+                double p = (boost::static_pointer_cast<AbstractCaUpdateRule<DIM> >(*iter_rule))->EvaluateProbability(nodeIndex, neighbour_index, *this, dt, 1, pCell);
+                probability_of_moving += p;
+                if (probability_of_moving < 0)
+                {
+                    EXCEPTION("The probability of cellular movement is smaller than zero. In order to prevent it from happening you should change your time step and parameters");
+                }
+
+                if (probability_of_moving > 1)
+                {
+                    EXCEPTION("The probability of the cellular movement is bigger than one. In order to prevent it from happening you should change your time step and parameters");
+                }
+            }
+
+            probability_of_not_moving -= probability_of_moving;
+            neighbouring_node_propensities[local_index] = probability_of_moving;
+        }
+    }
+    if (probability_of_not_moving < 0)
+    {
+        EXCEPTION("The probability of the cell not moving is smaller than zero. In order to prevent it from happening you should change your time step and parameters");
+    }
+
+    double total_probability = 0.0;
+    for (unsigned local_index=0; local_index<num_neighbours; local_index++)
+    {
+        total_probability += neighbouring_node_propensities[local_index];
+        if (total_probability >= randomNumber)
+        {
+            return r_mesh.GetMooreNeighbour(nodeIndex, local_index);
+        }
+    }
+
+    // If loop completes with total_probability < randomNumber then stay in the same location
+    return UNSIGNED_UNSET;
+}
+
+template<unsigned DIM>
+double CaBasedCellPopulation<DIM>::EvaluateSwitchingProbability(unsigned nodeIndex, unsigned neighbourIndex, double dt)
+{
+    double probability_of_switch = 0.0;
+
+    // Now add contributions to the probability from each CA switching update rule
+    for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter_rule = mSwitchingUpdateRuleCollection.begin();
+         iter_rule != mSwitchingUpdateRuleCollection.end();
+         ++iter_rule)
+    {
+        // This static cast is fine, since we assert the update rule must be a CA switching update rule in AddUpdateRule()
+        double p = (boost::static_pointer_cast<AbstractCaSwitchingUpdateRule<DIM> >(*iter_rule))->EvaluateSwitchingProbability(nodeIndex, neighbourIndex, *this, dt, 1);
+        probability_of_switch += p;
+    }
+
+    assert(probability_of_switch >= 0);
+    assert(probability_of_switch <= 1);
+
+    return probability_of_switch;
+}
+
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::SwitchCellsAtLocations(unsigned nodeIndex, unsigned neighbourIndex)
+{
+    bool is_cell_on_node_index = mAvailableSpaces[nodeIndex] == 0 ? true : false;
+    bool is_cell_on_neighbour_location_index = mAvailableSpaces[neighbourIndex] == 0 ? true : false;
+
+    if (is_cell_on_node_index && is_cell_on_neighbour_location_index)
+    {
+        // Swap the cells associated with the node and the neighbour node
+        CellPtr p_cell = this->GetCellUsingLocationIndex(nodeIndex);
+        CellPtr p_neighbour_cell = this->GetCellUsingLocationIndex(neighbourIndex);
+
+        // Remove the cells from their current location
+        RemoveCellUsingLocationIndex(nodeIndex, p_cell);
+        RemoveCellUsingLocationIndex(neighbourIndex, p_neighbour_cell);
+
+        // Add cells to their new locations
+        AddCellUsingLocationIndex(nodeIndex, p_neighbour_cell);
+        AddCellUsingLocationIndex(neighbourIndex, p_cell);
+    }
+    else if (is_cell_on_node_index && !is_cell_on_neighbour_location_index)
+    {
+        // Move the cells associated with the node to the neighbour node
+        CellPtr p_cell = this->GetCellUsingLocationIndex(nodeIndex);
+        RemoveCellUsingLocationIndex(nodeIndex, p_cell);
+        AddCellUsingLocationIndex(neighbourIndex, p_cell);
+    }
+    else if (!is_cell_on_node_index && is_cell_on_neighbour_location_index)
+    {
+        // Move the cell associated with the neighbour node onto the node
+        CellPtr p_neighbour_cell = this->GetCellUsingLocationIndex(neighbourIndex);
+        RemoveCellUsingLocationIndex(neighbourIndex, p_neighbour_cell);
+        AddCellUsingLocationIndex(nodeIndex, p_neighbour_cell);
+    }
+    else
+    {
+        NEVER_REACHED;
+    }
+}
+
 template<unsigned DIM>
 void CaBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
 {
+    // Moving cells changes which sites are occupied
+    this->InvalidateNeighbourAdjacency();
+
+    if (mUseBatchedUpdate)
+    {
+        UpdateCellLocationsInBatches(dt);
+        return;
+    }
+
     /*
      * Here we loop over the nodes and calculate the probability of moving
      * and then select the node to move to.
      */
+    CellBasedProfiler* p_profiler = CellBasedProfiler::Instance();
     if (!(this->mUpdateRuleCollection.empty()))
     {
+        unsigned long num_moves = 0;
+
         // Iterate over cells
         ///\todo make this sweep random
-        for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
+        for (std::vector<CellPtr>::iterator cell_iter = this->mCells.begin();
              cell_iter != this->mCells.end();
              ++cell_iter)
         {
-            // Loop over neighbours and calculate probability of moving (make sure all probabilities are <1)
             unsigned node_index = this->GetLocationIndexUsingCell(*cell_iter);
+            unsigned chosen_neighbour_location_index = SelectMovementTarget(node_index, *cell_iter, dt);
 
-            // Find a random available neighbouring node to overwrite current site
-            std::set<unsigned> neighbouring_node_indices = static_cast<PottsMesh<DIM>& >((this->mrMesh)).GetMooreNeighbouringNodeIndices(node_index);
-            std::vector<double> neighbouring_node_propensities;
-            std::vector<unsigned> neighbouring_node_indices_vector;
-
-            if (!neighbouring_node_indices.empty())
-            {
-                unsigned num_neighbours = neighbouring_node_indices.size();
-                double probability_of_not_moving = 1.0;
-
-                for (std::set<unsigned>::iterator iter = neighbouring_node_indices.begin();
-                     iter != neighbouring_node_indices.end();
-                     ++iter)
-                {
-                    double probability_of_moving = 0.0;
-
-                    neighbouring_node_indices_vector.push_back(*iter);
-
-                    if (IsSiteAvailable(*iter, *cell_iter))
-                    {
-                        // Iterating over the update rule
-                        for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter_rule = this->mUpdateRuleCollection.begin();
-                             iter_rule != this->mUpdateRuleCollection.end();
-                             ++iter_rule)
-                        {
-                            // This static cast is fine, since we assert the update rule must be a CA update rule in AddUpdateRule()
-                            double p = (boost::static_pointer_cast<AbstractCaUpdateRule<DIM> >(*iter_rule))->EvaluateProbability(node_index, *iter, *this, dt, 1, *cell_iter);
-                            probability_of_moving += p;
-                            if (probability_of_moving < 0)
-                            {
-                                EXCEPTION("The probability of cellular movement is smaller than zero. In order to prevent it from happening you should change your time step and parameters");
-                            }
-
-                            if (probability_of_moving > 1)
-                            {
-                                EXCEPTION("The probability of the cellular movement is bigger than one. In order to prevent it from happening you should change your time step and parameters");
-                            }
-                        }
-
-                        probability_of_not_moving -= probability_of_moving;
-                        neighbouring_node_propensities.push_back(probability_of_moving);
-                    }
-                    else
-                    {
-                        neighbouring_node_propensities.push_back(0.0);
-                    }
-                }
-                if (probability_of_not_moving < 0)
-                {
-                    EXCEPTION("The probability of the cell not moving is smaller than zero. In order to prevent it from happening you should change your time step and parameters");
-                }
-
-                // Sample random number to specify which move to make
-                RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
-                double random_number = p_gen->ranf();
-
-                double total_probability = 0.0;
-                for (unsigned counter=0; counter<num_neighbours; counter++)
-                {
-                    total_probability += neighbouring_node_propensities[counter];
-                    if (total_probability >= random_number)
-                    {
-                        // Move the cell to this neighbour location
-                        unsigned chosen_neighbour_location_index = neighbouring_node_indices_vector[counter];
-                        this->MoveCellInLocationMap((*cell_iter), node_index, chosen_neighbour_location_index);
-                        break;
-                    }
-                }
-                // If loop completes with total_probability < random_number then stay in the same location
-            }
-            else
+            if (chosen_neighbour_location_index != UNSIGNED_UNSET)
             {
-                // Each node in the mesh must have at least one neighbour
-                NEVER_REACHED;
+                // Move the cell to this neighbour location
+                this->MoveCellInLocationMap((*cell_iter), node_index, chosen_neighbour_location_index);
+                num_moves++;
             }
         }
+        p_profiler->IncrementCounter("CA moves accepted", num_moves);
     }
 
     /*
@@ -385,7 +516,9 @@ void CaBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
         assert(mLatticeCarryingCapacity == 1);
 
         RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        PottsMesh<DIM>& r_mesh = rGetMesh();
         unsigned num_nodes = this->mrMesh.GetNumNodes();
+        unsigned long num_switches = 0;
 
         // Randomly permute mUpdateRuleCollection if specified
         if (this->mIterateRandomlyOverUpdateRuleCollection)
@@ -409,83 +542,233 @@ void CaBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
             }
 
             // Find a random available neighbouring node to switch cells with the current site
-            std::set<unsigned> neighbouring_node_indices = static_cast<PottsMesh<DIM>& >((this->mrMesh)).GetMooreNeighbouringNodeIndices(node_index);
+            unsigned num_neighbours = r_mesh.GetNumMooreNeighbours(node_index);
+            assert(num_neighbours > 0);
+            unsigned neighbour_location_index = r_mesh.GetMooreNeighbour(node_index, p_gen->randMod(num_neighbours));
+
+            if (mAvailableSpaces[node_index] == 0 || mAvailableSpaces[neighbour_location_index] == 0)
+            {
+                double probability_of_switch = EvaluateSwitchingProbability(node_index, neighbour_location_index, dt);
 
-            unsigned neighbour_location_index;
+                // Generate a uniform random number to do the random switch
+                double random_number = p_gen->ranf();
+
+                if (random_number < probability_of_switch)
+                {
+                    SwitchCellsAtLocations(node_index, neighbour_location_index);
+                    num_switches++;
+                }
+            }
+        }
+        p_profiler->IncrementCounter("CA switches accepted", num_switches);
+    }
+}
 
-            if (!neighbouring_node_indices.empty())
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::UpdateCellLocationsInBatches(double dt)
+{
+    RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+    PottsMesh<DIM>& r_mesh = rGetMesh();
+    CellBasedProfiler* p_profiler = CellBasedProfiler::Instance();
+
+    if (!(this->mUpdateRuleCollection.empty()))
+    {
+        /*
+         * Propose a move for every cell against the lattice as it stands at the
+         * start of the time step. Each proposal only reads the lattice, and its
+         * random numbers are keyed by the cell ID and time step, so the cells may be
+         * shared between the threads of the ThreadPool and the proposals depend
+         * neither on the number of threads nor on the order in which cells are visited.
+         */
+        unsigned num_cells = this->mCells.size();
+        mBatchDt = dt;
+        mBatchTimeStep = SimulationTime::Instance()->GetTimeStepsElapsed();
+        mBatchSeed = p_gen->randMod(UINT_MAX);
+        mProposedTargets.assign(num_cells, UNSIGNED_UNSET);
+        mProposedPriorities.assign(num_cells, 0.0);
+
+        ThreadPoolMemberTask<CaBasedCellPopulation<DIM> > task(this, &CaBasedCellPopulation<DIM>::ProposeMoves);
+        ThreadPool::Instance()->ParallelFor(num_cells, task);
+
+        std::vector<CellPtr> moving_cells;
+        std::vector<unsigned> current_indices;
+        std::vector<unsigned> target_indices;
+        std::vector<std::pair<double, unsigned> > priorities;
+
+        for (unsigned cell_index=0; cell_index<num_cells; cell_index++)
+        {
+            if (mProposedTargets[cell_index] != UNSIGNED_UNSET)
             {
-                unsigned num_neighbours = neighbouring_node_indices.size();
-                unsigned chosen_neighbour = p_gen->randMod(num_neighbours);
+                priorities.push_back(std::pair<double, unsigned>(mProposedPriorities[cell_index], moving_cells.size()));
+                moving_cells.push_back(this->mCells[cell_index]);
+                current_indices.push_back(this->GetLocationIndexUsingCell(this->mCells[cell_index]));
+                target_indices.push_back(mProposedTargets[cell_index]);
+            }
+        }
+
+        /*
+         * Resolve conflicts: visit proposals in order of increasing priority (ties
+         * broken by the order of the cells in the population) and accept each one
+         * while its target site still has room at the start of the time step.
+         * Spaces vacated during this time step are not reused until the next one.
+         */
+        std::sort(priorities.begin(), priorities.end());
 
-                std::set<unsigned>::iterator neighbour_iter = neighbouring_node_indices.begin();
-                for (unsigned j=0; j<chosen_neighbour; j++)
+        std::vector<unsigned> remaining_spaces = mAvailableSpaces;
+        std::vector<unsigned> accepted_moves;
+        std::vector<unsigned> rejected_moves;
+        accepted_moves.reserve(priorities.size());
+
+        for (unsigned i=0; i<priorities.size(); i++)
+        {
+            unsigned move = priorities[i].second;
+            if (remaining_spaces[target_indices[move]] > 0)
+            {
+                remaining_spaces[target_indices[move]]--;
+                accepted_moves.push_back(move);
+            }
+            else
+            {
+                rejected_moves.push_back(move);
+            }
+        }
+
+        // Accepted moves never compete for space, so the order in which they are carried out is immaterial
+        for (unsigned i=0; i<accepted_moves.size(); i++)
+        {
+            unsigned move = accepted_moves[i];
+            this->MoveCellInLocationMap(moving_cells[move], current_indices[move], target_indices[move]);
+        }
+        unsigned long num_moves = accepted_moves.size();
+
+        // Give cells whose move was rejected another go against the updated lattice, as in the sequential update
+        if (mRetryBatchConflictsSequentially)
+        {
+            for (unsigned i=0; i<rejected_moves.size(); i++)
+            {
+                CellPtr p_cell = moving_cells[rejected_moves[i]];
+                unsigned node_index = current_indices[rejected_moves[i]];
+                unsigned target_index = SelectMovementTarget(node_index, p_cell, dt);
+
+                if (target_index != UNSIGNED_UNSET)
                 {
-                    neighbour_iter++;
+                    this->MoveCellInLocationMap(p_cell, node_index, target_index);
+                    num_moves++;
                 }
-                neighbour_location_index = *neighbour_iter;
+            }
+        }
+        p_profiler->IncrementCounter("CA moves accepted", num_moves);
+    }
+
+    if (!(mSwitchingUpdateRuleCollection.empty()))
+    {
+        assert(mLatticeCarryingCapacity == 1);
+
+        unsigned num_nodes = this->mrMesh.GetNumNodes();
+
+        // Randomly permute mUpdateRuleCollection if specified
+        if (this->mIterateRandomlyOverUpdateRuleCollection)
+        {
+            // Randomly permute mUpdateRuleCollection
+            p_gen->Shuffle(mSwitchingUpdateRuleCollection);
+        }
+
+        /*
+         * Propose switches in the same order as the sequential update. A site may
+         * take part in at most one switch per time step; the earliest proposal
+         * involving it wins, and later ones are deferred.
+         */
+        std::vector<bool> is_site_claimed(num_nodes, false);
+        std::vector<std::pair<unsigned, unsigned> > accepted_switches;
+        std::vector<std::pair<unsigned, unsigned> > deferred_switches;
 
-                bool is_cell_on_node_index = mAvailableSpaces[node_index] == 0 ? true : false;
-                bool is_cell_on_neighbour_location_index = mAvailableSpaces[neighbour_location_index] == 0 ? true : false;
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            unsigned node_index;
+
+            if (this->mUpdateNodesInRandomOrder)
+            {
+                node_index = p_gen->randMod(num_nodes);
+            }
+            else
+            {
+                // Loop over nodes in index order
+                node_index = i%num_nodes;
+            }
+
+            unsigned num_neighbours = r_mesh.GetNumMooreNeighbours(node_index);
+            assert(num_neighbours > 0);
+            unsigned neighbour_location_index = r_mesh.GetMooreNeighbour(node_index, p_gen->randMod(num_neighbours));
 
-                if (is_cell_on_node_index || is_cell_on_neighbour_location_index)
+            if (mAvailableSpaces[node_index] == 0 || mAvailableSpaces[neighbour_location_index] == 0)
+            {
+                double probability_of_switch = EvaluateSwitchingProbability(node_index, neighbour_location_index, dt);
+
+                if (p_gen->ranf() < probability_of_switch)
                 {
-                    double probability_of_switch = 0.0;
+                    std::pair<unsigned, unsigned> proposed_switch(node_index, neighbour_location_index);
 
-                    // Now add contributions to the probability from each CA switching update rule
-                    for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter_rule = mSwitchingUpdateRuleCollection.begin();
-                         iter_rule != mSwitchingUpdateRuleCollection.end();
-                         ++iter_rule)
+                    if (!is_site_claimed[node_index] && !is_site_claimed[neighbour_location_index])
                     {
-                        // This static cast is fine, since we assert the update rule must be a CA switching update rule in AddUpdateRule()
-                        double p = (boost::static_pointer_cast<AbstractCaSwitchingUpdateRule<DIM> >(*iter_rule))->EvaluateSwitchingProbability(node_index, neighbour_location_index, *this, dt, 1);
-                        probability_of_switch += p;
+                        is_site_claimed[node_index] = true;
+                        is_site_claimed[neighbour_location_index] = true;
+                        accepted_switches.push_back(proposed_switch);
                     }
+                    else
+                    {
+                        deferred_switches.push_back(proposed_switch);
+                    }
+                }
+            }
+        }
 
-                    assert(probability_of_switch >= 0);
-                    assert(probability_of_switch <= 1);
+        // Accepted switches involve disjoint pairs of sites, so the order in which they are carried out is immaterial
+        for (unsigned i=0; i<accepted_switches.size(); i++)
+        {
+            SwitchCellsAtLocations(accepted_switches[i].first, accepted_switches[i].second);
+        }
+        unsigned long num_switches = accepted_switches.size();
 
-                    // Generate a uniform random number to do the random switch
-                    double random_number = p_gen->ranf();
+        // Reattempt deferred switches against the updated lattice, as in the sequential update
+        if (mRetryBatchConflictsSequentially)
+        {
+            for (unsigned i=0; i<deferred_switches.size(); i++)
+            {
+                unsigned node_index = deferred_switches[i].first;
+                unsigned neighbour_location_index = deferred_switches[i].second;
 
-                    if (random_number < probability_of_switch)
+                if (mAvailableSpaces[node_index] == 0 || mAvailableSpaces[neighbour_location_index] == 0)
+                {
+                    double probability_of_switch = EvaluateSwitchingProbability(node_index, neighbour_location_index, dt);
+
+                    if (p_gen->ranf() < probability_of_switch)
                     {
-                        if (is_cell_on_node_index && is_cell_on_neighbour_location_index)
-                        {
-                            // Swap the cells associated with the node and the neighbour node
-                            CellPtr p_cell = this->GetCellUsingLocationIndex(node_index);
-                            CellPtr p_neighbour_cell = this->GetCellUsingLocationIndex(neighbour_location_index);
-
-                            // Remove the cells from their current location
-                            RemoveCellUsingLocationIndex(node_index, p_cell);
-                            RemoveCellUsingLocationIndex(neighbour_location_index, p_neighbour_cell);
-
-                            // Add cells to their new locations
-                            AddCellUsingLocationIndex(node_index, p_neighbour_cell);
-                            AddCellUsingLocationIndex(neighbour_location_index, p_cell);
-                        }
-                        else if (is_cell_on_node_index && !is_cell_on_neighbour_location_index)
-                        {
-                            // Move the cells associated with the node to the neighbour node
-                            CellPtr p_cell = this->GetCellUsingLocationIndex(node_index);
-                            RemoveCellUsingLocationIndex(node_index, p_cell);
-                            AddCellUsingLocationIndex(neighbour_location_index, p_cell);
-                        }
-                        else if (!is_cell_on_node_index && is_cell_on_neighbour_location_index)
-                        {
-                            // Move the cell associated with the neighbour node onto the node
-                            CellPtr p_neighbour_cell = this->GetCellUsingLocationIndex(neighbour_location_index);
-                            RemoveCellUsingLocationIndex(neighbour_location_index, p_neighbour_cell);
-                            AddCellUsingLocationIndex(node_index, p_neighbour_cell);
-                        }
-                        else
-                        {
-                            NEVER_REACHED;
-                        }
+                        SwitchCellsAtLocations(node_index, neighbour_location_index);
+                        num_switches++;
                     }
                 }
             }
         }
+        p_profiler->IncrementCounter("CA switches accepted", num_switches);
+    }
+}
+
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::ProposeMoves(unsigned firstCellIndex, unsigned endCellIndex)
+{
+    CounterBasedRandomNumberGenerator generator(mBatchSeed, "CaBasedCellPopulation");
+
+    // The first number selects the move and the second is the priority of the proposal
+    std::vector<double> random_numbers(2);
+
+    for (unsigned cell_index=firstCellIndex; cell_index<endCellIndex; cell_index++)
+    {
+        const CellPtr& r_cell = this->mCells[cell_index];
+        unsigned node_index = this->GetLocationIndexUsingCell(r_cell);
+
+        generator.FillUniform(r_cell->GetCellId(), mBatchTimeStep, random_numbers);
+        mProposedTargets[cell_index] = SelectMovementTarget(node_index, r_cell, mBatchDt, random_numbers[0]);
+        mProposedPriorities[cell_index] = random_numbers[1];
     }
 }
 
@@ -498,6 +781,7 @@ bool CaBasedCellPopulation<DIM>::IsCellAssociatedWithADeletedLocation(CellPtr pC
 template<unsigned DIM>
 void CaBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
 {
+    this->InvalidateNeighbourAdjacency();
 }
 
 template<unsigned DIM>
@@ -546,6 +830,30 @@ double CaBasedCellPopulation<DIM>::GetWidth(const unsigned& rDimension)
     return width;
 }
 
+template<unsigned DIM>
+bool CaBasedCellPopulation<DIM>::GetUseBatchedUpdate()
+{
+    return mUseBatchedUpdate;
+}
+
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::SetUseBatchedUpdate(bool useBatchedUpdate)
+{
+    mUseBatchedUpdate = useBatchedUpdate;
+}
+
+template<unsigned DIM>
+bool CaBasedCellPopulation<DIM>::GetRetryBatchConflictsSequentially()
+{
+    return mRetryBatchConflictsSequentially;
+}
+
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::SetRetryBatchConflictsSequentially(bool retryBatchConflictsSequentially)
+{
+    mRetryBatchConflictsSequentially = retryBatchConflictsSequentially;
+}
+
 template<unsigned DIM>
 void CaBasedCellPopulation<DIM>::AddUpdateRule(boost::shared_ptr<AbstractUpdateRule<DIM> > pUpdateRule)
 {
@@ -643,6 +951,7 @@ void CaBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDirec
 
     // Create mesh writer for VTK output
     VtkMeshWriter<DIM, DIM> mesh_writer(rDirectory, "results_"+time.str(), false);
+    mesh_writer.SetWriteAsynchronously(this->mUseAsynchronousVtkOutput);
 
     // Create a counter to keep track of how many cells are at a lattice site
     unsigned num_sites = this->mrMesh.GetNumNodes();
@@ -83,6 +83,34 @@ private:
      * This is a specialisation for CA models. */
     boost::shared_ptr<AbstractCaBasedDivisionRule<DIM> > mpCaBasedDivisionRule;
 
+    /**
+     * Whether to update cell locations in synchronous batches rather than one
+     * cell at a time. Defaults to false.
+     */
+    bool mUseBatchedUpdate;
+
+    /**
+     * Whether, in batched mode, moves and switches that lose a conflict are
+     * reattempted one at a time against the updated lattice, as in the
+     * sequential update. Defaults to true.
+     */
+    bool mRetryBatchConflictsSequentially;
+
+    /** The time step passed to ProposeMoves(). Only used during UpdateCellLocationsInBatches(). */
+    double mBatchDt;
+
+    /** The number of time steps elapsed, used by ProposeMoves() to key its random numbers. */
+    unsigned mBatchTimeStep;
+
+    /** The seed used by ProposeMoves(), drawn from the RandomNumberGenerator once per batched update. */
+    unsigned mBatchSeed;
+
+    /** The target site proposed by ProposeMoves() for each cell, or UNSIGNED_UNSET. */
+    std::vector<unsigned> mProposedTargets;
+
+    /** The priority drawn by ProposeMoves() for each cell; lower values win conflicts. */
+    std::vector<double> mProposedPriorities;
+
     /**
      * Set the empty sites by taking in a set of which nodes indices are empty sites.
      *
@@ -111,6 +139,8 @@ private:
         archive & mLatticeCarryingCapacity;
         archive & mAvailableSpaces;
         archive & mpCaBasedDivisionRule;
+        archive & mUseBatchedUpdate;
+        archive & mRetryBatchConflictsSequentially;
 // LCOV_EXCL_STOP
     }
 
@@ -121,6 +151,17 @@ private:
      */
     void Validate();
 
+    /**
+     * Overridden AppendNeighbouringLocationIndices() method.
+     *
+     * Appends the occupied Moore neighbours of the site, read from the lattice
+     * neighbour table of the PottsMesh rather than a std::set.
+     *
+     * @param index a location index to which a cell is attached
+     * @param rNeighbours the vector to append to
+     */
+    void AppendNeighbouringLocationIndices(unsigned index, std::vector<unsigned>& rNeighbours);
+
     /**
      * Overridden WriteVtkResultsToFile() method.
      *
@@ -130,6 +171,81 @@ private:
      */
     virtual void WriteVtkResultsToFile(const std::string& rDirectory);
 
+    /**
+     * Evaluate the probability of a cell moving to each of its neighbouring sites,
+     * using the CA update rules, and sample one of these moves.
+     *
+     * Only reads the current state of the lattice, so may be used to propose moves
+     * for many cells before any of them are carried out.
+     *
+     * @param nodeIndex the index of the site currently occupied by the cell
+     * @param pCell the cell
+     * @param dt simulation time step
+     * @return the index of the site to move to, or UNSIGNED_UNSET if the cell stays put
+     */
+    unsigned SelectMovementTarget(unsigned nodeIndex, CellPtr pCell, double dt);
+
+    /**
+     * As above, but sample the move using a given uniform random number rather than
+     * one drawn from the RandomNumberGenerator, so that this method may be called
+     * by several threads at once.
+     *
+     * @param nodeIndex the index of the site currently occupied by the cell
+     * @param pCell the cell
+     * @param dt simulation time step
+     * @param randomNumber a uniform random number in (0,1]
+     * @return the index of the site to move to, or UNSIGNED_UNSET if the cell stays put
+     */
+    unsigned SelectMovementTarget(unsigned nodeIndex, CellPtr pCell, double dt, double randomNumber);
+
+    /**
+     * Propose a move, and draw a priority, for each cell in a range of mCells, storing
+     * the results in mProposedTargets and mProposedPriorities. The random numbers used
+     * for each cell are drawn from a CounterBasedRandomNumberGenerator keyed by the cell
+     * ID and time step, so the proposals do not depend on the order in which cells are
+     * visited. Run as a ThreadPool task by UpdateCellLocationsInBatches().
+     *
+     * @param firstCellIndex the index in mCells of the first cell
+     * @param endCellIndex one past the index in mCells of the last cell
+     */
+    void ProposeMoves(unsigned firstCellIndex, unsigned endCellIndex);
+
+    /**
+     * Evaluate the probability of switching the contents of two neighbouring sites,
+     * using the CA switching update rules.
+     *
+     * @param nodeIndex the index of the first site
+     * @param neighbourIndex the index of the second site
+     * @param dt simulation time step
+     * @return the switching probability
+     */
+    double EvaluateSwitchingProbability(unsigned nodeIndex, unsigned neighbourIndex, double dt);
+
+    /**
+     * Switch the cells (if any) associated with two neighbouring sites. At least one
+     * of the sites must be occupied.
+     *
+     * @param nodeIndex the index of the first site
+     * @param neighbourIndex the index of the second site
+     */
+    void SwitchCellsAtLocations(unsigned nodeIndex, unsigned neighbourIndex);
+
+    /**
+     * Batched version of UpdateCellLocations(), used if mUseBatchedUpdate is true.
+     *
+     * Moves are proposed for every cell against the lattice as it stands at the
+     * start of the time step, sharing the cells between the threads of the ThreadPool.
+     * Where more cells target a site than it has spaces, the proposals with the lowest
+     * randomly drawn priorities are accepted. The result does not depend on the number
+     * of threads. Switches
+     * are proposed for every site in the usual order and a site may take part in at
+     * most one switch, the earliest proposal winning. Accepted moves and switches
+     * never interact so may be carried out in any order.
+     *
+     * @param dt simulation time step
+     */
+    void UpdateCellLocationsInBatches(double dt);
+
 public:
 
     /**
@@ -201,6 +317,17 @@ public:
      */
     virtual TetrahedralMesh<DIM, DIM>* GetTetrahedralMeshForPdeModifier();
 
+    /**
+     * Overridden UpdateTetrahedralMeshForPdeModifier() method.
+     *
+     * Moves the nodes of a mesh created by GetTetrahedralMeshForPdeModifier() to
+     * the current cell centres and updates its triangulation incrementally where possible.
+     *
+     * @param pMesh the mesh to update
+     * @return whether the mesh was updated
+     */
+    virtual bool UpdateTetrahedralMeshForPdeModifier(TetrahedralMesh<DIM, DIM>* pMesh);
+
     /**
      * Overridden GetNode() method.
      *
@@ -430,6 +557,31 @@ public:
      */
     virtual void AddUpdateRule(boost::shared_ptr<AbstractUpdateRule<DIM> > pUpdateRule);
 
+    /**
+     * @return mUseBatchedUpdate
+     */
+    bool GetUseBatchedUpdate();
+
+    /**
+     * Set mUseBatchedUpdate.
+     *
+     * @param useBatchedUpdate whether to update cell locations in synchronous batches
+     */
+    void SetUseBatchedUpdate(bool useBatchedUpdate);
+
+    /**
+     * @return mRetryBatchConflictsSequentially
+     */
+    bool GetRetryBatchConflictsSequentially();
+
+    /**
+     * Set mRetryBatchConflictsSequentially.
+     *
+     * @param retryBatchConflictsSequentially whether to reattempt moves and switches
+     *     that lose a conflict one at a time
+     */
+    void SetRetryBatchConflictsSequentially(bool retryBatchConflictsSequentially);
+
     /**
      * Overridden AddUpdateRule() method.
      *
@@ -0,0 +1,132 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "CellLocationRegistry.hpp"
+
+#include <algorithm>
+
+void CellLocationRegistry::Clear()
+{
+    mCellsAtLocation.clear();
+    mLocationOfCell.clear();
+}
+
+void CellLocationRegistry::AddCell(unsigned index, CellPtr pCell)
+{
+    if (index >= mCellsAtLocation.size())
+    {
+        mCellsAtLocation.resize(index+1);
+    }
+
+    std::vector<CellPtr>& r_slot = mCellsAtLocation[index];
+    if (std::find(r_slot.begin(), r_slot.end(), pCell) == r_slot.end())
+    {
+        r_slot.push_back(pCell);
+    }
+    mLocationOfCell[pCell.get()] = index;
+}
+
+void CellLocationRegistry::SetCell(unsigned index, CellPtr pCell)
+{
+    if (index < mCellsAtLocation.size())
+    {
+        mCellsAtLocation[index].clear();
+    }
+    AddCell(index, pCell);
+}
+
+bool CellLocationRegistry::RemoveCell(unsigned index, CellPtr pCell)
+{
+    if (index >= mCellsAtLocation.size())
+    {
+        return false;
+    }
+
+    std::vector<CellPtr>& r_slot = mCellsAtLocation[index];
+    std::vector<CellPtr>::iterator it = std::find(r_slot.begin(), r_slot.end(), pCell);
+    if (it == r_slot.end())
+    {
+        return false;
+    }
+
+    // Swap the cell with the last cell in the slot and pop it
+    *it = r_slot.back();
+    r_slot.pop_back();
+    mLocationOfCell.erase(pCell.get());
+    return true;
+}
+
+bool CellLocationRegistry::HasCell(Cell* pCell) const
+{
+    return mLocationOfCell.find(pCell) != mLocationOfCell.end();
+}
+
+void CellLocationRegistry::GetMaps(std::map<unsigned, std::set<CellPtr> >& rLocationCellMap,
+                                   std::map<Cell*, unsigned>& rCellLocationMap) const
+{
+    rLocationCellMap.clear();
+    rCellLocationMap.clear();
+    for (unsigned index=0; index<mCellsAtLocation.size(); index++)
+    {
+        if (!mCellsAtLocation[index].empty())
+        {
+            rLocationCellMap[index].insert(mCellsAtLocation[index].begin(), mCellsAtLocation[index].end());
+        }
+    }
+    rCellLocationMap.insert(mLocationOfCell.begin(), mLocationOfCell.end());
+}
+
+void CellLocationRegistry::SetMaps(const std::map<unsigned, std::set<CellPtr> >& rLocationCellMap,
+                                   const std::map<Cell*, unsigned>& rCellLocationMap)
+{
+    Clear();
+    for (std::map<unsigned, std::set<CellPtr> >::const_iterator map_iter = rLocationCellMap.begin();
+         map_iter != rLocationCellMap.end();
+         ++map_iter)
+    {
+        for (std::set<CellPtr>::const_iterator cell_iter = map_iter->second.begin();
+             cell_iter != map_iter->second.end();
+             ++cell_iter)
+        {
+            // Skip cells listed under a location index that they have since left
+            std::map<Cell*, unsigned>::const_iterator location_iter = rCellLocationMap.find(cell_iter->get());
+            if (location_iter != rCellLocationMap.end() && location_iter->second == map_iter->first)
+            {
+                AddCell(map_iter->first, *cell_iter);
+            }
+        }
+    }
+}
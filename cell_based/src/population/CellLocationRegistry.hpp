@@ -0,0 +1,166 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef CELLLOCATIONREGISTRY_HPP_
+#define CELLLOCATIONREGISTRY_HPP_
+
+#include <cassert>
+#include <map>
+#include <set>
+#include <vector>
+#include <boost/unordered_map.hpp>
+
+#include "Cell.hpp"
+
+/**
+ * Bidirectional map between cells and the location indices (nodes, lattice
+ * sites or elements) to which they are attached, used by AbstractCellPopulation.
+ *
+ * Cells are stored in a dense array of slots indexed by location index, so
+ * looking up the cells at a location does not search a tree. Each slot may hold
+ * more than one cell, as required by CaBasedCellPopulation. Cells are removed from
+ * a slot by swapping them with the last cell in the slot, so the order of cells
+ * within a slot is not preserved. The reverse map, from cells to location indices,
+ * is a hash table.
+ */
+class CellLocationRegistry
+{
+private:
+
+    /** The cells attached to each location index. */
+    std::vector<std::vector<CellPtr> > mCellsAtLocation;
+
+    /** The location index of each cell. */
+    boost::unordered_map<Cell*, unsigned> mLocationOfCell;
+
+    /** An empty slot, returned for location indices beyond the end of mCellsAtLocation. Never modified. */
+    std::vector<CellPtr> mEmptySlot;
+
+public:
+
+    /**
+     * Remove all cells from the registry.
+     */
+    void Clear();
+
+    /**
+     * Attach a cell to a location index, in addition to any cells already attached to it.
+     * If the cell is already attached to this location index, this method has no effect
+     * other than recording the location index of the cell.
+     *
+     * @param index the location index
+     * @param pCell the cell
+     */
+    void AddCell(unsigned index, CellPtr pCell);
+
+    /**
+     * Attach a cell to a location index, detaching any cells already attached to it.
+     *
+     * @param index the location index
+     * @param pCell the cell
+     */
+    void SetCell(unsigned index, CellPtr pCell);
+
+    /**
+     * Detach a cell from a location index.
+     *
+     * @param index the location index
+     * @param pCell the cell
+     *
+     * @return whether the cell was attached to the location index.
+     */
+    bool RemoveCell(unsigned index, CellPtr pCell);
+
+    /**
+     * @param index the location index
+     *
+     * @return the cells attached to a location index (possibly none).
+     */
+    const std::vector<CellPtr>& rGetCellsAtLocation(unsigned index) const
+    {
+        return (index < mCellsAtLocation.size()) ? mCellsAtLocation[index] : mEmptySlot;
+    }
+
+    /**
+     * @return one more than the largest location index that a cell may be attached to.
+     * Slots below this may be empty.
+     */
+    unsigned GetNumLocations() const
+    {
+        return mCellsAtLocation.size();
+    }
+
+    /**
+     * @param pCell the cell
+     *
+     * @return whether the cell is attached to any location index.
+     */
+    bool HasCell(Cell* pCell) const;
+
+    /**
+     * Get the location index of a cell, which must be attached to a location index.
+     *
+     * @param pCell the cell
+     *
+     * @return the location index.
+     */
+    unsigned GetLocationIndex(Cell* pCell) const
+    {
+        boost::unordered_map<Cell*, unsigned>::const_iterator it = mLocationOfCell.find(pCell);
+        assert(it != mLocationOfCell.end());
+        return it->second;
+    }
+
+    /**
+     * Copy the registry into the pair of maps used in archives.
+     *
+     * @param rLocationCellMap filled with the cells attached to each occupied location index
+     * @param rCellLocationMap filled with the location index of each cell
+     */
+    void GetMaps(std::map<unsigned, std::set<CellPtr> >& rLocationCellMap,
+                 std::map<Cell*, unsigned>& rCellLocationMap) const;
+
+    /**
+     * Replace the contents of the registry with a pair of maps read from an archive.
+     *
+     * @param rLocationCellMap the cells attached to each location index
+     * @param rCellLocationMap the location index of each cell
+     */
+    void SetMaps(const std::map<unsigned, std::set<CellPtr> >& rLocationCellMap,
+                 const std::map<Cell*, unsigned>& rCellLocationMap);
+};
+
+#endif /*CELLLOCATIONREGISTRY_HPP_*/
@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "TrianglesMeshWriter.hpp"
 #include "VtkMeshWriter.hpp"
 #include "CellBasedEventHandler.hpp"
+#include "CellBasedProfiler.hpp"
 #include "Cylindrical2dMesh.hpp"
 #include "Cylindrical2dVertexMesh.hpp"
 #include "NodesOnlyMesh.hpp"
@@ -48,6 +49,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NodeVelocityWriter.hpp"
 #include "CellPopulationAreaWriter.hpp"
 
+#include <climits>
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::MeshBasedCellPopulation(MutableMesh<ELEMENT_DIM,SPACE_DIM>& rMesh,
                                       std::vector<CellPtr>& rCells,
@@ -61,7 +64,11 @@ MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::MeshBasedCellPopulation(MutableM
       mAreaBasedDampingConstantParameter(0.1),
       mWriteVtkAsPoints(false),
       mOutputMeshInVtk(false),
-      mHasVariableRestLength(false)
+      mHasVariableRestLength(false),
+      mUseIncrementalReMesh(false),
+      mUseIncrementalVoronoiTessellation(false),
+      mSpringTableIsStale(true),
+      mSpringTableRestLengthsAreStale(true)
 {
     mpMutableMesh = static_cast<MutableMesh<ELEMENT_DIM,SPACE_DIM>* >(&(this->mrMesh));
 
@@ -88,6 +95,8 @@ MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::MeshBasedCellPopulation(MutableM
     mpMutableMesh = static_cast<MutableMesh<ELEMENT_DIM,SPACE_DIM>* >(&(this->mrMesh));
     mpVoronoiTessellation = NULL;
     mDeleteMesh = true;
+    mSpringTableIsStale = true;
+    mSpringTableRestLengthsAreStale = true;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -216,11 +225,13 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::RemoveDeadCells()
 {
     unsigned num_removed = 0;
-    for (std::list<CellPtr>::iterator it = this->mCells.begin();
-         it != this->mCells.end();
-         )
+
+    // Remove the dead cells in a single pass, moving each remaining cell down so that they stay in order
+    unsigned num_cells_kept = 0;
+    for (unsigned cell_index=0; cell_index<this->mCells.size(); cell_index++)
     {
-        if ((*it)->IsDead())
+        CellPtr p_cell = this->mCells[cell_index];
+        if (p_cell->IsDead())
         {
             // Check if this cell is in a marked spring
             std::vector<const std::pair<CellPtr,CellPtr>*> pairs_to_remove; // Pairs that must be purged
@@ -232,9 +243,9 @@ unsigned MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::RemoveDeadCells()
 
                 for (unsigned i=0; i<2; i++)
                 {
-                    CellPtr p_cell = (i==0 ? r_pair.first : r_pair.second);
+                    CellPtr p_pair_cell = (i==0 ? r_pair.first : r_pair.second);
 
-                    if (p_cell == *it)
+                    if (p_pair_cell == p_cell)
                     {
                         // Remember to purge this spring
                         pairs_to_remove.push_back(&r_pair);
@@ -253,20 +264,19 @@ unsigned MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::RemoveDeadCells()
 
             // Remove the node from the mesh
             num_removed++;
-            static_cast<MutableMesh<ELEMENT_DIM,SPACE_DIM>&>((this->mrMesh)).DeleteNodePriorToReMesh(this->GetLocationIndexUsingCell((*it)));
+            mSpringTableIsStale = true;
+            static_cast<MutableMesh<ELEMENT_DIM,SPACE_DIM>&>((this->mrMesh)).DeleteNodePriorToReMesh(this->GetLocationIndexUsingCell(p_cell));
 
             // Update mappings between cells and location indices
-            unsigned location_index_of_removed_node = this->GetLocationIndexUsingCell((*it));
-            this->RemoveCellUsingLocationIndex(location_index_of_removed_node, (*it));
-
-            // Update vector of cells
-            it = this->mCells.erase(it);
+            unsigned location_index_of_removed_node = this->GetLocationIndexUsingCell(p_cell);
+            this->RemoveCellUsingLocationIndex(location_index_of_removed_node, p_cell);
         }
         else
         {
-            ++it;
+            this->mCells[num_cells_kept++] = p_cell;
         }
     }
+    this->mCells.resize(num_cells_kept);
 
     return num_removed;
 }
@@ -274,6 +284,9 @@ unsigned MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::RemoveDeadCells()
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::Update(bool hasHadBirthsOrDeaths)
 {
+    // Remeshing may change which cells neighbour each other
+    this->InvalidateNeighbourAdjacency();
+
     ///\todo check if there is a more efficient way of keeping track of node velocity information (#2404)
     bool output_node_velocities = (this-> template HasWriter<NodeVelocityWriter>());
 
@@ -324,22 +337,33 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::Update(bool hasHadBirthsOrD
     NodeMap node_map(this->mrMesh.GetNumAllNodes());
 
     // We must use a static_cast to call ReMesh() as this method is not defined in parent mesh classes
-    static_cast<MutableMesh<ELEMENT_DIM,SPACE_DIM>&>((this->mrMesh)).ReMesh(node_map);
+    MutableMesh<ELEMENT_DIM,SPACE_DIM>& r_mutable_mesh = static_cast<MutableMesh<ELEMENT_DIM,SPACE_DIM>&>((this->mrMesh));
+    r_mutable_mesh.SetUseIncrementalReMesh(mUseIncrementalReMesh);
+    r_mutable_mesh.ReMesh(node_map);
+    CellBasedProfiler::Instance()->IncrementCounter("Delaunay remeshes");
 
     if (!node_map.IsIdentityMap())
     {
+        // Cells are reattached to renumbered nodes, so the spring table must be rebuilt
+        mSpringTableIsStale = true;
+
         UpdateGhostNodesAfterReMesh(node_map);
 
         // Update the mappings between cells and location indices
-        std::map<Cell*, unsigned> old_cell_location_map = this->mCellLocationMap;
+        std::vector<unsigned> old_node_indices;
+        old_node_indices.reserve(this->mCells.size());
+        for (std::vector<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
+        {
+            old_node_indices.push_back(this->GetLocationIndexUsingCell(*it));
+        }
 
         // Remove any dead pointers from the maps (needed to avoid archiving errors)
-        this->mLocationCellMap.clear();
-        this->mCellLocationMap.clear();
+        this->mCellLocationRegistry.Clear();
 
-        for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
+        std::vector<unsigned>::iterator old_index_iter = old_node_indices.begin();
+        for (std::vector<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it, ++old_index_iter)
         {
-            unsigned old_node_index = old_cell_location_map[(*it).get()];
+            unsigned old_node_index = *old_index_iter;
 
             // This shouldn't ever happen, as the cell vector only contains living cells
             assert(!node_map.IsDeleted(old_node_index));
@@ -361,19 +385,19 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::Update(bool hasHadBirthsOrD
     }
     else
     {
-        if (old_node_radius_map[this->mCellLocationMap[(*(this->mCells.begin())).get()]] > 0.0)
+        if (old_node_radius_map[this->GetLocationIndexUsingCell(*(this->mCells.begin()))] > 0.0)
         {
-            for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
+            for (std::vector<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
             {
-                unsigned node_index = this->mCellLocationMap[(*it).get()];
+                unsigned node_index = this->GetLocationIndexUsingCell(*it);
                 this->GetNode(node_index)->SetRadius(old_node_radius_map[node_index]);
             }
         }
         if (output_node_velocities)
         {
-            for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
+            for (std::vector<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
             {
-                unsigned node_index = this->mCellLocationMap[(*it).get()];
+                unsigned node_index = this->GetLocationIndexUsingCell(*it);
                 this->GetNode(node_index)->AddAppliedForceContribution(old_node_applied_force_map[node_index]);
             }
         }
@@ -452,6 +476,11 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::DivideLongSprings(double sp
     std::vector<c_vector<unsigned, 5> > new_nodes;
     new_nodes = rGetMesh().SplitLongEdges(springDivisionThreshold);
 
+    if (!new_nodes.empty())
+    {
+        mSpringTableIsStale = true;
+    }
+
     // Add new cells onto new nodes
     for (unsigned index=0; index<new_nodes.size(); index++)
     {
@@ -540,6 +569,8 @@ CellPtr MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::AddCell(CellPtr pNewCell
     std::pair<CellPtr,CellPtr> cell_pair = this->CreateCellPair(pParentCell, p_created_cell);
     this->MarkSpring(cell_pair);
 
+    mSpringTableIsStale = true;
+
     // Return pointer to new cell
     return p_created_cell;
 }
@@ -622,6 +653,7 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::WriteVtkResultsToFile(const
     {
         // Create mesh writer for VTK output
         VtkMeshWriter<ELEMENT_DIM, SPACE_DIM> mesh_writer(rDirectory, "mesh_"+time.str(), false);
+        mesh_writer.SetWriteAsynchronously(this->mUseAsynchronousVtkOutput);
         mesh_writer.WriteFilesUsingMesh(rGetMesh());
     }
 
@@ -629,6 +661,7 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::WriteVtkResultsToFile(const
     {
         // Create mesh writer for VTK output
         VtkMeshWriter<SPACE_DIM, SPACE_DIM> cells_writer(rDirectory, "results_"+time.str(), false);
+        cells_writer.SetWriteAsynchronously(this->mUseAsynchronousVtkOutput);
 
         // Iterate over any cell writers that are present
         unsigned num_cells = this->GetNumAllCells();
@@ -696,6 +729,7 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::WriteVtkResultsToFile(const
     {
         // Create mesh writer for VTK output
         VertexMeshWriter<ELEMENT_DIM, SPACE_DIM> mesh_writer(rDirectory, "results", false);
+        mesh_writer.SetWriteAsynchronously(this->mUseAsynchronousVtkOutput);
         std::vector<double> cell_volumes(num_cells_from_mesh);
 
         // Iterate over any cell writers that are present
@@ -781,7 +815,8 @@ double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetVolumeOfCell(CellPtr p
             unsigned element_index = mpVoronoiTessellation->GetVoronoiElementIndexCorrespondingToDelaunayNodeIndex(node_index);
 
             // Get the cell's volume from the Voronoi tessellation
-            cell_volume = mpVoronoiTessellation->GetVolumeOfElement(element_index);
+            UpdateVoronoiElementGeometry(element_index);
+            cell_volume = mVoronoiElementVolumes[element_index];
         }
         catch (Exception&)
         {
@@ -847,6 +882,30 @@ bool MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetOutputMeshInVtk()
     return mOutputMeshInVtk;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SetUseIncrementalReMesh(bool useIncrementalReMesh)
+{
+    mUseIncrementalReMesh = useIncrementalReMesh;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetUseIncrementalReMesh()
+{
+    return mUseIncrementalReMesh;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SetUseIncrementalVoronoiTessellation(bool useIncrementalVoronoiTessellation)
+{
+    mUseIncrementalVoronoiTessellation = useIncrementalVoronoiTessellation;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetUseIncrementalVoronoiTessellation()
+{
+    return mUseIncrementalVoronoiTessellation;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::WriteDataToVisualizerSetupFile(out_stream& pVizSetupFile)
 {
@@ -944,12 +1003,145 @@ typename MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SpringIterator MeshBase
     return SpringIterator(*this, static_cast<MutableMesh<ELEMENT_DIM,SPACE_DIM>&>((this->mrMesh)).EdgesEnd());
 }
 
+//////////////////////////////////////////////////////////////////////////////
+//                              Spring table                                //
+//////////////////////////////////////////////////////////////////////////////
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SpringTableMatchesMesh()
+{
+    unsigned num_elements = mpMutableMesh->GetNumAllElements();
+    if (mSpringTableElementNodeIndices.size() != num_elements*(ELEMENT_DIM+1))
+    {
+        return false;
+    }
+
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        Element<ELEMENT_DIM,SPACE_DIM>* p_element = mpMutableMesh->GetElement(elem_index);
+        const unsigned* p_stored_indices = &mSpringTableElementNodeIndices[elem_index*(ELEMENT_DIM+1)];
+        bool is_deleted = p_element->IsDeleted();
+        for (unsigned local_index=0; local_index<ELEMENT_DIM+1; local_index++)
+        {
+            unsigned node_index = is_deleted ? UINT_MAX : p_element->GetNodeGlobalIndex(local_index);
+            if (node_index != p_stored_indices[local_index])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::UpdateSpringTable()
+{
+    if (!mSpringTableIsStale && SpringTableMatchesMesh())
+    {
+        return;
+    }
+
+    CellBasedProfiler::Instance()->IncrementCounter("spring table rebuilds");
+
+    mSpringNodeIndicesA.clear();
+    mSpringNodeIndicesB.clear();
+    mSpringCellsA.clear();
+    mSpringCellsB.clear();
+
+    // Visit the springs in the same order as SpringIterator, so forces are summed in the same order
+    for (SpringIterator spring_iterator = SpringsBegin();
+         spring_iterator != SpringsEnd();
+         ++spring_iterator)
+    {
+        mSpringNodeIndicesA.push_back(spring_iterator.GetNodeA()->GetIndex());
+        mSpringNodeIndicesB.push_back(spring_iterator.GetNodeB()->GetIndex());
+        mSpringCellsA.push_back(spring_iterator.GetCellA());
+        mSpringCellsB.push_back(spring_iterator.GetCellB());
+    }
+
+    // Record the connectivity of the mesh
+    unsigned num_elements = mpMutableMesh->GetNumAllElements();
+    mSpringTableElementNodeIndices.resize(num_elements*(ELEMENT_DIM+1));
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        Element<ELEMENT_DIM,SPACE_DIM>* p_element = mpMutableMesh->GetElement(elem_index);
+        bool is_deleted = p_element->IsDeleted();
+        for (unsigned local_index=0; local_index<ELEMENT_DIM+1; local_index++)
+        {
+            mSpringTableElementNodeIndices[elem_index*(ELEMENT_DIM+1) + local_index] = is_deleted ? UINT_MAX : p_element->GetNodeGlobalIndex(local_index);
+        }
+    }
+
+    mSpringTableIsStale = false;
+    mSpringTableRestLengthsAreStale = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::InvalidateSpringTable()
+{
+    mSpringTableIsStale = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetNumSprings() const
+{
+    return mSpringNodeIndicesA.size();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::vector<unsigned>& MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::rGetSpringNodeIndicesA() const
+{
+    return mSpringNodeIndicesA;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::vector<unsigned>& MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::rGetSpringNodeIndicesB() const
+{
+    return mSpringNodeIndicesB;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::vector<CellPtr>& MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::rGetSpringCellsA() const
+{
+    return mSpringCellsA;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::vector<CellPtr>& MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::rGetSpringCellsB() const
+{
+    return mSpringCellsB;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::vector<double>& MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::rGetSpringRestLengths()
+{
+    if (mSpringTableRestLengthsAreStale)
+    {
+        unsigned num_springs = mSpringNodeIndicesA.size();
+        mSpringTableRestLengths.resize(num_springs);
+        for (unsigned spring_index=0; spring_index<num_springs; spring_index++)
+        {
+            mSpringTableRestLengths[spring_index] = GetRestLength(mSpringNodeIndicesA[spring_index], mSpringNodeIndicesB[spring_index]);
+        }
+        mSpringTableRestLengthsAreStale = false;
+    }
+    return mSpringTableRestLengths;
+}
+
 /**
  *
  */
 template<>
 void MeshBasedCellPopulation<2>::CreateVoronoiTessellation()
 {
+    // If the mesh has not changed topology, just move the vertices and mark the changed elements as stale
+    if (mUseIncrementalVoronoiTessellation
+        && (mpVoronoiTessellation != NULL)
+        && mpVoronoiTessellation->UpdateVerticesFromDelaunayMesh(mVoronoiElementIsStale))
+    {
+        return;
+    }
+
     delete mpVoronoiTessellation;
 
     // Check if the mesh associated with this cell population is periodic
@@ -963,6 +1155,11 @@ void MeshBasedCellPopulation<2>::CreateVoronoiTessellation()
     {
         mpVoronoiTessellation = new VertexMesh<2, 2>(static_cast<MutableMesh<2, 2> &>((this->mrMesh)), is_mesh_periodic);
     }
+
+    unsigned num_elements = mpVoronoiTessellation->GetNumAllElements();
+    mVoronoiElementVolumes.resize(num_elements);
+    mVoronoiElementSurfaceAreas.resize(num_elements);
+    mVoronoiElementIsStale.assign(num_elements, true);
 }
 /**
  * Can't tessellate 2d meshes in 3d space yet.
@@ -984,6 +1181,11 @@ void MeshBasedCellPopulation<3>::CreateVoronoiTessellation()
 {
     delete mpVoronoiTessellation;
     mpVoronoiTessellation = new VertexMesh<3, 3>(static_cast<MutableMesh<3, 3> &>((this->mrMesh)));
+
+    unsigned num_elements = mpVoronoiTessellation->GetNumAllElements();
+    mVoronoiElementVolumes.resize(num_elements);
+    mVoronoiElementSurfaceAreas.resize(num_elements);
+    mVoronoiElementIsStale.assign(num_elements, true);
 }
 
 /**
@@ -1030,16 +1232,28 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetVolumeOfVoronoiElement(unsigned index)
 {
     unsigned element_index = mpVoronoiTessellation->GetVoronoiElementIndexCorrespondingToDelaunayNodeIndex(index);
-    double volume = mpVoronoiTessellation->GetVolumeOfElement(element_index);
-    return volume;
+    UpdateVoronoiElementGeometry(element_index);
+    return mVoronoiElementVolumes[element_index];
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetSurfaceAreaOfVoronoiElement(unsigned index)
 {
     unsigned element_index = mpVoronoiTessellation->GetVoronoiElementIndexCorrespondingToDelaunayNodeIndex(index);
-    double surface_area = mpVoronoiTessellation->GetSurfaceAreaOfElement(element_index);
-    return surface_area;
+    UpdateVoronoiElementGeometry(element_index);
+    return mVoronoiElementSurfaceAreas[element_index];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::UpdateVoronoiElementGeometry(unsigned elementIndex)
+{
+    assert(elementIndex < mVoronoiElementIsStale.size());
+    if (mVoronoiElementIsStale[elementIndex])
+    {
+        mVoronoiElementVolumes[elementIndex] = mpVoronoiTessellation->GetVolumeOfElement(elementIndex);
+        mVoronoiElementSurfaceAreas[elementIndex] = mpVoronoiTessellation->GetSurfaceAreaOfElement(elementIndex);
+        mVoronoiElementIsStale[elementIndex] = false;
+    }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -1063,7 +1277,7 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::CheckCellPointers()
 {
     bool res = true;
-    for (std::list<CellPtr>::iterator it=this->mCells.begin();
+    for (std::vector<CellPtr>::iterator it=this->mCells.begin();
          it!=this->mCells.end();
          ++it)
     {
@@ -1181,6 +1395,28 @@ double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetWidth(const unsigned&
     return width;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::AppendNeighbouringLocationIndices(unsigned index, std::vector<unsigned>& rNeighbours)
+{
+    Node<SPACE_DIM>* p_node = this->mrMesh.GetNode(index);
+    for (typename Node<SPACE_DIM>::ContainingElementIterator elem_iter = p_node->ContainingElementsBegin();
+         elem_iter != p_node->ContainingElementsEnd();
+         ++elem_iter)
+    {
+        Element<ELEMENT_DIM,SPACE_DIM>* p_element = static_cast<MutableMesh<ELEMENT_DIM,SPACE_DIM>&>((this->mrMesh)).GetElement(*elem_iter);
+
+        // Nodes shared by several elements are appended more than once, and removed by the caller
+        for (unsigned i=0; i<p_element->GetNumNodes(); i++)
+        {
+            unsigned node_index = p_element->GetNodeGlobalIndex(i);
+            if ((node_index != index) && !(this->IsGhostNode(node_index)))
+            {
+                rNeighbours.push_back(node_index);
+            }
+        }
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 std::set<unsigned> MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetNeighbouringNodeIndices(unsigned index)
 {
@@ -1236,6 +1472,7 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::CalculateRestLengths()
         mSpringRestLengths[node_pair] = separation;
     }
     mHasVariableRestLength = true;
+    mSpringTableRestLengthsAreStale = true;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -1274,6 +1511,7 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SetRestLength(unsigned inde
         {
             // modify the stored rest length
             iter->second = restLength;
+            mSpringTableRestLengthsAreStale = true;
         }
         else
         {
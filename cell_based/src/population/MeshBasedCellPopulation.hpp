@@ -89,6 +89,8 @@ private:
         archive & mWriteVtkAsPoints;
         archive & mOutputMeshInVtk;
         archive & mHasVariableRestLength;
+        archive & mUseIncrementalReMesh;
+        archive & mUseIncrementalVoronoiTessellation;
 
         this->Validate();
     }
@@ -142,11 +144,74 @@ protected:
     /** Whether springs have variable rest lengths. */
     bool mHasVariableRestLength;
 
+    /**
+     * Whether to update the existing triangulation in Update() where possible,
+     * rather than remeshing from scratch. Defaults to false.
+     */
+    bool mUseIncrementalReMesh;
+
+    /**
+     * Whether CreateVoronoiTessellation() should move the vertices of the existing tessellation,
+     * rather than regenerating it, when mrMesh has the same elements as when the tessellation was
+     * generated (e.g. when using incremental remeshing and no flips, births or deaths have occurred).
+     * Only used in 2D. Defaults to false.
+     */
+    bool mUseIncrementalVoronoiTessellation;
+
+    /** Volume (area in 2D) of each element of mpVoronoiTessellation, computed when first requested. */
+    std::vector<double> mVoronoiElementVolumes;
+
+    /** Surface area (perimeter in 2D) of each element of mpVoronoiTessellation, computed when first requested. */
+    std::vector<double> mVoronoiElementSurfaceAreas;
+
+    /** Whether each entry of mVoronoiElementVolumes and mVoronoiElementSurfaceAreas is out of date. */
+    std::vector<bool> mVoronoiElementIsStale;
+
     /** Node pairs for force calculations. */
     std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > > mNodePairs;
 
+    /** The index of the node at end A of each spring in the spring table (see UpdateSpringTable()). */
+    std::vector<unsigned> mSpringNodeIndicesA;
+
+    /** The index of the node at end B of each spring in the spring table. */
+    std::vector<unsigned> mSpringNodeIndicesB;
+
+    /** The cell attached to end A of each spring in the spring table. */
+    std::vector<CellPtr> mSpringCellsA;
+
+    /** The cell attached to end B of each spring in the spring table. */
+    std::vector<CellPtr> mSpringCellsB;
+
+    /** The rest length of each spring in the spring table, as returned by GetRestLength(). */
+    std::vector<double> mSpringTableRestLengths;
+
+    /**
+     * The global indices of the nodes of each element of the mesh when the spring table was
+     * built, with UINT_MAX for deleted elements. Used to detect changes in connectivity.
+     */
+    std::vector<unsigned> mSpringTableElementNodeIndices;
+
+    /** Whether the spring table must be rebuilt regardless of the mesh connectivity, e.g. because cells have been added or removed. */
+    bool mSpringTableIsStale;
+
+    /** Whether mSpringTableRestLengths must be refreshed from mSpringRestLengths. */
+    bool mSpringTableRestLengthsAreStale;
+
 // LCOV_EXCL_STOP // Avoid prototypes being treated as code by gcov
 
+    /**
+     * Compute the volume and surface area of a given element of mpVoronoiTessellation,
+     * if the cached values are out of date.
+     *
+     * @param elementIndex the global index of the element
+     */
+    void UpdateVoronoiElementGeometry(unsigned elementIndex);
+
+    /**
+     * @return whether the elements of the mesh have the same nodes as when the spring table was built.
+     */
+    bool SpringTableMatchesMesh();
+
     /**
      * Update mIsGhostNode if required by a remesh.
      *
@@ -154,6 +219,17 @@ protected:
      */
     virtual void UpdateGhostNodesAfterReMesh(NodeMap& rMap);
 
+    /**
+     * Overridden AppendNeighbouringLocationIndices() method.
+     *
+     * Appends the non-ghost nodes of the elements containing the node, without
+     * constructing a std::set.
+     *
+     * @param index a location index to which a cell is attached
+     * @param rNeighbours the vector to append to
+     */
+    virtual void AppendNeighbouringLocationIndices(unsigned index, std::vector<unsigned>& rNeighbours);
+
     /**
      * Check consistency of our internal data structures. Each node must
      * have a cell associated with it.
@@ -515,6 +591,59 @@ public:
      */
     SpringIterator SpringsEnd();
 
+    /**
+     * Bring the spring table up to date. The spring table lists the springs visited by
+     * SpringIterator, in the same order, as contiguous arrays of node indices and cells, so
+     * that forces can be evaluated without iterating over the edges of the mesh or looking
+     * up the cell attached to each node.
+     *
+     * The table is only rebuilt if cells have been added or removed, or the connectivity
+     * of the mesh has changed since it was last built (this is detected by comparing the
+     * nodes of each element, so is most effective with SetUseIncrementalReMesh()).
+     * The accessors below may be used until the population or its mesh next changes.
+     */
+    void UpdateSpringTable();
+
+    /**
+     * Force the spring table to be rebuilt the next time UpdateSpringTable() is called.
+     * This should be called if cells are reassigned to nodes without remeshing.
+     */
+    void InvalidateSpringTable();
+
+    /**
+     * @return the number of springs in the spring table.
+     */
+    unsigned GetNumSprings() const;
+
+    /**
+     * @return the index of the node at end A of each spring in the spring table.
+     */
+    const std::vector<unsigned>& rGetSpringNodeIndicesA() const;
+
+    /**
+     * @return the index of the node at end B of each spring in the spring table.
+     */
+    const std::vector<unsigned>& rGetSpringNodeIndicesB() const;
+
+    /**
+     * @return the cell at end A of each spring in the spring table.
+     */
+    const std::vector<CellPtr>& rGetSpringCellsA() const;
+
+    /**
+     * @return the cell at end B of each spring in the spring table.
+     */
+    const std::vector<CellPtr>& rGetSpringCellsB() const;
+
+    /**
+     * Get the rest length of each spring in the spring table, as returned by GetRestLength()
+     * (so not accounting for cell division or apoptosis). The rest lengths are looked up
+     * again only if they have been changed since they were last requested.
+     *
+     * @return the rest length of each spring in the spring table.
+     */
+    const std::vector<double>& rGetSpringRestLengths();
+
     /**
      * Helper method for use in debugging.
      */
@@ -570,6 +699,34 @@ public:
      */
     bool GetOutputMeshInVtk();
 
+    /**
+     * Set mUseIncrementalReMesh. If true, Update() asks the mesh to update its
+     * existing triangulation by node insertion and edge flips where it can; see
+     * MutableMesh::SetUseIncrementalReMesh().
+     *
+     * @param useIncrementalReMesh whether to remesh incrementally where possible
+     */
+    void SetUseIncrementalReMesh(bool useIncrementalReMesh);
+
+    /**
+     * @return mUseIncrementalReMesh.
+     */
+    bool GetUseIncrementalReMesh();
+
+    /**
+     * Set mUseIncrementalVoronoiTessellation. If true, CreateVoronoiTessellation() moves the
+     * vertices of the existing tessellation where the mesh has not changed topology, and only
+     * the areas and perimeters of the Voronoi elements that have changed are recomputed.
+     *
+     * @param useIncrementalVoronoiTessellation whether to update the tessellation in place where possible
+     */
+    void SetUseIncrementalVoronoiTessellation(bool useIncrementalVoronoiTessellation);
+
+    /**
+     * @return mUseIncrementalVoronoiTessellation.
+     */
+    bool GetUseIncrementalVoronoiTessellation();
+
     /**
      * Overridden GetNeighbouringNodeIndices() method.
      *
@@ -36,6 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MeshBasedCellPopulationWithGhostNodes.hpp"
 #include "Exception.hpp"
 #include "CellLocationIndexWriter.hpp"
+#include "CellBasedProfiler.hpp"
 
 template<unsigned DIM>
 MeshBasedCellPopulationWithGhostNodes<DIM>::MeshBasedCellPopulationWithGhostNodes(
@@ -135,6 +136,9 @@ void MeshBasedCellPopulationWithGhostNodes<DIM>::SetGhostNodes(const std::set<un
         this->mIsGhostNode[*iter] = true;
     }
 
+    // Springs to ghost nodes are excluded from the spring table
+    this->InvalidateSpringTable();
+
     Validate();
 }
 
@@ -253,21 +257,23 @@ std::set<unsigned> MeshBasedCellPopulationWithGhostNodes<DIM>::GetNeighbouringLo
 template<unsigned DIM>
 void MeshBasedCellPopulationWithGhostNodes<DIM>::AcceptCellWritersAcrossPopulation()
 {
-    for (typename AbstractMesh<DIM, DIM>::NodeIterator node_iter = this->rGetMesh().GetNodeIteratorBegin();
-         node_iter != this->rGetMesh().GetNodeIteratorEnd();
-         ++node_iter)
+    for (typename std::vector<boost::shared_ptr<AbstractCellWriter<DIM, DIM> > >::iterator cell_writer_iter = this->mCellWriters.begin();
+         cell_writer_iter != this->mCellWriters.end();
+         ++cell_writer_iter)
     {
-        // If it isn't a ghost node then there might be cell writers attached
-        if (! this->IsGhostNode(node_iter->GetIndex()))
+        unsigned timer = CellBasedProfiler::Instance()->BeginTimer("Writer", cell_writer_iter->get());
+        for (typename AbstractMesh<DIM, DIM>::NodeIterator node_iter = this->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->rGetMesh().GetNodeIteratorEnd();
+             ++node_iter)
         {
-            for (typename std::vector<boost::shared_ptr<AbstractCellWriter<DIM, DIM> > >::iterator cell_writer_iter = this->mCellWriters.begin();
-                 cell_writer_iter != this->mCellWriters.end();
-                 ++cell_writer_iter)
+            // If it isn't a ghost node then there might be cell writers attached
+            if (! this->IsGhostNode(node_iter->GetIndex()))
             {
                 CellPtr cell_from_node = this->GetCellUsingLocationIndex(node_iter->GetIndex());
                 this->AcceptCellWriter(*cell_writer_iter, cell_from_node);
             }
         }
+        CellBasedProfiler::Instance()->EndTimer(timer);
     }
 }
 
@@ -345,6 +351,7 @@ void MeshBasedCellPopulationWithGhostNodes<DIM>::WriteVtkResultsToFile(const std
 
         // Create mesh writer for VTK output
         VertexMeshWriter<DIM, DIM> mesh_writer(rDirectory, "results", false);
+        mesh_writer.SetWriteAsynchronously(this->mUseAsynchronousVtkOutput);
 
         // Iterate over any cell writers that are present
         unsigned num_vtk_cells = this->mpVoronoiTessellation->GetNumElements();
@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MutableMesh.hpp"
 #include "MathsCustomFunctions.hpp"
 #include "VtkMeshWriter.hpp"
+#include "CellBasedEventHandler.hpp"
 
 template<unsigned DIM>
 NodeBasedCellPopulation<DIM>::NodeBasedCellPopulation(NodesOnlyMesh<DIM>& rMesh,
@@ -47,8 +48,11 @@ NodeBasedCellPopulation<DIM>::NodeBasedCellPopulation(NodesOnlyMesh<DIM>& rMesh,
     : AbstractCentreBasedCellPopulation<DIM>(rMesh, rCells, locationIndices),
       mDeleteMesh(deleteMesh),
       mUseVariableRadii(false),
+      mUsePackedHaloMessages(false),
       mLoadBalanceMesh(false),
-      mLoadBalanceFrequency(100)
+      mLoadBalanceFrequency(100),
+      mUseOneStepSlabLoadBalance(false),
+      mForceTimeAtLastLoadBalance(0.0)
 {
     mpNodesOnlyMesh = static_cast<NodesOnlyMesh<DIM>* >(&(this->mrMesh));
 
@@ -63,8 +67,11 @@ NodeBasedCellPopulation<DIM>::NodeBasedCellPopulation(NodesOnlyMesh<DIM>& rMesh)
     : AbstractCentreBasedCellPopulation<DIM>(rMesh),
       mDeleteMesh(true),
       mUseVariableRadii(false), // will be set by serialize() method
+      mUsePackedHaloMessages(false),
       mLoadBalanceMesh(false),
-      mLoadBalanceFrequency(100)
+      mLoadBalanceFrequency(100),
+      mUseOneStepSlabLoadBalance(false),
+      mForceTimeAtLastLoadBalance(0.0)
 {
     mpNodesOnlyMesh = static_cast<NodesOnlyMesh<DIM>* >(&(this->mrMesh));
 }
@@ -107,6 +114,27 @@ TetrahedralMesh<DIM, DIM>* NodeBasedCellPopulation<DIM>::GetTetrahedralMeshForPd
     return new MutableMesh<DIM,DIM>(temp_nodes);
 }
 
+template<unsigned DIM>
+bool NodeBasedCellPopulation<DIM>::UpdateTetrahedralMeshForPdeModifier(TetrahedralMesh<DIM, DIM>* pMesh)
+{
+    // Use the same node ordering as GetTetrahedralMeshForPdeModifier()
+    std::vector<c_vector<double, DIM> > locations;
+    for (typename AbstractMesh<DIM,DIM>::NodeIterator node_iter = mpNodesOnlyMesh->GetNodeIteratorBegin();
+         node_iter != mpNodesOnlyMesh->GetNodeIteratorEnd();
+         ++node_iter)
+    {
+        locations.push_back(node_iter->rGetLocation());
+    }
+
+    MutableMesh<DIM,DIM>* p_mesh = dynamic_cast<MutableMesh<DIM,DIM>*>(pMesh);
+    if (p_mesh == NULL)
+    {
+        return false;
+    }
+    p_mesh->SetUseIncrementalReMesh(true);
+    return p_mesh->MoveNodesAndReMesh(locations);
+}
+
 template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::Clear()
 {
@@ -141,11 +169,16 @@ template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::SetNode(unsigned nodeIndex, ChastePoint<DIM>& rNewLocation)
 {
     mpNodesOnlyMesh->SetNode(nodeIndex, rNewLocation, false);
+
+    // Neighbours are found by distance, so moving a node may change them
+    this->InvalidateNeighbourAdjacency();
 }
 
 template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
 {
+    this->InvalidateNeighbourAdjacency();
+
     UpdateCellProcessLocation();
 
     mpNodesOnlyMesh->UpdateBoxCollection();
@@ -154,11 +187,43 @@ void NodeBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
     {
         if ((SimulationTime::Instance()->GetTimeStepsElapsed() % mLoadBalanceFrequency) == 0)
         {
-            mpNodesOnlyMesh->LoadBalanceMesh();
+            if (mUseOneStepSlabLoadBalance)
+            {
+                // Weight each node by the time this process has spent calculating forces per node
+                double force_time = CellBasedEventHandler::GetElapsedTime(CellBasedEventHandler::FORCE);
+                double elapsed_force_time = force_time - mForceTimeAtLastLoadBalance;
+                mForceTimeAtLastLoadBalance = force_time;
+
+                // Fall back to counting nodes unless every process has timed its forces
+                double cost_per_node = 1.0;
+                if (!PetscTools::ReplicateBool(!(elapsed_force_time > 0.0)))
+                {
+                    cost_per_node = elapsed_force_time/std::max(GetNumNodes(), 1u);
+                }
+                mpNodesOnlyMesh->RebalanceMeshSlabs(cost_per_node);
+
+                // Cells are only passed between neighbouring processes, so repeat until every cell has arrived
+                UpdateCellProcessLocation();
+                mpNodesOnlyMesh->CalculateNodesOutsideLocalDomain();
+                while (PetscTools::ReplicateBool(!mpNodesOnlyMesh->rGetNodesToSendLeft().empty()
+                                                 || !mpNodesOnlyMesh->rGetNodesToSendRight().empty()))
+                {
+                    UpdateCellProcessLocation();
+                    mpNodesOnlyMesh->CalculateNodesOutsideLocalDomain();
+                }
+            }
+            else
+            {
+                mpNodesOnlyMesh->LoadBalanceMesh();
 
-            UpdateCellProcessLocation();
+                UpdateCellProcessLocation();
+            }
 
             mpNodesOnlyMesh->UpdateBoxCollection();
+
+            // Most halo cells are new to the neighbouring processes after the domain boundaries move
+            mRightHaloCommunicator.Reset();
+            mLeftHaloCommunicator.Reset();
         }
     }
 
@@ -175,11 +240,12 @@ void NodeBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
      */
     if (mUseVariableRadii)
     {
+        static const CellDataKey radius_key("Radius");
         for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = this->Begin();
              cell_iter != this->End();
              ++cell_iter)
         {
-            double cell_radius = cell_iter->GetCellData()->GetItem("Radius");
+            double cell_radius = cell_iter->GetCellData()->GetItem(radius_key);
             unsigned node_index = this->GetLocationIndexUsingCell(*cell_iter);
             this->GetNode(node_index)->SetRadius(cell_radius);
         }
@@ -196,19 +262,29 @@ void NodeBasedCellPopulation<DIM>::UpdateMapsAfterRemesh(NodeMap& map)
     {
         UpdateParticlesAfterReMesh(map);
 
+        // The halo cells sent before were identified by their old node indices
+        mRightHaloCommunicator.Reset();
+        mLeftHaloCommunicator.Reset();
+
         // Update the mappings between cells and location indices
-        ///\todo we want to make mCellLocationMap private - we need to find a better way of doing this
-        std::map<Cell*, unsigned> old_map = this->mCellLocationMap;
+        std::vector<unsigned> old_node_indices;
+        old_node_indices.reserve(this->mCells.size());
+        for (std::vector<CellPtr>::iterator it = this->mCells.begin();
+             it != this->mCells.end();
+             ++it)
+        {
+            old_node_indices.push_back(this->GetLocationIndexUsingCell(*it));
+        }
 
         // Remove any dead pointers from the maps (needed to avoid archiving errors)
-        this->mLocationCellMap.clear();
-        this->mCellLocationMap.clear();
+        this->mCellLocationRegistry.Clear();
 
-        for (std::list<CellPtr>::iterator it = this->mCells.begin();
+        std::vector<unsigned>::iterator old_index_iter = old_node_indices.begin();
+        for (std::vector<CellPtr>::iterator it = this->mCells.begin();
              it != this->mCells.end();
-             ++it)
+             ++it, ++old_index_iter)
         {
-            unsigned old_node_index = old_map[(*it).get()];
+            unsigned old_node_index = *old_index_iter;
 
             // This shouldn't ever happen, as the cell vector only contains living cells
             assert(!map.IsDeleted(old_node_index));
@@ -225,29 +301,28 @@ template<unsigned DIM>
 unsigned NodeBasedCellPopulation<DIM>::RemoveDeadCells()
 {
     unsigned num_removed = 0;
-    for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
-         cell_iter != this->mCells.end();
-         )
+    // Remove the dead cells in a single pass, moving each remaining cell down so that they stay in order
+    unsigned num_cells_kept = 0;
+    for (unsigned cell_index=0; cell_index<this->mCells.size(); cell_index++)
     {
-        if ((*cell_iter)->IsDead())
+        CellPtr p_cell = this->mCells[cell_index];
+        if (p_cell->IsDead())
         {
             // Remove the node from the mesh
             num_removed++;
-            unsigned location_index = mpNodesOnlyMesh->SolveNodeMapping(this->GetLocationIndexUsingCell((*cell_iter)));
+            unsigned location_index = mpNodesOnlyMesh->SolveNodeMapping(this->GetLocationIndexUsingCell(p_cell));
             mpNodesOnlyMesh->DeleteNodePriorToReMesh(location_index);
 
             // Update mappings between cells and location indices
-            unsigned location_index_of_removed_node = this->GetLocationIndexUsingCell((*cell_iter));
-            this->RemoveCellUsingLocationIndex(location_index_of_removed_node, (*cell_iter));
-
-            // Update vector of cells
-            cell_iter = this->mCells.erase(cell_iter);
+            unsigned location_index_of_removed_node = this->GetLocationIndexUsingCell(p_cell);
+            this->RemoveCellUsingLocationIndex(location_index_of_removed_node, p_cell);
         }
         else
         {
-            ++cell_iter;
+            this->mCells[num_cells_kept++] = p_cell;
         }
     }
+    this->mCells.resize(num_cells_kept);
 
     return num_removed;
 }
@@ -348,6 +423,30 @@ void NodeBasedCellPopulation<DIM>::SetLoadBalanceFrequency(unsigned loadBalanceF
     mLoadBalanceFrequency = loadBalanceFrequency;
 }
 
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::SetUseOneStepSlabLoadBalance(bool useOneStepSlabLoadBalance)
+{
+    mUseOneStepSlabLoadBalance = useOneStepSlabLoadBalance;
+}
+
+template<unsigned DIM>
+bool NodeBasedCellPopulation<DIM>::GetUseOneStepSlabLoadBalance() const
+{
+    return mUseOneStepSlabLoadBalance;
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::SetUsePackedHaloMessages(bool usePackedHaloMessages)
+{
+    mUsePackedHaloMessages = usePackedHaloMessages;
+}
+
+template<unsigned DIM>
+bool NodeBasedCellPopulation<DIM>::GetUsePackedHaloMessages() const
+{
+    return mUsePackedHaloMessages;
+}
+
 template<unsigned DIM>
 double NodeBasedCellPopulation<DIM>::GetWidth(const unsigned& rDimension)
 {
@@ -427,8 +526,15 @@ std::set<unsigned> NodeBasedCellPopulation<DIM>::GetNodesWithinNeighbourhoodRadi
 template<unsigned DIM>
 std::set<unsigned> NodeBasedCellPopulation<DIM>::GetNeighbouringNodeIndices(unsigned index)
 {
-    std::set<unsigned> neighbouring_node_indices;
+    std::vector<unsigned> neighbouring_node_indices;
+    AppendNeighbouringLocationIndices(index, neighbouring_node_indices);
 
+    return std::set<unsigned>(neighbouring_node_indices.begin(), neighbouring_node_indices.end());
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::AppendNeighbouringLocationIndices(unsigned index, std::vector<unsigned>& rNeighbours)
+{
     // Get location and radius of node
     Node<DIM>* p_node_i = this->GetNode(index);
     const c_vector<double, DIM>& r_node_i_location = p_node_i->rGetLocation();
@@ -481,13 +587,11 @@ std::set<unsigned> NodeBasedCellPopulation<DIM>::GetNeighbouringNodeIndices(unsi
             }
             if (distance_between_nodes <= max_interaction_distance)// + DBL_EPSILSON) //Assumes that max_interaction_distance is of order 1
             {
-                // ...then add this node index to the set of neighbouring node indices
-                neighbouring_node_indices.insert((*iter));
+                // ...then add this node index to the neighbouring node indices
+                rNeighbours.push_back(*iter);
             }
         }
     }
-
-    return neighbouring_node_indices;
 }
 
 template<unsigned DIM>
@@ -510,9 +614,6 @@ double NodeBasedCellPopulation<DIM>::GetVolumeOfCell(CellPtr pCell)
     // Get the location of this node
     const c_vector<double, DIM>& r_node_i_location = GetNode(node_index)->rGetLocation();
 
-    // Get the set of node indices corresponding to this cell's neighbours
-    std::set<unsigned> neighbouring_node_indices = GetNeighbouringNodeIndices(node_index);
-
     // THe number of neighbours in equilibrium configuration, from sphere packing problem
     unsigned num_neighbours_equil;
     if (DIM==2)
@@ -525,9 +626,9 @@ double NodeBasedCellPopulation<DIM>::GetVolumeOfCell(CellPtr pCell)
         num_neighbours_equil = 12;
     }
 
-    // Loop over this set
-    for (std::set<unsigned>::iterator iter = neighbouring_node_indices.begin();
-         iter != neighbouring_node_indices.end();
+    // Loop over the node indices corresponding to this cell's neighbours
+    for (typename AbstractCellPopulation<DIM>::NeighbourIterator iter = this->GetNeighbouringLocationsBegin(node_index);
+         iter != this->GetNeighbouringLocationsEnd(node_index);
          ++iter)
     {
         Node<DIM>* p_node_j = this->GetNode(*iter);
@@ -615,6 +716,7 @@ void NodeBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDir
 
     // Create mesh writer for VTK output
     VtkMeshWriter<DIM, DIM> mesh_writer(rDirectory, "results_"+time.str(), false);
+    mesh_writer.SetWriteAsynchronously(this->mUseAsynchronousVtkOutput);
     mesh_writer.SetParallelFiles(*mpNodesOnlyMesh);
 
     // Iterate over any cell writers that are present
@@ -727,7 +829,7 @@ void NodeBasedCellPopulation<DIM>::DeleteMovedCell(unsigned index)
     mpNodesOnlyMesh->DeleteMovedNode(index);
 
     // Update vector of cells
-    for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
+    for (std::vector<CellPtr>::iterator cell_iter = this->mCells.begin();
          cell_iter != this->mCells.end();
          ++cell_iter)
     {
@@ -925,7 +1027,23 @@ void NodeBasedCellPopulation<DIM>::RefreshHaloCells()
     std::vector<unsigned> halos_to_send_left = mpNodesOnlyMesh->rGetHaloNodesToSendLeft();
     AddCellsToSendLeft(halos_to_send_left);
 
-    NonBlockingSendCellsToNeighbourProcesses();
+    if (mUsePackedHaloMessages)
+    {
+        if (!PetscTools::AmTopMost())
+        {
+            int tag = SmallPow(2u, 1+ PetscTools::GetMyRank() ) * SmallPow (3u, 1 + PetscTools::GetMyRank() + 1);
+            mRightHaloCommunicator.ISendCells(mCellsToSendRight, PetscTools::GetMyRank() + 1, tag);
+        }
+        if (!PetscTools::AmMaster())
+        {
+            int tag = SmallPow (2u, 1 + PetscTools::GetMyRank() ) * SmallPow (3u, 1 + PetscTools::GetMyRank() - 1);
+            mLeftHaloCommunicator.ISendCells(mCellsToSendLeft, PetscTools::GetMyRank() - 1, tag);
+        }
+    }
+    else
+    {
+        NonBlockingSendCellsToNeighbourProcesses();
+    }
 }
 
 template<unsigned DIM>
@@ -953,7 +1071,23 @@ void NodeBasedCellPopulation<DIM>::AddCellsToSendLeft(std::vector<unsigned>& cel
 template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::AddReceivedHaloCells()
 {
-    GetReceivedCells();
+    if (mUsePackedHaloMessages)
+    {
+        if (!PetscTools::AmTopMost())
+        {
+            int tag = SmallPow (3u, 1 + PetscTools::GetMyRank() ) * SmallPow (2u, 1+ PetscTools::GetMyRank() + 1);
+            mpCellsRecvRight.reset(new std::vector<std::pair<CellPtr, Node<DIM>* > >(mRightHaloCommunicator.RecvCells(PetscTools::GetMyRank() + 1, tag)));
+        }
+        if (!PetscTools::AmMaster())
+        {
+            int tag = SmallPow (3u, 1 + PetscTools::GetMyRank() ) * SmallPow (2u, 1+ PetscTools::GetMyRank() - 1);
+            mpCellsRecvLeft.reset(new std::vector<std::pair<CellPtr, Node<DIM>* > >(mLeftHaloCommunicator.RecvCells(PetscTools::GetMyRank() - 1, tag)));
+        }
+    }
+    else
+    {
+        GetReceivedCells();
+    }
 
     if (!PetscTools::AmMaster())
     {
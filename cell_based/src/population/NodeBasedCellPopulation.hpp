@@ -46,6 +46,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractCentreBasedCellPopulation.hpp"
 #include "NodesOnlyMesh.hpp"
+#include "PackedHaloCellCommunicator.hpp"
 
 /**
  * A NodeBasedCellPopulation is a CellPopulation consisting of only nodes in space with associated cells.
@@ -97,6 +98,15 @@ private:
     /** A communicator to send cells to the left hand process */
     ObjectCommunicator<std::vector<std::pair<CellPtr, Node<DIM>* > > > mLeftCommunicator;
 
+    /** Whether halo cells are sent with #mRightHaloCommunicator and #mLeftHaloCommunicator rather than serialised in full. */
+    bool mUsePackedHaloMessages;
+
+    /** A communicator to send halo cells to the right hand process as plain data */
+    PackedHaloCellCommunicator<DIM> mRightHaloCommunicator;
+
+    /** A communicator to send halo cells to the left hand process as plain data */
+    PackedHaloCellCommunicator<DIM> mLeftHaloCommunicator;
+
     /** The tag used to send and recieve cell information */
     static const unsigned mCellCommunicationTag = 123;
 
@@ -115,6 +125,15 @@ private:
     /** The frequency at which the mesh is rebalanced */
     unsigned mLoadBalanceFrequency;
 
+    /**
+     * Whether to move all the slab boundaries of the mesh in a single step, using the measured time
+     * spent calculating forces on each process, rather than moving each boundary by at most one row.
+     */
+    bool mUseOneStepSlabLoadBalance;
+
+    /** The time (in milliseconds) recorded against CellBasedEventHandler::FORCE at the last load balance. */
+    double mForceTimeAtLastLoadBalance;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -220,6 +239,14 @@ protected:
      */
     virtual void UpdateParticlesAfterReMesh(NodeMap& rMap);
 
+    /**
+     * Overridden AppendNeighbouringLocationIndices() method.
+     *
+     * @param index a location index to which a cell is attached
+     * @param rNeighbours the vector to append to
+     */
+    virtual void AppendNeighbouringLocationIndices(unsigned index, std::vector<unsigned>& rNeighbours);
+
     /**
      * Check consistency of our internal data structures.
      */
@@ -294,6 +321,17 @@ public:
      */
     virtual TetrahedralMesh<DIM, DIM>* GetTetrahedralMeshForPdeModifier();
 
+    /**
+     * Overridden UpdateTetrahedralMeshForPdeModifier() method.
+     *
+     * Moves the nodes of a mesh created by GetTetrahedralMeshForPdeModifier() to
+     * the current node locations and updates its triangulation incrementally where possible.
+     *
+     * @param pMesh the mesh to update
+     * @return whether the mesh was updated
+     */
+    virtual bool UpdateTetrahedralMeshForPdeModifier(TetrahedralMesh<DIM, DIM>* pMesh);
+
     /**
      * @return the number of nodes in the cell population.
      */
@@ -411,6 +449,39 @@ public:
      */
     void SetLoadBalanceFrequency(unsigned loadBalanceFrequency);
 
+    /**
+     * Set whether load balancing should move all the slab boundaries of the mesh in a single step, weighting
+     * each node by the time spent calculating forces on its process since the last load balance (or counting
+     * nodes if no forces have been timed). Only has an effect if SetLoadBalanceMesh() has been called.
+     *
+     * This only changes where the slab boundaries go: the domain is still divided into slabs of whole rows
+     * along its last dimension, so a population that is clustered within a few rows cannot be balanced.
+     * See NodesOnlyMesh::RebalanceMeshSlabs().
+     *
+     * @param useOneStepSlabLoadBalance whether to move the slab boundaries in a single step.
+     */
+    void SetUseOneStepSlabLoadBalance(bool useOneStepSlabLoadBalance);
+
+    /**
+     * @return #mUseOneStepSlabLoadBalance
+     */
+    bool GetUseOneStepSlabLoadBalance() const;
+
+    /**
+     * Set whether halo cells should be sent as plain data (locations, radii, birth times and CellData)
+     * once a neighbouring process holds a copy, rather than being serialised in full at every update.
+     * Other changes to a halo cell, such as a new mutation state, are only seen by the neighbouring
+     * process when the cell next enters its halo. See PackedHaloCellCommunicator.
+     *
+     * @param usePackedHaloMessages whether to use packed halo messages.
+     */
+    void SetUsePackedHaloMessages(bool usePackedHaloMessages);
+
+    /**
+     * @return #mUsePackedHaloMessages
+     */
+    bool GetUsePackedHaloMessages() const;
+
     /**
      * Overridden GetWidth() method.
      *
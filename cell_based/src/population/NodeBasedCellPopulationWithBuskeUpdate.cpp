@@ -94,11 +94,9 @@ void NodeBasedCellPopulationWithBuskeUpdate<DIM>::UpdateNodeLocations(double dt)
 
         // loop over neighbours to add contribution
 
-        // Get the set of node indices corresponding to this cell's neighbours
-        std::set<unsigned> neighbouring_node_indices = this->GetNeighbouringNodeIndices(global_node_index);
-
-        for (std::set<unsigned>::iterator iter = neighbouring_node_indices.begin();
-             iter != neighbouring_node_indices.end();
+        // Loop over the node indices corresponding to this cell's neighbours
+        for (typename AbstractCellPopulation<DIM>::NeighbourIterator iter = this->GetNeighbouringLocationsBegin(global_node_index);
+             iter != this->GetNeighbouringLocationsEnd(global_node_index);
              ++iter)
         {
             unsigned neighbour_node_global_index = *iter;
@@ -42,6 +42,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellProliferativeTypesWriter.hpp"
 #include "CellVolumesWriter.hpp"
 #include "CellMutationStatesCountWriter.hpp"
+#include "CellBasedProfiler.hpp"
 
 template<unsigned DIM>
 NodeBasedCellPopulationWithParticles<DIM>::NodeBasedCellPopulationWithParticles(NodesOnlyMesh<DIM>& rMesh,
@@ -194,21 +195,23 @@ void NodeBasedCellPopulationWithParticles<DIM>::Validate()
 template<unsigned DIM>
 void NodeBasedCellPopulationWithParticles<DIM>::AcceptCellWritersAcrossPopulation()
 {
-    for (typename AbstractMesh<DIM, DIM>::NodeIterator node_iter = this->rGetMesh().GetNodeIteratorBegin();
-         node_iter != this->rGetMesh().GetNodeIteratorEnd();
-         ++node_iter)
+    for (typename std::vector<boost::shared_ptr<AbstractCellWriter<DIM, DIM> > >::iterator cell_writer_iter = this->mCellWriters.begin();
+         cell_writer_iter != this->mCellWriters.end();
+         ++cell_writer_iter)
     {
-        // If it isn't a particle then there might be cell writers attached
-        if (! this->IsParticle(node_iter->GetIndex()))
+        unsigned timer = CellBasedProfiler::Instance()->BeginTimer("Writer", cell_writer_iter->get());
+        for (typename AbstractMesh<DIM, DIM>::NodeIterator node_iter = this->rGetMesh().GetNodeIteratorBegin();
+             node_iter != this->rGetMesh().GetNodeIteratorEnd();
+             ++node_iter)
         {
-            for (typename std::vector<boost::shared_ptr<AbstractCellWriter<DIM, DIM> > >::iterator cell_writer_iter = this->mCellWriters.begin();
-                 cell_writer_iter != this->mCellWriters.end();
-                 ++cell_writer_iter)
+            // If it isn't a particle then there might be cell writers attached
+            if (! this->IsParticle(node_iter->GetIndex()))
             {
                 CellPtr cell_from_node = this->GetCellUsingLocationIndex(node_iter->GetIndex());
                 this->AcceptCellWriter(*cell_writer_iter, cell_from_node);
             }
         }
+        CellBasedProfiler::Instance()->EndTimer(timer);
     }
 }
 
@@ -248,6 +251,7 @@ void NodeBasedCellPopulationWithParticles<DIM>::WriteVtkResultsToFile(const std:
 
     // Create mesh writer for VTK output
     VtkMeshWriter<DIM, DIM> mesh_writer(rDirectory, "results_"+time.str(), false);
+    mesh_writer.SetWriteAsynchronously(this->mUseAsynchronousVtkOutput);
     mesh_writer.SetParallelFiles(*(this->mpNodesOnlyMesh));
 
     // Iterate over any cell writers that are present
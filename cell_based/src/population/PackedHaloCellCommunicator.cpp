@@ -0,0 +1,257 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+// Serialisation headers - must come first
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "PackedHaloCellCommunicator.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include "CellData.hpp"
+#include "Exception.hpp"
+
+/**
+ * Append a plain value to the end of a message buffer.
+ *
+ * @param rBuffer the buffer
+ * @param value the value
+ */
+template<typename TYPE>
+static void AppendToBuffer(std::vector<char>& rBuffer, TYPE value)
+{
+    unsigned old_size = rBuffer.size();
+    rBuffer.resize(old_size + sizeof(TYPE));
+    memcpy(&rBuffer[old_size], &value, sizeof(TYPE));
+}
+
+/**
+ * Read a plain value from a message buffer.
+ *
+ * @param rBuffer the buffer
+ * @param rPosition the position to read from, advanced past the value
+ * @return the value
+ */
+template<typename TYPE>
+static TYPE ReadFromBuffer(const std::vector<char>& rBuffer, unsigned& rPosition)
+{
+    assert(rPosition + sizeof(TYPE) <= rBuffer.size());
+    TYPE value;
+    memcpy(&value, &rBuffer[rPosition], sizeof(TYPE));
+    rPosition += sizeof(TYPE);
+    return value;
+}
+
+template<unsigned DIM>
+PackedHaloCellCommunicator<DIM>::PackedHaloCellCommunicator()
+    : mIsSending(false)
+{
+}
+
+template<unsigned DIM>
+PackedHaloCellCommunicator<DIM>::~PackedHaloCellCommunicator()
+{
+    if (mIsSending)
+    {
+        MPI_Wait(&mSendRequest, MPI_STATUS_IGNORE);
+    }
+}
+
+template<unsigned DIM>
+void PackedHaloCellCommunicator<DIM>::Pack(const std::vector<std::pair<CellPtr, Node<DIM>* > >& rCellsToSend)
+{
+    std::map<unsigned, std::pair<CellPtr, unsigned> > cells_sent;
+    std::vector<std::pair<CellPtr, Node<DIM>* > > cells_to_serialise;
+    std::vector<unsigned> packed_cells;
+
+    for (unsigned i=0; i<rCellsToSend.size(); i++)
+    {
+        CellPtr p_cell = rCellsToSend[i].first;
+        unsigned node_index = rCellsToSend[i].second->GetIndex();
+        unsigned key_signature = p_cell->GetCellData()->GetKeySignature();
+
+        typename std::map<unsigned, std::pair<CellPtr, unsigned> >::iterator it = mCellsSent.find(node_index);
+        if (it != mCellsSent.end() && it->second.first == p_cell && it->second.second == key_signature)
+        {
+            packed_cells.push_back(i);
+        }
+        else
+        {
+            cells_to_serialise.push_back(rCellsToSend[i]);
+        }
+        cells_sent[node_index] = std::pair<CellPtr, unsigned>(p_cell, key_signature);
+    }
+    mCellsSent.swap(cells_sent);
+
+    mSendBuffer.clear();
+    AppendToBuffer<unsigned>(mSendBuffer, packed_cells.size());
+    for (unsigned i=0; i<packed_cells.size(); i++)
+    {
+        CellPtr p_cell = rCellsToSend[packed_cells[i]].first;
+        Node<DIM>* p_node = rCellsToSend[packed_cells[i]].second;
+
+        AppendToBuffer<unsigned>(mSendBuffer, p_node->GetIndex());
+        const c_vector<double, DIM>& r_location = p_node->rGetLocation();
+        for (unsigned d=0; d<DIM; d++)
+        {
+            AppendToBuffer<double>(mSendBuffer, r_location[d]);
+        }
+        AppendToBuffer<double>(mSendBuffer, p_node->GetRadius());
+        AppendToBuffer<double>(mSendBuffer, p_cell->GetBirthTime());
+
+        // CellData values are sent in alphabetical order of their keys, which is the same on every process
+        boost::shared_ptr<CellData> p_cell_data = p_cell->GetCellData();
+        std::vector<std::string> keys = p_cell_data->GetKeys();
+        for (unsigned k=0; k<keys.size(); k++)
+        {
+            AppendToBuffer<double>(mSendBuffer, p_cell_data->GetItem(keys[k]));
+        }
+    }
+
+    // The cells the neighbour does not yet hold follow, serialised in full
+    std::ostringstream ss(std::ios::binary);
+    {
+        boost::archive::binary_oarchive output_arch(ss);
+        output_arch << cells_to_serialise;
+    }
+    const std::string serialised_cells = ss.str();
+    mSendBuffer.insert(mSendBuffer.end(), serialised_cells.begin(), serialised_cells.end());
+}
+
+template<unsigned DIM>
+std::vector<std::pair<CellPtr, Node<DIM>* > > PackedHaloCellCommunicator<DIM>::Unpack()
+{
+    std::vector<std::pair<CellPtr, Node<DIM>* > > cells;
+    std::map<unsigned, CellPtr> received_cells;
+
+    unsigned position = 0;
+    unsigned num_packed_cells = ReadFromBuffer<unsigned>(mRecvBuffer, position);
+    for (unsigned i=0; i<num_packed_cells; i++)
+    {
+        unsigned node_index = ReadFromBuffer<unsigned>(mRecvBuffer, position);
+        c_vector<double, DIM> location;
+        for (unsigned d=0; d<DIM; d++)
+        {
+            location[d] = ReadFromBuffer<double>(mRecvBuffer, position);
+        }
+        double radius = ReadFromBuffer<double>(mRecvBuffer, position);
+        double birth_time = ReadFromBuffer<double>(mRecvBuffer, position);
+
+        std::map<unsigned, CellPtr>::iterator it = mReceivedCells.find(node_index);
+        if (it == mReceivedCells.end())
+        {
+            EXCEPTION("The halo cell at node " << node_index << " has not been received in full");
+        }
+        CellPtr p_cell = it->second;
+        p_cell->SetBirthTime(birth_time);
+
+        boost::shared_ptr<CellData> p_cell_data = p_cell->GetCellData();
+        std::vector<std::string> keys = p_cell_data->GetKeys();
+        for (unsigned k=0; k<keys.size(); k++)
+        {
+            p_cell_data->SetItem(keys[k], ReadFromBuffer<double>(mRecvBuffer, position));
+        }
+
+        Node<DIM>* p_node = new Node<DIM>(node_index, location);
+        p_node->SetRadius(radius);
+
+        cells.push_back(std::pair<CellPtr, Node<DIM>* >(p_cell, p_node));
+        received_cells[node_index] = p_cell;
+    }
+
+    std::vector<std::pair<CellPtr, Node<DIM>* > > serialised_cells;
+    std::string serialised_string(mRecvBuffer.begin() + position, mRecvBuffer.end());
+    std::istringstream ss(serialised_string, std::ios::binary);
+    {
+        boost::archive::binary_iarchive input_arch(ss);
+        input_arch >> serialised_cells;
+    }
+    for (unsigned i=0; i<serialised_cells.size(); i++)
+    {
+        cells.push_back(serialised_cells[i]);
+        received_cells[serialised_cells[i].second->GetIndex()] = serialised_cells[i].first;
+    }
+
+    mReceivedCells.swap(received_cells);
+
+    return cells;
+}
+
+template<unsigned DIM>
+void PackedHaloCellCommunicator<DIM>::ISendCells(const std::vector<std::pair<CellPtr, Node<DIM>* > >& rCellsToSend, unsigned destinationProcess, int tag)
+{
+    // The buffer of the previous message must not be overwritten until it has been sent
+    if (mIsSending)
+    {
+        MPI_Wait(&mSendRequest, MPI_STATUS_IGNORE);
+    }
+
+    Pack(rCellsToSend);
+
+    MPI_Isend(&mSendBuffer[0], mSendBuffer.size(), MPI_BYTE, destinationProcess, tag, PetscTools::GetWorld(), &mSendRequest);
+    mIsSending = true;
+}
+
+template<unsigned DIM>
+std::vector<std::pair<CellPtr, Node<DIM>* > > PackedHaloCellCommunicator<DIM>::RecvCells(unsigned sourceProcess, int tag)
+{
+    MPI_Status status;
+    MPI_Probe(sourceProcess, tag, PetscTools::GetWorld(), &status);
+
+    int recv_size;
+    MPI_Get_count(&status, MPI_BYTE, &recv_size);
+    mRecvBuffer.resize(recv_size);
+
+    MPI_Recv(&mRecvBuffer[0], recv_size, MPI_BYTE, sourceProcess, tag, PetscTools::GetWorld(), &status);
+
+    return Unpack();
+}
+
+template<unsigned DIM>
+void PackedHaloCellCommunicator<DIM>::Reset()
+{
+    mCellsSent.clear();
+}
+
+// Explicit instantiation
+template class PackedHaloCellCommunicator<1>;
+template class PackedHaloCellCommunicator<2>;
+template class PackedHaloCellCommunicator<3>;
@@ -0,0 +1,150 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef PACKEDHALOCELLCOMMUNICATOR_HPP_
+#define PACKEDHALOCELLCOMMUNICATOR_HPP_
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "Cell.hpp"
+#include "Node.hpp"
+#include "PetscTools.hpp"
+
+/**
+ * Sends the halo cells of a NodeBasedCellPopulation to one neighbouring process
+ * and receives the halo cells sent back, as an alternative to ObjectCommunicator.
+ *
+ * A cell is serialised in full only the first time it is sent as a halo cell, or
+ * when the set of keys in its CellData has changed (as recorded by
+ * CellData::GetKeySignature()). While it stays in the halo
+ * it is sent as plain data: its node index, location, radius, birth time and
+ * CellData values. Cells are identified by their node index, which is unique
+ * across processes; the sender also checks that the cell at that index is the
+ * same cell it sent before, since the indices of dead cells are reused. The
+ * receiving process keeps the cells it has already been sent and updates them in
+ * place. Any other change to a halo cell, such as a new
+ * mutation state or label, is not seen by the neighbour until the cell leaves the
+ * halo and is sent again.
+ *
+ * Each refresh is a single message, sized on arrival with MPI_Probe, so there is
+ * no limit on the size of the halo.
+ */
+template<unsigned DIM>
+class PackedHaloCellCommunicator
+{
+private:
+
+    friend class TestPackedHaloCellCommunicator;
+
+    /**
+     * The cells the neighbour holds after the last message, with the signature of
+     * the CellData keys sent for each, keyed by node index.
+     */
+    std::map<unsigned, std::pair<CellPtr, unsigned> > mCellsSent;
+
+    /** The halo cells received from the neighbour in the last message, keyed by node index. */
+    std::map<unsigned, CellPtr> mReceivedCells;
+
+    /** The buffer of the message being sent. Kept until the send completes. */
+    std::vector<char> mSendBuffer;
+
+    /** The buffer of the last message received. */
+    std::vector<char> mRecvBuffer;
+
+    /** The request for the message being sent. */
+    MPI_Request mSendRequest;
+
+    /** Whether a send has been posted and not yet completed. */
+    bool mIsSending;
+
+    /**
+     * Pack the given halo cells into #mSendBuffer, recording which cells the
+     * neighbour will hold once it has unpacked the message.
+     *
+     * @param rCellsToSend the halo cells and their nodes
+     */
+    void Pack(const std::vector<std::pair<CellPtr, Node<DIM>* > >& rCellsToSend);
+
+    /**
+     * Unpack the halo cells in #mRecvBuffer, replacing the cells held from the
+     * previous message.
+     *
+     * @return the halo cells, each with a new node that the caller must delete
+     */
+    std::vector<std::pair<CellPtr, Node<DIM>* > > Unpack();
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    PackedHaloCellCommunicator();
+
+    /**
+     * Destructor. Waits for any outstanding send to complete.
+     */
+    ~PackedHaloCellCommunicator();
+
+    /**
+     * Post a non-blocking send of the given halo cells.
+     *
+     * @param rCellsToSend the halo cells and their nodes
+     * @param destinationProcess the neighbouring process
+     * @param tag the message tag
+     */
+    void ISendCells(const std::vector<std::pair<CellPtr, Node<DIM>* > >& rCellsToSend, unsigned destinationProcess, int tag);
+
+    /**
+     * Receive the halo cells sent by the neighbour with ISendCells().
+     *
+     * @param sourceProcess the neighbouring process
+     * @param tag the message tag
+     * @return the halo cells, each with a new node that the caller must delete
+     */
+    std::vector<std::pair<CellPtr, Node<DIM>* > > RecvCells(unsigned sourceProcess, int tag);
+
+    /**
+     * Forget every cell sent, so the next message serialises every cell. The
+     * neighbour replaces the cells it holds with each message it receives, so this
+     * need only be called on the sending side, e.g. when node indices change.
+     */
+    void Reset();
+};
+
+#endif /*PACKEDHALOCELLCOMMUNICATOR_HPP_*/
@@ -39,6 +39,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractPottsUpdateRule.hpp"
 #include "NodesOnlyMesh.hpp"
 #include "Exception.hpp"
+#include "CellBasedProfiler.hpp"
 #include "CellPopulationElementWriter.hpp"
 #include "CellIdWriter.hpp"
 
@@ -147,6 +148,27 @@ TetrahedralMesh<DIM, DIM>* PottsBasedCellPopulation<DIM>::GetTetrahedralMeshForP
     return new MutableMesh<DIM, DIM>(temp_nodes);
 }
 
+template<unsigned DIM>
+bool PottsBasedCellPopulation<DIM>::UpdateTetrahedralMeshForPdeModifier(TetrahedralMesh<DIM, DIM>* pMesh)
+{
+    // Use the same node ordering as GetTetrahedralMeshForPdeModifier()
+    std::vector<c_vector<double, DIM> > locations;
+    for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = this->Begin();
+         cell_iter != this->End();
+         ++cell_iter)
+    {
+        locations.push_back(this->GetLocationOfCellCentre(*cell_iter));
+    }
+
+    MutableMesh<DIM, DIM>* p_mesh = dynamic_cast<MutableMesh<DIM, DIM>*>(pMesh);
+    if (p_mesh == NULL)
+    {
+        return false;
+    }
+    p_mesh->SetUseIncrementalReMesh(true);
+    return p_mesh->MoveNodesAndReMesh(locations);
+}
+
 template<unsigned DIM>
 PottsElement<DIM>* PottsBasedCellPopulation<DIM>::GetElement(unsigned elementIndex)
 {
@@ -213,33 +235,37 @@ unsigned PottsBasedCellPopulation<DIM>::RemoveDeadCells()
 {
     unsigned num_removed = 0;
 
-    for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
-         cell_iter != this->mCells.end();
-         )
+    // Remove the dead cells in a single pass, moving each remaining cell down so that they stay in order
+    unsigned num_cells_kept = 0;
+    for (unsigned cell_index=0; cell_index<this->mCells.size(); cell_index++)
     {
-        if ((*cell_iter)->IsDead())
+        CellPtr p_cell = this->mCells[cell_index];
+        if (p_cell->IsDead())
         {
             // Get the location index corresponding to this cell
-            unsigned location_index = this->GetLocationIndexUsingCell(*cell_iter);
+            unsigned location_index = this->GetLocationIndexUsingCell(p_cell);
 
             // Use this to remove the cell from the population
             mpPottsMesh->DeleteElement(location_index);
 
-            // Erase cell and update counter
-            cell_iter = this->mCells.erase(cell_iter);
+            // Update counter
             num_removed++;
         }
         else
         {
-            ++cell_iter;
+            this->mCells[num_cells_kept++] = p_cell;
         }
     }
+    this->mCells.resize(num_cells_kept);
     return num_removed;
 }
 
 template<unsigned DIM>
 void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
 {
+    // Moving element boundaries changes which elements neighbour each other
+    this->InvalidateNeighbourAdjacency();
+
     /*
      * This method implements a Monte Carlo method to update the cell population.
      * We sample randomly from all nodes in the mesh. Once we have selected a target
@@ -254,6 +280,7 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
 
     RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
     unsigned num_nodes = this->mrMesh.GetNumNodes();
+    unsigned long num_moves_accepted = 0;
 
     // Randomly permute mUpdateRuleCollection if specified
     if (this->mIterateRandomlyOverUpdateRuleCollection)
@@ -276,34 +303,22 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
             node_index = i%num_nodes;
         }
 
-        Node<DIM>* p_node = this->mrMesh.GetNode(node_index);
-
         // Each node in the mesh must be in at most one element
-        assert(p_node->GetNumContainingElements() <= 1);
+        assert(this->mrMesh.GetNode(node_index)->GetNumContainingElements() <= 1);
 
         // Find a random available neighbouring node to overwrite current site
-        std::set<unsigned> neighbouring_node_indices = mpPottsMesh->GetMooreNeighbouringNodeIndices(node_index);
-        unsigned neighbour_location_index;
+        unsigned num_neighbours = mpPottsMesh->GetNumMooreNeighbours(node_index);
 
-        if (!neighbouring_node_indices.empty())
+        if (num_neighbours > 0)
         {
-            unsigned num_neighbours = neighbouring_node_indices.size();
             unsigned chosen_neighbour = p_gen->randMod(num_neighbours);
+            unsigned neighbour_location_index = mpPottsMesh->GetMooreNeighbour(node_index, chosen_neighbour);
 
-            std::set<unsigned>::iterator neighbour_iter = neighbouring_node_indices.begin();
-            for (unsigned j=0; j<chosen_neighbour; j++)
-            {
-                neighbour_iter++;
-            }
-
-            neighbour_location_index = *neighbour_iter;
+            unsigned containing_element = mpPottsMesh->GetContainingElementIndexOfNode(node_index);
+            unsigned neighbour_containing_element = mpPottsMesh->GetContainingElementIndexOfNode(neighbour_location_index);
 
-            std::set<unsigned> containing_elements = p_node->rGetContainingElementIndices();
-            std::set<unsigned> neighbour_containing_elements = GetNode(neighbour_location_index)->rGetContainingElementIndices();
             // Only calculate Hamiltonian and update elements if the nodes are from different elements, or one is from the medium
-            if ((!containing_elements.empty() && neighbour_containing_elements.empty())
-                || (containing_elements.empty() && !neighbour_containing_elements.empty())
-                || (!containing_elements.empty() && !neighbour_containing_elements.empty() && *containing_elements.begin() != *neighbour_containing_elements.begin()))
+            if (containing_element != neighbour_containing_element)
             {
                 double delta_H = 0.0; // This is H_1-H_0.
 
@@ -313,7 +328,7 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
                      ++iter)
                 {
                     // This static cast is fine, since we assert the update rule must be a Potts update rule in AddUpdateRule()
-                    double dH = (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContribution(neighbour_location_index, p_node->GetIndex(), *this);
+                    double dH = (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContribution(neighbour_location_index, node_index, *this);
                     delta_H += dH;
                 }
 
@@ -323,29 +338,19 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
                 double p = exp(-delta_H/mTemperature);
                 if (delta_H <= 0 || random_number < p)
                 {
-                    // Do swap
-
-                    // Remove the current node from any elements containing it (there should be at most one such element)
-                    for (std::set<unsigned>::iterator iter = containing_elements.begin();
-                         iter != containing_elements.end();
-                         ++iter)
-                    {
-                        GetElement(*iter)->DeleteNode(GetElement(*iter)->GetNodeLocalIndex(node_index));
-
-                        ///\todo If this causes the element to have no nodes then flag the element and cell to be deleted
-                    }
-
-                    // Next add the current node to any elements containing the neighbouring node (there should be at most one such element)
-                    for (std::set<unsigned>::iterator iter = neighbour_containing_elements.begin();
-                         iter != neighbour_containing_elements.end();
-                         ++iter)
-                    {
-                        GetElement(*iter)->AddNode(this->mrMesh.GetNode(node_index));
-                    }
+                    /*
+                     * Do swap: remove the current node from the element containing it (if any)
+                     * and add it to the element containing the neighbouring node (if any).
+                     *
+                     * \todo If this causes the element to have no nodes then flag the element and cell to be deleted
+                     */
+                    mpPottsMesh->MoveNodeToElement(node_index, neighbour_containing_element);
+                    num_moves_accepted++;
                 }
             }
         }
     }
+    CellBasedProfiler::Instance()->IncrementCounter("Potts moves accepted", num_moves_accepted);
 }
 
 template<unsigned DIM>
@@ -357,6 +362,7 @@ bool PottsBasedCellPopulation<DIM>::IsCellAssociatedWithADeletedLocation(CellPtr
 template<unsigned DIM>
 void PottsBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
 {
+    this->InvalidateNeighbourAdjacency();
 }
 
 template<unsigned DIM>
@@ -521,6 +527,7 @@ void PottsBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDi
 
     // Create mesh writer for VTK output
     VtkMeshWriter<DIM, DIM> mesh_writer(rDirectory, "results_"+time.str(), false);
+    mesh_writer.SetWriteAsynchronously(this->mUseAsynchronousVtkOutput);
 
     // Iterate over any cell writers that are present
     unsigned num_nodes = GetNumNodes();
@@ -751,6 +758,7 @@ void PottsBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDi
         VertexMesh<2,2> cell_outline_mesh(outline_nodes,outline_elements);
 
         VertexMeshWriter<2, 2> outline_mesh_writer(rDirectory, "outlines", false);
+        outline_mesh_writer.SetWriteAsynchronously(this->mUseAsynchronousVtkOutput);
         outline_mesh_writer.WriteVtkUsingMesh(cell_outline_mesh, time.str());
         outline_mesh_writer.WriteFilesUsingMesh(cell_outline_mesh);
     }
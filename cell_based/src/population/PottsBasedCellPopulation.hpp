@@ -191,6 +191,17 @@ public:
      */
     virtual TetrahedralMesh<DIM, DIM>* GetTetrahedralMeshForPdeModifier();
 
+    /**
+     * Overridden UpdateTetrahedralMeshForPdeModifier() method.
+     *
+     * Moves the nodes of a mesh created by GetTetrahedralMeshForPdeModifier() to
+     * the current cell centres and updates its triangulation incrementally where possible.
+     *
+     * @param pMesh the mesh to update
+     * @return whether the mesh was updated
+     */
+    virtual bool UpdateTetrahedralMeshForPdeModifier(TetrahedralMesh<DIM, DIM>* pMesh);
+
     /**
      * Get a particular PottsElement.
      *
@@ -66,7 +66,7 @@ VertexBasedCellPopulation<DIM>::VertexBasedCellPopulation(MutableVertexMesh<DIM,
     mpVertexBasedDivisionRule.reset(new ShortAxisVertexBasedDivisionRule<DIM>());
 
     // If no location indices are specified, associate with elements from the mesh (assumed to be sequentially ordered).
-    std::list<CellPtr>::iterator it = this->mCells.begin();
+    std::vector<CellPtr>::iterator it = this->mCells.begin();
     for (unsigned i=0; it != this->mCells.end(); ++it, ++i)
     {
         unsigned index = locationIndices.empty() ? i : locationIndices[i]; // assume that the ordering matches
@@ -160,7 +160,7 @@ unsigned VertexBasedCellPopulation<DIM>::GetNumNodes()
 template<unsigned DIM>
 c_vector<double, DIM> VertexBasedCellPopulation<DIM>::GetLocationOfCellCentre(CellPtr pCell)
 {
-    return mpMutableVertexMesh->GetCentroidOfElement(this->mCellLocationMap[pCell.get()]);
+    return mpMutableVertexMesh->GetCentroidOfElement(this->GetLocationIndexUsingCell(pCell));
 }
 
 template<unsigned DIM>
@@ -218,7 +218,6 @@ CellPtr VertexBasedCellPopulation<DIM>::AddCell(CellPtr pNewCell, CellPtr pParen
     // Update location cell map
     CellPtr p_created_cell = this->mCells.back();
     this->SetCellUsingLocationIndex(new_element_index,p_created_cell);
-    this->mCellLocationMap[p_created_cell.get()] = new_element_index;
 
     return p_created_cell;
 }
@@ -228,33 +227,32 @@ unsigned VertexBasedCellPopulation<DIM>::RemoveDeadCells()
 {
     unsigned num_removed = 0;
 
-    for (std::list<CellPtr>::iterator it = this->mCells.begin();
-         it != this->mCells.end();
-         )
+    // Remove the dead cells in a single pass, moving each remaining cell down so that they stay in order
+    unsigned num_cells_kept = 0;
+    for (unsigned cell_index=0; cell_index<this->mCells.size(); cell_index++)
     {
-        if ((*it)->IsDead())
+        CellPtr p_cell = this->mCells[cell_index];
+        if (p_cell->IsDead())
         {
             // Count the cell as dead
             num_removed++;
 
             // Remove the element from the mesh if it is not deleted yet
             ///\todo (#2489) this should cause an error - we should fix this!
-            if (!(this->GetElement(this->GetLocationIndexUsingCell((*it)))->IsDeleted()))
+            if (!(this->GetElement(this->GetLocationIndexUsingCell(p_cell))->IsDeleted()))
             {
                 // This warning relies on the fact that there is only one other possibility for
                 // vertex elements to be marked as deleted: a T2 swap
                 WARN_ONCE_ONLY("A Cell is removed without performing a T2 swap. This could leave a void in the mesh.");
-                mpMutableVertexMesh->DeleteElementPriorToReMesh(this->GetLocationIndexUsingCell((*it)));
+                mpMutableVertexMesh->DeleteElementPriorToReMesh(this->GetLocationIndexUsingCell(p_cell));
             }
-
-            // Delete the cell
-            it = this->mCells.erase(it);
         }
         else
         {
-            ++it;
+            this->mCells[num_cells_kept++] = p_cell;
         }
     }
+    this->mCells.resize(num_cells_kept);
     return num_removed;
 }
 
@@ -286,24 +284,33 @@ bool VertexBasedCellPopulation<DIM>::IsCellAssociatedWithADeletedLocation(CellPt
 template<unsigned DIM>
 void VertexBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
 {
+    // Remeshing may change which cells neighbour each other
+    this->InvalidateNeighbourAdjacency();
+
     VertexElementMap element_map(mpMutableVertexMesh->GetNumAllElements());
     mpMutableVertexMesh->ReMesh(element_map);
 
     if (!element_map.IsIdentityMap())
     {
         // Fix up the mappings between CellPtrs and VertexElements
-        ///\todo We want to make these maps private, so we need a better way of doing the code below.
-        std::map<Cell*, unsigned> old_map = this->mCellLocationMap;
+        std::vector<unsigned> old_elem_indices;
+        old_elem_indices.reserve(this->mCells.size());
+        for (std::vector<CellPtr>::iterator cell_iter = this->mCells.begin();
+             cell_iter != this->mCells.end();
+             ++cell_iter)
+        {
+            old_elem_indices.push_back(this->GetLocationIndexUsingCell(*cell_iter));
+        }
 
-        this->mCellLocationMap.clear();
-        this->mLocationCellMap.clear();
+        this->mCellLocationRegistry.Clear();
 
-        for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
+        std::vector<unsigned>::iterator old_index_iter = old_elem_indices.begin();
+        for (std::vector<CellPtr>::iterator cell_iter = this->mCells.begin();
              cell_iter != this->mCells.end();
-             ++cell_iter)
+             ++cell_iter, ++old_index_iter)
         {
             // The cell vector should only ever contain living cells
-            unsigned old_elem_index = old_map[(*cell_iter).get()];
+            unsigned old_elem_index = *old_index_iter;
             assert(!element_map.IsDeleted(old_elem_index));
 
             unsigned new_elem_index = element_map.GetNewIndex(old_elem_index);
@@ -394,6 +401,7 @@ void VertexBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rD
 
     // Create mesh writer for VTK output
     VertexMeshWriter<DIM, DIM> mesh_writer(rDirectory, "results", false);
+    mesh_writer.SetWriteAsynchronously(this->mUseAsynchronousVtkOutput);
 
     // Iterate over any cell writers that are present
     unsigned num_cells = this->GetNumAllCells();
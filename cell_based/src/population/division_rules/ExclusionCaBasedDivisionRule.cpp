@@ -44,15 +44,13 @@ bool ExclusionCaBasedDivisionRule<SPACE_DIM>::IsRoomToDivide(CellPtr pParentCell
     // Get node index corresponding to this cell
     unsigned node_index = rCellPopulation.GetLocationIndexUsingCell(pParentCell);
 
-    // Get the set of neighbouring node indices
-    std::set<unsigned> neighbouring_node_indices = static_cast<PottsMesh<SPACE_DIM>*>(&(rCellPopulation.rGetMesh()))->GetMooreNeighbouringNodeIndices(node_index);
+    PottsMesh<SPACE_DIM>* static_cast_mesh = static_cast<PottsMesh<SPACE_DIM>*>(&(rCellPopulation.rGetMesh()));
 
     // Iterate through the neighbours to see if there are any available sites
-    for (std::set<unsigned>::iterator neighbour_iter = neighbouring_node_indices.begin();
-         neighbour_iter != neighbouring_node_indices.end();
-         ++neighbour_iter)
+    unsigned num_neighbours = static_cast_mesh->GetNumMooreNeighbours(node_index);
+    for (unsigned local_index=0; local_index<num_neighbours; local_index++)
     {
-        if (rCellPopulation.IsSiteAvailable(*neighbour_iter, pParentCell))
+        if (rCellPopulation.IsSiteAvailable(static_cast_mesh->GetMooreNeighbour(node_index, local_index), pParentCell))
         {
             is_room = true;
             break;
@@ -75,28 +73,25 @@ unsigned ExclusionCaBasedDivisionRule<SPACE_DIM>::CalculateDaughterNodeIndex(Cel
 
     PottsMesh<SPACE_DIM>* static_cast_mesh = static_cast<PottsMesh<SPACE_DIM>*>(&(rCellPopulation.rGetMesh()));
 
-    // Get the set of neighbouring node indices
-    std::set<unsigned> neighbouring_node_indices = static_cast_mesh->GetMooreNeighbouringNodeIndices(parent_node_index);
-    unsigned num_neighbours = neighbouring_node_indices.size();
+    // Get the number of neighbouring node indices
+    unsigned num_neighbours = static_cast_mesh->GetNumMooreNeighbours(parent_node_index);
 
     // Each node must have at least one neighbour
-    assert(!neighbouring_node_indices.empty());
+    assert(num_neighbours > 0);
 
     std::vector<double> neighbouring_node_propensities;
-    std::vector<unsigned> neighbouring_node_indices_vector;
+    neighbouring_node_propensities.reserve(num_neighbours);
 
     double total_propensity = 0.0;
 
     // Select neighbour at random
-    for (std::set<unsigned>::iterator neighbour_iter = neighbouring_node_indices.begin();
-         neighbour_iter != neighbouring_node_indices.end();
-         ++neighbour_iter)
+    for (unsigned local_index=0; local_index<num_neighbours; local_index++)
     {
-        neighbouring_node_indices_vector.push_back(*neighbour_iter);
+        unsigned neighbour_index = static_cast_mesh->GetMooreNeighbour(parent_node_index, local_index);
 
-        double propensity_dividing_into_neighbour = rCellPopulation.EvaluateDivisionPropensity(parent_node_index,*neighbour_iter,pParentCell);
+        double propensity_dividing_into_neighbour = rCellPopulation.EvaluateDivisionPropensity(parent_node_index, neighbour_index, pParentCell);
 
-        if (!(rCellPopulation.IsSiteAvailable(*neighbour_iter, pParentCell)))
+        if (!(rCellPopulation.IsSiteAvailable(neighbour_index, pParentCell)))
         {
             propensity_dividing_into_neighbour = 0.0;
         }
@@ -125,7 +120,7 @@ unsigned ExclusionCaBasedDivisionRule<SPACE_DIM>::CalculateDaughterNodeIndex(Cel
         if (total_probability >= random_number)
         {
             // Divide the parent cell to this neighbour location
-            daughter_node_index = neighbouring_node_indices_vector[counter];
+            daughter_node_index = static_cast_mesh->GetMooreNeighbour(parent_node_index, counter);
             break;
         }
     }
@@ -74,9 +74,8 @@ unsigned ShovingCaBasedDivisionRule<SPACE_DIM>::CalculateDaughterNodeIndex(CellP
 
     PottsMesh<SPACE_DIM>* p_static_cast_mesh = static_cast<PottsMesh<SPACE_DIM>*>(&(rCellPopulation.rGetMesh()));
 
-    // Get the set of neighbouring node indices
-    std::set<unsigned> neighbouring_node_indices = p_static_cast_mesh->GetMooreNeighbouringNodeIndices(parent_node_index);
-    unsigned num_neighbours = neighbouring_node_indices.size();
+    // Get the number of neighbouring node indices
+    unsigned num_neighbours = p_static_cast_mesh->GetNumMooreNeighbours(parent_node_index);
 
     // Check cell is not on the boundary
     IsNodeOnBoundary(num_neighbours);
@@ -87,13 +86,12 @@ unsigned ShovingCaBasedDivisionRule<SPACE_DIM>::CalculateDaughterNodeIndex(CellP
     double total_propensity = 0.0;
 
     // Select neighbour at random
-    for (std::set<unsigned>::iterator neighbour_iter = neighbouring_node_indices.begin();
-         neighbour_iter != neighbouring_node_indices.end();
-         ++neighbour_iter)
+    for (unsigned local_index=0; local_index<num_neighbours; local_index++)
     {
-        neighbouring_node_indices_vector.push_back(*neighbour_iter);
+        unsigned neighbour_index = p_static_cast_mesh->GetMooreNeighbour(parent_node_index, local_index);
+        neighbouring_node_indices_vector.push_back(neighbour_index);
 
-        double propensity_dividing_into_neighbour = rCellPopulation.EvaluateDivisionPropensity(parent_node_index,*neighbour_iter,pParentCell);
+        double propensity_dividing_into_neighbour = rCellPopulation.EvaluateDivisionPropensity(parent_node_index,neighbour_index,pParentCell);
 
         neighbouring_node_propensities.push_back(propensity_dividing_into_neighbour);
         total_propensity += propensity_dividing_into_neighbour;
@@ -131,32 +129,32 @@ unsigned ShovingCaBasedDivisionRule<SPACE_DIM>::CalculateDaughterNodeIndex(CellP
     // If daughter node is occupied then move the cell in the direction of counter
     if (!(rCellPopulation.IsSiteAvailable(daughter_node_index, pNewCell)))
     {
+        /*
+         * Work out the whole chain of moves before carrying any of them out, so
+         * that the population is left untouched if the cells cannot be shoved.
+         */
         std::list<std::pair<unsigned,unsigned> > cell_moves;
+        std::set<unsigned> visited_node_indices;
+        visited_node_indices.insert(parent_node_index);
 
         bool is_neighbour_occupied = true;
-        int max_moves = 1000;
-        int move_number = 0;
         unsigned current_node_index = parent_node_index;
         unsigned target_node_index = daughter_node_index;
-        while (is_neighbour_occupied && move_number < max_moves)
+        while (is_neighbour_occupied)
         {
-            move_number++;
             current_node_index = target_node_index;
 
-            std::set<unsigned> neighbouring_node_indices = p_static_cast_mesh->GetMooreNeighbouringNodeIndices(current_node_index);
+            // The chain of shoved cells must not loop back on itself (this can happen on periodic lattices)
+            if (!visited_node_indices.insert(current_node_index).second)
+            {
+                EXCEPTION("Unable to shove cells out of the way of a dividing cell as there is no free site in that direction.");
+            }
 
             // Check cell is not on the boundary
-            IsNodeOnBoundary(neighbouring_node_indices.size());
+            IsNodeOnBoundary(p_static_cast_mesh->GetNumMooreNeighbours(current_node_index));
 
             // Select the appropriate neighbour
-            std::set<unsigned>::iterator neighbour_iter = neighbouring_node_indices.begin();
-            for (unsigned i=0; i<counter; i++)
-            {
-                ++neighbour_iter;
-            }
-            assert(neighbour_iter != neighbouring_node_indices.end());
-
-            target_node_index = *neighbour_iter;
+            target_node_index = p_static_cast_mesh->GetMooreNeighbour(current_node_index, counter);
 
             std::pair<unsigned, unsigned> new_move(current_node_index, target_node_index);
 
@@ -167,12 +165,7 @@ unsigned ShovingCaBasedDivisionRule<SPACE_DIM>::CalculateDaughterNodeIndex(CellP
             {
                 is_neighbour_occupied = false;
             }
-
-            // If target node is occupied then keep shoving the cells out of the way
-            current_node_index = target_node_index;
-
         }
-        assert(move_number<max_moves);
 
         // Do moves to free up the daughter node index
         for (std::list<std::pair<unsigned, unsigned> >::reverse_iterator reverse_iter = cell_moves.rbegin();
@@ -35,6 +35,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractTwoBodyInteractionForce.hpp"
 #include "IsNan.hpp"
+#include "CellBasedProfiler.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AbstractTwoBodyInteractionForce()
@@ -78,28 +79,33 @@ void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContributio
     {
         MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_static_cast_cell_population = static_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
 
+        p_static_cast_cell_population->UpdateSpringTable();
+        const std::vector<unsigned>& r_node_indices_a = p_static_cast_cell_population->rGetSpringNodeIndicesA();
+        const std::vector<unsigned>& r_node_indices_b = p_static_cast_cell_population->rGetSpringNodeIndicesB();
+        unsigned num_springs = r_node_indices_a.size();
+
         // Iterate over all springs and add force contributions
-        for (typename MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SpringIterator spring_iterator = p_static_cast_cell_population->SpringsBegin();
-             spring_iterator != p_static_cast_cell_population->SpringsEnd();
-             ++spring_iterator)
+        for (unsigned spring_index=0; spring_index<num_springs; spring_index++)
         {
-            unsigned nodeA_global_index = spring_iterator.GetNodeA()->GetIndex();
-            unsigned nodeB_global_index = spring_iterator.GetNodeB()->GetIndex();
+            unsigned nodeA_global_index = r_node_indices_a[spring_index];
+            unsigned nodeB_global_index = r_node_indices_b[spring_index];
 
             // Calculate the force between nodes
             c_vector<double, SPACE_DIM> force = CalculateForceBetweenNodes(nodeA_global_index, nodeB_global_index, rCellPopulation);
 
             // Add the force contribution to each node
             c_vector<double, SPACE_DIM> negative_force = -1.0*force;
-            spring_iterator.GetNodeB()->AddAppliedForceContribution(negative_force);
-            spring_iterator.GetNodeA()->AddAppliedForceContribution(force);
+            rCellPopulation.GetNode(nodeB_global_index)->AddAppliedForceContribution(negative_force);
+            rCellPopulation.GetNode(nodeA_global_index)->AddAppliedForceContribution(force);
         }
+        CellBasedProfiler::Instance()->IncrementCounter("node pairs evaluated", num_springs);
     }
     else    // This is a NodeBasedCellPopulation
     {
         AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_static_cast_cell_population = static_cast<AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
 
         std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >& r_node_pairs = p_static_cast_cell_population->rGetNodePairs();
+        CellBasedProfiler::Instance()->IncrementCounter("node pairs evaluated", r_node_pairs.size());
 
         for (typename std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >::iterator iter = r_node_pairs.begin();
             iter != r_node_pairs.end();
@@ -61,8 +61,6 @@ void BuskeCompressionForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM
     // This force class is defined for NodeBasedCellPopulations only
     assert(dynamic_cast<NodeBasedCellPopulation<DIM>*>(&rCellPopulation) != NULL);
 
-    NodeBasedCellPopulation<DIM>* p_static_cast_cell_population = static_cast<NodeBasedCellPopulation<DIM>*>(&rCellPopulation);
-
     c_vector<double, DIM> unit_vector;
 
     // Loop over cells in the population
@@ -84,12 +82,9 @@ void BuskeCompressionForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM
         double delta_V_c = 0.0;
         c_vector<double, DIM> dVAdd_vector = zero_vector<double>(DIM);
 
-        // Get the set of node indices corresponding to this cell's neighbours
-        std::set<unsigned> neighbouring_node_indices = p_static_cast_cell_population->GetNeighbouringNodeIndices(node_index);
-
-        // Loop over this set
-        for (std::set<unsigned>::iterator iter = neighbouring_node_indices.begin();
-             iter != neighbouring_node_indices.end();
+        // Loop over the node indices corresponding to this cell's neighbours
+        for (typename AbstractCellPopulation<DIM>::NeighbourIterator iter = rCellPopulation.GetNeighbouringLocationsBegin(node_index);
+             iter != rCellPopulation.GetNeighbouringLocationsEnd(node_index);
              ++iter)
         {
             Node<DIM>* p_node_j = rCellPopulation.GetNode(*iter);
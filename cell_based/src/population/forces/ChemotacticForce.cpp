@@ -62,6 +62,9 @@ void ChemotacticForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rC
     CellwiseDataGradient<DIM> gradients;
     gradients.SetupGradients(rCellPopulation, "nutrient");
 
+    // Look up the key of the nutrient concentration once, rather than for every cell
+    static const CellDataKey nutrient_key("nutrient");
+
     for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
          cell_iter != rCellPopulation.End();
          ++cell_iter)
@@ -72,7 +75,7 @@ void ChemotacticForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rC
             unsigned node_global_index = rCellPopulation.GetLocationIndexUsingCell(*cell_iter);
 
             c_vector<double,DIM>& r_gradient = gradients.rGetGradient(node_global_index);
-            double nutrient_concentration = cell_iter->GetCellData()->GetItem("nutrient");
+            double nutrient_concentration = cell_iter->GetCellData()->GetItem(nutrient_key);
             double magnitude_of_gradient = norm_2(r_gradient);
 
             double force_magnitude = GetChemotacticForceMagnitude(nutrient_concentration, magnitude_of_gradient);
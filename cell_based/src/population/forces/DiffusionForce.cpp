@@ -44,7 +44,9 @@ template<unsigned DIM>
 DiffusionForce<DIM>::DiffusionForce()
     : AbstractForce<DIM>(),
       mAbsoluteTemperature(296.0), // default to room temperature
-      mViscosity(3.204e-6) // default to viscosity of water at room temperature in (using 10 microns and hours)
+      mViscosity(3.204e-6), // default to viscosity of water at room temperature in (using 10 microns and hours)
+      mUseCounterBasedRandomNumbers(false),
+      mCounterBasedRandomNumberSeed(0u)
 {
 }
 
@@ -85,11 +87,28 @@ double DiffusionForce<DIM>::GetDiffusionScalingConstant()
     return msBoltzmannConstant*mAbsoluteTemperature/(6.0*mViscosity*M_PI);
 }
 
+template<unsigned DIM>
+void DiffusionForce<DIM>::SetUseCounterBasedRandomNumbers(bool useCounterBasedRandomNumbers, unsigned seed)
+{
+    mUseCounterBasedRandomNumbers = useCounterBasedRandomNumbers;
+    mCounterBasedRandomNumberSeed = seed;
+}
+
+template<unsigned DIM>
+bool DiffusionForce<DIM>::GetUseCounterBasedRandomNumbers()
+{
+    return mUseCounterBasedRandomNumbers;
+}
+
 template<unsigned DIM>
 void DiffusionForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCellPopulation)
 {
     double dt = SimulationTime::Instance()->GetTimeStep();
 
+    unsigned time_step = SimulationTime::Instance()->GetTimeStepsElapsed();
+    CounterBasedRandomNumberGenerator counter_based_generator(mCounterBasedRandomNumberSeed, "DiffusionForce");
+    std::vector<double> counter_based_normals(DIM);
+
     // Iterate over the nodes
     for (typename AbstractMesh<DIM, DIM>::NodeIterator node_iter = rCellPopulation.rGetMesh().GetNodeIteratorBegin();
          node_iter != rCellPopulation.rGetMesh().GetNodeIteratorEnd();
@@ -119,6 +138,11 @@ void DiffusionForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCel
         double diffusion_const_scaling = GetDiffusionScalingConstant();
         double diffusion_constant = diffusion_const_scaling/node_radius;
 
+        if (mUseCounterBasedRandomNumbers)
+        {
+            counter_based_generator.FillStandardNormal(node_index, time_step, counter_based_normals);
+        }
+
         c_vector<double, DIM> force_contribution;
         for (unsigned i=0; i<DIM; i++)
         {
@@ -131,7 +155,7 @@ void DiffusionForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCel
              *
              * where W is a standard normal random variable.
              */
-            double xi = RandomNumberGenerator::Instance()->StandardNormalRandomDeviate();
+            double xi = mUseCounterBasedRandomNumbers ? counter_based_normals[i] : RandomNumberGenerator::Instance()->StandardNormalRandomDeviate();
 
             force_contribution[i] = (nu*sqrt(2.0*diffusion_constant*dt)/dt)*xi;
         }
@@ -42,6 +42,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractForce.hpp"
 #include "AbstractOffLatticeCellPopulation.hpp"
 #include "RandomNumberGenerator.hpp"
+#include "CounterBasedRandomNumberGenerator.hpp"
 
 /**
  * A 'diffusion force' class to model the random movement of nodes.
@@ -71,6 +72,16 @@ private :
      */
     static const double msBoltzmannConstant;
 
+    /**
+     * Whether to draw random numbers from a CounterBasedRandomNumberGenerator keyed
+     * by node index and time step, rather than from the RandomNumberGenerator
+     * singleton. Defaults to false.
+     */
+    bool mUseCounterBasedRandomNumbers;
+
+    /** The seed used if mUseCounterBasedRandomNumbers is true. Defaults to 0. */
+    unsigned mCounterBasedRandomNumberSeed;
+
     /**
      * Archiving.
      */
@@ -88,6 +99,8 @@ private :
         archive & boost::serialization::base_object<AbstractForce<DIM> >(*this);
         archive & mAbsoluteTemperature;
         archive & mViscosity;
+        archive & mUseCounterBasedRandomNumbers;
+        archive & mCounterBasedRandomNumberSeed;
     }
 
 public :
@@ -139,6 +152,23 @@ public :
      */
     double GetDiffusionScalingConstant();
 
+    /**
+     * Set mUseCounterBasedRandomNumbers and mCounterBasedRandomNumberSeed.
+     *
+     * If true, the random force on each node is a function of the seed, the node
+     * index and the number of time steps elapsed only, so does not depend on the
+     * order in which nodes are visited or on how they are distributed across processes.
+     *
+     * @param useCounterBasedRandomNumbers whether to use counter-based random numbers
+     * @param seed the seed for the counter-based random numbers (defaults to 0)
+     */
+    void SetUseCounterBasedRandomNumbers(bool useCounterBasedRandomNumbers, unsigned seed=0u);
+
+    /**
+     * @return mUseCounterBasedRandomNumbers.
+     */
+    bool GetUseCounterBasedRandomNumbers();
+
     /**
      * Overridden AddForceContribution() method.
      * Note that this method requires cell/node radii to be set.
@@ -34,6 +34,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "FarhadifarForce.hpp"
+#include "ThreadPool.hpp"
+#include "ThreadPoolMemberTask.hpp"
 
 template<unsigned DIM>
 FarhadifarForce<DIM>::FarhadifarForce()
@@ -41,7 +43,8 @@ FarhadifarForce<DIM>::FarhadifarForce()
      mAreaElasticityParameter(1.0), // These parameters are Case I in Farhadifar's paper
      mPerimeterContractilityParameter(0.04),
      mLineTensionParameter(0.12),
-     mBoundaryLineTensionParameter(0.12) // this parameter as such does not exist in Farhadifar's model.
+     mBoundaryLineTensionParameter(0.12), // this parameter as such does not exist in Farhadifar's model.
+     mpVertexCellPopulation(NULL)
 {
 }
 
@@ -65,24 +68,27 @@ void FarhadifarForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCe
     unsigned num_nodes = p_cell_population->GetNumNodes();
     unsigned num_elements = p_cell_population->GetNumElements();
 
-    // Begin by computing the area and perimeter of each element in the mesh, to avoid having to do this multiple times
-    std::vector<double> element_areas(num_elements);
-    std::vector<double> element_perimeters(num_elements);
-    std::vector<double> target_areas(num_elements);
-    for (typename VertexMesh<DIM,DIM>::VertexElementIterator elem_iter = p_cell_population->rGetMesh().GetElementIteratorBegin();
-         elem_iter != p_cell_population->rGetMesh().GetElementIteratorEnd();
+    /*
+     * Begin by computing the area and perimeter of each element in the mesh, and the edge and area
+     * gradients at each of its vertices, in a single pass to avoid having to do this multiple times
+     */
+    MutableVertexMesh<DIM,DIM>& r_mesh = p_cell_population->rGetMesh();
+    r_mesh.UpdateElementGeometryCache();
+
+    mTargetAreas.resize(num_elements);
+    static const CellDataKey target_area_key("target area");
+    for (typename VertexMesh<DIM,DIM>::VertexElementIterator elem_iter = r_mesh.GetElementIteratorBegin();
+         elem_iter != r_mesh.GetElementIteratorEnd();
          ++elem_iter)
     {
         unsigned elem_index = elem_iter->GetIndex();
-        element_areas[elem_index] = p_cell_population->rGetMesh().GetVolumeOfElement(elem_index);
-        element_perimeters[elem_index] = p_cell_population->rGetMesh().GetSurfaceAreaOfElement(elem_index);
         try
         {
             // If we haven't specified a growth modifier, there won't be any target areas in the CellData array and CellData
             // will throw an exception that it doesn't have "target area" entries.  We add this piece of code to give a more
             // understandable message. There is a slight chance that the exception is thrown although the error is not about the
             // target areas.
-            target_areas[elem_index] = p_cell_population->GetCellUsingLocationIndex(elem_index)->GetCellData()->GetItem("target area");
+            mTargetAreas[elem_index] = p_cell_population->GetCellUsingLocationIndex(elem_index)->GetCellData()->GetItem(target_area_key);
         }
         catch (Exception&)
         {
@@ -90,8 +96,46 @@ void FarhadifarForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCe
         }
     }
 
-    // Iterate over vertices in the cell population
-    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    /*
+     * Next compute the line tension parameter of each edge of each element. The edge from local node i to
+     * local node i+1 is passed to GetLineTensionParameter() in this order whichever of its nodes we are
+     * considering, so we need only compute each value once. The loop over vertices below then only
+     * reads from these vectors and the mesh, and does not allocate any memory.
+     */
+    mEdgeLineTensionParameters.resize(r_mesh.GetNumCachedVertices());
+    for (typename VertexMesh<DIM,DIM>::VertexElementIterator elem_iter = r_mesh.GetElementIteratorBegin();
+         elem_iter != r_mesh.GetElementIteratorEnd();
+         ++elem_iter)
+    {
+        unsigned offset = r_mesh.GetCachedVertexOffsetOfElement(elem_iter->GetIndex());
+        unsigned num_nodes_elem = elem_iter->GetNumNodes();
+        for (unsigned local_index=0; local_index<num_nodes_elem; local_index++)
+        {
+            Node<DIM>* p_this_node = elem_iter->GetNode(local_index);
+            Node<DIM>* p_next_node = elem_iter->GetNode((local_index+1)%num_nodes_elem);
+            mEdgeLineTensionParameters[offset+local_index] = GetLineTensionParameter(p_this_node, p_next_node, *p_cell_population);
+        }
+    }
+
+    /*
+     * Each node only receives its own force, so the loop over vertices may be shared between the
+     * threads of the ThreadPool. Each thread is given a contiguous range of nodes, so the result
+     * does not depend on the number of threads.
+     */
+    mpVertexCellPopulation = p_cell_population;
+    ThreadPoolMemberTask<FarhadifarForce<DIM> > task(this, &FarhadifarForce<DIM>::AddForceContributionToNodes);
+    ThreadPool::Instance()->ParallelFor(num_nodes, task);
+    mpVertexCellPopulation = NULL;
+}
+
+template<unsigned DIM>
+void FarhadifarForce<DIM>::AddForceContributionToNodes(unsigned firstNodeIndex, unsigned endNodeIndex)
+{
+    VertexBasedCellPopulation<DIM>* p_cell_population = mpVertexCellPopulation;
+    MutableVertexMesh<DIM,DIM>& r_mesh = p_cell_population->rGetMesh();
+
+    // Iterate over vertices in the given range
+    for (unsigned node_index=firstNodeIndex; node_index<endNodeIndex; node_index++)
     {
         Node<DIM>* p_this_node = p_cell_population->GetNode(node_index);
 
@@ -112,11 +156,11 @@ void FarhadifarForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCe
         c_vector<double, DIM> line_tension_contribution = zero_vector<double>(DIM);
 
         // Find the indices of the elements owned by this node
-        std::set<unsigned> containing_elem_indices = p_cell_population->GetNode(node_index)->rGetContainingElementIndices();
+        const std::set<unsigned>& r_containing_elem_indices = p_this_node->rGetContainingElementIndices();
 
         // Iterate over these elements
-        for (std::set<unsigned>::iterator iter = containing_elem_indices.begin();
-             iter != containing_elem_indices.end();
+        for (std::set<unsigned>::const_iterator iter = r_containing_elem_indices.begin();
+             iter != r_containing_elem_indices.end();
              ++iter)
         {
             // Get this element, its index and its number of nodes
@@ -128,35 +172,30 @@ void FarhadifarForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCe
             unsigned local_index = p_element->GetNodeLocalIndex(node_index);
 
             // Add the force contribution from this cell's area elasticity (note the minus sign)
-            c_vector<double, DIM> element_area_gradient =
-                    p_cell_population->rGetMesh().GetAreaGradientOfElementAtNode(p_element, local_index);
-            area_elasticity_contribution -= GetAreaElasticityParameter()*(element_areas[elem_index] -
-                    target_areas[elem_index])*element_area_gradient;
+            const c_vector<double, DIM>& r_element_area_gradient = r_mesh.rGetCachedAreaGradientOfElementAtNode(elem_index, local_index);
+            area_elasticity_contribution -= GetAreaElasticityParameter()*(r_mesh.GetCachedVolumeOfElement(elem_index) -
+                    mTargetAreas[elem_index])*r_element_area_gradient;
 
-            // Get the previous and next nodes in this element
+            // Get the previous node in this element
             unsigned previous_node_local_index = (num_nodes_elem+local_index-1)%num_nodes_elem;
-            Node<DIM>* p_previous_node = p_element->GetNode(previous_node_local_index);
-
-            unsigned next_node_local_index = (local_index+1)%num_nodes_elem;
-            Node<DIM>* p_next_node = p_element->GetNode(next_node_local_index);
 
-            // Compute the line tension parameter for each of these edges - be aware that this is half of the actual
-            // value for internal edges since we are looping over each of the internal edges twice
-            double previous_edge_line_tension_parameter = GetLineTensionParameter(p_previous_node, p_this_node, *p_cell_population);
-            double next_edge_line_tension_parameter = GetLineTensionParameter(p_this_node, p_next_node, *p_cell_population);
+            // Get the line tension parameter for the edges ending and starting at this node - be aware that this is half
+            // of the actual value for internal edges since we are looping over each of the internal edges twice
+            unsigned offset = r_mesh.GetCachedVertexOffsetOfElement(elem_index);
+            double previous_edge_line_tension_parameter = mEdgeLineTensionParameters[offset+previous_node_local_index];
+            double next_edge_line_tension_parameter = mEdgeLineTensionParameters[offset+local_index];
 
             // Compute the gradient of each these edges, computed at the present node
-            c_vector<double, DIM> previous_edge_gradient =
-                    -p_cell_population->rGetMesh().GetNextEdgeGradientOfElementAtNode(p_element, previous_node_local_index);
-            c_vector<double, DIM> next_edge_gradient = p_cell_population->rGetMesh().GetNextEdgeGradientOfElementAtNode(p_element, local_index);
+            c_vector<double, DIM> previous_edge_gradient = -r_mesh.rGetCachedNextEdgeGradientOfElementAtNode(elem_index, previous_node_local_index);
+            const c_vector<double, DIM>& r_next_edge_gradient = r_mesh.rGetCachedNextEdgeGradientOfElementAtNode(elem_index, local_index);
 
             // Add the force contribution from cell-cell and cell-boundary line tension (note the minus sign)
             line_tension_contribution -= previous_edge_line_tension_parameter*previous_edge_gradient +
-                    next_edge_line_tension_parameter*next_edge_gradient;
+                    next_edge_line_tension_parameter*r_next_edge_gradient;
 
             // Add the force contribution from this cell's perimeter contractility (note the minus sign)
-            c_vector<double, DIM> element_perimeter_gradient = previous_edge_gradient + next_edge_gradient;
-            perimeter_contractility_contribution -= GetPerimeterContractilityParameter()* element_perimeters[elem_index]*
+            c_vector<double, DIM> element_perimeter_gradient = previous_edge_gradient + r_next_edge_gradient;
+            perimeter_contractility_contribution -= GetPerimeterContractilityParameter()* r_mesh.GetCachedSurfaceAreaOfElement(elem_index)*
                                                                                                      element_perimeter_gradient;
         }
 
@@ -169,26 +208,27 @@ template<unsigned DIM>
 double FarhadifarForce<DIM>::GetLineTensionParameter(Node<DIM>* pNodeA, Node<DIM>* pNodeB, VertexBasedCellPopulation<DIM>& rVertexCellPopulation)
 {
     // Find the indices of the elements owned by each node
-    std::set<unsigned> elements_containing_nodeA = pNodeA->rGetContainingElementIndices();
-    std::set<unsigned> elements_containing_nodeB = pNodeB->rGetContainingElementIndices();
-
-    // Find common elements
-    std::set<unsigned> shared_elements;
-    std::set_intersection(elements_containing_nodeA.begin(),
-                          elements_containing_nodeA.end(),
-                          elements_containing_nodeB.begin(),
-                          elements_containing_nodeB.end(),
-                          std::inserter(shared_elements, shared_elements.begin()));
+    const std::set<unsigned>& r_elements_containing_nodeA = pNodeA->rGetContainingElementIndices();
+    const std::set<unsigned>& r_elements_containing_nodeB = pNodeB->rGetContainingElementIndices();
+
+    // Count common elements, without constructing their intersection
+    unsigned num_shared_elements = 0;
+    for (std::set<unsigned>::const_iterator iter = r_elements_containing_nodeA.begin();
+         iter != r_elements_containing_nodeA.end();
+         ++iter)
+    {
+        num_shared_elements += r_elements_containing_nodeB.count(*iter);
+    }
 
     // Check that the nodes have a common edge
-    assert(!shared_elements.empty());
+    assert(num_shared_elements > 0);
 
     // Since each internal edge is visited twice in the loop above, we have to use half the line tension parameter
     // for each visit.
     double line_tension_parameter_in_calculation = GetLineTensionParameter()/2.0;
 
     // If the edge corresponds to a single element, then the cell is on the boundary
-    if (shared_elements.size() == 1)
+    if (num_shared_elements == 1)
     {
         line_tension_parameter_in_calculation = GetBoundaryLineTensionParameter();
     }
@@ -44,10 +44,14 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VertexBasedCellPopulation.hpp"
 
 #include <iostream>
+#include <vector>
 
 /**
  * A force class for use in Vertex-based simulations. This force is based on the
  * Energy function proposed by Farhadifar et al in  Curr. Biol., 2007, 17, 2095-2104.
+ *
+ * The loop over nodes is shared between the threads of the ThreadPool singleton, if it has
+ * more than one.
  */
 
 
@@ -98,6 +102,27 @@ protected:
      */
     double mBoundaryLineTensionParameter;
 
+    /** The target area of each element, stored during AddForceContribution(). */
+    std::vector<double> mTargetAreas;
+
+    /**
+     * The line tension parameter of each element edge, stored during AddForceContribution()
+     * and indexed in the same way as the element geometry cache of the mesh.
+     */
+    std::vector<double> mEdgeLineTensionParameters;
+
+    /** The cell population passed to AddForceContribution(), while it is being called. */
+    VertexBasedCellPopulation<DIM>* mpVertexCellPopulation;
+
+    /**
+     * Add the force on a contiguous range of nodes, using the target areas and edge line
+     * tension parameters stored by AddForceContribution(). This method only writes to the
+     * given nodes, so may be called on different ranges concurrently.
+     *
+     * @param firstNodeIndex the index of the first node in the range
+     * @param endNodeIndex one past the index of the last node in the range
+     */
+    void AddForceContributionToNodes(unsigned firstNodeIndex, unsigned endNodeIndex);
 
 public:
 
@@ -35,6 +35,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "GeneralisedLinearSpringForce.hpp"
 #include "IsNan.hpp"
+#include "CellBasedProfiler.hpp"
+
+#include <typeinfo>
 
 #include "Debug.hpp"
 
@@ -230,6 +233,164 @@ c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>:
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>::AddForceContribution(AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
+{
+    MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_mesh_cell_population = dynamic_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
+
+    if ((p_mesh_cell_population != NULL) && (typeid(*this) == typeid(GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>)))
+    {
+        AddSpringTableForceContribution(*p_mesh_cell_population);
+    }
+    else
+    {
+        AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContribution(rCellPopulation);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>::AddSpringTableForceContribution(MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
+{
+    rCellPopulation.UpdateSpringTable();
+    const std::vector<unsigned>& r_node_indices_a = rCellPopulation.rGetSpringNodeIndicesA();
+    const std::vector<unsigned>& r_node_indices_b = rCellPopulation.rGetSpringNodeIndicesB();
+    const std::vector<CellPtr>& r_cells_a = rCellPopulation.rGetSpringCellsA();
+    const std::vector<CellPtr>& r_cells_b = rCellPopulation.rGetSpringCellsB();
+    const std::vector<double>& r_rest_lengths = rCellPopulation.rGetSpringRestLengths();
+
+    unsigned num_springs = r_node_indices_a.size();
+    CellBasedProfiler::Instance()->IncrementCounter("node pairs evaluated", num_springs);
+    if (num_springs == 0)
+    {
+        return;
+    }
+
+    mSpringComponents.resize(SPACE_DIM*num_springs);
+    mSpringLengths.resize(num_springs);
+    mSpringCurrentRestLengths.resize(num_springs);
+
+    // Gather the displacement of each spring, with component i of spring s stored at i*num_springs + s
+    AbstractMesh<ELEMENT_DIM,SPACE_DIM>& r_mesh = rCellPopulation.rGetMesh();
+    for (unsigned spring_index=0; spring_index<num_springs; spring_index++)
+    {
+        // Use GetVectorFromAtoB(), which may be overridden (e.g. in Cylindrical2dMesh)
+        c_vector<double, SPACE_DIM> displacement = r_mesh.GetVectorFromAtoB(r_mesh.GetNode(r_node_indices_a[spring_index])->rGetLocation(),
+                                                                            r_mesh.GetNode(r_node_indices_b[spring_index])->rGetLocation());
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            mSpringComponents[i*num_springs + spring_index] = displacement[i];
+        }
+    }
+
+    /*
+     * Gather the current rest length of each spring, which only differs from the stored rest
+     * length if both cells are newly divided or either cell has begun apoptosis (see
+     * CalculateForceBetweenNodes()).
+     */
+    double dt = SimulationTime::Instance()->GetTimeStep();
+    for (unsigned spring_index=0; spring_index<num_springs; spring_index++)
+    {
+        const CellPtr& p_cell_A = r_cells_a[spring_index];
+        const CellPtr& p_cell_B = r_cells_b[spring_index];
+        double rest_length_final = r_rest_lengths[spring_index];
+        double rest_length = rest_length_final;
+
+        double ageA = p_cell_A->GetAge();
+        double ageB = p_cell_B->GetAge();
+        assert(!std::isnan(ageA));
+        assert(!std::isnan(ageB));
+
+        if (ageA < mMeinekeSpringGrowthDuration && ageB < mMeinekeSpringGrowthDuration)
+        {
+            std::pair<CellPtr,CellPtr> cell_pair = rCellPopulation.CreateCellPair(p_cell_A, p_cell_B);
+
+            if (rCellPopulation.IsMarkedSpring(cell_pair))
+            {
+                // Spring rest length increases from a small value to the normal rest length over 1 hour
+                double lambda = mMeinekeDivisionRestingSpringLength;
+                rest_length = lambda + (rest_length_final - lambda) * ageA/mMeinekeSpringGrowthDuration;
+            }
+            if (ageA + dt >= mMeinekeSpringGrowthDuration)
+            {
+                // This spring is about to go out of scope
+                rCellPopulation.UnmarkSpring(cell_pair);
+            }
+        }
+
+        bool a_has_apoptosis_begun = p_cell_A->HasApoptosisBegun();
+        bool b_has_apoptosis_begun = p_cell_B->HasApoptosisBegun();
+        if (a_has_apoptosis_begun || b_has_apoptosis_begun)
+        {
+            double a_rest_length = rest_length*0.5;
+            double b_rest_length = a_rest_length;
+            if (a_has_apoptosis_begun)
+            {
+                a_rest_length = a_rest_length * p_cell_A->GetTimeUntilDeath() / p_cell_A->GetApoptosisTime();
+            }
+            if (b_has_apoptosis_begun)
+            {
+                b_rest_length = b_rest_length * p_cell_B->GetTimeUntilDeath() / p_cell_B->GetApoptosisTime();
+            }
+            rest_length = a_rest_length + b_rest_length;
+        }
+        mSpringCurrentRestLengths[spring_index] = rest_length;
+    }
+
+    // Compute the length of each spring
+    double* p_components = &mSpringComponents[0];
+    double* p_lengths = &mSpringLengths[0];
+    const double* p_rest_lengths = &mSpringCurrentRestLengths[0];
+    for (unsigned spring_index=0; spring_index<num_springs; spring_index++)
+    {
+        p_lengths[spring_index] = 0.0;
+    }
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        const double* p_component = p_components + i*num_springs;
+        for (unsigned spring_index=0; spring_index<num_springs; spring_index++)
+        {
+            p_lengths[spring_index] += p_component[spring_index]*p_component[spring_index];
+        }
+    }
+    for (unsigned spring_index=0; spring_index<num_springs; spring_index++)
+    {
+        p_lengths[spring_index] = sqrt(p_lengths[spring_index]);
+        assert(p_lengths[spring_index] > 0);
+        assert(!std::isnan(p_lengths[spring_index]));
+    }
+
+    /*
+     * Overwrite each displacement with the force on node A, in the same order of operations
+     * as CalculateForceBetweenNodes() so that the results are identical. There is zero force
+     * between nodes at least the cutoff length apart.
+     */
+    double cut_off_length = this->mUseCutOffLength ? this->GetCutOffLength() : DBL_MAX;
+    double spring_stiffness = mMeinekeSpringStiffness;
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        double* p_component = p_components + i*num_springs;
+        for (unsigned spring_index=0; spring_index<num_springs; spring_index++)
+        {
+            double length = p_lengths[spring_index];
+            double force = spring_stiffness * (p_component[spring_index]/length) * (length - p_rest_lengths[spring_index]);
+            p_component[spring_index] = (length < cut_off_length) ? force : 0.0;
+        }
+    }
+
+    // Add the force contribution to each node
+    for (unsigned spring_index=0; spring_index<num_springs; spring_index++)
+    {
+        c_vector<double, SPACE_DIM> force;
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            force[i] = p_components[i*num_springs + spring_index];
+        }
+        c_vector<double, SPACE_DIM> negative_force = -1.0*force;
+        r_mesh.GetNode(r_node_indices_b[spring_index])->AddAppliedForceContribution(negative_force);
+        r_mesh.GetNode(r_node_indices_a[spring_index])->AddAppliedForceContribution(force);
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>::GetMeinekeSpringStiffness()
 {
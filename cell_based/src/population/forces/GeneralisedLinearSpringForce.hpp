@@ -113,6 +113,31 @@ protected:
      */
     double mMeinekeSpringGrowthDuration;
 
+    /**
+     * Workspace used by AddSpringTableForceContribution(), holding each component of the
+     * displacement (and then the force) of each spring in turn. Not archived.
+     */
+    std::vector<double> mSpringComponents;
+
+    /** Workspace used by AddSpringTableForceContribution(), holding the length of each spring. Not archived. */
+    std::vector<double> mSpringLengths;
+
+    /** Workspace used by AddSpringTableForceContribution(), holding the current rest length of each spring. Not archived. */
+    std::vector<double> mSpringCurrentRestLengths;
+
+    /**
+     * Add the force contribution of each spring in a MeshBasedCellPopulation, equivalent to
+     * calling CalculateForceBetweenNodes() for each spring in the population's spring table.
+     *
+     * Node displacements and rest lengths are gathered into contiguous arrays, so that the
+     * forces can be computed in loops without branches or virtual calls that the compiler
+     * can vectorise, and are then added to the nodes in the same order as in
+     * AbstractTwoBodyInteractionForce::AddForceContribution().
+     *
+     * @param rCellPopulation the cell population
+     */
+    void AddSpringTableForceContribution(MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
 public:
 
     /**
@@ -158,6 +183,18 @@ public:
     c_vector<double, SPACE_DIM> CalculateForceBetweenNodes(unsigned nodeAGlobalIndex,
                                                      unsigned nodeBGlobalIndex,
                                                      AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
+    /**
+     * Overridden AddForceContribution() method.
+     *
+     * For a MeshBasedCellPopulation, this uses AddSpringTableForceContribution() unless
+     * this object is an instance of a subclass, which may override CalculateForceBetweenNodes()
+     * or VariableSpringConstantMultiplicationFactor(). Otherwise the method on
+     * AbstractTwoBodyInteractionForce is used.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void AddForceContribution(AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
     /**
      * @return mMeinekeSpringStiffness
      */
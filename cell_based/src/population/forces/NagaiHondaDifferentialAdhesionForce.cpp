@@ -56,29 +56,40 @@ double NagaiHondaDifferentialAdhesionForce<DIM>::GetAdhesionParameter(Node<DIM>*
                                                                       VertexBasedCellPopulation<DIM>& rVertexCellPopulation)
 {
     // Find the indices of the elements owned by each node
-    std::set<unsigned> elements_containing_nodeA = pNodeA->rGetContainingElementIndices();
-    std::set<unsigned> elements_containing_nodeB = pNodeB->rGetContainingElementIndices();
+    const std::set<unsigned>& r_elements_containing_nodeA = pNodeA->rGetContainingElementIndices();
+    const std::set<unsigned>& r_elements_containing_nodeB = pNodeB->rGetContainingElementIndices();
+
+    /*
+     * Count the common elements, and how many of these correspond to labelled cells, without
+     * constructing their intersection
+     */
+    unsigned num_shared_elements = 0;
+    unsigned num_labelled_cells = 0;
+    for (std::set<unsigned>::const_iterator iter = r_elements_containing_nodeA.begin();
+         iter != r_elements_containing_nodeA.end();
+         ++iter)
+    {
+        if (r_elements_containing_nodeB.find(*iter) != r_elements_containing_nodeB.end())
+        {
+            num_shared_elements++;
 
-    // Find common elements
-    std::set<unsigned> shared_elements;
-    std::set_intersection(elements_containing_nodeA.begin(),
-                          elements_containing_nodeA.end(),
-                          elements_containing_nodeB.begin(),
-                          elements_containing_nodeB.end(),
-                          std::inserter(shared_elements, shared_elements.begin()));
+            // Get cell associated with this element
+            CellPtr p_cell = rVertexCellPopulation.GetCellUsingLocationIndex(*iter);
+
+            if (p_cell->template HasCellProperty<CellLabel>())
+            {
+                num_labelled_cells++;
+            }
+        }
+    }
 
     // Check that the nodes have a common edge
-    assert(!shared_elements.empty());
+    assert(num_shared_elements > 0);
 
     // If the edge corresponds to a single element, then the cell is on the boundary
-    if (shared_elements.size() == 1)
+    if (num_shared_elements == 1)
     {
-        unsigned element_index = *(shared_elements.begin());
-
-        // Get cell associated with this element
-        CellPtr p_cell = rVertexCellPopulation.GetCellUsingLocationIndex(element_index);
-
-        if (p_cell->template HasCellProperty<CellLabel>())
+        if (num_labelled_cells == 1)
         {
             // This cell is labelled
             return this->GetNagaiHondaLabelledCellBoundaryAdhesionEnergyParameter();
@@ -91,23 +102,6 @@ double NagaiHondaDifferentialAdhesionForce<DIM>::GetAdhesionParameter(Node<DIM>*
     }
     else
     {
-        // Work out the number of labelled cells: 0,1 or 2
-        unsigned num_labelled_cells = 0;
-        for (std::set<unsigned>::iterator iter = shared_elements.begin();
-             iter != shared_elements.end();
-             ++iter)
-        {
-            unsigned element_index = *(iter);
-
-            // Get cell associated with this element
-            CellPtr p_cell = rVertexCellPopulation.GetCellUsingLocationIndex(element_index);
-
-            if (p_cell->template HasCellProperty<CellLabel>())
-            {
-                num_labelled_cells++;
-            }
-        }
-
         if (num_labelled_cells == 2)
         {
             // Both cells are labelled
@@ -44,6 +44,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VertexBasedCellPopulation.hpp"
 
 #include <iostream>
+#include <vector>
 
 /**
  * A force class for use in vertex-based simulations, based on a mechanical
@@ -56,6 +57,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * Each of the model parameter member variables are rescaled such that mDampingConstantNormal
  * takes the default value 1, whereas Nagai and Honda (who denote the parameter by
  * nu) take the value 0.01.
+ *
+ * The loop over nodes is shared between the threads of the ThreadPool singleton, if it has
+ * more than one.
  */
 template<unsigned DIM>
 class NagaiHondaForce  : public AbstractForce<DIM>
@@ -107,6 +111,27 @@ protected:
      */
     double mNagaiHondaCellBoundaryAdhesionEnergyParameter;
 
+    /** The target area of each element, stored during AddForceContribution(). */
+    std::vector<double> mTargetAreas;
+
+    /**
+     * The adhesion parameter of each element edge, stored during AddForceContribution()
+     * and indexed in the same way as the element geometry cache of the mesh.
+     */
+    std::vector<double> mEdgeAdhesionParameters;
+
+    /** The cell population passed to AddForceContribution(), while it is being called. */
+    VertexBasedCellPopulation<DIM>* mpVertexCellPopulation;
+
+    /**
+     * Add the force on a contiguous range of nodes, using the target areas and edge adhesion
+     * parameters stored by AddForceContribution(). This method only writes to the given nodes,
+     * so may be called on different ranges concurrently.
+     *
+     * @param firstNodeIndex the index of the first node in the range
+     * @param endNodeIndex one past the index of the last node in the range
+     */
+    void AddForceContributionToNodes(unsigned firstNodeIndex, unsigned endNodeIndex);
 
 public:
 
@@ -50,8 +50,6 @@ IsolatedLabelledCellKiller<DIM>::IsolatedLabelledCellKiller(AbstractCellPopulati
 template<unsigned DIM>
 void IsolatedLabelledCellKiller<DIM>::CheckAndLabelCellsForApoptosisOrDeath()
 {
-    MutableVertexMesh<DIM, DIM>& vertex_mesh = static_cast<VertexBasedCellPopulation<DIM>*>(this->mpCellPopulation)->rGetMesh();
-
     unsigned num_labelled_cells = this->mpCellPopulation->GetCellPropertyRegistry()->template Get<CellLabel>()->GetCellCount();
 
     // If there is more than one labelled cell...
@@ -68,13 +66,10 @@ void IsolatedLabelledCellKiller<DIM>::CheckAndLabelCellsForApoptosisOrDeath()
                 // Get the element index corresponding to this cell
                 unsigned elem_index = this->mpCellPopulation->GetLocationIndexUsingCell(*cell_iter);
 
-                // Get the set of neighbouring element indices
-                std::set<unsigned> neighbouring_elem_indices = vertex_mesh.GetNeighbouringElementIndices(elem_index);
-
-                // Check if any of the corresponding cells have the CellLabel property...
+                // Check if any of the cells in neighbouring elements have the CellLabel property...
                 unsigned num_labelled_neighbours = 0;
-                for (std::set<unsigned>::iterator elem_iter = neighbouring_elem_indices.begin();
-                     elem_iter != neighbouring_elem_indices.end();
+                for (typename AbstractCellPopulation<DIM>::NeighbourIterator elem_iter = this->mpCellPopulation->GetNeighbouringLocationsBegin(elem_index);
+                     elem_iter != this->mpCellPopulation->GetNeighbouringLocationsEnd(elem_index);
                      ++elem_iter)
                 {
                     if (this->mpCellPopulation->GetCellUsingLocationIndex(*elem_iter)->template HasCellProperty<CellLabel>())
@@ -38,7 +38,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 template<unsigned DIM>
 RandomCellKiller<DIM>::RandomCellKiller(AbstractCellPopulation<DIM>* pCellPopulation, double probabilityOfDeathInAnHour)
         : AbstractCellKiller<DIM>(pCellPopulation),
-          mProbabilityOfDeathInAnHour(probabilityOfDeathInAnHour)
+          mProbabilityOfDeathInAnHour(probabilityOfDeathInAnHour),
+          mUseCounterBasedRandomNumbers(false),
+          mCounterBasedRandomNumberSeed(0u)
 {
     if ((mProbabilityOfDeathInAnHour<0) || (mProbabilityOfDeathInAnHour>1))
     {
@@ -52,6 +54,19 @@ double RandomCellKiller<DIM>::GetDeathProbabilityInAnHour() const
     return mProbabilityOfDeathInAnHour;
 }
 
+template<unsigned DIM>
+void RandomCellKiller<DIM>::SetUseCounterBasedRandomNumbers(bool useCounterBasedRandomNumbers, unsigned seed)
+{
+    mUseCounterBasedRandomNumbers = useCounterBasedRandomNumbers;
+    mCounterBasedRandomNumberSeed = seed;
+}
+
+template<unsigned DIM>
+bool RandomCellKiller<DIM>::GetUseCounterBasedRandomNumbers() const
+{
+    return mUseCounterBasedRandomNumbers;
+}
+
 template<unsigned DIM>
 void RandomCellKiller<DIM>::CheckAndLabelSingleCellForApoptosis(CellPtr pCell)
 {
@@ -70,10 +85,24 @@ void RandomCellKiller<DIM>::CheckAndLabelSingleCellForApoptosis(CellPtr pCell)
      */
     double death_prob_this_timestep = 1.0 - pow((1.0 - mProbabilityOfDeathInAnHour), SimulationTime::Instance()->GetTimeStep());
 
-    if (!pCell->HasApoptosisBegun() &&
-        RandomNumberGenerator::Instance()->ranf() < death_prob_this_timestep)
+    if (!pCell->HasApoptosisBegun())
     {
-        pCell->StartApoptosis();
+        double random_number;
+        if (mUseCounterBasedRandomNumbers)
+        {
+            unsigned time_step = SimulationTime::Instance()->GetTimeStepsElapsed();
+            CounterBasedRandomNumberGenerator generator(mCounterBasedRandomNumberSeed, "RandomCellKiller");
+            random_number = generator.ranf(pCell->GetCellId(), time_step);
+        }
+        else
+        {
+            random_number = RandomNumberGenerator::Instance()->ranf();
+        }
+
+        if (random_number < death_prob_this_timestep)
+        {
+            pCell->StartApoptosis();
+        }
     }
 }
 
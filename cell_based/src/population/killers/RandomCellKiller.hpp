@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractCellKiller.hpp"
 #include "RandomNumberGenerator.hpp"
+#include "CounterBasedRandomNumberGenerator.hpp"
 
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
@@ -70,6 +71,16 @@ private:
       */
      double mProbabilityOfDeathInAnHour;
 
+    /**
+     * Whether to draw random numbers from a CounterBasedRandomNumberGenerator keyed
+     * by cell ID and time step, rather than from the RandomNumberGenerator
+     * singleton. Defaults to false.
+     */
+    bool mUseCounterBasedRandomNumbers;
+
+    /** The seed used if mUseCounterBasedRandomNumbers is true. Defaults to 0. */
+    unsigned mCounterBasedRandomNumberSeed;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -82,6 +93,8 @@ private:
     void serialize(Archive & archive, const unsigned int version)
     {
         archive & boost::serialization::base_object<AbstractCellKiller<DIM> >(*this);
+        archive & mUseCounterBasedRandomNumbers;
+        archive & mCounterBasedRandomNumberSeed;
 
         // Make sure the random number generator is also archived
         SerializableSingleton<RandomNumberGenerator>* p_rng_wrapper = RandomNumberGenerator::Instance()->GetSerializationWrapper();
@@ -103,6 +116,23 @@ public:
      */
     double GetDeathProbabilityInAnHour() const;
 
+    /**
+     * Set mUseCounterBasedRandomNumbers and mCounterBasedRandomNumberSeed.
+     *
+     * If true, whether a cell is labelled for apoptosis at a given time step is a
+     * function of the seed, the cell ID and the number of time steps elapsed only,
+     * so does not depend on the order in which cells are visited.
+     *
+     * @param useCounterBasedRandomNumbers whether to use counter-based random numbers
+     * @param seed the seed for the counter-based random numbers (defaults to 0)
+     */
+    void SetUseCounterBasedRandomNumbers(bool useCounterBasedRandomNumbers, unsigned seed=0u);
+
+    /**
+     * @return mUseCounterBasedRandomNumbers.
+     */
+    bool GetUseCounterBasedRandomNumbers() const;
+
     /**
      * Overridden method to test a given cell for apoptosis.
      *
@@ -53,14 +53,12 @@ double AdhesionPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(unsigned cu
                                                                 unsigned targetNodeIndex,
                                                                 PottsBasedCellPopulation<DIM>& rCellPopulation)
 {
-    std::set<unsigned> containing_elements = rCellPopulation.GetNode(currentNodeIndex)->rGetContainingElementIndices();
-    std::set<unsigned> new_location_containing_elements = rCellPopulation.GetNode(targetNodeIndex)->rGetContainingElementIndices();
+    PottsMesh<DIM>& r_mesh = rCellPopulation.rGetMesh();
+    unsigned current_element = r_mesh.GetContainingElementIndexOfNode(currentNodeIndex);
+    unsigned target_element = r_mesh.GetContainingElementIndexOfNode(targetNodeIndex);
 
-    bool current_node_contained = !containing_elements.empty();
-    bool target_node_contained = !new_location_containing_elements.empty();
-
-    // Every node must each be in at most one element
-    assert(new_location_containing_elements.size() < 2);
+    bool current_node_contained = (current_element != UINT_MAX);
+    bool target_node_contained = (target_element != UINT_MAX);
 
     if (!current_node_contained && !target_node_contained)
     {
@@ -69,7 +67,7 @@ double AdhesionPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(unsigned cu
 
     if (current_node_contained && target_node_contained)
     {
-        if (*(new_location_containing_elements.begin()) == *(containing_elements.begin()))
+        if (target_element == current_element)
         {
             EXCEPTION("The current node and target node must not be in the same element.");
         }
@@ -77,17 +75,11 @@ double AdhesionPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(unsigned cu
 
     // Iterate over nodes neighbouring the target node to work out the contact energy contribution
     double delta_H = 0.0;
-    std::set<unsigned> target_neighbouring_node_indices = rCellPopulation.rGetMesh().GetVonNeumannNeighbouringNodeIndices(targetNodeIndex);
-    for (std::set<unsigned>::iterator iter = target_neighbouring_node_indices.begin();
-         iter != target_neighbouring_node_indices.end();
-         ++iter)
+    unsigned num_target_neighbours = r_mesh.GetNumVonNeumannNeighbours(targetNodeIndex);
+    for (unsigned i=0; i<num_target_neighbours; i++)
     {
-        std::set<unsigned> neighbouring_node_containing_elements = rCellPopulation.rGetMesh().GetNode(*iter)->rGetContainingElementIndices();
-
-        // Every node must each be in at most one element
-        assert(neighbouring_node_containing_elements.size() < 2);
-
-        bool neighbouring_node_contained = !neighbouring_node_containing_elements.empty();
+        unsigned neighbour_element = r_mesh.GetContainingElementIndexOfNode(r_mesh.GetVonNeumannNeighbour(targetNodeIndex, i));
+        bool neighbouring_node_contained = (neighbour_element != UINT_MAX);
 
         /**
          * Before the move, we have a negative contribution (H_0) to the Hamiltonian if:
@@ -97,8 +89,6 @@ double AdhesionPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(unsigned cu
          */
         if (neighbouring_node_contained && target_node_contained)
         {
-            unsigned neighbour_element = (*neighbouring_node_containing_elements.begin());
-            unsigned target_element = (*new_location_containing_elements.begin());
             if (target_element != neighbour_element)
             {
                 // The nodes are currently contained in different elements
@@ -108,13 +98,11 @@ double AdhesionPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(unsigned cu
         else if (neighbouring_node_contained && !target_node_contained)
         {
             // The neighbouring node is contained in a Potts element, but the target node is not
-            unsigned neighbour_element = (*neighbouring_node_containing_elements.begin());
             delta_H -= GetCellBoundaryAdhesionEnergy(rCellPopulation.GetCellUsingLocationIndex(neighbour_element));
         }
         else if (!neighbouring_node_contained && target_node_contained)
         {
             // The target node is contained in a Potts element, but the neighbouring node is not
-            unsigned target_element = (*new_location_containing_elements.begin());
             delta_H -= GetCellBoundaryAdhesionEnergy(rCellPopulation.GetCellUsingLocationIndex(target_element));
         }
 
@@ -126,8 +114,6 @@ double AdhesionPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(unsigned cu
          */
         if (neighbouring_node_contained && current_node_contained)
         {
-            unsigned neighbour_element = (*neighbouring_node_containing_elements.begin());
-            unsigned current_element = (*containing_elements.begin());
             if (current_element != neighbour_element)
             {
                 // The nodes are currently contained in different elements
@@ -137,13 +123,11 @@ double AdhesionPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(unsigned cu
         else if (neighbouring_node_contained && !current_node_contained)
         {
             // The neighbouring node is contained in a Potts element, but the current node is not
-            unsigned neighbour_element = (*neighbouring_node_containing_elements.begin());
             delta_H += GetCellBoundaryAdhesionEnergy(rCellPopulation.GetCellUsingLocationIndex(neighbour_element));
         }
         else if (!neighbouring_node_contained && current_node_contained)
         {
             // The current node is contained in a Potts element, but the neighbouring node is not
-            unsigned current_element = (*containing_elements.begin());
             delta_H += GetCellBoundaryAdhesionEnergy(rCellPopulation.GetCellUsingLocationIndex(current_element));
         }
     }
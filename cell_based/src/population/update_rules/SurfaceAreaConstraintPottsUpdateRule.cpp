@@ -59,14 +59,12 @@ double SurfaceAreaConstraintPottsUpdateRule<DIM>::EvaluateHamiltonianContributio
     // This method only works in 2D and 3D at present
     assert(DIM == 2 || DIM == 3);
 
-    std::set<unsigned> containing_elements = rCellPopulation.GetNode(currentNodeIndex)->rGetContainingElementIndices();
-    std::set<unsigned> new_location_containing_elements = rCellPopulation.GetNode(targetNodeIndex)->rGetContainingElementIndices();
+    PottsMesh<DIM>& r_mesh = rCellPopulation.rGetMesh();
+    unsigned current_element = r_mesh.GetContainingElementIndexOfNode(currentNodeIndex);
+    unsigned target_element = r_mesh.GetContainingElementIndexOfNode(targetNodeIndex);
 
-    bool current_node_contained = !containing_elements.empty();
-    bool target_node_contained = !new_location_containing_elements.empty();
-
-    // Every node must each be in at most one element
-    assert(new_location_containing_elements.size() < 2);
+    bool current_node_contained = (current_element != UINT_MAX);
+    bool target_node_contained = (target_element != UINT_MAX);
 
     if (!current_node_contained && !target_node_contained)
     {
@@ -75,7 +73,7 @@ double SurfaceAreaConstraintPottsUpdateRule<DIM>::EvaluateHamiltonianContributio
 
     if (current_node_contained && target_node_contained)
     {
-        if (*(new_location_containing_elements.begin()) == *(containing_elements.begin()))
+        if (target_element == current_element)
         {
             EXCEPTION("The current node and target node must not be in the same element.");
         }
@@ -84,89 +82,45 @@ double SurfaceAreaConstraintPottsUpdateRule<DIM>::EvaluateHamiltonianContributio
     // Iterate over nodes neighbouring the target node to work out the change in surface area
     unsigned neighbours_in_same_element_as_current_node = 0;
     unsigned neighbours_in_same_element_as_target_node = 0;
-    std::set<unsigned> target_neighbouring_node_indices = rCellPopulation.rGetMesh().GetVonNeumannNeighbouringNodeIndices(targetNodeIndex);
-    for (std::set<unsigned>::iterator iter = target_neighbouring_node_indices.begin();
-         iter != target_neighbouring_node_indices.end();
-         ++iter)
+    unsigned num_target_neighbours = r_mesh.GetNumVonNeumannNeighbours(targetNodeIndex);
+    for (unsigned i=0; i<num_target_neighbours; i++)
     {
-        std::set<unsigned> neighbouring_node_containing_elements = rCellPopulation.rGetMesh().GetNode(*iter)->rGetContainingElementIndices();
-
-        // Every node must each be in at most one element
-        assert(neighbouring_node_containing_elements.size() < 2);
-
-        bool neighbouring_node_contained = !neighbouring_node_containing_elements.empty();
+        unsigned neighbour_element = r_mesh.GetContainingElementIndexOfNode(r_mesh.GetVonNeumannNeighbour(targetNodeIndex, i));
 
-        if (neighbouring_node_contained && target_node_contained)
+        if (neighbour_element != UINT_MAX)
         {
-            unsigned neighbour_element = (*neighbouring_node_containing_elements.begin());
-            unsigned target_element = (*new_location_containing_elements.begin());
-            if (target_element == neighbour_element)
+            if (target_node_contained && target_element == neighbour_element)
             {
                 neighbours_in_same_element_as_target_node++;
             }
-        }
-        if (neighbouring_node_contained && current_node_contained)
-        {
-            unsigned neighbour_element = (*neighbouring_node_containing_elements.begin());
-            unsigned current_element = (*containing_elements.begin());
-            if (current_element == neighbour_element)
+            if (current_node_contained && current_element == neighbour_element)
             {
                 neighbours_in_same_element_as_current_node++;
             }
         }
     }
 
-    if (DIM == 2)
-    {
-        assert(neighbours_in_same_element_as_current_node<5);
-        assert(neighbours_in_same_element_as_target_node<5);
-
-        double change_in_surface_area[5] = {4,2,0,-2,-4};
+    // Adding (removing) a lattice site with k neighbours in the same element changes its surface area by 2*DIM-2k (2k-2*DIM)
+    assert(neighbours_in_same_element_as_current_node <= 2*DIM);
+    assert(neighbours_in_same_element_as_target_node <= 2*DIM);
 
-        if (current_node_contained) // current node is in an element
-        {
-            unsigned current_element = (*containing_elements.begin());
-            double current_surface_area = rCellPopulation.rGetMesh().GetSurfaceAreaOfElement(current_element);
-            double current_surface_area_difference = current_surface_area - mMatureCellTargetSurfaceArea;
-            double current_surface_area_difference_after_switch = current_surface_area_difference + change_in_surface_area[neighbours_in_same_element_as_current_node];
-
-            delta_H += mDeformationEnergyParameter*(current_surface_area_difference_after_switch*current_surface_area_difference_after_switch - current_surface_area_difference*current_surface_area_difference);
-        }
-        if (target_node_contained) // target node is in an element
-        {
-            unsigned target_element = (*new_location_containing_elements.begin());
-            double target_surface_area = rCellPopulation.rGetMesh().GetSurfaceAreaOfElement(target_element);
-            double target_surface_area_difference = target_surface_area - mMatureCellTargetSurfaceArea;
-            double target_surface_area_difference_after_switch = target_surface_area_difference - change_in_surface_area[neighbours_in_same_element_as_target_node];
+    if (current_node_contained) // current node is in an element
+    {
+        double current_surface_area = r_mesh.GetCachedSurfaceAreaOfElement(current_element);
+        double current_surface_area_difference = current_surface_area - mMatureCellTargetSurfaceArea;
+        double change_in_surface_area = 2.0*DIM - 2.0*neighbours_in_same_element_as_current_node;
+        double current_surface_area_difference_after_switch = current_surface_area_difference + change_in_surface_area;
 
-            delta_H += mDeformationEnergyParameter*(target_surface_area_difference_after_switch*target_surface_area_difference_after_switch - target_surface_area_difference*target_surface_area_difference);
-        }
+        delta_H += mDeformationEnergyParameter*(current_surface_area_difference_after_switch*current_surface_area_difference_after_switch - current_surface_area_difference*current_surface_area_difference);
     }
-    else if (DIM==3)
+    if (target_node_contained) // target node is in an element
     {
-        assert(neighbours_in_same_element_as_current_node < 7);
-        assert(neighbours_in_same_element_as_target_node < 7);
-
-        double change_in_surface_area[7] = {6,4,2,0,-2,-4,-6};
-
-        if (current_node_contained) // current node is in an element
-        {
-            unsigned current_element = (*containing_elements.begin());
-            double current_surface_area = rCellPopulation.rGetMesh().GetSurfaceAreaOfElement(current_element);
-            double current_surface_area_difference = current_surface_area - mMatureCellTargetSurfaceArea;
-            double current_surface_area_difference_after_switch = current_surface_area_difference + change_in_surface_area[neighbours_in_same_element_as_current_node];
+        double target_surface_area = r_mesh.GetCachedSurfaceAreaOfElement(target_element);
+        double target_surface_area_difference = target_surface_area - mMatureCellTargetSurfaceArea;
+        double change_in_surface_area = 2.0*DIM - 2.0*neighbours_in_same_element_as_target_node;
+        double target_surface_area_difference_after_switch = target_surface_area_difference - change_in_surface_area;
 
-            delta_H += mDeformationEnergyParameter*(current_surface_area_difference_after_switch*current_surface_area_difference_after_switch - current_surface_area_difference*current_surface_area_difference);
-        }
-        if (target_node_contained) // target node is in an element
-        {
-            unsigned target_element = (*new_location_containing_elements.begin());
-            double target_surface_area = rCellPopulation.rGetMesh().GetSurfaceAreaOfElement(target_element);
-            double target_surface_area_difference = target_surface_area - mMatureCellTargetSurfaceArea;
-            double target_surface_area_difference_after_switch = target_surface_area_difference - change_in_surface_area[neighbours_in_same_element_as_target_node];
-
-            delta_H += mDeformationEnergyParameter*(target_surface_area_difference_after_switch*target_surface_area_difference_after_switch - target_surface_area_difference*target_surface_area_difference);
-        }
+        delta_H += mDeformationEnergyParameter*(target_surface_area_difference_after_switch*target_surface_area_difference_after_switch - target_surface_area_difference*target_surface_area_difference);
     }
 
     return delta_H;
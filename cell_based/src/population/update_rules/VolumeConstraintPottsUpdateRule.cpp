@@ -56,14 +56,12 @@ double VolumeConstraintPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(uns
 {
     double delta_H = 0.0;
 
-    std::set<unsigned> containing_elements = rCellPopulation.GetNode(currentNodeIndex)->rGetContainingElementIndices();
-    std::set<unsigned> new_location_containing_elements = rCellPopulation.GetNode(targetNodeIndex)->rGetContainingElementIndices();
+    PottsMesh<DIM>& r_mesh = rCellPopulation.rGetMesh();
+    unsigned current_element = r_mesh.GetContainingElementIndexOfNode(currentNodeIndex);
+    unsigned target_element = r_mesh.GetContainingElementIndexOfNode(targetNodeIndex);
 
-    bool current_node_contained = !containing_elements.empty();
-    bool target_node_contained = !new_location_containing_elements.empty();
-
-    // Every node must each be in at most one element
-    assert(new_location_containing_elements.size() < 2);
+    bool current_node_contained = (current_element != UINT_MAX);
+    bool target_node_contained = (target_element != UINT_MAX);
 
     if (!current_node_contained && !target_node_contained)
     {
@@ -72,7 +70,7 @@ double VolumeConstraintPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(uns
 
     if (current_node_contained && target_node_contained)
     {
-        if (*(new_location_containing_elements.begin()) == *(containing_elements.begin()))
+        if (target_element == current_element)
         {
             EXCEPTION("The current node and target node must not be in the same element.");
         }
@@ -80,16 +78,14 @@ double VolumeConstraintPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(uns
 
     if (current_node_contained) // current node is in an element
     {
-        unsigned current_element = (*containing_elements.begin());
-        double current_volume = rCellPopulation.rGetMesh().GetVolumeOfElement(current_element);
+        double current_volume = r_mesh.GetVolumeOfElement(current_element);
         double current_volume_difference = current_volume - mMatureCellTargetVolume;
 
         delta_H += mDeformationEnergyParameter*((current_volume_difference + 1.0)*(current_volume_difference + 1.0) - current_volume_difference*current_volume_difference);
     }
     if (target_node_contained) // target node is in an element
     {
-        unsigned target_element = (*new_location_containing_elements.begin());
-        double target_volume = rCellPopulation.rGetMesh().GetVolumeOfElement(target_element);
+        double target_volume = r_mesh.GetVolumeOfElement(target_element);
         double target_volume_difference = target_volume - mMatureCellTargetVolume;
 
         delta_H += mDeformationEnergyParameter*((target_volume_difference - 1.0)*(target_volume_difference - 1.0) - target_volume_difference*target_volume_difference);
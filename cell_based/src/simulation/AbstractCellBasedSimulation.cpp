@@ -36,15 +36,22 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cmath>
 #include <iostream>
 #include <fstream>
+#include <map>
 #include <set>
+#include <boost/scoped_ptr.hpp>
 
 #include "AbstractCellBasedSimulation.hpp"
 #include "CellBasedEventHandler.hpp"
+#include "CellBasedProfiler.hpp"
+#include "CellBasedProfilerScope.hpp"
+#include "ThreadPool.hpp"
 #include "LogFile.hpp"
 #include "Version.hpp"
 #include "ExecutableSupport.hpp"
 #include "Exception.hpp"
 #include "AbstractPdeModifier.hpp"
+#include "DeltaNotchSrnModel.hpp"
+#include "ApoptoticCellProperty.hpp"
 #include <typeinfo>
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -64,7 +71,9 @@ AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::AbstractCellBasedSimulation(
       mNumDeaths(0),
       mOutputDivisionLocations(false),
       mOutputCellVelocities(false),
-      mSamplingTimestepMultiple(1)
+      mSamplingTimestepMultiple(1),
+      mSolveCellOdesInBatches(false),
+      mOutputProfileTrace(false)
 {
     // Set a random seed of 0 if it wasn't specified earlier
     RandomNumberGenerator::Instance();
@@ -175,7 +184,9 @@ unsigned AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::DoCellRemoval()
          killer_iter != mCellKillers.end();
          ++killer_iter)
     {
+        unsigned timer = CellBasedProfiler::Instance()->BeginTimer("Killer", killer_iter->get());
         (*killer_iter)->CheckAndLabelCellsForApoptosisOrDeath();
+        CellBasedProfiler::Instance()->EndTimer(timer);
     }
 
     num_deaths_this_step += mrCellPopulation.RemoveDeadCells();
@@ -317,6 +328,16 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::Solve()
         EXCEPTION("SetEndTime has not yet been called.");
     }
 
+    /*
+     * The profiler is shared by every thread, so it may not be used by simulations that are
+     * run by tasks on the thread pool (AbstractCellBasedSimulationEnsemble disables it).
+     */
+    CellBasedProfiler* p_profiler = CellBasedProfiler::Instance();
+    if ((mOutputProfileTrace || p_profiler->IsEnabled()) && ThreadPool::Instance()->IsRunningTask())
+    {
+        EXCEPTION("Profiling is not supported for simulations run on the thread pool.");
+    }
+
     /*
      * Note that mDt is used here for "ideal time step". If this step doesn't divide the time remaining
      * then a *different* time step will be taken by the time-stepper. The real time-step (used in the
@@ -385,6 +406,20 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::Solve()
         }
     }
 
+    // The scope restores the profiler's state and closes the trace file however Solve() ends
+    boost::scoped_ptr<CellBasedProfilerScope> p_profiler_scope;
+    if (mOutputProfileTrace)
+    {
+        p_profiler_scope.reset(new CellBasedProfilerScope(true));
+        p_profiler_scope->OpenTraceFile(output_file_handler, "profile_trace.csv");
+    }
+
+    // Objects timed in a previous call to Solve() may since have been destroyed
+    if (p_profiler->IsEnabled())
+    {
+        p_profiler->ClearObjectCache();
+    }
+
     this->mrCellPopulation.SimulationSetupHook(this);
 
     SetupSolve();
@@ -394,7 +429,9 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::Solve()
          iter != mSimulationModifiers.end();
          ++iter)
     {
+        unsigned timer = p_profiler->BeginTimer("Modifier", iter->get());
         (*iter)->SetupSolve(this->mrCellPopulation,this->mSimulationOutputDirectory);
+        p_profiler->EndTimer(timer);
     }
 
     /*
@@ -425,6 +462,10 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::Solve()
     mrCellPopulation.WriteResultsToFiles(results_directory+"/");
 
     OutputSimulationSetup();
+    if (mOutputProfileTrace)
+    {
+        p_profiler->WriteTraceStep(p_simulation_time->GetTimeStepsElapsed(), p_simulation_time->GetTime());
+    }
     CellBasedEventHandler::EndEvent(CellBasedEventHandler::SETUP);
 
     // Enter main time loop
@@ -502,7 +543,9 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::Solve()
              iter != mSimulationModifiers.end();
              ++iter)
         {
+            unsigned timer = p_profiler->BeginTimer("Modifier", iter->get());
             (*iter)->UpdateAtEndOfTimeStep(this->mrCellPopulation);
+            p_profiler->EndTimer(timer);
         }
         CellBasedEventHandler::EndEvent(CellBasedEventHandler::UPDATESIMULATION);
 
@@ -517,10 +560,17 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::Solve()
                  iter != mSimulationModifiers.end();
                  ++iter)
             {
+                unsigned timer = p_profiler->BeginTimer("Modifier", iter->get());
                 (*iter)->UpdateAtEndOfOutputTimeStep(this->mrCellPopulation);
+                p_profiler->EndTimer(timer);
             }
         }
         CellBasedEventHandler::EndEvent(CellBasedEventHandler::OUTPUT);
+
+        if (mOutputProfileTrace)
+        {
+            p_profiler->WriteTraceStep(p_simulation_time->GetTimeStepsElapsed(), p_simulation_time->GetTime());
+        }
     }
 
     LOG(1, "--END TIME = " << p_simulation_time->GetTime() << "\n");
@@ -538,7 +588,9 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::Solve()
          iter != mSimulationModifiers.end();
          ++iter)
     {
+        unsigned timer = p_profiler->BeginTimer("Modifier", iter->get());
         (*iter)->UpdateAtEndOfSolve(this->mrCellPopulation);
+        p_profiler->EndTimer(timer);
     }
     CellBasedEventHandler::EndEvent(CellBasedEventHandler::UPDATESIMULATION);
 
@@ -561,6 +613,13 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::Solve()
         mpVizSetupFile->close();
     }
 
+    if (mOutputProfileTrace)
+    {
+        // The final update of the cell population is recorded against the last time step
+        p_profiler->WriteTraceStep(p_simulation_time->GetTimeStepsElapsed(), p_simulation_time->GetTime());
+        p_profiler_scope.reset();
+    }
+
     CellBasedEventHandler::EndEvent(CellBasedEventHandler::OUTPUT);
     CellBasedEventHandler::EndEvent(CellBasedEventHandler::EVERYTHING);
 }
@@ -583,6 +642,10 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::UpdateCellPopulation()
 
     // Divide cells
     CellBasedEventHandler::BeginEvent(CellBasedEventHandler::BIRTH);
+    if (mSolveCellOdesInBatches && !mNoBirth)
+    {
+        SolveCellOdesInBatches();
+    }
     unsigned births_this_step = DoCellBirth();
     mNumBirths += births_this_step;
     LOG(1, "\tNum births = " << mNumBirths << "\n");
@@ -606,6 +669,32 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::UpdateCellPopulation()
     CellBasedEventHandler::EndEvent(CellBasedEventHandler::UPDATECELLPOPULATION);
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::SolveCellOdesInBatches()
+{
+    std::vector<DeltaNotchSrnModel*> delta_notch_models;
+
+    for (typename AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>::Iterator cell_iter = mrCellPopulation.Begin();
+         cell_iter != mrCellPopulation.End();
+         ++cell_iter)
+    {
+        // Only include cells for which DoCellBirth() will call ReadyToDivide() and run the models
+        if ((cell_iter->GetAge() <= 0.0) || cell_iter->HasApoptosisBegun()
+            || cell_iter->template HasCellProperty<ApoptoticCellProperty>() || cell_iter->IsDead())
+        {
+            continue;
+        }
+
+        DeltaNotchSrnModel* p_srn_model = dynamic_cast<DeltaNotchSrnModel*>(cell_iter->GetSrnModel());
+        if (p_srn_model)
+        {
+            delta_notch_models.push_back(p_srn_model);
+        }
+    }
+
+    DeltaNotchSrnModel::SimulateModelsToCurrentTime(delta_notch_models);
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::GetOutputDivisionLocations()
 {
@@ -630,6 +719,30 @@ void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::SetOutputCellVelocities
     mOutputCellVelocities = outputCellVelocities;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::GetSolveCellOdesInBatches()
+{
+    return mSolveCellOdesInBatches;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::SetSolveCellOdesInBatches(bool solveCellOdesInBatches)
+{
+    mSolveCellOdesInBatches = solveCellOdesInBatches;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::GetOutputProfileTrace()
+{
+    return mOutputProfileTrace;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::SetOutputProfileTrace(bool outputProfileTrace)
+{
+    mOutputProfileTrace = outputProfileTrace;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::OutputSimulationSetup()
 {
@@ -104,6 +104,8 @@ private:
         archive & mCellKillers;
         archive & mSimulationModifiers;
         archive & mSamplingTimestepMultiple;
+        archive & mSolveCellOdesInBatches;
+        archive & mOutputProfileTrace;
     }
 
 protected:
@@ -171,6 +173,20 @@ protected:
      */
     unsigned mSamplingTimestepMultiple;
 
+    /**
+     * Whether to integrate the Delta-Notch SRN models of all cells in a single batched
+     * pass before processing cell divisions (see SolveCellOdesInBatches()).
+     * Initialised to false in constructor.
+     */
+    bool mSolveCellOdesInBatches;
+
+    /**
+     * Whether to enable CellBasedProfiler during Solve() and write the timings and
+     * counters of each time step to the file profile_trace.csv. Initialised to false
+     * in constructor.
+     */
+    bool mOutputProfileTrace;
+
     /**
      * Writes out special information about the mesh to the visualizer.
      */
@@ -195,6 +211,22 @@ protected:
      */
     virtual unsigned DoCellBirth();
 
+    /**
+     * Advance the SRN ODEs that DoCellBirth() would otherwise solve lazily, one cell at
+     * a time, through Cell::ReadyToDivide().
+     *
+     * The Delta-Notch SRN models of all cells are passed to
+     * DeltaNotchSrnModel::SimulateModelsToCurrentTime(), which integrates those using the
+     * Runge-Kutta solver in one structure-of-arrays pass, shared between the threads of
+     * the ThreadPool. Other models are left to ReadyToDivide(). When DoCellBirth() then
+     * calls ReadyToDivide(), each batched model finds that it has already been simulated
+     * to the current time.
+     *
+     * Only cells that DoCellBirth() would ask to divide are included, so the results
+     * are identical to those of the lazy path.
+     */
+    void SolveCellOdesInBatches();
+
     /**
      * During a simulation time step, process any cell sloughing or death
      *
@@ -468,6 +500,30 @@ public:
      */
     void SetOutputCellVelocities(bool outputCellVelocities);
 
+    /**
+     * @return mSolveCellOdesInBatches
+     */
+    bool GetSolveCellOdesInBatches();
+
+    /**
+     * Set mSolveCellOdesInBatches.
+     *
+     * @param solveCellOdesInBatches the new value of mSolveCellOdesInBatches
+     */
+    void SetSolveCellOdesInBatches(bool solveCellOdesInBatches);
+
+    /**
+     * @return mOutputProfileTrace
+     */
+    bool GetOutputProfileTrace();
+
+    /**
+     * Set mOutputProfileTrace.
+     *
+     * @param outputProfileTrace the new value of mOutputProfileTrace
+     */
+    void SetOutputProfileTrace(bool outputProfileTrace);
+
     /**
      * Outputs simulation parameters to file
      *
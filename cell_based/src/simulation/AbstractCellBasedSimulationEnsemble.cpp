@@ -0,0 +1,171 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "AbstractCellBasedSimulationEnsemble.hpp"
+#include "ThreadPool.hpp"
+#include "ThreadPoolMemberTask.hpp"
+#include "PetscTools.hpp"
+#include "Warnings.hpp"
+#include "CellBasedEventHandler.hpp"
+#include "CellBasedProfilerScope.hpp"
+#include "AsynchronousVtkWriter.hpp"
+
+AbstractCellBasedSimulationEnsemble::AbstractCellBasedSimulationEnsemble()
+    : mFirstSeed(0u)
+{
+}
+
+AbstractCellBasedSimulationEnsemble::~AbstractCellBasedSimulationEnsemble()
+{
+}
+
+void AbstractCellBasedSimulationEnsemble::SetFirstSeed(unsigned firstSeed)
+{
+    mFirstSeed = firstSeed;
+}
+
+unsigned AbstractCellBasedSimulationEnsemble::GetFirstSeed() const
+{
+    return mFirstSeed;
+}
+
+void AbstractCellBasedSimulationEnsemble::FinishReplicate(unsigned replicateIndex)
+{
+}
+
+void AbstractCellBasedSimulationEnsemble::RunReplicates(unsigned firstReplicateIndex, unsigned endReplicateIndex)
+{
+    for (unsigned replicate_index=firstReplicateIndex; replicate_index<endReplicateIndex; replicate_index++)
+    {
+        SimulationContext& r_context = *(mContexts[replicate_index]);
+        r_context.Activate();
+        try
+        {
+            RunReplicate(replicate_index);
+        }
+        catch (Exception&)
+        {
+            r_context.Deactivate();
+            throw;
+        }
+        r_context.Deactivate();
+    }
+}
+
+void AbstractCellBasedSimulationEnsemble::Run(unsigned numReplicates)
+{
+    if (ThreadPool::Instance()->GetNumThreads() == 1 || numReplicates < 2 || PetscTools::IsParallel())
+    {
+        for (unsigned replicate_index=0; replicate_index<numReplicates; replicate_index++)
+        {
+            // The context is deactivated and its services freed when it goes out of scope
+            SimulationContext context(mFirstSeed + replicate_index);
+            context.Activate();
+
+            RunReplicate(replicate_index);
+            FinishReplicate(replicate_index);
+
+            context.Deactivate();
+        }
+        return;
+    }
+
+    // Create every context on this thread, so that the pool threads only use them
+    mContexts.clear();
+    for (unsigned replicate_index=0; replicate_index<numReplicates; replicate_index++)
+    {
+        mContexts.push_back(boost::shared_ptr<SimulationContext>(new SimulationContext(mFirstSeed + replicate_index)));
+    }
+
+    /*
+     * Make sure that the shared singletons which simulations use are created before the
+     * threads start, and stop the pool threads from making PETSc calls or recording timings
+     */
+    Warnings::Instance();
+#ifdef CHASTE_VTK
+    AsynchronousVtkWriter::Instance();
+#endif
+    bool was_isolated = PetscTools::IsIsolated();
+    bool event_handler_was_enabled = CellBasedEventHandler::IsEnabled();
+    PetscTools::IsolateProcesses(true);
+    CellBasedEventHandler::Disable();
+    {
+        // The profiler is switched back on, if it was on, when this block is left
+        CellBasedProfilerScope profiler_scope(false);
+
+        // Give each thread one replicate at a time, as replicates may take very different times
+        ThreadPoolMemberTask<AbstractCellBasedSimulationEnsemble> task(this, &AbstractCellBasedSimulationEnsemble::RunReplicates);
+        try
+        {
+            ThreadPool::Instance()->ParallelFor(numReplicates, task, 1);
+        }
+        catch (Exception&)
+        {
+            mContexts.clear();
+            PetscTools::IsolateProcesses(was_isolated);
+            if (event_handler_was_enabled)
+            {
+                CellBasedEventHandler::Enable();
+            }
+            throw;
+        }
+    }
+
+    PetscTools::IsolateProcesses(was_isolated);
+    if (event_handler_was_enabled)
+    {
+        CellBasedEventHandler::Enable();
+    }
+
+    // Record the results on this thread
+    for (unsigned replicate_index=0; replicate_index<numReplicates; replicate_index++)
+    {
+        SimulationContext& r_context = *(mContexts[replicate_index]);
+        r_context.Activate();
+        try
+        {
+            FinishReplicate(replicate_index);
+        }
+        catch (Exception&)
+        {
+            r_context.Deactivate();
+            mContexts.clear();
+            throw;
+        }
+        r_context.Deactivate();
+    }
+    mContexts.clear();
+}
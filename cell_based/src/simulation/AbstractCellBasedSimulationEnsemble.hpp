@@ -0,0 +1,150 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef ABSTRACTCELLBASEDSIMULATIONENSEMBLE_HPP_
+#define ABSTRACTCELLBASEDSIMULATIONENSEMBLE_HPP_
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include "SimulationContext.hpp"
+
+/**
+ * An abstract class for running an ensemble of independent cell-based simulations,
+ * such as stochastic replicates or a parameter sweep, within one process.
+ *
+ * Each replicate is run in its own SimulationContext, so it has a fresh simulation
+ * time (starting at time zero), its own random number generator seeded with the
+ * first seed plus the replicate index, its own cell property registry and cell IDs
+ * starting from zero. Replicates therefore give the same results as if each were run
+ * in a separate process, without paying process start-up costs for each one.
+ *
+ * Subclasses set up and run a single simulation in RunReplicate(), and may record
+ * its results in FinishReplicate().
+ *
+ * If the ThreadPool singleton has more than one thread and this is a sequential
+ * run, replicates are shared between its threads. Each simulation then uses the
+ * services of its own context on whichever thread runs it, while the calling
+ * (master) thread keeps the default services. While replicates run on the pool:
+ *  - PetscTools treats the process as isolated, so output file handlers make no
+ *    PETSc calls. RunReplicate() must not make any other PETSc calls, for example
+ *    by solving PDEs with the finite element solvers;
+ *  - CellBasedEventHandler and CellBasedProfiler are disabled;
+ *  - each replicate must write its results to its own output directory.
+ * FinishReplicate() is called on the master thread, in replicate order, once every
+ * replicate has run, and is the place for any work which does use PETSc or writes
+ * to shared files.
+ */
+class AbstractCellBasedSimulationEnsemble
+{
+private:
+
+    /** The seed used for the random number generator of the first replicate. */
+    unsigned mFirstSeed;
+
+    /** The context of each replicate, while Run() shares replicates between threads. */
+    std::vector<boost::shared_ptr<SimulationContext> > mContexts;
+
+    /**
+     * Run a contiguous range of replicates, each in its own context from mContexts.
+     * This is the task given to the ThreadPool by Run().
+     *
+     * @param firstReplicateIndex the index of the first replicate in the range
+     * @param endReplicateIndex one past the index of the last replicate in the range
+     */
+    void RunReplicates(unsigned firstReplicateIndex, unsigned endReplicateIndex);
+
+protected:
+
+    /**
+     * Set up and solve a single simulation. This method is called with the
+     * replicate's SimulationContext active, on any thread of the ThreadPool, and
+     * may be called for several replicates at once. It should therefore only write
+     * to data belonging to its own replicate, such as an element of a vector
+     * sized before calling Run().
+     *
+     * As this method is pure virtual, it must be overridden in subclasses.
+     *
+     * @param replicateIndex the index of the replicate, from zero
+     */
+    virtual void RunReplicate(unsigned replicateIndex)=0;
+
+    /**
+     * Record the results of a single simulation. This method is called on the
+     * thread which called Run(), in replicate order, with the replicate's
+     * SimulationContext active, after RunReplicate() has been called for every
+     * replicate (or straight after RunReplicate() for this replicate, if
+     * replicates are run one at a time). The default implementation does nothing.
+     *
+     * @param replicateIndex the index of the replicate, from zero
+     */
+    virtual void FinishReplicate(unsigned replicateIndex);
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    AbstractCellBasedSimulationEnsemble();
+
+    /**
+     * Destructor.
+     */
+    virtual ~AbstractCellBasedSimulationEnsemble();
+
+    /**
+     * Set mFirstSeed.
+     *
+     * @param firstSeed the seed for the first replicate's random number generator
+     */
+    void SetFirstSeed(unsigned firstSeed);
+
+    /**
+     * @return mFirstSeed.
+     */
+    unsigned GetFirstSeed() const;
+
+    /**
+     * Run a number of replicates, each in its own SimulationContext, sharing them
+     * between the threads of the ThreadPool if it has more than one. The services
+     * used by the calling thread are unaffected, even if a replicate throws an
+     * exception.
+     *
+     * @param numReplicates the number of replicates to run
+     */
+    void Run(unsigned numReplicates);
+};
+
+#endif /*ABSTRACTCELLBASEDSIMULATIONENSEMBLE_HPP_*/
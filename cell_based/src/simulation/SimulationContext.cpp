@@ -0,0 +1,106 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "SimulationContext.hpp"
+#include "CellId.hpp"
+#include "Exception.hpp"
+
+SimulationContext::SimulationContext(unsigned seed, double startTime)
+    : mpSimulationTime(NULL),
+      mpRandomNumberGenerator(NULL),
+      mpCellPropertyRegistry(NULL),
+      mMaxCellId(0u),
+      mppPreviousSimulationTime(NULL),
+      mppPreviousRandomNumberGenerator(NULL),
+      mppPreviousCellPropertyRegistry(NULL),
+      mpPreviousMaxCellId(NULL),
+      mpPreviousCellCycleModelOdeSolvers(NULL),
+      mIsActive(false)
+{
+    // Create this context's simulation time and random number generator, leaving those in use in place
+    SimulationTime** pp_current_simulation_time = SimulationTime::SetThreadInstanceLocation(&mpSimulationTime);
+    SimulationTime::Instance()->SetStartTime(startTime);
+    SimulationTime::SetThreadInstanceLocation(pp_current_simulation_time);
+
+    RandomNumberGenerator** pp_current_random_number_generator = RandomNumberGenerator::SetThreadInstanceLocation(&mpRandomNumberGenerator);
+    RandomNumberGenerator::Instance()->Reseed(seed);
+    RandomNumberGenerator::SetThreadInstanceLocation(pp_current_random_number_generator);
+}
+
+SimulationContext::~SimulationContext()
+{
+    if (mIsActive)
+    {
+        Deactivate();
+    }
+
+    delete mpSimulationTime;
+    delete mpRandomNumberGenerator;
+    delete mpCellPropertyRegistry;
+}
+
+void SimulationContext::Activate()
+{
+    if (mIsActive)
+    {
+        EXCEPTION("This simulation context is already active.");
+    }
+    mppPreviousSimulationTime = SimulationTime::SetThreadInstanceLocation(&mpSimulationTime);
+    mppPreviousRandomNumberGenerator = RandomNumberGenerator::SetThreadInstanceLocation(&mpRandomNumberGenerator);
+    mppPreviousCellPropertyRegistry = CellPropertyRegistry::SetThreadInstanceLocation(&mpCellPropertyRegistry);
+    mpPreviousMaxCellId = CellId::SetThreadMaxCellIdLocation(&mMaxCellId);
+    mpPreviousCellCycleModelOdeSolvers = AbstractCellCycleModelOdeSolver::SetThreadInstanceLocation(&mCellCycleModelOdeSolvers);
+    mIsActive = true;
+}
+
+void SimulationContext::Deactivate()
+{
+    if (!mIsActive)
+    {
+        EXCEPTION("This simulation context is not active.");
+    }
+    SimulationTime::SetThreadInstanceLocation(mppPreviousSimulationTime);
+    RandomNumberGenerator::SetThreadInstanceLocation(mppPreviousRandomNumberGenerator);
+    CellPropertyRegistry::SetThreadInstanceLocation(mppPreviousCellPropertyRegistry);
+    CellId::SetThreadMaxCellIdLocation(mpPreviousMaxCellId);
+    AbstractCellCycleModelOdeSolver::SetThreadInstanceLocation(mpPreviousCellCycleModelOdeSolvers);
+    mIsActive = false;
+}
+
+bool SimulationContext::IsActive() const
+{
+    return mIsActive;
+}
@@ -0,0 +1,149 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef SIMULATIONCONTEXT_HPP_
+#define SIMULATIONCONTEXT_HPP_
+
+#include "SimulationTime.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "CellPropertyRegistry.hpp"
+#include "AbstractCellCycleModelOdeSolver.hpp"
+
+/**
+ * A set of the global services used by a cell-based simulation: the simulation
+ * time, the random number generator, the cell property registry, the cell ID
+ * counter and the ODE solvers shared by ODE-based cell-cycle and SRN models.
+ *
+ * These services are singletons, so by default a process can only run one
+ * simulation at a time. A SimulationContext owns its own copy of each service.
+ * While it is active on a thread (between calls to Activate() and Deactivate()
+ * on that thread) its copies replace the singletons for that thread only, so that
+ * code running on the thread which calls, for example, SimulationTime::Instance()
+ * sees the context's simulation time. The services that were in use before
+ * activation are used again after deactivation, so the shared singletons act as
+ * the default context.
+ *
+ * This allows several simulations, such as stochastic replicates, to be run (or
+ * interleaved) within one process, and to run at the same time on different
+ * threads; see AbstractCellBasedSimulationEnsemble. Contexts must be activated
+ * and deactivated in a nested fashion on each thread, and a context may only be
+ * active on one thread at a time.
+ */
+class SimulationContext
+{
+private:
+
+    /** This context's simulation time. */
+    SimulationTime* mpSimulationTime;
+
+    /** This context's random number generator. */
+    RandomNumberGenerator* mpRandomNumberGenerator;
+
+    /** This context's cell property registry, which is created the first time it is used. */
+    CellPropertyRegistry* mpCellPropertyRegistry;
+
+    /** This context's maximum cell ID. */
+    unsigned mMaxCellId;
+
+    /** This context's cell-cycle model ODE solvers, which are created the first time each is used. */
+    AbstractCellCycleModelOdeSolver::InstanceMap mCellCycleModelOdeSolvers;
+
+    /** Where the thread on which this context is active found its simulation time before activation. */
+    SimulationTime** mppPreviousSimulationTime;
+
+    /** Where the thread on which this context is active found its random number generator before activation. */
+    RandomNumberGenerator** mppPreviousRandomNumberGenerator;
+
+    /** Where the thread on which this context is active found its cell property registry before activation. */
+    CellPropertyRegistry** mppPreviousCellPropertyRegistry;
+
+    /** Where the thread on which this context is active found its maximum cell ID before activation. */
+    unsigned* mpPreviousMaxCellId;
+
+    /** Where the thread on which this context is active found its cell-cycle model ODE solvers before activation. */
+    AbstractCellCycleModelOdeSolver::InstanceMap* mpPreviousCellCycleModelOdeSolvers;
+
+    /** Whether this context is active. */
+    bool mIsActive;
+
+    /**
+     * Copy constructor.
+     */
+    SimulationContext(const SimulationContext&);
+
+    /**
+     * Overloaded assignment operator.
+     * @return reference by convention
+     */
+    SimulationContext& operator= (const SimulationContext&);
+
+public:
+
+    /**
+     * Constructor. Creates a new simulation time and random number generator,
+     * without affecting the services used by any thread.
+     *
+     * @param seed the seed for this context's random number generator (defaults to 0)
+     * @param startTime the start time of this context's simulation time (defaults to 0.0)
+     */
+    SimulationContext(unsigned seed=0u, double startTime=0.0);
+
+    /**
+     * Destructor. Deactivates the context if necessary, then frees its services.
+     */
+    ~SimulationContext();
+
+    /**
+     * Make the calling thread use this context's services in place of those it
+     * currently uses.
+     */
+    void Activate();
+
+    /**
+     * Make the calling thread use the services that it used before Activate() was
+     * called. This must be called on the thread which activated the context. The
+     * services used while active, including any created or replaced during that
+     * time, are kept by this context for the next activation.
+     */
+    void Deactivate();
+
+    /**
+     * @return mIsActive.
+     */
+    bool IsActive() const;
+};
+
+#endif /*SIMULATIONCONTEXT_HPP_*/
@@ -38,7 +38,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 template<unsigned DIM>
 AbstractTargetAreaModifier<DIM>::AbstractTargetAreaModifier()
     : AbstractCellBasedSimulationModifier<DIM>(),
-      mReferenceTargetArea(1.0)
+      mReferenceTargetArea(1.0),
+      mTargetAreaKey("target area")
 {
 }
 
@@ -74,7 +75,7 @@ void AbstractTargetAreaModifier<DIM>::UpdateTargetAreas(AbstractCellPopulation<D
     // Assume that SetupSolve() has already been called, so we must be using a VertexBasedCellPopulation
 
     // Loop over the list of cells, rather than using the population iterator, so as to include dead cells
-    for (std::list<CellPtr>::iterator cell_iter = rCellPopulation.rGetCells().begin();
+    for (std::vector<CellPtr>::iterator cell_iter = rCellPopulation.rGetCells().begin();
          cell_iter != rCellPopulation.rGetCells().end();
          ++cell_iter)
     {
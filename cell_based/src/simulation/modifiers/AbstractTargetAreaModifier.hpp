@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/base_object.hpp>
 #include "AbstractCellBasedSimulationModifier.hpp"
 #include "VertexBasedCellPopulation.hpp"
+#include "CellDataKey.hpp"
 
 /**
  * A modifier class in which the target area property of each cell is updated.
@@ -71,6 +72,13 @@ protected:
      */
     double mReferenceTargetArea;
 
+    /**
+     * The key of the "target area" item of CellData, looked up once so that
+     * subclasses can set each cell's target area without a string comparison.
+     * Not archived, as it is set in the constructor.
+     */
+    CellDataKey mTargetAreaKey;
+
 public:
 
     /**
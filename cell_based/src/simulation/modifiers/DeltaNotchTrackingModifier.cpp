@@ -69,6 +69,11 @@ void DeltaNotchTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,
     // Make sure the cell population is updated
     rCellPopulation.Update();
 
+    // Look up the keys of the cell data items once, rather than for every cell
+    static const CellDataKey notch_key("notch");
+    static const CellDataKey delta_key("delta");
+    static const CellDataKey mean_delta_key("mean delta");
+
     // First recover each cell's Notch and Delta concentrations from the ODEs and store in CellData
     for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
          cell_iter != rCellPopulation.End();
@@ -79,8 +84,8 @@ void DeltaNotchTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,
         double this_notch = p_model->GetNotch();
 
         // Note that the state variables must be in the same order as listed in DeltaNotchOdeSystem
-        cell_iter->GetCellData()->SetItem("notch", this_notch);
-        cell_iter->GetCellData()->SetItem("delta", this_delta);
+        cell_iter->GetCellData()->SetItem(notch_key, this_notch);
+        cell_iter->GetCellData()->SetItem(delta_key, this_delta);
     }
 
     // Next iterate over the population to compute and store each cell's neighbouring Delta concentration in CellData
@@ -88,27 +93,28 @@ void DeltaNotchTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,
          cell_iter != rCellPopulation.End();
          ++cell_iter)
     {
-        // Get the set of neighbouring location indices
-        std::set<unsigned> neighbour_indices = rCellPopulation.GetNeighbouringLocationIndices(*cell_iter);
+        // Get the number of neighbouring location indices
+        unsigned location_index = rCellPopulation.GetLocationIndexUsingCell(*cell_iter);
+        unsigned num_neighbours = rCellPopulation.GetNumNeighbouringLocations(location_index);
 
         // Compute this cell's average neighbouring Delta concentration and store in CellData
-        if (!neighbour_indices.empty())
+        if (num_neighbours > 0)
         {
             double mean_delta = 0.0;
-            for (std::set<unsigned>::iterator iter = neighbour_indices.begin();
-                 iter != neighbour_indices.end();
+            for (typename AbstractCellPopulation<DIM>::NeighbourIterator iter = rCellPopulation.GetNeighbouringLocationsBegin(location_index);
+                 iter != rCellPopulation.GetNeighbouringLocationsEnd(location_index);
                  ++iter)
             {
                 CellPtr p_cell = rCellPopulation.GetCellUsingLocationIndex(*iter);
-                double this_delta = p_cell->GetCellData()->GetItem("delta");
-                mean_delta += this_delta/neighbour_indices.size();
+                double this_delta = p_cell->GetCellData()->GetItem(delta_key);
+                mean_delta += this_delta/num_neighbours;
             }
-            cell_iter->GetCellData()->SetItem("mean delta", mean_delta);
+            cell_iter->GetCellData()->SetItem(mean_delta_key, mean_delta);
         }
         else
         {
             // If this cell has no neighbours, such as an isolated cell in a CaBasedCellPopulation, store 0.0 for the cell data
-            cell_iter->GetCellData()->SetItem("mean delta", 0.0);
+            cell_iter->GetCellData()->SetItem(mean_delta_key, 0.0);
         }
     }
 }
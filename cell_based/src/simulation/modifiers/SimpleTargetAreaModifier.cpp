@@ -118,7 +118,7 @@ void SimpleTargetAreaModifier<DIM>::UpdateTargetAreaOfCell(CellPtr pCell)
     }
 
     // Set cell data
-    pCell->GetCellData()->SetItem("target area", cell_target_area);
+    pCell->GetCellData()->SetItem(this->mTargetAreaKey, cell_target_area);
 }
 
 template<unsigned DIM>
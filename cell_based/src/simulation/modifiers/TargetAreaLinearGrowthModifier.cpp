@@ -128,7 +128,7 @@ void TargetAreaLinearGrowthModifier<DIM>::UpdateTargetAreaOfCell(CellPtr pCell)
     }
 
     // Set cell data
-    pCell->GetCellData()->SetItem("target area", cell_target_area);
+    pCell->GetCellData()->SetItem(this->mTargetAreaKey, cell_target_area);
 }
 
 template<unsigned DIM>
@@ -83,6 +83,9 @@ void VolumeTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,DIM>
         static_cast<MeshBasedCellPopulation<DIM>*>(&(rCellPopulation))->CreateVoronoiTessellation();
     }
 
+    // Look up the key of the cell volume once, rather than for every cell
+    static const CellDataKey volume_key("volume");
+
     // Iterate over cell population
     for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
          cell_iter != rCellPopulation.End();
@@ -92,7 +95,7 @@ void VolumeTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,DIM>
         double cell_volume = rCellPopulation.GetVolumeOfCell(*cell_iter);
 
         // Store the cell's volume in CellData
-        cell_iter->GetCellData()->SetItem("volume", cell_volume);
+        cell_iter->GetCellData()->SetItem(volume_key, cell_volume);
     }
 }
 
@@ -41,16 +41,18 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NodeBasedCellPopulationWithBuskeUpdate.hpp"
 #include "MeshBasedCellPopulationWithGhostNodes.hpp"
 #include "CellBasedEventHandler.hpp"
+#include "CellBasedProfiler.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::AbstractNumericalMethod()
     : mpCellPopulation(NULL),
       mpForceCollection(NULL),
+      mpBoundaryConditions(NULL),
       mUseAdaptiveTimestep(false),
       mUseUpdateNodeLocation(false),
       mGhostNodeForcesEnabled(true)
 {
-    // mpCellPopulation and mpForceCollection are initialized by the OffLatticeSimulation constructor
+    // mpCellPopulation, mpForceCollection and mpBoundaryConditions are initialized by OffLatticeSimulation::SetupSolve()
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -86,6 +88,12 @@ void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetForceCollection(std::vec
     mpForceCollection = pForces;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetBoundaryConditions(std::vector<boost::shared_ptr<AbstractCellPopulationBoundaryCondition<ELEMENT_DIM, SPACE_DIM> > >* pBoundaryConditions)
+{
+    mpBoundaryConditions = pBoundaryConditions;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetUseAdaptiveTimestep(bool useAdaptiveTimestep)
 {
@@ -112,7 +120,9 @@ std::vector<c_vector<double, SPACE_DIM> > AbstractNumericalMethod<ELEMENT_DIM,SP
     for (typename std::vector<boost::shared_ptr<AbstractForce<ELEMENT_DIM, SPACE_DIM> > >::iterator iter = mpForceCollection->begin();
         iter != mpForceCollection->end(); ++iter)
     {
+        unsigned timer = CellBasedProfiler::Instance()->BeginTimer("Force", iter->get());
         (*iter)->AddForceContribution(*mpCellPopulation);
+        CellBasedProfiler::Instance()->EndTimer(timer);
     }
 
     /**
@@ -165,6 +175,68 @@ void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SafeNodePositionUpdate( uns
     mpCellPopulation->SetNode(nodeIndex, new_point);
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetAllNodeLocations(const std::vector<c_vector<double, SPACE_DIM> >& rNewLocations)
+{
+    unsigned index = 0;
+    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+         node_iter != mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+         ++node_iter, ++index)
+    {
+        SafeNodePositionUpdate(node_iter->GetIndex(), rNewLocations[index]);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::ImposeBoundaryConditions(const std::vector<c_vector<double, SPACE_DIM> >& rOldLocations)
+{
+    if (mpBoundaryConditions == NULL || mpBoundaryConditions->empty())
+    {
+        return false;
+    }
+
+    // The boundary conditions expect the old locations keyed by node
+    std::map<Node<SPACE_DIM>*, c_vector<double, SPACE_DIM> > old_node_locations;
+    unsigned index = 0;
+    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+         node_iter != mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+         ++node_iter, ++index)
+    {
+        old_node_locations[&(*node_iter)] = rOldLocations[index];
+    }
+
+    std::vector<c_vector<double, SPACE_DIM> > unconstrained_locations = SaveCurrentLocations();
+
+    for (typename std::vector<boost::shared_ptr<AbstractCellPopulationBoundaryCondition<ELEMENT_DIM,SPACE_DIM> > >::iterator bcs_iter = mpBoundaryConditions->begin();
+         bcs_iter != mpBoundaryConditions->end();
+         ++bcs_iter)
+    {
+        (*bcs_iter)->ImposeBoundaryCondition(old_node_locations);
+    }
+
+    for (typename std::vector<boost::shared_ptr<AbstractCellPopulationBoundaryCondition<ELEMENT_DIM,SPACE_DIM> > >::iterator bcs_iter = mpBoundaryConditions->begin();
+         bcs_iter != mpBoundaryConditions->end();
+         ++bcs_iter)
+    {
+        if (!((*bcs_iter)->VerifyBoundaryCondition()))
+        {
+            EXCEPTION("The cell population boundary conditions are incompatible.");
+        }
+    }
+
+    index = 0;
+    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+         node_iter != mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+         ++node_iter, ++index)
+    {
+        if (norm_inf(node_iter->rGetLocation() - unconstrained_locations[index]) > 0.0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::DetectStepSizeExceptions(unsigned nodeIndex, c_vector<double,SPACE_DIM>& displacement, double dt)
 {    
@@ -43,6 +43,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractOffLatticeCellPopulation.hpp"
 #include "AbstractForce.hpp"
+#include "AbstractCellPopulationBoundaryCondition.hpp"
 
 /**
  * An abstract class representing a numerical method for off lattice cell based simulations.
@@ -83,6 +84,9 @@ protected:
     /** Pointer to the force collection to apply*/
     std::vector<boost::shared_ptr<AbstractForce<ELEMENT_DIM, SPACE_DIM> > >* mpForceCollection;
 
+    /** Pointer to the boundary conditions to impose, or NULL if none have been set */
+    std::vector<boost::shared_ptr<AbstractCellPopulationBoundaryCondition<ELEMENT_DIM, SPACE_DIM> > >* mpBoundaryConditions;
+
     /**
      * Whether the numerical method uses an adaptive time step.
      * Initialized to false in the AbstractNumericalMethod constructor.
@@ -126,6 +130,25 @@ protected:
      */
      void SafeNodePositionUpdate(unsigned nodeIndex, c_vector<double, SPACE_DIM> newPosition);
 
+    /**
+     * Moves every node to the given location, taking into account periodic boundary conditions.
+     * Used by methods that evaluate forces at intermediate positions.
+     *
+     * @param rNewLocations the new location of each node, in the order given by SaveCurrentLocations()
+     */
+    void SetAllNodeLocations(const std::vector<c_vector<double, SPACE_DIM> >& rNewLocations);
+
+    /**
+     * Imposes each of the simulation's boundary conditions on the current node locations, then
+     * checks that they are all satisfied. Used by methods that take several substeps per time step,
+     * so that no substep starts from a configuration that violates the boundary conditions.
+     *
+     * @param rOldLocations the location of each node at the start of the substep, in the order
+     *     given by SaveCurrentLocations()
+     * @return whether any node was moved
+     */
+    bool ImposeBoundaryConditions(const std::vector<c_vector<double, SPACE_DIM> >& rOldLocations);
+
     /**
      * Detects whether a node has exceeded the acceptable displacement for one timestep.
      * If a step size exception has occurred, it either causes the simulation to terminate or,
@@ -166,6 +189,13 @@ public:
      */
     void SetForceCollection(std::vector<boost::shared_ptr<AbstractForce<ELEMENT_DIM, SPACE_DIM> > >* pForces);
 
+    /**
+     * Sets the pointer to the boundary conditions imposed by this method between substeps
+     *
+     * @param pBoundaryConditions Pointer to the simulation's boundary conditions
+     */
+    void SetBoundaryConditions(std::vector<boost::shared_ptr<AbstractCellPopulationBoundaryCondition<ELEMENT_DIM, SPACE_DIM> > >* pBoundaryConditions);
+
     /**
      * Set mUseAdaptiveTimestep.
      *
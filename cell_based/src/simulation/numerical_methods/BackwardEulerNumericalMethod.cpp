@@ -0,0 +1,300 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "BackwardEulerNumericalMethod.hpp"
+
+#include <cfloat>
+#include <cmath>
+
+/**
+ * @return the dot product of two vectors of node displacements
+ *
+ * @param rA the first vector
+ * @param rB the second vector
+ */
+template<unsigned SPACE_DIM>
+static double DotProduct(const std::vector<c_vector<double, SPACE_DIM> >& rA, const std::vector<c_vector<double, SPACE_DIM> >& rB)
+{
+    double result = 0.0;
+    for (unsigned i=0; i<rA.size(); i++)
+    {
+        result += inner_prod(rA[i], rB[i]);
+    }
+    return result;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::BackwardEulerNumericalMethod()
+    : AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>(),
+      mMaxNewtonIterations(1),
+      mMaxKrylovIterations(20),
+      mSolverTolerance(1e-6)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::~BackwardEulerNumericalMethod()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(double dt)
+{
+    if (this->mUseUpdateNodeLocation)
+    {
+        // See ForwardEulerNumericalMethod: this only applies to NodeBasedCellPopulationWithBuskeUpdates
+        this->mpCellPopulation->UpdateNodeLocations(dt);
+        return;
+    }
+
+    std::vector<c_vector<double, SPACE_DIM> > old_locations = this->SaveCurrentLocations();
+    std::vector<c_vector<double, SPACE_DIM> > new_locations = old_locations;
+    std::vector<c_vector<double, SPACE_DIM> > forces = this->ComputeForcesIncludingDamping();
+    unsigned num_nodes = old_locations.size();
+
+    std::vector<c_vector<double, SPACE_DIM> > minus_residual(num_nodes);
+    for (unsigned iteration=0; iteration<mMaxNewtonIterations; iteration++)
+    {
+        if (iteration > 0)
+        {
+            forces = this->ComputeForcesIncludingDamping();
+        }
+
+        // The residual of the scheme is G = r - r^t - dt F(r)
+        double residual = 0.0;
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            minus_residual[i] = old_locations[i] + dt*forces[i] - new_locations[i];
+            residual = std::max(residual, norm_inf(minus_residual[i]));
+        }
+        if (residual <= mSolverTolerance)
+        {
+            break;
+        }
+
+        std::vector<c_vector<double, SPACE_DIM> > correction = SolveLinearSystem(new_locations, forces, minus_residual, dt);
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            new_locations[i] += correction[i];
+        }
+        this->SetAllNodeLocations(new_locations);
+    }
+
+    unsigned index = 0;
+    for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+         node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+         ++node_iter, ++index)
+    {
+        c_vector<double, SPACE_DIM> displacement = new_locations[index] - old_locations[index];
+
+        // In the vertex-based case, the displacement may be scaled if the cell rearrangement threshold is exceeded
+        this->DetectStepSizeExceptions(node_iter->GetIndex(), displacement, dt);
+
+        this->SafeNodePositionUpdate(node_iter->GetIndex(), old_locations[index] + displacement);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<c_vector<double, SPACE_DIM> > BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SolveLinearSystem(const std::vector<c_vector<double, SPACE_DIM> >& rLocations,
+                                                                                                                const std::vector<c_vector<double, SPACE_DIM> >& rForces,
+                                                                                                                const std::vector<c_vector<double, SPACE_DIM> >& rRhs,
+                                                                                                                double dt)
+{
+    unsigned num_nodes = rRhs.size();
+    std::vector<c_vector<double, SPACE_DIM> > solution(num_nodes, zero_vector<double>(SPACE_DIM));
+
+    double rhs_norm = sqrt(DotProduct<SPACE_DIM>(rRhs, rRhs));
+    if (rhs_norm == 0.0)
+    {
+        return solution;
+    }
+    double locations_norm = sqrt(DotProduct<SPACE_DIM>(rLocations, rLocations));
+
+    // GMRES from a zero initial guess, with the Arnoldi basis in basis and the Hessenberg matrix reduced by Givens rotations
+    unsigned max_iterations = mMaxKrylovIterations;
+    std::vector<std::vector<c_vector<double, SPACE_DIM> > > basis(1, rRhs);
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        basis[0][i] /= rhs_norm;
+    }
+    std::vector<std::vector<double> > hessenberg(max_iterations, std::vector<double>(max_iterations + 1, 0.0));
+    std::vector<double> cosines(max_iterations);
+    std::vector<double> sines(max_iterations);
+    std::vector<double> reduced_rhs(max_iterations + 1, 0.0);
+    reduced_rhs[0] = rhs_norm;
+
+    std::vector<c_vector<double, SPACE_DIM> > perturbed_locations(num_nodes);
+    unsigned num_iterations = 0;
+    for (unsigned j=0; j<max_iterations; j++)
+    {
+        // Apply (I - dt J) to the latest basis vector, approximating J v by a finite difference of the forces
+        const std::vector<c_vector<double, SPACE_DIM> >& r_v = basis[j];
+        double epsilon = sqrt(DBL_EPSILON)*(1.0 + locations_norm);
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            perturbed_locations[i] = rLocations[i] + epsilon*r_v[i];
+        }
+        this->SetAllNodeLocations(perturbed_locations);
+        std::vector<c_vector<double, SPACE_DIM> > perturbed_forces = this->ComputeForcesIncludingDamping();
+
+        std::vector<c_vector<double, SPACE_DIM> > w(num_nodes);
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            w[i] = r_v[i] - (dt/epsilon)*(perturbed_forces[i] - rForces[i]);
+        }
+
+        // Modified Gram-Schmidt
+        for (unsigned k=0; k<=j; k++)
+        {
+            hessenberg[j][k] = DotProduct<SPACE_DIM>(w, basis[k]);
+            for (unsigned i=0; i<num_nodes; i++)
+            {
+                w[i] -= hessenberg[j][k]*basis[k][i];
+            }
+        }
+        double w_norm = sqrt(DotProduct<SPACE_DIM>(w, w));
+        hessenberg[j][j+1] = w_norm;
+
+        for (unsigned k=0; k<j; k++)
+        {
+            double temp = cosines[k]*hessenberg[j][k] + sines[k]*hessenberg[j][k+1];
+            hessenberg[j][k+1] = -sines[k]*hessenberg[j][k] + cosines[k]*hessenberg[j][k+1];
+            hessenberg[j][k] = temp;
+        }
+        double denominator = sqrt(hessenberg[j][j]*hessenberg[j][j] + w_norm*w_norm);
+        cosines[j] = hessenberg[j][j]/denominator;
+        sines[j] = w_norm/denominator;
+        hessenberg[j][j] = denominator;
+        hessenberg[j][j+1] = 0.0;
+        reduced_rhs[j+1] = -sines[j]*reduced_rhs[j];
+        reduced_rhs[j] *= cosines[j];
+
+        num_iterations = j + 1;
+        if (fabs(reduced_rhs[j+1]) <= mSolverTolerance*rhs_norm || w_norm == 0.0)
+        {
+            break;
+        }
+
+        basis.push_back(w);
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            basis[j+1][i] /= w_norm;
+        }
+    }
+
+    // Back substitution for the coefficients of the basis vectors
+    std::vector<double> coefficients(num_iterations);
+    for (unsigned k=num_iterations; k-- > 0; )
+    {
+        double sum = reduced_rhs[k];
+        for (unsigned l=k+1; l<num_iterations; l++)
+        {
+            sum -= hessenberg[l][k]*coefficients[l];
+        }
+        coefficients[k] = sum/hessenberg[k][k];
+    }
+
+    for (unsigned k=0; k<num_iterations; k++)
+    {
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            solution[i] += coefficients[k]*basis[k][i];
+        }
+    }
+    return solution;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetMaxNewtonIterations(unsigned maxNewtonIterations)
+{
+    assert(maxNewtonIterations > 0);
+    mMaxNewtonIterations = maxNewtonIterations;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetMaxNewtonIterations()
+{
+    return mMaxNewtonIterations;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetMaxKrylovIterations(unsigned maxKrylovIterations)
+{
+    assert(maxKrylovIterations > 0);
+    mMaxKrylovIterations = maxKrylovIterations;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetMaxKrylovIterations()
+{
+    return mMaxKrylovIterations;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetSolverTolerance(double solverTolerance)
+{
+    assert(solverTolerance > 0.0);
+    mSolverTolerance = solverTolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetSolverTolerance()
+{
+    return mSolverTolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void BackwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<MaxNewtonIterations>" << mMaxNewtonIterations << "</MaxNewtonIterations> \n";
+    *rParamsFile << "\t\t\t<MaxKrylovIterations>" << mMaxKrylovIterations << "</MaxKrylovIterations> \n";
+    *rParamsFile << "\t\t\t<SolverTolerance>" << mSolverTolerance << "</SolverTolerance> \n";
+
+    // Call method on direct parent class
+    AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class BackwardEulerNumericalMethod<1,1>;
+template class BackwardEulerNumericalMethod<1,2>;
+template class BackwardEulerNumericalMethod<2,2>;
+template class BackwardEulerNumericalMethod<1,3>;
+template class BackwardEulerNumericalMethod<2,3>;
+template class BackwardEulerNumericalMethod<3,3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(BackwardEulerNumericalMethod)
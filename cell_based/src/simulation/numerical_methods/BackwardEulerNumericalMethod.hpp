@@ -0,0 +1,184 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef BACKWARDEULERNUMERICALMETHOD_HPP_
+#define BACKWARDEULERNUMERICALMETHOD_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractNumericalMethod.hpp"
+
+/**
+ * Implements backward Euler time stepping.
+ *
+ * Solves the equations of motion dr/dt = F using the scheme
+ *
+ * r^(t+1) = r^t + dt F^(t+1),
+ *
+ * which remains stable for stiff forces at time steps far larger than forward
+ * Euler allows. The nonlinear equations are solved by Newton's method, starting
+ * from r^t. Each Newton step solves (I - dt J) d = -G, where G is the residual
+ * of the scheme and J is the Jacobian of the forces, by GMRES without forming J:
+ * each product J v is approximated by a finite difference of two evaluations of
+ * the force collection.
+ *
+ * By default a single Newton step is taken, which gives the linearly implicit
+ * (semi-implicit) Euler method. This is exact for linear forces and has the same
+ * stability. More Newton steps may be requested with SetMaxNewtonIterations().
+ *
+ * In parallel, each process solves for its own nodes with the halo nodes held
+ * fixed.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM=ELEMENT_DIM>
+class BackwardEulerNumericalMethod : public AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> {
+
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /**
+     * Save or restore the simulation.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> >(*this);
+        archive & mMaxNewtonIterations;
+        archive & mMaxKrylovIterations;
+        archive & mSolverTolerance;
+    }
+
+    /** The largest number of Newton steps in each time step. Defaults to 1. */
+    unsigned mMaxNewtonIterations;
+
+    /** The largest number of GMRES iterations in each Newton step. Defaults to 20. */
+    unsigned mMaxKrylovIterations;
+
+    /**
+     * The tolerance of the solvers. Newton's method stops once no node's residual exceeds it,
+     * and GMRES stops once the norm of its residual has been reduced by this factor.
+     * Defaults to 1e-6.
+     */
+    double mSolverTolerance;
+
+    /**
+     * Approximately solve (I - dt J) x = b by GMRES, where J is the Jacobian of the forces
+     * at the current node locations.
+     *
+     * @param rLocations the current node locations
+     * @param rForces the forces (including damping) at the current node locations
+     * @param rRhs the right-hand side b
+     * @param dt the time step
+     * @return the solution x
+     */
+    std::vector<c_vector<double, SPACE_DIM> > SolveLinearSystem(const std::vector<c_vector<double, SPACE_DIM> >& rLocations,
+                                                                const std::vector<c_vector<double, SPACE_DIM> >& rForces,
+                                                                const std::vector<c_vector<double, SPACE_DIM> >& rRhs,
+                                                                double dt);
+
+public:
+
+    /**
+     * Constructor.
+     */
+    BackwardEulerNumericalMethod();
+
+    /**
+     * Destructor.
+     */
+    virtual ~BackwardEulerNumericalMethod();
+
+    /**
+     * Overridden UpdateAllNodePositions() method.
+     *
+     * @param dt Time step size
+     */
+    void UpdateAllNodePositions(double dt);
+
+    /**
+     * Set mMaxNewtonIterations.
+     *
+     * @param maxNewtonIterations the largest number of Newton steps in each time step
+     */
+    void SetMaxNewtonIterations(unsigned maxNewtonIterations);
+
+    /**
+     * @return mMaxNewtonIterations.
+     */
+    unsigned GetMaxNewtonIterations();
+
+    /**
+     * Set mMaxKrylovIterations.
+     *
+     * @param maxKrylovIterations the largest number of GMRES iterations in each Newton step
+     */
+    void SetMaxKrylovIterations(unsigned maxKrylovIterations);
+
+    /**
+     * @return mMaxKrylovIterations.
+     */
+    unsigned GetMaxKrylovIterations();
+
+    /**
+     * Set mSolverTolerance.
+     *
+     * @param solverTolerance the tolerance of the solvers
+     */
+    void SetSolverTolerance(double solverTolerance);
+
+    /**
+     * @return mSolverTolerance.
+     */
+    double GetSolverTolerance();
+
+    /**
+     * Overridden OutputNumericalMethodParameters() method.
+     *
+     * @param rParamsFile Reference to the parameter output filestream
+     */
+    virtual void OutputNumericalMethodParameters(out_stream& rParamsFile);
+};
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(BackwardEulerNumericalMethod)
+
+#endif /*BACKWARDEULERNUMERICALMETHOD_HPP_*/
@@ -0,0 +1,239 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "RungeKutta23NumericalMethod.hpp"
+#include "StepSizeException.hpp"
+#include "Exception.hpp"
+
+#include <cmath>
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+RungeKutta23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::RungeKutta23NumericalMethod()
+    : AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>(),
+      mAbsoluteTolerance(1e-3),
+      mCurrentStep(0.0)
+{
+    this->mUseAdaptiveTimestep = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+RungeKutta23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::~RungeKutta23NumericalMethod()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void RungeKutta23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(double dt)
+{
+    if (this->mUseUpdateNodeLocation)
+    {
+        // See ForwardEulerNumericalMethod: this only applies to NodeBasedCellPopulationWithBuskeUpdates
+        this->mpCellPopulation->UpdateNodeLocations(dt);
+        return;
+    }
+
+    // The largest and smallest factors by which a substep may change, and the safety factor applied to the error estimate
+    const double max_growth = 5.0;
+    const double min_growth = 0.2;
+    const double safety = 0.9;
+
+    std::vector<c_vector<double, SPACE_DIM> > old_locations = this->SaveCurrentLocations();
+    std::vector<c_vector<double, SPACE_DIM> > k1 = this->ComputeForcesIncludingDamping();
+    unsigned num_nodes = old_locations.size();
+
+    std::vector<c_vector<double, SPACE_DIM> > stage_locations(num_nodes);
+    std::vector<c_vector<double, SPACE_DIM> > new_locations(num_nodes);
+
+    double proposed_step = (mCurrentStep > 0.0) ? mCurrentStep : dt;
+    double time_advanced_so_far = 0.0;
+
+    while (time_advanced_so_far < dt)
+    {
+        // Take the remainder of the time step if the proposed substep would (nearly) reach it
+        double time_remaining = dt - time_advanced_so_far;
+        double h = proposed_step;
+        bool is_last_substep = false;
+        if (h >= time_remaining*(1.0 - 1e-10))
+        {
+            h = time_remaining;
+            is_last_substep = true;
+        }
+
+        if (!is_last_substep && h < 1e-10*dt)
+        {
+            EXCEPTION("RungeKutta23NumericalMethod could not find a small enough substep to meet the tolerance");
+        }
+
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            stage_locations[i] = old_locations[i] + 0.5*h*k1[i];
+        }
+        this->SetAllNodeLocations(stage_locations);
+        std::vector<c_vector<double, SPACE_DIM> > k2 = this->ComputeForcesIncludingDamping();
+
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            stage_locations[i] = old_locations[i] + 0.75*h*k2[i];
+        }
+        this->SetAllNodeLocations(stage_locations);
+        std::vector<c_vector<double, SPACE_DIM> > k3 = this->ComputeForcesIncludingDamping();
+
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            new_locations[i] = old_locations[i] + h*((2.0/9.0)*k1[i] + (1.0/3.0)*k2[i] + (4.0/9.0)*k3[i]);
+        }
+        this->SetAllNodeLocations(new_locations);
+        std::vector<c_vector<double, SPACE_DIM> > k4 = this->ComputeForcesIncludingDamping();
+
+        // The difference between the third and second order solutions estimates the error
+        double error = 0.0;
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            c_vector<double, SPACE_DIM> node_error = h*((-5.0/72.0)*k1[i] + (1.0/12.0)*k2[i] + (1.0/9.0)*k3[i] - 0.125*k4[i]);
+            error = std::max(error, norm_inf(node_error));
+        }
+
+        double growth = max_growth;
+        if (error > 0.0)
+        {
+            growth = std::min(max_growth, std::max(min_growth, safety*pow(mAbsoluteTolerance/error, 1.0/3.0)));
+        }
+
+        bool is_accepted = (error <= mAbsoluteTolerance);
+        bool was_displacement_altered = false;
+
+        if (is_accepted)
+        {
+            // The population may veto the substep, or alter displacements in the vertex-based case
+            try
+            {
+                unsigned index = 0;
+                for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+                     node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+                     ++node_iter, ++index)
+                {
+                    c_vector<double, SPACE_DIM> displacement = new_locations[index] - old_locations[index];
+                    this->DetectStepSizeExceptions(node_iter->GetIndex(), displacement, h);
+
+                    c_vector<double, SPACE_DIM> altered_location = old_locations[index] + displacement;
+                    if (norm_inf(altered_location - new_locations[index]) > 0.0)
+                    {
+                        new_locations[index] = altered_location;
+                        this->SafeNodePositionUpdate(node_iter->GetIndex(), altered_location);
+                        was_displacement_altered = true;
+                    }
+                }
+            }
+            catch (StepSizeException& e)
+            {
+                is_accepted = false;
+                growth = std::min(growth, e.GetSuggestedNewStep()/h);
+            }
+        }
+
+        if (is_accepted)
+        {
+            // Impose the boundary conditions on every accepted substep, so the next one starts from a valid configuration
+            if (this->ImposeBoundaryConditions(old_locations))
+            {
+                new_locations = this->SaveCurrentLocations();
+                was_displacement_altered = true;
+            }
+
+            time_advanced_so_far = is_last_substep ? dt : time_advanced_so_far + h;
+            old_locations.swap(new_locations);
+
+            // The last stage is the first stage of the next substep, unless the population moved any nodes itself
+            if (was_displacement_altered)
+            {
+                k1 = this->ComputeForcesIncludingDamping();
+            }
+            else
+            {
+                k1.swap(k4);
+            }
+
+            // A substep shortened to reach the end of the time step should not shrink the next one
+            proposed_step = is_last_substep ? std::max(proposed_step, growth*h) : growth*h;
+        }
+        else
+        {
+            this->SetAllNodeLocations(old_locations);
+            proposed_step = growth*h;
+        }
+    }
+
+    mCurrentStep = proposed_step;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void RungeKutta23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetAbsoluteTolerance(double absoluteTolerance)
+{
+    assert(absoluteTolerance > 0.0);
+    mAbsoluteTolerance = absoluteTolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double RungeKutta23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetAbsoluteTolerance()
+{
+    return mAbsoluteTolerance;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double RungeKutta23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetCurrentStep()
+{
+    return mCurrentStep;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void RungeKutta23NumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<AbsoluteTolerance>" << mAbsoluteTolerance << "</AbsoluteTolerance> \n";
+
+    // Call method on direct parent class
+    AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::OutputNumericalMethodParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class RungeKutta23NumericalMethod<1,1>;
+template class RungeKutta23NumericalMethod<1,2>;
+template class RungeKutta23NumericalMethod<2,2>;
+template class RungeKutta23NumericalMethod<1,3>;
+template class RungeKutta23NumericalMethod<2,3>;
+template class RungeKutta23NumericalMethod<3,3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(RungeKutta23NumericalMethod)
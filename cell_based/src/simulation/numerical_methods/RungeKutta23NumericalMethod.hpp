@@ -0,0 +1,149 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef RUNGEKUTTA23NUMERICALMETHOD_HPP_
+#define RUNGEKUTTA23NUMERICALMETHOD_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractNumericalMethod.hpp"
+
+/**
+ * Implements the embedded Runge-Kutta method of Bogacki and Shampine with error control.
+ *
+ * Solves the equations of motion dr/dt = F by taking as many substeps as needed
+ * to cover each time step dt. Each substep h uses the third order scheme
+ *
+ * k1 = F(r^t), k2 = F(r^t + h k1/2), k3 = F(r^t + 3h k2/4),
+ * r^(t+h) = r^t + h (2 k1 + 3 k2 + 4 k3)/9,
+ *
+ * and compares it with an embedded second order scheme, which also uses
+ * k4 = F(r^(t+h)), to estimate the error. A substep is rejected if the
+ * largest error in any node's displacement exceeds the absolute tolerance,
+ * or if the cell population reports a step size exception; it is then
+ * retried with a smaller substep. After each accepted substep the substep
+ * size is grown again, by up to a factor of five, and the size reached is
+ * remembered for the next time step. Since k4 is the first stage of the
+ * next substep, each substep costs three force evaluations. The simulation's
+ * boundary conditions are imposed after every accepted substep, so that no
+ * substep evaluates forces on a configuration that violates them.
+ *
+ * Cell birth and death are still only considered once per time step, by
+ * the simulation, so a simulation can use a time step much larger than the
+ * stiffest force would allow with forward Euler and let this method take
+ * the substeps that the forces need.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM=ELEMENT_DIM>
+class RungeKutta23NumericalMethod : public AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> {
+
+    friend class TestNumericalMethods;
+
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /**
+     * Save or restore the simulation.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM> >(*this);
+        archive & mAbsoluteTolerance;
+        archive & mCurrentStep;
+    }
+
+    /** The largest error allowed in the displacement of any node in one substep. Defaults to 1e-3. */
+    double mAbsoluteTolerance;
+
+    /** The substep size to try next, or zero if no substep has been taken yet. */
+    double mCurrentStep;
+
+public:
+
+    /**
+     * Constructor. Adaptive time stepping is switched on, so that step size
+     * exceptions cause a substep to be retried rather than a warning.
+     */
+    RungeKutta23NumericalMethod();
+
+    /**
+     * Destructor.
+     */
+    virtual ~RungeKutta23NumericalMethod();
+
+    /**
+     * Overridden UpdateAllNodePositions() method.
+     *
+     * @param dt Time step size
+     */
+    void UpdateAllNodePositions(double dt);
+
+    /**
+     * Set mAbsoluteTolerance.
+     *
+     * @param absoluteTolerance the largest error allowed in the displacement of any node in one substep
+     */
+    void SetAbsoluteTolerance(double absoluteTolerance);
+
+    /**
+     * @return mAbsoluteTolerance.
+     */
+    double GetAbsoluteTolerance();
+
+    /**
+     * @return the substep size that will be tried first in the next time step (zero before the first time step).
+     */
+    double GetCurrentStep();
+
+    /**
+     * Overridden OutputNumericalMethodParameters() method.
+     *
+     * @param rParamsFile Reference to the parameter output filestream
+     */
+    virtual void OutputNumericalMethodParameters(out_stream& rParamsFile);
+};
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(RungeKutta23NumericalMethod)
+
+#endif /*RUNGEKUTTA23NUMERICALMETHOD_HPP_*/
@@ -0,0 +1,391 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "Hdf5CellDataConverter.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include "Exception.hpp"
+#include "PetscTools.hpp"
+#include "NodesOnlyMesh.hpp"
+#include "VtkMeshWriter.hpp"
+
+/** The fixed length of the strings in the "Variable Details" attribute (as in Hdf5CellDataWriter). */
+static const unsigned HDF5_CELL_DATA_MAX_STRING_SIZE = 100;
+
+/**
+ * Helper function to read a whole dataset from an HDF5 group.
+ *
+ * @param groupId the group containing the dataset
+ * @param rName the name of the dataset
+ * @param memoryType the HDF5 type in which to read the data
+ * @param rValues filled with the data, stored row by row
+ * @return the number of columns (cells) in the dataset
+ */
+template<typename T>
+static unsigned ReadHdf5CellDataColumns(hid_t groupId, const std::string& rName, hid_t memoryType, std::vector<T>& rValues)
+{
+    hid_t dataset_id = H5Dopen(groupId, rName.c_str(), H5P_DEFAULT);
+    hid_t dataspace = H5Dget_space(dataset_id);
+    hsize_t dims[2];
+    H5Sget_simple_extent_dims(dataspace, dims, NULL);
+    H5Sclose(dataspace);
+
+    rValues.resize(dims[0]*dims[1]);
+    if (!rValues.empty())
+    {
+        H5Dread(dataset_id, memoryType, H5S_ALL, H5S_ALL, H5P_DEFAULT, &rValues[0]);
+    }
+    H5Dclose(dataset_id);
+
+    return dims[1];
+}
+
+/**
+ * @return the name of the group holding a given time step.
+ * @param timeStep the index of the time step
+ */
+static std::string GetHdf5CellDataGroupName(unsigned timeStep)
+{
+    std::stringstream group_name;
+    group_name << "TimeStep_" << timeStep;
+    return group_name.str();
+}
+
+template<unsigned DIM>
+Hdf5CellDataConverter<DIM>::Hdf5CellDataConverter(const FileFinder& rH5File)
+{
+    if (!rH5File.IsFile())
+    {
+        EXCEPTION("Hdf5CellDataConverter could not find " << rH5File.GetAbsolutePath());
+    }
+
+    mFileId = H5Fopen(rH5File.GetAbsolutePath().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (mFileId < 0)
+    {
+        EXCEPTION("Hdf5CellDataConverter could not open " << rH5File.GetAbsolutePath() << " , H5Fopen error code = " << mFileId);
+    }
+
+    // Check the file was written by a population of the same spatial dimension
+    unsigned space_dim = 0;
+    if (H5Aexists(mFileId, "SpaceDimension") > 0)
+    {
+        hid_t attr = H5Aopen_name(mFileId, "SpaceDimension");
+        H5Aread(attr, H5T_NATIVE_UINT, &space_dim);
+        H5Aclose(attr);
+    }
+    if (space_dim != DIM)
+    {
+        H5Fclose(mFileId);
+        EXCEPTION("The file " << rH5File.GetAbsolutePath() << " does not contain cell data of dimension " << DIM);
+    }
+
+    // Read the time of each time step
+    for (unsigned time_step=0; H5Lexists(mFileId, GetHdf5CellDataGroupName(time_step).c_str(), H5P_DEFAULT) > 0; time_step++)
+    {
+        hid_t group_id = H5Gopen(mFileId, GetHdf5CellDataGroupName(time_step).c_str(), H5P_DEFAULT);
+        hid_t attr = H5Aopen_name(group_id, "Time");
+        double time;
+        H5Aread(attr, H5T_NATIVE_DOUBLE, &time);
+        H5Aclose(attr);
+
+        // The variable names are the same for every time step, so read them from the first
+        if (time_step == 0 && H5Lexists(group_id, "Data", H5P_DEFAULT) > 0)
+        {
+            hid_t data_id = H5Dopen(group_id, "Data", H5P_DEFAULT);
+            hid_t names_attr = H5Aopen_name(data_id, "Variable Details");
+            hid_t names_space = H5Aget_space(names_attr);
+            unsigned num_variables = H5Sget_simple_extent_npoints(names_space);
+
+            hid_t string_type = H5Tcopy(H5T_C_S1);
+            H5Tset_size(string_type, HDF5_CELL_DATA_MAX_STRING_SIZE);
+            std::vector<char> names(num_variables*HDF5_CELL_DATA_MAX_STRING_SIZE);
+            H5Aread(names_attr, string_type, &names[0]);
+            for (unsigned var=0; var<num_variables; var++)
+            {
+                mVariableNames.push_back(std::string(&names[var*HDF5_CELL_DATA_MAX_STRING_SIZE]));
+            }
+
+            H5Tclose(string_type);
+            H5Sclose(names_space);
+            H5Aclose(names_attr);
+            H5Dclose(data_id);
+        }
+
+        H5Gclose(group_id);
+        mTimes.push_back(time);
+    }
+}
+
+template<unsigned DIM>
+Hdf5CellDataConverter<DIM>::~Hdf5CellDataConverter()
+{
+    H5Fclose(mFileId);
+}
+
+template<unsigned DIM>
+unsigned Hdf5CellDataConverter<DIM>::GetNumTimeSteps()
+{
+    return mTimes.size();
+}
+
+template<unsigned DIM>
+const std::vector<double>& Hdf5CellDataConverter<DIM>::rGetTimes()
+{
+    return mTimes;
+}
+
+template<unsigned DIM>
+const std::vector<std::string>& Hdf5CellDataConverter<DIM>::rGetVariableNames()
+{
+    return mVariableNames;
+}
+
+template<unsigned DIM>
+void Hdf5CellDataConverter<DIM>::ReadTimeStep(unsigned timeStep,
+                                              std::vector<unsigned>& rCellIds,
+                                              std::vector<unsigned>& rLocationIndices,
+                                              std::vector<c_vector<double, DIM> >& rLocations,
+                                              std::vector<std::vector<double> >& rData)
+{
+    if (timeStep >= mTimes.size())
+    {
+        EXCEPTION("Time step " << timeStep << " is not in the file, which has " << mTimes.size() << " time steps.");
+    }
+
+    hid_t group_id = H5Gopen(mFileId, GetHdf5CellDataGroupName(timeStep).c_str(), H5P_DEFAULT);
+
+    unsigned num_cells = ReadHdf5CellDataColumns(group_id, "CellId", H5T_NATIVE_UINT, rCellIds);
+    ReadHdf5CellDataColumns(group_id, "LocationIndex", H5T_NATIVE_UINT, rLocationIndices);
+
+    std::vector<double> locations;
+    ReadHdf5CellDataColumns(group_id, "Location", H5T_NATIVE_DOUBLE, locations);
+    rLocations.resize(num_cells);
+    for (unsigned i=0; i<num_cells; i++)
+    {
+        for (unsigned d=0; d<DIM; d++)
+        {
+            rLocations[i][d] = locations[d*num_cells + i];
+        }
+    }
+
+    rData.assign(mVariableNames.size(), std::vector<double>(num_cells));
+    if (!mVariableNames.empty())
+    {
+        std::vector<double> data;
+        ReadHdf5CellDataColumns(group_id, "Data", H5T_NATIVE_DOUBLE, data);
+        for (unsigned var=0; var<mVariableNames.size(); var++)
+        {
+            std::copy(data.begin() + var*num_cells, data.begin() + (var+1)*num_cells, rData[var].begin());
+        }
+    }
+
+    H5Gclose(group_id);
+}
+
+template<unsigned DIM>
+void Hdf5CellDataConverter<DIM>::WriteTxtFiles(OutputFileHandler& rOutputFileHandler)
+{
+    if (!PetscTools::AmMaster())
+    {
+        return;
+    }
+
+    std::vector<out_stream> files;
+    for (unsigned var=0; var<mVariableNames.size(); var++)
+    {
+        std::string file_name = mVariableNames[var];
+        std::replace(file_name.begin(), file_name.end(), ' ', '_');
+        files.push_back(rOutputFileHandler.OpenOutputFile(file_name + ".dat"));
+    }
+
+    std::vector<unsigned> cell_ids;
+    std::vector<unsigned> location_indices;
+    std::vector<c_vector<double, DIM> > locations;
+    std::vector<std::vector<double> > data;
+    for (unsigned time_step=0; time_step<mTimes.size(); time_step++)
+    {
+        ReadTimeStep(time_step, cell_ids, location_indices, locations, data);
+
+        for (unsigned var=0; var<files.size(); var++)
+        {
+            *files[var] << mTimes[time_step] << "\t";
+            for (unsigned i=0; i<cell_ids.size(); i++)
+            {
+                *files[var] << location_indices[i] << " " << cell_ids[i] << " ";
+                for (unsigned d=0; d<DIM; d++)
+                {
+                    *files[var] << locations[i][d] << " ";
+                }
+                *files[var] << data[var][i] << " ";
+            }
+            *files[var] << "\n";
+        }
+    }
+
+    for (unsigned var=0; var<files.size(); var++)
+    {
+        files[var]->close();
+    }
+}
+
+template<unsigned DIM>
+void Hdf5CellDataConverter<DIM>::WriteVtkFiles(const std::string& rDirectory)
+{
+#ifdef CHASTE_VTK
+    // VTK can only be written in 2 or 3 dimensions
+    if (DIM == 1)
+    {
+        return;
+    }
+
+    OutputFileHandler output_file_handler(rDirectory, false);
+    out_stream p_vtk_meta_file;
+    if (PetscTools::AmMaster())
+    {
+        p_vtk_meta_file = output_file_handler.OpenOutputFile("results.pvd");
+        *p_vtk_meta_file << "<?xml version=\"1.0\"?>\n";
+        *p_vtk_meta_file << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"LittleEndian\" compressor=\"vtkZLibDataCompressor\">\n";
+        *p_vtk_meta_file << "    <Collection>\n";
+    }
+
+    std::vector<unsigned> cell_ids;
+    std::vector<unsigned> location_indices;
+    std::vector<c_vector<double, DIM> > locations;
+    std::vector<std::vector<double> > data;
+    for (unsigned time_step=0; time_step<mTimes.size(); time_step++)
+    {
+        ReadTimeStep(time_step, cell_ids, location_indices, locations, data);
+        unsigned num_cells = cell_ids.size();
+        if (num_cells == 0)
+        {
+            continue;
+        }
+
+        // Use a single interaction box along each axis, since no neighbours are needed
+        std::vector<Node<DIM>*> nodes;
+        c_vector<double, DIM> min_corner = locations[0];
+        c_vector<double, DIM> max_corner = locations[0];
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            nodes.push_back(new Node<DIM>(i, locations[i]));
+            for (unsigned d=0; d<DIM; d++)
+            {
+                min_corner[d] = std::min(min_corner[d], locations[i][d]);
+                max_corner[d] = std::max(max_corner[d], locations[i][d]);
+            }
+        }
+        double cut_off = std::max(1.0, norm_inf(max_corner - min_corner));
+
+        NodesOnlyMesh<DIM> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, cut_off);
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+
+        /*
+         * The mesh holds copies of the nodes owned by this process, in their original
+         * order, so match each of them to the next row of the file at that location.
+         */
+        unsigned num_local_nodes = mesh.GetNumNodes();
+        std::vector<unsigned> rows(num_local_nodes);
+        unsigned row = 0;
+        for (typename AbstractMesh<DIM, DIM>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+             node_iter != mesh.GetNodeIteratorEnd();
+             ++node_iter)
+        {
+            while (row < num_cells && norm_inf(locations[row] - node_iter->rGetLocation()) > 0.0)
+            {
+                row++;
+            }
+            assert(row < num_cells);
+            rows[mesh.SolveNodeMapping(node_iter->GetIndex())] = row;
+            row++;
+        }
+
+        std::stringstream time;
+        time << time_step;
+        VtkMeshWriter<DIM, DIM> mesh_writer(rDirectory, "results_"+time.str(), false);
+        mesh_writer.SetParallelFiles(mesh);
+
+        std::vector<double> point_data(num_local_nodes);
+        for (unsigned i=0; i<num_local_nodes; i++)
+        {
+            point_data[i] = cell_ids[rows[i]];
+        }
+        mesh_writer.AddPointData("Cell IDs", point_data);
+
+        for (unsigned var=0; var<mVariableNames.size(); var++)
+        {
+            for (unsigned i=0; i<num_local_nodes; i++)
+            {
+                point_data[i] = data[var][rows[i]];
+            }
+            mesh_writer.AddPointData(mVariableNames[var], point_data);
+        }
+
+        mesh_writer.WriteFilesUsingMesh(mesh);
+
+        if (PetscTools::AmMaster())
+        {
+            *p_vtk_meta_file << "        <DataSet timestep=\"" << mTimes[time_step];
+            *p_vtk_meta_file << "\" group=\"\" part=\"0\" file=\"results_" << time_step;
+            if (PetscTools::IsSequential())
+            {
+                *p_vtk_meta_file << ".vtu\"/>\n";
+            }
+            else
+            {
+                // Parallel vtu files  .vtu -> .pvtu
+                *p_vtk_meta_file << ".pvtu\"/>\n";
+            }
+        }
+    }
+
+    if (PetscTools::AmMaster())
+    {
+        *p_vtk_meta_file << "    </Collection>\n";
+        *p_vtk_meta_file << "</VTKFile>\n";
+        p_vtk_meta_file->close();
+    }
+#endif //CHASTE_VTK
+}
+
+// Explicit instantiation
+template class Hdf5CellDataConverter<1>;
+template class Hdf5CellDataConverter<2>;
+template class Hdf5CellDataConverter<3>;
@@ -0,0 +1,134 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef HDF5CELLDATACONVERTER_HPP_
+#define HDF5CELLDATACONVERTER_HPP_
+
+#include <hdf5.h>
+#include <string>
+#include <vector>
+
+#include "FileFinder.hpp"
+#include "UblasVectorInclude.hpp"
+#include "OutputFileHandler.hpp"
+
+/**
+ * Reads an HDF5 file written by Hdf5CellDataWriter and converts it to the
+ * existing cell-based output formats.
+ *
+ * WriteTxtFiles() writes one text file per cell writer, in the format used by
+ * CellDataItemWriter: each line holds a time stamp followed, for each cell, by
+ * its location index, cell ID, location and value.
+ *
+ * WriteVtkFiles() writes one .vtu file per time step, with a point per cell, and
+ * a results.pvd file, in the same way as NodeBasedCellPopulation.
+ */
+template<unsigned DIM>
+class Hdf5CellDataConverter
+{
+private:
+
+    /** The HDF5 file ID. */
+    hid_t mFileId;
+
+    /** The time of each time step in the file. */
+    std::vector<double> mTimes;
+
+    /** The names of the data variables, one per cell writer. */
+    std::vector<std::string> mVariableNames;
+
+public:
+
+    /**
+     * Constructor. Opens the file and reads the time steps and variable names.
+     *
+     * @param rH5File the HDF5 file to convert
+     */
+    Hdf5CellDataConverter(const FileFinder& rH5File);
+
+    /**
+     * Destructor. Closes the file.
+     */
+    ~Hdf5CellDataConverter();
+
+    /**
+     * @return the number of time steps in the file.
+     */
+    unsigned GetNumTimeSteps();
+
+    /**
+     * @return the time of each time step in the file.
+     */
+    const std::vector<double>& rGetTimes();
+
+    /**
+     * @return the names of the data variables.
+     */
+    const std::vector<std::string>& rGetVariableNames();
+
+    /**
+     * Read the data stored for a given time step.
+     *
+     * @param timeStep the index of the time step
+     * @param rCellIds filled with the ID of each cell
+     * @param rLocationIndices filled with the location index of each cell
+     * @param rLocations filled with the location of each cell
+     * @param rData filled with the value of each variable (outer index) for each cell (inner index)
+     */
+    void ReadTimeStep(unsigned timeStep,
+                      std::vector<unsigned>& rCellIds,
+                      std::vector<unsigned>& rLocationIndices,
+                      std::vector<c_vector<double, DIM> >& rLocations,
+                      std::vector<std::vector<double> >& rData);
+
+    /**
+     * Write the data as text files, one per variable, named "<variable>.dat"
+     * (with any spaces in the variable name replaced by underscores).
+     *
+     * @param rOutputFileHandler handler for the directory in which to write the files
+     */
+    void WriteTxtFiles(OutputFileHandler& rOutputFileHandler);
+
+    /**
+     * Write the data as VTK files "results_<time step>.vtu" and a collection file
+     * "results.pvd". Does nothing if Chaste was built without VTK.
+     *
+     * @param rDirectory the output directory, relative to CHASTE_TEST_OUTPUT
+     */
+    void WriteVtkFiles(const std::string& rDirectory);
+};
+
+#endif /*HDF5CELLDATACONVERTER_HPP_*/
@@ -0,0 +1,296 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "Hdf5CellDataWriter.hpp"
+
+#include <cstring>
+#include <sstream>
+#include "AbstractCellPopulation.hpp"
+#include "Exception.hpp"
+#include "PetscTools.hpp"
+#include "SimulationTime.hpp"
+
+/** The fixed length of the strings in the "Variable Details" attribute (as in Hdf5DataWriter). */
+static const unsigned HDF5_CELL_DATA_MAX_STRING_SIZE = 100;
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+Hdf5CellDataWriter<ELEMENT_DIM, SPACE_DIM>::Hdf5CellDataWriter(const std::string& rFileName, bool useCompression)
+    : mFileName(rFileName),
+      mUseCompression(useCompression),
+      mFileId(0),
+      mNumTimeStepsWritten(0)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+Hdf5CellDataWriter<ELEMENT_DIM, SPACE_DIM>::~Hdf5CellDataWriter()
+{
+    if (mFileId > 0)
+    {
+        CloseFile();
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void Hdf5CellDataWriter<ELEMENT_DIM, SPACE_DIM>::OpenOutputFile(OutputFileHandler& rOutputFileHandler)
+{
+    if (mFileId > 0)
+    {
+        CloseFile();
+    }
+
+#if !(H5_VERS_MAJOR > 1 || (H5_VERS_MAJOR == 1 && (H5_VERS_MINOR > 10 || (H5_VERS_MINOR == 10 && H5_VERS_RELEASE >= 2))))
+    if (mUseCompression && PetscTools::IsParallel())
+    {
+        EXCEPTION("Compressed HDF5 cell output in parallel requires HDF5 1.10.2 or later.");
+    }
+#endif
+
+    std::string file_name = rOutputFileHandler.GetOutputDirectoryFullPath() + mFileName;
+
+    // Set up a property list saying how we'll open the file
+    hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl, PetscTools::GetWorld(), MPI_INFO_NULL);
+    mFileId = H5Fcreate(file_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    H5Pclose(fapl);
+
+    if (mFileId < 0)
+    {
+        hid_t error_code = mFileId;
+        mFileId = 0;
+        EXCEPTION("Hdf5CellDataWriter could not create " << file_name << " , H5Fcreate error code = " << error_code);
+    }
+    mNumTimeStepsWritten = 0;
+
+    // Record the spatial dimension so that readers can check it
+    hsize_t one = 1;
+    hid_t one_space = H5Screate_simple(1, &one, NULL);
+    hid_t attr = H5Acreate(mFileId, "SpaceDimension", H5T_NATIVE_UINT, one_space, H5P_DEFAULT, H5P_DEFAULT);
+    unsigned space_dim = SPACE_DIM;
+    H5Awrite(attr, H5T_NATIVE_UINT, &space_dim);
+    H5Aclose(attr);
+    H5Sclose(one_space);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+hid_t Hdf5CellDataWriter<ELEMENT_DIM, SPACE_DIM>::WriteColumns(hid_t groupId,
+                                                              const std::string& rName,
+                                                              hid_t dataType,
+                                                              unsigned numRows,
+                                                              unsigned numTotalCells,
+                                                              unsigned offset,
+                                                              unsigned numLocalCells,
+                                                              const void* pData)
+{
+    hsize_t dataset_dims[2] = {numRows, numTotalCells};
+    hid_t filespace = H5Screate_simple(2, dataset_dims, NULL);
+
+    // Compression needs a chunked layout; an empty dataset cannot be chunked
+    hid_t cparms = H5Pcreate(H5P_DATASET_CREATE);
+    if (mUseCompression && numTotalCells > 0)
+    {
+        hsize_t chunk_dims[2] = {1, numTotalCells};
+        H5Pset_chunk(cparms, 2, chunk_dims);
+        H5Pset_deflate(cparms, 1);
+    }
+    hid_t dataset_id = H5Dcreate(groupId, rName.c_str(), dataType, filespace, H5P_DEFAULT, cparms, H5P_DEFAULT);
+    H5Pclose(cparms);
+
+    if (numTotalCells > 0)
+    {
+        // Every process takes part in the collective write, even if it owns no cells
+        hsize_t count[2] = {numRows, numLocalCells};
+        hsize_t memory_dims[2] = {numRows, (numLocalCells > 0) ? numLocalCells : 1u};
+        hid_t memspace = H5Screate_simple(2, memory_dims, NULL);
+        if (numLocalCells > 0)
+        {
+            hsize_t offset_dims[2] = {0, offset};
+            H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offset_dims, NULL, count, NULL);
+        }
+        else
+        {
+            H5Sselect_none(filespace);
+            H5Sselect_none(memspace);
+        }
+
+        hid_t property_list_id = H5Pcreate(H5P_DATASET_XFER);
+        H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
+        H5Dwrite(dataset_id, dataType, memspace, filespace, property_list_id, pData);
+        H5Pclose(property_list_id);
+        H5Sclose(memspace);
+    }
+    H5Sclose(filespace);
+
+    return dataset_id;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void Hdf5CellDataWriter<ELEMENT_DIM, SPACE_DIM>::WriteTimeStep(AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation,
+                                                               const std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >& rCellWriters)
+{
+    if (mFileId == 0)
+    {
+        EXCEPTION("OpenOutputFile() must be called before WriteTimeStep().");
+    }
+
+    // Gather this process's cells into columns
+    std::vector<CellPtr> local_cells;
+    for (typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator cell_iter = pCellPopulation->Begin();
+         cell_iter != pCellPopulation->End();
+         ++cell_iter)
+    {
+        local_cells.push_back(*cell_iter);
+    }
+    unsigned num_local_cells = local_cells.size();
+    unsigned num_writers = rCellWriters.size();
+
+    std::vector<unsigned> cell_ids(num_local_cells);
+    std::vector<unsigned> location_indices(num_local_cells);
+    std::vector<double> locations(SPACE_DIM*num_local_cells);
+    std::vector<double> data(num_writers*num_local_cells);
+    for (unsigned i=0; i<num_local_cells; i++)
+    {
+        CellPtr p_cell = local_cells[i];
+        cell_ids[i] = p_cell->GetCellId();
+        location_indices[i] = pCellPopulation->GetLocationIndexUsingCell(p_cell);
+
+        c_vector<double, SPACE_DIM> location = pCellPopulation->GetLocationOfCellCentre(p_cell);
+        for (unsigned d=0; d<SPACE_DIM; d++)
+        {
+            locations[d*num_local_cells + i] = location[d];
+        }
+        for (unsigned var=0; var<num_writers; var++)
+        {
+            data[var*num_local_cells + i] = rCellWriters[var]->GetCellDataForVtkOutput(p_cell, pCellPopulation);
+        }
+    }
+
+    // Work out where this process's block of columns starts
+    unsigned num_total_cells = num_local_cells;
+    unsigned offset = 0;
+    if (PetscTools::IsParallel())
+    {
+        MPI_Allreduce(&num_local_cells, &num_total_cells, 1, MPI_UNSIGNED, MPI_SUM, PetscTools::GetWorld());
+        MPI_Exscan(&num_local_cells, &offset, 1, MPI_UNSIGNED, MPI_SUM, PetscTools::GetWorld());
+        if (PetscTools::AmMaster())
+        {
+            // The result of MPI_Exscan is undefined on the first process
+            offset = 0;
+        }
+    }
+
+    // Create the group for this time step
+    std::stringstream group_name;
+    group_name << "TimeStep_" << mNumTimeStepsWritten;
+    hid_t group_id = H5Gcreate(mFileId, group_name.str().c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+    hsize_t one = 1;
+    hid_t one_space = H5Screate_simple(1, &one, NULL);
+    hid_t time_attr = H5Acreate(group_id, "Time", H5T_NATIVE_DOUBLE, one_space, H5P_DEFAULT, H5P_DEFAULT);
+    double time = SimulationTime::Instance()->GetTime();
+    H5Awrite(time_attr, H5T_NATIVE_DOUBLE, &time);
+    H5Aclose(time_attr);
+    H5Sclose(one_space);
+
+    // A process that owns no cells passes no buffer, but still takes part in the collective writes
+    H5Dclose(WriteColumns(group_id, "CellId", H5T_NATIVE_UINT, 1, num_total_cells, offset, num_local_cells, cell_ids.empty() ? NULL : &cell_ids[0]));
+    H5Dclose(WriteColumns(group_id, "LocationIndex", H5T_NATIVE_UINT, 1, num_total_cells, offset, num_local_cells, location_indices.empty() ? NULL : &location_indices[0]));
+    H5Dclose(WriteColumns(group_id, "Location", H5T_NATIVE_DOUBLE, SPACE_DIM, num_total_cells, offset, num_local_cells, locations.empty() ? NULL : &locations[0]));
+
+    if (num_writers > 0)
+    {
+        hid_t data_id = WriteColumns(group_id, "Data", H5T_NATIVE_DOUBLE, num_writers, num_total_cells, offset, num_local_cells, data.empty() ? NULL : &data[0]);
+
+        // Name the rows of the data
+        hsize_t columns[1] = {num_writers};
+        hid_t colspace = H5Screate_simple(1, columns, NULL);
+        std::vector<char> col_data(num_writers*HDF5_CELL_DATA_MAX_STRING_SIZE, '\0');
+        for (unsigned var=0; var<num_writers; var++)
+        {
+            std::string name = rCellWriters[var]->GetVtkCellDataName();
+            strncpy(&col_data[var*HDF5_CELL_DATA_MAX_STRING_SIZE], name.c_str(), HDF5_CELL_DATA_MAX_STRING_SIZE-1);
+        }
+
+        hid_t string_type = H5Tcopy(H5T_C_S1);
+        H5Tset_size(string_type, HDF5_CELL_DATA_MAX_STRING_SIZE);
+        hid_t attr = H5Acreate(data_id, "Variable Details", string_type, colspace, H5P_DEFAULT, H5P_DEFAULT);
+        H5Awrite(attr, string_type, &col_data[0]);
+
+        H5Aclose(attr);
+        H5Tclose(string_type);
+        H5Sclose(colspace);
+        H5Dclose(data_id);
+    }
+
+    H5Gclose(group_id);
+    mNumTimeStepsWritten++;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void Hdf5CellDataWriter<ELEMENT_DIM, SPACE_DIM>::CloseFile()
+{
+    if (mFileId > 0)
+    {
+        H5Fclose(mFileId);
+        mFileId = 0;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::string Hdf5CellDataWriter<ELEMENT_DIM, SPACE_DIM>::GetFileName()
+{
+    return mFileName;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool Hdf5CellDataWriter<ELEMENT_DIM, SPACE_DIM>::GetUseCompression()
+{
+    return mUseCompression;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned Hdf5CellDataWriter<ELEMENT_DIM, SPACE_DIM>::GetNumTimeStepsWritten()
+{
+    return mNumTimeStepsWritten;
+}
+
+// Explicit instantiation
+template class Hdf5CellDataWriter<1,1>;
+template class Hdf5CellDataWriter<1,2>;
+template class Hdf5CellDataWriter<2,2>;
+template class Hdf5CellDataWriter<1,3>;
+template class Hdf5CellDataWriter<2,3>;
+template class Hdf5CellDataWriter<3,3>;
@@ -0,0 +1,169 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef HDF5CELLDATAWRITER_HPP_
+#define HDF5CELLDATAWRITER_HPP_
+
+#include <hdf5.h>
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "AbstractCellWriter.hpp"
+#include "OutputFileHandler.hpp"
+
+// Forward declaration prevents circular include chain
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM> class AbstractCellPopulation;
+
+/**
+ * A writer that stores the output of a population's cell writers in a single
+ * HDF5 file, instead of one text file per cell writer.
+ *
+ * Each call to WriteTimeStep() creates a group "TimeStep_<n>", with an attribute
+ * "Time", containing the following columnar datasets. Each dataset has one row per
+ * quantity and one column per cell, so that each quantity is stored contiguously:
+ *  - "CellId" (1 x num_cells, unsigned);
+ *  - "LocationIndex" (1 x num_cells, unsigned);
+ *  - "Location" (SPACE_DIM x num_cells, double);
+ *  - "Data" (num_cell_writers x num_cells, double), holding the value returned by
+ *    each cell writer's GetCellDataForVtkOutput() method. The names of the rows are
+ *    stored in the string attribute "Variable Details", using GetVtkCellDataName().
+ *
+ * The file is opened using the MPI-IO driver and each process writes the cells it
+ * owns into a contiguous block of columns with a single collective write, so no
+ * round-robin over processes is needed.
+ *
+ * The datasets may optionally be compressed using the deflate filter. This needs
+ * HDF5 1.10.2 or later when running in parallel.
+ *
+ * Hdf5CellDataConverter reads these files back and writes text or VTK output.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class Hdf5CellDataWriter
+{
+private:
+
+    /** The name of the HDF5 file. */
+    std::string mFileName;
+
+    /** Whether to compress the datasets. */
+    bool mUseCompression;
+
+    /** The HDF5 file ID, or 0 if the file is not open. */
+    hid_t mFileId;
+
+    /** The number of time steps written to the current file. */
+    unsigned mNumTimeStepsWritten;
+
+    /**
+     * Create a dataset with numRows rows and numTotalCells columns, and collectively
+     * write this process's block of columns into it.
+     *
+     * @param groupId the group in which to create the dataset
+     * @param rName the name of the dataset
+     * @param dataType the HDF5 type of the data (H5T_NATIVE_UINT or H5T_NATIVE_DOUBLE)
+     * @param numRows the number of rows in the dataset
+     * @param numTotalCells the total number of cells over all processes
+     * @param offset the index of the first column owned by this process
+     * @param numLocalCells the number of columns owned by this process
+     * @param pData this process's data, stored row by row (numRows x numLocalCells)
+     *
+     * @return the ID of the dataset, which must be closed by the caller
+     */
+    hid_t WriteColumns(hid_t groupId,
+                       const std::string& rName,
+                       hid_t dataType,
+                       unsigned numRows,
+                       unsigned numTotalCells,
+                       unsigned offset,
+                       unsigned numLocalCells,
+                       const void* pData);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rFileName the name of the HDF5 file (defaults to "results.h5")
+     * @param useCompression whether to compress the datasets (defaults to false)
+     */
+    Hdf5CellDataWriter(const std::string& rFileName="results.h5", bool useCompression=false);
+
+    /**
+     * Destructor. Closes the file if it is still open.
+     */
+    ~Hdf5CellDataWriter();
+
+    /**
+     * Create the HDF5 file, overwriting any existing file of the same name.
+     * This method is collective.
+     *
+     * @param rOutputFileHandler handler for the directory in which to create the file
+     */
+    void OpenOutputFile(OutputFileHandler& rOutputFileHandler);
+
+    /**
+     * Write the current state of the cells owned by this process to a new time step
+     * group. This method is collective.
+     *
+     * @param pCellPopulation the cell population
+     * @param rCellWriters the cell writers whose data to output
+     */
+    void WriteTimeStep(AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation,
+                       const std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >& rCellWriters);
+
+    /**
+     * Close the HDF5 file. This method is collective.
+     */
+    void CloseFile();
+
+    /**
+     * @return mFileName.
+     */
+    std::string GetFileName();
+
+    /**
+     * @return mUseCompression.
+     */
+    bool GetUseCompression();
+
+    /**
+     * @return mNumTimeStepsWritten.
+     */
+    unsigned GetNumTimeStepsWritten();
+};
+
+#endif /*HDF5CELLDATAWRITER_HPP_*/
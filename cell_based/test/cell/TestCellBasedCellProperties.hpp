@@ -42,6 +42,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellId.hpp"
 #include "CellData.hpp"
+#include "CellDataKey.hpp"
 
 #include "CellPropertyRegistry.hpp"
 
@@ -140,6 +141,67 @@ public:
         TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 3u);
     }
 
+    void TestCellDataKeyMethods() throw(Exception)
+    {
+        // Keys with the same name share an index
+        CellDataKey key_a("key thing a");
+        CellDataKey key_b("key thing b");
+        CellDataKey key_a_again("key thing a");
+        TS_ASSERT_EQUALS(key_a.GetIndex(), key_a_again.GetIndex());
+        TS_ASSERT_DIFFERS(key_a.GetIndex(), key_b.GetIndex());
+        TS_ASSERT_EQUALS(key_b.rGetName(), "key thing b");
+        TS_ASSERT_EQUALS(CellDataKey::rGetNameOfIndex(key_a.GetIndex()), "key thing a");
+
+        // Looking up an unused name does not intern it
+        unsigned num_keys = CellDataKey::GetNumKeys();
+        unsigned index;
+        TS_ASSERT_EQUALS(CellDataKey::FindIndex("key thing c", index), false);
+        TS_ASSERT_EQUALS(CellDataKey::GetNumKeys(), num_keys);
+        TS_ASSERT_EQUALS(CellDataKey::FindIndex("key thing b", index), true);
+        TS_ASSERT_EQUALS(index, key_b.GetIndex());
+
+        // Key and string access refer to the same items
+        MAKE_PTR(CellData, p_cell_data);
+        TS_ASSERT_THROWS_THIS(p_cell_data->GetItem(key_b), "The item key thing b is not stored");
+        TS_ASSERT_THROWS_THIS(p_cell_data->GetItem("key thing c"), "The item key thing c is not stored");
+
+        p_cell_data->SetItem(key_b, 2.0);
+        p_cell_data->SetItem("key thing a", 1.0);
+        TS_ASSERT_DELTA(p_cell_data->GetItem(key_a), 1.0, 1e-8);
+        TS_ASSERT_DELTA(p_cell_data->GetItem("key thing b"), 2.0, 1e-8);
+        TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 2u);
+
+        // Overwriting an item does not change the number of items
+        p_cell_data->SetItem(key_a_again, 3.0);
+        TS_ASSERT_DELTA(p_cell_data->GetItem(key_a), 3.0, 1e-8);
+        TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 2u);
+
+        // Keys are returned in alphabetical order, whatever order they were set in
+        std::vector<std::string> keys = p_cell_data->GetKeys();
+        TS_ASSERT_EQUALS(keys.size(), 2u);
+        TS_ASSERT_EQUALS(keys[0], "key thing a");
+        TS_ASSERT_EQUALS(keys[1], "key thing b");
+
+        // Copies hold their own values
+        boost::shared_ptr<CellData> p_copy(new CellData(*p_cell_data));
+        p_copy->SetItem(key_a, 4.0);
+        TS_ASSERT_DELTA(p_cell_data->GetItem(key_a), 3.0, 1e-8);
+        TS_ASSERT_DELTA(p_copy->GetItem(key_a), 4.0, 1e-8);
+
+        // The key signature depends on the set of keys stored, but not on their values or order
+        TS_ASSERT_EQUALS(p_copy->GetKeySignature(), p_cell_data->GetKeySignature());
+        MAKE_PTR(CellData, p_other_cell_data);
+        p_other_cell_data->SetItem(key_a, 5.0);
+        TS_ASSERT_DIFFERS(p_other_cell_data->GetKeySignature(), p_cell_data->GetKeySignature());
+        p_other_cell_data->SetItem(key_b, 6.0);
+        TS_ASSERT_EQUALS(p_other_cell_data->GetKeySignature(), p_cell_data->GetKeySignature());
+        MAKE_PTR(CellData, p_different_cell_data);
+        p_different_cell_data->SetItem("key thing c", 1.0);
+        p_different_cell_data->SetItem(key_b, 2.0);
+        TS_ASSERT_EQUALS(p_different_cell_data->GetNumItems(), 2u);
+        TS_ASSERT_DIFFERS(p_different_cell_data->GetKeySignature(), p_cell_data->GetKeySignature());
+    }
+
     void TestArchiveCellData() throw(Exception)
     {
         OutputFileHandler handler("archive", false);
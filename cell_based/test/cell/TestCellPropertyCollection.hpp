@@ -48,6 +48,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ApcOneHitCellMutationState.hpp"
 #include "ApcTwoHitCellMutationState.hpp"
 #include "BetaCateninOneHitCellMutationState.hpp"
+#include "AbstractCellProliferativeType.hpp"
+#include "StemCellProliferativeType.hpp"
+#include "ApoptoticCellProperty.hpp"
+#include "CellLabel.hpp"
 
 #include "OutputFileHandler.hpp"
 
@@ -137,6 +141,65 @@ public:
                               "Can only call GetProperty on a collection of size 1.");
     }
 
+    void TestPropertyTypeIds() throw (Exception)
+    {
+        // Each class gets its own type ID, which matches that of its instances
+        unsigned wt_id = CellPropertyRegistry::GetTypeId<WildTypeCellMutationState>();
+        unsigned apc1_id = CellPropertyRegistry::GetTypeId<ApcOneHitCellMutationState>();
+        TS_ASSERT_DIFFERS(wt_id, apc1_id);
+        TS_ASSERT_EQUALS(CellPropertyRegistry::GetTypeId<WildTypeCellMutationState>(), wt_id);
+        TS_ASSERT_LESS_THAN(wt_id, CellPropertyRegistry::GetNumTypeIds());
+
+        NEW_PROP(WildTypeCellMutationState, p_wt_mutation);
+        NEW_PROP(ApcOneHitCellMutationState, p_apc1_mutation);
+        NEW_PROP(StemCellProliferativeType, p_stem_type);
+        NEW_PROP(CellLabel, p_label);
+        TS_ASSERT_EQUALS(p_wt_mutation->GetTypeId(), wt_id);
+        TS_ASSERT_EQUALS(p_apc1_mutation->GetTypeId(), apc1_id);
+        TS_ASSERT_EQUALS(CellPropertyRegistry::Instance()->Get<WildTypeCellMutationState>()->GetTypeId(), wt_id);
+
+        // The cached answers to type queries track additions and removals
+        CellPropertyCollection collection;
+        TS_ASSERT_EQUALS(collection.HasProperty<WildTypeCellMutationState>(), false);
+        TS_ASSERT_EQUALS(collection.HasPropertyType<AbstractCellMutationState>(), false);
+
+        collection.AddProperty(p_wt_mutation);
+        collection.AddProperty(p_stem_type);
+        TS_ASSERT_EQUALS(collection.HasProperty<WildTypeCellMutationState>(), true);
+        TS_ASSERT_EQUALS(collection.HasProperty<ApcOneHitCellMutationState>(), false);
+        TS_ASSERT_EQUALS(collection.HasPropertyType<AbstractCellMutationState>(), true);
+        TS_ASSERT_EQUALS(collection.HasPropertyType<AbstractCellProliferativeType>(), true);
+        TS_ASSERT_EQUALS(collection.HasPropertyType<CellLabel>(), false);
+        TS_ASSERT_EQUALS(collection.HasProperty<ApoptoticCellProperty>(), false);
+
+        // Ask the same questions again, now that the subclass relationships have been remembered
+        TS_ASSERT_EQUALS(collection.HasPropertyType<AbstractCellMutationState>(), true);
+        TS_ASSERT_EQUALS(collection.HasPropertyType<CellLabel>(), false);
+
+        collection.AddProperty(p_label);
+        TS_ASSERT_EQUALS(collection.HasPropertyType<CellLabel>(), true);
+        TS_ASSERT_EQUALS(collection.GetProperties<CellLabel>().GetSize(), 1u);
+        TS_ASSERT_EQUALS(collection.GetPropertiesType<AbstractCellMutationState>().GetSize(), 1u);
+
+        collection.RemoveProperty(p_wt_mutation);
+        TS_ASSERT_EQUALS(collection.HasProperty<WildTypeCellMutationState>(), false);
+        TS_ASSERT_EQUALS(collection.HasPropertyType<AbstractCellMutationState>(), false);
+        TS_ASSERT_EQUALS(collection.GetProperties<WildTypeCellMutationState>().GetSize(), 0u);
+
+        // Two objects of the same type: removing one leaves the type present
+        NEW_PROP(ApcOneHitCellMutationState, p_apc1_mutation_2);
+        collection.AddProperty(p_apc1_mutation);
+        collection.AddProperty(p_apc1_mutation_2);
+        collection.RemoveProperty<ApcOneHitCellMutationState>();
+        TS_ASSERT_EQUALS(collection.HasProperty<ApcOneHitCellMutationState>(), true);
+        collection.RemoveProperty<ApcOneHitCellMutationState>();
+        TS_ASSERT_EQUALS(collection.HasProperty<ApcOneHitCellMutationState>(), false);
+
+        collection.RemoveProperty<CellLabel>();
+        TS_ASSERT_EQUALS(collection.HasPropertyType<CellLabel>(), false);
+        TS_ASSERT_EQUALS(collection.GetSize(), 1u);
+    }
+
     void TestArchiveCellPropertyCollection() throw (Exception)
     {
         OutputFileHandler handler("archive", false);
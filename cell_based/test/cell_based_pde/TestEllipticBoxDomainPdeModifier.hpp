@@ -62,6 +62,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PottsMeshGenerator.hpp"
 #include "CaBasedCellPopulation.hpp"
 #include "UniformSourceEllipticPde.hpp"
+#include "Warnings.hpp"
+#include <pde/test/pdes/VaryingDiffusionAndSourceTermPde.hpp>
 
 // This test is always run sequentially (never in parallel)
 #include "FakePetscSetup.hpp"
@@ -237,6 +239,156 @@ public:
         TS_ASSERT_DELTA( p_cell_0->GetCellData()->GetItem("variable_grad_y"), -0.0179, 1e-4);
     }
 
+    void TestMeshBasedSquareMonolayerWithPersistentSolver() throw (Exception)
+    {
+        // Same set up as TestMeshBasedSquareMonolayer
+        HoneycombMeshGenerator generator(10,10,0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_property =
+                cells[0]->rGetCellPropertyCollection().GetCellPropertyRegistry()->Get<ApoptoticCellProperty>();
+        for (unsigned i =0; i<cells.size(); i++)
+        {
+            c_vector<double,2> cell_location = p_mesh->GetNode(i)->rGetLocation();
+            if (cell_location(0)<5.0)
+            {
+                cells[i]->AddCellProperty(p_apoptotic_property);
+            }
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 2);
+
+        MAKE_PTR_ARGS(AveragedSourceEllipticPde<2>, p_pde, (cell_population, -0.1));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        ChasteCuboid<2> cuboid(lower, upper);
+
+        MAKE_PTR_ARGS(EllipticBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, false, &cuboid));
+        p_pde_modifier->SetDependentVariableName("variable");
+
+        // Keep the solver and its linear system between time steps
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUsePersistentSolver(), false);
+        p_pde_modifier->SetUsePersistentSolver(true);
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUsePersistentSolver(), true);
+
+        p_pde_modifier->SetupSolve(cell_population,"TestAveragedBoxEllipticPdeWithMeshOnSquareWithPersistentSolver");
+        TS_ASSERT(p_pde_modifier->mpSolver);
+
+        CellPtr p_cell_0 = cell_population.GetCellUsingLocationIndex(0);
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("variable"), 0.8605, 1e-4);
+
+        // Solve again, reusing the solver and starting from the previous solution; the cells have not moved
+        for (unsigned i=0; i<2; i++)
+        {
+            SimulationTime::Instance()->IncrementTimeOneStep();
+            p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        }
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("variable"), 0.8605, 1e-4);
+    }
+
+    void TestMeshBasedSquareMonolayerWithStructuredGridSolver() throw (Exception)
+    {
+        // Same set up as TestMeshBasedSquareMonolayer
+        HoneycombMeshGenerator generator(10,10,0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_property =
+                cells[0]->rGetCellPropertyCollection().GetCellPropertyRegistry()->Get<ApoptoticCellProperty>();
+        for (unsigned i =0; i<cells.size(); i++)
+        {
+            c_vector<double,2> cell_location = p_mesh->GetNode(i)->rGetLocation();
+            if (cell_location(0)<5.0)
+            {
+                cells[i]->AddCellProperty(p_apoptotic_property);
+            }
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 1);
+
+        MAKE_PTR_ARGS(AveragedSourceEllipticPde<2>, p_pde, (cell_population, -0.1));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        ChasteCuboid<2> cuboid(lower, upper);
+
+        MAKE_PTR_ARGS(EllipticBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, false, &cuboid));
+        p_pde_modifier->SetDependentVariableName("variable");
+
+        // Solve by finite differences and multigrid on the lattice of FE mesh nodes
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUseStructuredGridSolver(), false);
+        p_pde_modifier->SetUseStructuredGridSolver(true);
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUseStructuredGridSolver(), true);
+
+        p_pde_modifier->SetupSolve(cell_population,"TestAveragedBoxEllipticPdeWithMeshOnSquareWithStructuredGridSolver");
+        TS_ASSERT(!p_pde_modifier->mpSolver);
+        TS_ASSERT(p_pde_modifier->mpGridSolver);
+        TS_ASSERT_EQUALS(p_pde_modifier->mpGridSolver->GetNumNodes(), 441u);
+        TS_ASSERT_EQUALS(p_pde_modifier->mpGridSolver->GetNumLevels(), 2u);
+
+        // The cells are deposited onto the lattice nodes, so the solution is close to but not the same as the FE value of 0.8605
+        CellPtr p_cell_0 = cell_population.GetCellUsingLocationIndex(0);
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("variable"), 0.8675, 1e-4);
+    }
+
+    void TestStructuredGridSolverFallsBackToFeWithVaryingDiffusion() throw (Exception)
+    {
+        HoneycombMeshGenerator generator(10,10,0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 1);
+
+        // The diffusion term of this PDE varies in space, so it cannot be solved on the lattice
+        MAKE_PTR(VaryingDiffusionAndSourceTermPde<2>, p_pde);
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        ChasteCuboid<2> cuboid(lower, upper);
+
+        MAKE_PTR_ARGS(EllipticBoxDomainPdeModifier<2>, p_fe_modifier, (p_pde, p_bc, false, &cuboid));
+        p_fe_modifier->SetDependentVariableName("variable");
+        p_fe_modifier->SetupSolve(cell_population,"TestEllipticBoxDomainPdeWithVaryingDiffusion");
+
+        CellPtr p_cell_0 = cell_population.GetCellUsingLocationIndex(0);
+        double fe_value = p_cell_0->GetCellData()->GetItem("variable");
+
+        MAKE_PTR_ARGS(EllipticBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, false, &cuboid));
+        p_pde_modifier->SetDependentVariableName("variable");
+        p_pde_modifier->SetUseStructuredGridSolver(true);
+        p_pde_modifier->SetupSolve(cell_population,"TestEllipticBoxDomainPdeWithVaryingDiffusionAndStructuredGridSolver");
+
+        // The FE solver is used instead, with a warning
+        TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 1u);
+        TS_ASSERT_EQUALS(Warnings::Instance()->GetNextWarningMessage(),
+            "The structured grid solver requires a uniform and isotropic diffusion term, so the FE solver is used instead");
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("variable"), fe_value, 1e-10);
+        Warnings::QuietDestroy();
+    }
+
     void TestNodeBasedSquareMonolayer() throw (Exception)
     {
         HoneycombMeshGenerator generator(10,10,0);
@@ -64,6 +64,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PottsMeshGenerator.hpp"
 #include "CaBasedCellPopulation.hpp"
 #include "ReplicatableVector.hpp"
+#include "TrianglesMeshReader.hpp"
 
 // This test is always run sequentially (never in parallel)
 #include "FakePetscSetup.hpp"
@@ -238,6 +239,47 @@ public:
         }
     }
 
+    void TestSolverReusedWhileMeshConnectivityUnchanged() throw(Exception)
+    {
+        // Create a MeshBasedCellPopulation on a mesh with a convex boundary, which can be remeshed incrementally
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_128_elements");
+        MutableMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+        mesh.SetUseIncrementalReMesh(true);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        MeshBasedCellPopulation<2> cell_population(mesh, cells);
+
+        // Create a PDE modifier and set the name of the dependent variable in the PDE
+        MAKE_PTR_ARGS(UniformSourceEllipticPde<2>, p_pde, (-0.1));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+        MAKE_PTR_ARGS(EllipticGrowingDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, false));
+        p_pde_modifier->SetDependentVariableName("nutrient");
+
+        // The first solve constructs the solver
+        p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        boost::shared_ptr<CellBasedEllipticPdeSolver<2> > p_solver = p_pde_modifier->mpSolver;
+        TS_ASSERT(p_solver);
+        double nutrient = cell_population.GetCellUsingLocationIndex(40)->GetCellData()->GetItem("nutrient");
+
+        // Remeshing without moving any nodes leaves the connectivity unchanged, so the solver is kept
+        mesh.ReMesh();
+        p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        TS_ASSERT_EQUALS(p_pde_modifier->mFeMeshConnectivityChanged, false);
+        TS_ASSERT_EQUALS(p_pde_modifier->mpSolver, p_solver);
+        TS_ASSERT_DELTA(cell_population.GetCellUsingLocationIndex(40)->GetCellData()->GetItem("nutrient"), nutrient, 1e-6);
+
+        // Inserting a node changes the connectivity, so a new solver is constructed
+        mesh.AddNode(new Node<2>(0, false, 0.61, 0.67));
+        mesh.ReMesh();
+        p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        TS_ASSERT_EQUALS(p_pde_modifier->mFeMeshConnectivityChanged, true);
+        TS_ASSERT_DIFFERS(p_pde_modifier->mpSolver, p_solver);
+    }
+
     void TestGrowingDomainPdeModifierExceptions() throw(Exception)
     {
         EXIT_IF_PARALLEL;
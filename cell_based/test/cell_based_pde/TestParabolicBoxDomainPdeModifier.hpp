@@ -247,6 +247,127 @@ public:
             "Boundary conditions cannot yet be set on the cell population boundary for a ParabolicBoxDomainPdeModifier");
     }
 
+    void TestMeshBasedSquareMonolayerWithPersistentSolver() throw (Exception)
+    {
+        // Same set up as TestMeshBasedSquareMonolayer
+        HoneycombMeshGenerator generator(10,10,0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_property =
+                       cells[0]->rGetCellPropertyCollection().GetCellPropertyRegistry()->Get<ApoptoticCellProperty>();
+        for (unsigned i =0; i<cells.size(); i++)
+        {
+            c_vector<double,2> cell_location = p_mesh->GetNode(i)->rGetLocation();
+            if (cell_location(0)<5.0)
+            {
+                cells[i]->AddCellProperty(p_apoptotic_property);
+            }
+            cells[i]->GetCellData()->SetItem("variable",1.0);
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 10);
+
+        MAKE_PTR_ARGS(AveragedSourceParabolicPde<2>, p_pde, (cell_population, 0.1, 1.0, -1.0));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        ChasteCuboid<2> cuboid(lower, upper);
+
+        MAKE_PTR_ARGS(ParabolicBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, false, &cuboid));
+        p_pde_modifier->SetDependentVariableName("variable");
+
+        // Keep the solver, and its assembled matrix and preconditioner, between time steps
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUsePersistentSolver(), false);
+        p_pde_modifier->SetUsePersistentSolver(true);
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUsePersistentSolver(), true);
+
+        p_pde_modifier->SetupSolve(cell_population,"TestAveragedParabolicPdeWithMeshOnSquareWithPersistentSolver");
+        TS_ASSERT(!p_pde_modifier->mpSolver);
+
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        SimpleLinearParabolicSolver<2,2>* p_solver = p_pde_modifier->mpSolver.get();
+        TS_ASSERT(p_solver != NULL);
+
+        for (unsigned i=1; i<10; i++)
+        {
+            SimulationTime::Instance()->IncrementTimeOneStep();
+            p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+
+            // The same solver is used at every time step
+            TS_ASSERT_EQUALS(p_pde_modifier->mpSolver.get(), p_solver);
+        }
+
+        // The solution is the same as when a new solver is created at each time step
+        CellPtr p_cell_0 = cell_population.GetCellUsingLocationIndex(0);
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("variable"), 0.8513, 1e-4);
+    }
+
+    void TestMeshBasedSquareMonolayerWithStructuredGridSolver() throw (Exception)
+    {
+        // Same set up as TestMeshBasedSquareMonolayer
+        HoneycombMeshGenerator generator(10,10,0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_property =
+                       cells[0]->rGetCellPropertyCollection().GetCellPropertyRegistry()->Get<ApoptoticCellProperty>();
+        for (unsigned i =0; i<cells.size(); i++)
+        {
+            c_vector<double,2> cell_location = p_mesh->GetNode(i)->rGetLocation();
+            if (cell_location(0)<5.0)
+            {
+                cells[i]->AddCellProperty(p_apoptotic_property);
+            }
+            cells[i]->GetCellData()->SetItem("variable",1.0);
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 10);
+
+        MAKE_PTR_ARGS(AveragedSourceParabolicPde<2>, p_pde, (cell_population, 0.1, 1.0, -1.0));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        ChasteCuboid<2> cuboid(lower, upper);
+
+        MAKE_PTR_ARGS(ParabolicBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, false, &cuboid));
+        p_pde_modifier->SetDependentVariableName("variable");
+
+        // Solve by finite differences and multigrid on the lattice of FE mesh nodes
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUseStructuredGridSolver(), false);
+        p_pde_modifier->SetUseStructuredGridSolver(true);
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUseStructuredGridSolver(), true);
+
+        p_pde_modifier->SetupSolve(cell_population,"TestAveragedParabolicPdeWithMeshOnSquareWithStructuredGridSolver");
+
+        for (unsigned i=0; i<10; i++)
+        {
+            SimulationTime::Instance()->IncrementTimeOneStep();
+            p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        }
+        TS_ASSERT(!p_pde_modifier->mpSolver);
+        TS_ASSERT(p_pde_modifier->mpGridSolver);
+
+        // The solution is close to the FE value of 0.8513, with the difference due to the lumped time derivative and source deposition
+        CellPtr p_cell_0 = cell_population.GetCellUsingLocationIndex(0);
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("variable"), 0.8738, 1e-4);
+    }
+
     // Only difference from above test is the use of Neuman BCs here
     void TestMeshBasedSquareMonolayerWithNeumanBcs() throw (Exception)
     {
@@ -0,0 +1,292 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTREGULARGRIDMULTIGRIDSOLVER_HPP_
+#define TESTREGULARGRIDMULTIGRIDSOLVER_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include <cmath>
+#include "RegularGridMultigridSolver.hpp"
+#include "ThreadPool.hpp"
+
+// This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestRegularGridMultigridSolver : public CxxTest::TestSuite
+{
+public:
+
+    void TestConstructor() throw(Exception)
+    {
+        // The levels have 32x16, 16x8 and 8x4 intervals; the last has few enough nodes to factorise
+        c_vector<unsigned,2> num_nodes;
+        num_nodes[0] = 33;
+        num_nodes[1] = 17;
+        RegularGridMultigridSolver<2> solver(num_nodes, 0.5);
+        TS_ASSERT_EQUALS(solver.GetNumNodes(), 561u);
+        TS_ASSERT_EQUALS(solver.GetNumLevels(), 3u);
+        TS_ASSERT_EQUALS(solver.mLevels[2].mTotalNumNodes, 45u);
+        TS_ASSERT_DELTA(solver.mLevels[2].mStepSizes[0], 2.0, 1e-12);
+        TS_ASSERT_DELTA(solver.mLevels[2].mStepSizes[1], 2.0, 1e-12);
+
+        // An odd number of intervals is rounded up when coarsening, so the spacing differs between directions
+        num_nodes[0] = 12;
+        RegularGridMultigridSolver<2> solver_with_odd_intervals(num_nodes, 0.5);
+        TS_ASSERT_EQUALS(solver_with_odd_intervals.GetNumLevels(), 2u);
+        TS_ASSERT_EQUALS(solver_with_odd_intervals.mLevels[1].mNumNodes[0], 7u);
+        TS_ASSERT_EQUALS(solver_with_odd_intervals.mLevels[1].mNumNodes[1], 9u);
+        TS_ASSERT_DELTA(solver_with_odd_intervals.mLevels[1].mStepSizes[0], 11.0*0.5/6.0, 1e-12);
+        TS_ASSERT_DELTA(solver_with_odd_intervals.mLevels[1].mStepSizes[1], 1.0, 1e-12);
+
+        // Fine node 3 lies between coarse nodes 1 and 2, at 18/11 in coarse lattice coordinates
+        TS_ASSERT_EQUALS(solver_with_odd_intervals.mLevels[0].mCoarseLowerCoords[0][3], 1u);
+        TS_ASSERT_DELTA(solver_with_odd_intervals.mLevels[0].mCoarseUpperWeights[0][3], 7.0/11.0, 1e-12);
+
+        // A small lattice is not coarsened at all
+        num_nodes[0] = 5;
+        num_nodes[1] = 5;
+        RegularGridMultigridSolver<2> solver_without_coarsening(num_nodes, 0.5);
+        TS_ASSERT_EQUALS(solver_without_coarsening.GetNumLevels(), 1u);
+
+        // Nodes on an edge of the lattice pick up a ghost node term for each edge
+        TS_ASSERT_DELTA(solver.GetNeumannBoundaryFactor(0), 8.0, 1e-12);
+        TS_ASSERT_DELTA(solver.GetNeumannBoundaryFactor(1), 4.0, 1e-12);
+        TS_ASSERT_DELTA(solver.GetNeumannBoundaryFactor(34), 0.0, 1e-12);
+    }
+
+    void TestSolveWithDirichletBoundaryConditions() throw(Exception)
+    {
+        // Solve -Laplacian(u) = -4 on the unit square with u = x^2 + y^2 on the boundary, which is exact for finite differences
+        for (unsigned num_intervals=8; num_intervals<=32; num_intervals*=2)
+        {
+            unsigned n = num_intervals + 1;
+            double h = 1.0/num_intervals;
+            c_vector<unsigned,2> num_nodes;
+            num_nodes[0] = n;
+            num_nodes[1] = n;
+            RegularGridMultigridSolver<2> solver(num_nodes, h);
+
+            std::vector<double> diagonal_term(n*n, 0.0);
+            std::vector<double> rhs(n*n, -4.0);
+            std::vector<double> solution(n*n, 0.0);
+            std::vector<bool> is_dirichlet_node(n*n, false);
+            for (unsigned j=0; j<n; j++)
+            {
+                for (unsigned i=0; i<n; i++)
+                {
+                    if (i==0 || j==0 || i==n-1 || j==n-1)
+                    {
+                        is_dirichlet_node[j*n+i] = true;
+                        solution[j*n+i] = (i*h)*(i*h) + (j*h)*(j*h);
+                    }
+                }
+            }
+
+            solver.SetUpOperator(1.0, diagonal_term, is_dirichlet_node);
+            solver.Solve(rhs, solution);
+
+            for (unsigned j=0; j<n; j++)
+            {
+                for (unsigned i=0; i<n; i++)
+                {
+                    TS_ASSERT_DELTA(solution[j*n+i], (i*h)*(i*h) + (j*h)*(j*h), 1e-8);
+                }
+            }
+
+            // The number of V-cycles does not grow with the size of the lattice
+            TS_ASSERT_LESS_THAN(solver.GetNumCyclesOfLastSolve(), 12u);
+
+            // Starting from the solution, no V-cycles are needed
+            solver.Solve(rhs, solution);
+            TS_ASSERT_EQUALS(solver.GetNumCyclesOfLastSolve(), 0u);
+        }
+    }
+
+    void TestSolveWithAnyNumberOfNodes() throw(Exception)
+    {
+        // Solve u - Laplacian(u) = (1 + 2 pi^2) u with zero flux on the unit square, so u = cos(pi x) cos(pi y)
+        unsigned sizes[3] = {12, 100, 101};
+        for (unsigned k=0; k<3; k++)
+        {
+            unsigned n = sizes[k];
+            double h = 1.0/(n-1);
+            c_vector<unsigned,2> num_nodes;
+            num_nodes[0] = n;
+            num_nodes[1] = n;
+            RegularGridMultigridSolver<2> solver(num_nodes, h);
+
+            std::vector<double> diagonal_term(n*n, 1.0);
+            std::vector<double> rhs(n*n);
+            std::vector<double> exact(n*n);
+            std::vector<double> solution(n*n, 0.0);
+            std::vector<bool> is_dirichlet_node(n*n, false);
+            for (unsigned index=0; index<n*n; index++)
+            {
+                exact[index] = cos(M_PI*(index%n)*h)*cos(M_PI*(index/n)*h);
+                rhs[index] = (1.0 + 2.0*M_PI*M_PI)*exact[index];
+            }
+
+            solver.SetUpOperator(1.0, diagonal_term, is_dirichlet_node);
+            solver.Solve(rhs, solution);
+
+            for (unsigned index=0; index<n*n; index++)
+            {
+                TS_ASSERT_DELTA(solution[index], exact[index], 1e-2);
+            }
+
+            // The number of V-cycles does not depend on whether the number of intervals is even
+            TS_ASSERT_LESS_THAN(solver.GetNumCyclesOfLastSolve(), 12u);
+        }
+
+        // With zero flux everywhere and a(x) = 0 the operator is singular, so the coarsest level is smoothed instead
+        unsigned n = 64;
+        c_vector<unsigned,2> num_nodes;
+        num_nodes[0] = n;
+        num_nodes[1] = n;
+        RegularGridMultigridSolver<2> solver(num_nodes, 1.0/(n-1));
+
+        std::vector<double> diagonal_term(n*n, 0.0);
+        std::vector<double> rhs(n*n);
+        std::vector<double> solution(n*n, 0.0);
+        std::vector<bool> is_dirichlet_node(n*n, false);
+        for (unsigned index=0; index<n*n; index++)
+        {
+            rhs[index] = cos(M_PI*(index%n)/(n-1.0));
+        }
+
+        solver.SetUpOperator(1.0, diagonal_term, is_dirichlet_node);
+        TS_ASSERT(!solver.mCoarsestLevelIsFactorised);
+        solver.SetTolerance(1e-6);
+        solver.Solve(rhs, solution);
+        TS_ASSERT_LESS_THAN(solver.GetNumCyclesOfLastSolve(), 12u);
+    }
+
+    void TestSolveWithNeumannBoundaryConditions() throw(Exception)
+    {
+        // Solve -u'' = 0 on [0,1] with u(0) = 0 and u'(1) = 1, so u = x
+        unsigned n = 17;
+        c_vector<unsigned,1> num_nodes;
+        num_nodes[0] = n;
+        RegularGridMultigridSolver<1> solver_1d(num_nodes, 1.0/(n-1));
+
+        std::vector<double> diagonal_term(n, 0.0);
+        std::vector<double> rhs(n, 0.0);
+        std::vector<double> solution(n, 0.0);
+        std::vector<bool> is_dirichlet_node(n, false);
+        is_dirichlet_node[0] = true;
+        rhs[n-1] += solver_1d.GetNeumannBoundaryFactor(n-1)*1.0;
+
+        solver_1d.SetUpOperator(1.0, diagonal_term, is_dirichlet_node);
+        solver_1d.Solve(rhs, solution);
+        for (unsigned i=0; i<n; i++)
+        {
+            TS_ASSERT_DELTA(solution[i], i/(double)(n-1), 1e-8);
+        }
+
+        // Solve u - Laplacian(u) = (1 + 3 pi^2) u with zero flux on the unit cube, so u = cos(pi x) cos(pi y) cos(pi z)
+        c_vector<unsigned,3> num_nodes_3d;
+        num_nodes_3d[0] = n;
+        num_nodes_3d[1] = n;
+        num_nodes_3d[2] = n;
+        double h = 1.0/(n-1);
+        RegularGridMultigridSolver<3> solver_3d(num_nodes_3d, h);
+        TS_ASSERT_EQUALS(solver_3d.GetNumLevels(), 3u);
+
+        unsigned num_nodes_total = solver_3d.GetNumNodes();
+        std::vector<double> diagonal_term_3d(num_nodes_total, 1.0);
+        std::vector<double> rhs_3d(num_nodes_total);
+        std::vector<double> exact_3d(num_nodes_total);
+        std::vector<double> solution_3d(num_nodes_total, 0.0);
+        std::vector<bool> is_dirichlet_node_3d(num_nodes_total, false);
+        for (unsigned index=0; index<num_nodes_total; index++)
+        {
+            double x = (index%n)*h;
+            double y = ((index/n)%n)*h;
+            double z = (index/(n*n))*h;
+            exact_3d[index] = cos(M_PI*x)*cos(M_PI*y)*cos(M_PI*z);
+            rhs_3d[index] = (1.0 + 3.0*M_PI*M_PI)*exact_3d[index];
+        }
+
+        solver_3d.SetUpOperator(1.0, diagonal_term_3d, is_dirichlet_node_3d);
+        solver_3d.Solve(rhs_3d, solution_3d);
+
+        // The finite difference scheme is second order accurate
+        for (unsigned index=0; index<num_nodes_total; index++)
+        {
+            TS_ASSERT_DELTA(solution_3d[index], exact_3d[index], 5e-3);
+        }
+    }
+
+    void TestSolveDoesNotDependOnNumberOfThreads() throw(Exception)
+    {
+        // Solve u - Laplacian(u) = f with a Dirichlet edge on a lattice large enough for its loops to be shared between threads
+        c_vector<unsigned,2> num_nodes;
+        num_nodes[0] = 129;
+        num_nodes[1] = 110;
+        RegularGridMultigridSolver<2> solver(num_nodes, 1.0/128);
+        TS_ASSERT(solver.GetNumNodes() >= RegularGridMultigridSolver<2>::MIN_NUM_NODES_TO_SHARE);
+
+        unsigned num_nodes_total = solver.GetNumNodes();
+        std::vector<double> diagonal_term(num_nodes_total, 1.0);
+        std::vector<double> rhs(num_nodes_total);
+        std::vector<bool> is_dirichlet_node(num_nodes_total, false);
+        for (unsigned index=0; index<num_nodes_total; index++)
+        {
+            rhs[index] = sin(0.37*index);
+            is_dirichlet_node[index] = (index < num_nodes[0]);
+        }
+        solver.SetUpOperator(1.0, diagonal_term, is_dirichlet_node);
+
+        std::vector<double> serial_solution(num_nodes_total, 0.0);
+        solver.Solve(rhs, serial_solution);
+        unsigned num_serial_cycles = solver.GetNumCyclesOfLastSolve();
+
+        // Each node is only written by its own iteration, so the result is identical with more threads
+        ThreadPool::Instance()->SetNumThreads(3);
+        std::vector<double> threaded_solution(num_nodes_total, 0.0);
+        solver.SetUpOperator(1.0, diagonal_term, is_dirichlet_node);
+        solver.Solve(rhs, threaded_solution);
+        ThreadPool::Instance()->SetNumThreads(1);
+
+        TS_ASSERT_EQUALS(solver.GetNumCyclesOfLastSolve(), num_serial_cycles);
+        for (unsigned index=0; index<num_nodes_total; index++)
+        {
+            TS_ASSERT_EQUALS(threaded_solution[index], serial_solution[index]);
+        }
+    }
+};
+
+#endif /*TESTREGULARGRIDMULTIGRIDSOLVER_HPP_*/
@@ -1774,6 +1774,76 @@ public:
         TS_ASSERT_EQUALS(p_mesh->GetNumNodes(), 2u);
     }
 
+    void TestLatticeState() throw(Exception)
+    {
+        // Create a mesh with four 2x2 elements surrounded by medium
+        PottsMeshGenerator<2> generator(6, 2, 2, 6, 2, 2);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        TS_ASSERT_EQUALS(p_mesh->GetNumElements(), 4u);
+        TS_ASSERT_EQUALS(p_mesh->GetNumNodes(), 36u);
+
+        // Test the flattened neighbour tables agree with the neighbour sets
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            std::set<unsigned> moore = p_mesh->GetMooreNeighbouringNodeIndices(node_index);
+            TS_ASSERT_EQUALS(p_mesh->GetNumMooreNeighbours(node_index), moore.size());
+            unsigned local_index = 0;
+            for (std::set<unsigned>::iterator iter = moore.begin(); iter != moore.end(); ++iter)
+            {
+                TS_ASSERT_EQUALS(p_mesh->GetMooreNeighbour(node_index, local_index), *iter);
+                local_index++;
+            }
+
+            std::set<unsigned> von_neumann = p_mesh->GetVonNeumannNeighbouringNodeIndices(node_index);
+            TS_ASSERT_EQUALS(p_mesh->GetNumVonNeumannNeighbours(node_index), von_neumann.size());
+            local_index = 0;
+            for (std::set<unsigned>::iterator iter = von_neumann.begin(); iter != von_neumann.end(); ++iter)
+            {
+                TS_ASSERT_EQUALS(p_mesh->GetVonNeumannNeighbour(node_index, local_index), *iter);
+                local_index++;
+            }
+        }
+
+        // Test the cached element surface areas agree with those computed from the mesh
+        for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+        {
+            TS_ASSERT_DELTA(p_mesh->GetCachedSurfaceAreaOfElement(elem_index), 8.0, 1e-12);
+        }
+
+        // Move a sequence of nodes between elements and the medium, checking the state is updated incrementally
+        unsigned nodes_to_move[6] = {7, 13, 8, 14, 0, 21};
+        unsigned new_elements[6] = {UINT_MAX, 1, 0, UINT_MAX, 2, 3};
+        for (unsigned i=0; i<6; i++)
+        {
+            p_mesh->MoveNodeToElement(nodes_to_move[i], new_elements[i]);
+            TS_ASSERT_EQUALS(p_mesh->GetContainingElementIndexOfNode(nodes_to_move[i]), new_elements[i]);
+
+            for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+            {
+                std::set<unsigned> containing_elements = p_mesh->GetNode(node_index)->rGetContainingElementIndices();
+                unsigned expected_index = containing_elements.empty() ? UINT_MAX : *(containing_elements.begin());
+                TS_ASSERT_EQUALS(p_mesh->GetContainingElementIndexOfNode(node_index), expected_index);
+            }
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                TS_ASSERT_DELTA(p_mesh->GetCachedSurfaceAreaOfElement(elem_index), p_mesh->GetSurfaceAreaOfElement(elem_index), 1e-12);
+            }
+        }
+
+        // Test the state is recomputed after an element is divided
+        unsigned new_element_index = p_mesh->DivideElement(p_mesh->GetElement(3));
+        TS_ASSERT_EQUALS(new_element_index, 4u);
+        for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+        {
+            TS_ASSERT_DELTA(p_mesh->GetCachedSurfaceAreaOfElement(elem_index), p_mesh->GetSurfaceAreaOfElement(elem_index), 1e-12);
+        }
+        for (unsigned local_index=0; local_index<p_mesh->GetElement(4)->GetNumNodes(); local_index++)
+        {
+            TS_ASSERT_EQUALS(p_mesh->GetContainingElementIndexOfNode(p_mesh->GetElement(4)->GetNodeGlobalIndex(local_index)), 4u);
+        }
+    }
+
     void TestArchive2dPottsMesh()
     {
         EXIT_IF_PARALLEL;
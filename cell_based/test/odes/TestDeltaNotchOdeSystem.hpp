@@ -46,6 +46,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "OutputFileHandler.hpp"
 #include "DeltaNotchOdeSystem.hpp"
+#include "DeltaNotchOdeBatch.hpp"
+#include "ThreadPool.hpp"
 #include "RungeKutta4IvpOdeSolver.hpp"
 #include "RungeKuttaFehlbergIvpOdeSolver.hpp"
 #include "BackwardEulerIvpOdeSolver.hpp"
@@ -172,6 +174,60 @@ public:
 
 #endif //CHASTE_CVODE
    }
+
+    void TestDeltaNotchOdeBatch() throw(Exception)
+    {
+        // The end time is not a multiple of the time step, so the last step is shorter
+        double start_time = 0.5;
+        double end_time = 2.0005;
+        double dt = 0.001;
+
+        unsigned num_systems = 50;
+        std::vector<DeltaNotchOdeSystem*> ode_systems;
+        for (unsigned i=0; i<num_systems; i++)
+        {
+            std::vector<double> state_variables;
+            state_variables.push_back(0.02*i);
+            state_variables.push_back(1.0 - 0.01*i);
+            ode_systems.push_back(new DeltaNotchOdeSystem(state_variables));
+            ode_systems[i]->SetParameter("Mean Delta", 0.03*i);
+        }
+
+        // Solve each system on its own, as DeltaNotchSrnModel does
+        RungeKutta4IvpOdeSolver solver;
+        for (unsigned i=0; i<num_systems; i++)
+        {
+            solver.SolveAndUpdateStateVariable(ode_systems[i], start_time, end_time, dt);
+        }
+
+        // The batch gives the same results on any number of threads
+        unsigned num_threads[2] = {1, 4};
+        for (unsigned j=0; j<2; j++)
+        {
+            ThreadPool::Instance()->SetNumThreads(num_threads[j]);
+
+            DeltaNotchOdeBatch batch(start_time, end_time, dt);
+            for (unsigned i=0; i<num_systems; i++)
+            {
+                TS_ASSERT_EQUALS(batch.AddSystem(0.02*i, 1.0 - 0.01*i, 0.03*i), i);
+            }
+            TS_ASSERT_EQUALS(batch.GetNumSystems(), num_systems);
+
+            batch.Solve();
+
+            for (unsigned i=0; i<num_systems; i++)
+            {
+                TS_ASSERT_DELTA(batch.GetNotch(i), ode_systems[i]->GetStateVariable(0), 1e-12);
+                TS_ASSERT_DELTA(batch.GetDelta(i), ode_systems[i]->GetStateVariable(1), 1e-12);
+            }
+        }
+
+        for (unsigned i=0; i<num_systems; i++)
+        {
+            delete ode_systems[i];
+        }
+        ThreadPool::Destroy();
+    }
 };
 
 #endif /*TESTDELTANOTCHODESYSTEM_HPP_*/
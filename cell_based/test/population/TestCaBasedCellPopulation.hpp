@@ -50,6 +50,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FixedG1GenerationalCellCycleModel.hpp"
 #include "DifferentiatedCellProliferativeType.hpp"
 #include "DiffusionCaUpdateRule.hpp"
+#include "RandomCaSwitchingUpdateRule.hpp"
+#include "ThreadPool.hpp"
 #include "AbstractCellBasedTestSuite.hpp"
 #include "ArchiveOpener.hpp"
 #include "WildTypeCellMutationState.hpp"
@@ -723,6 +725,14 @@ public:
 
         std::set<unsigned> neighbours_of_cell_0 = cell_population.GetNeighbouringLocationIndices(*(cell_population.Begin()));
         TS_ASSERT(neighbours_of_cell_0 == expected_neighbours_of_cell_0);
+
+        // Test the neighbour adjacency gives the same neighbours, in ascending order
+        TS_ASSERT_EQUALS(cell_population.GetNumNeighbouringLocations(0), 3u);
+        std::vector<unsigned> adjacent_to_cell_0(cell_population.GetNeighbouringLocationsBegin(0), cell_population.GetNeighbouringLocationsEnd(0));
+        TS_ASSERT_EQUALS(adjacent_to_cell_0.size(), 3u);
+        TS_ASSERT_EQUALS(adjacent_to_cell_0[0], 1u);
+        TS_ASSERT_EQUALS(adjacent_to_cell_0[1], 3u);
+        TS_ASSERT_EQUALS(adjacent_to_cell_0[2], 4u);
     }
 
     void TestUpdateCellLocationsRandomlyExceptions()
@@ -762,6 +772,224 @@ public:
         TS_ASSERT_EQUALS(cell_population.rGetCells().size(), 1u);
     }
 
+    void TestBatchedUpdateCellLocations()
+    {
+        // The random numbers used to propose moves are keyed by the time step
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(20.0, 20);
+
+        // Create a simple 2D PottsMesh populated with cells everywhere except the centre site
+        PottsMeshGenerator<2> generator(3, 0, 0, 3, 0, 0);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, 8);
+
+        std::vector<unsigned> location_indices;
+        for (unsigned i=0; i<9; i++)
+        {
+            if (i != 4)
+            {
+                location_indices.push_back(i);
+            }
+        }
+
+        CaBasedCellPopulation<2u> cell_population(*p_mesh, cells, location_indices);
+
+        // Test the default settings and the set methods
+        TS_ASSERT_EQUALS(cell_population.GetUseBatchedUpdate(), false);
+        TS_ASSERT_EQUALS(cell_population.GetRetryBatchConflictsSequentially(), true);
+        cell_population.SetUseBatchedUpdate(true);
+        cell_population.SetRetryBatchConflictsSequentially(false);
+        TS_ASSERT_EQUALS(cell_population.GetUseBatchedUpdate(), true);
+        TS_ASSERT_EQUALS(cell_population.GetRetryBatchConflictsSequentially(), false);
+
+        // Every cell can only move to the centre site, and most of them will try to
+        MAKE_PTR(DiffusionCaUpdateRule<2u>, p_diffusion_update_rule);
+        p_diffusion_update_rule->SetDiffusionParameter(1.0);
+        cell_population.AddUpdateRule(p_diffusion_update_rule);
+
+        for (unsigned step=0; step<10; step++)
+        {
+            std::map<CellPtr, unsigned> old_locations;
+            for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+                 cell_iter != cell_population.End();
+                 ++cell_iter)
+            {
+                old_locations[*cell_iter] = cell_population.GetLocationIndexUsingCell(*cell_iter);
+            }
+
+            cell_population.UpdateCellLocations(1.0);
+            SimulationTime::Instance()->IncrementTimeOneStep();
+
+            // At most one cell can have moved, and no site may hold more than one cell
+            unsigned num_moved = 0;
+            std::set<unsigned> occupied_sites;
+            for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+                 cell_iter != cell_population.End();
+                 ++cell_iter)
+            {
+                unsigned location_index = cell_population.GetLocationIndexUsingCell(*cell_iter);
+                occupied_sites.insert(location_index);
+                if (location_index != old_locations[*cell_iter])
+                {
+                    num_moved++;
+                }
+            }
+            TS_ASSERT_LESS_THAN_EQUALS(num_moved, 1u);
+            TS_ASSERT_EQUALS(occupied_sites.size(), 8u);
+
+            unsigned num_free_spaces = 0;
+            for (unsigned i=0; i<9; i++)
+            {
+                TS_ASSERT_EQUALS(cell_population.rGetAvailableSpaces()[i], (occupied_sites.count(i) == 1) ? 0u : 1u);
+                num_free_spaces += cell_population.rGetAvailableSpaces()[i];
+            }
+            TS_ASSERT_EQUALS(num_free_spaces, 1u);
+        }
+
+        // Cells that lose a conflict may have another go, but the lattice must remain consistent
+        cell_population.SetRetryBatchConflictsSequentially(true);
+        for (unsigned step=0; step<10; step++)
+        {
+            cell_population.UpdateCellLocations(1.0);
+            SimulationTime::Instance()->IncrementTimeOneStep();
+
+            std::set<unsigned> occupied_sites;
+            for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+                 cell_iter != cell_population.End();
+                 ++cell_iter)
+            {
+                occupied_sites.insert(cell_population.GetLocationIndexUsingCell(*cell_iter));
+            }
+            TS_ASSERT_EQUALS(occupied_sites.size(), 8u);
+
+            for (unsigned i=0; i<9; i++)
+            {
+                TS_ASSERT_EQUALS(cell_population.rGetAvailableSpaces()[i], (occupied_sites.count(i) == 1) ? 0u : 1u);
+            }
+        }
+
+        // The exceptions are thrown in batched mode too
+        TS_ASSERT_THROWS_THIS(cell_population.UpdateCellLocations(-1.0),
+            "The probability of cellular movement is smaller than zero. In order to prevent it from happening you should change your time step and parameters");
+    }
+
+    void TestBatchedUpdateDoesNotDependOnNumberOfThreads()
+    {
+        unsigned num_steps = 5;
+        std::vector<std::vector<unsigned> > locations(2);
+
+        for (unsigned run=0; run<2; run++)
+        {
+            ThreadPool::Instance()->SetNumThreads(run == 0 ? 1 : 3);
+            RandomNumberGenerator::Instance()->Reseed(0);
+            CellId::ResetMaxCellId();
+            SimulationTime::Destroy();
+            SimulationTime::Instance()->SetStartTime(0.0);
+            SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0*num_steps, num_steps);
+
+            // Create a 10 by 10 lattice with a cell on every other site
+            PottsMeshGenerator<2> generator(10, 0, 0, 10, 0, 0);
+            PottsMesh<2>* p_mesh = generator.GetMesh();
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasic(cells, 50);
+
+            std::vector<unsigned> location_indices;
+            for (unsigned i=0; i<50; i++)
+            {
+                location_indices.push_back(2*i);
+            }
+
+            CaBasedCellPopulation<2u> cell_population(*p_mesh, cells, location_indices);
+            cell_population.SetUseBatchedUpdate(true);
+            cell_population.SetRetryBatchConflictsSequentially(false);
+
+            MAKE_PTR(DiffusionCaUpdateRule<2u>, p_diffusion_update_rule);
+            p_diffusion_update_rule->SetDiffusionParameter(0.2);
+            cell_population.AddUpdateRule(p_diffusion_update_rule);
+
+            for (unsigned step=0; step<num_steps; step++)
+            {
+                cell_population.UpdateCellLocations(1.0);
+                SimulationTime::Instance()->IncrementTimeOneStep();
+            }
+
+            for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+                 cell_iter != cell_population.End();
+                 ++cell_iter)
+            {
+                locations[run].push_back(cell_population.GetLocationIndexUsingCell(*cell_iter));
+            }
+        }
+        ThreadPool::Destroy();
+
+        // The cells end up in the same places whatever the number of threads
+        TS_ASSERT_EQUALS(locations[0].size(), 50u);
+        TS_ASSERT_EQUALS(locations[1].size(), 50u);
+        unsigned num_moved = 0;
+        for (unsigned i=0; i<locations[0].size(); i++)
+        {
+            TS_ASSERT_EQUALS(locations[0][i], locations[1][i]);
+            if (locations[0][i] != 2*i)
+            {
+                num_moved++;
+            }
+        }
+        TS_ASSERT_LESS_THAN(0u, num_moved);
+    }
+
+    void TestBatchedSwitchingUpdate()
+    {
+        // Create a simple 2D PottsMesh with every site but one occupied
+        PottsMeshGenerator<2> generator(5, 0, 0, 5, 0, 0);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, 24);
+
+        std::vector<unsigned> location_indices;
+        for (unsigned i=0; i<24; i++)
+        {
+            location_indices.push_back(i);
+        }
+
+        CaBasedCellPopulation<2u> cell_population(*p_mesh, cells, location_indices);
+        cell_population.SetUseBatchedUpdate(true);
+
+        MAKE_PTR(RandomCaSwitchingUpdateRule<2u>, p_switching_update_rule);
+        p_switching_update_rule->SetSwitchingParameter(1.0);
+        cell_population.AddUpdateRule(p_switching_update_rule);
+
+        for (unsigned retry=0; retry<2; retry++)
+        {
+            cell_population.SetRetryBatchConflictsSequentially(retry == 1);
+
+            for (unsigned step=0; step<10; step++)
+            {
+                cell_population.UpdateCellLocations(1.0);
+
+                // Cells are shuffled around but each site still holds at most one cell
+                std::set<unsigned> occupied_sites;
+                for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+                     cell_iter != cell_population.End();
+                     ++cell_iter)
+                {
+                    occupied_sites.insert(cell_population.GetLocationIndexUsingCell(*cell_iter));
+                }
+                TS_ASSERT_EQUALS(occupied_sites.size(), 24u);
+
+                for (unsigned i=0; i<25; i++)
+                {
+                    TS_ASSERT_EQUALS(cell_population.rGetAvailableSpaces()[i], (occupied_sites.count(i) == 1) ? 0u : 1u);
+                }
+            }
+        }
+    }
+
     void TestArchiving() throw(Exception)
     {
         FileFinder archive_dir("archive", RelativeTo::ChasteTestOutput);
@@ -815,6 +1043,8 @@ public:
             // Set member variables in order to test that they are archived correctly
             static_cast<CaBasedCellPopulation<2>*>(p_cell_population)->SetUpdateNodesInRandomOrder(false);
             static_cast<CaBasedCellPopulation<2>*>(p_cell_population)->SetIterateRandomlyOverUpdateRuleCollection(true);
+            static_cast<CaBasedCellPopulation<2>*>(p_cell_population)->SetUseBatchedUpdate(true);
+            static_cast<CaBasedCellPopulation<2>*>(p_cell_population)->SetRetryBatchConflictsSequentially(false);
 
             // Create output archive
             ArchiveOpener<boost::archive::text_oarchive, std::ofstream> arch_opener(archive_dir, archive_file);
@@ -869,6 +1099,8 @@ public:
 
             TS_ASSERT_EQUALS(p_static_population->GetUpdateNodesInRandomOrder(), false);
             TS_ASSERT_EQUALS(p_static_population->GetIterateRandomlyOverUpdateRuleCollection(), true);
+            TS_ASSERT_EQUALS(p_static_population->GetUseBatchedUpdate(), true);
+            TS_ASSERT_EQUALS(p_static_population->GetRetryBatchConflictsSequentially(), false);
 
             // Test that the update rule has been archived correctly
             std::vector<boost::shared_ptr<AbstractUpdateRule<2> > > update_rule_collection = p_static_population->GetUpdateRuleCollection();
@@ -92,7 +92,7 @@ public:
         MeshBasedCellPopulation<2> cell_population(mesh, cells);
 
         // Get a reference to the cells held in cell population
-        std::list<CellPtr>& r_cells = cell_population.rGetCells();
+        std::vector<CellPtr>& r_cells = cell_population.rGetCells();
 
         // Create cell killer
         TargetedCellKiller<2> single_cell_killer(&cell_population, 1u);
@@ -104,7 +104,7 @@ public:
 
         std::set<double> old_locations;
 
-        std::list<CellPtr>::iterator cell_it = r_cells.begin();
+        std::vector<CellPtr>::iterator cell_it = r_cells.begin();
         TS_ASSERT(!(*cell_it)->IsDead());
         ++cell_it;
         TS_ASSERT((*cell_it)->IsDead());
@@ -117,7 +117,7 @@ public:
         }
 
         // Store 'locations' of cells which are not dead
-        for (std::list<CellPtr>::iterator cell_iter = r_cells.begin();
+        for (std::vector<CellPtr>::iterator cell_iter = r_cells.begin();
              cell_iter != r_cells.end();
              ++cell_iter)
         {
@@ -134,7 +134,7 @@ public:
 
         // Check that dead cells are removed from the mesh
         std::set< double > new_locations;
-        for (std::list<CellPtr>::iterator cell_iter = r_cells.begin();
+        for (std::vector<CellPtr>::iterator cell_iter = r_cells.begin();
              cell_iter != r_cells.end();
              ++cell_iter)
         {
@@ -169,7 +169,7 @@ public:
         MeshBasedCellPopulation<2> cell_population(mesh, cells);
 
         // Get a reference to the cells held in cell population
-        std::list<CellPtr>& r_cells = cell_population.rGetCells();
+        std::vector<CellPtr>& r_cells = cell_population.rGetCells();
 
         // Check for bad probabilities being passed in
         TS_ASSERT_THROWS_THIS(RandomCellKiller<2> random_cell_killer(&cell_population, -0.1),
@@ -199,7 +199,7 @@ public:
         std::set<double> old_locations;
 
         bool apoptosis_cell_found = false;
-        std::list<CellPtr>::iterator cell_it = r_cells.begin();
+        std::vector<CellPtr>::iterator cell_it = r_cells.begin();
         ++cell_it;
         while (cell_it != r_cells.end() && !apoptosis_cell_found)
         {
@@ -220,7 +220,7 @@ public:
         p_simulation_time->IncrementTimeOneStep();
 
         // Store 'locations' of cells which are not dead
-        for (std::list<CellPtr>::iterator cell_iter = r_cells.begin();
+        for (std::vector<CellPtr>::iterator cell_iter = r_cells.begin();
             cell_iter != r_cells.end();
             ++cell_iter)
         {
@@ -237,7 +237,7 @@ public:
 
         // Check that dead cells are removed from the mesh
         std::set< double > new_locations;
-        for (std::list<CellPtr>::iterator cell_iter = r_cells.begin();
+        for (std::vector<CellPtr>::iterator cell_iter = r_cells.begin();
             cell_iter != r_cells.end();
             ++cell_iter)
         {
@@ -250,6 +250,52 @@ public:
         TS_ASSERT(new_locations == old_locations);
     }
 
+
+    void TestRandomCellKillerWithCounterBasedRandomNumbers() throw(Exception)
+    {
+        // Set up singleton classes
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(32.0, 32);
+
+        // Create mesh
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/2D_0_to_100mm_200_elements");
+        MutableMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        // Create cell population
+        MeshBasedCellPopulation<2> cell_population(mesh, cells);
+
+        // Create cell killer
+        RandomCellKiller<2> random_cell_killer(&cell_population, 0.5);
+        TS_ASSERT_EQUALS(random_cell_killer.GetUseCounterBasedRandomNumbers(), false);
+        random_cell_killer.SetUseCounterBasedRandomNumbers(true, 2u);
+        TS_ASSERT_EQUALS(random_cell_killer.GetUseCounterBasedRandomNumbers(), true);
+
+        random_cell_killer.CheckAndLabelCellsForApoptosisOrDeath();
+
+        // Whether each cell is labelled is determined by the seed, its cell ID and the time step
+        CounterBasedRandomNumberGenerator generator(2u, "RandomCellKiller");
+        double death_prob_this_timestep = 1.0 - pow(0.5, p_simulation_time->GetTimeStep());
+        unsigned num_apoptotic_cells = 0;
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            bool expect_apoptosis = (generator.ranf(cell_iter->GetCellId(), 0) < death_prob_this_timestep);
+            TS_ASSERT_EQUALS(cell_iter->HasApoptosisBegun(), expect_apoptosis);
+            if (cell_iter->HasApoptosisBegun())
+            {
+                num_apoptotic_cells++;
+            }
+        }
+        TS_ASSERT_LESS_THAN(0u, num_apoptotic_cells);
+        TS_ASSERT_LESS_THAN(num_apoptotic_cells, cell_population.GetNumRealCells());
+    }
     void TestApoptoticCellKiller() throw(Exception)
     {
         SimulationTime* p_simulation_time = SimulationTime::Instance();
@@ -281,7 +327,7 @@ public:
         ApoptoticCellKiller<2> bad_cell_killer(&cell_population);
 
         // Get a reference to the cells held in cell population
-        std::list<CellPtr>& r_cells = cell_population.rGetCells();
+        std::vector<CellPtr>& r_cells = cell_population.rGetCells();
 
         // Reset each cell to have a StemCellProliferativeType
         for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
@@ -309,7 +355,7 @@ public:
 
         // Store 'locations' of cells which are not dead
         std::set< double > old_locations;
-        for (std::list<CellPtr>::iterator cell_iter = r_cells.begin();
+        for (std::vector<CellPtr>::iterator cell_iter = r_cells.begin();
              cell_iter != r_cells.end();
              ++cell_iter)
         {
@@ -326,7 +372,7 @@ public:
 
         // Check that dead cells are removed from the mesh
         std::set< double > new_locations;
-        for (std::list<CellPtr>::iterator cell_iter = r_cells.begin();
+        for (std::vector<CellPtr>::iterator cell_iter = r_cells.begin();
              cell_iter != r_cells.end();
              ++cell_iter)
         {
@@ -604,6 +650,7 @@ public:
         {
             // Create an output archive
             RandomCellKiller<2> cell_killer(NULL, 0.134);
+            cell_killer.SetUseCounterBasedRandomNumbers(true, 4u);
 
             std::ofstream ofs(archive_filename.c_str());
             boost::archive::text_oarchive output_arch(ofs);
@@ -627,6 +674,7 @@ public:
 
             // Test we have restored the probability correctly
             TS_ASSERT_DELTA(p_cell_killer->GetDeathProbabilityInAnHour(), 0.134, 1e-9);
+            TS_ASSERT_EQUALS(p_cell_killer->GetUseCounterBasedRandomNumbers(), true);
 
             delete p_cell_killer;
         }
@@ -0,0 +1,127 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTCELLLOCATIONREGISTRY_HPP_
+#define TESTCELLLOCATIONREGISTRY_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "CellLocationRegistry.hpp"
+#include "CellsGenerator.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "AbstractCellBasedTestSuite.hpp"
+
+#include "FakePetscSetup.hpp"
+
+class TestCellLocationRegistry : public AbstractCellBasedTestSuite
+{
+public:
+
+    void TestAddAndRemoveCells() throw(Exception)
+    {
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, 4);
+
+        CellLocationRegistry registry;
+        TS_ASSERT_EQUALS(registry.rGetCellsAtLocation(7).size(), 0u);
+        TS_ASSERT_EQUALS(registry.HasCell(cells[0].get()), false);
+
+        // Several cells may share a location index
+        registry.AddCell(5, cells[0]);
+        registry.AddCell(5, cells[1]);
+        registry.AddCell(5, cells[2]);
+        registry.AddCell(2, cells[3]);
+        registry.AddCell(5, cells[1]);
+        TS_ASSERT_EQUALS(registry.rGetCellsAtLocation(5).size(), 3u);
+        TS_ASSERT_EQUALS(registry.rGetCellsAtLocation(2).size(), 1u);
+        TS_ASSERT_EQUALS(registry.rGetCellsAtLocation(0).size(), 0u);
+        TS_ASSERT_EQUALS(registry.GetLocationIndex(cells[1].get()), 5u);
+        TS_ASSERT_EQUALS(registry.GetLocationIndex(cells[3].get()), 2u);
+
+        // Removing a cell moves the last cell in the slot into its place
+        TS_ASSERT_EQUALS(registry.RemoveCell(5, cells[0]), true);
+        TS_ASSERT_EQUALS(registry.RemoveCell(5, cells[0]), false);
+        TS_ASSERT_EQUALS(registry.RemoveCell(9, cells[1]), false);
+        TS_ASSERT_EQUALS(registry.rGetCellsAtLocation(5).size(), 2u);
+        TS_ASSERT_EQUALS(registry.rGetCellsAtLocation(5)[0], cells[2]);
+        TS_ASSERT_EQUALS(registry.rGetCellsAtLocation(5)[1], cells[1]);
+        TS_ASSERT_EQUALS(registry.HasCell(cells[0].get()), false);
+
+        // Setting a cell replaces any cells already at the location index
+        registry.SetCell(5, cells[0]);
+        TS_ASSERT_EQUALS(registry.rGetCellsAtLocation(5).size(), 1u);
+        TS_ASSERT_EQUALS(registry.rGetCellsAtLocation(5)[0], cells[0]);
+        TS_ASSERT_EQUALS(registry.GetLocationIndex(cells[0].get()), 5u);
+
+        registry.Clear();
+        TS_ASSERT_EQUALS(registry.rGetCellsAtLocation(5).size(), 0u);
+        TS_ASSERT_EQUALS(registry.HasCell(cells[3].get()), false);
+    }
+
+    void TestConversionToAndFromMaps() throw(Exception)
+    {
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, 3);
+
+        CellLocationRegistry registry;
+        registry.AddCell(0, cells[0]);
+        registry.AddCell(3, cells[1]);
+        registry.AddCell(3, cells[2]);
+
+        std::map<unsigned, std::set<CellPtr> > location_cell_map;
+        std::map<Cell*, unsigned> cell_location_map;
+        registry.GetMaps(location_cell_map, cell_location_map);
+        TS_ASSERT_EQUALS(location_cell_map.size(), 2u);
+        TS_ASSERT_EQUALS(location_cell_map[3].size(), 2u);
+        TS_ASSERT_EQUALS(cell_location_map.size(), 3u);
+        TS_ASSERT_EQUALS(cell_location_map[cells[2].get()], 3u);
+
+        // A cell listed under a location index it has left is not restored there
+        location_cell_map[1].insert(cells[0]);
+
+        CellLocationRegistry restored_registry;
+        restored_registry.SetMaps(location_cell_map, cell_location_map);
+        TS_ASSERT_EQUALS(restored_registry.rGetCellsAtLocation(0).size(), 1u);
+        TS_ASSERT_EQUALS(restored_registry.rGetCellsAtLocation(1).size(), 0u);
+        TS_ASSERT_EQUALS(restored_registry.rGetCellsAtLocation(3).size(), 2u);
+        TS_ASSERT_EQUALS(restored_registry.GetLocationIndex(cells[0].get()), 0u);
+        TS_ASSERT_EQUALS(restored_registry.GetLocationIndex(cells[1].get()), 3u);
+    }
+};
+
+#endif /*TESTCELLLOCATIONREGISTRY_HPP_*/
@@ -101,7 +101,7 @@ public:
 
         // Impose boundary condition
         std::map<Node<2>*, c_vector<double,2> > old_locations;
-        for (std::list<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
+        for (std::vector<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
              cell_iter != cell_population.rGetCells().end();
              ++cell_iter)
         {
@@ -112,7 +112,7 @@ public:
         boundary_condition.ImposeBoundaryCondition(old_locations);
 
         // Test that all nodes satisfy the boundary condition
-        for (std::list<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
+        for (std::vector<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
              cell_iter != cell_population.rGetCells().end();
              ++cell_iter)
         {
@@ -168,7 +168,7 @@ public:
 
         // Impose boundary condition
         std::map<Node<2>*, c_vector<double,2> > old_locations;
-        for (std::list<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
+        for (std::vector<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
              cell_iter != cell_population.rGetCells().end();
              ++cell_iter)
         {
@@ -380,7 +380,7 @@ public:
         // Store the location of each node prior to imposing the boundary condition
         std::map<Node<3>*, c_vector<double,3> > old_locations;
 
-        for (std::list<CellPtr>::iterator cell_iter = population_3d.rGetCells().begin();
+        for (std::vector<CellPtr>::iterator cell_iter = population_3d.rGetCells().begin();
              cell_iter != population_3d.rGetCells().end();
              ++cell_iter)
         {
@@ -392,7 +392,7 @@ public:
 
         bc_3d.ImposeBoundaryCondition(old_locations);
 
-        for (std::list<CellPtr>::iterator cell_iter = population_3d.rGetCells().begin();
+        for (std::vector<CellPtr>::iterator cell_iter = population_3d.rGetCells().begin();
              cell_iter != population_3d.rGetCells().end();
              ++cell_iter)
         {
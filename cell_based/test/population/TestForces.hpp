@@ -200,6 +200,79 @@ public:
         TS_ASSERT_DELTA(force_on_spring[1], 0.0, 1e-4);
     }
 
+    void TestGeneralisedLinearSpringForceWithSpringTable() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator doesn't work in parallel.
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 10);
+
+        HoneycombMeshGenerator generator(6, 6, 2);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+        std::vector<unsigned> location_indices = generator.GetCellLocationIndices();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, location_indices.size(), location_indices);
+
+        MeshBasedCellPopulationWithGhostNodes<2> cell_population(*p_mesh, cells, location_indices);
+
+        // Perturb the nodes, so that the springs have different lengths and directions
+        for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+        {
+            ChastePoint<2> new_point(p_mesh->GetNode(i)->rGetLocation()[0] + 0.1*sin(1.0*i),
+                                     p_mesh->GetNode(i)->rGetLocation()[1] + 0.1*cos(2.0*i));
+            p_mesh->SetNode(i, new_point, false);
+        }
+
+        // Make the cells at the ends of one spring newly divided, and another cell apoptotic
+        cell_population.UpdateSpringTable();
+        CellPtr p_cell_a = cell_population.rGetSpringCellsA()[0];
+        CellPtr p_cell_b = cell_population.rGetSpringCellsB()[0];
+        p_cell_a->SetBirthTime(-0.25);
+        p_cell_b->SetBirthTime(-0.25);
+        std::pair<CellPtr,CellPtr> cell_pair = cell_population.CreateCellPair(p_cell_a, p_cell_b);
+        cell_population.MarkSpring(cell_pair);
+        cell_population.rGetSpringCellsA()[5]->StartApoptosis();
+
+        GeneralisedLinearSpringForce<2> linear_force;
+
+        // Compare the spring table kernel with the force between each pair of nodes, with and without a cutoff
+        for (unsigned run=0; run<2; run++)
+        {
+            if (run == 1)
+            {
+                linear_force.SetCutOffLength(1.05);
+            }
+
+            std::vector<c_vector<double, 2> > expected_forces(p_mesh->GetNumNodes(), zero_vector<double>(2));
+            for (MeshBasedCellPopulation<2>::SpringIterator spring_iterator = cell_population.SpringsBegin();
+                 spring_iterator != cell_population.SpringsEnd();
+                 ++spring_iterator)
+            {
+                unsigned node_a_index = spring_iterator.GetNodeA()->GetIndex();
+                unsigned node_b_index = spring_iterator.GetNodeB()->GetIndex();
+                c_vector<double, 2> force = linear_force.CalculateForceBetweenNodes(node_a_index, node_b_index, cell_population);
+                expected_forces[node_a_index] += force;
+                expected_forces[node_b_index] -= force;
+            }
+
+            for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+            {
+                cell_population.GetNode(i)->ClearAppliedForce();
+            }
+            linear_force.AddForceContribution(cell_population);
+
+            for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+            {
+                TS_ASSERT_DELTA(cell_population.GetNode(i)->rGetAppliedForce()[0], expected_forces[i][0], 1e-12);
+                TS_ASSERT_DELTA(cell_population.GetNode(i)->rGetAppliedForce()[1], expected_forces[i][1], 1e-12);
+            }
+        }
+
+        // The newly divided cells are still joined by a marked spring
+        TS_ASSERT(cell_population.IsMarkedSpring(cell_pair));
+    }
+
     void TestGeneralisedLinearSpringForceCalculationIn1d() throw (Exception)
     {
         // Create a 1D mesh with nodes equally spaced a unit distance apart
@@ -1951,6 +2024,89 @@ public:
         RandomNumberGenerator::Destroy();
     }
 
+    void TestDiffusionForceWithCounterBasedRandomNumbers()
+    {
+        // Set up time parameters
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0,1);
+
+        // Create a NodeBasedCellPopulation
+        std::vector<Node<2>*> nodes;
+        nodes.push_back(new Node<2>(0, true, 0.0, 0.0));
+        nodes.push_back(new Node<2>(1, true, 1.0, 0.0));
+
+        NodesOnlyMesh<2> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 100.0);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+        cell_population.Update();
+
+        DiffusionForce<2> force;
+        TS_ASSERT_EQUALS(force.GetUseCounterBasedRandomNumbers(), false);
+        force.SetUseCounterBasedRandomNumbers(true, 3u);
+        TS_ASSERT_EQUALS(force.GetUseCounterBasedRandomNumbers(), true);
+
+        // The forces are the same however the random number generator singleton is seeded
+        std::vector<c_vector<double,2> > first_forces;
+        for (unsigned repeat=0; repeat<2; repeat++)
+        {
+            RandomNumberGenerator::Instance()->Reseed(repeat);
+
+            for (AbstractMesh<2,2>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                node_iter->ClearAppliedForce();
+            }
+
+            force.AddForceContribution(cell_population);
+
+            for (AbstractMesh<2,2>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                if (repeat == 0)
+                {
+                    first_forces.push_back(node_iter->rGetAppliedForce());
+                }
+                else
+                {
+                    unsigned node_index = node_iter->GetIndex();
+                    TS_ASSERT_DELTA(node_iter->rGetAppliedForce()[0], first_forces[node_index][0], 1e-12);
+                    TS_ASSERT_DELTA(node_iter->rGetAppliedForce()[1], first_forces[node_index][1], 1e-12);
+                }
+            }
+        }
+
+        // Each force is determined by the seed, node index and time step
+        CounterBasedRandomNumberGenerator generator(3u, "DiffusionForce");
+        double dt = SimulationTime::Instance()->GetTimeStep();
+        for (unsigned node_index=0; node_index<2; node_index++)
+        {
+            double nu = cell_population.GetDampingConstant(node_index);
+            double diffusion_constant = force.GetDiffusionScalingConstant()/mesh.GetNode(node_index)->GetRadius();
+            for (unsigned i=0; i<2; i++)
+            {
+                double expected_force = (nu*sqrt(2.0*diffusion_constant*dt)/dt)*generator.StandardNormalRandomDeviate(node_index, 0, i);
+                TS_ASSERT_DELTA(first_forces[node_index][i], expected_force, 1e-9*fabs(expected_force));
+            }
+        }
+        TS_ASSERT_DIFFERS(first_forces[0][0], first_forces[1][0]);
+
+        // Avoid memory leak
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+
+        // Tidy up
+        SimulationTime::Destroy();
+        RandomNumberGenerator::Destroy();
+    }
+
     void TestDiffusionForceWithVertexBasedCellPopulation()
     {
         // Define the seed
@@ -2136,6 +2292,7 @@ public:
 
         {
             DiffusionForce<2> force;
+            force.SetUseCounterBasedRandomNumbers(true, 5u);
 
             std::ofstream ofs(archive_filename.c_str());
             boost::archive::text_oarchive output_arch(ofs);
@@ -2158,6 +2315,7 @@ public:
             // Test member variables
             TS_ASSERT_DELTA((static_cast<DiffusionForce<2>*>(p_force))->GetAbsoluteTemperature(), 296.0, 1e-6);
             TS_ASSERT_DELTA((static_cast<DiffusionForce<2>*>(p_force))->GetViscosity(), 3.204e-6, 1e-6);
+            TS_ASSERT_EQUALS((static_cast<DiffusionForce<2>*>(p_force))->GetUseCounterBasedRandomNumbers(), true);
 
             // Tidy up
             delete p_force;
@@ -0,0 +1,267 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTHDF5CELLDATAWRITER_HPP_
+#define TESTHDF5CELLDATAWRITER_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "AbstractCellBasedTestSuite.hpp"
+#include "Hdf5CellDataWriter.hpp"
+#include "Hdf5CellDataConverter.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "CellsGenerator.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "WildTypeCellMutationState.hpp"
+#include "StemCellProliferativeType.hpp"
+#include "SimulationTime.hpp"
+#include "FileFinder.hpp"
+#include "SmartPointers.hpp"
+#include "CellAgesWriter.hpp"
+#include "CellIdWriter.hpp"
+
+#include "PetscSetupAndFinalize.hpp"
+
+class TestHdf5CellDataWriter : public AbstractCellBasedTestSuite
+{
+private:
+
+    /**
+     * Helper method to create a node-based population of three cells with ages 0.7, 1.2 and 1.7.
+     *
+     * @param rMesh an empty mesh, which is filled with nodes
+     * @param rCells filled with the cells
+     */
+    void SetUpCellsAndMesh(NodesOnlyMesh<2>& rMesh, std::vector<CellPtr>& rCells)
+    {
+        std::vector<Node<2>* > nodes;
+        nodes.push_back(new Node<2>(0, false,  1.4));
+        nodes.push_back(new Node<2>(1, false,  2.3));
+        nodes.push_back(new Node<2>(2, false, -6.1));
+        rMesh.ConstructNodesWithoutMesh(nodes, 1.5);
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+
+        boost::shared_ptr<AbstractCellProperty> p_healthy_state(CellPropertyRegistry::Instance()->Get<WildTypeCellMutationState>());
+        boost::shared_ptr<AbstractCellProperty> p_type(CellPropertyRegistry::Instance()->Get<StemCellProliferativeType>());
+        for (unsigned i=0; i<rMesh.GetNumNodes(); i++)
+        {
+            FixedG1GenerationalCellCycleModel* p_cell_model = new FixedG1GenerationalCellCycleModel();
+            CellPtr p_cell(new Cell(p_healthy_state, p_cell_model));
+            p_cell->SetCellProliferativeType(p_type);
+            p_cell->SetBirthTime(-0.7 - i*0.5);
+            rCells.push_back(p_cell);
+        }
+    }
+
+public:
+
+    void TestWriterAndConverter() throw (Exception)
+    {
+        EXIT_IF_PARALLEL; // The expected values below assume all cells are on one process
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(25, 2);
+
+        NodesOnlyMesh<2> mesh;
+        std::vector<CellPtr> cells;
+        SetUpCellsAndMesh(mesh, cells);
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+
+        std::vector<boost::shared_ptr<AbstractCellWriter<2,2> > > cell_writers;
+        cell_writers.push_back(boost::shared_ptr<AbstractCellWriter<2,2> >(new CellAgesWriter<2,2>()));
+        cell_writers.push_back(boost::shared_ptr<AbstractCellWriter<2,2> >(new CellIdWriter<2,2>()));
+
+        std::string output_directory = "TestHdf5CellDataWriter";
+        OutputFileHandler output_file_handler(output_directory);
+
+        // Write two time steps
+        Hdf5CellDataWriter<2,2> writer;
+        TS_ASSERT_EQUALS(writer.GetFileName(), "results.h5");
+        TS_ASSERT_EQUALS(writer.GetUseCompression(), false);
+        TS_ASSERT_THROWS_THIS(writer.WriteTimeStep(&cell_population, cell_writers),
+                              "OpenOutputFile() must be called before WriteTimeStep().");
+
+        writer.OpenOutputFile(output_file_handler);
+        writer.WriteTimeStep(&cell_population, cell_writers);
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        writer.WriteTimeStep(&cell_population, cell_writers);
+        TS_ASSERT_EQUALS(writer.GetNumTimeStepsWritten(), 2u);
+        writer.CloseFile();
+
+        // Read the file back
+        FileFinder h5_file = output_file_handler.FindFile("results.h5");
+        TS_ASSERT_THROWS_CONTAINS(Hdf5CellDataConverter<3> wrong_dimension(h5_file),
+                                  "does not contain cell data of dimension 3");
+
+        Hdf5CellDataConverter<2> converter(h5_file);
+        TS_ASSERT_EQUALS(converter.GetNumTimeSteps(), 2u);
+        TS_ASSERT_DELTA(converter.rGetTimes()[0], 0.0, 1e-12);
+        TS_ASSERT_DELTA(converter.rGetTimes()[1], 12.5, 1e-12);
+        TS_ASSERT_EQUALS(converter.rGetVariableNames().size(), 2u);
+        TS_ASSERT_EQUALS(converter.rGetVariableNames()[0], "Ages");
+        TS_ASSERT_EQUALS(converter.rGetVariableNames()[1], "Cell IDs");
+
+        std::vector<unsigned> cell_ids;
+        std::vector<unsigned> location_indices;
+        std::vector<c_vector<double, 2> > locations;
+        std::vector<std::vector<double> > data;
+        converter.ReadTimeStep(1, cell_ids, location_indices, locations, data);
+        TS_ASSERT_EQUALS(cell_ids.size(), 3u);
+
+        unsigned i = 0;
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter, ++i)
+        {
+            TS_ASSERT_EQUALS(cell_ids[i], cell_iter->GetCellId());
+            TS_ASSERT_EQUALS(location_indices[i], cell_population.GetLocationIndexUsingCell(*cell_iter));
+            c_vector<double, 2> location = cell_population.GetLocationOfCellCentre(*cell_iter);
+            TS_ASSERT_DELTA(locations[i][0], location[0], 1e-12);
+            TS_ASSERT_DELTA(locations[i][1], location[1], 1e-12);
+            TS_ASSERT_DELTA(data[0][i], cell_iter->GetAge(), 1e-12);
+            TS_ASSERT_DELTA(data[1][i], cell_iter->GetCellId(), 1e-12);
+        }
+        TS_ASSERT_DELTA(data[0][0], 13.2, 1e-12);
+
+        TS_ASSERT_THROWS_THIS(converter.ReadTimeStep(2, cell_ids, location_indices, locations, data),
+                              "Time step 2 is not in the file, which has 2 time steps.");
+
+        // Convert to the text format used by CellDataItemWriter
+        OutputFileHandler txt_handler(output_directory + "/txt");
+        converter.WriteTxtFiles(txt_handler);
+
+        std::ifstream ages_file((txt_handler.GetOutputDirectoryFullPath() + "Ages.dat").c_str());
+        std::string line;
+        std::getline(ages_file, line);
+        TS_ASSERT_EQUALS(line, "0\t0 0 1.4 0 0.7 1 1 2.3 0 1.2 2 2 -6.1 0 1.7 ");
+        std::getline(ages_file, line);
+        TS_ASSERT_EQUALS(line, "12.5\t0 0 1.4 0 13.2 1 1 2.3 0 13.7 2 2 -6.1 0 14.2 ");
+        TS_ASSERT(output_file_handler.FindFile("txt/Cell_IDs.dat").IsFile());
+
+        // Convert to VTK
+        converter.WriteVtkFiles(output_directory + "/vtk");
+#ifdef CHASTE_VTK
+        TS_ASSERT(output_file_handler.FindFile("vtk/results.pvd").IsFile());
+        TS_ASSERT(output_file_handler.FindFile("vtk/results_1.vtu").IsFile());
+#endif //CHASTE_VTK
+    }
+
+    void TestCompressedOutput() throw (Exception)
+    {
+#if !(H5_VERS_MAJOR > 1 || (H5_VERS_MAJOR == 1 && (H5_VERS_MINOR > 10 || (H5_VERS_MINOR == 10 && H5_VERS_RELEASE >= 2))))
+        EXIT_IF_PARALLEL; // Older versions of HDF5 cannot write compressed data in parallel
+#endif
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(25, 2);
+
+        NodesOnlyMesh<2> mesh;
+        std::vector<CellPtr> cells;
+        SetUpCellsAndMesh(mesh, cells);
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+
+        std::vector<boost::shared_ptr<AbstractCellWriter<2,2> > > cell_writers;
+        cell_writers.push_back(boost::shared_ptr<AbstractCellWriter<2,2> >(new CellAgesWriter<2,2>()));
+
+        OutputFileHandler output_file_handler("TestHdf5CellDataWriterCompressed");
+        Hdf5CellDataWriter<2,2> writer("compressed.h5", true);
+        TS_ASSERT_EQUALS(writer.GetUseCompression(), true);
+        writer.OpenOutputFile(output_file_handler);
+        writer.WriteTimeStep(&cell_population, cell_writers);
+        writer.CloseFile();
+
+        // Every process reads the whole file, which holds all the cells
+        Hdf5CellDataConverter<2> converter(output_file_handler.FindFile("compressed.h5"));
+        TS_ASSERT_EQUALS(converter.GetNumTimeSteps(), 1u);
+
+        std::vector<unsigned> cell_ids;
+        std::vector<unsigned> location_indices;
+        std::vector<c_vector<double, 2> > locations;
+        std::vector<std::vector<double> > data;
+        converter.ReadTimeStep(0, cell_ids, location_indices, locations, data);
+        TS_ASSERT_EQUALS(cell_ids.size(), 3u);
+
+        double total_age = 0.0;
+        for (unsigned i=0; i<data[0].size(); i++)
+        {
+            total_age += data[0][i];
+        }
+        TS_ASSERT_DELTA(total_age, 0.7 + 1.2 + 1.7, 1e-12);
+    }
+
+    void TestPopulationHdf5CellOutput() throw (Exception)
+    {
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(25, 2);
+
+        NodesOnlyMesh<2> mesh;
+        std::vector<CellPtr> cells;
+        SetUpCellsAndMesh(mesh, cells);
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+        cell_population.AddCellWriter<CellAgesWriter>();
+
+        TS_ASSERT_EQUALS(cell_population.GetUseHdf5CellOutput(), false);
+        TS_ASSERT_EQUALS(cell_population.GetCompressHdf5CellOutput(), false);
+        cell_population.SetUseHdf5CellOutput(true);
+        TS_ASSERT_EQUALS(cell_population.GetUseHdf5CellOutput(), true);
+
+        std::string output_directory = "TestPopulationHdf5CellOutput";
+        OutputFileHandler output_file_handler(output_directory);
+        cell_population.OpenWritersFiles(output_file_handler);
+        cell_population.WriteResultsToFiles(output_directory);
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        cell_population.WriteResultsToFiles(output_directory);
+        cell_population.CloseWritersFiles();
+
+        // The cell writers' data are in the HDF5 file rather than in text files
+        TS_ASSERT(!output_file_handler.FindFile("cellages.dat").Exists());
+        TS_ASSERT(output_file_handler.FindFile("results.viznodes").IsFile());
+
+        Hdf5CellDataConverter<2> converter(output_file_handler.FindFile("results.h5"));
+        TS_ASSERT_EQUALS(converter.GetNumTimeSteps(), 2u);
+        TS_ASSERT_EQUALS(converter.rGetVariableNames().size(), 2u);
+        TS_ASSERT_EQUALS(converter.rGetVariableNames()[0], "Ages");
+        TS_ASSERT_EQUALS(converter.rGetVariableNames()[1], "Cell types");
+
+        std::vector<unsigned> cell_ids;
+        std::vector<unsigned> location_indices;
+        std::vector<c_vector<double, 2> > locations;
+        std::vector<std::vector<double> > data;
+        converter.ReadTimeStep(1, cell_ids, location_indices, locations, data);
+        TS_ASSERT_EQUALS(cell_ids.size(), 3u);
+    }
+};
+
+#endif /*TESTHDF5CELLDATAWRITER_HPP_*/
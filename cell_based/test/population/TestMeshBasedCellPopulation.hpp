@@ -61,6 +61,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "DifferentiatedCellProliferativeType.hpp"
 #include "ApoptoticCellProperty.hpp"
 #include "FixedCentreBasedDivisionRule.hpp"
+#include "CellBasedProfiler.hpp"
 
 // Cell writers
 #include "CellAgesWriter.hpp"
@@ -87,6 +88,28 @@ class TestMeshBasedCellPopulation : public AbstractCellBasedTestSuite
 {
 private:
 
+    void CheckSpringTableMatchesSpringIterator(MeshBasedCellPopulation<2>& rCellPopulation)
+    {
+        rCellPopulation.UpdateSpringTable();
+
+        unsigned spring_index = 0;
+        for (MeshBasedCellPopulation<2>::SpringIterator spring_iterator = rCellPopulation.SpringsBegin();
+             spring_iterator != rCellPopulation.SpringsEnd();
+             ++spring_iterator)
+        {
+            TS_ASSERT_LESS_THAN(spring_index, rCellPopulation.GetNumSprings());
+            if (spring_index < rCellPopulation.GetNumSprings())
+            {
+                TS_ASSERT_EQUALS(rCellPopulation.rGetSpringNodeIndicesA()[spring_index], spring_iterator.GetNodeA()->GetIndex());
+                TS_ASSERT_EQUALS(rCellPopulation.rGetSpringNodeIndicesB()[spring_index], spring_iterator.GetNodeB()->GetIndex());
+                TS_ASSERT_EQUALS(rCellPopulation.rGetSpringCellsA()[spring_index], spring_iterator.GetCellA());
+                TS_ASSERT_EQUALS(rCellPopulation.rGetSpringCellsB()[spring_index], spring_iterator.GetCellB());
+            }
+            spring_index++;
+        }
+        TS_ASSERT_EQUALS(rCellPopulation.GetNumSprings(), spring_index);
+    }
+
     template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
     void TestSmallMeshBasedCellPopulation(std::string meshFilename)
     {
@@ -243,7 +266,7 @@ public:
         MeshBasedCellPopulation<2> cell_population(mesh, cells);
 
         // Create two cell pairs
-        std::list<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
+        std::vector<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
         CellPtr cell_0 = *cell_iter++;
         CellPtr cell_1 = *cell_iter;
         std::pair<CellPtr,CellPtr> cell_pair1 = cell_population.CreateCellPair(cell_0, cell_1);
@@ -362,6 +385,110 @@ public:
         TS_ASSERT_DELTA(area_based_damping_const, cell_population.GetDampingConstantNormal(), 1e-6);
     }
 
+    void TestIncrementalVoronoiTessellation()
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator doesn't work in parallel
+
+        HoneycombMeshGenerator generator(5, 5, 0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        TS_ASSERT_EQUALS(cell_population.GetUseIncrementalVoronoiTessellation(), false);
+        cell_population.SetUseIncrementalVoronoiTessellation(true);
+        TS_ASSERT_EQUALS(cell_population.GetUseIncrementalVoronoiTessellation(), true);
+
+        cell_population.CreateVoronoiTessellation();
+        VertexMesh<2,2>* p_tessellation = cell_population.GetVoronoiTessellation();
+        TS_ASSERT_DELTA(cell_population.GetVolumeOfVoronoiElement(12), 0.5*sqrt(3.0), 1e-6);
+        TS_ASSERT_DELTA(cell_population.GetSurfaceAreaOfVoronoiElement(12), 2.0*sqrt(3.0), 1e-6);
+
+        // Move an interior node without changing the triangulation
+        p_mesh->SetNode(12, ChastePoint<2>(p_mesh->GetNode(12)->rGetLocation()[0] + 0.05, p_mesh->GetNode(12)->rGetLocation()[1]), true);
+
+        // The existing tessellation is updated, and the cached areas of the changed elements recomputed
+        cell_population.CreateVoronoiTessellation();
+        TS_ASSERT_EQUALS(cell_population.GetVoronoiTessellation(), p_tessellation);
+
+        VertexMesh<2,2> new_tessellation(*p_mesh);
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            TS_ASSERT_DELTA(cell_population.GetVolumeOfVoronoiElement(node_index), new_tessellation.GetVolumeOfElement(node_index), 1e-12);
+            TS_ASSERT_DELTA(cell_population.GetSurfaceAreaOfVoronoiElement(node_index), new_tessellation.GetSurfaceAreaOfElement(node_index), 1e-12);
+        }
+        TS_ASSERT_DELTA(cell_population.GetVolumeOfCell(cell_population.GetCellUsingLocationIndex(12)), new_tessellation.GetVolumeOfElement(12), 1e-12);
+
+        // After a change in topology the tessellation is regenerated
+        p_mesh->AddNode(new Node<2>(p_mesh->GetNumNodes(), false, 2.0, 5.0));
+        p_mesh->ReMesh();
+        cell_population.CreateVoronoiTessellation();
+        TS_ASSERT_EQUALS(cell_population.GetVoronoiTessellation()->GetNumElements(), 26u);
+
+        VertexMesh<2,2> regenerated_tessellation(*p_mesh);
+        TS_ASSERT_DELTA(cell_population.GetVolumeOfVoronoiElement(12), regenerated_tessellation.GetVolumeOfElement(12), 1e-12);
+    }
+
+    void TestSpringTable()
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator doesn't work in parallel
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 1);
+
+        HoneycombMeshGenerator generator(5, 5, 0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        CellBasedProfiler* p_profiler = CellBasedProfiler::Instance();
+        p_profiler->Reset();
+        p_profiler->Enable();
+        unsigned rebuilds = p_profiler->GetCounterIndex("spring table rebuilds");
+
+        // The spring table lists the springs visited by SpringIterator, in the same order
+        CheckSpringTableMatchesSpringIterator(cell_population);
+        unsigned num_springs = cell_population.GetNumSprings();
+        TS_ASSERT_LESS_THAN(0u, num_springs);
+        TS_ASSERT_EQUALS(p_profiler->GetCounterTotal(rebuilds), 1u);
+
+        // Without variable rest lengths, every spring has rest length 1
+        TS_ASSERT_EQUALS(cell_population.rGetSpringRestLengths().size(), num_springs);
+        TS_ASSERT_DELTA(cell_population.rGetSpringRestLengths()[10], 1.0, 1e-12);
+
+        // The table is not rebuilt if nodes move without changing the connectivity of the mesh
+        p_mesh->SetNode(12, ChastePoint<2>(p_mesh->GetNode(12)->rGetLocation()[0] + 0.05, p_mesh->GetNode(12)->rGetLocation()[1]), true);
+        cell_population.UpdateSpringTable();
+        TS_ASSERT_EQUALS(p_profiler->GetCounterTotal(rebuilds), 1u);
+
+        // Changes to rest lengths are picked up without rebuilding the table
+        cell_population.CalculateRestLengths();
+        unsigned node_a = cell_population.rGetSpringNodeIndicesA()[10];
+        unsigned node_b = cell_population.rGetSpringNodeIndicesB()[10];
+        TS_ASSERT_DELTA(cell_population.rGetSpringRestLengths()[10], cell_population.GetRestLength(node_a, node_b), 1e-12);
+        cell_population.SetRestLength(node_a, node_b, 0.7);
+        TS_ASSERT_DELTA(cell_population.rGetSpringRestLengths()[10], 0.7, 1e-12);
+        cell_population.UpdateSpringTable();
+        TS_ASSERT_EQUALS(p_profiler->GetCounterTotal(rebuilds), 1u);
+
+        // Removing a cell changes the springs, so the table is rebuilt
+        cell_population.GetCellUsingLocationIndex(12)->Kill();
+        cell_population.RemoveDeadCells();
+        cell_population.Update();
+        CheckSpringTableMatchesSpringIterator(cell_population);
+        TS_ASSERT_EQUALS(p_profiler->GetCounterTotal(rebuilds), 2u);
+        TS_ASSERT_LESS_THAN(cell_population.GetNumSprings(), num_springs);
+
+        p_profiler->Disable();
+        p_profiler->Reset();
+    }
+
     void TestSetNodeAndAddCell()
     {
         // Create a simple mesh
@@ -208,6 +208,13 @@ public:
 
         std::set<unsigned> neighbours_of_cell_0 = cell_population.GetNeighbouringLocationIndices(*(cell_population.Begin()));
         TS_ASSERT(neighbours_of_cell_0 == expected_neighbours_of_cell_0);
+
+        // Test the neighbour adjacency also excludes ghost nodes
+        unsigned index_of_cell_0 = cell_population.GetLocationIndexUsingCell(*(cell_population.Begin()));
+        std::set<unsigned> adjacent_to_cell_0(cell_population.GetNeighbouringLocationsBegin(index_of_cell_0),
+                                              cell_population.GetNeighbouringLocationsEnd(index_of_cell_0));
+        TS_ASSERT_EQUALS(cell_population.GetNumNeighbouringLocations(index_of_cell_0), 2u);
+        TS_ASSERT(adjacent_to_cell_0 == expected_neighbours_of_cell_0);
     }
 
     void TestCellPopulationIteratorWithNoCells()
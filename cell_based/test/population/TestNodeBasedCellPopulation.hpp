@@ -523,6 +523,64 @@ public:
         }
     }
 
+    void TestCellsStayInOrderAndIteratorsStayValid()
+    {
+        EXIT_IF_PARALLEL;
+
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(10.0, 1);
+
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_128_elements");
+        TetrahedralMesh<2,2> generating_mesh;
+        generating_mesh.ConstructFromMeshReader(mesh_reader);
+        NodesOnlyMesh<2> mesh;
+        mesh.ConstructNodesWithoutMesh(generating_mesh, 1.2);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+
+        // Kill several cells, and check that removing them keeps the other cells in order
+        std::vector<CellPtr> original_cells = cell_population.rGetCells();
+        original_cells[0]->Kill();
+        original_cells[27]->Kill();
+        original_cells[28]->Kill();
+        original_cells[80]->Kill();
+        TS_ASSERT_EQUALS(cell_population.RemoveDeadCells(), 4u);
+
+        std::vector<CellPtr> expected_cells;
+        for (unsigned i=0; i<original_cells.size(); i++)
+        {
+            if (!original_cells[i]->IsDead())
+            {
+                expected_cells.push_back(original_cells[i]);
+            }
+        }
+        TS_ASSERT_EQUALS(cell_population.rGetCells().size(), 77u);
+        TS_ASSERT(cell_population.rGetCells() == expected_cells);
+
+        // An end iterator taken before a cell is added during iteration still marks the end, and the new cell is visited
+        AbstractCellPopulation<2>::Iterator end_iter = cell_population.End();
+        AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+        TS_ASSERT_EQUALS(*cell_iter, expected_cells[0]);
+
+        boost::shared_ptr<AbstractCellProperty> p_state(new WildTypeCellMutationState);
+        CellPtr p_cell(new Cell(p_state, new FixedG1GenerationalCellCycleModel()));
+        p_cell->SetCellProliferativeType(expected_cells[0]->GetCellProliferativeType());
+        p_cell->SetBirthTime(-1.0);
+        CellPtr p_child_cell = cell_population.AddCell(p_cell, *cell_iter);
+
+        std::vector<CellPtr> visited_cells;
+        for ( ; cell_iter != end_iter; ++cell_iter)
+        {
+            visited_cells.push_back(*cell_iter);
+        }
+        TS_ASSERT_EQUALS(visited_cells.size(), 78u);
+        TS_ASSERT_EQUALS(visited_cells.back(), p_child_cell);
+        TS_ASSERT(!(cell_population.End() != end_iter));
+    }
+
     void TestAddAndRemoveAndAddWithOutRemovingDeletedNodesSmallCutOff()
     {
         SimulationTime* p_simulation_time = SimulationTime::Instance();
@@ -813,6 +871,22 @@ public:
 
             TS_ASSERT_EQUALS(node_4_neighbours.size(), expected_node_4_neighbours.size());
             TS_ASSERT_EQUALS(node_4_neighbours, expected_node_4_neighbours);
+
+            // Test the neighbour adjacency gives the same neighbours
+            TS_ASSERT_EQUALS(node_based_cell_population.GetNumNeighbouringLocations(0), 0u);
+            TS_ASSERT_EQUALS(node_based_cell_population.GetNumNeighbouringLocations(4), 3u);
+            std::set<unsigned> adjacent_to_node_4(node_based_cell_population.GetNeighbouringLocationsBegin(4),
+                                                  node_based_cell_population.GetNeighbouringLocationsEnd(4));
+            TS_ASSERT_EQUALS(adjacent_to_node_4, expected_node_4_neighbours);
+
+            // Moving node 0 next to node 4 makes them neighbours, without calling Update()
+            ChastePoint<2> new_location(0.3, 0.3);
+            node_based_cell_population.SetNode(0, new_location);
+
+            TS_ASSERT_EQUALS(node_based_cell_population.GetNumNeighbouringLocations(4), 4u);
+            TS_ASSERT_EQUALS(*(node_based_cell_population.GetNeighbouringLocationsBegin(4)), 0u);
+            TS_ASSERT_EQUALS(node_based_cell_population.GetNumNeighbouringLocations(0), 1u);
+            TS_ASSERT_EQUALS(*(node_based_cell_population.GetNeighbouringLocationsBegin(0)), 4u);
         }
     }
 
@@ -1441,6 +1515,8 @@ public:
             }
 
             p_cell_population->SetUseVariableRadii(true);
+            p_cell_population->SetUseHdf5CellOutput(true, true);
+            p_cell_population->SetUseAsynchronousVtkOutput(true);
 
             // Create an output archive
             ArchiveOpener<boost::archive::text_oarchive, std::ofstream> arch_opener(archive_dir, archive_file);
@@ -1506,6 +1582,9 @@ public:
             // Check the member variables have been restored
             TS_ASSERT_DELTA(p_cell_population->GetMechanicsCutOffLength(), 1.5, 1e-9);
             TS_ASSERT(p_cell_population->GetUseVariableRadii());
+            TS_ASSERT(p_cell_population->GetUseHdf5CellOutput());
+            TS_ASSERT(p_cell_population->GetCompressHdf5CellOutput());
+            TS_ASSERT(p_cell_population->GetUseAsynchronousVtkOutput());
 
             // Tidy up
             delete p_cell_population;
@@ -257,6 +257,36 @@ public:
         }
     }
 
+    void TestRefreshHaloCellsWithPackedMessages() throw (Exception)
+    {
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->GetUsePackedHaloMessages(), false);
+        mpNodeBasedCellPopulation->SetUsePackedHaloMessages(true);
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->GetUsePackedHaloMessages(), true);
+
+        // The first update sends the halo cells in full
+        mpNodeBasedCellPopulation->Update();
+        std::vector<CellPtr> first_halo_cells = mpNodeBasedCellPopulation->mHaloCells;
+
+        // Later updates reuse the same halo cells, updated from plain data
+        mpNodeBasedCellPopulation->Update();
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->mHaloCells.size(), first_halo_cells.size());
+        for (unsigned i=0; i<first_halo_cells.size(); i++)
+        {
+            TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->mHaloCells[i], first_halo_cells[i]);
+            unsigned location_index = mpNodeBasedCellPopulation->mHaloCellLocationMap[first_halo_cells[i]];
+            TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->GetCellUsingLocationIndex(location_index), first_halo_cells[i]);
+        }
+
+        if (!PetscTools::AmMaster() && !PetscTools::AmTopMost())
+        {
+           TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->mHaloCells.size(), 2u);
+        }
+        else if (!PetscTools::AmMaster() || !PetscTools::AmTopMost())
+        {
+           TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->mHaloCells.size(), 1u);
+        }
+    }
+
     void TestUpdateWithLoadBalanceDoesntThrow() throw (Exception)
     {
         SimulationTime* p_simulation_time = SimulationTime::Instance();
@@ -271,6 +301,32 @@ public:
         TS_ASSERT_THROWS_NOTHING(mpNodeBasedCellPopulation->Update());
     }
 
+    void TestUpdateWithOneStepSlabLoadBalanceDoesntThrow() throw (Exception)
+    {
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(10.0, 1);
+
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->GetUseOneStepSlabLoadBalance(), false);
+
+        mpNodeBasedCellPopulation->SetLoadBalanceMesh(true);
+        mpNodeBasedCellPopulation->SetUseOneStepSlabLoadBalance(true);
+        mpNodeBasedCellPopulation->SetLoadBalanceFrequency(50);
+
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->GetUseOneStepSlabLoadBalance(), true);
+
+        unsigned num_local_cells = mpNodeBasedCellPopulation->GetNumRealCells();
+        unsigned total_cells_before;
+        MPI_Allreduce(&num_local_cells, &total_cells_before, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+
+        TS_ASSERT_THROWS_NOTHING(mpNodeBasedCellPopulation->Update());
+
+        // Cells may have moved process, but none are lost or duplicated
+        num_local_cells = mpNodeBasedCellPopulation->GetNumRealCells();
+        unsigned total_cells_after;
+        MPI_Allreduce(&num_local_cells, &total_cells_after, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+        TS_ASSERT_EQUALS(total_cells_after, total_cells_before);
+    }
+
     void TestGetCellUsingLocationIndexWithHaloCell() throw (Exception)
     {
         boost::shared_ptr<Node<3> > p_node(new Node<3>(10, false, 0.0, 0.0, 0.0));
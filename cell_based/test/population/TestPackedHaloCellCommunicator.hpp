@@ -0,0 +1,199 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTPACKEDHALOCELLCOMMUNICATOR_HPP_
+#define TESTPACKEDHALOCELLCOMMUNICATOR_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "CheckpointArchiveTypes.hpp"
+
+#include "PackedHaloCellCommunicator.hpp"
+#include "CellsGenerator.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "CellData.hpp"
+#include "SmartPointers.hpp"
+#include "AbstractCellBasedTestSuite.hpp"
+
+#include "FakePetscSetup.hpp"
+
+class TestPackedHaloCellCommunicator : public AbstractCellBasedTestSuite
+{
+private:
+
+    /**
+     * Pass a message from one communicator to another without MPI.
+     *
+     * @param rSender the sending communicator
+     * @param rReceiver the receiving communicator
+     * @param rCellsToSend the halo cells to send
+     * @return the halo cells received
+     */
+    std::vector<std::pair<CellPtr, Node<2>* > > PassCells(PackedHaloCellCommunicator<2>& rSender,
+                                                           PackedHaloCellCommunicator<2>& rReceiver,
+                                                           const std::vector<std::pair<CellPtr, Node<2>* > >& rCellsToSend)
+    {
+        rSender.Pack(rCellsToSend);
+        rReceiver.mRecvBuffer = rSender.mSendBuffer;
+        return rReceiver.Unpack();
+    }
+
+    /**
+     * Delete the nodes of received halo cells.
+     *
+     * @param rCells the received halo cells
+     */
+    void DeleteNodes(std::vector<std::pair<CellPtr, Node<2>* > >& rCells)
+    {
+        for (unsigned i=0; i<rCells.size(); i++)
+        {
+            delete rCells[i].second;
+        }
+    }
+
+public:
+
+    void TestPackAndUnpackHaloCells() throw(Exception)
+    {
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, 3);
+
+        std::vector<Node<2>*> nodes;
+        for (unsigned i=0; i<3; i++)
+        {
+            nodes.push_back(new Node<2>(10+i, false, 1.0*i, 2.0));
+            nodes[i]->SetRadius(0.5);
+            cells[i]->GetCellData()->SetItem("volume", 1.0+i);
+        }
+
+        std::vector<std::pair<CellPtr, Node<2>* > > cells_to_send;
+        cells_to_send.push_back(std::pair<CellPtr, Node<2>* >(cells[0], nodes[0]));
+        cells_to_send.push_back(std::pair<CellPtr, Node<2>* >(cells[1], nodes[1]));
+
+        PackedHaloCellCommunicator<2> sender;
+        PackedHaloCellCommunicator<2> receiver;
+
+        // The first time cells are sent they are serialised in full, so are new objects
+        std::vector<std::pair<CellPtr, Node<2>* > > received = PassCells(sender, receiver, cells_to_send);
+        TS_ASSERT_EQUALS(received.size(), 2u);
+        TS_ASSERT_EQUALS(received[0].second->GetIndex(), 10u);
+        TS_ASSERT_EQUALS(received[1].second->GetIndex(), 11u);
+        TS_ASSERT_DELTA(received[1].second->rGetLocation()[0], 1.0, 1e-12);
+        TS_ASSERT_DELTA(received[1].first->GetCellData()->GetItem("volume"), 2.0, 1e-12);
+        TS_ASSERT(received[0].first != cells[0]);
+        CellPtr p_received_cell = received[1].first;
+        DeleteNodes(received);
+
+        // Once held by the receiver, a cell is updated in place from plain data
+        nodes[1]->rGetModifiableLocation()[0] = 1.5;
+        nodes[1]->SetRadius(0.7);
+        cells[1]->SetBirthTime(-3.0);
+        cells[1]->GetCellData()->SetItem("volume", 5.0);
+        cells_to_send.push_back(std::pair<CellPtr, Node<2>* >(cells[2], nodes[2]));
+
+        received = PassCells(sender, receiver, cells_to_send);
+        TS_ASSERT_EQUALS(received.size(), 3u);
+        TS_ASSERT_EQUALS(received[1].first, p_received_cell);
+        TS_ASSERT_EQUALS(received[1].second->GetIndex(), 11u);
+        TS_ASSERT_DELTA(received[1].second->rGetLocation()[0], 1.5, 1e-12);
+        TS_ASSERT_DELTA(received[1].second->GetRadius(), 0.7, 1e-12);
+        TS_ASSERT_DELTA(p_received_cell->GetBirthTime(), -3.0, 1e-12);
+        TS_ASSERT_DELTA(p_received_cell->GetCellData()->GetItem("volume"), 5.0, 1e-12);
+
+        // The new cell is serialised in full, after the packed cells
+        TS_ASSERT_EQUALS(received[2].second->GetIndex(), 12u);
+        TS_ASSERT_DELTA(received[2].first->GetCellData()->GetItem("volume"), 3.0, 1e-12);
+        DeleteNodes(received);
+
+        // A cell with a new CellData item is serialised in full again
+        cells[1]->GetCellData()->SetItem("area", 4.0);
+        received = PassCells(sender, receiver, cells_to_send);
+        TS_ASSERT_EQUALS(received.size(), 3u);
+        TS_ASSERT_EQUALS(received[2].second->GetIndex(), 11u);
+        TS_ASSERT(received[2].first != p_received_cell);
+        TS_ASSERT_DELTA(received[2].first->GetCellData()->GetItem("area"), 4.0, 1e-12);
+        DeleteNodes(received);
+
+        // A different cell reusing a node index is serialised in full
+        cells_to_send.resize(1);
+        cells_to_send[0].first = cells[2];
+        received = PassCells(sender, receiver, cells_to_send);
+        TS_ASSERT_EQUALS(received.size(), 1u);
+        TS_ASSERT_EQUALS(received[0].second->GetIndex(), 10u);
+        TS_ASSERT_DELTA(received[0].first->GetCellData()->GetItem("volume"), 3.0, 1e-12);
+        DeleteNodes(received);
+
+        // A cell whose CellData has different keys, but as many, is serialised in full again
+        cells[2]->RemoveCellProperty<CellData>();
+        MAKE_PTR(CellData, p_new_cell_data);
+        p_new_cell_data->SetItem("length", 6.0);
+        cells[2]->AddCellProperty(p_new_cell_data);
+        received = PassCells(sender, receiver, cells_to_send);
+        TS_ASSERT_EQUALS(received.size(), 1u);
+        TS_ASSERT_DELTA(received[0].first->GetCellData()->GetItem("length"), 6.0, 1e-12);
+        TS_ASSERT_EQUALS(received[0].first->GetCellData()->GetNumItems(), 1u);
+        CellPtr p_held_cell = received[0].first;
+        DeleteNodes(received);
+
+        // After the sender is reset, every cell is serialised in full, which the receiver accepts
+        sender.Reset();
+        received = PassCells(sender, receiver, cells_to_send);
+        TS_ASSERT_EQUALS(received.size(), 1u);
+        TS_ASSERT(received[0].first != p_held_cell);
+        TS_ASSERT_DELTA(received[0].first->GetCellData()->GetItem("length"), 6.0, 1e-12);
+        DeleteNodes(received);
+
+        // The next message updates the cell in place again
+        p_held_cell = received[0].first;
+        received = PassCells(sender, receiver, cells_to_send);
+        TS_ASSERT_EQUALS(received[0].first, p_held_cell);
+        DeleteNodes(received);
+
+        // A receiver that does not hold a cell cannot update it
+        PackedHaloCellCommunicator<2> new_receiver;
+        sender.Pack(cells_to_send);
+        new_receiver.mRecvBuffer = sender.mSendBuffer;
+        TS_ASSERT_THROWS_THIS(new_receiver.Unpack(), "The halo cell at node 10 has not been received in full");
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+};
+
+#endif /*TESTPACKEDHALOCELLCOMMUNICATOR_HPP_*/
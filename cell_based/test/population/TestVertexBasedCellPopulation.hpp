@@ -164,6 +164,11 @@ public:
         std::set<unsigned> neighbours_of_cell_0 = cell_population.GetNeighbouringLocationIndices(*(cell_population.Begin()));
         TS_ASSERT(neighbours_of_cell_0 == expected_neighbours_of_cell_0);
 
+        // Test the neighbour adjacency gives the same neighbours
+        TS_ASSERT_EQUALS(cell_population.GetNumNeighbouringLocations(0), 2u);
+        std::set<unsigned> adjacent_to_cell_0(cell_population.GetNeighbouringLocationsBegin(0), cell_population.GetNeighbouringLocationsEnd(0));
+        TS_ASSERT(adjacent_to_cell_0 == expected_neighbours_of_cell_0);
+
         // For coverage, test that GetDefaultTimeStep() returns the correct value
         TS_ASSERT_DELTA(cell_population.GetDefaultTimeStep(), 0.002, 1e-6);
     }
@@ -0,0 +1,384 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCELLBASEDBENCHMARKS_HPP_
+#define TESTCELLBASEDBENCHMARKS_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+// Must be included before other cell_based headers
+#include "CellBasedSimulationArchiver.hpp"
+
+#include <sstream>
+#include <boost/shared_ptr.hpp>
+
+#include "AbstractCellBasedTestSuite.hpp"
+#include "CellBasedBenchmark.hpp"
+#include "CellBasedEventHandler.hpp"
+#include "CommandLineArguments.hpp"
+#include "OffLatticeSimulation.hpp"
+#include "OnLatticeSimulation.hpp"
+#include "HoneycombMeshGenerator.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "PottsMeshGenerator.hpp"
+#include "CellsGenerator.hpp"
+#include "NoCellCycleModel.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "MeshBasedCellPopulation.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "PottsBasedCellPopulation.hpp"
+#include "CaBasedCellPopulation.hpp"
+#include "GeneralisedLinearSpringForce.hpp"
+#include "NagaiHondaForce.hpp"
+#include "SimpleTargetAreaModifier.hpp"
+#include "VolumeConstraintPottsUpdateRule.hpp"
+#include "AdhesionPottsUpdateRule.hpp"
+#include "DiffusionCaUpdateRule.hpp"
+#include "AveragedSourceEllipticPde.hpp"
+#include "ConstBoundaryCondition.hpp"
+#include "EllipticBoxDomainPdeModifier.hpp"
+#include "SmartPointers.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * This class benchmarks each type of cell population, with and without a PDE,
+ * on square populations of non-proliferating cells of increasing size.
+ *
+ * Results are written to CellBasedBenchmarks/benchmark_results.csv and may be compared
+ * against a stored baseline with python/utils/CompareCellBasedBenchmarks.py.
+ *
+ * The number of cells across each population may be set with the command line option
+ * -benchmark_sizes (default 10 20 40), and the numbers of warm-up and measured time
+ * steps with -benchmark_steps (default 5 25).
+ */
+class TestCellBasedBenchmarks : public AbstractCellBasedTestSuite
+{
+private:
+
+    /** The benchmark, which records the results of every test in this suite. */
+    boost::shared_ptr<CellBasedBenchmark> mpBenchmark;
+
+    /**
+     * @return the number of cells across each population to benchmark.
+     */
+    std::vector<unsigned> GetSizes()
+    {
+        if (CommandLineArguments::Instance()->OptionExists("-benchmark_sizes"))
+        {
+            return CommandLineArguments::Instance()->GetUnsignedsCorrespondingToOption("-benchmark_sizes");
+        }
+        std::vector<unsigned> sizes;
+        sizes.push_back(10);
+        sizes.push_back(20);
+        sizes.push_back(40);
+        return sizes;
+    }
+
+    /**
+     * Run a benchmark, resetting the singletons used by the simulation first.
+     *
+     * @param rName the name of the benchmark
+     * @param numCellsAcross the number of cells across the population
+     * @param rSimulator the simulation
+     */
+    void RunBenchmark(const std::string& rName, unsigned numCellsAcross, AbstractCellBasedSimulation<2>& rSimulator)
+    {
+        if (!mpBenchmark)
+        {
+            unsigned num_warm_up_steps = 5;
+            unsigned num_measured_steps = 25;
+            if (CommandLineArguments::Instance()->OptionExists("-benchmark_steps"))
+            {
+                num_warm_up_steps = CommandLineArguments::Instance()->GetUnsignedCorrespondingToOption("-benchmark_steps", 1);
+                num_measured_steps = CommandLineArguments::Instance()->GetUnsignedCorrespondingToOption("-benchmark_steps", 2);
+            }
+            mpBenchmark.reset(new CellBasedBenchmark("CellBasedBenchmarks", num_warm_up_steps, num_measured_steps));
+        }
+
+        std::stringstream name;
+        name << rName << "_" << numCellsAcross*numCellsAcross;
+        rSimulator.SetOutputDirectory("CellBasedBenchmarks/" + name.str());
+
+        // Only write results at the start and end of the simulation, outside the timed time steps
+        rSimulator.SetSamplingTimestepMultiple(1000000);
+
+        unsigned num_modifiers = rSimulator.GetSimulationModifiers()->size();
+        mpBenchmark->Run(name.str(), rSimulator);
+
+        // No cells divide or die
+        TS_ASSERT_DELTA(mpBenchmark->GetNumCells(), numCellsAcross*numCellsAcross, 1e-6);
+        TS_ASSERT_LESS_THAN(0.0, mpBenchmark->GetCellStepsPerSecond());
+        TS_ASSERT_LESS_THAN(0.0, mpBenchmark->GetPeakMemory());
+
+        // Only the time loop is timed, and the benchmark's timer is removed afterwards
+        TS_ASSERT_DELTA(mpBenchmark->rGetEventTimes()[CellBasedEventHandler::SETUP], 0.0, 1e-12);
+        TS_ASSERT_EQUALS(rSimulator.GetSimulationModifiers()->size(), num_modifiers);
+    }
+
+    /**
+     * Add an elliptic PDE, solved on a box domain covering the cell population, to a simulation.
+     *
+     * @param rSimulator the simulation
+     * @param rCellPopulation the cell population
+     */
+    void AddPde(AbstractCellBasedSimulation<2>& rSimulator, AbstractCellPopulation<2>& rCellPopulation)
+    {
+        MAKE_PTR_ARGS(AveragedSourceEllipticPde<2>, p_pde, (rCellPopulation, -0.1));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+        ChasteCuboid<2> cuboid = rCellPopulation.rGetMesh().CalculateBoundingBox();
+        MAKE_PTR_ARGS(EllipticBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, false, &cuboid));
+        p_pde_modifier->SetDependentVariableName("nutrient");
+        rSimulator.AddSimulationModifier(p_pde_modifier);
+    }
+
+    /**
+     * Create non-proliferating cells.
+     *
+     * @param rCells filled with the cells
+     * @param numCells the number of cells
+     * @param rLocationIndices the location indices of the cells (may be empty)
+     */
+    void GenerateCells(std::vector<CellPtr>& rCells, unsigned numCells, const std::vector<unsigned>& rLocationIndices=std::vector<unsigned>())
+    {
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+        CellsGenerator<NoCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(rCells, numCells, rLocationIndices, p_diff_type);
+    }
+
+    void BenchmarkNodeBased(unsigned numCellsAcross, bool withPde)
+    {
+        HoneycombMeshGenerator generator(numCellsAcross, numCellsAcross, 0);
+        TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+        NodesOnlyMesh<2> mesh;
+        mesh.ConstructNodesWithoutMesh(*p_generating_mesh, 1.5);
+
+        std::vector<CellPtr> cells;
+        GenerateCells(cells, mesh.GetNumNodes());
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+
+        OffLatticeSimulation<2> simulator(cell_population);
+        MAKE_PTR(GeneralisedLinearSpringForce<2>, p_force);
+        p_force->SetCutOffLength(1.5);
+        simulator.AddForce(p_force);
+        if (withPde)
+        {
+            AddPde(simulator, cell_population);
+        }
+
+        RunBenchmark(withPde ? "NodeBasedWithPde" : "NodeBased", numCellsAcross, simulator);
+    }
+
+    void BenchmarkMeshBased(unsigned numCellsAcross, bool withPde)
+    {
+        HoneycombMeshGenerator generator(numCellsAcross, numCellsAcross, 0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        GenerateCells(cells, p_mesh->GetNumNodes());
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        OffLatticeSimulation<2> simulator(cell_population);
+        MAKE_PTR(GeneralisedLinearSpringForce<2>, p_force);
+        simulator.AddForce(p_force);
+        if (withPde)
+        {
+            AddPde(simulator, cell_population);
+        }
+
+        RunBenchmark(withPde ? "MeshBasedWithPde" : "MeshBased", numCellsAcross, simulator);
+    }
+
+    void BenchmarkVertexBased(unsigned numCellsAcross, bool withPde)
+    {
+        HoneycombVertexMeshGenerator generator(numCellsAcross, numCellsAcross);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        GenerateCells(cells, p_mesh->GetNumElements());
+        VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        OffLatticeSimulation<2> simulator(cell_population);
+        MAKE_PTR(NagaiHondaForce<2>, p_force);
+        simulator.AddForce(p_force);
+        MAKE_PTR(SimpleTargetAreaModifier<2>, p_growth_modifier);
+        simulator.AddSimulationModifier(p_growth_modifier);
+        if (withPde)
+        {
+            AddPde(simulator, cell_population);
+        }
+
+        RunBenchmark(withPde ? "VertexBasedWithPde" : "VertexBased", numCellsAcross, simulator);
+    }
+
+    void BenchmarkPottsBased(unsigned numCellsAcross, bool withPde)
+    {
+        // Cells of 4 by 4 lattice sites, with a margin of medium around them
+        PottsMeshGenerator<2> generator(5*numCellsAcross, numCellsAcross, 4, 5*numCellsAcross, numCellsAcross, 4);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        GenerateCells(cells, p_mesh->GetNumElements());
+        PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        OnLatticeSimulation<2> simulator(cell_population);
+        simulator.SetDt(0.1);
+        MAKE_PTR(VolumeConstraintPottsUpdateRule<2>, p_volume_constraint_update_rule);
+        p_volume_constraint_update_rule->SetMatureCellTargetVolume(16);
+        simulator.AddUpdateRule(p_volume_constraint_update_rule);
+        MAKE_PTR(AdhesionPottsUpdateRule<2>, p_adhesion_update_rule);
+        simulator.AddUpdateRule(p_adhesion_update_rule);
+        if (withPde)
+        {
+            AddPde(simulator, cell_population);
+        }
+
+        RunBenchmark(withPde ? "PottsBasedWithPde" : "PottsBased", numCellsAcross, simulator);
+    }
+
+    void BenchmarkCaBased(unsigned numCellsAcross, bool withPde)
+    {
+        // A square block of cells in the middle of a lattice twice as wide
+        unsigned num_sites_across = 2*numCellsAcross;
+        PottsMeshGenerator<2> generator(num_sites_across, 0, 0, num_sites_across, 0, 0);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        std::vector<unsigned> location_indices;
+        for (unsigned j=numCellsAcross/2; j<numCellsAcross/2 + numCellsAcross; j++)
+        {
+            for (unsigned i=numCellsAcross/2; i<numCellsAcross/2 + numCellsAcross; i++)
+            {
+                location_indices.push_back(i + j*num_sites_across);
+            }
+        }
+
+        std::vector<CellPtr> cells;
+        GenerateCells(cells, location_indices.size(), location_indices);
+        CaBasedCellPopulation<2> cell_population(*p_mesh, cells, location_indices);
+
+        OnLatticeSimulation<2> simulator(cell_population);
+        MAKE_PTR(DiffusionCaUpdateRule<2>, p_diffusion_update_rule);
+        simulator.AddUpdateRule(p_diffusion_update_rule);
+        if (withPde)
+        {
+            AddPde(simulator, cell_population);
+        }
+
+        RunBenchmark(withPde ? "CaBasedWithPde" : "CaBased", numCellsAcross, simulator);
+    }
+
+    /**
+     * Reset the singletons used by a simulation, so that each benchmark starts from time zero.
+     */
+    void ResetSingletons()
+    {
+        tearDown();
+        setUp();
+    }
+
+public:
+
+    void TestNodeBasedBenchmarks() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator does not work in parallel
+
+        std::vector<unsigned> sizes = GetSizes();
+        for (unsigned i=0; i<sizes.size(); i++)
+        {
+            ResetSingletons();
+            BenchmarkNodeBased(sizes[i], false);
+            ResetSingletons();
+            BenchmarkNodeBased(sizes[i], true);
+        }
+    }
+
+    void TestMeshBasedBenchmarks() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator does not work in parallel
+
+        std::vector<unsigned> sizes = GetSizes();
+        for (unsigned i=0; i<sizes.size(); i++)
+        {
+            ResetSingletons();
+            BenchmarkMeshBased(sizes[i], false);
+            ResetSingletons();
+            BenchmarkMeshBased(sizes[i], true);
+        }
+    }
+
+    void TestVertexBasedBenchmarks() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;
+
+        std::vector<unsigned> sizes = GetSizes();
+        for (unsigned i=0; i<sizes.size(); i++)
+        {
+            ResetSingletons();
+            BenchmarkVertexBased(sizes[i], false);
+            ResetSingletons();
+            BenchmarkVertexBased(sizes[i], true);
+        }
+    }
+
+    void TestPottsBasedBenchmarks() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;
+
+        std::vector<unsigned> sizes = GetSizes();
+        for (unsigned i=0; i<sizes.size(); i++)
+        {
+            ResetSingletons();
+            BenchmarkPottsBased(sizes[i], false);
+            ResetSingletons();
+            BenchmarkPottsBased(sizes[i], true);
+        }
+    }
+
+    void TestCaBasedBenchmarks() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;
+
+        std::vector<unsigned> sizes = GetSizes();
+        for (unsigned i=0; i<sizes.size(); i++)
+        {
+            ResetSingletons();
+            BenchmarkCaBased(sizes[i], false);
+            ResetSingletons();
+            BenchmarkCaBased(sizes[i], true);
+        }
+    }
+};
+
+#endif /*TESTCELLBASEDBENCHMARKS_HPP_*/
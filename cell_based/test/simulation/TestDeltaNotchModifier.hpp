@@ -139,6 +139,71 @@ public:
         TS_ASSERT_DELTA(mean_delta, 1.0000, 1e-04);
     }
 
+    void TestUpdateAtEndOfTimeStepNodeBasedWithBatchedOdes() throw(Exception)
+    {
+        EXIT_IF_PARALLEL;
+
+        // Create the same population as in TestUpdateAtEndOfTimeStepNodeBased()
+        HoneycombMeshGenerator generator(2, 2, 0);
+        MutableMesh<2,2>* p_generating_mesh = generator.GetMesh();
+        NodesOnlyMesh<2> mesh;
+        mesh.ConstructNodesWithoutMesh(*p_generating_mesh, 1.5);
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(WildTypeCellMutationState, p_state);
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+
+        std::vector<double> initial_conditions;
+        initial_conditions.push_back(1.0);
+        initial_conditions.push_back(1.0);
+
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            UniformCellCycleModel* p_cc_model = new UniformCellCycleModel();
+            p_cc_model->SetDimension(2);
+
+            DeltaNotchSrnModel* p_srn_model = new DeltaNotchSrnModel();
+            p_srn_model->SetInitialConditions(initial_conditions);
+            CellPtr p_cell(new Cell(p_state, p_cc_model, p_srn_model));
+            p_cell->SetCellProliferativeType(p_diff_type);
+            p_cell->SetBirthTime(0.0);
+            cells.push_back(p_cell);
+        }
+
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+
+        OffLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory("TestDeltaNotchNodeBasedWithBatchedOdes");
+        simulator.SetEndTime(0.01);
+
+        // Integrate the SRN models in a single pass before cell divisions are processed
+        TS_ASSERT_EQUALS(simulator.GetSolveCellOdesInBatches(), false);
+        simulator.SetSolveCellOdesInBatches(true);
+        TS_ASSERT_EQUALS(simulator.GetSolveCellOdesInBatches(), true);
+
+        MAKE_PTR(DeltaNotchTrackingModifier<2>, p_modifier);
+        simulator.AddSimulationModifier(p_modifier);
+
+        simulator.Solve();
+
+        // Each SRN model has been simulated to the end time
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            TS_ASSERT_DELTA(cell_iter->GetSrnModel()->GetSimulatedToTime(), 0.01, 1e-10);
+        }
+
+        // The levels in cell 0 are the same as when the ODEs are solved lazily
+        CellPtr cell0 = cell_population.rGetCells().front();
+        double notch = dynamic_cast<DeltaNotchSrnModel*>(cell0->GetSrnModel())->GetNotch();
+        TS_ASSERT_DELTA(notch, 0.9999, 1e-04);
+        double delta = dynamic_cast<DeltaNotchSrnModel*>(cell0->GetSrnModel())->GetDelta();
+        TS_ASSERT_DELTA(delta, 0.9901, 1e-04);
+        double mean_delta = dynamic_cast<DeltaNotchSrnModel*>(cell0->GetSrnModel())->GetMeanNeighbouringDelta();
+        TS_ASSERT_DELTA(mean_delta, 1.0000, 1e-04);
+    }
+
     void TestHeterogeneousDeltaNotchOnUntetheredTwoCellSystem()
     {
         EXIT_IF_PARALLEL;
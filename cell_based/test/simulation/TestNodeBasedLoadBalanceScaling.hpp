@@ -0,0 +1,176 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTNODEBASEDLOADBALANCESCALING_HPP_
+#define TESTNODEBASEDLOADBALANCESCALING_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "AbstractCellBasedTestSuite.hpp"
+#include "NodesOnlyMesh.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "CellsGenerator.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "GeneralisedLinearSpringForce.hpp"
+#include "CellBasedEventHandler.hpp"
+#include "Timer.hpp"
+#include "SmartPointers.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * This class times a node-based population whose cells are packed twice as
+ * densely in the lower half of the domain as in the upper half, comparing the
+ * original slab load balancing, which moves each slab boundary by at most one
+ * row per balance, with one-step slab load balancing, which places every slab
+ * boundary at once and weights each node by the measured force calculation time.
+ *
+ * This test is used for profiling strong scaling, and should be run as
+ *     mpirun -np N ...
+ * for N = 1, 2, 4, 8, 16, 32, 64 so that the reported times and load
+ * imbalances can be compared.
+ */
+class TestNodeBasedLoadBalanceScaling : public AbstractCellBasedTestSuite
+{
+private:
+
+    /**
+     * Time a fixed number of force evaluations and population updates.
+     *
+     * @param useOneStepSlabLoadBalance whether to use one-step slab load balancing
+     * @param rName the name used when printing timings
+     */
+    void TimeUpdatesOnClusteredPopulation(bool useOneStepSlabLoadBalance, const std::string& rName)
+    {
+        unsigned num_steps = 50;
+        unsigned num_across = 12;
+        unsigned num_dense_layers = 48;
+        unsigned num_sparse_layers = 24;
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, num_steps);
+
+        // Every process creates all the nodes; the mesh keeps the ones it owns
+        std::vector<Node<3>*> nodes;
+        for (unsigned k=0; k<num_dense_layers+num_sparse_layers; k++)
+        {
+            double z = (k < num_dense_layers) ? 0.5*k : 0.5*num_dense_layers + (k - num_dense_layers);
+            for (unsigned j=0; j<num_across; j++)
+            {
+                for (unsigned i=0; i<num_across; i++)
+                {
+                    nodes.push_back(new Node<3>(nodes.size(), false, (double)i, (double)j, z));
+                }
+            }
+        }
+        unsigned total_num_nodes = nodes.size();
+
+        NodesOnlyMesh<3> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 3> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes(), std::vector<unsigned>(), p_diff_type);
+
+        NodeBasedCellPopulation<3> cell_population(mesh, cells);
+        cell_population.SetLoadBalanceMesh(true);
+        cell_population.SetUseOneStepSlabLoadBalance(useOneStepSlabLoadBalance);
+        cell_population.SetLoadBalanceFrequency(10);
+
+        MAKE_PTR(GeneralisedLinearSpringForce<3>, p_force);
+        p_force->SetCutOffLength(1.5);
+
+        CellBasedEventHandler::Reset();
+        PetscTools::Barrier();
+        Timer::Reset();
+
+        for (unsigned step=0; step<num_steps; step++)
+        {
+            cell_population.Update();
+
+            CellBasedEventHandler::BeginEvent(CellBasedEventHandler::FORCE);
+            for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                node_iter->ClearAppliedForce();
+            }
+            p_force->AddForceContribution(cell_population);
+            CellBasedEventHandler::EndEvent(CellBasedEventHandler::FORCE);
+
+            SimulationTime::Instance()->IncrementTimeOneStep();
+        }
+
+        PetscTools::Barrier();
+        double elapsed_time = Timer::GetElapsedTime();
+
+        // Compare the busiest process with a perfectly even split of the nodes
+        unsigned num_local_nodes = mesh.GetNumNodes();
+        unsigned max_num_local_nodes;
+        unsigned num_nodes;
+        MPI_Allreduce(&num_local_nodes, &max_num_local_nodes, 1, MPI_UNSIGNED, MPI_MAX, PETSC_COMM_WORLD);
+        MPI_Allreduce(&num_local_nodes, &num_nodes, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+        TS_ASSERT_EQUALS(num_nodes, total_num_nodes);
+
+        double imbalance = max_num_local_nodes*PetscTools::GetNumProcs()/(double)num_nodes;
+
+        if (PetscTools::AmMaster())
+        {
+            std::cout << rName << " on " << PetscTools::GetNumProcs() << " processes: "
+                      << elapsed_time << "s for " << num_steps << " steps, node imbalance "
+                      << imbalance << "\n" << std::flush;
+        }
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
+public:
+
+    void TestSlabLoadBalanceScalingForProfiling() throw (Exception)
+    {
+        TimeUpdatesOnClusteredPopulation(false, "Slab load balancing");
+    }
+
+    void TestOneStepSlabLoadBalanceScalingForProfiling() throw (Exception)
+    {
+        TimeUpdatesOnClusteredPopulation(true, "One-step slab load balancing");
+    }
+};
+
+#endif /*TESTNODEBASEDLOADBALANCESCALING_HPP_*/
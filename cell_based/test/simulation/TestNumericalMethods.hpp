@@ -65,6 +65,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileComparison.hpp"
 #include "PopulationTestingForce.hpp"
 #include "ForwardEulerNumericalMethod.hpp"
+#include "RungeKutta23NumericalMethod.hpp"
+#include "BackwardEulerNumericalMethod.hpp"
+#include "PlaneBoundaryCondition.hpp"
+#include "OutputFileHandler.hpp"
 #include "Warnings.hpp"
 
 
@@ -473,6 +477,297 @@ public:
         }
     }
 
+    void TestUpdateAllNodePositionsWithRungeKutta23() throw(Exception)
+    {
+        EXIT_IF_PARALLEL;    // This test doesn't work in parallel.
+
+        HoneycombMeshGenerator generator(3, 3, 0);
+        TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+
+        MAKE_PTR(NodesOnlyMesh<2>, p_mesh);
+        p_mesh->ConstructNodesWithoutMesh(*p_generating_mesh, 2.0);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        NodeBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        cell_population.SetDampingConstantNormal(1.1);
+
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+        force_collection.push_back(p_test_force);
+
+        MAKE_PTR(RungeKutta23NumericalMethod<2>, p_rk_method);
+        p_rk_method->SetCellPopulation(&cell_population);
+        p_rk_method->SetForceCollection(&force_collection);
+
+        TS_ASSERT(p_rk_method->HasAdaptiveTimestep());
+        TS_ASSERT_DELTA(p_rk_method->GetAbsoluteTolerance(), 1e-3, 1e-12);
+        TS_ASSERT_DELTA(p_rk_method->GetCurrentStep(), 0.0, 1e-12);
+
+        std::vector<c_vector<double, 2> > old_posns(cell_population.GetNumNodes());
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            old_posns[j] = cell_population.GetNode(j)->rGetLocation();
+        }
+
+        // With a loose tolerance the whole time step is taken as one third order step
+        double dt = 0.01;
+        p_rk_method->SetAbsoluteTolerance(1.0);
+        p_rk_method->UpdateAllNodePositions(dt);
+
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            double damping = cell_population.GetDampingConstant(j);
+            for (unsigned d=0; d<2; d++)
+            {
+                double z = dt*0.01*(d+1)*j/damping;
+                double expected = old_posns[j][d]*(1.0 + z + z*z/2.0 + z*z*z/6.0);
+                TS_ASSERT_DELTA(cell_population.GetNode(j)->rGetLocation()[d], expected, 1e-12);
+            }
+        }
+
+        // The substep grows again after the step is accepted
+        TS_ASSERT_DELTA(p_rk_method->GetCurrentStep(), 5.0*dt, 1e-12);
+
+        // With a tight tolerance a long time step is split into substeps that match the exact solution
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            old_posns[j] = cell_population.GetNode(j)->rGetLocation();
+        }
+        dt = 20.0;
+        p_rk_method->SetAbsoluteTolerance(1e-8);
+        p_rk_method->UpdateAllNodePositions(dt);
+
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            double damping = cell_population.GetDampingConstant(j);
+            for (unsigned d=0; d<2; d++)
+            {
+                double expected = old_posns[j][d]*exp(dt*0.01*(d+1)*j/damping);
+                TS_ASSERT_DELTA(cell_population.GetNode(j)->rGetLocation()[d], expected, 1e-5);
+            }
+        }
+        TS_ASSERT_LESS_THAN(p_rk_method->GetCurrentStep(), dt);
+
+        // No substep can meet an impossible tolerance
+        p_rk_method->SetAbsoluteTolerance(1e-300);
+        TS_ASSERT_THROWS_THIS(p_rk_method->UpdateAllNodePositions(dt),
+            "RungeKutta23NumericalMethod could not find a small enough substep to meet the tolerance");
+    }
+
+    void TestRungeKutta23ImposesBoundaryConditionsOnEachSubstep() throw(Exception)
+    {
+        EXIT_IF_PARALLEL;    // This test doesn't work in parallel.
+
+        HoneycombMeshGenerator generator(3, 3, 0);
+        TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+
+        MAKE_PTR(NodesOnlyMesh<2>, p_mesh);
+        p_mesh->ConstructNodesWithoutMesh(*p_generating_mesh, 2.0);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        NodeBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+        force_collection.push_back(p_test_force);
+
+        // The testing force pushes nodes away from the origin, so some of them reach the plane x = 1.5
+        c_vector<double, 2> point = zero_vector<double>(2);
+        point[0] = 1.5;
+        c_vector<double, 2> normal = zero_vector<double>(2);
+        normal[0] = 1.0;
+        std::vector<boost::shared_ptr<AbstractCellPopulationBoundaryCondition<2,2> > > boundary_conditions;
+        MAKE_PTR_ARGS(PlaneBoundaryCondition<2>, p_bc, (&cell_population, point, normal));
+        boundary_conditions.push_back(p_bc);
+
+        MAKE_PTR(RungeKutta23NumericalMethod<2>, p_rk_method);
+        p_rk_method->SetCellPopulation(&cell_population);
+        p_rk_method->SetForceCollection(&force_collection);
+        p_rk_method->SetBoundaryConditions(&boundary_conditions);
+        p_rk_method->SetAbsoluteTolerance(1e-6);
+
+        // The method is called directly, so only its own substeps can have imposed the boundary condition
+        p_rk_method->UpdateAllNodePositions(20.0);
+
+        bool some_node_on_plane = false;
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            double x = cell_population.GetNode(j)->rGetLocation()[0];
+            TS_ASSERT_LESS_THAN_EQUALS(x, 1.5 + 1e-12);
+            if (fabs(x - 1.5) < 1e-12)
+            {
+                some_node_on_plane = true;
+            }
+        }
+        TS_ASSERT(some_node_on_plane);
+    }
+
+    void TestUpdateAllNodePositionsWithBackwardEuler() throw(Exception)
+    {
+        EXIT_IF_PARALLEL;    // This test doesn't work in parallel.
+
+        HoneycombMeshGenerator generator(3, 3, 0);
+        TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+
+        MAKE_PTR(NodesOnlyMesh<2>, p_mesh);
+        p_mesh->ConstructNodesWithoutMesh(*p_generating_mesh, 2.0);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        NodeBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        cell_population.SetDampingConstantNormal(1.1);
+
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+        force_collection.push_back(p_test_force);
+
+        MAKE_PTR(BackwardEulerNumericalMethod<2>, p_be_method);
+        p_be_method->SetCellPopulation(&cell_population);
+        p_be_method->SetForceCollection(&force_collection);
+
+        TS_ASSERT_EQUALS(p_be_method->GetMaxNewtonIterations(), 1u);
+        TS_ASSERT_EQUALS(p_be_method->GetMaxKrylovIterations(), 20u);
+        TS_ASSERT_DELTA(p_be_method->GetSolverTolerance(), 1e-6, 1e-12);
+
+        // The force is linear, so one Newton step gives the backward Euler solution
+        for (unsigned num_newton_iterations=1; num_newton_iterations<=3; num_newton_iterations+=2)
+        {
+            p_be_method->SetMaxNewtonIterations(num_newton_iterations);
+
+            std::vector<c_vector<double, 2> > old_posns(cell_population.GetNumNodes());
+            for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+            {
+                old_posns[j] = cell_population.GetNode(j)->rGetLocation();
+            }
+
+            double dt = 0.01;
+            p_be_method->UpdateAllNodePositions(dt);
+
+            for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+            {
+                c_vector<double, 2> actual_location = cell_population.GetNode(j)->rGetLocation();
+                double damping = cell_population.GetDampingConstant(j);
+                c_vector<double, 2> expected_location = p_test_force->GetExpectedOneStepLocationBE(j, damping, old_posns[j], dt);
+                TS_ASSERT_DELTA(norm_2(actual_location - expected_location), 0, 1e-8);
+            }
+        }
+
+        // With too few GMRES iterations the solution is only approximate, but Newton's method corrects it
+        p_be_method->SetMaxKrylovIterations(2);
+        p_be_method->SetMaxNewtonIterations(20);
+        p_be_method->SetSolverTolerance(1e-10);
+        std::vector<c_vector<double, 2> > old_posns(cell_population.GetNumNodes());
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            old_posns[j] = cell_population.GetNode(j)->rGetLocation();
+        }
+        p_be_method->UpdateAllNodePositions(0.01);
+        for (unsigned j=0; j<cell_population.GetNumNodes(); j++)
+        {
+            c_vector<double, 2> actual_location = cell_population.GetNode(j)->rGetLocation();
+            double damping = cell_population.GetDampingConstant(j);
+            c_vector<double, 2> expected_location = p_test_force->GetExpectedOneStepLocationBE(j, damping, old_posns[j], 0.01);
+            TS_ASSERT_DELTA(norm_2(actual_location - expected_location), 0, 1e-8);
+        }
+    }
+
+    void TestNewNumericalMethodsWithBuskeUpdate() throw(Exception)
+    {
+        EXIT_IF_PARALLEL;    // This test doesn't work in parallel.
+
+        HoneycombMeshGenerator generator(3, 3, 0);
+        TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+
+        MAKE_PTR(NodesOnlyMesh<2>, p_mesh);
+        p_mesh->ConstructNodesWithoutMesh(*p_generating_mesh, 2.0);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        NodeBasedCellPopulationWithBuskeUpdate<2> cell_population(*p_mesh, cells);
+
+        std::vector<boost::shared_ptr<AbstractForce<2,2> > > force_collection;
+        MAKE_PTR(PopulationTestingForce<2>, p_test_force);
+        force_collection.push_back(p_test_force);
+
+        // Both methods delegate to the population, as ForwardEulerNumericalMethod does (see #2087)
+        MAKE_PTR(RungeKutta23NumericalMethod<2>, p_rk_method);
+        p_rk_method->SetCellPopulation(&cell_population);
+        p_rk_method->SetForceCollection(&force_collection);
+        TS_ASSERT_THROWS_THIS(p_rk_method->UpdateAllNodePositions(0.01),"You must provide a rowPreallocation argument for a large sparse system");
+
+        MAKE_PTR(BackwardEulerNumericalMethod<2>, p_be_method);
+        p_be_method->SetCellPopulation(&cell_population);
+        p_be_method->SetForceCollection(&force_collection);
+        TS_ASSERT_THROWS_THIS(p_be_method->UpdateAllNodePositions(0.01),"You must provide a rowPreallocation argument for a large sparse system");
+
+        Warnings::QuietDestroy();
+    }
+
+    void TestArchivingAndOutputOfNewNumericalMethods() throw(Exception)
+    {
+        OutputFileHandler handler("TestNumericalMethods", false);
+        std::string archive_filename = handler.GetOutputDirectoryFullPath() + "numerical_methods.arch";
+
+        {
+            boost::shared_ptr<AbstractNumericalMethod<2,2> > p_rk_method(new RungeKutta23NumericalMethod<2,2>());
+            boost::static_pointer_cast<RungeKutta23NumericalMethod<2,2> >(p_rk_method)->SetAbsoluteTolerance(0.02);
+
+            boost::shared_ptr<AbstractNumericalMethod<2,2> > p_be_method(new BackwardEulerNumericalMethod<2,2>());
+            boost::static_pointer_cast<BackwardEulerNumericalMethod<2,2> >(p_be_method)->SetMaxNewtonIterations(4);
+            boost::static_pointer_cast<BackwardEulerNumericalMethod<2,2> >(p_be_method)->SetMaxKrylovIterations(7);
+            boost::static_pointer_cast<BackwardEulerNumericalMethod<2,2> >(p_be_method)->SetSolverTolerance(1e-4);
+
+            std::ofstream ofs(archive_filename.c_str());
+            boost::archive::text_oarchive output_arch(ofs);
+            output_arch << p_rk_method;
+            output_arch << p_be_method;
+
+            out_stream p_parameter_file = handler.OpenOutputFile("numerical_methods.parameters");
+            p_rk_method->OutputNumericalMethodInfo(p_parameter_file);
+            p_be_method->OutputNumericalMethodInfo(p_parameter_file);
+            p_parameter_file->close();
+        }
+
+        {
+            boost::shared_ptr<AbstractNumericalMethod<2,2> > p_rk_method;
+            boost::shared_ptr<AbstractNumericalMethod<2,2> > p_be_method;
+
+            std::ifstream ifs(archive_filename.c_str(), std::ios::binary);
+            boost::archive::text_iarchive input_arch(ifs);
+            input_arch >> p_rk_method;
+            input_arch >> p_be_method;
+
+            RungeKutta23NumericalMethod<2,2>* p_rk = dynamic_cast<RungeKutta23NumericalMethod<2,2>*>(p_rk_method.get());
+            TS_ASSERT(p_rk != NULL);
+            TS_ASSERT_DELTA(p_rk->GetAbsoluteTolerance(), 0.02, 1e-12);
+            TS_ASSERT(p_rk->HasAdaptiveTimestep());
+
+            BackwardEulerNumericalMethod<2,2>* p_be = dynamic_cast<BackwardEulerNumericalMethod<2,2>*>(p_be_method.get());
+            TS_ASSERT(p_be != NULL);
+            TS_ASSERT_EQUALS(p_be->GetMaxNewtonIterations(), 4u);
+            TS_ASSERT_EQUALS(p_be->GetMaxKrylovIterations(), 7u);
+            TS_ASSERT_DELTA(p_be->GetSolverTolerance(), 1e-4, 1e-12);
+        }
+
+        // Check the parameters were written
+        std::ifstream parameter_file((handler.GetOutputDirectoryFullPath() + "numerical_methods.parameters").c_str());
+        std::string contents((std::istreambuf_iterator<char>(parameter_file)), std::istreambuf_iterator<char>());
+        TS_ASSERT_DIFFERS(contents.find("<RungeKutta23NumericalMethod-2-2>"), std::string::npos);
+        TS_ASSERT_DIFFERS(contents.find("<AbsoluteTolerance>0.02</AbsoluteTolerance>"), std::string::npos);
+        TS_ASSERT_DIFFERS(contents.find("<BackwardEulerNumericalMethod-2-2>"), std::string::npos);
+        TS_ASSERT_DIFFERS(contents.find("<MaxKrylovIterations>7</MaxKrylovIterations>"), std::string::npos);
+    }
+
     void TestSettingAndGettingFlags() throw (Exception)
     {
         // Create numerical methods for testing
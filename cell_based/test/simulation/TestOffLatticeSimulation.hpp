@@ -58,6 +58,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MeshBasedCellPopulationWithGhostNodes.hpp"
 #include "NumericFileComparison.hpp"
 #include "CellBasedEventHandler.hpp"
+#include "CellBasedProfiler.hpp"
 #include "WildTypeCellMutationState.hpp"
 #include "DifferentiatedCellProliferativeType.hpp"
 #include "OffLatticeSimulationWithMyStoppingEvent.hpp"
@@ -1159,6 +1160,78 @@ public:
         TS_ASSERT_EQUALS(simulator.rGetCellPopulation().GetNumNodes(), simulator.rGetCellPopulation().GetNumRealCells());
     }
 
+    void TestOffLatticeSimulationWithProfileTrace() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator does not work in parallel
+
+        // Create a simple 2D MeshBasedCellPopulation
+        HoneycombMeshGenerator generator(5, 5, 0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes());
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        cell_population.AddCellWriter<CellIdWriter>();
+
+        // Set up cell-based simulation with a force, a cell killer and a modifier
+        OffLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory("TestOffLatticeSimulationWithProfileTrace");
+        simulator.SetEndTime(0.1);
+        TS_ASSERT_EQUALS(simulator.GetOutputProfileTrace(), false);
+        simulator.SetOutputProfileTrace(true);
+        TS_ASSERT_EQUALS(simulator.GetOutputProfileTrace(), true);
+
+        MAKE_PTR(GeneralisedLinearSpringForce<2>, p_force);
+        simulator.AddForce(p_force);
+
+        c_vector<double,2> normal = zero_vector<double>(2);
+        normal[1] = -1.0;
+        MAKE_PTR_ARGS(PlaneBasedCellKiller<2>, p_killer, (&cell_population, zero_vector<double>(2), normal));
+        simulator.AddCellKiller(p_killer);
+
+        MAKE_PTR(VolumeTrackingModifier<2>, p_modifier);
+        simulator.AddSimulationModifier(p_modifier);
+
+        CellBasedProfiler* p_profiler = CellBasedProfiler::Instance();
+        p_profiler->Reset();
+        simulator.Solve();
+
+        // The profiler is only enabled for the duration of Solve()
+        TS_ASSERT_EQUALS(p_profiler->IsEnabled(), false);
+        TS_ASSERT_EQUALS(p_profiler->IsTraceFileOpen(), false);
+
+        // Each force, cell killer, modifier and writer has its own timer
+        unsigned num_steps = 12; // 0.1/(1/120), rounded
+        unsigned index;
+        TS_ASSERT_EQUALS(p_profiler->FindTimer("Force:GeneralisedLinearSpringForce-2-2", index), true);
+        TS_ASSERT_EQUALS(p_profiler->GetTimerCalls(index), num_steps);
+        TS_ASSERT_EQUALS(p_profiler->FindTimer("Killer:PlaneBasedCellKiller-2", index), true);
+        TS_ASSERT_EQUALS(p_profiler->GetTimerCalls(index), num_steps + 1);
+        TS_ASSERT_EQUALS(p_profiler->FindTimer("Modifier:VolumeTrackingModifier-2", index), true);
+        TS_ASSERT_EQUALS(p_profiler->GetTimerCalls(index), 2*num_steps + 2);
+        TS_ASSERT_EQUALS(p_profiler->FindTimer("Writer:CellIdWriter-2-2", index), true);
+        TS_ASSERT_EQUALS(p_profiler->GetTimerCalls(index), num_steps + 1);
+
+        // Work counters are recorded (VolumeTrackingModifier also updates the cell population)
+        TS_ASSERT_LESS_THAN_EQUALS(num_steps + 1, p_profiler->GetCounterTotal(p_profiler->GetCounterIndex("Delaunay remeshes")));
+        TS_ASSERT_LESS_THAN(0u, p_profiler->GetCounterTotal(p_profiler->GetCounterIndex("node pairs evaluated")));
+
+        // The per-step trace has a header and lines for each step
+        OutputFileHandler handler("TestOffLatticeSimulationWithProfileTrace/results_from_time_0", false);
+        FileFinder trace_file = handler.FindFile("profile_trace.csv");
+        TS_ASSERT(trace_file.Exists());
+        std::ifstream trace(trace_file.GetAbsolutePath().c_str());
+        std::string line;
+        std::getline(trace, line);
+        TS_ASSERT_EQUALS(line, "step,time,kind,name,calls,value");
+        std::getline(trace, line);
+        TS_ASSERT_EQUALS(line.substr(0, 2), "0,");
+
+        p_profiler->Reset();
+    }
+
     void TestWriterIteratorsWithCellDeath() throw(Exception)
     {
         /*
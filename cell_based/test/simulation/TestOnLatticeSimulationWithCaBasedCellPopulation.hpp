@@ -367,8 +367,8 @@ public:
 
         // Assign roughly half the cells to undergo apoptotis. Set their location index as
         // a cell data item to check ordering in output VTK file
-        std::list<CellPtr> cells2 = cell_population.rGetCells();
-        std::list<CellPtr>::iterator it;
+        std::vector<CellPtr> cells2 = cell_population.rGetCells();
+        std::vector<CellPtr>::iterator it;
         RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
         for (it = cells2.begin(); it != cells2.end(); ++it)
         {
@@ -0,0 +1,434 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTSIMULATIONCONTEXT_HPP_
+#define TESTSIMULATIONCONTEXT_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+// Must be included before other cell_based headers
+#include "CellBasedSimulationArchiver.hpp"
+
+#include <sstream>
+#include "SimulationContext.hpp"
+#include "AbstractCellBasedSimulationEnsemble.hpp"
+#include "CellsGenerator.hpp"
+#include "OffLatticeSimulation.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "HoneycombMeshGenerator.hpp"
+#include "DiffusionForce.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "UniformCellCycleModel.hpp"
+#include "DeltaNotchSrnModel.hpp"
+#include "DeltaNotchTrackingModifier.hpp"
+#include "CellCycleModelOdeSolver.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+#include "WildTypeCellMutationState.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "CellId.hpp"
+#include "ThreadPool.hpp"
+#include "CellBasedEventHandler.hpp"
+#include "SmartPointers.hpp"
+#include "AbstractCellBasedTestSuite.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * A simple ensemble, used in the tests below, which runs a short node-based
+ * simulation with diffusion and records the final cell locations.
+ */
+class DiffusingNodesEnsemble : public AbstractCellBasedSimulationEnsemble
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param numReplicates the number of replicates that will be run
+     */
+    DiffusingNodesEnsemble(unsigned numReplicates)
+        : mFirstRandomNumbers(numReplicates),
+          mFirstCellIds(numReplicates),
+          mFinalLocations(numReplicates)
+    {
+    }
+
+    /** The first random number drawn in each replicate. */
+    std::vector<double> mFirstRandomNumbers;
+
+    /** The ID of the first cell created in each replicate. */
+    std::vector<unsigned> mFirstCellIds;
+
+    /** The final location of the first node in each replicate. */
+    std::vector<c_vector<double, 2> > mFinalLocations;
+
+    /** The replicates finished, in the order in which FinishReplicate() was called. */
+    std::vector<unsigned> mFinishedReplicates;
+
+    /** The simulation time at which each replicate finished. */
+    std::vector<double> mFinishTimes;
+
+protected:
+
+    /**
+     * Run a single replicate.
+     *
+     * @param replicateIndex the index of the replicate
+     */
+    void RunReplicate(unsigned replicateIndex)
+    {
+        mFirstRandomNumbers[replicateIndex] = RandomNumberGenerator::Instance()->ranf();
+
+        HoneycombMeshGenerator generator(2, 2, 0);
+        TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+        NodesOnlyMesh<2> mesh;
+        mesh.ConstructNodesWithoutMesh(*p_generating_mesh, 1.5);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, mesh.GetNumNodes());
+        mFirstCellIds[replicateIndex] = cells[0]->GetCellId();
+
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+
+        std::stringstream output_directory;
+        output_directory << "TestSimulationEnsemble/replicate_" << replicateIndex;
+        OffLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory(output_directory.str());
+        simulator.SetEndTime(0.1);
+
+        MAKE_PTR(DiffusionForce<2>, p_force);
+        simulator.AddForce(p_force);
+
+        simulator.Solve();
+
+        mFinalLocations[replicateIndex] = cell_population.GetNode(0)->rGetLocation();
+    }
+
+    /**
+     * Record that a replicate has finished.
+     *
+     * @param replicateIndex the index of the replicate
+     */
+    void FinishReplicate(unsigned replicateIndex)
+    {
+        mFinishedReplicates.push_back(replicateIndex);
+        mFinishTimes.push_back(SimulationTime::Instance()->GetTime());
+    }
+};
+
+/**
+ * An ensemble, used in the tests below, which runs a short node-based simulation
+ * of diffusing cells with Delta-Notch SRN models from random initial conditions,
+ * and records the final Delta-Notch levels of each cell.
+ */
+class DeltaNotchEnsemble : public AbstractCellBasedSimulationEnsemble
+{
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param numReplicates the number of replicates that will be run
+     */
+    DeltaNotchEnsemble(unsigned numReplicates)
+        : mFinalNotch(numReplicates),
+          mFinalDelta(numReplicates),
+          mFinalMeanDelta(numReplicates)
+    {
+    }
+
+    /** The final notch level of each cell in each replicate, from its SRN model. */
+    std::vector<std::vector<double> > mFinalNotch;
+
+    /** The final delta level of each cell in each replicate, from its cell data. */
+    std::vector<std::vector<double> > mFinalDelta;
+
+    /** The final mean neighbouring delta level of each cell in each replicate, from its cell data. */
+    std::vector<std::vector<double> > mFinalMeanDelta;
+
+protected:
+
+    /**
+     * Run a single replicate.
+     *
+     * @param replicateIndex the index of the replicate
+     */
+    void RunReplicate(unsigned replicateIndex)
+    {
+        HoneycombMeshGenerator generator(3, 3, 0);
+        TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+        NodesOnlyMesh<2> mesh;
+        mesh.ConstructNodesWithoutMesh(*p_generating_mesh, 1.5);
+
+        MAKE_PTR(WildTypeCellMutationState, p_state);
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+        std::vector<CellPtr> cells;
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            UniformCellCycleModel* p_cc_model = new UniformCellCycleModel();
+            p_cc_model->SetDimension(2);
+
+            std::vector<double> initial_conditions;
+            initial_conditions.push_back(RandomNumberGenerator::Instance()->ranf());
+            initial_conditions.push_back(RandomNumberGenerator::Instance()->ranf());
+            DeltaNotchSrnModel* p_srn_model = new DeltaNotchSrnModel();
+            p_srn_model->SetInitialConditions(initial_conditions);
+
+            CellPtr p_cell(new Cell(p_state, p_cc_model, p_srn_model));
+            p_cell->SetCellProliferativeType(p_diff_type);
+            p_cell->SetBirthTime(0.0);
+            cells.push_back(p_cell);
+        }
+
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+
+        std::stringstream output_directory;
+        output_directory << "TestDeltaNotchEnsemble/replicate_" << replicateIndex;
+        OffLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory(output_directory.str());
+        simulator.SetEndTime(0.5);
+
+        MAKE_PTR(DiffusionForce<2>, p_force);
+        simulator.AddForce(p_force);
+        MAKE_PTR(DeltaNotchTrackingModifier<2>, p_modifier);
+        simulator.AddSimulationModifier(p_modifier);
+
+        simulator.Solve();
+
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            mFinalNotch[replicateIndex].push_back(static_cast<DeltaNotchSrnModel*>(cell_iter->GetSrnModel())->GetNotch());
+            mFinalDelta[replicateIndex].push_back(cell_iter->GetCellData()->GetItem("delta"));
+            mFinalMeanDelta[replicateIndex].push_back(cell_iter->GetCellData()->GetItem("mean delta"));
+        }
+    }
+};
+
+class TestSimulationContext : public AbstractCellBasedTestSuite
+{
+public:
+
+    void TestContextsReplaceSingletons() throw (Exception)
+    {
+        // Set up the default simulation time, as set up by the test suite
+        SimulationTime* p_default_time = SimulationTime::Instance();
+        p_default_time->SetEndTimeAndNumberOfTimeSteps(10.0, 10);
+        p_default_time->IncrementTimeOneStep();
+
+        SimulationContext context(1u, 5.0);
+        TS_ASSERT_EQUALS(context.IsActive(), false);
+        TS_ASSERT_THROWS_THIS(context.Deactivate(), "This simulation context is not active.");
+
+        // Activating the context gives fresh singletons
+        context.Activate();
+        TS_ASSERT_EQUALS(context.IsActive(), true);
+        TS_ASSERT_THROWS_THIS(context.Activate(), "This simulation context is already active.");
+
+        TS_ASSERT(SimulationTime::Instance() != p_default_time);
+        TS_ASSERT_DELTA(SimulationTime::Instance()->GetTime(), 5.0, 1e-12);
+        TS_ASSERT_EQUALS(SimulationTime::Instance()->IsEndTimeAndNumberOfTimeStepsSetUp(), false);
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(6.0, 2);
+        SimulationTime::Instance()->IncrementTimeOneStep();
+
+        MAKE_PTR(CellId, p_cell_id);
+        p_cell_id->AssignCellId();
+        TS_ASSERT_EQUALS(p_cell_id->GetCellId(), 0u);
+
+        double first_context_random_number = RandomNumberGenerator::Instance()->ranf();
+
+        // Deactivating restores the defaults, which are unaffected by the context
+        context.Deactivate();
+        TS_ASSERT_EQUALS(SimulationTime::Instance(), p_default_time);
+        TS_ASSERT_DELTA(SimulationTime::Instance()->GetTime(), 1.0, 1e-12);
+        double first_default_random_number = RandomNumberGenerator::Instance()->ranf();
+
+        MAKE_PTR(CellId, p_other_cell_id);
+        p_other_cell_id->AssignCellId();
+        TS_ASSERT_EQUALS(p_other_cell_id->GetCellId(), 0u);
+
+        // Reactivating the context resumes where it left off
+        context.Activate();
+        TS_ASSERT_DELTA(SimulationTime::Instance()->GetTime(), 5.5, 1e-12);
+        double second_context_random_number = RandomNumberGenerator::Instance()->ranf();
+        p_cell_id->AssignCellId();
+        TS_ASSERT_EQUALS(p_cell_id->GetCellId(), 1u);
+        context.Deactivate();
+
+        // The context's random numbers are the same as a generator seeded with 1 would give
+        RandomNumberGenerator::Instance()->Reseed(1);
+        TS_ASSERT_EQUALS(RandomNumberGenerator::Instance()->ranf(), first_context_random_number);
+        TS_ASSERT_EQUALS(RandomNumberGenerator::Instance()->ranf(), second_context_random_number);
+
+        // ...and the default generator was not advanced by the context
+        RandomNumberGenerator::Instance()->Reseed(0);
+        TS_ASSERT_EQUALS(RandomNumberGenerator::Instance()->ranf(), first_default_random_number);
+    }
+
+    void TestEnsemble() throw (Exception)
+    {
+        EXIT_IF_PARALLEL; // HoneycombMeshGenerator does not work in parallel
+
+        double default_random_number = RandomNumberGenerator::Instance()->ranf();
+
+        DiffusingNodesEnsemble ensemble(3);
+        TS_ASSERT_EQUALS(ensemble.GetFirstSeed(), 0u);
+        ensemble.SetFirstSeed(3u);
+        TS_ASSERT_EQUALS(ensemble.GetFirstSeed(), 3u);
+        ensemble.Run(3);
+
+        TS_ASSERT_EQUALS(ensemble.mFinishedReplicates.size(), 3u);
+        for (unsigned i=0; i<3; i++)
+        {
+            // Each replicate has its own seed and numbers its cells from zero
+            RandomNumberGenerator::Instance()->Reseed(3 + i);
+            TS_ASSERT_EQUALS(ensemble.mFirstRandomNumbers[i], RandomNumberGenerator::Instance()->ranf());
+            TS_ASSERT_EQUALS(ensemble.mFirstCellIds[i], 0u);
+
+            // Each replicate is finished in order, with its context active
+            TS_ASSERT_EQUALS(ensemble.mFinishedReplicates[i], i);
+            TS_ASSERT_DELTA(ensemble.mFinishTimes[i], 0.1, 1e-12);
+        }
+
+        // Different replicates give different results
+        TS_ASSERT_DIFFERS(ensemble.mFinalLocations[0][0], ensemble.mFinalLocations[1][0]);
+
+        // Running a replicate again gives the same result
+        DiffusingNodesEnsemble repeat_ensemble(1);
+        repeat_ensemble.SetFirstSeed(4u);
+        repeat_ensemble.Run(1);
+        TS_ASSERT_DELTA(repeat_ensemble.mFinalLocations[0][0], ensemble.mFinalLocations[1][0], 1e-12);
+        TS_ASSERT_DELTA(repeat_ensemble.mFinalLocations[0][1], ensemble.mFinalLocations[1][1], 1e-12);
+
+        // The singletons in place before the ensemble was run are restored
+        RandomNumberGenerator::Instance()->Reseed(0);
+        TS_ASSERT_EQUALS(RandomNumberGenerator::Instance()->ranf(), default_random_number);
+        TS_ASSERT_EQUALS(SimulationTime::Instance()->IsStartTimeSetUp(), true);
+        TS_ASSERT_EQUALS(SimulationTime::Instance()->IsEndTimeAndNumberOfTimeStepsSetUp(), false);
+    }
+
+    void TestEnsembleOnThreads() throw (Exception)
+    {
+        EXIT_IF_PARALLEL; // HoneycombMeshGenerator does not work in parallel
+
+        double default_random_number = RandomNumberGenerator::Instance()->ranf();
+
+        DiffusingNodesEnsemble serial_ensemble(5);
+        serial_ensemble.SetFirstSeed(7u);
+        serial_ensemble.Run(5);
+
+        // Share the replicates between three threads
+        ThreadPool::Instance()->SetNumThreads(3);
+        DiffusingNodesEnsemble threaded_ensemble(5);
+        threaded_ensemble.SetFirstSeed(7u);
+        threaded_ensemble.Run(5);
+        ThreadPool::Destroy();
+
+        // Each replicate gives the same results whichever thread runs it
+        TS_ASSERT_EQUALS(threaded_ensemble.mFinishedReplicates.size(), 5u);
+        for (unsigned i=0; i<5; i++)
+        {
+            TS_ASSERT_EQUALS(threaded_ensemble.mFirstRandomNumbers[i], serial_ensemble.mFirstRandomNumbers[i]);
+            TS_ASSERT_EQUALS(threaded_ensemble.mFirstCellIds[i], 0u);
+            TS_ASSERT_EQUALS(threaded_ensemble.mFinalLocations[i][0], serial_ensemble.mFinalLocations[i][0]);
+            TS_ASSERT_EQUALS(threaded_ensemble.mFinalLocations[i][1], serial_ensemble.mFinalLocations[i][1]);
+            TS_ASSERT_EQUALS(threaded_ensemble.mFinishedReplicates[i], i);
+            TS_ASSERT_DELTA(threaded_ensemble.mFinishTimes[i], 0.1, 1e-12);
+        }
+
+        // The services of this thread are unaffected, and timings are recorded again
+        RandomNumberGenerator::Instance()->Reseed(0);
+        TS_ASSERT_EQUALS(RandomNumberGenerator::Instance()->ranf(), default_random_number);
+        TS_ASSERT_EQUALS(SimulationTime::Instance()->IsEndTimeAndNumberOfTimeStepsSetUp(), false);
+        TS_ASSERT_EQUALS(PetscTools::IsIsolated(), false);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::IsEnabled(), true);
+    }
+
+    void TestEnsembleWithOdesOnThreads() throw (Exception)
+    {
+        EXIT_IF_PARALLEL; // HoneycombMeshGenerator does not work in parallel
+
+        DeltaNotchEnsemble serial_ensemble(6);
+        serial_ensemble.SetFirstSeed(11u);
+        serial_ensemble.Run(6);
+
+        // Share the replicates between four threads, each of which solves ODEs with its own solvers
+        ThreadPool::Instance()->SetNumThreads(4);
+        DeltaNotchEnsemble threaded_ensemble(6);
+        threaded_ensemble.SetFirstSeed(11u);
+        threaded_ensemble.Run(6);
+        ThreadPool::Destroy();
+
+        // Each replicate gives bit-for-bit the same results whichever thread runs it
+        for (unsigned i=0; i<6; i++)
+        {
+            TS_ASSERT_EQUALS(threaded_ensemble.mFinalNotch[i].size(), 9u);
+            TS_ASSERT_EQUALS(threaded_ensemble.mFinalNotch[i].size(), serial_ensemble.mFinalNotch[i].size());
+            for (unsigned j=0; j<serial_ensemble.mFinalNotch[i].size(); j++)
+            {
+                TS_ASSERT_EQUALS(threaded_ensemble.mFinalNotch[i][j], serial_ensemble.mFinalNotch[i][j]);
+                TS_ASSERT_EQUALS(threaded_ensemble.mFinalDelta[i][j], serial_ensemble.mFinalDelta[i][j]);
+                TS_ASSERT_EQUALS(threaded_ensemble.mFinalMeanDelta[i][j], serial_ensemble.mFinalMeanDelta[i][j]);
+            }
+        }
+
+        // Different replicates start from different initial conditions
+        TS_ASSERT_DIFFERS(serial_ensemble.mFinalNotch[0][0], serial_ensemble.mFinalNotch[1][0]);
+    }
+
+    void TestContextsHaveTheirOwnOdeSolvers() throw (Exception)
+    {
+        typedef CellCycleModelOdeSolver<DeltaNotchSrnModel, RungeKutta4IvpOdeSolver> SolverType;
+        boost::shared_ptr<SolverType> p_default_solver = SolverType::Instance();
+        TS_ASSERT_EQUALS(SolverType::Instance(), p_default_solver);
+
+        SimulationContext context;
+        context.Activate();
+        boost::shared_ptr<SolverType> p_context_solver = SolverType::Instance();
+        TS_ASSERT(p_context_solver != p_default_solver);
+        TS_ASSERT_EQUALS(SolverType::Instance(), p_context_solver);
+        context.Deactivate();
+
+        // The default solver is used again outside the context, and the context keeps its own
+        TS_ASSERT_EQUALS(SolverType::Instance(), p_default_solver);
+        context.Activate();
+        TS_ASSERT_EQUALS(SolverType::Instance(), p_context_solver);
+        context.Deactivate();
+    }
+};
+
+#endif /*TESTSIMULATIONCONTEXT_HPP_*/
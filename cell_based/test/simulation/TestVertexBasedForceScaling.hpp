@@ -0,0 +1,159 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTVERTEXBASEDFORCESCALING_HPP_
+#define TESTVERTEXBASEDFORCESCALING_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "AbstractCellBasedTestSuite.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "CellsGenerator.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "SimpleTargetAreaModifier.hpp"
+#include "NagaiHondaForce.hpp"
+#include "FarhadifarForce.hpp"
+#include "Timer.hpp"
+#include "ThreadPool.hpp"
+#include "SmartPointers.hpp"
+#include "FakePetscSetup.hpp"
+
+/**
+ * This class times the force calculations of the vertex model on
+ * honeycomb meshes of increasing size, up to around 10^5 cells.
+ *
+ * This test is used for profiling, to establish how the run time
+ * of NagaiHondaForce and FarhadifarForce scales with the number of
+ * cells as the code is developed. Each force is timed with one thread and with
+ * four threads in the ThreadPool, and the forces are checked to be identical.
+ */
+class TestVertexBasedForceScaling : public AbstractCellBasedTestSuite
+{
+private:
+
+    /**
+     * Time repeated evaluations of a force on a series of honeycomb meshes.
+     *
+     * @param pForce the force
+     * @param rForceName the name of the force, used when printing timings
+     */
+    void TimeForceOnHoneycombMeshes(boost::shared_ptr<AbstractForce<2> > pForce, const std::string& rForceName)
+    {
+        unsigned num_evaluations = 10;
+
+        // Use meshes of approximately 10^2, 10^3, 10^4 and 10^5 cells
+        unsigned num_cells_across[4] = {10, 32, 100, 316};
+
+        for (unsigned size_index=0; size_index<4; size_index++)
+        {
+            HoneycombVertexMeshGenerator generator(num_cells_across[size_index], num_cells_across[size_index]);
+            MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+            std::vector<CellPtr> cells;
+            MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasic(cells, p_mesh->GetNumElements(), std::vector<unsigned>(), p_diff_type);
+
+            VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+            MAKE_PTR(SimpleTargetAreaModifier<2>, p_growth_modifier);
+            p_growth_modifier->UpdateTargetAreas(cell_population);
+
+            std::vector<c_vector<double, 2> > serial_forces;
+            unsigned num_threads[2] = {1, 4};
+            for (unsigned thread_index=0; thread_index<2; thread_index++)
+            {
+                ThreadPool::Instance()->SetNumThreads(num_threads[thread_index]);
+
+                Timer::Reset();
+                for (unsigned i=0; i<num_evaluations; i++)
+                {
+                    for (unsigned node_index=0; node_index<cell_population.GetNumNodes(); node_index++)
+                    {
+                        cell_population.GetNode(node_index)->ClearAppliedForce();
+                    }
+                    pForce->AddForceContribution(cell_population);
+                }
+                double time_per_evaluation = Timer::GetElapsedTime()/num_evaluations;
+
+                std::cout << rForceName << " with " << cell_population.GetNumRealCells() << " cells and "
+                          << num_threads[thread_index] << " threads: " << time_per_evaluation << "s per evaluation\n" << std::flush;
+
+                // Each node is given the same force whatever the number of threads
+                for (unsigned node_index=0; node_index<cell_population.GetNumNodes(); node_index++)
+                {
+                    const c_vector<double, 2>& r_force = cell_population.GetNode(node_index)->rGetAppliedForce();
+                    if (thread_index == 0)
+                    {
+                        serial_forces.push_back(r_force);
+                    }
+                    else
+                    {
+                        TS_ASSERT_EQUALS(r_force[0], serial_forces[node_index][0]);
+                        TS_ASSERT_EQUALS(r_force[1], serial_forces[node_index][1]);
+                    }
+                }
+            }
+            ThreadPool::Destroy();
+
+            // The energy is invariant under translation, so the forces on the nodes should sum to zero
+            c_vector<double, 2> total_force = zero_vector<double>(2);
+            for (unsigned node_index=0; node_index<cell_population.GetNumNodes(); node_index++)
+            {
+                total_force += cell_population.GetNode(node_index)->rGetAppliedForce();
+            }
+            TS_ASSERT_DELTA(norm_2(total_force), 0.0, 1e-8*cell_population.GetNumNodes());
+        }
+    }
+
+public:
+
+    void TestNagaiHondaForceScalingForProfiling() throw (Exception)
+    {
+        MAKE_PTR(NagaiHondaForce<2>, p_force);
+        TimeForceOnHoneycombMeshes(p_force, "NagaiHondaForce");
+    }
+
+    void TestFarhadifarForceScalingForProfiling() throw (Exception)
+    {
+        MAKE_PTR(FarhadifarForce<2>, p_force);
+        TimeForceOnHoneycombMeshes(p_force, "FarhadifarForce");
+    }
+};
+
+#endif /*TESTVERTEXBASEDFORCESCALING_HPP_*/
@@ -0,0 +1,152 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include <cmath>
+#include "CounterBasedRandomNumberGenerator.hpp"
+
+CounterBasedRandomNumberGenerator::CounterBasedRandomNumberGenerator(unsigned seed, const std::string& rPurpose)
+{
+    // Hash the purpose using the 32-bit FNV-1a hash
+    boost::uint32_t hash = 2166136261u;
+    for (unsigned i=0; i<rPurpose.size(); i++)
+    {
+        hash ^= static_cast<unsigned char>(rPurpose[i]);
+        hash *= 16777619u;
+    }
+
+    mKey[0] = seed;
+    mKey[1] = hash;
+}
+
+void CounterBasedRandomNumberGenerator::Philox4x32(const boost::uint32_t counter[4], const boost::uint32_t key[2], boost::uint32_t output[4])
+{
+    boost::uint32_t ctr[4] = {counter[0], counter[1], counter[2], counter[3]};
+    boost::uint32_t k0 = key[0];
+    boost::uint32_t k1 = key[1];
+
+    for (unsigned round=0; round<10; round++)
+    {
+        if (round > 0)
+        {
+            // Bump the key by the Weyl sequence constants
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+
+        boost::uint64_t product_0 = static_cast<boost::uint64_t>(0xD2511F53u)*ctr[0];
+        boost::uint64_t product_1 = static_cast<boost::uint64_t>(0xCD9E8D57u)*ctr[2];
+        boost::uint32_t hi_0 = static_cast<boost::uint32_t>(product_0 >> 32);
+        boost::uint32_t lo_0 = static_cast<boost::uint32_t>(product_0);
+        boost::uint32_t hi_1 = static_cast<boost::uint32_t>(product_1 >> 32);
+        boost::uint32_t lo_1 = static_cast<boost::uint32_t>(product_1);
+
+        ctr[0] = hi_1 ^ ctr[1] ^ k0;
+        ctr[1] = lo_1;
+        ctr[2] = hi_0 ^ ctr[3] ^ k1;
+        ctr[3] = lo_0;
+    }
+
+    for (unsigned i=0; i<4; i++)
+    {
+        output[i] = ctr[i];
+    }
+}
+
+void CounterBasedRandomNumberGenerator::GenerateUniformPair(unsigned streamIndex, unsigned step, unsigned blockIndex,
+                                                            double& rUniform1, double& rUniform2) const
+{
+    boost::uint32_t counter[4] = {streamIndex, step, blockIndex, 0u};
+    boost::uint32_t output[4];
+    Philox4x32(counter, mKey, output);
+
+    // Use 53 bits from each pair of words, shifted by one so that the result lies in (0,1]
+    const double two_to_minus_53 = 1.0/9007199254740992.0;
+    rUniform1 = ((output[0] >> 5)*67108864.0 + (output[1] >> 6) + 1.0)*two_to_minus_53;
+    rUniform2 = ((output[2] >> 5)*67108864.0 + (output[3] >> 6) + 1.0)*two_to_minus_53;
+}
+
+double CounterBasedRandomNumberGenerator::ranf(unsigned streamIndex, unsigned step, unsigned drawIndex) const
+{
+    double uniform_1;
+    double uniform_2;
+    GenerateUniformPair(streamIndex, step, drawIndex/2, uniform_1, uniform_2);
+    return (drawIndex%2 == 0) ? uniform_1 : uniform_2;
+}
+
+double CounterBasedRandomNumberGenerator::StandardNormalRandomDeviate(unsigned streamIndex, unsigned step, unsigned drawIndex) const
+{
+    double uniform_1;
+    double uniform_2;
+    GenerateUniformPair(streamIndex, step, drawIndex/2, uniform_1, uniform_2);
+
+    double radius = sqrt(-2.0*log(uniform_1));
+    double angle = 2.0*M_PI*uniform_2;
+    return (drawIndex%2 == 0) ? radius*cos(angle) : radius*sin(angle);
+}
+
+void CounterBasedRandomNumberGenerator::FillUniform(unsigned streamIndex, unsigned step, std::vector<double>& rValues) const
+{
+    for (unsigned i=0; i<rValues.size(); i+=2)
+    {
+        double uniform_1;
+        double uniform_2;
+        GenerateUniformPair(streamIndex, step, i/2, uniform_1, uniform_2);
+
+        rValues[i] = uniform_1;
+        if (i+1 < rValues.size())
+        {
+            rValues[i+1] = uniform_2;
+        }
+    }
+}
+
+void CounterBasedRandomNumberGenerator::FillStandardNormal(unsigned streamIndex, unsigned step, std::vector<double>& rValues) const
+{
+    for (unsigned i=0; i<rValues.size(); i+=2)
+    {
+        double uniform_1;
+        double uniform_2;
+        GenerateUniformPair(streamIndex, step, i/2, uniform_1, uniform_2);
+
+        double radius = sqrt(-2.0*log(uniform_1));
+        double angle = 2.0*M_PI*uniform_2;
+        rValues[i] = radius*cos(angle);
+        if (i+1 < rValues.size())
+        {
+            rValues[i+1] = radius*sin(angle);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef COUNTERBASEDRANDOMNUMBERGENERATOR_HPP_
+#define COUNTERBASEDRANDOMNUMBERGENERATOR_HPP_
+
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+/**
+ * A stateless random number generator based on the Philox4x32-10 counter-based
+ * generator of Salmon et al. (2011), "Parallel random numbers: as easy as 1, 2, 3".
+ *
+ * Unlike RandomNumberGenerator, each random number is a pure function of a key,
+ * formed from a seed and a string naming the purpose of the numbers, and a counter,
+ * formed from a stream index (for example a node index or cell ID), a step (for
+ * example the number of time steps elapsed) and the index of the draw within that
+ * stream and step. The numbers drawn for a given node or cell are therefore the
+ * same however many processes are used and in whatever order the nodes or cells
+ * are visited, and const methods of this class may be called concurrently.
+ */
+class CounterBasedRandomNumberGenerator
+{
+private:
+
+    /** The key, formed from the seed and a hash of the purpose. */
+    boost::uint32_t mKey[2];
+
+    /**
+     * Compute the Philox block containing a given pair of draws.
+     *
+     * @param streamIndex the stream index
+     * @param step the step
+     * @param blockIndex the index of the block (the draw index divided by two)
+     * @param rUniform1 the first uniform random number in the block, in (0,1]
+     * @param rUniform2 the second uniform random number in the block, in (0,1]
+     */
+    void GenerateUniformPair(unsigned streamIndex, unsigned step, unsigned blockIndex,
+                             double& rUniform1, double& rUniform2) const;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param seed the seed
+     * @param rPurpose a name for what the random numbers are used for, so that
+     *     different uses with the same seed and counters give independent numbers
+     */
+    CounterBasedRandomNumberGenerator(unsigned seed, const std::string& rPurpose);
+
+    /**
+     * Apply the ten rounds of the Philox4x32 bijection.
+     *
+     * @param counter the counter
+     * @param key the key
+     * @param output the four random 32-bit words
+     */
+    static void Philox4x32(const boost::uint32_t counter[4], const boost::uint32_t key[2], boost::uint32_t output[4]);
+
+    /**
+     * @return a uniform random number in (0,1].
+     *
+     * @param streamIndex the stream index
+     * @param step the step
+     * @param drawIndex the index of the draw within this stream and step (defaults to 0)
+     */
+    double ranf(unsigned streamIndex, unsigned step, unsigned drawIndex=0) const;
+
+    /**
+     * @return a random number from the normal distribution with mean 0 and
+     * standard deviation 1, computed by the Box-Muller transform.
+     *
+     * @param streamIndex the stream index
+     * @param step the step
+     * @param drawIndex the index of the draw within this stream and step (defaults to 0)
+     */
+    double StandardNormalRandomDeviate(unsigned streamIndex, unsigned step, unsigned drawIndex=0) const;
+
+    /**
+     * Fill a vector with uniform random numbers in (0,1]. Entry i is equal to
+     * ranf(streamIndex, step, i), but each block of the generator is only computed once.
+     *
+     * @param streamIndex the stream index
+     * @param step the step
+     * @param rValues the vector to fill (its size is the number of values drawn)
+     */
+    void FillUniform(unsigned streamIndex, unsigned step, std::vector<double>& rValues) const;
+
+    /**
+     * Fill a vector with standard normal random numbers. Entry i is equal to
+     * StandardNormalRandomDeviate(streamIndex, step, i), but each block of the
+     * generator is only computed once.
+     *
+     * @param streamIndex the stream index
+     * @param step the step
+     * @param rValues the vector to fill (its size is the number of values drawn)
+     */
+    void FillStandardNormal(unsigned streamIndex, unsigned step, std::vector<double>& rValues) const;
+};
+
+#endif /*COUNTERBASEDRANDOMNUMBERGENERATOR_HPP_*/
@@ -38,6 +38,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 RandomNumberGenerator* RandomNumberGenerator::mpInstance = NULL;
 
+CHASTE_THREAD_LOCAL RandomNumberGenerator** RandomNumberGenerator::mppThreadInstance = NULL;
+
 RandomNumberGenerator::RandomNumberGenerator()
     : mMersenneTwisterGenerator(0u),
       mGenerateUnitReal(mMersenneTwisterGenerator, boost::uniform_real<>()),
@@ -47,27 +49,41 @@ RandomNumberGenerator::RandomNumberGenerator()
       mGenerateStandardNormal(mMersenneTwisterGenerator, boost::normal_distribution<>(0.0, 1.0))
 #endif
 {
-    assert(mpInstance == NULL); // Ensure correct serialization
+    assert(rGetInstancePointer() == NULL); // Ensure correct serialization
+}
+
+RandomNumberGenerator*& RandomNumberGenerator::rGetInstancePointer()
+{
+    return (mppThreadInstance == NULL) ? mpInstance : *mppThreadInstance;
 }
 
 RandomNumberGenerator* RandomNumberGenerator::Instance()
 {
-    if (mpInstance == NULL)
+    RandomNumberGenerator*& rp_instance = rGetInstancePointer();
+    if (rp_instance == NULL)
     {
-        mpInstance = new RandomNumberGenerator();
+        rp_instance = new RandomNumberGenerator();
     }
-    return mpInstance;
+    return rp_instance;
 }
 
 void RandomNumberGenerator::Destroy()
 {
-    if (mpInstance)
+    RandomNumberGenerator*& rp_instance = rGetInstancePointer();
+    if (rp_instance)
     {
-        delete mpInstance;
-        mpInstance = NULL;
+        delete rp_instance;
+        rp_instance = NULL;
     }
 }
 
+RandomNumberGenerator** RandomNumberGenerator::SetThreadInstanceLocation(RandomNumberGenerator** ppInstance)
+{
+    RandomNumberGenerator** pp_previous_instance = mppThreadInstance;
+    mppThreadInstance = ppInstance;
+    return pp_previous_instance;
+}
+
 unsigned RandomNumberGenerator::randMod(unsigned base)
 {
     assert(base > 0u);
@@ -50,6 +50,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ChasteSerialization.hpp"
 #include "SerializableSingleton.hpp"
+#include "ChasteThreadLocal.hpp"
 #include <boost/serialization/split_member.hpp>
 
 /**
@@ -73,9 +74,17 @@ private:
 #else
     boost::variate_generator<boost::mt19937& , boost::normal_distribution<> > mGenerateStandardNormal;
 #endif
-    /** Pointer to the single instance. */
+    /** Pointer to the single instance, shared by all threads that have not called SetThreadInstanceLocation(). */
     static RandomNumberGenerator* mpInstance;
 
+    /** If not NULL, the location of the pointer to the instance used by this thread in place of mpInstance. */
+    static CHASTE_THREAD_LOCAL RandomNumberGenerator** mppThreadInstance;
+
+    /**
+     * @return a reference to the pointer to the instance used by the calling thread.
+     */
+    static RandomNumberGenerator*& rGetInstancePointer();
+
     friend class boost::serialization::access;
     /**
      * Save the RandomNumberGenerator and its member variables.
@@ -233,6 +242,20 @@ public:
      */
     static void Destroy();
 
+    /**
+     * Make the calling thread use the instance pointed to from the given location,
+     * instead of the shared instance. This allows several simulations to be run at
+     * once in one process, each with its own random number stream. Instance() and
+     * Destroy() called on this thread then act on the pointer at this location,
+     * which may be NULL (in which case the next call to Instance will create and
+     * seed a new instance there).
+     *
+     * @param ppInstance the location of this thread's instance pointer, or NULL to
+     *     use the shared instance again
+     * @return the location previously used by this thread, or NULL
+     */
+    static RandomNumberGenerator** SetThreadInstanceLocation(RandomNumberGenerator** ppInstance);
+
     /**
      * Reseed the random number generator.
      *
@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cassert>
 #include <iostream>
 #include <algorithm>
+#include <pthread.h>
 
 #include "Warnings.hpp"
 #include "Exception.hpp"
@@ -48,6 +49,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 Warnings* Warnings::mpInstance = NULL;
 
+/** Guards the list of warnings, so that warnings may be added from any thread */
+static pthread_mutex_t warnings_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 Warnings::Warnings()
 {
 }
@@ -103,17 +107,20 @@ void Warnings::AddWarning(const std::string& rMessage, const std::string& rFilen
     std::string context("Chaste warning: in file " + posix_filename + " at line "  + line_number_stream.str()  + ": ");
     std::pair<std::string, std::string> item(context, rMessage);
 
+    pthread_mutex_lock(&warnings_mutex);
     if (onlyOnce)
     {
         WarningsContainerType::iterator it = find(mWarningMessages.begin(), mWarningMessages.end(), item);
         if (it != mWarningMessages.end())
         {
+            pthread_mutex_unlock(&warnings_mutex);
             return;
         }
     }
 
     mWarningMessages.push_back(item);
     LOG(1, context + rMessage);
+    pthread_mutex_unlock(&warnings_mutex);
 }
 
 unsigned Warnings::GetNumWarnings()
@@ -48,6 +48,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  * Warnings can be polled with GetNumWarnings() and GetNextWarningMessage().
  * Warnings can be ignored and destroyed with QuietDestroy().
+ * Warnings may be added from any thread.
  * All warnings left at the close of the test suite (not the individual test), or
  * the close of the executable, will be printed to the screen.
  */
@@ -0,0 +1,259 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "ThreadPool.hpp"
+#include <cassert>
+#include <algorithm>
+
+ThreadPool* ThreadPool::mpInstance = NULL;
+
+ThreadPool::ThreadPool()
+    : mNumThreads(1u),
+      mpTask(NULL),
+      mNumItems(0u),
+      mNextItem(0u),
+      mChunkSize(1u),
+      mLoopCount(0u),
+      mLoopCountWhenThreadsStarted(0u),
+      mNumBusyThreads(0u),
+      mStopRequested(false),
+      mpTaskException(NULL)
+{
+    pthread_mutex_init(&mMutex, NULL);
+    pthread_cond_init(&mWorkAvailable, NULL);
+    pthread_cond_init(&mWorkFinished, NULL);
+}
+
+ThreadPool* ThreadPool::Instance()
+{
+    if (mpInstance == NULL)
+    {
+        mpInstance = new ThreadPool;
+    }
+    return mpInstance;
+}
+
+void ThreadPool::Destroy()
+{
+    if (mpInstance)
+    {
+        delete mpInstance;
+        mpInstance = NULL;
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    StopThreads();
+    pthread_cond_destroy(&mWorkFinished);
+    pthread_cond_destroy(&mWorkAvailable);
+    pthread_mutex_destroy(&mMutex);
+}
+
+void ThreadPool::StopThreads()
+{
+    if (!mThreads.empty())
+    {
+        pthread_mutex_lock(&mMutex);
+        mStopRequested = true;
+        pthread_cond_broadcast(&mWorkAvailable);
+        pthread_mutex_unlock(&mMutex);
+
+        for (unsigned i=0; i<mThreads.size(); i++)
+        {
+            pthread_join(mThreads[i], NULL);
+        }
+        mThreads.clear();
+        mStopRequested = false;
+    }
+}
+
+void ThreadPool::SetNumThreads(unsigned numThreads)
+{
+    assert(numThreads > 0);
+    assert(mpTask == NULL);
+    if (numThreads != mNumThreads)
+    {
+        StopThreads();
+        mNumThreads = numThreads;
+    }
+}
+
+unsigned ThreadPool::GetNumThreads()
+{
+    return mNumThreads;
+}
+
+void* ThreadPool::ThreadMain(void* pPool)
+{
+    static_cast<ThreadPool*>(pPool)->WaitForWork();
+    return NULL;
+}
+
+void ThreadPool::WaitForWork()
+{
+    pthread_mutex_lock(&mMutex);
+    unsigned loops_seen = mLoopCountWhenThreadsStarted;
+    while (true)
+    {
+        while (mLoopCount == loops_seen && !mStopRequested)
+        {
+            pthread_cond_wait(&mWorkAvailable, &mMutex);
+        }
+        if (mStopRequested)
+        {
+            break;
+        }
+        loops_seen = mLoopCount;
+
+        pthread_mutex_unlock(&mMutex);
+        ExecuteChunks();
+        pthread_mutex_lock(&mMutex);
+
+        mNumBusyThreads--;
+        if (mNumBusyThreads == 0)
+        {
+            pthread_cond_signal(&mWorkFinished);
+        }
+    }
+    pthread_mutex_unlock(&mMutex);
+}
+
+void ThreadPool::ExecuteChunks()
+{
+    while (true)
+    {
+        pthread_mutex_lock(&mMutex);
+        if (mNextItem >= mNumItems || mpTaskException != NULL)
+        {
+            pthread_mutex_unlock(&mMutex);
+            return;
+        }
+        unsigned begin = mNextItem;
+        unsigned end = std::min(mNumItems, begin + mChunkSize);
+        mNextItem = end;
+        AbstractThreadPoolTask* p_task = mpTask;
+        pthread_mutex_unlock(&mMutex);
+
+        try
+        {
+            p_task->Execute(begin, end);
+        }
+        catch (Exception& e)
+        {
+            pthread_mutex_lock(&mMutex);
+            if (mpTaskException == NULL)
+            {
+                mpTaskException = new Exception(e);
+            }
+            pthread_mutex_unlock(&mMutex);
+        }
+    }
+}
+
+bool ThreadPool::IsRunningTask()
+{
+    pthread_mutex_lock(&mMutex);
+    bool is_running_task = (mpTask != NULL);
+    pthread_mutex_unlock(&mMutex);
+    return is_running_task;
+}
+
+void ThreadPool::ParallelFor(unsigned numItems, AbstractThreadPoolTask& rTask, unsigned chunkSize)
+{
+    if (numItems == 0)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&mMutex);
+    bool run_on_calling_thread = (mNumThreads == 1 || numItems == 1 || mpTask != NULL);
+    if (!run_on_calling_thread)
+    {
+        mpTask = &rTask;
+    }
+    pthread_mutex_unlock(&mMutex);
+
+    if (run_on_calling_thread)
+    {
+        rTask.Execute(0, numItems);
+        return;
+    }
+
+    // Start the other threads the first time they are needed
+    pthread_mutex_lock(&mMutex);
+    mLoopCountWhenThreadsStarted = mLoopCount;
+    pthread_mutex_unlock(&mMutex);
+    while (mThreads.size() + 1 < mNumThreads)
+    {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, ThreadPool::ThreadMain, this) != 0)
+        {
+            break;
+        }
+        mThreads.push_back(thread);
+    }
+
+    pthread_mutex_lock(&mMutex);
+    mNumItems = numItems;
+    mNextItem = 0;
+    unsigned num_threads = mThreads.size() + 1;
+    mChunkSize = (chunkSize > 0) ? chunkSize : (numItems + num_threads - 1)/num_threads;
+    mNumBusyThreads = mThreads.size();
+    mLoopCount++;
+    pthread_cond_broadcast(&mWorkAvailable);
+    pthread_mutex_unlock(&mMutex);
+
+    // The calling thread does its share too
+    ExecuteChunks();
+
+    pthread_mutex_lock(&mMutex);
+    while (mNumBusyThreads > 0)
+    {
+        pthread_cond_wait(&mWorkFinished, &mMutex);
+    }
+    mpTask = NULL;
+    Exception* p_exception = mpTaskException;
+    mpTaskException = NULL;
+    pthread_mutex_unlock(&mMutex);
+
+    if (p_exception != NULL)
+    {
+        Exception exception(*p_exception);
+        delete p_exception;
+        throw exception;
+    }
+}
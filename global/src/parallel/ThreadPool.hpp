@@ -0,0 +1,187 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef THREADPOOL_HPP_
+#define THREADPOOL_HPP_
+
+#include <pthread.h>
+#include <vector>
+#include "AbstractThreadPoolTask.hpp"
+#include "Exception.hpp"
+
+/**
+ * A singleton pool of POSIX threads which share the iterations of a loop on
+ * each process, for loops whose iterations are independent.
+ *
+ * There is one thread by default, in which case ParallelFor() simply runs the loop
+ * on the calling thread. SetNumThreads() sets the total number of threads, including
+ * the calling thread, which does its share of the work. The other threads are started
+ * when first needed and then wait for work between loops.
+ *
+ * Items are handed out in contiguous chunks, so a task which computes each item
+ * independently gives the same results whatever the number of threads.
+ *
+ * A call to ParallelFor() made by a task that is already running on the pool is run
+ * on the calling thread, so that loops can be nested. The threads make no MPI or PETSc
+ * calls of their own; tasks must not make any either.
+ */
+class ThreadPool
+{
+private:
+
+    /** Pointer to the single instance. */
+    static ThreadPool* mpInstance;
+
+    /** The total number of threads, including the calling thread (defaults to 1). */
+    unsigned mNumThreads;
+
+    /** The threads started so far, which do not include the calling thread. */
+    std::vector<pthread_t> mThreads;
+
+    /** The task being run, or NULL between loops. */
+    AbstractThreadPoolTask* mpTask;
+
+    /** The number of items in the loop being run. */
+    unsigned mNumItems;
+
+    /** The index of the next item to hand out. */
+    unsigned mNextItem;
+
+    /** The number of items handed out at a time. */
+    unsigned mChunkSize;
+
+    /** Incremented each time a loop starts, so that waiting threads can tell there is work. */
+    unsigned mLoopCount;
+
+    /** The value of mLoopCount when threads were last started, before the loop they join. */
+    unsigned mLoopCountWhenThreadsStarted;
+
+    /** The number of started threads still working on the current loop. */
+    unsigned mNumBusyThreads;
+
+    /** Whether the started threads have been asked to finish. */
+    bool mStopRequested;
+
+    /** A copy of the first exception thrown by the task in the current loop, or NULL. */
+    Exception* mpTaskException;
+
+    /** Protects all the members above that are shared with the started threads. */
+    pthread_mutex_t mMutex;
+
+    /** Signalled when a loop starts or the threads are asked to finish. */
+    pthread_cond_t mWorkAvailable;
+
+    /** Signalled when the last started thread finishes its share of a loop. */
+    pthread_cond_t mWorkFinished;
+
+    /**
+     * Private constructor. Use Instance() to access the pool.
+     */
+    ThreadPool();
+
+    /**
+     * Entry point of each started thread.
+     *
+     * @param pPool pointer to the pool
+     * @return NULL
+     */
+    static void* ThreadMain(void* pPool);
+
+    /**
+     * Wait for loops and work on them until asked to stop. Runs on each started thread.
+     */
+    void WaitForWork();
+
+    /**
+     * Take chunks of items from the current loop and execute them until none are left.
+     */
+    void ExecuteChunks();
+
+    /**
+     * Ask the started threads to finish, and wait until they have.
+     */
+    void StopThreads();
+
+public:
+
+    /**
+     * @return a pointer to the single instance, creating it if necessary.
+     */
+    static ThreadPool* Instance();
+
+    /**
+     * Stop the started threads and delete the instance.
+     */
+    static void Destroy();
+
+    /**
+     * Destructor. Stops the started threads.
+     */
+    ~ThreadPool();
+
+    /**
+     * Set mNumThreads. Must not be called from within a task.
+     *
+     * @param numThreads the total number of threads, which must be at least 1
+     */
+    void SetNumThreads(unsigned numThreads);
+
+    /**
+     * @return mNumThreads.
+     */
+    unsigned GetNumThreads();
+
+    /**
+     * @return whether a loop is being shared between the threads, in which case the
+     *     caller may be one of several threads running a task at the same time.
+     */
+    bool IsRunningTask();
+
+    /**
+     * Run a task on the items 0 to numItems-1, sharing them between the threads,
+     * and return once they have all been processed. If the task throws an Exception
+     * on any thread, the remaining chunks are skipped and the first Exception is
+     * thrown again on the calling thread.
+     *
+     * @param numItems the number of items
+     * @param rTask the task
+     * @param chunkSize the number of items handed out at a time; by default the items
+     *     are split evenly between the threads
+     */
+    void ParallelFor(unsigned numItems, AbstractThreadPoolTask& rTask, unsigned chunkSize=0);
+};
+
+#endif /*THREADPOOL_HPP_*/
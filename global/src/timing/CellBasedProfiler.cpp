@@ -0,0 +1,396 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "CellBasedProfiler.hpp"
+
+#include <cassert>
+#include <sstream>
+#include <typeinfo>
+
+#include <boost/serialization/extended_type_info.hpp>
+#include <boost/serialization/extended_type_info_typeid.hpp>
+#include <boost/serialization/extended_type_info_no_rtti.hpp>
+#include <boost/serialization/type_info_implementation.hpp>
+
+#include "PetscTools.hpp"
+#include "Timer.hpp"
+
+/**
+ * @param pObject the object
+ * @return the identifier of the class of an object, or the compiler's name for the
+ * class if it has no Boost Serialization export key (in which case GetIdentifier()
+ * would dereference a null pointer).
+ */
+static std::string GetIdentifierOrTypeName(const Identifiable* pObject)
+{
+    const boost::serialization::extended_type_info* p_info;
+#if BOOST_VERSION >= 103700
+    p_info = boost::serialization::type_info_implementation<Identifiable>::type::get_const_instance().get_derived_extended_type_info(*pObject);
+#else
+    p_info = boost::serialization::type_info_implementation<Identifiable>::type::get_derived_extended_type_info(*pObject);
+#endif
+    if (p_info != NULL && p_info->get_key() != NULL)
+    {
+        return pObject->GetIdentifier();
+    }
+    return typeid(*pObject).name();
+}
+
+CellBasedProfiler::CellBasedProfiler()
+    : mEnabled(false)
+{
+}
+
+CellBasedProfiler* CellBasedProfiler::Instance()
+{
+    static CellBasedProfiler inst;
+    return &inst;
+}
+
+void CellBasedProfiler::Enable()
+{
+    mEnabled = true;
+}
+
+void CellBasedProfiler::Disable()
+{
+    mEnabled = false;
+}
+
+void CellBasedProfiler::Reset()
+{
+    unsigned num_timers = mTimerNames.size();
+    mTimerDepths.assign(num_timers, 0u);
+    mTimerStartTimes.assign(num_timers, 0.0);
+    mTimerTotals.assign(num_timers, 0.0);
+    mTimerStepTimes.assign(num_timers, 0.0);
+    mTimerCalls.assign(num_timers, 0ul);
+    mTimerStepCalls.assign(num_timers, 0ul);
+    mOpenTimers.clear();
+
+    unsigned num_counters = mCounterNames.size();
+    mCounterTotals.assign(num_counters, 0ul);
+    mCounterStepValues.assign(num_counters, 0ul);
+}
+
+void CellBasedProfiler::ClearObjectCache()
+{
+    mObjectTimerIndices.clear();
+}
+
+unsigned CellBasedProfiler::GetTimerIndex(const std::string& rName)
+{
+    std::map<std::string, unsigned>::const_iterator it = mTimerIndices.find(rName);
+    if (it != mTimerIndices.end())
+    {
+        return it->second;
+    }
+
+    unsigned index = mTimerNames.size();
+    mTimerIndices[rName] = index;
+    mTimerNames.push_back(rName);
+    mTimerParents.push_back(UINT_MAX);
+    mTimerParentIsSet.push_back(false);
+    mTimerDepths.push_back(0u);
+    mTimerStartTimes.push_back(0.0);
+    mTimerTotals.push_back(0.0);
+    mTimerStepTimes.push_back(0.0);
+    mTimerCalls.push_back(0ul);
+    mTimerStepCalls.push_back(0ul);
+    return index;
+}
+
+bool CellBasedProfiler::FindTimer(const std::string& rName, unsigned& rIndex) const
+{
+    std::map<std::string, unsigned>::const_iterator it = mTimerIndices.find(rName);
+    if (it == mTimerIndices.end())
+    {
+        return false;
+    }
+    rIndex = it->second;
+    return true;
+}
+
+unsigned CellBasedProfiler::GetNumTimers() const
+{
+    return mTimerNames.size();
+}
+
+const std::string& CellBasedProfiler::rGetTimerName(unsigned index) const
+{
+    assert(index < mTimerNames.size());
+    return mTimerNames[index];
+}
+
+unsigned CellBasedProfiler::GetTimerParent(unsigned index) const
+{
+    assert(index < mTimerParents.size());
+    return mTimerParents[index];
+}
+
+double CellBasedProfiler::GetTimerTotal(unsigned index) const
+{
+    assert(index < mTimerTotals.size());
+    return mTimerTotals[index];
+}
+
+unsigned long CellBasedProfiler::GetTimerCalls(unsigned index) const
+{
+    assert(index < mTimerCalls.size());
+    return mTimerCalls[index];
+}
+
+unsigned CellBasedProfiler::BeginTimer(unsigned index)
+{
+    if (!mEnabled)
+    {
+        return UINT_MAX;
+    }
+    assert(index < mTimerNames.size());
+
+    // The parent of a timer is the innermost timer open when it is first begun
+    if (!mTimerParentIsSet[index])
+    {
+        if (!mOpenTimers.empty() && mOpenTimers.back() != index)
+        {
+            mTimerParents[index] = mOpenTimers.back();
+        }
+        mTimerParentIsSet[index] = true;
+    }
+
+    // A timer begun again before it is ended (for example, by recursion) is only timed once
+    if (mTimerDepths[index] == 0)
+    {
+        mTimerStartTimes[index] = Timer::GetWallTime();
+    }
+    mTimerDepths[index]++;
+    mTimerCalls[index]++;
+    mTimerStepCalls[index]++;
+    mOpenTimers.push_back(index);
+
+    return index;
+}
+
+unsigned CellBasedProfiler::BeginTimer(const std::string& rName)
+{
+    if (!mEnabled)
+    {
+        return UINT_MAX;
+    }
+    return BeginTimer(GetTimerIndex(rName));
+}
+
+unsigned CellBasedProfiler::BeginTimer(const std::string& rCategory, const Identifiable* pObject)
+{
+    if (!mEnabled)
+    {
+        return UINT_MAX;
+    }
+
+    std::pair<const Identifiable*, std::string> key(pObject, rCategory);
+    std::map<std::pair<const Identifiable*, std::string>, unsigned>::const_iterator it = mObjectTimerIndices.find(key);
+    unsigned index;
+    if (it != mObjectTimerIndices.end())
+    {
+        index = it->second;
+    }
+    else
+    {
+        index = GetTimerIndex(rCategory + ":" + GetIdentifierOrTypeName(pObject));
+        mObjectTimerIndices[key] = index;
+    }
+    return BeginTimer(index);
+}
+
+void CellBasedProfiler::EndTimer(unsigned index)
+{
+    if (index == UINT_MAX)
+    {
+        return;
+    }
+    assert(index < mTimerNames.size());
+    assert(!mOpenTimers.empty() && mOpenTimers.back() == index);
+    mOpenTimers.pop_back();
+
+    assert(mTimerDepths[index] > 0);
+    mTimerDepths[index]--;
+    if (mTimerDepths[index] == 0)
+    {
+        double elapsed = Timer::GetWallTime() - mTimerStartTimes[index];
+        mTimerTotals[index] += elapsed;
+        mTimerStepTimes[index] += elapsed;
+    }
+}
+
+unsigned CellBasedProfiler::GetCounterIndex(const std::string& rName)
+{
+    std::map<std::string, unsigned>::const_iterator it = mCounterIndices.find(rName);
+    if (it != mCounterIndices.end())
+    {
+        return it->second;
+    }
+
+    unsigned index = mCounterNames.size();
+    mCounterIndices[rName] = index;
+    mCounterNames.push_back(rName);
+    mCounterTotals.push_back(0ul);
+    mCounterStepValues.push_back(0ul);
+    return index;
+}
+
+unsigned CellBasedProfiler::GetNumCounters() const
+{
+    return mCounterNames.size();
+}
+
+const std::string& CellBasedProfiler::rGetCounterName(unsigned index) const
+{
+    assert(index < mCounterNames.size());
+    return mCounterNames[index];
+}
+
+unsigned long CellBasedProfiler::GetCounterTotal(unsigned index) const
+{
+    assert(index < mCounterTotals.size());
+    return mCounterTotals[index];
+}
+
+void CellBasedProfiler::IncrementCounter(unsigned index, unsigned long amount)
+{
+    if (!mEnabled)
+    {
+        return;
+    }
+    assert(index < mCounterNames.size());
+    mCounterTotals[index] += amount;
+    mCounterStepValues[index] += amount;
+}
+
+void CellBasedProfiler::IncrementCounter(const std::string& rName, unsigned long amount)
+{
+    if (!mEnabled)
+    {
+        return;
+    }
+    IncrementCounter(GetCounterIndex(rName), amount);
+}
+
+void CellBasedProfiler::OpenTraceFile(OutputFileHandler& rOutputFileHandler, const std::string& rFileName)
+{
+    std::stringstream file_name;
+    file_name << rFileName;
+    if (PetscTools::IsParallel())
+    {
+        file_name << "_" << PetscTools::GetMyRank();
+    }
+    mpTraceFile = rOutputFileHandler.OpenOutputFile(file_name.str());
+    *mpTraceFile << "step,time,kind,name,calls,value\n";
+}
+
+bool CellBasedProfiler::IsTraceFileOpen() const
+{
+    return mpTraceFile.get() != NULL;
+}
+
+void CellBasedProfiler::WriteTraceStep(unsigned step, double time)
+{
+    if (mpTraceFile.get() != NULL)
+    {
+        for (unsigned i=0; i<mTimerNames.size(); i++)
+        {
+            if (mTimerStepCalls[i] > 0)
+            {
+                *mpTraceFile << step << "," << time << ",timer," << mTimerNames[i] << ","
+                             << mTimerStepCalls[i] << "," << mTimerStepTimes[i] << "\n";
+            }
+        }
+        for (unsigned i=0; i<mCounterNames.size(); i++)
+        {
+            if (mCounterStepValues[i] > 0)
+            {
+                *mpTraceFile << step << "," << time << ",counter," << mCounterNames[i] << ",,"
+                             << mCounterStepValues[i] << "\n";
+            }
+        }
+    }
+
+    mTimerStepTimes.assign(mTimerNames.size(), 0.0);
+    mTimerStepCalls.assign(mTimerNames.size(), 0ul);
+    mCounterStepValues.assign(mCounterNames.size(), 0ul);
+}
+
+void CellBasedProfiler::CloseTraceFile()
+{
+    if (mpTraceFile.get() != NULL)
+    {
+        // Forget the file before closing it, so that it is not left half-open if closing fails
+        out_stream p_file = mpTraceFile;
+        mpTraceFile.reset();
+        p_file->close();
+    }
+}
+
+void CellBasedProfiler::ReportTimer(std::ostream& rStream, unsigned index, unsigned indent) const
+{
+    rStream << std::string(2*indent, ' ') << mTimerNames[index] << "\t"
+            << mTimerCalls[index] << " calls\t" << mTimerTotals[index] << " s\n";
+
+    for (unsigned child=0; child<mTimerNames.size(); child++)
+    {
+        if (mTimerParents[child] == index)
+        {
+            ReportTimer(rStream, child, indent+1);
+        }
+    }
+}
+
+void CellBasedProfiler::Report(std::ostream& rStream) const
+{
+    rStream << "Timers:\n";
+    for (unsigned i=0; i<mTimerNames.size(); i++)
+    {
+        if (mTimerParents[i] == UINT_MAX)
+        {
+            ReportTimer(rStream, i, 1);
+        }
+    }
+
+    rStream << "Counters:\n";
+    for (unsigned i=0; i<mCounterNames.size(); i++)
+    {
+        rStream << "  " << mCounterNames[i] << "\t" << mCounterTotals[i] << "\n";
+    }
+    rStream << std::flush;
+}
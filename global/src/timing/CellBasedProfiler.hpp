@@ -0,0 +1,344 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLBASEDPROFILER_HPP_
+#define CELLBASEDPROFILER_HPP_
+
+#include <climits>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Identifiable.hpp"
+#include "OutputFileHandler.hpp"
+
+/**
+ * A singleton class that records fine-grained timings and counters during a
+ * cell-based simulation.
+ *
+ * Where CellBasedEventHandler times a fixed set of coarse events, this class times
+ * named scopes that are created on first use. Scopes for forces, simulation modifiers,
+ * cell killers and cell writers are keyed by the identifier of the object concerned,
+ * so each object gets its own timer. Timers nest: the parent of a timer is the timer
+ * that was open when it was first begun, which gives a hierarchy for Report().
+ *
+ * Counters record how much work was done, for example the number of node pairs
+ * evaluated or T1 swaps performed. Both timers and counters keep a running total and
+ * a value for the current time step; the latter may be written to a CSV trace file
+ * by WriteTraceStep().
+ *
+ * The profiler is disabled by default, in which case BeginTimer() and IncrementCounter()
+ * return immediately.
+ */
+class CellBasedProfiler
+{
+    friend class TestCellBasedProfiler;
+
+private:
+
+    /** Whether timings and counts are being recorded. */
+    bool mEnabled;
+
+    /** The name of each timer. */
+    std::vector<std::string> mTimerNames;
+
+    /** Map from timer names to timer indices. */
+    std::map<std::string, unsigned> mTimerIndices;
+
+    /** The parent of each timer, or UINT_MAX for a timer begun with no other timer open. */
+    std::vector<unsigned> mTimerParents;
+
+    /** Whether the parent of each timer has been set. */
+    std::vector<bool> mTimerParentIsSet;
+
+    /** The number of times each timer has been begun but not yet ended. */
+    std::vector<unsigned> mTimerDepths;
+
+    /** The wall time at which each open timer was begun. */
+    std::vector<double> mTimerStartTimes;
+
+    /** The total wall time (in seconds) recorded by each timer. */
+    std::vector<double> mTimerTotals;
+
+    /** The wall time (in seconds) recorded by each timer in the current time step. */
+    std::vector<double> mTimerStepTimes;
+
+    /** The total number of times each timer has been begun. */
+    std::vector<unsigned long> mTimerCalls;
+
+    /** The number of times each timer has been begun in the current time step. */
+    std::vector<unsigned long> mTimerStepCalls;
+
+    /** The indices of the timers currently open, innermost last. */
+    std::vector<unsigned> mOpenTimers;
+
+    /** The name of each counter. */
+    std::vector<std::string> mCounterNames;
+
+    /** Map from counter names to counter indices. */
+    std::map<std::string, unsigned> mCounterIndices;
+
+    /** The total value of each counter. */
+    std::vector<unsigned long> mCounterTotals;
+
+    /** The value of each counter in the current time step. */
+    std::vector<unsigned long> mCounterStepValues;
+
+    /**
+     * Cache of the timer index used for each object in each category, since looking up
+     * the identifier of an object is expensive. Cleared by ClearObjectCache().
+     */
+    std::map<std::pair<const Identifiable*, std::string>, unsigned> mObjectTimerIndices;
+
+    /** The CSV trace file, if open. */
+    out_stream mpTraceFile;
+
+    /**
+     * Default constructor. Private, as this is a singleton.
+     */
+    CellBasedProfiler();
+
+    /**
+     * Write the report line for a timer and, recursively, its children.
+     *
+     * @param rStream the stream to write to
+     * @param index the timer index
+     * @param indent the number of levels to indent the line by
+     */
+    void ReportTimer(std::ostream& rStream, unsigned index, unsigned indent) const;
+
+public:
+
+    /**
+     * @return the single instance of the profiler.
+     */
+    static CellBasedProfiler* Instance();
+
+    /**
+     * Start recording timings and counts.
+     */
+    void Enable();
+
+    /**
+     * Stop recording timings and counts. Timers that are open remain open until ended.
+     */
+    void Disable();
+
+    /**
+     * @return whether timings and counts are being recorded.
+     */
+    bool IsEnabled() const
+    {
+        return mEnabled;
+    }
+
+    /**
+     * Set all timings and counts to zero and close any open timers. The names of
+     * timers and counters, and their indices, are kept.
+     */
+    void Reset();
+
+    /**
+     * Forget which timer is used for each object. This should be called when objects
+     * passed to BeginTimer() may have been destroyed, since a new object may be
+     * created at the same address; AbstractCellBasedSimulation::Solve() calls it when
+     * the profiler is enabled.
+     */
+    void ClearObjectCache();
+
+    /**
+     * Get the index of a timer, creating the timer if there is none of this name.
+     *
+     * @param rName the name of the timer
+     * @return the timer index.
+     */
+    unsigned GetTimerIndex(const std::string& rName);
+
+    /**
+     * Look up the index of a timer without creating it.
+     *
+     * @param rName the name of the timer
+     * @param rIndex set to the timer index, if found
+     * @return whether there is a timer of this name.
+     */
+    bool FindTimer(const std::string& rName, unsigned& rIndex) const;
+
+    /**
+     * @return the number of timers created.
+     */
+    unsigned GetNumTimers() const;
+
+    /**
+     * @param index the timer index
+     * @return the name of a timer.
+     */
+    const std::string& rGetTimerName(unsigned index) const;
+
+    /**
+     * @param index the timer index
+     * @return the index of the parent of a timer, or UINT_MAX if the timer has no parent.
+     */
+    unsigned GetTimerParent(unsigned index) const;
+
+    /**
+     * @param index the timer index
+     * @return the total wall time (in seconds) recorded by a timer, excluding any current call.
+     */
+    double GetTimerTotal(unsigned index) const;
+
+    /**
+     * @param index the timer index
+     * @return the total number of times a timer has been begun.
+     */
+    unsigned long GetTimerCalls(unsigned index) const;
+
+    /**
+     * Begin a timer, if the profiler is enabled.
+     *
+     * @param index the timer index
+     * @return the timer index if the timer was begun, or UINT_MAX if the profiler is disabled.
+     */
+    unsigned BeginTimer(unsigned index);
+
+    /**
+     * Begin the timer of a named scope, if the profiler is enabled.
+     *
+     * @param rName the name of the timer
+     * @return the timer index if the timer was begun, or UINT_MAX if the profiler is disabled.
+     */
+    unsigned BeginTimer(const std::string& rName);
+
+    /**
+     * Begin the timer of an object, if the profiler is enabled. The timer is named
+     * "<category>:<identifier>", where the identifier is given by GetIdentifier(), or
+     * by the compiler's type name if the class of the object has no export key.
+     *
+     * @param rCategory the category of the object, such as "Force"
+     * @param pObject the object
+     * @return the timer index if the timer was begun, or UINT_MAX if the profiler is disabled.
+     */
+    unsigned BeginTimer(const std::string& rCategory, const Identifiable* pObject);
+
+    /**
+     * End a timer begun by BeginTimer(). Does nothing if index is UINT_MAX, so that
+     * the return value of BeginTimer() may always be passed to this method.
+     *
+     * @param index the timer index
+     */
+    void EndTimer(unsigned index);
+
+    /**
+     * Get the index of a counter, creating the counter if there is none of this name.
+     *
+     * @param rName the name of the counter
+     * @return the counter index.
+     */
+    unsigned GetCounterIndex(const std::string& rName);
+
+    /**
+     * @return the number of counters created.
+     */
+    unsigned GetNumCounters() const;
+
+    /**
+     * @param index the counter index
+     * @return the name of a counter.
+     */
+    const std::string& rGetCounterName(unsigned index) const;
+
+    /**
+     * @param index the counter index
+     * @return the total value of a counter.
+     */
+    unsigned long GetCounterTotal(unsigned index) const;
+
+    /**
+     * Add to a counter, if the profiler is enabled.
+     *
+     * @param index the counter index
+     * @param amount the amount to add (defaults to 1)
+     */
+    void IncrementCounter(unsigned index, unsigned long amount=1);
+
+    /**
+     * Add to a named counter, if the profiler is enabled.
+     *
+     * @param rName the name of the counter
+     * @param amount the amount to add (defaults to 1)
+     */
+    void IncrementCounter(const std::string& rName, unsigned long amount=1);
+
+    /**
+     * Open a CSV trace file, replacing any that is open, and write its header line.
+     * When running in parallel, the rank of the process is appended to the file name.
+     *
+     * @param rOutputFileHandler handler for the directory in which to create the file
+     * @param rFileName the name of the file
+     */
+    void OpenTraceFile(OutputFileHandler& rOutputFileHandler, const std::string& rFileName);
+
+    /**
+     * @return whether a trace file is open.
+     */
+    bool IsTraceFileOpen() const;
+
+    /**
+     * Write a line to the trace file, if open, for each timer and counter used since
+     * the last call to this method, then set their values for the time step to zero.
+     * Each line has the form "step,time,kind,name,calls,value", where kind is "timer"
+     * or "counter" and value is in seconds for timers.
+     *
+     * @param step the number of time steps elapsed
+     * @param time the simulation time
+     */
+    void WriteTraceStep(unsigned step, double time);
+
+    /**
+     * Close the trace file, if open.
+     */
+    void CloseTraceFile();
+
+    /**
+     * Write the hierarchy of timers, with the number of calls and total time of each,
+     * followed by the totals of the counters.
+     *
+     * @param rStream the stream to write to (defaults to std::cout)
+     */
+    void Report(std::ostream& rStream=std::cout) const;
+};
+
+#endif /*CELLBASEDPROFILER_HPP_*/
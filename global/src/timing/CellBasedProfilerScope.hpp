@@ -0,0 +1,94 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLBASEDPROFILERSCOPE_HPP_
+#define CELLBASEDPROFILERSCOPE_HPP_
+
+#include <string>
+
+#include "OutputFileHandler.hpp"
+
+/**
+ * Switches the CellBasedProfiler on or off for the lifetime of an instance of this class.
+ *
+ * When the instance is destroyed, including when an exception is thrown, any trace file
+ * opened through it is closed and the profiler is left enabled or disabled as it was
+ * before. The profiler is a single shared object, so scopes must be nested and must not
+ * be created by tasks running on the ThreadPool.
+ */
+class CellBasedProfilerScope
+{
+private:
+
+    /** Whether the profiler was enabled when this scope was created. */
+    bool mWasEnabled;
+
+    /** Whether this scope opened the trace file. */
+    bool mOpenedTraceFile;
+
+    /** Not copyable. */
+    CellBasedProfilerScope(const CellBasedProfilerScope&);
+
+    /**
+     * Not assignable.
+     * @return this object
+     */
+    CellBasedProfilerScope& operator=(const CellBasedProfilerScope&);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param enable whether the profiler is to be enabled (true) or disabled (false) in this scope
+     */
+    CellBasedProfilerScope(bool enable);
+
+    /**
+     * Destructor. Closes any trace file opened by OpenTraceFile() and restores the
+     * previous state of the profiler.
+     */
+    ~CellBasedProfilerScope();
+
+    /**
+     * Open the profiler's trace file, which is closed when this scope ends.
+     *
+     * @param rOutputFileHandler handler for the directory in which to create the file
+     * @param rFileName the name of the file
+     */
+    void OpenTraceFile(OutputFileHandler& rOutputFileHandler, const std::string& rFileName);
+};
+
+#endif /*CELLBASEDPROFILERSCOPE_HPP_*/
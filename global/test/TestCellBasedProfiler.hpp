@@ -0,0 +1,229 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCELLBASEDPROFILER_HPP_
+#define TESTCELLBASEDPROFILER_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "CheckpointArchiveTypes.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <typeinfo>
+
+#include "CellBasedProfiler.hpp"
+#include "CellBasedProfilerScope.hpp"
+#include "OutputFileHandler.hpp"
+#include "PetscTools.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * An identifiable class with no export key, used to test the timers of objects.
+ */
+class ProfiledObject : public Identifiable
+{
+};
+
+class TestCellBasedProfiler : public CxxTest::TestSuite
+{
+public:
+
+    void TestDisabledByDefault() throw(Exception)
+    {
+        CellBasedProfiler* p_profiler = CellBasedProfiler::Instance();
+        TS_ASSERT_EQUALS(p_profiler->IsEnabled(), false);
+
+        // Nothing is recorded while disabled
+        unsigned timer = p_profiler->BeginTimer("Solve");
+        TS_ASSERT_EQUALS(timer, UINT_MAX);
+        p_profiler->EndTimer(timer);
+        p_profiler->IncrementCounter("pairs", 5);
+
+        unsigned index;
+        TS_ASSERT_EQUALS(p_profiler->FindTimer("Solve", index), false);
+        TS_ASSERT_EQUALS(p_profiler->GetCounterTotal(p_profiler->GetCounterIndex("pairs")), 0u);
+    }
+
+    void TestTimersAndCounters() throw(Exception)
+    {
+        CellBasedProfiler* p_profiler = CellBasedProfiler::Instance();
+        p_profiler->Enable();
+
+        // Timers nest, and each keeps the parent it was first begun within
+        unsigned outer = p_profiler->BeginTimer("Outer");
+        for (unsigned i=0; i<3; i++)
+        {
+            unsigned inner = p_profiler->BeginTimer("Inner");
+            p_profiler->EndTimer(inner);
+        }
+        p_profiler->EndTimer(outer);
+
+        unsigned inner = p_profiler->BeginTimer("Inner");
+        p_profiler->EndTimer(inner);
+
+        unsigned index;
+        TS_ASSERT_EQUALS(p_profiler->FindTimer("Outer", index), true);
+        TS_ASSERT_EQUALS(index, outer);
+        TS_ASSERT_EQUALS(p_profiler->rGetTimerName(inner), "Inner");
+        TS_ASSERT_EQUALS(p_profiler->GetTimerParent(outer), UINT_MAX);
+        TS_ASSERT_EQUALS(p_profiler->GetTimerParent(inner), outer);
+        TS_ASSERT_EQUALS(p_profiler->GetTimerCalls(outer), 1u);
+        TS_ASSERT_EQUALS(p_profiler->GetTimerCalls(inner), 4u);
+        TS_ASSERT_LESS_THAN_EQUALS(p_profiler->GetTimerTotal(inner), p_profiler->GetTimerTotal(outer) + 1e-3);
+
+        // Objects get a timer per category, named after their class
+        ProfiledObject object;
+        unsigned object_timer = p_profiler->BeginTimer("Force", &object);
+        p_profiler->EndTimer(object_timer);
+        TS_ASSERT_EQUALS(p_profiler->rGetTimerName(object_timer), std::string("Force:") + typeid(ProfiledObject).name());
+        TS_ASSERT_EQUALS(p_profiler->BeginTimer("Force", &object), object_timer);
+        p_profiler->EndTimer(object_timer);
+        TS_ASSERT_EQUALS(p_profiler->GetTimerCalls(object_timer), 2u);
+
+        unsigned writer_timer = p_profiler->BeginTimer("Writer", &object);
+        p_profiler->EndTimer(writer_timer);
+        TS_ASSERT_DIFFERS(writer_timer, object_timer);
+
+        // Counters accumulate
+        unsigned pairs = p_profiler->GetCounterIndex("pairs");
+        p_profiler->IncrementCounter("pairs", 5);
+        p_profiler->IncrementCounter(pairs);
+        TS_ASSERT_EQUALS(p_profiler->GetCounterTotal(pairs), 6u);
+        TS_ASSERT_EQUALS(p_profiler->rGetCounterName(pairs), "pairs");
+
+        // The report shows the hierarchy of timers
+        std::stringstream report;
+        p_profiler->Report(report);
+        TS_ASSERT_DIFFERS(report.str().find("  Outer\t1 calls"), std::string::npos);
+        TS_ASSERT_DIFFERS(report.str().find("    Inner\t4 calls"), std::string::npos);
+        TS_ASSERT_DIFFERS(report.str().find("  pairs\t6"), std::string::npos);
+
+        // Reset keeps the names but not the values
+        unsigned num_timers = p_profiler->GetNumTimers();
+        p_profiler->Reset();
+        TS_ASSERT_EQUALS(p_profiler->GetNumTimers(), num_timers);
+        TS_ASSERT_EQUALS(p_profiler->GetTimerCalls(inner), 0u);
+        TS_ASSERT_EQUALS(p_profiler->GetCounterTotal(pairs), 0u);
+
+        p_profiler->ClearObjectCache();
+        p_profiler->Disable();
+    }
+
+    void TestTraceFile() throw(Exception)
+    {
+        EXIT_IF_PARALLEL; // The trace file name depends on the rank
+
+        CellBasedProfiler* p_profiler = CellBasedProfiler::Instance();
+        p_profiler->Reset();
+        p_profiler->Enable();
+
+        OutputFileHandler handler("TestCellBasedProfiler");
+        p_profiler->OpenTraceFile(handler, "trace.csv");
+        TS_ASSERT_EQUALS(p_profiler->IsTraceFileOpen(), true);
+
+        unsigned timer = p_profiler->BeginTimer("Step");
+        p_profiler->EndTimer(timer);
+        p_profiler->IncrementCounter("swaps", 2);
+        p_profiler->WriteTraceStep(1, 0.5);
+
+        // Entries not used in a time step are omitted
+        p_profiler->IncrementCounter("swaps", 3);
+        p_profiler->WriteTraceStep(2, 1.0);
+
+        p_profiler->CloseTraceFile();
+        TS_ASSERT_EQUALS(p_profiler->IsTraceFileOpen(), false);
+
+        std::ifstream trace((handler.GetOutputDirectoryFullPath() + "trace.csv").c_str());
+        std::string line;
+        std::getline(trace, line);
+        TS_ASSERT_EQUALS(line, "step,time,kind,name,calls,value");
+        std::getline(trace, line);
+        TS_ASSERT_EQUALS(line.substr(0, 20), "1,0.5,timer,Step,1,");
+        std::getline(trace, line);
+        TS_ASSERT_EQUALS(line, "1,0.5,counter,swaps,,2");
+        std::getline(trace, line);
+        TS_ASSERT_EQUALS(line, "2,1,counter,swaps,,3");
+        TS_ASSERT_EQUALS(std::getline(trace, line).good(), false);
+
+        TS_ASSERT_EQUALS(p_profiler->GetCounterTotal(p_profiler->GetCounterIndex("swaps")), 5u);
+
+        p_profiler->Reset();
+        p_profiler->Disable();
+    }
+
+    void TestScope() throw(Exception)
+    {
+        EXIT_IF_PARALLEL; // The trace file name depends on the rank
+
+        CellBasedProfiler* p_profiler = CellBasedProfiler::Instance();
+        TS_ASSERT_EQUALS(p_profiler->IsEnabled(), false);
+
+        OutputFileHandler handler("TestCellBasedProfiler", false);
+        {
+            CellBasedProfilerScope enabled_scope(true);
+            TS_ASSERT_EQUALS(p_profiler->IsEnabled(), true);
+            enabled_scope.OpenTraceFile(handler, "scope_trace.csv");
+            TS_ASSERT_EQUALS(p_profiler->IsTraceFileOpen(), true);
+
+            // Scopes may be nested
+            {
+                CellBasedProfilerScope disabled_scope(false);
+                TS_ASSERT_EQUALS(p_profiler->IsEnabled(), false);
+            }
+            TS_ASSERT_EQUALS(p_profiler->IsEnabled(), true);
+        }
+        TS_ASSERT_EQUALS(p_profiler->IsEnabled(), false);
+        TS_ASSERT_EQUALS(p_profiler->IsTraceFileOpen(), false);
+
+        // The state is restored and the file closed when an exception is thrown
+        try
+        {
+            CellBasedProfilerScope scope(true);
+            scope.OpenTraceFile(handler, "scope_trace.csv");
+            EXCEPTION("Leaving the scope");
+        }
+        catch (Exception& e)
+        {
+            TS_ASSERT_EQUALS(e.GetShortMessage(), "Leaving the scope");
+        }
+        TS_ASSERT_EQUALS(p_profiler->IsEnabled(), false);
+        TS_ASSERT_EQUALS(p_profiler->IsTraceFileOpen(), false);
+
+        p_profiler->Reset();
+    }
+};
+
+#endif /*TESTCELLBASEDPROFILER_HPP_*/
@@ -0,0 +1,157 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTCOUNTERBASEDRANDOMNUMBERGENERATOR_HPP_
+#define TESTCOUNTERBASEDRANDOMNUMBERGENERATOR_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <cmath>
+#include <vector>
+#include "CounterBasedRandomNumberGenerator.hpp"
+
+//This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestCounterBasedRandomNumberGenerator : public CxxTest::TestSuite
+{
+public:
+
+    void TestPhiloxKnownAnswers()
+    {
+        // Known answer tests from the Random123 distribution
+        {
+            boost::uint32_t counter[4] = {0u, 0u, 0u, 0u};
+            boost::uint32_t key[2] = {0u, 0u};
+            boost::uint32_t output[4];
+            CounterBasedRandomNumberGenerator::Philox4x32(counter, key, output);
+
+            TS_ASSERT_EQUALS(output[0], 0x6627e8d5u);
+            TS_ASSERT_EQUALS(output[1], 0xe169c58du);
+            TS_ASSERT_EQUALS(output[2], 0xbc57ac4cu);
+            TS_ASSERT_EQUALS(output[3], 0x9b00dbd8u);
+        }
+        {
+            boost::uint32_t counter[4] = {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu};
+            boost::uint32_t key[2] = {0xffffffffu, 0xffffffffu};
+            boost::uint32_t output[4];
+            CounterBasedRandomNumberGenerator::Philox4x32(counter, key, output);
+
+            TS_ASSERT_EQUALS(output[0], 0x408f276du);
+            TS_ASSERT_EQUALS(output[1], 0x41c83b0eu);
+            TS_ASSERT_EQUALS(output[2], 0xa20bc7c6u);
+            TS_ASSERT_EQUALS(output[3], 0x6d5451fdu);
+        }
+        {
+            boost::uint32_t counter[4] = {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u};
+            boost::uint32_t key[2] = {0xa4093822u, 0x299f31d0u};
+            boost::uint32_t output[4];
+            CounterBasedRandomNumberGenerator::Philox4x32(counter, key, output);
+
+            TS_ASSERT_EQUALS(output[0], 0xd16cfe09u);
+            TS_ASSERT_EQUALS(output[1], 0x94fdccebu);
+            TS_ASSERT_EQUALS(output[2], 0x5001e420u);
+            TS_ASSERT_EQUALS(output[3], 0x24126ea1u);
+        }
+    }
+
+    void TestStreamsAreReproducibleAndIndependent()
+    {
+        CounterBasedRandomNumberGenerator gen(7u, "TestStreams");
+        CounterBasedRandomNumberGenerator same_gen(7u, "TestStreams");
+        CounterBasedRandomNumberGenerator other_seed_gen(8u, "TestStreams");
+        CounterBasedRandomNumberGenerator other_purpose_gen(7u, "OtherStreams");
+
+        // The same key and counter always give the same number, whatever order they are drawn in
+        double first = gen.ranf(3, 10, 1);
+        TS_ASSERT_EQUALS(gen.ranf(5, 10, 0) == gen.ranf(5, 10, 0), true);
+        TS_ASSERT_EQUALS(same_gen.ranf(3, 10, 1), first);
+        TS_ASSERT_EQUALS(gen.ranf(3, 10, 1), first);
+
+        // Changing any part of the key or counter gives a different number
+        TS_ASSERT_DIFFERS(gen.ranf(3, 10, 0), first);
+        TS_ASSERT_DIFFERS(gen.ranf(4, 10, 1), first);
+        TS_ASSERT_DIFFERS(gen.ranf(3, 11, 1), first);
+        TS_ASSERT_DIFFERS(other_seed_gen.ranf(3, 10, 1), first);
+        TS_ASSERT_DIFFERS(other_purpose_gen.ranf(3, 10, 1), first);
+
+        // Batches agree with single draws
+        std::vector<double> uniforms(5);
+        std::vector<double> normals(5);
+        gen.FillUniform(3, 10, uniforms);
+        gen.FillStandardNormal(3, 10, normals);
+        for (unsigned i=0; i<5; i++)
+        {
+            TS_ASSERT_EQUALS(uniforms[i], gen.ranf(3, 10, i));
+            TS_ASSERT_EQUALS(normals[i], gen.StandardNormalRandomDeviate(3, 10, i));
+        }
+    }
+
+    void TestDistributions()
+    {
+        CounterBasedRandomNumberGenerator gen(0u, "TestDistributions");
+
+        unsigned num_samples = 100000;
+        double uniform_sum = 0.0;
+        double normal_sum = 0.0;
+        double normal_sum_squares = 0.0;
+        std::vector<double> values(4);
+
+        for (unsigned stream=0; stream<num_samples/4; stream++)
+        {
+            gen.FillUniform(stream, 0, values);
+            for (unsigned i=0; i<4; i++)
+            {
+                TS_ASSERT_LESS_THAN(0.0, values[i]);
+                TS_ASSERT_LESS_THAN_EQUALS(values[i], 1.0);
+                uniform_sum += values[i];
+            }
+
+            gen.FillStandardNormal(stream, 0, values);
+            for (unsigned i=0; i<4; i++)
+            {
+                normal_sum += values[i];
+                normal_sum_squares += values[i]*values[i];
+            }
+        }
+
+        TS_ASSERT_DELTA(uniform_sum/num_samples, 0.5, 5e-3);
+        TS_ASSERT_DELTA(normal_sum/num_samples, 0.0, 1e-2);
+        TS_ASSERT_DELTA(normal_sum_squares/num_samples, 1.0, 2e-2);
+    }
+};
+
+#endif /*TESTCOUNTERBASEDRANDOMNUMBERGENERATOR_HPP_*/
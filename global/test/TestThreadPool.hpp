@@ -0,0 +1,221 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTTHREADPOOL_HPP_
+#define TESTTHREADPOOL_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "ThreadPoolMemberTask.hpp"
+#include "FakePetscSetup.hpp"
+
+/**
+ * Helper class for TestThreadPool, which squares each item (plus an offset)
+ * and records how many times each one is visited.
+ */
+class SquareItems
+{
+public:
+    /** The result for each item. */
+    std::vector<unsigned> mSquares;
+
+    /** The number of times each item has been processed. */
+    std::vector<unsigned> mNumVisits;
+
+    /** The number added to each item index before squaring it. */
+    unsigned mOffset;
+
+    /** If less than the number of items, the item whose processing throws. */
+    unsigned mFailingItem;
+
+    /** Whether each range of items starts a nested loop over the same items. */
+    bool mUseNestedLoop;
+
+    /** For each item, whether the pool said it was running a task when the item was processed. */
+    std::vector<unsigned> mPoolWasRunningTask;
+
+    /**
+     * Constructor.
+     *
+     * @param numItems the number of items
+     */
+    SquareItems(unsigned numItems)
+        : mSquares(numItems, 0u),
+          mNumVisits(numItems, 0u),
+          mOffset(0u),
+          mFailingItem(numItems),
+          mUseNestedLoop(false),
+          mPoolWasRunningTask(numItems, 0u)
+    {
+    }
+
+    /**
+     * Process a range of items.
+     *
+     * @param begin the first item
+     * @param end one past the last item
+     */
+    void Square(unsigned begin, unsigned end)
+    {
+        for (unsigned i=begin; i<end; i++)
+        {
+            if (i == mFailingItem)
+            {
+                EXCEPTION("Item " << i << " failed");
+            }
+            mSquares[i] = (i + mOffset)*(i + mOffset);
+            mNumVisits[i]++;
+            mPoolWasRunningTask[i] = ThreadPool::Instance()->IsRunningTask();
+        }
+    }
+
+    /**
+     * Process a range of items with a nested loop, which runs on the calling thread.
+     *
+     * @param begin the first item
+     * @param end one past the last item
+     */
+    void SquareWithNestedLoop(unsigned begin, unsigned end)
+    {
+        SquareItems nested(end - begin);
+        nested.mOffset = begin;
+        ThreadPoolMemberTask<SquareItems> task(&nested, &SquareItems::Square);
+        ThreadPool::Instance()->ParallelFor(end - begin, task);
+
+        for (unsigned i=begin; i<end; i++)
+        {
+            mSquares[i] = nested.mSquares[i-begin];
+            mNumVisits[i]++;
+        }
+    }
+};
+
+class TestThreadPool : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Check that every item was visited once and squared.
+     *
+     * @param rItems the items
+     */
+    void CheckItems(const SquareItems& rItems)
+    {
+        for (unsigned i=0; i<rItems.mSquares.size(); i++)
+        {
+            TS_ASSERT_EQUALS(rItems.mSquares[i], i*i);
+            TS_ASSERT_EQUALS(rItems.mNumVisits[i], 1u);
+        }
+    }
+
+public:
+
+    void TestParallelFor() throw(Exception)
+    {
+        ThreadPool* p_pool = ThreadPool::Instance();
+        TS_ASSERT_EQUALS(p_pool->GetNumThreads(), 1u);
+
+        // With one thread the loop runs on the calling thread
+        SquareItems serial_items(100);
+        ThreadPoolMemberTask<SquareItems> serial_task(&serial_items, &SquareItems::Square);
+        p_pool->ParallelFor(100, serial_task);
+        CheckItems(serial_items);
+        TS_ASSERT_EQUALS(serial_items.mPoolWasRunningTask[0], 0u);
+
+        p_pool->SetNumThreads(4);
+        TS_ASSERT_EQUALS(p_pool->GetNumThreads(), 4u);
+
+        // Split the items evenly, then in small chunks, then with fewer items than threads; repeat to reuse the threads
+        unsigned num_items[3] = {1000, 1000, 3};
+        unsigned chunk_sizes[3] = {0, 7, 0};
+        for (unsigned repeat=0; repeat<2; repeat++)
+        {
+            for (unsigned k=0; k<3; k++)
+            {
+                SquareItems items(num_items[k]);
+                ThreadPoolMemberTask<SquareItems> task(&items, &SquareItems::Square);
+                p_pool->ParallelFor(num_items[k], task, chunk_sizes[k]);
+                CheckItems(items);
+                for (unsigned i=0; i<num_items[k]; i++)
+                {
+                    TS_ASSERT_EQUALS(items.mPoolWasRunningTask[i], 1u);
+                }
+                TS_ASSERT_EQUALS(p_pool->IsRunningTask(), false);
+            }
+        }
+
+        // Nothing to do
+        SquareItems no_items(0);
+        ThreadPoolMemberTask<SquareItems> empty_task(&no_items, &SquareItems::Square);
+        p_pool->ParallelFor(0, empty_task);
+
+        // A loop started from within a task runs on the thread running that task
+        SquareItems outer_items(100);
+        ThreadPoolMemberTask<SquareItems> outer_task(&outer_items, &SquareItems::SquareWithNestedLoop);
+        p_pool->ParallelFor(100, outer_task, 10);
+        CheckItems(outer_items);
+
+        ThreadPool::Destroy();
+    }
+
+    void TestExceptionInTask() throw(Exception)
+    {
+        ThreadPool::Instance()->SetNumThreads(3);
+
+        SquareItems items(300);
+        items.mFailingItem = 250;
+        ThreadPoolMemberTask<SquareItems> task(&items, &SquareItems::Square);
+        TS_ASSERT_THROWS_CONTAINS(ThreadPool::Instance()->ParallelFor(300, task), "Item 250 failed");
+
+        // The pool can still be used
+        SquareItems more_items(300);
+        ThreadPoolMemberTask<SquareItems> more_task(&more_items, &SquareItems::Square);
+        ThreadPool::Instance()->ParallelFor(300, more_task);
+        CheckItems(more_items);
+
+        // Changing the number of threads stops the started threads; new ones are started when needed
+        ThreadPool::Instance()->SetNumThreads(2);
+        SquareItems last_items(300);
+        ThreadPoolMemberTask<SquareItems> last_task(&last_items, &SquareItems::Square);
+        ThreadPool::Instance()->ParallelFor(300, last_task);
+        CheckItems(last_items);
+
+        ThreadPool::Destroy();
+    }
+};
+
+#endif /*TESTTHREADPOOL_HPP_*/
@@ -33,6 +33,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <algorithm>
+#include <iterator>
 #include <map>
 #include <cstring>
 
@@ -50,13 +52,17 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 MutableMesh<ELEMENT_DIM, SPACE_DIM>::MutableMesh()
-    : mAddedNodes(false)
+    : mAddedNodes(false),
+      mUseIncrementalReMesh(false),
+      mNumConnectivityChanges(0)
 {
     this->mMeshChangesDuringSimulation = true;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 MutableMesh<ELEMENT_DIM, SPACE_DIM>::MutableMesh(std::vector<Node<SPACE_DIM> *> nodes)
+    : mUseIncrementalReMesh(false),
+      mNumConnectivityChanges(0)
 {
     this->mMeshChangesDuringSimulation = true;
     Clear();
@@ -79,7 +85,7 @@ MutableMesh<ELEMENT_DIM, SPACE_DIM>::~MutableMesh()
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned MutableMesh<ELEMENT_DIM, SPACE_DIM>::AddNode(Node<SPACE_DIM>* pNewNode)
 {
-    if (mDeletedNodeIndices.empty())
+    if (mDeletedNodeIndices.empty() || mUseIncrementalReMesh)
     {
         pNewNode->SetIndex(this->mNodes.size());
         this->mNodes.push_back(pNewNode);
@@ -127,6 +133,8 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::Clear()
     mDeletedBoundaryElementIndices.clear();
     mDeletedNodeIndices.clear();
     mAddedNodes = false;
+    mNodeLocationsAtLastReMesh.clear();
+    mNumConnectivityChanges++;
 
     TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::Clear();
 }
@@ -566,6 +574,9 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReIndex(NodeMap& map)
     assert(!mAddedNodes);
     map.Resize(this->GetNumAllNodes());
 
+    // Node indices are about to change
+    mNodeLocationsAtLastReMesh.clear();
+
     std::vector<Element<ELEMENT_DIM, SPACE_DIM> *> live_elements;
 
     for (unsigned i=0; i<this->mElements.size(); i++)
@@ -698,6 +709,14 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(NodeMap& map)
             this->mpDistributedVectorFactory = new DistributedVectorFactory(this->GetNumNodes());
         }
     }
+
+    // Where possible, update the existing triangulation rather than remeshing from scratch
+    if (mUseIncrementalReMesh && ReMeshIncrementally(map))
+    {
+        RecordNodeLocationsAtReMesh();
+        return;
+    }
+
     if (SPACE_DIM==1)
     {
         // Store the node locations
@@ -803,6 +822,23 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(NodeMap& map)
 
         this->ImportFromMesher(mesher_output, mesher_output.numberoftetrahedra, mesher_output.tetrahedronlist, mesher_output.numberoftrifaces, mesher_output.trifacelist, NULL);
     }
+
+    mNumConnectivityChanges++;
+    RecordNodeLocationsAtReMesh();
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableMesh<ELEMENT_DIM, SPACE_DIM>::RecordNodeLocationsAtReMesh()
+{
+    mNodeLocationsAtLastReMesh.clear();
+    if (mUseIncrementalReMesh)
+    {
+        mNodeLocationsAtLastReMesh.reserve(this->mNodes.size());
+        for (unsigned node_index=0; node_index<this->mNodes.size(); node_index++)
+        {
+            mNodeLocationsAtLastReMesh.push_back(this->mNodes[node_index]->rGetLocation());
+        }
+    }
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -989,6 +1025,580 @@ c_vector<unsigned, 3> MutableMesh<ELEMENT_DIM, SPACE_DIM>::SplitEdge(Node<SPACE_
     return new_node_index_vector;
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableMesh<ELEMENT_DIM, SPACE_DIM>::SetUseIncrementalReMesh(bool useIncrementalReMesh)
+{
+    mUseIncrementalReMesh = useIncrementalReMesh;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::GetUseIncrementalReMesh() const
+{
+    return mUseIncrementalReMesh;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MutableMesh<ELEMENT_DIM, SPACE_DIM>::GetNumConnectivityChanges() const
+{
+    return mNumConnectivityChanges;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::MoveNodesAndReMesh(const std::vector<c_vector<double, SPACE_DIM> >& rLocations)
+{
+    if (rLocations.size() < this->mNodes.size() || !mDeletedNodeIndices.empty())
+    {
+        return false;
+    }
+
+    for (unsigned index=0; index<this->mNodes.size(); index++)
+    {
+        this->mNodes[index]->rGetModifiableLocation() = rLocations[index];
+    }
+    for (unsigned index=this->mNodes.size(); index<rLocations.size(); index++)
+    {
+        AddNode(new Node<SPACE_DIM>(index, rLocations[index]));
+    }
+
+    NodeMap map(this->mNodes.size());
+    ReMesh(map);
+    return true;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double MutableMesh<ELEMENT_DIM, SPACE_DIM>::CalculateOrientation(const c_vector<double, SPACE_DIM>& rA,
+                                                                  const c_vector<double, SPACE_DIM>& rB,
+                                                                  const c_vector<double, SPACE_DIM>& rC)
+{
+    assert(SPACE_DIM == 2);
+    c_vector<double, SPACE_DIM> a_to_b = this->GetVectorFromAtoB(rA, rB);
+    c_vector<double, SPACE_DIM> a_to_c = this->GetVectorFromAtoB(rA, rC);
+    return a_to_b[0]*a_to_c[1] - a_to_b[1]*a_to_c[0];
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<unsigned> MutableMesh<ELEMENT_DIM, SPACE_DIM>::GetElementsSharingEdge(Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB)
+{
+    const std::set<unsigned>& r_elements_a = pNodeA->rGetContainingElementIndices();
+    const std::set<unsigned>& r_elements_b = pNodeB->rGetContainingElementIndices();
+
+    std::vector<unsigned> shared_elements;
+    std::set_intersection(r_elements_a.begin(), r_elements_a.end(),
+                          r_elements_b.begin(), r_elements_b.end(),
+                          std::back_inserter(shared_elements));
+    return shared_elements;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::FlipEdgeIfNotDelaunay(Node<SPACE_DIM>* pNodeA,
+                                                                 Node<SPACE_DIM>* pNodeB,
+                                                                 std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rEdgesToCheck)
+{
+    assert(ELEMENT_DIM == 2 && SPACE_DIM == 2);
+
+    // Edges on the boundary of the mesh, or removed by an earlier flip, are left alone
+    std::vector<unsigned> shared_elements = GetElementsSharingEdge(pNodeA, pNodeB);
+    if (shared_elements.size() != 2)
+    {
+        return false;
+    }
+    Element<ELEMENT_DIM, SPACE_DIM>* p_element_1 = this->mElements[shared_elements[0]];
+    Element<ELEMENT_DIM, SPACE_DIM>* p_element_2 = this->mElements[shared_elements[1]];
+
+    // Find the node of each element opposite the edge
+    Node<SPACE_DIM>* p_node_c = NULL;
+    Node<SPACE_DIM>* p_node_d = NULL;
+    for (unsigned i=0; i<3; i++)
+    {
+        if (p_element_1->GetNode(i) != pNodeA && p_element_1->GetNode(i) != pNodeB)
+        {
+            p_node_c = p_element_1->GetNode(i);
+        }
+        if (p_element_2->GetNode(i) != pNodeA && p_element_2->GetNode(i) != pNodeB)
+        {
+            p_node_d = p_element_2->GetNode(i);
+        }
+    }
+    assert(p_node_c != NULL && p_node_d != NULL);
+
+    // Label the edge so that (a,b,c) is anticlockwise, as every element is
+    if (CalculateOrientation(pNodeA->rGetLocation(), pNodeB->rGetLocation(), p_node_c->rGetLocation()) < 0.0)
+    {
+        std::swap(pNodeA, pNodeB);
+    }
+    const c_vector<double, SPACE_DIM>& r_a = pNodeA->rGetLocation();
+    const c_vector<double, SPACE_DIM>& r_b = pNodeB->rGetLocation();
+    const c_vector<double, SPACE_DIM>& r_c = p_node_c->rGetLocation();
+    const c_vector<double, SPACE_DIM>& r_d = p_node_d->rGetLocation();
+
+    // The edge is locally Delaunay unless d lies strictly inside the circumcircle of (a,b,c)
+    c_vector<double, SPACE_DIM> d_to_a = this->GetVectorFromAtoB(r_d, r_a);
+    c_vector<double, SPACE_DIM> d_to_b = this->GetVectorFromAtoB(r_d, r_b);
+    c_vector<double, SPACE_DIM> d_to_c = this->GetVectorFromAtoB(r_d, r_c);
+    double adx = d_to_a[0];
+    double ady = d_to_a[1];
+    double bdx = d_to_b[0];
+    double bdy = d_to_b[1];
+    double cdx = d_to_c[0];
+    double cdy = d_to_c[1];
+    double ad2 = adx*adx + ady*ady;
+    double bd2 = bdx*bdx + bdy*bdy;
+    double cd2 = cdx*cdx + cdy*cdy;
+    double in_circle = adx*(bdy*cd2 - cdy*bd2) - ady*(bdx*cd2 - cdx*bd2) + ad2*(bdx*cdy - cdx*bdy);
+    double magnitude = fabs(adx)*(fabs(bdy)*cd2 + fabs(cdy)*bd2)
+                     + fabs(ady)*(fabs(bdx)*cd2 + fabs(cdx)*bd2)
+                     + ad2*(fabs(bdx*cdy) + fabs(cdx*bdy));
+
+    // Treat nearly cocircular nodes as cocircular, so that round-off error cannot cause repeated flips
+    if (in_circle <= 1e-10*magnitude)
+    {
+        return false;
+    }
+
+    // The flipped elements (a,d,c) and (d,b,c) must both be valid
+    if (CalculateOrientation(r_a, r_d, r_c) <= DBL_EPSILON || CalculateOrientation(r_d, r_b, r_c) <= DBL_EPSILON)
+    {
+        return false;
+    }
+
+    // Replacing nodes in place preserves the anticlockwise ordering of each element
+    p_element_1->ReplaceNode(pNodeB, p_node_d);
+    p_element_2->ReplaceNode(pNodeA, p_node_c);
+
+    rEdgesToCheck.push_back(std::make_pair(pNodeA, p_node_c));
+    rEdgesToCheck.push_back(std::make_pair(p_node_c, pNodeB));
+    rEdgesToCheck.push_back(std::make_pair(pNodeB, p_node_d));
+    rEdgesToCheck.push_back(std::make_pair(p_node_d, pNodeA));
+    return true;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::CheckBoundaryForIncrementalReMesh()
+{
+    /*
+     * Remeshing from scratch would triangulate the convex hull of the nodes, so check that
+     * the boundary of the mesh is still convex. Each boundary edge is directed so that its
+     * element lies on the left, giving an anticlockwise loop around the mesh.
+     */
+    std::map<Node<SPACE_DIM>*, Node<SPACE_DIM>*> next_boundary_node;
+    for (unsigned b_elem_index=0; b_elem_index<this->mBoundaryElements.size(); b_elem_index++)
+    {
+        Node<SPACE_DIM>* p_node_u = this->mBoundaryElements[b_elem_index]->GetNode(0);
+        Node<SPACE_DIM>* p_node_v = this->mBoundaryElements[b_elem_index]->GetNode(ELEMENT_DIM-1);
+
+        std::vector<unsigned> shared_elements = GetElementsSharingEdge(p_node_u, p_node_v);
+        if (shared_elements.size() != 1)
+        {
+            return false;
+        }
+        Element<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[shared_elements[0]];
+        unsigned local_index = 0;
+        while (p_element->GetNode(local_index) == p_node_u || p_element->GetNode(local_index) == p_node_v)
+        {
+            local_index++;
+        }
+        if (CalculateOrientation(p_node_u->rGetLocation(), p_node_v->rGetLocation(), p_element->GetNode(local_index)->rGetLocation()) < 0.0)
+        {
+            std::swap(p_node_u, p_node_v);
+        }
+        next_boundary_node[p_node_u] = p_node_v;
+    }
+    for (typename std::map<Node<SPACE_DIM>*, Node<SPACE_DIM>*>::iterator iter = next_boundary_node.begin();
+         iter != next_boundary_node.end();
+         ++iter)
+    {
+        typename std::map<Node<SPACE_DIM>*, Node<SPACE_DIM>*>::iterator next_iter = next_boundary_node.find(iter->second);
+        if (next_iter == next_boundary_node.end())
+        {
+            return false;
+        }
+        c_vector<double, SPACE_DIM> edge_1 = iter->second->rGetLocation() - iter->first->rGetLocation();
+        c_vector<double, SPACE_DIM> edge_2 = next_iter->second->rGetLocation() - iter->second->rGetLocation();
+
+        // Allow for round-off error where consecutive boundary edges are collinear
+        if (edge_1[0]*edge_2[1] - edge_1[1]*edge_2[0] < -1e-12*norm_2(edge_1)*norm_2(edge_2))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::FlipEdgesUntilDelaunay(std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rEdgesToCheck,
+                                                                  unsigned& rNumFlips)
+{
+    // Give up if this takes unexpectedly long
+    unsigned max_num_flips = 100*this->mElements.size();
+    while (!rEdgesToCheck.empty())
+    {
+        std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> edge = rEdgesToCheck.back();
+        rEdgesToCheck.pop_back();
+
+        if (FlipEdgeIfNotDelaunay(edge.first, edge.second, rEdgesToCheck))
+        {
+            rNumFlips++;
+            if (rNumFlips > max_num_flips)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+Element<ELEMENT_DIM, SPACE_DIM>* MutableMesh<ELEMENT_DIM, SPACE_DIM>::LocateElementByWalk(const c_vector<double, SPACE_DIM>& rLocation,
+                                                                                            Element<ELEMENT_DIM, SPACE_DIM>* pStartElement)
+{
+    assert(ELEMENT_DIM == 2 && SPACE_DIM == 2);
+
+    Element<ELEMENT_DIM, SPACE_DIM>* p_element = pStartElement;
+    for (unsigned step=0; step<this->mElements.size(); step++)
+    {
+        bool is_on_edge = false;
+        Element<ELEMENT_DIM, SPACE_DIM>* p_next_element = NULL;
+        for (unsigned i=0; i<3 && p_next_element==NULL; i++)
+        {
+            Node<SPACE_DIM>* p_node_a = p_element->GetNode(i);
+            Node<SPACE_DIM>* p_node_b = p_element->GetNode((i+1)%3);
+            double orientation = CalculateOrientation(p_node_a->rGetLocation(), p_node_b->rGetLocation(), rLocation);
+            if (orientation < 0.0)
+            {
+                // The point is on the far side of this edge, so step into the neighbouring element
+                std::vector<unsigned> shared_elements = GetElementsSharingEdge(p_node_a, p_node_b);
+                if (shared_elements.size() != 2)
+                {
+                    // The edge is on the boundary, so the point is outside the mesh
+                    return NULL;
+                }
+                unsigned next_index = (shared_elements[0] == p_element->GetIndex()) ? shared_elements[1] : shared_elements[0];
+                p_next_element = this->mElements[next_index];
+            }
+            else if (orientation <= DBL_EPSILON)
+            {
+                is_on_edge = true;
+            }
+        }
+
+        if (p_next_element == NULL)
+        {
+            return is_on_edge ? NULL : p_element;
+        }
+        p_element = p_next_element;
+    }
+
+    // The walk should not cycle, but guard against round-off error
+    return NULL;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::RetriangulateAroundDeletedNode(Node<SPACE_DIM>* pNode,
+                                                                          std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rEdgesToCheck)
+{
+    assert(ELEMENT_DIM == 2 && SPACE_DIM == 2);
+    assert(pNode->IsDeleted());
+
+    const std::set<unsigned>& r_containing_elements = pNode->rGetContainingElementIndices();
+    std::vector<unsigned> star_elements(r_containing_elements.begin(), r_containing_elements.end());
+
+    // Each element (p,a,b), ordered anticlockwise, contributes the edge from a to b of the polygon around p
+    std::map<Node<SPACE_DIM>*, Node<SPACE_DIM>*> next_polygon_node;
+    for (unsigned i=0; i<star_elements.size(); i++)
+    {
+        Element<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[star_elements[i]];
+        unsigned local_index = 0;
+        while (p_element->GetNode(local_index) != pNode)
+        {
+            local_index++;
+        }
+        next_polygon_node[p_element->GetNode((local_index+1)%3)] = p_element->GetNode((local_index+2)%3);
+    }
+
+    // Follow the edges round the polygon, which must close up after visiting each element once
+    std::vector<Node<SPACE_DIM>*> polygon;
+    Node<SPACE_DIM>* p_first_node = next_polygon_node.begin()->first;
+    Node<SPACE_DIM>* p_current_node = p_first_node;
+    do
+    {
+        typename std::map<Node<SPACE_DIM>*, Node<SPACE_DIM>*>::iterator iter = next_polygon_node.find(p_current_node);
+        if (iter == next_polygon_node.end() || polygon.size() == star_elements.size())
+        {
+            return false;
+        }
+        polygon.push_back(p_current_node);
+        p_current_node = iter->second;
+    }
+    while (p_current_node != p_first_node);
+
+    if (polygon.size() != star_elements.size())
+    {
+        return false;
+    }
+
+    // Triangulate the polygon by repeatedly clipping off an ear, which is a convex corner containing no other corner
+    std::vector<std::vector<Node<SPACE_DIM>*> > new_element_nodes;
+    while (polygon.size() > 3)
+    {
+        bool found_ear = false;
+        for (unsigned i=0; i<polygon.size() && !found_ear; i++)
+        {
+            Node<SPACE_DIM>* p_previous_node = polygon[(i + polygon.size() - 1)%polygon.size()];
+            Node<SPACE_DIM>* p_ear_node = polygon[i];
+            Node<SPACE_DIM>* p_next_node = polygon[(i+1)%polygon.size()];
+            const c_vector<double, SPACE_DIM>& r_previous = p_previous_node->rGetLocation();
+            const c_vector<double, SPACE_DIM>& r_ear = p_ear_node->rGetLocation();
+            const c_vector<double, SPACE_DIM>& r_next = p_next_node->rGetLocation();
+
+            if (CalculateOrientation(r_previous, r_ear, r_next) <= DBL_EPSILON)
+            {
+                continue;
+            }
+
+            bool is_ear = true;
+            for (unsigned j=0; j<polygon.size() && is_ear; j++)
+            {
+                if (polygon[j] != p_previous_node && polygon[j] != p_ear_node && polygon[j] != p_next_node)
+                {
+                    const c_vector<double, SPACE_DIM>& r_other = polygon[j]->rGetLocation();
+                    if (CalculateOrientation(r_previous, r_ear, r_other) >= 0.0
+                        && CalculateOrientation(r_ear, r_next, r_other) >= 0.0
+                        && CalculateOrientation(r_next, r_previous, r_other) >= 0.0)
+                    {
+                        is_ear = false;
+                    }
+                }
+            }
+
+            if (is_ear)
+            {
+                std::vector<Node<SPACE_DIM>*> nodes;
+                nodes.push_back(p_previous_node);
+                nodes.push_back(p_ear_node);
+                nodes.push_back(p_next_node);
+                new_element_nodes.push_back(nodes);
+                polygon.erase(polygon.begin() + i);
+                found_ear = true;
+            }
+        }
+
+        if (!found_ear)
+        {
+            return false;
+        }
+    }
+    if (CalculateOrientation(polygon[0]->rGetLocation(), polygon[1]->rGetLocation(), polygon[2]->rGetLocation()) <= DBL_EPSILON)
+    {
+        return false;
+    }
+    new_element_nodes.push_back(polygon);
+
+    // Replace the elements around the node, reusing the slots of all but two of them
+    for (unsigned i=0; i<star_elements.size(); i++)
+    {
+        this->mElements[star_elements[i]]->MarkAsDeleted();
+    }
+    for (unsigned i=0; i<new_element_nodes.size(); i++)
+    {
+        unsigned index = star_elements[i];
+        delete this->mElements[index];
+        this->mElements[index] = new Element<ELEMENT_DIM, SPACE_DIM>(index, new_element_nodes[i]);
+
+        for (unsigned j=0; j<3; j++)
+        {
+            rEdgesToCheck.push_back(std::make_pair(new_element_nodes[i][j], new_element_nodes[i][(j+1)%3]));
+        }
+    }
+    for (unsigned i=new_element_nodes.size(); i<star_elements.size(); i++)
+    {
+        mDeletedElementIndices.push_back(star_elements[i]);
+    }
+    return true;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReMeshIncrementally(NodeMap& rMap)
+{
+    if (ELEMENT_DIM != 2 || SPACE_DIM != 2)
+    {
+        return false;
+    }
+
+    // Deleted elements or boundary elements would leave holes in the triangulation
+    if (!mDeletedElementIndices.empty() || !mDeletedBoundaryElementIndices.empty() || this->mElements.empty())
+    {
+        return false;
+    }
+
+    /*
+     * Sort the nodes into those to be removed from or inserted into the triangulation, and find
+     * the elements touched by nodes that have been added, removed or moved since the last remesh.
+     * Only edges of these elements can have stopped being locally Delaunay.
+     */
+    std::vector<Node<SPACE_DIM>*> nodes_to_remove;
+    std::vector<Node<SPACE_DIM>*> nodes_to_insert;
+    std::set<unsigned> touched_elements;
+    for (unsigned node_index=0; node_index<this->mNodes.size(); node_index++)
+    {
+        Node<SPACE_DIM>* p_node = this->mNodes[node_index];
+        if (p_node->GetNumContainingElements() == 0)
+        {
+            if (!p_node->IsDeleted())
+            {
+                nodes_to_insert.push_back(p_node);
+            }
+            continue;
+        }
+
+        bool is_touched = (node_index >= mNodeLocationsAtLastReMesh.size());
+        if (p_node->IsDeleted())
+        {
+            // Removing a node from the boundary would change the boundary of the mesh
+            if (p_node->IsBoundaryNode())
+            {
+                return false;
+            }
+            nodes_to_remove.push_back(p_node);
+            is_touched = true;
+        }
+        else if (!is_touched)
+        {
+            is_touched = (norm_inf(p_node->rGetLocation() - mNodeLocationsAtLastReMesh[node_index]) > 0.0);
+        }
+
+        if (is_touched)
+        {
+            const std::set<unsigned>& r_containing_elements = p_node->rGetContainingElementIndices();
+            touched_elements.insert(r_containing_elements.begin(), r_containing_elements.end());
+        }
+    }
+
+    // Check that no element has been inverted, or squashed flat, by node motion
+    for (std::set<unsigned>::iterator iter = touched_elements.begin();
+         iter != touched_elements.end();
+         ++iter)
+    {
+        Element<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[*iter];
+        if (CalculateOrientation(p_element->GetNode(0)->rGetLocation(),
+                                 p_element->GetNode(1)->rGetLocation(),
+                                 p_element->GetNode(2)->rGetLocation()) <= DBL_EPSILON)
+        {
+            return false;
+        }
+    }
+
+    if (!CheckBoundaryForIncrementalReMesh())
+    {
+        return false;
+    }
+
+    std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> > edges_to_check;
+    unsigned num_flips = 0;
+
+    // Remove any deleted nodes from the triangulation
+    for (unsigned i=0; i<nodes_to_remove.size(); i++)
+    {
+        if (!RetriangulateAroundDeletedNode(nodes_to_remove[i], edges_to_check))
+        {
+            return false;
+        }
+    }
+
+    // Restore the Delaunay property around the touched elements, which may have been replaced above
+    for (std::set<unsigned>::iterator iter = touched_elements.begin();
+         iter != touched_elements.end();
+         ++iter)
+    {
+        Element<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[*iter];
+        if (!p_element->IsDeleted())
+        {
+            for (unsigned i=0; i<3; i++)
+            {
+                edges_to_check.push_back(std::make_pair(p_element->GetNode(i), p_element->GetNode((i+1)%3)));
+            }
+        }
+    }
+    if (!FlipEdgesUntilDelaunay(edges_to_check, num_flips))
+    {
+        return false;
+    }
+
+    /*
+     * Insert any nodes that have been added since the last remesh one at a time, restoring the
+     * Delaunay property after each so that the walk locating the next one cannot cycle. Each walk
+     * starts from the element containing the previously inserted node, since nodes are usually
+     * added close to one another.
+     */
+    Element<ELEMENT_DIM, SPACE_DIM>* p_start_element = NULL;
+    for (unsigned elem_index=0; p_start_element==NULL; elem_index++)
+    {
+        if (!this->mElements[elem_index]->IsDeleted())
+        {
+            p_start_element = this->mElements[elem_index];
+        }
+    }
+    for (unsigned i=0; i<nodes_to_insert.size(); i++)
+    {
+        Node<SPACE_DIM>* p_new_node = nodes_to_insert[i];
+        Element<ELEMENT_DIM, SPACE_DIM>* p_containing_element = LocateElementByWalk(p_new_node->rGetLocation(), p_start_element);
+
+        // Nodes outside the mesh, or on an edge, change the boundary or need special treatment
+        if (p_containing_element == NULL)
+        {
+            return false;
+        }
+
+        // Split the element (n0,n1,n2) into (n0,n1,p), (n1,n2,p) and (n2,n0,p)
+        Node<SPACE_DIM>* p_node_0 = p_containing_element->GetNode(0);
+        Node<SPACE_DIM>* p_node_1 = p_containing_element->GetNode(1);
+        Node<SPACE_DIM>* p_node_2 = p_containing_element->GetNode(2);
+
+        std::vector<Node<SPACE_DIM>*> nodes_12;
+        nodes_12.push_back(p_node_1);
+        nodes_12.push_back(p_node_2);
+        nodes_12.push_back(p_new_node);
+
+        std::vector<Node<SPACE_DIM>*> nodes_20;
+        nodes_20.push_back(p_node_2);
+        nodes_20.push_back(p_node_0);
+        nodes_20.push_back(p_new_node);
+
+        p_containing_element->ReplaceNode(p_node_2, p_new_node);
+        this->mElements.push_back(new Element<ELEMENT_DIM, SPACE_DIM>(this->mElements.size(), nodes_12));
+        this->mElements.push_back(new Element<ELEMENT_DIM, SPACE_DIM>(this->mElements.size(), nodes_20));
+
+        edges_to_check.push_back(std::make_pair(p_node_0, p_node_1));
+        edges_to_check.push_back(std::make_pair(p_node_1, p_node_2));
+        edges_to_check.push_back(std::make_pair(p_node_2, p_node_0));
+        if (!FlipEdgesUntilDelaunay(edges_to_check, num_flips))
+        {
+            return false;
+        }
+
+        // Flips only replace nodes within elements, so this element still contains the new node
+        p_start_element = p_containing_element;
+    }
+
+    if (num_flips > 0 || !nodes_to_remove.empty() || !nodes_to_insert.empty())
+    {
+        mNumConnectivityChanges++;
+    }
+
+    mAddedNodes = false;
+    this->RefreshJacobianCachedData();
+
+    // Remove the deleted nodes and elements, if any, from the mesh
+    if (mDeletedNodeIndices.empty() && mDeletedElementIndices.empty())
+    {
+        rMap.ResetToIdentity();
+    }
+    else
+    {
+        ReIndex(rMap);
+    }
+    return true;
+}
+
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::CheckIsVoronoi(Element<ELEMENT_DIM, SPACE_DIM>* pElement, double maxPenetration)
 {
@@ -150,6 +150,76 @@ protected:
     /** Whether any nodes have been added to the mesh. */
     bool mAddedNodes;
 
+    /**
+     * Whether ReMesh() should first try to restore the Delaunay property by updating the
+     * existing triangulation locally, rather than remeshing from scratch. Defaults to false.
+     */
+    bool mUseIncrementalReMesh;
+
+    /**
+     * The location of each node at the end of the last call to ReMesh(), used by
+     * ReMeshIncrementally() to find the nodes that have moved since. Only stored when
+     * mUseIncrementalReMesh is true, and cleared whenever the mesh is cleared or reindexed.
+     */
+    std::vector<c_vector<double, SPACE_DIM> > mNodeLocationsAtLastReMesh;
+
+    /**
+     * The number of times the connectivity of the mesh has been changed by ReMesh() or Clear().
+     * Used by GetNumConnectivityChanges().
+     */
+    unsigned mNumConnectivityChanges;
+
+    /**
+     * Try to restore the Delaunay property by updating the existing triangulation, rather than
+     * remeshing from scratch. Deleted nodes are removed by retriangulating the polygon formed by
+     * the elements containing them, edges of elements containing nodes that have moved since the
+     * last remesh are flipped until locally Delaunay, and newly added nodes are then inserted one
+     * at a time into the elements containing them, which are found by walking from the element
+     * containing the previously inserted node. All geometric tests use GetVectorFromAtoB(), so this
+     * also works on periodic meshes.
+     *
+     * This is only implemented in 2D, and only when no elements or boundary elements have been
+     * deleted, no boundary node has been deleted, no element has been inverted by node motion and
+     * CheckBoundaryForIncrementalReMesh() holds, since otherwise the boundary of the mesh would
+     * change. If these conditions do not hold, or a new node lies outside the mesh or on an edge,
+     * the method returns false, leaving ReMesh() to remesh from scratch.
+     *
+     * @param rMap a NodeMap which is filled in to associate the indices of nodes before and after
+     *     the update; this is the identity unless nodes have been deleted
+     * @return whether the triangulation was successfully updated
+     */
+    bool ReMeshIncrementally(NodeMap& rMap);
+
+    /**
+     * Store the current node locations in mNodeLocationsAtLastReMesh, if mUseIncrementalReMesh is
+     * true. Called at the end of ReMesh().
+     */
+    void RecordNodeLocationsAtReMesh();
+
+    /**
+     * Called by ReMeshIncrementally() to check that remeshing from scratch would not change the
+     * boundary of the mesh. Since remeshing from scratch triangulates the convex hull of the
+     * nodes, this checks that the boundary of the mesh is still convex. Only used in 2D.
+     *
+     * @return whether the boundary of the mesh may be kept by an incremental remesh
+     */
+    virtual bool CheckBoundaryForIncrementalReMesh();
+
+    /**
+     * @return twice the signed area of the triangle with the given corners, which is positive
+     * if the corners are ordered anticlockwise. Only used in 2D.
+     *
+     * The sides are computed using GetVectorFromAtoB(), so that triangles straddling a periodic
+     * boundary are treated correctly.
+     *
+     * @param rA the first corner
+     * @param rB the second corner
+     * @param rC the third corner
+     */
+    double CalculateOrientation(const c_vector<double, SPACE_DIM>& rA,
+                                const c_vector<double, SPACE_DIM>& rB,
+                                const c_vector<double, SPACE_DIM>& rC);
+
 private:
 
 // LCOV_EXCL_START
@@ -164,6 +234,64 @@ private:
     bool CheckIsVoronoi(Element<ELEMENT_DIM, SPACE_DIM>* pElement, double maxPenetration);
 // LCOV_EXCL_STOP
 
+    /**
+     * @return the indices of the elements containing both of two given nodes.
+     *
+     * @param pNodeA the first node
+     * @param pNodeB the second node
+     */
+    std::vector<unsigned> GetElementsSharingEdge(Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB);
+
+    /**
+     * If the edge between two nodes is shared by two elements and is not locally Delaunay, flip it
+     * and add the four edges surrounding it to a stack of edges to be checked. Only used in 2D.
+     *
+     * @param pNodeA the first node
+     * @param pNodeB the second node
+     * @param rEdgesToCheck the stack of edges to be checked
+     * @return whether the edge was flipped
+     */
+    bool FlipEdgeIfNotDelaunay(Node<SPACE_DIM>* pNodeA,
+                               Node<SPACE_DIM>* pNodeB,
+                               std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rEdgesToCheck);
+
+    /**
+     * Flip edges from a stack until every edge on it is locally Delaunay. Only used in 2D.
+     *
+     * @param rEdgesToCheck the stack of edges to be checked, which is emptied
+     * @param rNumFlips the number of flips made so far, which is incremented for each flip
+     * @return false if the total number of flips becomes unexpectedly large, true otherwise
+     */
+    bool FlipEdgesUntilDelaunay(std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rEdgesToCheck,
+                                unsigned& rNumFlips);
+
+    /**
+     * Find the element containing a point by walking from a given element towards the point,
+     * crossing at each step an edge that separates the current element from the point. On a
+     * Delaunay triangulation this walk cannot cycle. Only used in 2D.
+     *
+     * @param rLocation the point
+     * @param pStartElement the element to start the walk from
+     * @return the element strictly containing the point, or NULL if the point lies outside the
+     *     mesh or on an edge
+     */
+    Element<ELEMENT_DIM, SPACE_DIM>* LocateElementByWalk(const c_vector<double, SPACE_DIM>& rLocation,
+                                                         Element<ELEMENT_DIM, SPACE_DIM>* pStartElement);
+
+    /**
+     * Remove a deleted interior node from the triangulation by retriangulating the polygon formed
+     * by the elements containing it. The polygon is triangulated by clipping ears, reusing the
+     * slots of the old elements and marking the two left over as deleted, and the edges of the new
+     * elements are added to a stack of edges to be checked. Only used in 2D.
+     *
+     * @param pNode the deleted node
+     * @param rEdgesToCheck the stack of edges to be checked
+     * @return false, leaving the mesh unchanged, if the elements containing the node do not form
+     *     a simple polygon around it; true otherwise
+     */
+    bool RetriangulateAroundDeletedNode(Node<SPACE_DIM>* pNode,
+                                        std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rEdgesToCheck);
+
 public:
 
     /**
@@ -218,6 +346,9 @@ public:
      *
      * NB. After calling this one or more times, you must then call ReMesh
      *
+     * The indices of deleted nodes are reused, unless mUseIncrementalReMesh is true, since the
+     * elements of the existing triangulation still refer to deleted nodes until the next remesh.
+     *
      * @param pNewNode  pointer to the new node
      * @return the index of the new node in the mesh
      */
@@ -326,6 +457,37 @@ public:
      */
     void ReMesh();
 
+    /**
+     * Set mUseIncrementalReMesh.
+     *
+     * @param useIncrementalReMesh whether ReMesh() should first try to update the existing triangulation
+     */
+    void SetUseIncrementalReMesh(bool useIncrementalReMesh);
+
+    /**
+     * @return mUseIncrementalReMesh.
+     */
+    bool GetUseIncrementalReMesh() const;
+
+    /**
+     * @return the number of times the connectivity of the mesh has been changed by ReMesh() or
+     * Clear(). This is unchanged by a remesh that only moves nodes without flipping any edges, so
+     * may be used to decide whether data depending on the connectivity, such as the sparsity
+     * pattern of a finite element matrix, needs to be rebuilt.
+     */
+    unsigned GetNumConnectivityChanges() const;
+
+    /**
+     * Move the nodes of the mesh to new locations and remesh. If there are more locations than
+     * nodes, new nodes are added for the extra locations. This allows a mesh constructed from a set
+     * of points to be reused, and updated incrementally, when the points move or new points appear.
+     *
+     * @param rLocations the new node locations, in order of node index
+     * @return false, leaving the mesh unchanged, if there are fewer locations than nodes or any
+     *     nodes have been deleted; true otherwise
+     */
+    bool MoveNodesAndReMesh(const std::vector<c_vector<double, SPACE_DIM> >& rLocations);
+
 // LCOV_EXCL_START
     /**
      * Find edges in the mesh longer than the given cutoff length and split them creating new elements as required.
@@ -281,11 +281,11 @@ void NodesOnlyMesh<SPACE_DIM>::CalculateNodesOutsideLocalDomain()
         {
             // Do nothing.
         }
-        else if (owning_process == PetscTools::GetMyRank() + 1)
+        else if (owning_process > PetscTools::GetMyRank())
         {
             mNodesToSendRight.push_back(node_iter->GetIndex());
         }
-        else if (owning_process == PetscTools::GetMyRank() - 1)
+        else
         {
             mNodesToSendLeft.push_back(node_iter->GetIndex());
         }
@@ -628,6 +628,28 @@ void NodesOnlyMesh<SPACE_DIM>::LoadBalanceMesh()
 
     unsigned new_rows = mpBoxCollection->LoadBalance(local_node_distribution);
 
+    SetNumLocalRowsOfBoxCollection(new_rows);
+}
+
+template<unsigned SPACE_DIM>
+void NodesOnlyMesh<SPACE_DIM>::RebalanceMeshSlabs(double localCostPerNode)
+{
+    std::vector<int> local_node_distribution = mpBoxCollection->CalculateNumberOfNodesInEachStrip();
+
+    std::vector<double> local_loads(local_node_distribution.size());
+    for (unsigned i=0; i<local_node_distribution.size(); i++)
+    {
+        local_loads[i] = localCostPerNode*local_node_distribution[i];
+    }
+
+    unsigned new_rows = mpBoxCollection->RebalanceSlabs(local_loads);
+
+    SetNumLocalRowsOfBoxCollection(new_rows);
+}
+
+template<unsigned SPACE_DIM>
+void NodesOnlyMesh<SPACE_DIM>::SetNumLocalRowsOfBoxCollection(unsigned numLocalRows)
+{
     c_vector<double, 2*SPACE_DIM> current_domain_size = mpBoxCollection->rGetDomainSize();
 
     // This ensures the domain will stay the same size.
@@ -637,7 +659,7 @@ void NodesOnlyMesh<SPACE_DIM>::LoadBalanceMesh()
         current_domain_size[2*d] = current_domain_size[2*d] + fudge;
         current_domain_size[2*d+1] = current_domain_size[2*d+1] - fudge;
     }
-    SetUpBoxCollection(mMaximumInteractionDistance, current_domain_size, new_rows);
+    SetUpBoxCollection(mMaximumInteractionDistance, current_domain_size, numLocalRows);
 }
 
 template<unsigned SPACE_DIM>
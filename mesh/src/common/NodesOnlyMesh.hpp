@@ -172,6 +172,14 @@ private:
       */
      void AddNodeWithFixedIndex(Node<SPACE_DIM>* pNewNode);
 
+     /**
+      * Set up the box collection again over the same domain, with a new number of rows owned by this process.
+      * Called by the load-balancing methods.
+      *
+      * @param numLocalRows the number of rows that should be owned by this process.
+      */
+     void SetNumLocalRowsOfBoxCollection(unsigned numLocalRows);
+
 protected:
 
     /**  Clear the BoxCollection  */
@@ -344,6 +352,7 @@ public:
 
     /**
      * Work out which nodes lie outside the local domain and add their indices to the vectors #mNodesToSendLeft and #mNodesToSendRight.
+     * A node owned by a process that is not a neighbour of this process is sent towards it.
      */
     void CalculateNodesOutsideLocalDomain();
 
@@ -428,6 +437,21 @@ public:
      */
     void LoadBalanceMesh();
 
+    /**
+     * Move all the slab boundaries of the underlying BoxCollection in a single step, so that each process
+     * carries as near an equal share of the load as whole rows allow. The load on each row of boxes is the number of nodes it contains
+     * multiplied by the cost of a node on the process that owns it.
+     *
+     * After this call nodes may lie several processes away from their owning process.
+     *
+     * Processes still own slabs of whole rows, as for LoadBalanceMesh(), so a cluster of nodes that lies
+     * within a few rows cannot be shared between more processes than it has rows.
+     *
+     * @param localCostPerNode the cost of a node on this process, for example its measured share of the
+     *     time spent calculating forces (defaults to 1.0, which balances the number of nodes)
+     */
+    void RebalanceMeshSlabs(double localCostPerNode=1.0);
+
     /**
      * Overridden ConstructFromMeshReader to correctly assign global node indices on load.
      *
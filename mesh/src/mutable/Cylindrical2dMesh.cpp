@@ -42,6 +42,7 @@ mesh_writer.WriteFilesUsingMesh(*this);
 */
 #include "Cylindrical2dMesh.hpp"
 #include "Exception.hpp"
+#include "UblasCustomFunctions.hpp"
 
 Cylindrical2dMesh::Cylindrical2dMesh(double width)
   : MutableMesh<2,2>(),
@@ -194,6 +195,30 @@ void Cylindrical2dMesh::ReMesh(NodeMap& rMap)
         }
     }
 
+    // Where possible, update the existing triangulation on the cylinder rather than remeshing from scratch
+    if (mUseIncrementalReMesh)
+    {
+        bool num_nodes_changed = mAddedNodes || !mDeletedNodeIndices.empty();
+        if (ReMeshIncrementally(rMap))
+        {
+            if (num_nodes_changed && mpDistributedVectorFactory)
+            {
+                // Size of mesh has changed
+                delete mpDistributedVectorFactory;
+                mpDistributedVectorFactory = new DistributedVectorFactory(GetNumNodes());
+            }
+            RecordNodeLocationsAtReMesh();
+            return;
+        }
+    }
+
+    /*
+     * The halo and mirrored nodes must reuse the indices of any deleted nodes, which
+     * AddNode() only does if the mesh is not being remeshed incrementally.
+     */
+    bool use_incremental_remesh = mUseIncrementalReMesh;
+    mUseIncrementalReMesh = false;
+
     CreateHaloNodes();
 
     // Create mirrored nodes for the normal remesher to work with
@@ -206,9 +231,12 @@ void Cylindrical2dMesh::ReMesh(NodeMap& rMap)
      *
      * Call ReMesh() on the parent class. Note that the mesh now has lots
      * of extra nodes which will be deleted, hence the name 'big_map'.
+     * The mirrored nodes lie outside the existing triangulation, so the
+     * parent class cannot update it incrementally.
      */
     NodeMap big_map(GetNumAllNodes());
     MutableMesh<2,2>::ReMesh(big_map);
+    mUseIncrementalReMesh = use_incremental_remesh;
 
     /*
      * If the big_map isn't the identity map, the little map ('map') needs to be
@@ -321,6 +349,8 @@ void Cylindrical2dMesh::ReMesh(NodeMap& rMap)
     mImageToRightOriginalNodeMap.clear();
     mLeftPeriodicBoundaryElementIndices.clear();
     mRightPeriodicBoundaryElementIndices.clear();
+
+    RecordNodeLocationsAtReMesh();
 }
 
 void Cylindrical2dMesh::ReconstructCylindricalMesh()
@@ -503,8 +533,109 @@ void Cylindrical2dMesh::SetNode(unsigned index, ChastePoint<2> point, bool concr
         point.SetCoordinate(0, point.rGetLocation()[0] + mWidth);
     }
 
-    // Update the node's location
-    MutableMesh<2,2>::SetNode(index, point, concreteMove);
+    // The mirrored mesh used while remeshing is not periodic
+    if (!concreteMove || !mLeftImages.empty() || !mRightImages.empty())
+    {
+        MutableMesh<2,2>::SetNode(index, point, concreteMove);
+        return;
+    }
+
+    // Update the node's location and the boundary elements containing it
+    MutableMesh<2,2>::SetNode(index, point, false);
+    Node<2>* p_node = mNodes[index];
+    for (Node<2>::ContainingBoundaryElementIterator it = p_node->ContainingBoundaryElementsBegin();
+         it != p_node->ContainingBoundaryElementsEnd();
+         ++it)
+    {
+        try
+        {
+            GetBoundaryElement(*it)->CalculateWeightedDirection(mBoundaryElementWeightedDirections[*it],
+                                                                mBoundaryElementJacobianDeterminants[*it]);
+        }
+        catch (Exception&)
+        {
+            EXCEPTION("Moving node caused a boundary element to have a non-positive Jacobian determinant");
+        }
+    }
+
+    // Elements containing the node may straddle the periodic boundary
+    for (Node<2>::ContainingElementIterator it = p_node->ContainingElementsBegin();
+         it != p_node->ContainingElementsEnd();
+         ++it)
+    {
+        CalculatePeriodicJacobian(*it);
+        if (mElementJacobianDeterminants[*it] <= DBL_EPSILON)
+        {
+            EXCEPTION("Moving node caused an element to have a non-positive Jacobian determinant");
+        }
+    }
+}
+
+void Cylindrical2dMesh::CalculatePeriodicJacobian(unsigned elementIndex)
+{
+    Element<2,2>* p_element = GetElement(elementIndex);
+    c_matrix<double, 2, 2>& r_jacobian = mElementJacobians[elementIndex];
+
+    // Column j is the periodic vector from node 0 to node j+1 of the element
+    const c_vector<double, 2>& r_location_0 = p_element->GetNode(0)->rGetLocation();
+    for (unsigned j=0; j<2; j++)
+    {
+        c_vector<double, 2> vector = GetVectorFromAtoB(r_location_0, p_element->GetNode(j+1)->rGetLocation());
+        r_jacobian(0,j) = vector[0];
+        r_jacobian(1,j) = vector[1];
+    }
+
+    mElementJacobianDeterminants[elementIndex] = Determinant(r_jacobian);
+    if (mElementJacobianDeterminants[elementIndex] > DBL_EPSILON)
+    {
+        mElementInverseJacobians[elementIndex] = Inverse(r_jacobian);
+    }
+}
+
+void Cylindrical2dMesh::RefreshJacobianCachedData()
+{
+    // The mirrored mesh used while remeshing is not periodic
+    if (!mLeftImages.empty() || !mRightImages.empty())
+    {
+        MutableMesh<2,2>::RefreshJacobianCachedData();
+        return;
+    }
+
+    unsigned num_elements = GetNumAllElements();
+    unsigned num_boundary_elements = GetNumAllBoundaryElements();
+
+    // Make sure we have enough space
+    mElementJacobians.resize(num_elements);
+    mElementInverseJacobians.resize(num_elements);
+    mElementJacobianDeterminants.resize(num_elements);
+    mBoundaryElementWeightedDirections.resize(num_boundary_elements);
+    mBoundaryElementJacobianDeterminants.resize(num_boundary_elements);
+
+    for (AbstractTetrahedralMesh<2,2>::ElementIterator iter = GetElementIteratorBegin();
+         iter != GetElementIteratorEnd();
+         ++iter)
+    {
+        unsigned index = iter->GetIndex();
+        CalculatePeriodicJacobian(index);
+        if (mElementJacobianDeterminants[index] <= DBL_EPSILON)
+        {
+            EXCEPTION("Jacobian determinant is non-positive: determinant = " << mElementJacobianDeterminants[index]
+                      << " for element " << index << " of the cylindrical mesh");
+        }
+    }
+
+    for (BoundaryElementIterator itb = GetBoundaryElementIteratorBegin();
+         itb != GetBoundaryElementIteratorEnd();
+         itb++)
+    {
+        unsigned index = (*itb)->GetIndex();
+        (*itb)->CalculateWeightedDirection(mBoundaryElementWeightedDirections[index], mBoundaryElementJacobianDeterminants[index]);
+    }
+}
+
+bool Cylindrical2dMesh::CheckBoundaryForIncrementalReMesh()
+{
+    return true;
 }
 
 double Cylindrical2dMesh::GetWidth(const unsigned& rDimension) const
@@ -125,6 +125,25 @@ private:
      */
     void CreateMirrorNodes();
 
+    /**
+     * Overridden CheckBoundaryForIncrementalReMesh() method.
+     *
+     * The top and bottom boundaries of the cylinder need not be convex, and remeshing from
+     * scratch shapes them using halo nodes, so an incremental remesh keeps them as they are.
+     *
+     * @return true
+     */
+    bool CheckBoundaryForIncrementalReMesh();
+
+    /**
+     * Compute the Jacobian of an element and its determinant from the periodic vectors
+     * between its nodes, so that an element straddling the periodic boundary is treated
+     * correctly. The inverse Jacobian is only computed if the determinant is positive.
+     *
+     * @param elementIndex the index of the element
+     */
+    void CalculatePeriodicJacobian(unsigned elementIndex);
+
     /**
      *
      * After any corrections have been made to the boundary elements (see UseTheseElementsToDecideMeshing())
@@ -240,7 +259,12 @@ public:
     /**
      * Overridden ReMesh() method.
      *
-     * Conduct a cylindrical remesh by calling CreateMirrorNodes() to create
+     * If incremental remeshing is switched on (see SetUseIncrementalReMesh()), first try
+     * to restore the Delaunay property directly on the cylinder, by inserting new nodes
+     * and flipping edges using periodic geometric tests, without creating any image nodes.
+     * The node map is then the identity.
+     *
+     * Otherwise conduct a cylindrical remesh by calling CreateMirrorNodes() to create
      * mirror image nodes, then calling ReMesh() on the parent class, then
      * mapping the new node indices and calling ReconstructCylindricalMesh()
      * to remove surplus nodes, leaving a fully periodic mesh.
@@ -265,7 +289,8 @@ public:
      * Overridden SetNode() method.
      *
      * If the location should be set outside a cylindrical boundary, it is moved
-     * back onto the cylinder.
+     * back onto the cylinder. A concrete move recomputes the Jacobians of the node's
+     * elements from periodic vectors, as RefreshJacobianCachedData() does.
      *
      * @param index is the index of the node to be moved
      * @param point is the new target location of the node
@@ -273,6 +298,15 @@ public:
      */
     void SetNode(unsigned index, ChastePoint<2> point, bool concreteMove);
 
+    /**
+     * Overridden RefreshJacobianCachedData() method.
+     *
+     * Computes the Jacobian of each element from the periodic vectors between its nodes,
+     * so that elements straddling the periodic boundary are treated correctly. While
+     * ReMesh() is triangulating the mirrored mesh, the parent class method is used.
+     */
+    void RefreshJacobianCachedData();
+
     /**
      * Overridden GetWidth() method.
      *
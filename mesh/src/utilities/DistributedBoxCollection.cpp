@@ -33,6 +33,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 #include "DistributedBoxCollection.hpp"
+
+#include <algorithm>
+
 #include "Exception.hpp"
 #include "MathsCustomFunctions.hpp"
 #include "Warnings.hpp"
@@ -90,6 +93,12 @@ DistributedBoxCollection<DIM>::DistributedBoxCollection(double boxWidth, c_vecto
     // Make a distributed vector factory to split the rows of boxes between processes.
     mpDistributedBoxStackFactory = new DistributedVectorFactory(mNumBoxesEachDirection(DIM-1), localRows);
 
+    // Cache the lowest row owned by each process for GetProcessOwningNode(), as this call is collective
+    if (!PetscTools::IsSequential())
+    {
+        mpDistributedBoxStackFactory->rGetGlobalLows();
+    }
+
     // Calculate how many boxes in a row / face. A useful piece of data in the class.
     mNumBoxes = 1u;
     for (unsigned dim=0; dim<DIM; dim++)
@@ -495,6 +504,85 @@ int DistributedBoxCollection<DIM>::LoadBalance(std::vector<int> localDistributio
     return new_rows;
 }
 
+template<unsigned DIM>
+int DistributedBoxCollection<DIM>::RebalanceSlabs(std::vector<double> localLoads)
+{
+    int num_local_rows = localLoads.size();
+    if (PetscTools::IsSequential())
+    {
+        return num_local_rows;
+    }
+    unsigned num_procs = PetscTools::GetNumProcs();
+
+    // Gather the load on every row of boxes onto every process
+    std::vector<int> rows_on_each_process(num_procs);
+    MPI_Allgather(&num_local_rows, 1, MPI_INT, &rows_on_each_process[0], 1, MPI_INT, PETSC_COMM_WORLD);
+
+    std::vector<int> row_offsets(num_procs, 0);
+    for (unsigned proc=1; proc<num_procs; proc++)
+    {
+        row_offsets[proc] = row_offsets[proc-1] + rows_on_each_process[proc-1];
+    }
+    unsigned num_rows = row_offsets[num_procs-1] + rows_on_each_process[num_procs-1];
+    assert(num_rows >= num_procs);
+
+    std::vector<double> row_loads(num_rows);
+    localLoads.resize(std::max(num_local_rows, 1)); // Make sure &localLoads[0] is valid
+    MPI_Allgatherv(&localLoads[0], num_local_rows, MPI_DOUBLE,
+                   &row_loads[0], &rows_on_each_process[0], &row_offsets[0], MPI_DOUBLE, PETSC_COMM_WORLD);
+
+    double total_load = 0.0;
+    double max_row_load = 0.0;
+    for (unsigned row=0; row<num_rows; row++)
+    {
+        total_load += row_loads[row];
+        max_row_load = std::max(max_row_load, row_loads[row]);
+    }
+
+    // With no load there is nothing to balance
+    if (!(total_load > 0.0))
+    {
+        return num_local_rows;
+    }
+
+    // Each row is owned by a single process, so its load cannot be shared
+    if (max_row_load > total_load/num_procs)
+    {
+        WARN_ONCE_ONLY("A single row of boxes carries more than an equal share of the load, so the load cannot be balanced by dividing the domain into slabs.");
+    }
+
+    /*
+     * Every process computes the same partition from the same data. Each process boundary is placed
+     * at the row boundary nearest to an equal share of the total load, leaving at least one row for
+     * each process.
+     */
+    unsigned my_rank = PetscTools::GetMyRank();
+    unsigned first_row = 0;
+    double cumulative_load = 0.0;
+    for (unsigned proc=0; proc<num_procs-1; proc++)
+    {
+        double target_load = total_load*(proc+1)/num_procs;
+        unsigned last_allowed_end = num_rows - (num_procs-1-proc);
+
+        unsigned end_row = first_row + 1;
+        cumulative_load += row_loads[first_row];
+        while (end_row < last_allowed_end && !(cumulative_load + 0.5*row_loads[end_row] > target_load))
+        {
+            cumulative_load += row_loads[end_row];
+            end_row++;
+        }
+
+        if (proc == my_rank)
+        {
+            return end_row - first_row;
+        }
+        first_row = end_row;
+    }
+
+    // The top-most process takes the remaining rows
+    return num_rows - first_row;
+}
+
 template<unsigned DIM>
 void DistributedBoxCollection<DIM>::SetupLocalBoxesHalfOnly()
 {
@@ -1104,18 +1192,17 @@ template<unsigned DIM>
 unsigned DistributedBoxCollection<DIM>::GetProcessOwningNode(Node<DIM>* pNode)
 {
     unsigned box_index = CalculateContainingBox(pNode);
-    unsigned containing_process = PetscTools::GetMyRank();
 
-    if (box_index > mMaxBoxIndex)
-    {
-        containing_process++;
-    }
-    else if (box_index < mMinBoxIndex)
+    if (IsBoxOwned(box_index))
     {
-        containing_process--;
+        return PetscTools::GetMyRank();
     }
 
-    return containing_process;
+    // The owning process is the last process whose lowest row is not above the row containing the box
+    unsigned row = box_index / mNumBoxesInAFace;
+    std::vector<unsigned>& r_global_lows = mpDistributedBoxStackFactory->rGetGlobalLows();
+
+    return (std::upper_bound(r_global_lows.begin(), r_global_lows.end(), row) - r_global_lows.begin()) - 1;
 }
 
 template<unsigned DIM>
@@ -49,6 +49,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /**
  * A collection of 'boxes' partitioning the domain with information on which nodes are located in which box.
+ *
+ * In parallel the domain is split into slabs: each process owns a contiguous range of rows (in 2d) or
+ * faces (in 3d) of boxes along the last dimension, and exchanges halo boxes with the processes above and
+ * below it only.
  */
 template<unsigned DIM>
 class DistributedBoxCollection
@@ -284,6 +288,27 @@ public:
      */
     int LoadBalance(std::vector<int> localDistribution);
 
+    /**
+     * A helper function to work out the number of rows to be owned by this process so that the load is
+     * shared as equally between the slabs as whole rows allow, in a single step.
+     *
+     * Unlike LoadBalance(), which moves each process boundary by at most one row per call, this method
+     * gathers the load on every row of boxes and places all the process boundaries at once. Each process
+     * keeps at least one row. Nodes may then be owned by a process that is not a neighbour of the process
+     * on which they currently lie.
+     *
+     * The result is still a partition into slabs, so the load can only be balanced along the last dimension,
+     * and no process can be given less than one row. A warning is given if a single row carries more than
+     * an equal share of the load. Splitting rows between processes (for example by recursive coordinate
+     * bisection) would need halo boxes to be exchanged with neighbours in every direction, which this class
+     * does not support.
+     *
+     * @param localLoads a vector containing the load (for example, the number of nodes weighted by their
+     *     measured cost) in each row/face of boxes owned by this process in 2d/3d
+     * @return the updated number of rows.
+     */
+    int RebalanceSlabs(std::vector<double> localLoads);
+
     /**
      *  Set up the local boxes (ie itself and its nearest-neighbours) for each of the boxes.
      *  This method just sets up half of the local boxes (for example, in 1D, local boxes for box0 = {1}
@@ -318,7 +343,6 @@ public:
 
     /**
      * Get the process that should own this node.
-     * Currently only returns +/-1 of this process so assumes nodes don't move too far. //\ todo this should be fixed.
      *
      * @param pNode the node to be tested
      * @return the ID of the process that should own the node.
@@ -171,6 +171,29 @@ c_vector<double, 2> Cylindrical2dVertexMesh::GetVectorFromAtoB(const c_vector<do
     return vector;
 }
 
+bool Cylindrical2dVertexMesh::UpdateVerticesFromDelaunayMesh(std::vector<bool>& rElementsChanged)
+{
+    if (!MutableVertexMesh<2,2>::UpdateVerticesFromDelaunayMesh(rElementsChanged))
+    {
+        return false;
+    }
+
+    // Loop over all vertices and check they're not outside [0,mWidth]
+    for (unsigned i=0; i<mNodes.size(); i++)
+    {
+        double x_location = mNodes[i]->rGetLocation()[0];
+        if (x_location < 0)
+        {
+            mNodes[i]->rGetModifiableLocation()[0] = x_location + mWidth;
+        }
+        else if (x_location > mWidth)
+        {
+            mNodes[i]->rGetModifiableLocation()[0] = x_location - mWidth;
+        }
+    }
+    return true;
+}
+
 void Cylindrical2dVertexMesh::SetNode(unsigned nodeIndex, ChastePoint<2> point)
 {
     double x_coord = point.rGetLocation()[0];
@@ -125,6 +125,17 @@ public:
      */
     c_vector<double, 2> GetVectorFromAtoB(const c_vector<double, 2>& rLocation1, const c_vector<double, 2>& rLocation2);
 
+    /**
+     * Overridden UpdateVerticesFromDelaunayMesh() method.
+     *
+     * Moves any vertex whose new circumcentre lies outside [0, mWidth] back onto the cylinder,
+     * as in the constructor.
+     *
+     * @param rElementsChanged  the entry for each element with a moved vertex is set to true
+     * @return whether the vertices were updated
+     */
+    bool UpdateVerticesFromDelaunayMesh(std::vector<bool>& rElementsChanged);
+
     /**
      * Overridden SetNode() method.
      *
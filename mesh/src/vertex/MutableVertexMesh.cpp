@@ -37,6 +37,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UblasCustomFunctions.hpp"
 #include "Warnings.hpp"
 #include "LogFile.hpp"
+#include "CellBasedProfiler.hpp"
+#include <iterator>
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::MutableVertexMesh(std::vector<Node<SPACE_DIM>*> nodes,
@@ -310,6 +312,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ClearLocationsOfT3Swaps()
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::AddNode(Node<SPACE_DIM>* pNewNode)
 {
+    this->InvalidateElementGeometryCache();
+
     if (mDeletedNodeIndices.empty())
     {
         pNewNode->SetIndex(this->mNodes.size());
@@ -329,6 +333,8 @@ unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::AddNode(Node<SPACE_DIM>* pNe
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::AddElement(VertexElement<ELEMENT_DIM,SPACE_DIM>* pNewElement)
 {
+    this->InvalidateElementGeometryCache();
+
     unsigned new_element_index = pNewElement->GetIndex();
 
     if (new_element_index == this->mElements.size())
@@ -346,6 +352,7 @@ unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::AddElement(VertexElement<ELE
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::SetNode(unsigned nodeIndex, ChastePoint<SPACE_DIM> point)
 {
+    this->InvalidateElementGeometryCache();
     this->mNodes[nodeIndex]->SetPoint(point);
 }
 
@@ -557,6 +564,8 @@ unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DivideElement(VertexElement<
     assert(SPACE_DIM == 2);
     assert(ELEMENT_DIM == SPACE_DIM);
 
+    this->InvalidateElementGeometryCache();
+
     // Sort nodeA and nodeB such that nodeBIndex > nodeAindex
     assert(nodeBIndex != nodeAIndex);
     unsigned node1_index = (nodeAIndex < nodeBIndex) ? nodeAIndex : nodeBIndex; // low index
@@ -679,6 +688,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DeleteElementPriorToReMesh(unsig
 {
     assert(SPACE_DIM == 2);
 
+    this->InvalidateElementGeometryCache();
+
     // Mark any nodes that are contained only in this element as deleted
     for (unsigned i=0; i<this->mElements[index]->GetNumNodes(); i++)
     {
@@ -701,6 +712,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DeleteElementPriorToReMesh(unsig
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DeleteNodePriorToReMesh(unsigned index)
 {
+    this->InvalidateElementGeometryCache();
     this->mNodes[index]->MarkAsDeleted();
     mDeletedNodeIndices.push_back(index);
 }
@@ -858,6 +870,9 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(VertexElementMap& rElemen
     assert(SPACE_DIM==2 || SPACE_DIM==3);
     assert(ELEMENT_DIM == SPACE_DIM);
 
+    // Remeshing may change the elements and their nodes
+    this->InvalidateElementGeometryCache();
+
     if (SPACE_DIM == 2)
     {
         // Make sure the map is big enough
@@ -874,6 +889,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(VertexElementMap& rElemen
         {
             // We check for any short edges and perform swaps if necessary and possible.
             recheck_mesh = CheckForSwapsFromShortEdges();
+            CellBasedProfiler::Instance()->IncrementCounter("vertex remesh passes");
         }
 
         // Check for element intersections
@@ -882,6 +898,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(VertexElementMap& rElemen
         {
             // Check mesh for intersections, and perform T3 swaps where required
             recheck_mesh = CheckForIntersections();
+            CellBasedProfiler::Instance()->IncrementCounter("vertex remesh passes");
         }
 
         RemoveDeletedNodes();
@@ -997,21 +1014,36 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForT2Swaps(VertexElementMap
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
 {
+    /*
+     * Only elements whose bounding box contains a node can include it, so we find these
+     * candidates using a uniform grid of boxes rather than looping over every element.
+     * The candidates for each node are visited in the same order as the elements being
+     * checked, so the first intersection found is the same as for an exhaustive search.
+     */
+    std::vector<unsigned> element_indices;
+    std::vector<unsigned> candidates;
+
     // If checking for internal intersections as well as on the boundary, then check that no nodes have overlapped any elements...
     if (mCheckForInternalIntersections)
     {
-        ///\todo Change to only loop over neighbouring elements (see #2401)
+        for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
+             elem_iter != this->GetElementIteratorEnd();
+             ++elem_iter)
+        {
+            element_indices.push_back(elem_iter->GetIndex());
+        }
+        SetUpIntersectionBoxes(element_indices);
+
         for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
              node_iter != this->GetNodeIteratorEnd();
              ++node_iter)
         {
             assert(!(node_iter->IsDeleted()));
 
-            for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
-                 elem_iter != this->GetElementIteratorEnd();
-                 ++elem_iter)
+            GetCandidateIntersectionElements(node_iter->rGetLocation(), candidates);
+            for (unsigned i=0; i<candidates.size(); i++)
             {
-                unsigned elem_index = elem_iter->GetIndex();
+                unsigned elem_index = element_indices[candidates[i]];
 
                 // Check that the node is not part of this element
                 if (node_iter->rGetContainingElementIndices().count(elem_index) == 0)
@@ -1038,6 +1070,8 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
                 boundary_element_indices.insert(elem_iter->GetIndex());
             }
         }
+        element_indices.assign(boundary_element_indices.begin(), boundary_element_indices.end());
+        SetUpIntersectionBoxes(element_indices);
 
         for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
              node_iter != this->GetNodeIteratorEnd();
@@ -1047,16 +1081,17 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
             {
                 assert(!(node_iter->IsDeleted()));
 
-                for (std::set<unsigned>::iterator elem_iter = boundary_element_indices.begin();
-                     elem_iter != boundary_element_indices.end();
-                     ++elem_iter)
+                GetCandidateIntersectionElements(node_iter->rGetLocation(), candidates);
+                for (unsigned i=0; i<candidates.size(); i++)
                 {
+                    unsigned elem_index = element_indices[candidates[i]];
+
                     // Check that the node is not part of this element
-                    if (node_iter->rGetContainingElementIndices().count(*elem_iter) == 0)
+                    if (node_iter->rGetContainingElementIndices().count(elem_index) == 0)
                     {
-                        if (this->ElementIncludesPoint(node_iter->rGetLocation(), *elem_iter))
+                        if (this->ElementIncludesPoint(node_iter->rGetLocation(), elem_index))
                         {
-                            PerformT3Swap(&(*node_iter), *elem_iter);
+                            PerformT3Swap(&(*node_iter), elem_index);
                             return true;
                         }
                     }
@@ -1068,6 +1103,195 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
     return false;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::SetUpIntersectionBoxes(const std::vector<unsigned>& rElementIndices)
+{
+    unsigned num_elements = rElementIndices.size();
+
+    for (unsigned i=0; i<mIntersectionBoxes.size(); i++)
+    {
+        mIntersectionBoxes[i].clear();
+    }
+    mUnboxedIntersectionElements.clear();
+
+    // Find the extent of the nodes, which contains the bounding box of any element that does not straddle a periodic boundary
+    c_vector<double, SPACE_DIM> min_corner = scalar_vector<double>(SPACE_DIM, DBL_MAX);
+    c_vector<double, SPACE_DIM> max_corner = scalar_vector<double>(SPACE_DIM, -DBL_MAX);
+    for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
+         node_iter != this->GetNodeIteratorEnd();
+         ++node_iter)
+    {
+        const c_vector<double, SPACE_DIM>& r_location = node_iter->rGetLocation();
+        for (unsigned dim=0; dim<SPACE_DIM; dim++)
+        {
+            min_corner[dim] = std::min(min_corner[dim], r_location[dim]);
+            max_corner[dim] = std::max(max_corner[dim], r_location[dim]);
+        }
+    }
+
+    // Pad bounding boxes so that round-off cannot exclude a point that ElementIncludesPoint() would accept
+    double scale = 1.0;
+    for (unsigned dim=0; dim<SPACE_DIM; dim++)
+    {
+        scale = std::max(scale, std::max(fabs(min_corner[dim]), fabs(max_corner[dim])));
+    }
+    double tolerance = 1e-10*scale;
+
+    // Find the bounding box of each element, relative to its first node as in ElementIncludesPoint()
+    std::vector<c_vector<double, SPACE_DIM> > element_min_corners(num_elements);
+    std::vector<c_vector<double, SPACE_DIM> > element_max_corners(num_elements);
+    std::vector<unsigned> boxed_elements;
+    double total_width = 0.0;
+
+    for (unsigned i=0; i<num_elements; i++)
+    {
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = this->GetElement(rElementIndices[i]);
+        c_vector<double, SPACE_DIM> first_vertex = p_element->GetNodeLocation(0);
+        c_vector<double, SPACE_DIM> lower = zero_vector<double>(SPACE_DIM);
+        c_vector<double, SPACE_DIM> upper = zero_vector<double>(SPACE_DIM);
+
+        for (unsigned local_index=1; local_index<p_element->GetNumNodes(); local_index++)
+        {
+            c_vector<double, SPACE_DIM> vertex = this->GetVectorFromAtoB(first_vertex, p_element->GetNodeLocation(local_index));
+            for (unsigned dim=0; dim<SPACE_DIM; dim++)
+            {
+                lower[dim] = std::min(lower[dim], vertex[dim]);
+                upper[dim] = std::max(upper[dim], vertex[dim]);
+            }
+        }
+
+        bool is_within_nodes = true;
+        double width = 0.0;
+        for (unsigned dim=0; dim<SPACE_DIM; dim++)
+        {
+            element_min_corners[i][dim] = first_vertex[dim] + lower[dim] - tolerance;
+            element_max_corners[i][dim] = first_vertex[dim] + upper[dim] + tolerance;
+            width = std::max(width, upper[dim] - lower[dim]);
+
+            if (element_min_corners[i][dim] < min_corner[dim] - 2.0*tolerance ||
+                element_max_corners[i][dim] > max_corner[dim] + 2.0*tolerance)
+            {
+                is_within_nodes = false;
+            }
+        }
+
+        if (is_within_nodes)
+        {
+            boxed_elements.push_back(i);
+            total_width += width;
+        }
+        else
+        {
+            mUnboxedIntersectionElements.push_back(i);
+        }
+    }
+
+    if (boxed_elements.empty())
+    {
+        mIntersectionBoxes.clear();
+        return;
+    }
+
+    // Use boxes of about the size of an element, but no more boxes than a few per element
+    mIntersectionBoxWidth = total_width/boxed_elements.size();
+    if (mIntersectionBoxWidth <= tolerance)
+    {
+        mIntersectionBoxWidth = scale;
+    }
+    mIntersectionBoxOrigin = min_corner;
+
+    unsigned num_boxes;
+    do
+    {
+        num_boxes = 1;
+        for (unsigned dim=0; dim<SPACE_DIM; dim++)
+        {
+            mNumIntersectionBoxes[dim] = 1 + (unsigned)floor((max_corner[dim] - min_corner[dim])/mIntersectionBoxWidth);
+            num_boxes *= mNumIntersectionBoxes[dim];
+        }
+        if (num_boxes > 4*boxed_elements.size() + 16)
+        {
+            mIntersectionBoxWidth *= 2.0;
+        }
+    }
+    while (num_boxes > 4*boxed_elements.size() + 16);
+
+    mIntersectionBoxes.resize(num_boxes);
+
+    // Add each element to every box its bounding box overlaps, in ascending order
+    for (unsigned i=0; i<boxed_elements.size(); i++)
+    {
+        unsigned position = boxed_elements[i];
+        c_vector<unsigned, SPACE_DIM> lower_box;
+        c_vector<unsigned, SPACE_DIM> upper_box;
+        for (unsigned dim=0; dim<SPACE_DIM; dim++)
+        {
+            double lower_coordinate = floor((element_min_corners[position][dim] - mIntersectionBoxOrigin[dim])/mIntersectionBoxWidth);
+            double upper_coordinate = floor((element_max_corners[position][dim] - mIntersectionBoxOrigin[dim])/mIntersectionBoxWidth);
+            lower_box[dim] = (lower_coordinate < 0.0) ? 0 : std::min((unsigned)lower_coordinate, mNumIntersectionBoxes[dim] - 1);
+            upper_box[dim] = (upper_coordinate < 0.0) ? 0 : std::min((unsigned)upper_coordinate, mNumIntersectionBoxes[dim] - 1);
+        }
+
+        c_vector<unsigned, SPACE_DIM> box = lower_box;
+        bool is_finished = false;
+        while (!is_finished)
+        {
+            unsigned box_index = 0;
+            unsigned stride = 1;
+            for (unsigned dim=0; dim<SPACE_DIM; dim++)
+            {
+                box_index += box[dim]*stride;
+                stride *= mNumIntersectionBoxes[dim];
+            }
+            mIntersectionBoxes[box_index].push_back(position);
+
+            // Move on to the next box overlapped by this element
+            unsigned dim = 0;
+            while (dim < SPACE_DIM && box[dim] == upper_box[dim])
+            {
+                box[dim] = lower_box[dim];
+                dim++;
+            }
+            if (dim == SPACE_DIM)
+            {
+                is_finished = true;
+            }
+            else
+            {
+                box[dim]++;
+            }
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::GetCandidateIntersectionElements(const c_vector<double, SPACE_DIM>& rPoint,
+                                                                                 std::vector<unsigned>& rCandidates)
+{
+    rCandidates.clear();
+
+    if (mIntersectionBoxes.empty())
+    {
+        rCandidates = mUnboxedIntersectionElements;
+        return;
+    }
+
+    unsigned box_index = 0;
+    unsigned stride = 1;
+    for (unsigned dim=0; dim<SPACE_DIM; dim++)
+    {
+        double coordinate = floor((rPoint[dim] - mIntersectionBoxOrigin[dim])/mIntersectionBoxWidth);
+        unsigned box = (coordinate < 0.0) ? 0 : std::min((unsigned)coordinate, mNumIntersectionBoxes[dim] - 1);
+        box_index += box*stride;
+        stride *= mNumIntersectionBoxes[dim];
+    }
+
+    const std::vector<unsigned>& r_box = mIntersectionBoxes[box_index];
+    std::merge(r_box.begin(), r_box.end(),
+               mUnboxedIntersectionElements.begin(), mUnboxedIntersectionElements.end(),
+               std::back_inserter(rCandidates));
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB)
 {
@@ -1448,6 +1672,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT1Swap(Node<SPACE_DIM>* p
     c_vector<double, SPACE_DIM> nodeB_location = pNodeB->rGetLocation();
     c_vector<double, SPACE_DIM> vector_AB = this->GetVectorFromAtoB(nodeA_location, nodeB_location);
     mLocationsOfT1Swaps.push_back(nodeA_location + 0.5*vector_AB);
+    CellBasedProfiler::Instance()->IncrementCounter("T1 swaps");
 
     double distance_AB = norm_2(vector_AB);
     if (distance_AB < 1e-10) ///\todo remove magic number? (see #1884 and #2401)
@@ -1748,6 +1973,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT2Swap(VertexElement<ELEM
 {
     // The given element must be triangular for us to be able to perform a T2 swap on it
     assert(rElement.GetNumNodes() == 3);
+    CellBasedProfiler::Instance()->IncrementCounter("T2 swaps");
 
     // Note that we define this vector before setting it, as otherwise the profiling build will break (see #2367)
     c_vector<double, SPACE_DIM> new_node_location;
@@ -1857,6 +2083,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::PerformT3Swap(Node<SPACE_DIM>* p
     // is called (see #2401) - we should correct this in these cases!
 
     mLocationsOfT3Swaps.push_back(intersection);
+    CellBasedProfiler::Instance()->IncrementCounter("T3 swaps");
 
     if (pNode->GetNumContainingElements() == 1)
     {
@@ -117,6 +117,29 @@ protected:
      */
     std::vector< c_vector<double, SPACE_DIM> > mLocationsOfT3Swaps;
 
+    /** Width of the boxes of the uniform grid used by CheckForIntersections() to find candidate elements. */
+    double mIntersectionBoxWidth;
+
+    /** Lower corner of the uniform grid used by CheckForIntersections(). */
+    c_vector<double, SPACE_DIM> mIntersectionBoxOrigin;
+
+    /** Number of boxes in each direction of the uniform grid used by CheckForIntersections(). */
+    c_vector<unsigned, SPACE_DIM> mNumIntersectionBoxes;
+
+    /**
+     * For each box of the uniform grid used by CheckForIntersections(), the positions (in
+     * ascending order) in the list of elements being checked of those whose bounding box
+     * overlaps the box. Not archived; the storage is reused between calls.
+     */
+    std::vector<std::vector<unsigned> > mIntersectionBoxes;
+
+    /**
+     * Positions in the list of elements being checked by CheckForIntersections() of those
+     * whose bounding box does not lie within the grid, for example because they straddle a
+     * periodic boundary. These are candidates for every point.
+     */
+    std::vector<unsigned> mUnboxedIntersectionElements;
+
     /**
      * Divide an element along the axis passing through two of its nodes.
      *
@@ -157,6 +180,30 @@ protected:
      */
     bool CheckForIntersections();
 
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * Bin the given elements into a uniform grid of boxes according to their bounding boxes,
+     * so that the elements that could include a given point can be found without looping
+     * over every element in the mesh. Bounding boxes are computed relative to the first node
+     * of each element using GetVectorFromAtoB(), as in ElementIncludesPoint().
+     *
+     * @param rElementIndices the global indices of the elements to be checked
+     */
+    void SetUpIntersectionBoxes(const std::vector<unsigned>& rElementIndices);
+
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * Find every element that could include a given point, that is every element whose
+     * bounding box contains the point. Must be called after SetUpIntersectionBoxes().
+     *
+     * @param rPoint the point
+     * @param rCandidates filled with the positions in the vector passed to SetUpIntersectionBoxes()
+     *     of the candidate elements, in ascending order
+     */
+    void GetCandidateIntersectionElements(const c_vector<double, SPACE_DIM>& rPoint, std::vector<unsigned>& rCandidates);
+
     /**
      * Helper method for ReMesh(), called by CheckForSwapsFromShortEdges() when
      * neighbouring nodes in an element have been found to be closer than the mCellRearrangementThreshold
@@ -39,7 +39,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexMesh(std::vector<Node<SPACE_DIM>*> nodes,
                                                std::vector<VertexElement<ELEMENT_DIM,SPACE_DIM>*> vertexElements)
-    : mpDelaunayMesh(NULL)
+    : mpDelaunayMesh(NULL),
+      mElementGeometryCacheIsValid(false)
 {
 
     // Reset member variables and clear mNodes and mElements
@@ -103,7 +104,8 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexMesh(std::vector<Node<SPACE_DIM>*> nodes,
                            std::vector<VertexElement<ELEMENT_DIM-1, SPACE_DIM>*> faces,
                            std::vector<VertexElement<ELEMENT_DIM, SPACE_DIM>*> vertexElements)
-    : mpDelaunayMesh(NULL)
+    : mpDelaunayMesh(NULL),
+      mElementGeometryCacheIsValid(false)
 {
     // Reset member variables and clear mNodes, mFaces and mElements
     Clear();
@@ -149,7 +151,8 @@ VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexMesh(std::vector<Node<SPACE_DIM>*> nod
  */
 template<>
 VertexMesh<2,2>::VertexMesh(TetrahedralMesh<2,2>& rMesh, bool isPeriodic)
-    : mpDelaunayMesh(&rMesh)
+    : mpDelaunayMesh(&rMesh),
+      mElementGeometryCacheIsValid(false)
 {
     //Note  !isPeriodic is not used except through polymorphic calls in rMesh
 
@@ -238,7 +241,8 @@ VertexMesh<2,2>::VertexMesh(TetrahedralMesh<2,2>& rMesh, bool isPeriodic)
  */
 template<>
 VertexMesh<3,3>::VertexMesh(TetrahedralMesh<3,3>& rMesh)
-    : mpDelaunayMesh(&rMesh)
+    : mpDelaunayMesh(&rMesh),
+      mElementGeometryCacheIsValid(false)
 {
     // Reset member variables and clear mNodes, mFaces and mElements
     Clear();
@@ -384,9 +388,17 @@ void VertexMesh<ELEMENT_DIM, SPACE_DIM>::GenerateVerticesFromElementCircumcentre
     c_matrix<double, ELEMENT_DIM, SPACE_DIM> inverse_jacobian;
     double jacobian_det;
 
+    mDelaunayElementNodeIndices.clear();
+    mDelaunayElementNodeIndices.reserve(rMesh.GetNumElements()*(ELEMENT_DIM+1));
+
     // Loop over elements of the Delaunay mesh and populate mNodes
     for (unsigned i=0; i<rMesh.GetNumElements(); i++)
     {
+        for (unsigned local_index=0; local_index<ELEMENT_DIM+1; local_index++)
+        {
+            mDelaunayElementNodeIndices.push_back(rMesh.GetElement(i)->GetNodeGlobalIndex(local_index));
+        }
+
         // Calculate the circumcentre of this element in the Delaunay mesh
         rMesh.GetInverseJacobianForElement(i, jacobian, jacobian_det, inverse_jacobian);
         c_vector<double, SPACE_DIM+1> circumsphere = rMesh.GetElement(i)->CalculateCircumsphere(jacobian, inverse_jacobian);
@@ -402,6 +414,137 @@ void VertexMesh<ELEMENT_DIM, SPACE_DIM>::GenerateVerticesFromElementCircumcentre
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool VertexMesh<ELEMENT_DIM, SPACE_DIM>::UpdateVerticesFromDelaunayMesh(std::vector<bool>& rElementsChanged)
+{
+    // Only 2D tessellations can be updated in place; 3D tessellations are regenerated
+    return false;
+}
+
+/**
+ * This method is only implemented for 2D Voronoi tessellations.
+ *
+ * @param rElementsChanged  the entry for each element with a moved vertex is set to true
+ * @return whether the vertices were updated
+ */
+template<>
+bool VertexMesh<2,2>::UpdateVerticesFromDelaunayMesh(std::vector<bool>& rElementsChanged)
+{
+    if (mpDelaunayMesh == NULL)
+    {
+        return false;
+    }
+
+    // Vertex i corresponds to Delaunay element i only while the Delaunay mesh keeps its connectivity
+    unsigned num_delaunay_elements = mpDelaunayMesh->GetNumAllElements();
+    if ((num_delaunay_elements != this->mNodes.size())
+        || (mpDelaunayMesh->GetNumAllNodes() != mElements.size())
+        || (mDelaunayElementNodeIndices.size() != num_delaunay_elements*(3)))
+    {
+        return false;
+    }
+    for (unsigned i=0; i<num_delaunay_elements; i++)
+    {
+        Element<2,2>* p_delaunay_element = mpDelaunayMesh->GetElement(i);
+        if (p_delaunay_element->IsDeleted())
+        {
+            return false;
+        }
+        for (unsigned local_index=0; local_index<3; local_index++)
+        {
+            if (p_delaunay_element->GetNodeGlobalIndex(local_index) != mDelaunayElementNodeIndices[i*(3) + local_index])
+            {
+                return false;
+            }
+        }
+    }
+
+    if (rElementsChanged.size() != mElements.size())
+    {
+        rElementsChanged.resize(mElements.size(), true);
+    }
+
+    // Move each vertex to the new circumcentre, noting which elements it belongs to
+    std::vector<bool> element_has_moved_vertex(mElements.size(), false);
+    c_matrix<double, 2, 2> jacobian;
+    c_matrix<double, 2, 2> inverse_jacobian;
+    double jacobian_det;
+    for (unsigned i=0; i<num_delaunay_elements; i++)
+    {
+        mpDelaunayMesh->GetInverseJacobianForElement(i, jacobian, jacobian_det, inverse_jacobian);
+        c_vector<double, 3> circumsphere = mpDelaunayMesh->GetElement(i)->CalculateCircumsphere(jacobian, inverse_jacobian);
+
+        c_vector<double, 2>& r_location = this->mNodes[i]->rGetModifiableLocation();
+        bool has_moved = false;
+        for (unsigned j=0; j<2; j++)
+        {
+            if (r_location(j) != circumsphere(j))
+            {
+                has_moved = true;
+                r_location(j) = circumsphere(j);
+            }
+        }
+
+        if (has_moved)
+        {
+            for (unsigned local_index=0; local_index<3; local_index++)
+            {
+                unsigned elem_index = mDelaunayElementNodeIndices[i*(3) + local_index];
+                element_has_moved_vertex[elem_index] = true;
+            }
+        }
+    }
+
+    // Restore the anticlockwise ordering of any changed element whose vertices have swapped order
+    for (unsigned elem_index=0; elem_index<mElements.size(); elem_index++)
+    {
+        if (!element_has_moved_vertex[elem_index])
+        {
+            continue;
+        }
+        rElementsChanged[elem_index] = true;
+
+        VertexElement<2,2>* p_element = mElements[elem_index];
+        unsigned num_nodes_in_element = p_element->GetNumNodes();
+        std::vector<std::pair<double, unsigned> > index_angle_list(num_nodes_in_element);
+        for (unsigned local_index=0; local_index<num_nodes_in_element; local_index++)
+        {
+            c_vector<double, 2> centre_to_vertex = mpDelaunayMesh->GetVectorFromAtoB(mpDelaunayMesh->GetNode(elem_index)->rGetLocation(),
+                                                                                            p_element->GetNodeLocation(local_index));
+            index_angle_list[local_index].first = atan2(centre_to_vertex(1), centre_to_vertex(0));
+            index_angle_list[local_index].second = p_element->GetNodeGlobalIndex(local_index);
+        }
+
+        // The angles of an anticlockwise element increase cyclically, so decrease at most once
+        unsigned num_decreases = 0;
+        for (unsigned local_index=0; local_index<num_nodes_in_element; local_index++)
+        {
+            unsigned next_local_index = (local_index+1)%num_nodes_in_element;
+            if (index_angle_list[next_local_index].first < index_angle_list[local_index].first)
+            {
+                num_decreases++;
+            }
+        }
+
+        if (num_decreases > 1)
+        {
+            sort(index_angle_list.begin(), index_angle_list.end());
+
+            VertexElement<2,2>* p_new_element = new VertexElement<2,2>(elem_index);
+            for (unsigned count=0; count<index_angle_list.size(); count++)
+            {
+                unsigned local_index = count>1 ? count-1 : 0;
+                p_new_element->AddNode(this->mNodes[index_angle_list[count].second], local_index);
+            }
+            delete p_element;
+            mElements[elem_index] = p_new_element;
+        }
+    }
+
+    InvalidateElementGeometryCache();
+    return true;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetEdgeLength(unsigned elementIndex1, unsigned elementIndex2)
 {
@@ -458,6 +601,7 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexMesh()
 {
     mpDelaunayMesh = NULL;
+    mElementGeometryCacheIsValid = false;
     this->mMeshChangesDuringSimulation = false;
     Clear();
 }
@@ -589,6 +733,8 @@ void VertexMesh<ELEMENT_DIM, SPACE_DIM>::Clear()
         delete this->mNodes[i];
     }
     this->mNodes.clear();
+
+    InvalidateElementGeometryCache();
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -1479,6 +1625,160 @@ c_vector<double, SPACE_DIM> VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetPerimeterGrad
     return previous_edge_gradient + next_edge_gradient;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMesh<ELEMENT_DIM, SPACE_DIM>::UpdateElementGeometryCache()
+{
+    assert(SPACE_DIM == 2 || SPACE_DIM == 3);
+
+    unsigned num_elements = mElements.size();
+
+    mCachedElementVolumes.assign(num_elements, 0.0);
+    mCachedElementSurfaceAreas.assign(num_elements, 0.0);
+    mCachedElementCentroids.assign(num_elements, zero_vector<double>(SPACE_DIM));
+    mCachedVertexOffsets.assign(num_elements+1, 0);
+
+    // Per-vertex quantities are only defined for 2D elements
+    bool cache_vertex_quantities = (ELEMENT_DIM == 2 && SPACE_DIM == 2);
+
+    if (cache_vertex_quantities)
+    {
+        for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+        {
+            unsigned num_nodes_in_element = mElements[elem_index]->IsDeleted() ? 0 : mElements[elem_index]->GetNumNodes();
+            mCachedVertexOffsets[elem_index+1] = mCachedVertexOffsets[elem_index] + num_nodes_in_element;
+        }
+    }
+
+    unsigned num_vertices = mCachedVertexOffsets[num_elements];
+    mCachedEdgeVectors.resize(num_vertices);
+    mCachedNextEdgeGradients.resize(num_vertices);
+    mCachedAreaGradients.resize(num_vertices);
+
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = mElements[elem_index];
+        if (p_element->IsDeleted())
+        {
+            continue;
+        }
+
+        // Use the (possibly overridden) methods themselves so that the cached values are identical
+        mCachedElementVolumes[elem_index] = this->GetVolumeOfElement(elem_index);
+        mCachedElementSurfaceAreas[elem_index] = this->GetSurfaceAreaOfElement(elem_index);
+        mCachedElementCentroids[elem_index] = this->GetCentroidOfElement(elem_index);
+
+        if (cache_vertex_quantities)
+        {
+            /*
+             * Each edge vector and gradient is computed once per element, rather than once for
+             * each call to GetNextEdgeGradientOfElementAtNode() or GetAreaGradientOfElementAtNode(),
+             * using the same calls to GetVectorFromAtoB() so that the results are identical.
+             */
+            unsigned num_nodes_in_element = p_element->GetNumNodes();
+            unsigned offset = mCachedVertexOffsets[elem_index];
+
+            for (unsigned local_index=0; local_index<num_nodes_in_element; local_index++)
+            {
+                unsigned previous_local_index = (num_nodes_in_element+local_index-1)%num_nodes_in_element;
+                unsigned next_local_index = (local_index+1)%num_nodes_in_element;
+
+                const c_vector<double, SPACE_DIM>& r_previous_node_location = p_element->GetNode(previous_local_index)->rGetLocation();
+                const c_vector<double, SPACE_DIM>& r_this_node_location = p_element->GetNode(local_index)->rGetLocation();
+                const c_vector<double, SPACE_DIM>& r_next_node_location = p_element->GetNode(next_local_index)->rGetLocation();
+
+                c_vector<double, SPACE_DIM> edge_vector = this->GetVectorFromAtoB(r_this_node_location, r_next_node_location);
+                double edge_length = norm_2(edge_vector);
+                assert(edge_length > DBL_EPSILON);
+
+                mCachedEdgeVectors[offset+local_index] = edge_vector;
+                mCachedNextEdgeGradients[offset+local_index] = this->GetVectorFromAtoB(r_next_node_location, r_this_node_location)/edge_length;
+
+                c_vector<double, SPACE_DIM> difference_vector = this->GetVectorFromAtoB(r_previous_node_location, r_next_node_location);
+                c_vector<double, SPACE_DIM>& r_area_gradient = mCachedAreaGradients[offset+local_index];
+                r_area_gradient[0] = 0.5*difference_vector[1];
+                r_area_gradient[1] = -0.5*difference_vector[0];
+            }
+        }
+    }
+
+    mElementGeometryCacheIsValid = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMesh<ELEMENT_DIM, SPACE_DIM>::InvalidateElementGeometryCache()
+{
+    mElementGeometryCacheIsValid = false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool VertexMesh<ELEMENT_DIM, SPACE_DIM>::IsElementGeometryCacheValid() const
+{
+    return mElementGeometryCacheIsValid;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetCachedVolumeOfElement(unsigned index) const
+{
+    assert(mElementGeometryCacheIsValid);
+    assert(index < mCachedElementVolumes.size());
+    return mCachedElementVolumes[index];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetCachedSurfaceAreaOfElement(unsigned index) const
+{
+    assert(mElementGeometryCacheIsValid);
+    assert(index < mCachedElementSurfaceAreas.size());
+    return mCachedElementSurfaceAreas[index];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const c_vector<double, SPACE_DIM>& VertexMesh<ELEMENT_DIM, SPACE_DIM>::rGetCachedCentroidOfElement(unsigned index) const
+{
+    assert(mElementGeometryCacheIsValid);
+    assert(index < mCachedElementCentroids.size());
+    return mCachedElementCentroids[index];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetNumCachedVertices() const
+{
+    assert(mElementGeometryCacheIsValid);
+    return mCachedVertexOffsets.back();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetCachedVertexOffsetOfElement(unsigned index) const
+{
+    assert(mElementGeometryCacheIsValid);
+    assert(index < mCachedVertexOffsets.size() - 1);
+    return mCachedVertexOffsets[index];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const c_vector<double, SPACE_DIM>& VertexMesh<ELEMENT_DIM, SPACE_DIM>::rGetCachedEdgeVectorOfElement(unsigned index, unsigned localIndex) const
+{
+    assert(mElementGeometryCacheIsValid);
+    assert(mCachedVertexOffsets[index] + localIndex < mCachedVertexOffsets[index+1]);
+    return mCachedEdgeVectors[mCachedVertexOffsets[index] + localIndex];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const c_vector<double, SPACE_DIM>& VertexMesh<ELEMENT_DIM, SPACE_DIM>::rGetCachedNextEdgeGradientOfElementAtNode(unsigned index, unsigned localIndex) const
+{
+    assert(mElementGeometryCacheIsValid);
+    assert(mCachedVertexOffsets[index] + localIndex < mCachedVertexOffsets[index+1]);
+    return mCachedNextEdgeGradients[mCachedVertexOffsets[index] + localIndex];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const c_vector<double, SPACE_DIM>& VertexMesh<ELEMENT_DIM, SPACE_DIM>::rGetCachedAreaGradientOfElementAtNode(unsigned index, unsigned localIndex) const
+{
+    assert(mElementGeometryCacheIsValid);
+    assert(mCachedVertexOffsets[index] + localIndex < mCachedVertexOffsets[index+1]);
+    return mCachedAreaGradients[mCachedVertexOffsets[index] + localIndex];
+}
+
 //////////////////////////////////////////////////////////////////////
 //                        3D-specific methods                       //
 //////////////////////////////////////////////////////////////////////
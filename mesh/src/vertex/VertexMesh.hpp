@@ -101,6 +101,44 @@ protected:
      */
     TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* mpDelaunayMesh;
 
+    /**
+     * The global indices of the nodes of each element of mpDelaunayMesh, in order, at the
+     * time the vertices of this mesh were generated from its circumcentres. Used by
+     * UpdateVerticesFromDelaunayMesh() to detect whether the Delaunay mesh has changed topology.
+     */
+    std::vector<unsigned> mDelaunayElementNodeIndices;
+
+    /**
+     * Whether the element geometry cache is up to date. Set by UpdateElementGeometryCache()
+     * and reset by InvalidateElementGeometryCache().
+     */
+    bool mElementGeometryCacheIsValid;
+
+    /** Cached volume (area in 2D) of each element, indexed by element global index. */
+    std::vector<double> mCachedElementVolumes;
+
+    /** Cached surface area (perimeter in 2D) of each element, indexed by element global index. */
+    std::vector<double> mCachedElementSurfaceAreas;
+
+    /** Cached centroid of each element, indexed by element global index. */
+    std::vector<c_vector<double, SPACE_DIM> > mCachedElementCentroids;
+
+    /**
+     * Offset of the first entry for each element in the per-vertex caches below, indexed
+     * by element global index. The entries for an element are stored contiguously in
+     * order of local node index, with one more offset than elements.
+     */
+    std::vector<unsigned> mCachedVertexOffsets;
+
+    /** Cached vector from each vertex of a 2D element to the next vertex in the element. */
+    std::vector<c_vector<double, SPACE_DIM> > mCachedEdgeVectors;
+
+    /** Cached value of GetNextEdgeGradientOfElementAtNode() for each vertex of a 2D element. */
+    std::vector<c_vector<double, SPACE_DIM> > mCachedNextEdgeGradients;
+
+    /** Cached value of GetAreaGradientOfElementAtNode() for each vertex of a 2D element. */
+    std::vector<c_vector<double, SPACE_DIM> > mCachedAreaGradients;
+
     /**
      * Solve node mapping method. This overridden method is required
      * as it is pure virtual in the base class.
@@ -452,6 +490,103 @@ public:
      */
     c_vector<double, SPACE_DIM> GetPerimeterGradientOfElementAtNode(VertexElement<ELEMENT_DIM,SPACE_DIM>* pElement, unsigned localIndex);
 
+    /**
+     * Compute the volume, surface area and centroid of every element and, in 2D, the edge
+     * vector, next edge gradient and area gradient at every vertex of every element, in a
+     * single pass over the mesh. The results are returned by the GetCached...() methods
+     * until the next call to this method or InvalidateElementGeometryCache().
+     *
+     * This should be called whenever the nodes have moved, for example at the start of a
+     * force calculation, as the mesh does not track changes to node locations.
+     */
+    void UpdateElementGeometryCache();
+
+    /**
+     * Mark the element geometry cache as out of date. This is called by any method that
+     * changes the elements of the mesh or their nodes.
+     */
+    void InvalidateElementGeometryCache();
+
+    /**
+     * If this mesh is a Voronoi tessellation and mpDelaunayMesh has the same elements as when
+     * the tessellation was generated, move each vertex to the circumcentre of the corresponding
+     * Delaunay element rather than regenerating the tessellation. Elements none of whose vertices
+     * have moved are left untouched; any other element whose vertices are no longer in
+     * anticlockwise order is reordered. Currently only implemented in 2D.
+     *
+     * @param rElementsChanged  resized to the number of elements if necessary; the entry for each
+     *     element with a moved vertex is set to true and the other entries are left unchanged
+     *
+     * @return whether the vertices were updated; false if the Delaunay mesh has changed topology
+     *     (or this is not a 2D Voronoi tessellation), in which case the tessellation must be regenerated
+     */
+    virtual bool UpdateVerticesFromDelaunayMesh(std::vector<bool>& rElementsChanged);
+
+    /**
+     * @return whether the element geometry cache is up to date
+     */
+    bool IsElementGeometryCacheValid() const;
+
+    /**
+     * @param index  the global index of a specified vertex element
+     *
+     * @return the cached value of GetVolumeOfElement() for this element
+     */
+    double GetCachedVolumeOfElement(unsigned index) const;
+
+    /**
+     * @param index  the global index of a specified vertex element
+     *
+     * @return the cached value of GetSurfaceAreaOfElement() for this element
+     */
+    double GetCachedSurfaceAreaOfElement(unsigned index) const;
+
+    /**
+     * @param index  the global index of a specified vertex element
+     *
+     * @return the cached value of GetCentroidOfElement() for this element
+     */
+    const c_vector<double, SPACE_DIM>& rGetCachedCentroidOfElement(unsigned index) const;
+
+    /**
+     * @return the total number of vertices, summed over 2D elements, in the per-vertex caches
+     */
+    unsigned GetNumCachedVertices() const;
+
+    /**
+     * The per-vertex cached quantities of each 2D element are stored contiguously, in order of
+     * local node index. This method may be used to store further per-vertex quantities alongside.
+     *
+     * @param index  the global index of a specified 2D vertex element
+     *
+     * @return the position in the per-vertex caches of the entry for the first node in the element
+     */
+    unsigned GetCachedVertexOffsetOfElement(unsigned index) const;
+
+    /**
+     * @param index  the global index of a specified 2D vertex element
+     * @param localIndex  local index of a node in this element
+     *
+     * @return the cached vector from this node to the next node in the element
+     */
+    const c_vector<double, SPACE_DIM>& rGetCachedEdgeVectorOfElement(unsigned index, unsigned localIndex) const;
+
+    /**
+     * @param index  the global index of a specified 2D vertex element
+     * @param localIndex  local index of a node in this element
+     *
+     * @return the cached value of GetNextEdgeGradientOfElementAtNode() for this node
+     */
+    const c_vector<double, SPACE_DIM>& rGetCachedNextEdgeGradientOfElementAtNode(unsigned index, unsigned localIndex) const;
+
+    /**
+     * @param index  the global index of a specified 2D vertex element
+     * @param localIndex  local index of a node in this element
+     *
+     * @return the cached value of GetAreaGradientOfElementAtNode() for this node
+     */
+    const c_vector<double, SPACE_DIM>& rGetCachedAreaGradientOfElementAtNode(unsigned index, unsigned localIndex) const;
+
     /**
      * Compute the second moments and product moment of area for a given 2D element
      * about its centroid. These are:
@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Version.hpp"
 #include "Cylindrical2dVertexMesh.hpp"
 #include "Toroidal2dVertexMesh.hpp"
+#include "AsynchronousVtkWriter.hpp"
 
 /**
  * Convenience collection of iterators, primarily to get compilation to happen.
@@ -62,14 +63,15 @@ VertexMeshWriter<ELEMENT_DIM, SPACE_DIM>::VertexMeshWriter(const std::string& rD
       mpMesh(NULL),
       mpIters(new MeshWriterIterators<ELEMENT_DIM, SPACE_DIM>),
       mpNodeMap(NULL),
-      mNodeMapCurrentIndex(0)
+      mNodeMapCurrentIndex(0),
+      mWriteAsynchronously(false)
 {
     mpIters->pNodeIter = NULL;
     mpIters->pElemIter = NULL;
 
 #ifdef CHASTE_VTK
      // Dubious, since we shouldn't yet know what any details of the mesh are.
-     mpVtkUnstructedMesh = vtkUnstructuredGrid::New();
+     mpVtkGridData = new VtkGridData;
 #endif //CHASTE_VTK
 }
 
@@ -90,8 +92,7 @@ VertexMeshWriter<ELEMENT_DIM, SPACE_DIM>::~VertexMeshWriter()
     }
 
 #ifdef CHASTE_VTK
-     // Dubious, since we shouldn't yet know what any details of the mesh are.
-     mpVtkUnstructedMesh->Delete(); // Reference counted
+     delete mpVtkGridData;
 #endif //CHASTE_VTK
 }
 
@@ -204,6 +205,12 @@ ElementData VertexMeshWriter<ELEMENT_DIM, SPACE_DIM>::GetNextElement()
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMeshWriter<ELEMENT_DIM, SPACE_DIM>::SetWriteAsynchronously(bool writeAsynchronously)
+{
+    mWriteAsynchronously = writeAsynchronously;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void VertexMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteVtkUsingMesh(VertexMesh<ELEMENT_DIM, SPACE_DIM>& rMesh, std::string stamp)
 {
@@ -214,29 +221,40 @@ void VertexMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteVtkUsingMesh(VertexMesh<ELEM
     MakeVtkMesh(rMesh);
 
     // Now write VTK mesh to file
-    assert(mpVtkUnstructedMesh->CheckAttributes() == 0);
+    std::string vtk_file_name = this->mpOutputFileHandler->GetOutputDirectoryFullPath() + this->mBaseName;
+    if (stamp != "")
+    {
+        vtk_file_name += "_" + stamp;
+    }
+    vtk_file_name += ".vtu";
+
+    if (mWriteAsynchronously)
+    {
+        // Hand over the mesh data, from which the VTK mesh is built and written on another thread
+        AsynchronousVtkWriter::Instance()->Enqueue(mpVtkGridData, vtk_file_name);
+        mpVtkGridData = new VtkGridData;
+        return;
+    }
+
+    vtkUnstructuredGrid* p_vtk_mesh = mpVtkGridData->MakeVtkGrid();
+    assert(p_vtk_mesh->CheckAttributes() == 0);
+
     vtkXMLUnstructuredGridWriter* p_writer = vtkXMLUnstructuredGridWriter::New();
 #if VTK_MAJOR_VERSION >= 6
-    p_writer->SetInputData(mpVtkUnstructedMesh);
+    p_writer->SetInputData(p_vtk_mesh);
 #else
-    p_writer->SetInput(mpVtkUnstructedMesh);
+    p_writer->SetInput(p_vtk_mesh);
 #endif
     // Uninitialised stuff arises (see #1079), but you can remove valgrind problems by removing compression:
     // **** REMOVE WITH CAUTION *****
     p_writer->SetCompressor(NULL);
     // **** REMOVE WITH CAUTION *****
 
-    std::string vtk_file_name = this->mpOutputFileHandler->GetOutputDirectoryFullPath() + this->mBaseName;
-    if (stamp != "")
-    {
-        vtk_file_name += "_" + stamp;
-    }
-    vtk_file_name += ".vtu";
-
     p_writer->SetFileName(vtk_file_name.c_str());
     //p_writer->PrintSelf(std::cout, vtkIndent());
     p_writer->Write();
     p_writer->Delete(); // Reference counted
+    p_vtk_mesh->Delete(); // Reference counted
 #endif //CHASTE_VTK
 }
 
@@ -273,29 +291,40 @@ void VertexMeshWriter<2, 2>::WriteVtkUsingMesh(VertexMesh<2, 2>& rMesh, std::str
     }
 
     // Now write VTK mesh to file
-    assert(mpVtkUnstructedMesh->CheckAttributes() == 0);
+    std::string vtk_file_name = this->mpOutputFileHandler->GetOutputDirectoryFullPath() + this->mBaseName;
+    if (stamp != "")
+    {
+        vtk_file_name += "_" + stamp;
+    }
+    vtk_file_name += ".vtu";
+
+    if (mWriteAsynchronously)
+    {
+        // Hand over the mesh data, from which the VTK mesh is built and written on another thread
+        AsynchronousVtkWriter::Instance()->Enqueue(mpVtkGridData, vtk_file_name);
+        mpVtkGridData = new VtkGridData;
+        return;
+    }
+
+    vtkUnstructuredGrid* p_vtk_mesh = mpVtkGridData->MakeVtkGrid();
+    assert(p_vtk_mesh->CheckAttributes() == 0);
+
     vtkXMLUnstructuredGridWriter* p_writer = vtkXMLUnstructuredGridWriter::New();
 #if VTK_MAJOR_VERSION >= 6
-    p_writer->SetInputData(mpVtkUnstructedMesh);
+    p_writer->SetInputData(p_vtk_mesh);
 #else
-    p_writer->SetInput(mpVtkUnstructedMesh);
+    p_writer->SetInput(p_vtk_mesh);
 #endif
     // Uninitialised stuff arises (see #1079), but you can remove valgrind problems by removing compression:
     // **** REMOVE WITH CAUTION *****
     p_writer->SetCompressor(NULL);
     // **** REMOVE WITH CAUTION *****
 
-    std::string vtk_file_name = this->mpOutputFileHandler->GetOutputDirectoryFullPath() + this->mBaseName;
-    if (stamp != "")
-    {
-        vtk_file_name += "_" + stamp;
-    }
-    vtk_file_name += ".vtu";
-
     p_writer->SetFileName(vtk_file_name.c_str());
     //p_writer->PrintSelf(std::cout, vtkIndent());
     p_writer->Write();
     p_writer->Delete(); // Reference counted
+    p_vtk_mesh->Delete(); // Reference counted
 #endif //CHASTE_VTK
 }
 
@@ -304,44 +333,31 @@ void VertexMeshWriter<ELEMENT_DIM, SPACE_DIM>::MakeVtkMesh(VertexMesh<ELEMENT_DI
 {
 #ifdef CHASTE_VTK
     // Make the Vtk mesh
-    vtkPoints* p_pts = vtkPoints::New(VTK_DOUBLE);
-    p_pts->GetData()->SetName("Vertex positions");
     for (unsigned node_num=0; node_num<rMesh.GetNumNodes(); node_num++)
     {
         c_vector<double, SPACE_DIM> position = rMesh.GetNode(node_num)->rGetLocation();
         if (SPACE_DIM==2)
         {
-            p_pts->InsertPoint(node_num, position[0], position[1], 0.0);
+            mpVtkGridData->AddPoint(position[0], position[1], 0.0);
         }
         else
         {
-            p_pts->InsertPoint(node_num, position[0], position[1], position[2]);
+            mpVtkGridData->AddPoint(position[0], position[1], position[2]);
         }
     }
 
-    mpVtkUnstructedMesh->SetPoints(p_pts);
-    p_pts->Delete(); // Reference counted
+    int cell_type = (SPACE_DIM == 2) ? VTK_POLYGON : VTK_CONVEX_POINT_SET;
+    std::vector<unsigned> cell_point_indices;
     for (typename VertexMesh<ELEMENT_DIM,SPACE_DIM>::VertexElementIterator iter = rMesh.GetElementIteratorBegin();
          iter != rMesh.GetElementIteratorEnd();
          ++iter)
     {
-        vtkCell* p_cell;
-        if (SPACE_DIM == 2)
-        {
-            p_cell = vtkPolygon::New();
-        }
-        else
-        {
-            p_cell = vtkConvexPointSet::New();
-        }
-        vtkIdList* p_cell_id_list = p_cell->GetPointIds();
-        p_cell_id_list->SetNumberOfIds(iter->GetNumNodes());
+        cell_point_indices.resize(iter->GetNumNodes());
         for (unsigned j=0; j<iter->GetNumNodes(); ++j)
         {
-            p_cell_id_list->SetId(j, iter->GetNodeGlobalIndex(j));
+            cell_point_indices[j] = iter->GetNodeGlobalIndex(j);
         }
-        mpVtkUnstructedMesh->InsertNextCell(p_cell->GetCellType(), p_cell_id_list);
-        p_cell->Delete(); // Reference counted
+        mpVtkGridData->AddCell(cell_type, cell_point_indices);
     }
 #endif //CHASTE_VTK
 }
@@ -350,16 +366,8 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void VertexMeshWriter<ELEMENT_DIM, SPACE_DIM>::AddCellData(std::string dataName, std::vector<double> dataPayload)
 {
 #ifdef CHASTE_VTK
-    vtkDoubleArray* p_scalars = vtkDoubleArray::New();
-    p_scalars->SetName(dataName.c_str());
-    for (unsigned i=0; i<dataPayload.size(); i++)
-    {
-        p_scalars->InsertNextValue(dataPayload[i]);
-    }
-
-    vtkCellData* p_cell_data = mpVtkUnstructedMesh->GetCellData();
-    p_cell_data->AddArray(p_scalars);
-    p_scalars->Delete(); // Reference counted
+    std::vector<double>& r_values = mpVtkGridData->rAddCellData(dataName);
+    r_values.assign(dataPayload.begin(), dataPayload.end());
 #endif //CHASTE_VTK
 }
 
@@ -367,16 +375,8 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void VertexMeshWriter<ELEMENT_DIM, SPACE_DIM>::AddPointData(std::string dataName, std::vector<double> dataPayload)
 {
 #ifdef CHASTE_VTK
-    vtkDoubleArray* p_scalars = vtkDoubleArray::New();
-    p_scalars->SetName(dataName.c_str());
-    for (unsigned i=0; i<dataPayload.size(); i++)
-    {
-        p_scalars->InsertNextValue(dataPayload[i]);
-    }
-
-    vtkPointData* p_point_data = mpVtkUnstructedMesh->GetPointData();
-    p_point_data->AddArray(p_scalars);
-    p_scalars->Delete(); // Reference counted
+    std::vector<double>& r_values = mpVtkGridData->rAddPointData(dataName);
+    r_values.assign(dataPayload.begin(), dataPayload.end());
 #endif //CHASTE_VTK
 }
 
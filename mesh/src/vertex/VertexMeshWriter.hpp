@@ -51,6 +51,8 @@ class VertexMesh;
 #include <vtkUnstructuredGridWriter.h>
 #include <vtkXMLUnstructuredGridWriter.h>
 #include <vtkDataCompressor.h>
+#include <vtkCellType.h>
+#include "VtkGridData.hpp"
 #endif //CHASTE_VTK
 
 #include "VertexMesh.hpp"
@@ -85,10 +87,14 @@ private:
     /** What was the last index written to #mpNodeMap ? */
     unsigned mNodeMapCurrentIndex;
 
+    /** Whether WriteVtkUsingMesh() hands the VTK mesh to AsynchronousVtkWriter rather than writing it immediately (defaults to false). */
+    bool mWriteAsynchronously;
+
 #ifdef CHASTE_VTK
 //Requires  "sudo aptitude install libvtk5-dev" or similar
 ///\todo Merge into VtkMeshWriter (#1076)
-    vtkUnstructuredGrid* mpVtkUnstructedMesh;
+    /** The VTK mesh, held in plain arrays until the VTK mesh data structure is built for writing. */
+    VtkGridData* mpVtkGridData;
 #endif //CHASTE_VTK
 
 public:
@@ -126,7 +132,15 @@ public:
     void WriteVtkUsingMesh(VertexMesh<ELEMENT_DIM, SPACE_DIM>& rMesh, std::string stamp="");
 
     /**
-     * Populate mpVtkUnstructedMesh using a vertex-based mesh.
+     * Set whether WriteVtkUsingMesh() should hand the finished mesh data to AsynchronousVtkWriter,
+     * which builds the VTK mesh and writes it on a background thread, instead of writing it immediately.
+     *
+     * @param writeAsynchronously the new value of mWriteAsynchronously
+     */
+    void SetWriteAsynchronously(bool writeAsynchronously);
+
+    /**
+     * Populate mpVtkGridData using a vertex-based mesh.
      * Called by WriteVtkUsingMesh().
      *
      * @param rMesh reference to the vertex-based mesh
@@ -0,0 +1,255 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "AsynchronousVtkWriter.hpp"
+
+#ifdef CHASTE_VTK
+
+#include <cassert>
+#include <fstream>
+#include <vtkUnstructuredGrid.h>
+#include <vtkXMLUnstructuredGridWriter.h>
+#include <vtkVersion.h>
+#include "VtkGridData.hpp"
+
+AsynchronousVtkWriter* AsynchronousVtkWriter::mpInstance = NULL;
+
+AsynchronousVtkWriter::AsynchronousVtkWriter()
+    : mMaxQueueDepth(4u),
+      mUseCompression(true),
+      mNumFilesWritten(0u),
+      mThreadStarted(false),
+      mStopRequested(false),
+      mWriting(false)
+{
+    pthread_mutex_init(&mMutex, NULL);
+    pthread_cond_init(&mQueueChanged, NULL);
+}
+
+AsynchronousVtkWriter* AsynchronousVtkWriter::Instance()
+{
+    if (mpInstance == NULL)
+    {
+        mpInstance = new AsynchronousVtkWriter;
+    }
+    return mpInstance;
+}
+
+void AsynchronousVtkWriter::Destroy()
+{
+    if (mpInstance)
+    {
+        delete mpInstance;
+        mpInstance = NULL;
+    }
+}
+
+AsynchronousVtkWriter::~AsynchronousVtkWriter()
+{
+    if (mThreadStarted)
+    {
+        // The background thread writes anything left in the queue before finishing
+        pthread_mutex_lock(&mMutex);
+        mStopRequested = true;
+        pthread_cond_broadcast(&mQueueChanged);
+        pthread_mutex_unlock(&mMutex);
+        pthread_join(mThread, NULL);
+    }
+    pthread_cond_destroy(&mQueueChanged);
+    pthread_mutex_destroy(&mMutex);
+}
+
+void* AsynchronousVtkWriter::ThreadMain(void* pWriter)
+{
+    static_cast<AsynchronousVtkWriter*>(pWriter)->ProcessQueue();
+    return NULL;
+}
+
+void AsynchronousVtkWriter::ProcessQueue()
+{
+    pthread_mutex_lock(&mMutex);
+    while (true)
+    {
+        while (mQueue.empty() && !mStopRequested)
+        {
+            pthread_cond_wait(&mQueueChanged, &mMutex);
+        }
+        if (mQueue.empty())
+        {
+            break;
+        }
+
+        QueuedGrid queued_grid = mQueue.front();
+        mQueue.pop_front();
+        mWriting = true;
+        bool use_compression = mUseCompression;
+        pthread_cond_broadcast(&mQueueChanged);
+
+        // Write without holding the lock, so that the simulation can queue more grids
+        pthread_mutex_unlock(&mMutex);
+        WriteGrid(queued_grid, use_compression);
+        pthread_mutex_lock(&mMutex);
+
+        mWriting = false;
+        mNumFilesWritten++;
+        pthread_cond_broadcast(&mQueueChanged);
+    }
+    pthread_mutex_unlock(&mMutex);
+}
+
+void AsynchronousVtkWriter::WriteGrid(const QueuedGrid& rQueuedGrid, bool useCompression)
+{
+    vtkUnstructuredGrid* p_grid = rQueuedGrid.mpGridData->MakeVtkGrid();
+    delete rQueuedGrid.mpGridData;
+    assert(p_grid->CheckAttributes() == 0);
+
+    vtkXMLUnstructuredGridWriter* p_writer = vtkXMLUnstructuredGridWriter::New();
+#if VTK_MAJOR_VERSION >= 6
+    p_writer->SetInputData(p_grid);
+#else
+    p_writer->SetInput(p_grid);
+#endif
+    // Raw binary appended data avoids the cost of base64 encoding
+    p_writer->SetDataModeToAppended();
+    p_writer->EncodeAppendedDataOff();
+    if (!useCompression)
+    {
+        p_writer->SetCompressor(NULL);
+    }
+    p_writer->SetFileName(rQueuedGrid.mFileName.c_str());
+    p_writer->Write();
+    p_writer->Delete(); // Reference counted
+    p_grid->Delete(); // Reference counted
+
+    if (!rQueuedGrid.mComment.empty())
+    {
+        std::ofstream vtu_file(rQueuedGrid.mFileName.c_str(), std::ios::out | std::ios::app);
+        vtu_file << "\n" << rQueuedGrid.mComment << "\n";
+    }
+}
+
+void AsynchronousVtkWriter::Enqueue(VtkGridData* pGridData, const std::string& rFileName, const std::string& rComment)
+{
+    QueuedGrid queued_grid;
+    queued_grid.mpGridData = pGridData;
+    queued_grid.mFileName = rFileName;
+    queued_grid.mComment = rComment;
+
+    pthread_mutex_lock(&mMutex);
+    if (mMaxQueueDepth == 0)
+    {
+        // Write on this thread, after anything already queued
+        while (!mQueue.empty() || mWriting)
+        {
+            pthread_cond_wait(&mQueueChanged, &mMutex);
+        }
+        bool use_compression = mUseCompression;
+        pthread_mutex_unlock(&mMutex);
+
+        WriteGrid(queued_grid, use_compression);
+
+        pthread_mutex_lock(&mMutex);
+        mNumFilesWritten++;
+        pthread_mutex_unlock(&mMutex);
+        return;
+    }
+
+    if (!mThreadStarted)
+    {
+        pthread_create(&mThread, NULL, &AsynchronousVtkWriter::ThreadMain, this);
+        mThreadStarted = true;
+    }
+
+    // Wait for space in the queue
+    while (mMaxQueueDepth > 0 && mQueue.size() >= mMaxQueueDepth)
+    {
+        pthread_cond_wait(&mQueueChanged, &mMutex);
+    }
+    mQueue.push_back(queued_grid);
+    pthread_cond_broadcast(&mQueueChanged);
+    pthread_mutex_unlock(&mMutex);
+}
+
+void AsynchronousVtkWriter::Flush()
+{
+    pthread_mutex_lock(&mMutex);
+    while (!mQueue.empty() || mWriting)
+    {
+        pthread_cond_wait(&mQueueChanged, &mMutex);
+    }
+    pthread_mutex_unlock(&mMutex);
+}
+
+void AsynchronousVtkWriter::SetMaxQueueDepth(unsigned maxQueueDepth)
+{
+    pthread_mutex_lock(&mMutex);
+    mMaxQueueDepth = maxQueueDepth;
+    pthread_cond_broadcast(&mQueueChanged);
+    pthread_mutex_unlock(&mMutex);
+}
+
+unsigned AsynchronousVtkWriter::GetMaxQueueDepth()
+{
+    pthread_mutex_lock(&mMutex);
+    unsigned max_queue_depth = mMaxQueueDepth;
+    pthread_mutex_unlock(&mMutex);
+    return max_queue_depth;
+}
+
+void AsynchronousVtkWriter::SetUseCompression(bool useCompression)
+{
+    pthread_mutex_lock(&mMutex);
+    mUseCompression = useCompression;
+    pthread_mutex_unlock(&mMutex);
+}
+
+bool AsynchronousVtkWriter::GetUseCompression()
+{
+    pthread_mutex_lock(&mMutex);
+    bool use_compression = mUseCompression;
+    pthread_mutex_unlock(&mMutex);
+    return use_compression;
+}
+
+unsigned AsynchronousVtkWriter::GetNumFilesWritten()
+{
+    pthread_mutex_lock(&mMutex);
+    unsigned num_files_written = mNumFilesWritten;
+    pthread_mutex_unlock(&mMutex);
+    return num_files_written;
+}
+
+#endif //CHASTE_VTK
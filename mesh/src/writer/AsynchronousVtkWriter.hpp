@@ -0,0 +1,206 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef ASYNCHRONOUSVTKWRITER_HPP_
+#define ASYNCHRONOUSVTKWRITER_HPP_
+
+#ifdef CHASTE_VTK
+
+#include <pthread.h>
+#include <deque>
+#include <string>
+
+class VtkGridData;
+
+/**
+ * A singleton which writes VTK unstructured grids to .vtu files on a background
+ * thread, so that a simulation does not have to wait for its VTK output.
+ *
+ * Mesh writers hand over ownership of a VtkGridData (a snapshot of the geometry and
+ * data in plain arrays) using Enqueue(), then carry on. The background thread builds
+ * the VTK grid from it, writes the grid in binary appended format, optionally
+ * compressed with zlib, and then deletes both. No VTK objects are created on the
+ * calling thread.
+ *
+ * The queue is bounded. Once it holds GetMaxQueueDepth() grids, Enqueue() waits
+ * for the writer to catch up, which limits the memory held by snapshots. With a
+ * maximum depth of zero, grids are written immediately on the calling thread.
+ *
+ * Call Flush() before relying on the files, for example at the end of a simulation.
+ *
+ * The background thread makes no MPI calls. Each process has its own writer.
+ */
+class AsynchronousVtkWriter
+{
+private:
+
+    /** A grid waiting to be written. */
+    struct QueuedGrid
+    {
+        /** The grid data, which is owned by the queue. */
+        VtkGridData* mpGridData;
+
+        /** The full path of the .vtu file to write. */
+        std::string mFileName;
+
+        /** A comment to append to the file after writing, or an empty string. */
+        std::string mComment;
+    };
+
+    /** Pointer to the single instance. */
+    static AsynchronousVtkWriter* mpInstance;
+
+    /** The grids waiting to be written. */
+    std::deque<QueuedGrid> mQueue;
+
+    /** The maximum number of grids that may be waiting to be written (defaults to 4). */
+    unsigned mMaxQueueDepth;
+
+    /** Whether to compress the data in the files using zlib (defaults to true). */
+    bool mUseCompression;
+
+    /** The number of files written since the instance was created. */
+    unsigned mNumFilesWritten;
+
+    /** Whether the background thread has been started. */
+    bool mThreadStarted;
+
+    /** Whether the background thread has been asked to finish. */
+    bool mStopRequested;
+
+    /** Whether the background thread is currently writing a grid. */
+    bool mWriting;
+
+    /** The background thread. */
+    pthread_t mThread;
+
+    /** Protects all the members above that are shared with the background thread. */
+    pthread_mutex_t mMutex;
+
+    /** Signalled whenever a grid is added to or removed from the queue. */
+    pthread_cond_t mQueueChanged;
+
+    /**
+     * Private constructor. Use Instance() to access the writer.
+     */
+    AsynchronousVtkWriter();
+
+    /**
+     * Entry point of the background thread.
+     *
+     * @param pWriter pointer to the writer
+     * @return NULL
+     */
+    static void* ThreadMain(void* pWriter);
+
+    /**
+     * Write queued grids until asked to stop. Runs on the background thread.
+     */
+    void ProcessQueue();
+
+    /**
+     * Build a grid from its data, write it to file and delete the data.
+     *
+     * @param rQueuedGrid the grid to write
+     * @param useCompression whether to compress the data using zlib
+     */
+    static void WriteGrid(const QueuedGrid& rQueuedGrid, bool useCompression);
+
+public:
+
+    /**
+     * @return a pointer to the single instance, creating it if necessary.
+     */
+    static AsynchronousVtkWriter* Instance();
+
+    /**
+     * Write any queued grids, stop the background thread and delete the instance.
+     */
+    static void Destroy();
+
+    /**
+     * Destructor. Writes any queued grids and stops the background thread.
+     */
+    ~AsynchronousVtkWriter();
+
+    /**
+     * Take ownership of the data of a grid and queue it for writing, waiting first
+     * if the queue is full.
+     *
+     * @param pGridData the grid data; the caller must not use it again
+     * @param rFileName the full path of the .vtu file to write
+     * @param rComment a comment (such as provenance) to append to the file, or an empty string
+     */
+    void Enqueue(VtkGridData* pGridData, const std::string& rFileName, const std::string& rComment="");
+
+    /**
+     * Wait until all queued grids have been written.
+     */
+    void Flush();
+
+    /**
+     * Set mMaxQueueDepth.
+     *
+     * @param maxQueueDepth the new value of mMaxQueueDepth
+     */
+    void SetMaxQueueDepth(unsigned maxQueueDepth);
+
+    /**
+     * @return mMaxQueueDepth.
+     */
+    unsigned GetMaxQueueDepth();
+
+    /**
+     * Set mUseCompression.
+     *
+     * @param useCompression the new value of mUseCompression
+     */
+    void SetUseCompression(bool useCompression);
+
+    /**
+     * @return mUseCompression.
+     */
+    bool GetUseCompression();
+
+    /**
+     * @return the number of files written so far.
+     */
+    unsigned GetNumFilesWritten();
+};
+
+#endif //CHASTE_VTK
+
+#endif /*ASYNCHRONOUSVTKWRITER_HPP_*/
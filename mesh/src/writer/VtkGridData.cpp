@@ -0,0 +1,162 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "VtkGridData.hpp"
+
+#ifdef CHASTE_VTK
+
+#include <cassert>
+#include <vtkCellData.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdList.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkUnstructuredGrid.h>
+
+VtkGridData::VtkGridData()
+{
+    mCellOffsets.push_back(0u);
+}
+
+void VtkGridData::AddPoint(double x, double y, double z)
+{
+    mPoints.push_back(x);
+    mPoints.push_back(y);
+    mPoints.push_back(z);
+}
+
+void VtkGridData::AddCell(int cellType, const std::vector<unsigned>& rPointIndices)
+{
+    mCellTypes.push_back(cellType);
+    mCellPointIndices.insert(mCellPointIndices.end(), rPointIndices.begin(), rPointIndices.end());
+    mCellOffsets.push_back(mCellPointIndices.size());
+}
+
+std::vector<double>& VtkGridData::rAddPointData(const std::string& rName, unsigned numComponents)
+{
+    assert(numComponents > 0);
+    mPointData.push_back(DataArray());
+    mPointData.back().mName = rName;
+    mPointData.back().mNumComponents = numComponents;
+    return mPointData.back().mValues;
+}
+
+std::vector<double>& VtkGridData::rAddCellData(const std::string& rName, unsigned numComponents)
+{
+    assert(numComponents > 0);
+    mCellData.push_back(DataArray());
+    mCellData.back().mName = rName;
+    mCellData.back().mNumComponents = numComponents;
+    return mCellData.back().mValues;
+}
+
+const std::vector<VtkGridData::DataArray>& VtkGridData::rGetCellData() const
+{
+    return mCellData;
+}
+
+void VtkGridData::PadCellData(unsigned numTuples)
+{
+    for (unsigned i=0; i<mCellData.size(); i++)
+    {
+        mCellData[i].mValues.resize(mCellData[i].mValues.size() + numTuples*mCellData[i].mNumComponents, 0.0);
+    }
+}
+
+unsigned VtkGridData::GetNumPoints() const
+{
+    return mPoints.size()/3;
+}
+
+unsigned VtkGridData::GetNumCells() const
+{
+    return mCellTypes.size();
+}
+
+void VtkGridData::AddVtkDataArrays(const std::vector<DataArray>& rArrays, vtkFieldData* pData)
+{
+    for (unsigned i=0; i<rArrays.size(); i++)
+    {
+        const DataArray& r_array = rArrays[i];
+        assert(r_array.mValues.size()%r_array.mNumComponents == 0);
+
+        vtkDoubleArray* p_array = vtkDoubleArray::New();
+        p_array->SetName(r_array.mName.c_str());
+        p_array->SetNumberOfComponents(r_array.mNumComponents);
+        p_array->SetNumberOfValues(r_array.mValues.size());
+        for (unsigned j=0; j<r_array.mValues.size(); j++)
+        {
+            p_array->SetValue(j, r_array.mValues[j]);
+        }
+        pData->AddArray(p_array);
+        p_array->Delete(); // Reference counted
+    }
+}
+
+vtkUnstructuredGrid* VtkGridData::MakeVtkGrid() const
+{
+    vtkUnstructuredGrid* p_grid = vtkUnstructuredGrid::New();
+
+    vtkPoints* p_pts = vtkPoints::New(VTK_DOUBLE);
+    p_pts->GetData()->SetName("Vertex positions");
+    p_pts->SetNumberOfPoints(GetNumPoints());
+    for (unsigned i=0; i<GetNumPoints(); i++)
+    {
+        p_pts->SetPoint(i, mPoints[3*i], mPoints[3*i+1], mPoints[3*i+2]);
+    }
+    p_grid->SetPoints(p_pts);
+    p_pts->Delete(); // Reference counted
+
+    p_grid->Allocate(GetNumCells());
+    vtkIdList* p_cell_id_list = vtkIdList::New();
+    for (unsigned i=0; i<GetNumCells(); i++)
+    {
+        p_cell_id_list->SetNumberOfIds(mCellOffsets[i+1] - mCellOffsets[i]);
+        for (unsigned j=mCellOffsets[i]; j<mCellOffsets[i+1]; j++)
+        {
+            p_cell_id_list->SetId(j - mCellOffsets[i], mCellPointIndices[j]);
+        }
+        p_grid->InsertNextCell(mCellTypes[i], p_cell_id_list);
+    }
+    p_cell_id_list->Delete(); // Reference counted
+
+    AddVtkDataArrays(mPointData, p_grid->GetPointData());
+    AddVtkDataArrays(mCellData, p_grid->GetCellData());
+
+    return p_grid;
+}
+
+#endif //CHASTE_VTK
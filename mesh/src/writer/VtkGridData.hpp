@@ -0,0 +1,176 @@
+/*
+
+Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef VTKGRIDDATA_HPP_
+#define VTKGRIDDATA_HPP_
+
+#ifdef CHASTE_VTK
+
+#include <string>
+#include <vector>
+
+class vtkFieldData;
+class vtkUnstructuredGrid;
+
+/**
+ * The geometry and data of a VTK unstructured grid, held in plain arrays.
+ *
+ * The mesh writers fill one of these, and the VTK grid is only built from it by
+ * MakeVtkGrid() when the file is written. This lets AsynchronousVtkWriter take over
+ * a snapshot of the mesh without the simulation thread creating any VTK objects.
+ */
+class VtkGridData
+{
+public:
+
+    /** A named data array with one tuple for each point or cell. */
+    struct DataArray
+    {
+        /** The name of the array. */
+        std::string mName;
+
+        /** The number of components in each tuple. */
+        unsigned mNumComponents;
+
+        /** The values, tuple by tuple. */
+        std::vector<double> mValues;
+    };
+
+private:
+
+    /** The x, y and z coordinates of each point. */
+    std::vector<double> mPoints;
+
+    /** The VTK cell type (such as VTK_TRIANGLE) of each cell. */
+    std::vector<int> mCellTypes;
+
+    /** The position in mCellPointIndices of the first point of each cell, followed by the total number of indices. */
+    std::vector<unsigned> mCellOffsets;
+
+    /** The point indices of all the cells, one cell after another. */
+    std::vector<unsigned> mCellPointIndices;
+
+    /** The point data arrays. */
+    std::vector<DataArray> mPointData;
+
+    /** The cell data arrays. */
+    std::vector<DataArray> mCellData;
+
+    /**
+     * Copy data arrays into the point or cell data of a VTK grid.
+     *
+     * @param rArrays the arrays
+     * @param pData the point or cell data of the grid
+     */
+    static void AddVtkDataArrays(const std::vector<DataArray>& rArrays, vtkFieldData* pData);
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    VtkGridData();
+
+    /**
+     * Add a point.
+     *
+     * @param x the x coordinate
+     * @param y the y coordinate
+     * @param z the z coordinate
+     */
+    void AddPoint(double x, double y, double z);
+
+    /**
+     * Add a cell.
+     *
+     * @param cellType the VTK cell type (such as VTK_TRIANGLE)
+     * @param rPointIndices the indices of the points of the cell, in VTK order
+     */
+    void AddCell(int cellType, const std::vector<unsigned>& rPointIndices);
+
+    /**
+     * Add an empty point data array. The reference returned is only valid until
+     * the next array is added.
+     *
+     * @param rName the name of the array
+     * @param numComponents the number of components in each tuple
+     * @return the values of the new array, for the caller to fill
+     */
+    std::vector<double>& rAddPointData(const std::string& rName, unsigned numComponents=1);
+
+    /**
+     * Add an empty cell data array. The reference returned is only valid until
+     * the next array is added.
+     *
+     * @param rName the name of the array
+     * @param numComponents the number of components in each tuple
+     * @return the values of the new array, for the caller to fill
+     */
+    std::vector<double>& rAddCellData(const std::string& rName, unsigned numComponents=1);
+
+    /**
+     * @return the cell data arrays
+     */
+    const std::vector<DataArray>& rGetCellData() const;
+
+    /**
+     * Append tuples of zeros to every cell data array.
+     *
+     * @param numTuples the number of tuples to append
+     */
+    void PadCellData(unsigned numTuples);
+
+    /**
+     * @return the number of points
+     */
+    unsigned GetNumPoints() const;
+
+    /**
+     * @return the number of cells
+     */
+    unsigned GetNumCells() const;
+
+    /**
+     * Build a VTK unstructured grid holding the points, cells and data.
+     *
+     * @return the grid, which the caller must Delete()
+     */
+    vtkUnstructuredGrid* MakeVtkGrid() const;
+};
+
+#endif //CHASTE_VTK
+
+#endif /*VTKGRIDDATA_HPP_*/
@@ -40,8 +40,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NodesOnlyMesh.hpp"
 
 #ifdef CHASTE_VTK
-#include "vtkQuadraticTetra.h"
-#include "vtkQuadraticTriangle.h"
+#include <vtkCellType.h>
+#include "AsynchronousVtkWriter.hpp"
 
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -52,26 +52,25 @@ VtkMeshWriter<ELEMENT_DIM, SPACE_DIM>::VtkMeshWriter(const std::string& rDirecto
                      const std::string& rBaseName,
                      const bool& rCleanDirectory)
     : AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>(rDirectory, rBaseName, rCleanDirectory),
-      mWriteParallelFiles(false)
+      mWriteParallelFiles(false),
+      mWriteAsynchronously(false)
 {
     this->mIndexFromZero = true;
 
     // Dubious, since we shouldn't yet know what any details of the mesh are.
-    mpVtkUnstructedMesh = vtkUnstructuredGrid::New();
+    mpVtkGridData = new VtkGridData;
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::~VtkMeshWriter()
 {
-    mpVtkUnstructedMesh->Delete(); // Reference counted
+    delete mpVtkGridData;
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::MakeVtkMesh()
 {
     //Construct nodes aka as Points
-    vtkPoints* p_pts = vtkPoints::New(VTK_DOUBLE);
-    p_pts->GetData()->SetName("Vertex positions");
     for (unsigned item_num=0; item_num<this->GetNumNodes(); item_num++)
     {
         std::vector<double> current_item = this->GetNextNode(); //this->mNodeData[item_num];
@@ -81,10 +80,8 @@ void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::MakeVtkMesh()
             current_item.push_back(0.0);//For y and z-coordinates if necessary
         }
         assert(current_item.size() == 3);
-        p_pts->InsertPoint(item_num, current_item[0], current_item[1], current_item[2]);
+        mpVtkGridData->AddPoint(current_item[0], current_item[1], current_item[2]);
     }
-    mpVtkUnstructedMesh->SetPoints(p_pts);
-    p_pts->Delete(); //Reference counted
 
     //Construct elements aka Cells
     for (unsigned item_num=0; item_num<this->GetNumElements(); item_num++)
@@ -93,45 +90,39 @@ void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::MakeVtkMesh()
 
         assert((current_element.size() == ELEMENT_DIM + 1) || (current_element.size() == (ELEMENT_DIM+1)*(ELEMENT_DIM+2)/2));
 
-        vtkCell* p_cell=NULL;
+        int cell_type = VTK_EMPTY_CELL;
         if (ELEMENT_DIM == 3 && current_element.size() == 4)
         {
-            p_cell = vtkTetra::New();
+            cell_type = VTK_TETRA;
         }
         else if (ELEMENT_DIM == 3 && current_element.size() == 10)
         {
-            p_cell = vtkQuadraticTetra::New();
+            cell_type = VTK_QUADRATIC_TETRA;
         }
         else if (ELEMENT_DIM == 2 && current_element.size() == 3)
         {
-            p_cell = vtkTriangle::New();
+            cell_type = VTK_TRIANGLE;
         }
         else if (ELEMENT_DIM == 2 && current_element.size() == 6)
         {
-            p_cell = vtkQuadraticTriangle::New();
+            cell_type = VTK_QUADRATIC_TRIANGLE;
         }
         else if (ELEMENT_DIM == 1)
         {
-            p_cell = vtkLine::New();
-        }
-
-        //Set the linear nodes
-        vtkIdList* p_cell_id_list = p_cell->GetPointIds();
-        for (unsigned j = 0; j < current_element.size(); ++j)
-        {
-            p_cell_id_list->SetId(j, current_element[j]);
+            cell_type = VTK_LINE;
+            current_element.resize(2); // A line has only its two end points
         }
 
         //VTK defines the node ordering in quadratic triangles differently to Chaste, so they must be treated as a special case
         if (SPACE_DIM == 2 && current_element.size() == 6)
         {
-            p_cell_id_list->SetId(3, current_element[5]);
-            p_cell_id_list->SetId(4, current_element[3]);
-            p_cell_id_list->SetId(5, current_element[4]);
+            std::vector<unsigned> chaste_order = current_element;
+            current_element[3] = chaste_order[5];
+            current_element[4] = chaste_order[3];
+            current_element[5] = chaste_order[4];
         }
 
-        mpVtkUnstructedMesh->InsertNextCell(p_cell->GetCellType(), p_cell_id_list);
-        p_cell->Delete(); //Reference counted
+        mpVtkGridData->AddCell(cell_type, current_element);
     }
 
     if (SPACE_DIM > 1)
@@ -155,14 +146,7 @@ void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::MakeVtkMesh()
             std::vector<unsigned> current_element = cable_element_data.NodeIndices;
             radii.push_back(cable_element_data.AttributeValue);
             assert(current_element.size() == 2);
-            vtkCell* p_cell=vtkLine::New();
-            vtkIdList* p_cell_id_list = p_cell->GetPointIds();
-            for (unsigned j = 0; j < 2; ++j)
-            {
-                p_cell_id_list->SetId(j, current_element[j]);
-            }
-            mpVtkUnstructedMesh->InsertNextCell(p_cell->GetCellType(), p_cell_id_list);
-            p_cell->Delete(); //Reference counted
+            mpVtkGridData->AddCell(VTK_LINE, current_element);
         }
         AddCellData("Cable radius", radii);
 
@@ -186,18 +170,31 @@ void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::WriteFiles()
     // Using separate scope here to make sure file is properly closed before re-opening it to add provenance info.
     {
         MakeVtkMesh();
-        assert(mpVtkUnstructedMesh->CheckAttributes() == 0);
+        std::string vtk_file_name = this->mpOutputFileHandler->GetOutputDirectoryFullPath() + this->mBaseName+".vtu";
+
+        if (mWriteAsynchronously)
+        {
+            // Hand over the mesh data, from which the VTK mesh is built and written on another thread
+            std::string comment = "<!-- " + ChasteBuildInfo::GetProvenanceString() + "-->";
+            AsynchronousVtkWriter::Instance()->Enqueue(mpVtkGridData, vtk_file_name, comment);
+            mpVtkGridData = new VtkGridData;
+            return;
+        }
+
+        vtkUnstructuredGrid* p_vtk_mesh = mpVtkGridData->MakeVtkGrid();
+        assert(p_vtk_mesh->CheckAttributes() == 0);
+
         vtkXMLUnstructuredGridWriter* p_writer = vtkXMLUnstructuredGridWriter::New();
 #if VTK_MAJOR_VERSION >= 6
-        p_writer->SetInputData(mpVtkUnstructedMesh);
+        p_writer->SetInputData(p_vtk_mesh);
 #else
-        p_writer->SetInput(mpVtkUnstructedMesh);
+        p_writer->SetInput(p_vtk_mesh);
 #endif
-        std::string vtk_file_name = this->mpOutputFileHandler->GetOutputDirectoryFullPath() + this->mBaseName+".vtu";
         p_writer->SetFileName(vtk_file_name.c_str());
         //p_writer->PrintSelf(std::cout, vtkIndent());
         p_writer->Write();
         p_writer->Delete(); //Reference counted
+        p_vtk_mesh->Delete(); //Reference counted
     }
 
     AddProvenance(this->mBaseName + ".vtu");
@@ -206,73 +203,51 @@ void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::WriteFiles()
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::AddCellData(std::string dataName, std::vector<double> dataPayload)
 {
-    vtkDoubleArray* p_scalars = vtkDoubleArray::New();
-    p_scalars->SetName(dataName.c_str());
-    for (unsigned i=0; i<dataPayload.size(); i++)
-    {
-        p_scalars->InsertNextValue(dataPayload[i]);
-    }
-
-    vtkCellData* p_cell_data = mpVtkUnstructedMesh->GetCellData();
-    p_cell_data->AddArray(p_scalars);
-    p_scalars->Delete(); //Reference counted
+    std::vector<double>& r_values = mpVtkGridData->rAddCellData(dataName);
+    r_values.assign(dataPayload.begin(), dataPayload.end());
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::AugmentCellData()
 {
-    unsigned num_cell_arrays = mpVtkUnstructedMesh->GetCellData()->GetNumberOfArrays();
-    for (unsigned i = 0; i < num_cell_arrays; i++)
+    unsigned num_elements = this->GetNumElements();
+    unsigned num_cable_pads = this->GetNumCableElements();
+    if (mWriteParallelFiles)
     {
-        vtkDataArray* array = mpVtkUnstructedMesh->GetCellData()->GetArray(i);
-
-        //Check data was the correct size before the cables were added
-        unsigned num_cable_pads = this->GetNumCableElements();
-        if (mWriteParallelFiles)
-        {
-            assert((unsigned)array->GetNumberOfTuples() == this->mpDistributedMesh->GetNumLocalElements());
-            num_cable_pads =  this->mpMixedMesh->GetNumLocalCableElements();
-        }
-        else
-        {
-            assert((unsigned)array->GetNumberOfTuples() == this->GetNumElements());
-        }
-
-        //Check that tuples of size 3 will be big enough for padding the rest of the data
-        assert(array->GetNumberOfComponents() <= 3);
-        double null_data[3] = {0.0, 0.0, 0.0};
+        num_elements = this->mpDistributedMesh->GetNumLocalElements();
+        num_cable_pads =  this->mpMixedMesh->GetNumLocalCableElements();
+    }
 
-        //Pad data
-        for (unsigned new_index = 0; new_index <  num_cable_pads; new_index++)
-        {
-            array->InsertNextTuple(null_data);
-        }
+    //Check data was the correct size before the cables were added
+    const std::vector<VtkGridData::DataArray>& r_cell_data = mpVtkGridData->rGetCellData();
+    for (unsigned i = 0; i < r_cell_data.size(); i++)
+    {
+        assert(r_cell_data[i].mValues.size() == num_elements*r_cell_data[i].mNumComponents);
     }
+    UNUSED_OPT(num_elements);
+
+    //Pad data
+    mpVtkGridData->PadCellData(num_cable_pads);
 }
 
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::AddCellData(std::string dataName, std::vector<c_vector<double, SPACE_DIM> > dataPayload)
 {
-    vtkDoubleArray* p_vectors = vtkDoubleArray::New();
-    p_vectors->SetName(dataName.c_str());
-    p_vectors->SetNumberOfComponents(3);
+    std::vector<double>& r_values = mpVtkGridData->rAddCellData(dataName, 3);
+    r_values.reserve(3*dataPayload.size());
     for (unsigned i=0; i<dataPayload.size(); i++)
     {
         for (unsigned j=0; j<SPACE_DIM; j++)
         {
-            p_vectors->InsertNextValue(dataPayload[i][j]);
+            r_values.push_back(dataPayload[i][j]);
         }
         //When SPACE_DIM<3, then pad
         for (unsigned j=SPACE_DIM; j<3; j++)
         {
-            p_vectors->InsertNextValue(0.0);
+            r_values.push_back(0.0);
         }
     }
-
-    vtkCellData* p_cell_data = mpVtkUnstructedMesh->GetCellData();
-    p_cell_data->AddArray(p_vectors);
-    p_vectors->Delete(); //Reference counted
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -280,35 +255,30 @@ void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::AddTensorCellData(std::string dataNam
 {
     assert(SPACE_DIM != 1);
 
-    vtkDoubleArray* p_vectors = vtkDoubleArray::New();
-    p_vectors->SetName(dataName.c_str());
-    p_vectors->SetNumberOfComponents(SPACE_DIM*SPACE_DIM);
+    std::vector<double>& r_values = mpVtkGridData->rAddCellData(dataName, SPACE_DIM*SPACE_DIM);
+    r_values.reserve(SPACE_DIM*SPACE_DIM*dataPayload.size());
     for (unsigned i=0; i<dataPayload.size(); i++)
     {
         if (SPACE_DIM == 2)
         {
-            p_vectors->InsertNextValue(dataPayload[i](0)); //a11
-            p_vectors->InsertNextValue(dataPayload[i](1)); //a12
-            p_vectors->InsertNextValue(dataPayload[i](1)); //a21
-            p_vectors->InsertNextValue(dataPayload[i](2)); //a22
+            r_values.push_back(dataPayload[i](0)); //a11
+            r_values.push_back(dataPayload[i](1)); //a12
+            r_values.push_back(dataPayload[i](1)); //a21
+            r_values.push_back(dataPayload[i](2)); //a22
         }
         else if (SPACE_DIM == 3)
         {
-            p_vectors->InsertNextValue(dataPayload[i](0)); //a11
-            p_vectors->InsertNextValue(dataPayload[i](1)); //a12
-            p_vectors->InsertNextValue(dataPayload[i](2)); //a13
-            p_vectors->InsertNextValue(dataPayload[i](1)); //a21
-            p_vectors->InsertNextValue(dataPayload[i](3)); //a22
-            p_vectors->InsertNextValue(dataPayload[i](4)); //a23
-            p_vectors->InsertNextValue(dataPayload[i](2)); //a31
-            p_vectors->InsertNextValue(dataPayload[i](4)); //a32
-            p_vectors->InsertNextValue(dataPayload[i](5)); //a33
+            r_values.push_back(dataPayload[i](0)); //a11
+            r_values.push_back(dataPayload[i](1)); //a12
+            r_values.push_back(dataPayload[i](2)); //a13
+            r_values.push_back(dataPayload[i](1)); //a21
+            r_values.push_back(dataPayload[i](3)); //a22
+            r_values.push_back(dataPayload[i](4)); //a23
+            r_values.push_back(dataPayload[i](2)); //a31
+            r_values.push_back(dataPayload[i](4)); //a32
+            r_values.push_back(dataPayload[i](5)); //a33
         }
     }
-
-    vtkCellData* p_cell_data = mpVtkUnstructedMesh->GetCellData();
-    p_cell_data->AddArray(p_vectors);
-    p_vectors->Delete(); //Reference counted
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -316,44 +286,25 @@ void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::AddTensorCellData(std::string dataNam
 {
     assert(SPACE_DIM != 1);
 
-    vtkDoubleArray* p_vectors = vtkDoubleArray::New();
-    p_vectors->SetName(dataName.c_str());
-    p_vectors->SetNumberOfComponents(SPACE_DIM*SPACE_DIM);
+    std::vector<double>& r_values = mpVtkGridData->rAddCellData(dataName, SPACE_DIM*SPACE_DIM);
+    r_values.reserve(SPACE_DIM*SPACE_DIM*dataPayload.size());
     for (unsigned i=0; i<dataPayload.size(); i++)
     {
-        if (SPACE_DIM == 2)
-        {
-            p_vectors->InsertNextValue(dataPayload[i](0,0)); //a11
-            p_vectors->InsertNextValue(dataPayload[i](0,1)); //a12
-            p_vectors->InsertNextValue(dataPayload[i](1,0)); //a21
-            p_vectors->InsertNextValue(dataPayload[i](1,1)); //a22
-        }
-        else if (SPACE_DIM == 3)
+        // Row by row: a11, a12, (a13,) a21, ...
+        for (unsigned row=0; row<SPACE_DIM; row++)
         {
-            p_vectors->InsertNextValue(dataPayload[i](0,0)); //a11
-            p_vectors->InsertNextValue(dataPayload[i](0,1)); //a12
-            p_vectors->InsertNextValue(dataPayload[i](0,2)); //a13
-            p_vectors->InsertNextValue(dataPayload[i](1,0)); //a21
-            p_vectors->InsertNextValue(dataPayload[i](1,1)); //a22
-            p_vectors->InsertNextValue(dataPayload[i](1,2)); //a23
-            p_vectors->InsertNextValue(dataPayload[i](2,0)); //a31
-            p_vectors->InsertNextValue(dataPayload[i](2,1)); //a32
-            p_vectors->InsertNextValue(dataPayload[i](2,2)); //a33
+            for (unsigned col=0; col<SPACE_DIM; col++)
+            {
+                r_values.push_back(dataPayload[i](row,col));
+            }
         }
     }
-
-    vtkCellData* p_cell_data = mpVtkUnstructedMesh->GetCellData();
-    p_cell_data->AddArray(p_vectors);
-    p_vectors->Delete(); //Reference counted
 }
 
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::AddPointData(std::string dataName, std::vector<double> dataPayload)
 {
-    vtkDoubleArray* p_scalars = vtkDoubleArray::New();
-    p_scalars->SetName(dataName.c_str());
-
     if (mWriteParallelFiles && this->mpDistributedMesh != NULL)
     {
         // In parallel, the vector we pass will only contain the values from the privately owned nodes.
@@ -411,23 +362,14 @@ void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::AddPointData(std::string dataName, st
         }
     }
 
-    for (unsigned i=0; i<dataPayload.size(); i++)
-    {
-        p_scalars->InsertNextValue(dataPayload[i]);
-    }
-
-    vtkPointData* p_point_data = mpVtkUnstructedMesh->GetPointData();
-    p_point_data->AddArray(p_scalars);
-    p_scalars->Delete(); //Reference counted
+    std::vector<double>& r_values = mpVtkGridData->rAddPointData(dataName);
+    r_values.assign(dataPayload.begin(), dataPayload.end());
 }
 
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::AddPointData(std::string dataName, std::vector<c_vector<double, SPACE_DIM> > dataPayload)
 {
-    vtkDoubleArray* p_vectors = vtkDoubleArray::New();
-    p_vectors->SetName(dataName.c_str());
-
     if (mWriteParallelFiles)
     {
         // In parallel, the vector we pass will only contain the values from the privately owned nodes.
@@ -487,23 +429,20 @@ void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::AddPointData(std::string dataName, st
         }
     }
 
-    p_vectors->SetNumberOfComponents(3);
+    std::vector<double>& r_values = mpVtkGridData->rAddPointData(dataName, 3);
+    r_values.reserve(3*dataPayload.size());
     for (unsigned i=0; i<dataPayload.size(); i++)
     {
         for (unsigned j=0; j<SPACE_DIM; j++)
         {
-            p_vectors->InsertNextValue(dataPayload[i][j]);
+            r_values.push_back(dataPayload[i][j]);
         }
         //When SPACE_DIM<3, then pad
         for (unsigned j=SPACE_DIM; j<3; j++)
         {
-            p_vectors->InsertNextValue(0.0);
+            r_values.push_back(0.0);
         }
     }
-
-    vtkPointData* p_point_data = mpVtkUnstructedMesh->GetPointData();
-    p_point_data->AddArray(p_vectors);
-    p_vectors->Delete(); //Reference counted
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -511,35 +450,19 @@ void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::AddTensorPointData(std::string dataNa
 {
     assert(SPACE_DIM != 1);
 
-    vtkDoubleArray* p_vectors = vtkDoubleArray::New();
-    p_vectors->SetName(dataName.c_str());
-    p_vectors->SetNumberOfComponents(SPACE_DIM*SPACE_DIM);
+    std::vector<double>& r_values = mpVtkGridData->rAddPointData(dataName, SPACE_DIM*SPACE_DIM);
+    r_values.reserve(SPACE_DIM*SPACE_DIM*dataPayload.size());
     for (unsigned i=0; i<dataPayload.size(); i++)
     {
-        if (SPACE_DIM == 2)
+        // Row by row: a11, a12, (a13,) a21, ...
+        for (unsigned row=0; row<SPACE_DIM; row++)
         {
-            p_vectors->InsertNextValue(dataPayload[i](0,0)); //a11
-            p_vectors->InsertNextValue(dataPayload[i](0,1)); //a12
-            p_vectors->InsertNextValue(dataPayload[i](1,0)); //a21
-            p_vectors->InsertNextValue(dataPayload[i](1,1)); //a22
-        }
-        else if (SPACE_DIM == 3)
-        {
-            p_vectors->InsertNextValue(dataPayload[i](0,0)); //a11
-            p_vectors->InsertNextValue(dataPayload[i](0,1)); //a12
-            p_vectors->InsertNextValue(dataPayload[i](0,2)); //a13
-            p_vectors->InsertNextValue(dataPayload[i](1,0)); //a21
-            p_vectors->InsertNextValue(dataPayload[i](1,1)); //a22
-            p_vectors->InsertNextValue(dataPayload[i](1,2)); //a23
-            p_vectors->InsertNextValue(dataPayload[i](2,0)); //a31
-            p_vectors->InsertNextValue(dataPayload[i](2,1)); //a32
-            p_vectors->InsertNextValue(dataPayload[i](2,2)); //a33
+            for (unsigned col=0; col<SPACE_DIM; col++)
+            {
+                r_values.push_back(dataPayload[i](row,col));
+            }
         }
     }
-
-    vtkPointData* p_point_data = mpVtkUnstructedMesh->GetPointData();
-    p_point_data->AddArray(p_vectors);
-    p_vectors->Delete(); //Reference counted
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -591,6 +514,12 @@ void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::SetParallelFiles( AbstractTetrahedral
     }
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtkMeshWriter<ELEMENT_DIM,SPACE_DIM>::SetWriteAsynchronously(bool writeAsynchronously)
+{
+    mWriteAsynchronously = writeAsynchronously;
+}
+
 ///\todo #1322 Mesh should be const
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void VtkMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingMesh(
@@ -608,8 +537,6 @@ void VtkMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingMesh(
     else
     {
         //Make the local mesh into a VtkMesh
-        vtkPoints* p_pts = vtkPoints::New(VTK_DOUBLE);
-        p_pts->GetData()->SetName("Vertex positions");
 
         // Owned nodes
         for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = rMesh.GetNodeIteratorBegin();
@@ -619,15 +546,15 @@ void VtkMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingMesh(
             c_vector<double, SPACE_DIM> current_item = node_iter->rGetLocation();
             if (SPACE_DIM == 3)
             {
-                p_pts->InsertNextPoint(current_item[0], current_item[1], current_item[2]);
+                mpVtkGridData->AddPoint(current_item[0], current_item[1], current_item[2]);
             }
             else if (SPACE_DIM == 2)
             {
-                p_pts->InsertNextPoint(current_item[0], current_item[1], 0.0);
+                mpVtkGridData->AddPoint(current_item[0], current_item[1], 0.0);
             }
             else // (SPACE_DIM == 1)
             {
-                p_pts->InsertNextPoint(current_item[0], 0.0, 0.0);
+                mpVtkGridData->AddPoint(current_item[0], 0.0, 0.0);
             }
         }
 
@@ -641,49 +568,40 @@ void VtkMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingMesh(
                 c_vector<double, SPACE_DIM> current_item = (*halo_iter)->rGetLocation();
                 if (SPACE_DIM == 3)
                 {
-                    p_pts->InsertNextPoint(current_item[0], current_item[1], current_item[2]);
+                    mpVtkGridData->AddPoint(current_item[0], current_item[1], current_item[2]);
                 }
                 else if (SPACE_DIM == 2)
                 {
-                    p_pts->InsertNextPoint(current_item[0], current_item[1], 0.0);
+                    mpVtkGridData->AddPoint(current_item[0], current_item[1], 0.0);
                 }
                 else // (SPACE_DIM == 1)
                 {
-                    p_pts->InsertNextPoint(current_item[0], 0.0, 0.0);
+                    mpVtkGridData->AddPoint(current_item[0], 0.0, 0.0);
                 }
             }
         }
 
-        mpVtkUnstructedMesh->SetPoints(p_pts);
-        p_pts->Delete(); //Reference counted
-
+        std::vector<unsigned> cell_point_indices(ELEMENT_DIM+1);
         for (typename AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>::ElementIterator elem_iter = rMesh.GetElementIteratorBegin();
              elem_iter != rMesh.GetElementIteratorEnd();
              ++elem_iter)
         {
-
-            vtkCell* p_cell=NULL;
             ///\todo This ought to look exactly like the other MakeVtkMesh
+            int cell_type = VTK_LINE;
             if (ELEMENT_DIM == 3)
             {
-                p_cell = vtkTetra::New();
+                cell_type = VTK_TETRA;
             }
             else if (ELEMENT_DIM == 2)
             {
-                p_cell = vtkTriangle::New();
-            }
-            else //(ELEMENT_DIM == 1)
-            {
-                p_cell = vtkLine::New();
+                cell_type = VTK_TRIANGLE;
             }
-            vtkIdList* p_cell_id_list = p_cell->GetPointIds();
             for (unsigned j = 0; j < ELEMENT_DIM+1; ++j)
             {
                 unsigned global_node_index = elem_iter->GetNodeGlobalIndex(j);
-                p_cell_id_list->SetId(j, mGlobalToNodeIndexMap[global_node_index]);
+                cell_point_indices[j] = mGlobalToNodeIndexMap[global_node_index];
             }
-            mpVtkUnstructedMesh->InsertNextCell(p_cell->GetCellType(), p_cell_id_list);
-            p_cell->Delete(); //Reference counted
+            mpVtkGridData->AddCell(cell_type, cell_point_indices);
         }
         //If necessary, construct cables
         if (this->mpMixedMesh )
@@ -691,20 +609,18 @@ void VtkMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingMesh(
             AugmentCellData();
             //Make a blank cell radius data for the regular elements
             std::vector<double> radii(this->mpMixedMesh->GetNumLocalElements(), 0.0);
+            std::vector<unsigned> cable_point_indices(2);
             for (typename MixedDimensionMesh<ELEMENT_DIM,SPACE_DIM>::CableElementIterator elem_iter = this->mpMixedMesh->GetCableElementIteratorBegin();
                  elem_iter != this->mpMixedMesh->GetCableElementIteratorEnd();
                  ++elem_iter)
             {
                 radii.push_back((*elem_iter)->GetAttribute());
-                vtkCell* p_cell=vtkLine::New();
-                vtkIdList* p_cell_id_list = p_cell->GetPointIds();
                 for (unsigned j = 0; j < 2; ++j)
                 {
                     unsigned global_node_index = (*elem_iter)->GetNodeGlobalIndex(j);
-                    p_cell_id_list->SetId(j, mGlobalToNodeIndexMap[global_node_index]);
+                    cable_point_indices[j] = mGlobalToNodeIndexMap[global_node_index];
                 }
-                mpVtkUnstructedMesh->InsertNextCell(p_cell->GetCellType(), p_cell_id_list);
-                p_cell->Delete(); //Reference counted
+                mpVtkGridData->AddCell(VTK_LINE, cable_point_indices);
             }
             AddCellData("Cable radius", radii);
         }
@@ -713,7 +629,8 @@ void VtkMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingMesh(
         //This block is to guard the mesh writers (vtkXMLPUnstructuredGridWriter) so that they
         //go out of scope, flush buffers and close files
         {
-            assert(mpVtkUnstructedMesh->CheckAttributes() == 0);
+            vtkUnstructuredGrid* p_vtk_mesh = mpVtkGridData->MakeVtkGrid();
+            assert(p_vtk_mesh->CheckAttributes() == 0);
             vtkXMLPUnstructuredGridWriter* p_writer = vtkXMLPUnstructuredGridWriter::New();
 
             p_writer->SetDataModeToBinary();
@@ -725,15 +642,16 @@ void VtkMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFilesUsingMesh(
 
 
 #if VTK_MAJOR_VERSION >= 6
-            p_writer->SetInputData(mpVtkUnstructedMesh);
+            p_writer->SetInputData(p_vtk_mesh);
 #else
-            p_writer->SetInput(mpVtkUnstructedMesh);
+            p_writer->SetInput(p_vtk_mesh);
 #endif
             std::string pvtk_file_name = this->mpOutputFileHandler->GetOutputDirectoryFullPath() + this->mBaseName+ ".pvtu";
             p_writer->SetFileName(pvtk_file_name.c_str());
             //p_writer->PrintSelf(std::cout, vtkIndent());
             p_writer->Write();
             p_writer->Delete(); //Reference counted
+            p_vtk_mesh->Delete(); //Reference counted
         }
 
         // Add provenance to the individual files
@@ -53,6 +53,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vtkDataCompressor.h>
 #include "AbstractTetrahedralMeshWriter.hpp"
 #include "Version.hpp"
+#include "VtkGridData.hpp"
 
 
 #include <map>
@@ -76,6 +77,8 @@ class VtkMeshWriter : public AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DI
 private:
     bool mWriteParallelFiles; /**< Whether to write parallel (.pvtu + .vtu for each process) files, defaults to false */
 
+    bool mWriteAsynchronously; /**< Whether to hand a single .vtu file to AsynchronousVtkWriter rather than writing it immediately, defaults to false */
+
     std::map<unsigned, unsigned> mGlobalToNodeIndexMap; /**< Map a global node index into a local index (into mNodes and mHaloNodes as if they were concatenated) */
 
     std::vector<std::vector<unsigned> > mNodesToSendPerProcess; /**< Used to communicate node-wise halo data */
@@ -85,16 +88,17 @@ private:
     NodesOnlyMesh<SPACE_DIM>* mpNodesOnlyMesh;
 
     /**
-     * A VTK mesh data structure.
+     * The VTK mesh, held in plain arrays.
      * Created at construction, has data associated with it by AddCellData
-     * and AddCellPoint, then is filled with mesh geometry by MakeVtkMesh() in
-     * WriteFiles().
+     * and AddPointData, then is filled with mesh geometry by MakeVtkMesh() in
+     * WriteFiles(). The VTK mesh data structure itself is only built from it
+     * when the file is written.
      */
-    vtkUnstructuredGrid* mpVtkUnstructedMesh;
+    VtkGridData* mpVtkGridData;
 
     /**
      * Private helper method which copies the mesh details into the waiting
-     * VTK mesh structure.  Called by  WriteFiles().
+     * mesh data.  Called by  WriteFiles().
      */
     void MakeVtkMesh();
 
@@ -197,6 +201,15 @@ public:
      */
      void SetParallelFiles(AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>& rMesh);
 
+    /**
+     * Set whether WriteFiles() should hand the finished mesh data to AsynchronousVtkWriter, which
+     * builds the VTK mesh and writes it on a background thread, instead of writing it immediately. This only applies when
+     * writing a single .vtu file; parallel files are always written immediately.
+     *
+     * @param writeAsynchronously the new value of mWriteAsynchronously
+     */
+    void SetWriteAsynchronously(bool writeAsynchronously);
+
     /**
      * Write files. Overrides the method implemented in AbstractTetrahedralMeshWriter, which concentrates mesh
      * data onto a single file in order to output a monolithic file. For VTK, a DistributedTetrahedralMesh in
@@ -1017,6 +1017,132 @@ public:
         TS_ASSERT_EQUALS(mesh.GetNumElements(), 4u);
     }
 
+    void TestIncrementalReMesh() throw (Exception)
+    {
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_128_elements");
+        MutableMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        TS_ASSERT_EQUALS(mesh.GetUseIncrementalReMesh(), false);
+        mesh.SetUseIncrementalReMesh(true);
+        TS_ASSERT_EQUALS(mesh.GetUseIncrementalReMesh(), true);
+
+        // Perturb the interior nodes, so that some edges are no longer Delaunay
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        std::vector<c_vector<double,2> > locations;
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            c_vector<double,2> location = mesh.GetNode(i)->rGetLocation();
+            if (!mesh.GetNode(i)->IsBoundaryNode())
+            {
+                location[0] += 0.04*(p_gen->ranf() - 0.5);
+                location[1] += 0.04*(p_gen->ranf() - 0.5);
+            }
+            locations.push_back(location);
+        }
+
+        // Add a new node in the interior of the mesh
+        c_vector<double,2> new_location;
+        new_location[0] = 0.53;
+        new_location[1] = 0.47;
+        locations.push_back(new_location);
+
+        // Too few locations are rejected, leaving the mesh unchanged
+        std::vector<c_vector<double,2> > too_few_locations(locations.begin(), locations.begin() + 10);
+        TS_ASSERT_EQUALS(mesh.MoveNodesAndReMesh(too_few_locations), false);
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 81u);
+
+        TS_ASSERT_EQUALS(mesh.MoveNodesAndReMesh(locations), true);
+
+        // The existing elements are kept and two are added by inserting the new node
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 82u);
+        TS_ASSERT_EQUALS(mesh.GetNumElements(), 130u);
+        TS_ASSERT_EQUALS(mesh.GetNumBoundaryElements(), 32u);
+        TS_ASSERT_EQUALS(mesh.GetNode(81)->GetNumContainingElements() >= 3u, true);
+        TS_ASSERT_DELTA(mesh.GetVolume(), 1.0, 1e-12);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(1e-6), true);
+
+        // Moving a boundary node outwards changes the convex hull, so the mesh is remeshed from scratch
+        ChastePoint<2> corner(1.2, 1.2);
+        mesh.SetNode(2, corner, false);
+        NodeMap map(mesh.GetNumNodes());
+        mesh.ReMesh(map);
+
+        TS_ASSERT_EQUALS(map.IsIdentityMap(), true);
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 82u);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(1e-6), true);
+    }
+
+    void TestIncrementalReMeshWithDeletedAndAddedNodes() throw (Exception)
+    {
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_128_elements");
+        MutableMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+        mesh.SetUseIncrementalReMesh(true);
+
+        // The first remesh checks every edge, since no node locations have been recorded
+        mesh.ReMesh();
+        unsigned num_connectivity_changes = mesh.GetNumConnectivityChanges();
+
+        // Remeshing again without moving any nodes leaves the connectivity unchanged
+        NodeMap identity_map(mesh.GetNumNodes());
+        mesh.ReMesh(identity_map);
+        TS_ASSERT_EQUALS(identity_map.IsIdentityMap(), true);
+        TS_ASSERT_EQUALS(mesh.GetNumConnectivityChanges(), num_connectivity_changes);
+        TS_ASSERT_EQUALS(mesh.GetNumElements(), 128u);
+
+        // Delete the interior node at (0.25, 0.375) and add a new node elsewhere in the interior
+        TS_ASSERT_EQUALS(mesh.GetNode(41)->IsBoundaryNode(), false);
+        mesh.DeleteNodePriorToReMesh(41);
+        unsigned new_index = mesh.AddNode(new Node<2>(0, false, 0.61, 0.67));
+
+        // The index of the deleted node is not reused, since its elements are still in the mesh
+        TS_ASSERT_EQUALS(new_index, 81u);
+
+        NodeMap map(mesh.GetNumAllNodes());
+        mesh.ReMesh(map);
+
+        // The deleted node is removed by retriangulating its neighbourhood, and the mesh reindexed
+        TS_ASSERT_EQUALS(map.IsDeleted(41), true);
+        TS_ASSERT_EQUALS(map.GetNewIndex(40), 40u);
+        TS_ASSERT_EQUALS(map.GetNewIndex(42), 41u);
+        TS_ASSERT_EQUALS(map.GetNewIndex(81), 80u);
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 81u);
+        TS_ASSERT_EQUALS(mesh.GetNumAllNodes(), 81u);
+        TS_ASSERT_EQUALS(mesh.GetNumElements(), 128u);
+        TS_ASSERT_EQUALS(mesh.GetNumAllElements(), 128u);
+        TS_ASSERT_EQUALS(mesh.GetNumBoundaryElements(), 32u);
+        TS_ASSERT_DELTA(mesh.GetNode(80)->rGetLocation()[0], 0.61, 1e-12);
+        TS_ASSERT_DELTA(mesh.GetNode(80)->rGetLocation()[1], 0.67, 1e-12);
+        TS_ASSERT_EQUALS(mesh.GetNode(80)->GetNumContainingElements() >= 3u, true);
+        TS_ASSERT_DELTA(mesh.GetVolume(), 1.0, 1e-12);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(1e-6), true);
+        TS_ASSERT_EQUALS(mesh.GetNumConnectivityChanges() > num_connectivity_changes, true);
+        num_connectivity_changes = mesh.GetNumConnectivityChanges();
+
+        // Moving one node only needs the edges of its own elements to be checked
+        c_vector<double,2> location = mesh.GetNode(30)->rGetLocation();
+        location[0] += 0.05;
+        location[1] += 0.02;
+        ChastePoint<2> point(location);
+        mesh.SetNode(30, point, false);
+        NodeMap moved_map(mesh.GetNumAllNodes());
+        mesh.ReMesh(moved_map);
+        TS_ASSERT_EQUALS(moved_map.IsIdentityMap(), true);
+        TS_ASSERT_EQUALS(mesh.GetNumElements(), 128u);
+        TS_ASSERT_DELTA(mesh.GetVolume(), 1.0, 1e-12);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(1e-6), true);
+        num_connectivity_changes = mesh.GetNumConnectivityChanges();
+
+        // A new node outside the mesh cannot be located by walking, so the mesh is remeshed from scratch
+        mesh.AddNode(new Node<2>(0, false, 1.5, 0.5));
+        NodeMap full_map(mesh.GetNumAllNodes());
+        mesh.ReMesh(full_map);
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 82u);
+        TS_ASSERT_EQUALS(mesh.GetNumConnectivityChanges() > num_connectivity_changes, true);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(1e-6), true);
+    }
+
     void TestReindex()
     {
         MutableMesh<2,2> mesh;
@@ -962,6 +962,54 @@ public:
             }
         }
     }
+
+    void TestRebalanceMeshSlabs()  throw (Exception)
+    {
+        std::vector<Node<1>*> nodes;
+        nodes.push_back(new Node<1>(0, true,  0.0));
+        nodes.push_back(new Node<1>(1, false, 1.0));
+        nodes.push_back(new Node<1>(2, false, 2.0));
+        nodes.push_back(new Node<1>(3, false, 3.0));
+        nodes.push_back(new Node<1>(4, false, 4.0));
+        nodes.push_back(new Node<1>(5, false, 5.0));
+        nodes.push_back(new Node<1>(6, false, 5.5));
+        nodes.push_back(new Node<1>(7, false, 11.0));
+
+        NodesOnlyMesh<1> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+        mesh.AddNodesToBoxes();
+
+        unsigned old_num_rows = mesh.mpBoxCollection->GetNumLocalRows();
+
+        // With no cost on any node the distribution is left alone
+        mesh.RebalanceMeshSlabs(0.0);
+        TS_ASSERT_EQUALS(mesh.mpBoxCollection->GetNumLocalRows(), old_num_rows);
+
+        mesh.AddNodesToBoxes();
+        mesh.RebalanceMeshSlabs();
+        unsigned new_num_rows = mesh.mpBoxCollection->GetNumLocalRows();
+        TS_ASSERT_LESS_THAN(0u, new_num_rows);
+
+        // Rows are moved between processes, never created or destroyed
+        unsigned total_old_rows;
+        unsigned total_new_rows;
+        MPI_Allreduce(&old_num_rows, &total_old_rows, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+        MPI_Allreduce(&new_num_rows, &total_new_rows, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+        TS_ASSERT_EQUALS(total_new_rows, total_old_rows);
+
+        // Every node is still owned by exactly one process
+        mesh.CalculateNodesOutsideLocalDomain();
+        unsigned num_local_nodes = mesh.GetNumNodes() - mesh.rGetNodesToSendLeft().size() - mesh.rGetNodesToSendRight().size();
+        unsigned total_nodes;
+        MPI_Allreduce(&num_local_nodes, &total_nodes, 1, MPI_UNSIGNED, MPI_SUM, PETSC_COMM_WORLD);
+        TS_ASSERT_EQUALS(total_nodes, 8u);
+
+        // Tidy up
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
 };
 
 #endif /*TESTNODESONLYMESH_HPP_*/
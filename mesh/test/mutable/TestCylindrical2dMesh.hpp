@@ -495,6 +495,88 @@ public:
         TS_ASSERT_DELTA(p_mesh->GetWidth(1u), sqrt(3.0), 1e-6);
     }
 
+    void TestIncrementalCylindricalReMesh() throw (Exception)
+    {
+        // Set up two identical meshes, the first of which is remeshed incrementally
+        CylindricalHoneycombMeshGenerator generator(6, 6, 0);
+        Cylindrical2dMesh* p_mesh = generator.GetCylindricalMesh();
+        p_mesh->SetUseIncrementalReMesh(true);
+
+        CylindricalHoneycombMeshGenerator reference_generator(6, 6, 0);
+        Cylindrical2dMesh* p_reference_mesh = reference_generator.GetCylindricalMesh();
+
+        // Move a node across the periodic boundary and add a node inside an element
+        double height = 0.5*sqrt(3.0);
+        c_vector<double,2> point;
+        point[0] = 2.0;
+        point[1] = 1.2;
+        for (unsigned i=0; i<2; i++)
+        {
+            Cylindrical2dMesh* p_this_mesh = (i==0) ? p_mesh : p_reference_mesh;
+            p_this_mesh->SetNode(6, ChastePoint<2>(-0.1, height), false);
+            p_this_mesh->AddNode(new Node<2>(p_this_mesh->GetNumNodes(), point));
+        }
+
+        // The incremental remesh does not create halo nodes, so leaves mTop alone
+        p_mesh->mTop = -100.0;
+        NodeMap map(p_mesh->GetNumNodes());
+        p_mesh->ReMesh(map);
+        TS_ASSERT_DELTA(p_mesh->mTop, -100.0, 1e-12);
+        TS_ASSERT_EQUALS(map.IsIdentityMap(), true);
+
+        NodeMap reference_map(p_reference_mesh->GetNumNodes());
+        p_reference_mesh->ReMesh(reference_map);
+
+        TS_ASSERT_EQUALS(p_mesh->GetNumNodes(), 37u);
+        TS_ASSERT_EQUALS(p_mesh->GetNumElements(), 62u);
+        TS_ASSERT_EQUALS(p_reference_mesh->GetNumElements(), 62u);
+        TS_ASSERT_DELTA(p_mesh->GetNode(6)->rGetLocation()[0], 5.9, 1e-12);
+
+        // Both meshes have the same periodic Delaunay triangulation, with the same Jacobians
+        std::set<std::set<unsigned> > elements;
+        std::set<std::set<unsigned> > reference_elements;
+        double total_determinant = 0.0;
+        double reference_total_determinant = 0.0;
+        for (unsigned i=0; i<2; i++)
+        {
+            Cylindrical2dMesh* p_this_mesh = (i==0) ? p_mesh : p_reference_mesh;
+            std::set<std::set<unsigned> >& r_elements = (i==0) ? elements : reference_elements;
+            double& r_total_determinant = (i==0) ? total_determinant : reference_total_determinant;
+
+            for (AbstractTetrahedralMesh<2,2>::ElementIterator iter = p_this_mesh->GetElementIteratorBegin();
+                 iter != p_this_mesh->GetElementIteratorEnd();
+                 ++iter)
+            {
+                std::set<unsigned> node_indices;
+                for (unsigned local_index=0; local_index<3; local_index++)
+                {
+                    node_indices.insert(iter->GetNodeGlobalIndex(local_index));
+                }
+                r_elements.insert(node_indices);
+
+                c_matrix<double, 2, 2> jacobian;
+                double determinant;
+                p_this_mesh->GetJacobianForElement(iter->GetIndex(), jacobian, determinant);
+                TS_ASSERT_LESS_THAN(0.0, determinant);
+                r_total_determinant += determinant;
+            }
+        }
+        TS_ASSERT(elements == reference_elements);
+        TS_ASSERT_DELTA(total_determinant, reference_total_determinant, 1e-10);
+
+        // Deleting a node requires the mesh to be reindexed, so the mesh is remeshed from scratch
+        p_mesh->DeleteNodePriorToReMesh(0);
+        NodeMap delete_map(p_mesh->GetNumAllNodes());
+        p_mesh->ReMesh(delete_map);
+        TS_ASSERT_DELTA(p_mesh->mTop, 5.0*height, 1e-6);
+        TS_ASSERT_EQUALS(delete_map.IsIdentityMap(), false);
+        TS_ASSERT_EQUALS(p_mesh->GetNumNodes(), 36u);
+
+        // Refreshing the Jacobians of an inverted element throws
+        p_mesh->SetNode(20, ChastePoint<2>(p_mesh->GetNode(20)->rGetLocation()[0] + 2.0, p_mesh->GetNode(20)->rGetLocation()[1]), false);
+        TS_ASSERT_THROWS_CONTAINS(p_mesh->RefreshMesh(), "Jacobian determinant is non-positive");
+    }
+
     void TestHaloNodeInsertionAndRemoval() throw (Exception)
     {
         unsigned cells_across = 5;
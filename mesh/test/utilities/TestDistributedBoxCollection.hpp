@@ -2255,6 +2255,70 @@ public:
         }
     }
 
+    void TestRebalanceSlabsFunction() throw (Exception)
+    {
+        double cut_off_length = 1.0;
+
+        c_vector<double, 2> domain_size;
+        domain_size(0) = 0.0;
+        domain_size(1) = 9.0;
+
+        if (PetscTools::IsSequential())
+        {
+            // With one process there is nothing to balance
+            DistributedBoxCollection<1> box_collection(cut_off_length, domain_size);
+            std::vector<double> local_loads(9, 10.0);
+            TS_ASSERT_EQUALS(box_collection.RebalanceSlabs(local_loads), 9);
+        }
+        else if (PetscTools::GetNumProcs() == 3)
+        {
+            // Start with 2, 2 and 5 rows on the three processes
+            int num_local_rows = PetscTools::AmTopMost() ? 5 : 2;
+            DistributedBoxCollection<1> box_collection(cut_off_length, domain_size, false, num_local_rows);
+            TS_ASSERT_EQUALS(box_collection.GetNumLocalRows(), (unsigned)num_local_rows);
+
+            // A node in the top-most row is owned by the top-most process, even on process 0
+            Node<1> node(0, false, 8.5);
+            TS_ASSERT_EQUALS(box_collection.GetProcessOwningNode(&node), 2u);
+
+            // An equal load on every row is balanced in a single step, unlike LoadBalance()
+            std::vector<double> local_loads(num_local_rows, 10.0);
+            TS_ASSERT_EQUALS(box_collection.RebalanceSlabs(local_loads), 3);
+
+            // Set up loads as:     1   1    |   1     100    |    1   1   1   1   1
+            local_loads.assign(num_local_rows, 1.0);
+            if (PetscTools::GetMyRank() == 1)
+            {
+                local_loads[1] = 100.0;
+            }
+
+            // The heavily loaded row gets a process to itself, and every process keeps at least one row
+            Warnings::QuietDestroy();
+            int new_rows = box_collection.RebalanceSlabs(local_loads);
+
+            // That row carries more than a third of the load, which the slab partition cannot share out
+            TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 1u);
+            TS_ASSERT_EQUALS(Warnings::Instance()->GetNextWarningMessage(), "A single row of boxes carries more than an equal share of the load, so the load cannot be balanced by dividing the domain into slabs.");
+            Warnings::QuietDestroy();
+            if (PetscTools::AmMaster())
+            {
+                TS_ASSERT_EQUALS(new_rows, 3);
+            }
+            else if (PetscTools::AmTopMost())
+            {
+                TS_ASSERT_EQUALS(new_rows, 5);
+            }
+            else
+            {
+                TS_ASSERT_EQUALS(new_rows, 1);
+            }
+
+            // With no load the distribution is left alone
+            local_loads.assign(num_local_rows, 0.0);
+            TS_ASSERT_EQUALS(box_collection.RebalanceSlabs(local_loads), num_local_rows);
+        }
+    }
+
     void TestGetDistributionOfNodes() throw (Exception)
     {
         double cut_off_length = 1.0;
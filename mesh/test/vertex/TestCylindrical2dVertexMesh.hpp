@@ -431,6 +431,66 @@ public:
         TS_ASSERT_DELTA(voronoi_mesh.GetVolumeOfElement(8), sqrt(3.0)/12.0, 1e-6);
     }
 
+    void TestUpdateVerticesFromDelaunayMesh() throw (Exception)
+    {
+        // Create a simple Cylindrical2dMesh, the Delaunay triangulation, and its Voronoi tessellation
+        CylindricalHoneycombMeshGenerator generator(3, 3, 0);
+        Cylindrical2dMesh* p_delaunay_mesh = generator.GetCylindricalMesh();
+        Cylindrical2dVertexMesh voronoi_mesh(*p_delaunay_mesh);
+
+        // Move a node on the periodic boundary and an interior node, without changing the triangulation
+        c_vector<double, 2> old_location = p_delaunay_mesh->GetNode(0)->rGetLocation();
+        p_delaunay_mesh->SetNode(0, ChastePoint<2>(old_location[0] - 0.05, old_location[1] + 0.02), true);
+        TS_ASSERT_DELTA(p_delaunay_mesh->GetNode(0)->rGetLocation()[0], old_location[0] - 0.05 + 3.0, 1e-12);
+        old_location = p_delaunay_mesh->GetNode(4)->rGetLocation();
+        p_delaunay_mesh->SetNode(4, ChastePoint<2>(old_location[0] + 0.05, old_location[1] + 0.02), true);
+
+        // The moves updated the Jacobians of elements straddling the periodic boundary from periodic vectors
+        std::vector<double> determinants;
+        for (unsigned i=0; i<p_delaunay_mesh->GetNumElements(); i++)
+        {
+            c_matrix<double, 2, 2> jacobian;
+            double determinant;
+            p_delaunay_mesh->GetJacobianForElement(i, jacobian, determinant);
+            determinants.push_back(determinant);
+        }
+        p_delaunay_mesh->RefreshJacobianCachedData();
+        for (unsigned i=0; i<p_delaunay_mesh->GetNumElements(); i++)
+        {
+            c_matrix<double, 2, 2> jacobian;
+            double determinant;
+            p_delaunay_mesh->GetJacobianForElement(i, jacobian, determinant);
+            TS_ASSERT_LESS_THAN(0.0, determinants[i]);
+            TS_ASSERT_DELTA(determinants[i], determinant, 1e-12);
+        }
+
+        std::vector<bool> elements_changed;
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVerticesFromDelaunayMesh(elements_changed), true);
+        TS_ASSERT_EQUALS(elements_changed.size(), 9u);
+        TS_ASSERT_EQUALS(elements_changed[0], true);
+        TS_ASSERT_EQUALS(elements_changed[4], true);
+
+        // The updated tessellation matches one generated from scratch, with all vertices on the cylinder
+        Cylindrical2dVertexMesh new_voronoi_mesh(*p_delaunay_mesh);
+        TS_ASSERT_EQUALS(voronoi_mesh.GetNumNodes(), new_voronoi_mesh.GetNumNodes());
+        for (unsigned i=0; i<voronoi_mesh.GetNumNodes(); i++)
+        {
+            c_vector<double, 2> location = voronoi_mesh.GetNode(i)->rGetLocation();
+            TS_ASSERT_LESS_THAN_EQUALS(0.0, location[0]);
+            TS_ASSERT_LESS_THAN_EQUALS(location[0], 3.0);
+            TS_ASSERT_DELTA(norm_2(voronoi_mesh.GetVectorFromAtoB(location, new_voronoi_mesh.GetNode(i)->rGetLocation())), 0.0, 1e-12);
+        }
+        for (unsigned i=0; i<voronoi_mesh.GetNumElements(); i++)
+        {
+            TS_ASSERT_DELTA(voronoi_mesh.GetVolumeOfElement(i), new_voronoi_mesh.GetVolumeOfElement(i), 1e-12);
+            TS_ASSERT_DELTA(voronoi_mesh.GetSurfaceAreaOfElement(i), new_voronoi_mesh.GetSurfaceAreaOfElement(i), 1e-12);
+        }
+
+        // Adding a node changes the topology, so the tessellation must be regenerated
+        p_delaunay_mesh->AddNode(new Node<2>(9, false, 1.5, 1.0));
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVerticesFromDelaunayMesh(elements_changed), false);
+    }
+
     void TestArchiving() throw (Exception)
     {
         FileFinder archive_dir("archive", RelativeTo::ChasteTestOutput);
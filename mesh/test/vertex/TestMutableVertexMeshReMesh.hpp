@@ -42,6 +42,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MutableVertexMesh.hpp"
 #include "FileComparison.hpp"
 #include "Warnings.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "CylindricalHoneycombVertexMeshGenerator.hpp"
+#include "RandomNumberGenerator.hpp"
 
 //This test is always run sequentially (never in parallel)
 #include "FakePetscSetup.hpp"
@@ -2816,6 +2819,88 @@ public:
         TS_ASSERT_DELTA(vertex_mesh.GetSurfaceAreaOfElement(2), 2.7294, 1e-4);
         TS_ASSERT_DELTA(vertex_mesh.GetSurfaceAreaOfElement(3), 2.3062, 1e-4);
     }
+
+    void TestIntersectionBoxes() throw(Exception)
+    {
+        // Create a honeycomb mesh and jiggle its nodes
+        HoneycombVertexMeshGenerator generator(6, 6);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            c_vector<double, 2>& r_location = p_mesh->GetNode(node_index)->rGetModifiableLocation();
+            r_location[0] += 0.2*(p_gen->ranf() - 0.5);
+            r_location[1] += 0.2*(p_gen->ranf() - 0.5);
+        }
+
+        std::vector<unsigned> element_indices;
+        for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+        {
+            element_indices.push_back(elem_index);
+        }
+        p_mesh->SetUpIntersectionBoxes(element_indices);
+
+        // No element straddles a periodic boundary
+        TS_ASSERT_EQUALS(p_mesh->mUnboxedIntersectionElements.size(), 0u);
+        TS_ASSERT_LESS_THAN(1u, p_mesh->mIntersectionBoxes.size());
+
+        // Every element that includes a node or element centroid must be a candidate, and candidates are in ascending order
+        std::vector<c_vector<double, 2> > test_points;
+        for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+        {
+            test_points.push_back(p_mesh->GetNode(node_index)->rGetLocation());
+        }
+        for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+        {
+            test_points.push_back(p_mesh->GetCentroidOfElement(elem_index));
+        }
+
+        unsigned num_inclusions = 0;
+        for (unsigned i=0; i<test_points.size(); i++)
+        {
+            std::vector<unsigned> candidates;
+            p_mesh->GetCandidateIntersectionElements(test_points[i], candidates);
+            TS_ASSERT_LESS_THAN(candidates.size(), element_indices.size());
+
+            for (unsigned j=1; j<candidates.size(); j++)
+            {
+                TS_ASSERT_LESS_THAN(candidates[j-1], candidates[j]);
+            }
+
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                if (p_mesh->ElementIncludesPoint(test_points[i], elem_index))
+                {
+                    TS_ASSERT(std::find(candidates.begin(), candidates.end(), elem_index) != candidates.end());
+                    num_inclusions++;
+                }
+            }
+        }
+        TS_ASSERT_LESS_THAN_EQUALS(p_mesh->GetNumElements(), num_inclusions);
+
+        // On a cylindrical mesh, elements straddling the periodic boundary are candidates for every point
+        CylindricalHoneycombVertexMeshGenerator cylindrical_generator(4, 4);
+        MutableVertexMesh<2,2>* p_cylindrical_mesh = cylindrical_generator.GetCylindricalMesh();
+
+        element_indices.clear();
+        for (unsigned elem_index=0; elem_index<p_cylindrical_mesh->GetNumElements(); elem_index++)
+        {
+            element_indices.push_back(elem_index);
+        }
+        p_cylindrical_mesh->SetUpIntersectionBoxes(element_indices);
+        TS_ASSERT_LESS_THAN(0u, p_cylindrical_mesh->mUnboxedIntersectionElements.size());
+
+        for (unsigned elem_index=0; elem_index<p_cylindrical_mesh->GetNumElements(); elem_index++)
+        {
+            c_vector<double, 2> centroid = p_cylindrical_mesh->GetCentroidOfElement(elem_index);
+            TS_ASSERT(p_cylindrical_mesh->ElementIncludesPoint(centroid, elem_index));
+
+            std::vector<unsigned> candidates;
+            p_cylindrical_mesh->GetCandidateIntersectionElements(centroid, candidates);
+            TS_ASSERT(std::find(candidates.begin(), candidates.end(), elem_index) != candidates.end());
+        }
+    }
 };
 
 #endif /*TESTMUTABLEVERTEXMESHREMESH_HPP_*/
@@ -1351,6 +1351,78 @@ public:
         TS_ASSERT_DELTA(element_perimeter_gradient[1], 1.0, 1e-6);
     }
 
+    void TestElementGeometryCache()
+    {
+        // Create a mesh comprising a square element and a triangular element sharing an edge
+        std::vector<Node<2>*> nodes;
+        nodes.push_back(new Node<2>(0, false, 0.0, 0.0));
+        nodes.push_back(new Node<2>(1, false, 1.0, 0.0));
+        nodes.push_back(new Node<2>(2, false, 1.0, 1.0));
+        nodes.push_back(new Node<2>(3, false, 0.0, 1.0));
+        nodes.push_back(new Node<2>(4, false, 1.5, 0.3));
+
+        std::vector<Node<2>*> nodes_elem_0, nodes_elem_1;
+        nodes_elem_0.push_back(nodes[0]);
+        nodes_elem_0.push_back(nodes[1]);
+        nodes_elem_0.push_back(nodes[2]);
+        nodes_elem_0.push_back(nodes[3]);
+        nodes_elem_1.push_back(nodes[1]);
+        nodes_elem_1.push_back(nodes[4]);
+        nodes_elem_1.push_back(nodes[2]);
+
+        std::vector<VertexElement<2,2>*> elements;
+        elements.push_back(new VertexElement<2,2>(0, nodes_elem_0));
+        elements.push_back(new VertexElement<2,2>(1, nodes_elem_1));
+
+        VertexMesh<2,2> mesh(nodes, elements);
+
+        // The cache is not valid until it has been computed
+        TS_ASSERT_EQUALS(mesh.IsElementGeometryCacheValid(), false);
+        mesh.UpdateElementGeometryCache();
+        TS_ASSERT_EQUALS(mesh.IsElementGeometryCacheValid(), true);
+
+        // Test that the cached quantities are identical to those computed directly
+        for (unsigned elem_index=0; elem_index<mesh.GetNumElements(); elem_index++)
+        {
+            VertexElement<2,2>* p_element = mesh.GetElement(elem_index);
+
+            TS_ASSERT_EQUALS(mesh.GetCachedVolumeOfElement(elem_index), mesh.GetVolumeOfElement(elem_index));
+            TS_ASSERT_EQUALS(mesh.GetCachedSurfaceAreaOfElement(elem_index), mesh.GetSurfaceAreaOfElement(elem_index));
+
+            c_vector<double, 2> centroid = mesh.GetCentroidOfElement(elem_index);
+            TS_ASSERT_EQUALS(mesh.rGetCachedCentroidOfElement(elem_index)[0], centroid[0]);
+            TS_ASSERT_EQUALS(mesh.rGetCachedCentroidOfElement(elem_index)[1], centroid[1]);
+
+            for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+            {
+                c_vector<double, 2> area_gradient = mesh.GetAreaGradientOfElementAtNode(p_element, local_index);
+                TS_ASSERT_EQUALS(mesh.rGetCachedAreaGradientOfElementAtNode(elem_index, local_index)[0], area_gradient[0]);
+                TS_ASSERT_EQUALS(mesh.rGetCachedAreaGradientOfElementAtNode(elem_index, local_index)[1], area_gradient[1]);
+
+                c_vector<double, 2> next_edge_gradient = mesh.GetNextEdgeGradientOfElementAtNode(p_element, local_index);
+                TS_ASSERT_EQUALS(mesh.rGetCachedNextEdgeGradientOfElementAtNode(elem_index, local_index)[0], next_edge_gradient[0]);
+                TS_ASSERT_EQUALS(mesh.rGetCachedNextEdgeGradientOfElementAtNode(elem_index, local_index)[1], next_edge_gradient[1]);
+
+                unsigned next_local_index = (local_index+1)%p_element->GetNumNodes();
+                c_vector<double, 2> edge_vector = p_element->GetNodeLocation(next_local_index) - p_element->GetNodeLocation(local_index);
+                TS_ASSERT_DELTA(mesh.rGetCachedEdgeVectorOfElement(elem_index, local_index)[0], edge_vector[0], 1e-12);
+                TS_ASSERT_DELTA(mesh.rGetCachedEdgeVectorOfElement(elem_index, local_index)[1], edge_vector[1], 1e-12);
+            }
+        }
+
+        // Test a couple of values explicitly
+        TS_ASSERT_DELTA(mesh.GetCachedVolumeOfElement(0), 1.0, 1e-12);
+        TS_ASSERT_DELTA(mesh.GetCachedSurfaceAreaOfElement(0), 4.0, 1e-12);
+        TS_ASSERT_DELTA(mesh.GetCachedVolumeOfElement(1), 0.25, 1e-12);
+
+        // Test that the cache can be invalidated, for example by Clear()
+        mesh.InvalidateElementGeometryCache();
+        TS_ASSERT_EQUALS(mesh.IsElementGeometryCacheValid(), false);
+        mesh.UpdateElementGeometryCache();
+        mesh.Clear();
+        TS_ASSERT_EQUALS(mesh.IsElementGeometryCacheValid(), false);
+    }
+
     void TestMeshGetWidthAndBoundingBoxMethod()
     {
         // Test method with a regular mesh with hexagonal elements of edge length 1/sqrt(3.0)
@@ -1980,6 +2052,105 @@ public:
         TS_ASSERT_DELTA(voronoi_mesh.GetVolumeOfElement(4), 0.5, 1e-6);
     }
 
+    void TestUpdateVerticesFromDelaunayMesh() throw (Exception)
+    {
+        // Create the same Delaunay triangulation as in the previous test
+        std::vector<Node<2> *> delaunay_nodes;
+        delaunay_nodes.push_back(new Node<2>(0, true, 0.0, 0.0));
+        delaunay_nodes.push_back(new Node<2>(1, true, 1.0, 0.0));
+        delaunay_nodes.push_back(new Node<2>(2, true, 1.0, 1.0));
+        delaunay_nodes.push_back(new Node<2>(3, true, 0.0, 1.0));
+        delaunay_nodes.push_back(new Node<2>(4, false, 0.5, 0.5));
+        MutableMesh<2,2> delaunay_mesh(delaunay_nodes);
+
+        VertexMesh<2,2> voronoi_mesh(delaunay_mesh);
+
+        // If no node has moved, no element is changed
+        std::vector<bool> elements_changed(5, false);
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVerticesFromDelaunayMesh(elements_changed), true);
+        for (unsigned i=0; i<5; i++)
+        {
+            TS_ASSERT_EQUALS(elements_changed[i], false);
+        }
+
+        // Move a corner node; only the Voronoi vertices of the Delaunay elements containing it move
+        delaunay_mesh.SetNode(1, ChastePoint<2>(1.1, 0.0));
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVerticesFromDelaunayMesh(elements_changed), true);
+        TS_ASSERT_EQUALS(elements_changed[0], true);
+        TS_ASSERT_EQUALS(elements_changed[1], true);
+        TS_ASSERT_EQUALS(elements_changed[2], true);
+        TS_ASSERT_EQUALS(elements_changed[3], false);
+        TS_ASSERT_EQUALS(elements_changed[4], true);
+
+        // The updated tessellation matches one generated from scratch
+        {
+            VertexMesh<2,2> new_voronoi_mesh(delaunay_mesh);
+            for (unsigned i=0; i<4; i++)
+            {
+                TS_ASSERT_DELTA(voronoi_mesh.GetNode(i)->rGetLocation()[0], new_voronoi_mesh.GetNode(i)->rGetLocation()[0], 1e-12);
+                TS_ASSERT_DELTA(voronoi_mesh.GetNode(i)->rGetLocation()[1], new_voronoi_mesh.GetNode(i)->rGetLocation()[1], 1e-12);
+            }
+            TS_ASSERT_DELTA(voronoi_mesh.GetVolumeOfElement(4), new_voronoi_mesh.GetVolumeOfElement(4), 1e-12);
+            TS_ASSERT_DELTA(voronoi_mesh.GetSurfaceAreaOfElement(4), new_voronoi_mesh.GetSurfaceAreaOfElement(4), 1e-12);
+        }
+
+        // Distort the triangulation so that two vertices of the central element swap order
+        delaunay_mesh.SetNode(1, ChastePoint<2>(1.0, 0.4));
+        delaunay_mesh.SetNode(2, ChastePoint<2>(1.4, 0.6));
+        delaunay_mesh.SetNode(3, ChastePoint<2>(0.4, 1.2));
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVerticesFromDelaunayMesh(elements_changed), true);
+        {
+            VertexMesh<2,2> new_voronoi_mesh(delaunay_mesh);
+            TS_ASSERT_EQUALS(voronoi_mesh.GetElement(4)->GetNumNodes(), 4u);
+            for (unsigned i=0; i<4; i++)
+            {
+                TS_ASSERT_EQUALS(voronoi_mesh.GetElement(4)->GetNodeGlobalIndex(i), new_voronoi_mesh.GetElement(4)->GetNodeGlobalIndex(i));
+            }
+            TS_ASSERT_DELTA(voronoi_mesh.GetVolumeOfElement(4), new_voronoi_mesh.GetVolumeOfElement(4), 1e-12);
+        }
+
+        // Adding a node changes the topology of the Delaunay mesh, so the tessellation must be regenerated
+        delaunay_mesh.AddNode(new Node<2>(5, false, 0.5, 0.9));
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVerticesFromDelaunayMesh(elements_changed), false);
+
+        // A vertex mesh that is not a tessellation cannot be updated either
+        std::vector<Node<2>*> nodes;
+        nodes.push_back(new Node<2>(0, false, 0.0, 0.0));
+        nodes.push_back(new Node<2>(1, false, 1.0, 0.0));
+        nodes.push_back(new Node<2>(2, false, 0.0, 1.0));
+        std::vector<VertexElement<2,2>*> elements;
+        elements.push_back(new VertexElement<2,2>(0, nodes));
+        VertexMesh<2,2> vertex_mesh(nodes, elements);
+        TS_ASSERT_EQUALS(vertex_mesh.UpdateVerticesFromDelaunayMesh(elements_changed), false);
+    }
+
+    void TestUpdateVerticesFromDelaunayMeshAfterEdgeFlip() throw (Exception)
+    {
+        // Create a quadrilateral whose Delaunay triangulation uses the diagonal between nodes 1 and 3
+        std::vector<Node<2> *> delaunay_nodes;
+        delaunay_nodes.push_back(new Node<2>(0, true, -0.5, -0.5));
+        delaunay_nodes.push_back(new Node<2>(1, true, 1.0, 0.0));
+        delaunay_nodes.push_back(new Node<2>(2, true, 1.0, 1.0));
+        delaunay_nodes.push_back(new Node<2>(3, true, 0.0, 1.0));
+        MutableMesh<2,2> delaunay_mesh(delaunay_nodes);
+        TS_ASSERT_EQUALS(delaunay_mesh.GetNumElements(), 2u);
+
+        VertexMesh<2,2> voronoi_mesh(delaunay_mesh);
+
+        // Moving node 0 inside the circumcircle of the other three nodes flips the diagonal
+        delaunay_mesh.SetNode(0, ChastePoint<2>(0.4, 0.4));
+        delaunay_mesh.ReMesh();
+        TS_ASSERT_EQUALS(delaunay_mesh.GetNumElements(), 2u);
+        TS_ASSERT_EQUALS(delaunay_mesh.GetNumNodes(), 4u);
+
+        std::vector<bool> elements_changed;
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVerticesFromDelaunayMesh(elements_changed), false);
+
+        // Only 2D tessellations are updated in place
+        VertexMesh<3,3> vertex_mesh_3d;
+        TS_ASSERT_EQUALS(vertex_mesh_3d.UpdateVerticesFromDelaunayMesh(elements_changed), false);
+    }
+
     void TestGetEdgeLengthWithSimpleMesh() throw (Exception)
     {
         // Create a simple 2D tetrahedral mesh, the Delaunay triangulation
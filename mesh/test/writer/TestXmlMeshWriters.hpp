@@ -43,6 +43,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "OutputFileHandler.hpp"
 #include "TetrahedralMesh.hpp"
 #include "VtkMeshWriter.hpp"
+#include "AsynchronousVtkWriter.hpp"
+#include "VtkGridData.hpp"
 #include "XdmfMeshWriter.hpp"
 #include "DistributedTetrahedralMesh.hpp"
 #include "MixedDimensionMesh.hpp"
@@ -637,6 +639,122 @@ public:
 #endif //CHASTE_VTK
     }
 
+    void TestVtkGridData() throw(Exception)
+    {
+#ifdef CHASTE_VTK
+        // Two triangles sharing an edge
+        VtkGridData grid_data;
+        grid_data.AddPoint(0.0, 0.0, 0.0);
+        grid_data.AddPoint(1.0, 0.0, 0.0);
+        grid_data.AddPoint(0.0, 1.0, 0.0);
+        grid_data.AddPoint(1.0, 1.0, 0.0);
+
+        std::vector<unsigned> point_indices(3);
+        point_indices[0] = 0;
+        point_indices[1] = 1;
+        point_indices[2] = 2;
+        grid_data.AddCell(VTK_TRIANGLE, point_indices);
+        point_indices[0] = 3;
+        grid_data.AddCell(VTK_TRIANGLE, point_indices);
+
+        TS_ASSERT_EQUALS(grid_data.GetNumPoints(), 4u);
+        TS_ASSERT_EQUALS(grid_data.GetNumCells(), 2u);
+
+        grid_data.rAddPointData("Height").assign(4, 0.0);
+        grid_data.rAddCellData("Area").assign(2, 0.5);
+        std::vector<double>& r_normals = grid_data.rAddCellData("Normal", 3);
+        r_normals.assign(6, 0.0);
+        r_normals[2] = r_normals[5] = 1.0;
+
+        // Padding appends a whole tuple of zeros to each cell data array
+        grid_data.PadCellData(1);
+        TS_ASSERT_EQUALS(grid_data.rGetCellData().size(), 2u);
+        TS_ASSERT_EQUALS(grid_data.rGetCellData()[0].mValues.size(), 3u);
+        TS_ASSERT_EQUALS(grid_data.rGetCellData()[1].mNumComponents, 3u);
+        TS_ASSERT_EQUALS(grid_data.rGetCellData()[1].mValues.size(), 9u);
+        TS_ASSERT_DELTA(grid_data.rGetCellData()[1].mValues[8], 0.0, 1e-12);
+
+        vtkUnstructuredGrid* p_grid = grid_data.MakeVtkGrid();
+        TS_ASSERT_EQUALS(p_grid->GetNumberOfPoints(), 4);
+        TS_ASSERT_EQUALS(p_grid->GetNumberOfCells(), 2);
+        TS_ASSERT_EQUALS(p_grid->GetCellType(1), VTK_TRIANGLE);
+        TS_ASSERT_EQUALS(p_grid->GetCell(1)->GetPointId(0), 3);
+        TS_ASSERT_DELTA(p_grid->GetPoint(3)[1], 1.0, 1e-12);
+        TS_ASSERT_EQUALS(p_grid->GetCellData()->GetNumberOfArrays(), 2);
+        TS_ASSERT_EQUALS(p_grid->GetCellData()->GetArray("Normal")->GetNumberOfComponents(), 3);
+        TS_ASSERT_DELTA(p_grid->GetCellData()->GetArray("Normal")->GetComponent(1, 2), 1.0, 1e-12);
+        p_grid->Delete(); // Reference counted
+#endif //CHASTE_VTK
+    }
+
+    void TestAsynchronousVtkMeshWriter() throw(Exception)
+    {
+#ifdef CHASTE_VTK
+        EXIT_IF_PARALLEL; // Only the master process writes a sequential mesh
+
+        TrianglesMeshReader<3,3> reader("mesh/test/data/cube_2mm_12_elements");
+        TetrahedralMesh<3,3> mesh;
+        mesh.ConstructFromMeshReader(reader);
+
+        std::vector<double> distance;
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            distance.push_back(norm_2(mesh.GetNode(i)->rGetLocation()));
+        }
+
+        AsynchronousVtkWriter* p_async_writer = AsynchronousVtkWriter::Instance();
+        TS_ASSERT_EQUALS(p_async_writer->GetMaxQueueDepth(), 4u);
+        TS_ASSERT_EQUALS(p_async_writer->GetUseCompression(), true);
+        p_async_writer->SetMaxQueueDepth(2);
+        TS_ASSERT_EQUALS(p_async_writer->GetMaxQueueDepth(), 2u);
+
+        // Queue more snapshots than the queue can hold; the writers can be destroyed straight away
+        OutputFileHandler handler("TestAsynchronousVtkMeshWriter");
+        for (unsigned i=0; i<5; i++)
+        {
+            std::stringstream base_name;
+            base_name << "cube_" << i;
+            VtkMeshWriter<3,3> writer("TestAsynchronousVtkMeshWriter", base_name.str(), false);
+            writer.SetWriteAsynchronously(true);
+            writer.AddPointData("Distance from origin", distance);
+            writer.WriteFilesUsingMesh(mesh);
+        }
+        p_async_writer->Flush();
+        TS_ASSERT_EQUALS(p_async_writer->GetNumFilesWritten(), 5u);
+
+        // With no queue the file is written before WriteFilesUsingMesh() returns
+        p_async_writer->SetMaxQueueDepth(0);
+        {
+            VtkMeshWriter<3,3> writer("TestAsynchronousVtkMeshWriter", "cube_5", false);
+            writer.SetWriteAsynchronously(true);
+            writer.AddPointData("Distance from origin", distance);
+            writer.WriteFilesUsingMesh(mesh);
+        }
+        TS_ASSERT_EQUALS(p_async_writer->GetNumFilesWritten(), 6u);
+        AsynchronousVtkWriter::Destroy();
+
+        for (unsigned i=0; i<6; i++)
+        {
+            std::stringstream file_name;
+            file_name << handler.GetOutputDirectoryFullPath() << "cube_" << i << ".vtu";
+            VtkMeshReader<3,3> vtk_reader(file_name.str());
+            TS_ASSERT_EQUALS(vtk_reader.GetNumNodes(), mesh.GetNumNodes());
+            TS_ASSERT_EQUALS(vtk_reader.GetNumElements(), mesh.GetNumElements());
+
+            std::vector<double> distance_read;
+            vtk_reader.GetPointData("Distance from origin", distance_read);
+            TS_ASSERT_EQUALS(distance_read.size(), distance.size());
+            for (unsigned j=0; j<distance_read.size(); j++)
+            {
+                TS_ASSERT_EQUALS(distance[j], distance_read[j]);
+            }
+        }
+#else
+        std::cout << "This test was not run, as VTK is not enabled." << std::endl;
+        std::cout << "If required please install and alter your hostconfig settings to switch on chaste support." << std::endl;
+#endif //CHASTE_VTK
+    }
+
     void TestVtkMeshWriterForCables() throw(Exception)
     {
 #ifdef CHASTE_VTK
@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef _ODESYSTEMINFORMATION_HPP_
 #define _ODESYSTEMINFORMATION_HPP_
 
+#include <pthread.h>
 #include <boost/shared_ptr.hpp>
 #include "AbstractOdeSystemInformation.hpp"
 
@@ -113,12 +114,17 @@ public:
 template<class ODE_SYSTEM>
 boost::shared_ptr<OdeSystemInformation<ODE_SYSTEM> > OdeSystemInformation<ODE_SYSTEM>::Instance()
 {
+    // The instance is only read once initialised, but may be requested from several threads at once
+    static pthread_mutex_t instance_mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_mutex_lock(&instance_mutex);
     if (!mpInstance)
     {
         mpInstance.reset(new OdeSystemInformation<ODE_SYSTEM>);
         mpInstance->Initialise();
     }
-    return mpInstance;
+    boost::shared_ptr<OdeSystemInformation<ODE_SYSTEM> > p_instance = mpInstance;
+    pthread_mutex_unlock(&instance_mutex);
+    return p_instance;
 }
 
 template<class ODE_SYSTEM>
@@ -0,0 +1,130 @@
+#!/usr/bin/python
+
+"""Copyright (c) 2005-2016, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+"""
+
+"""
+Compare the results of the cell-based benchmark suite (TestCellBasedBenchmarks)
+against a stored baseline.
+
+Usage:
+    CompareCellBasedBenchmarks.py <results.csv> <baseline.csv> [--tolerance 0.1] [--update]
+
+Each benchmark present in both files is reported with its throughput (cell steps
+per second) and peak memory. A benchmark whose throughput falls, or whose peak
+memory rises, by more than the given fractional tolerance is flagged as a
+regression, and the script exits with status 1 if there are any regressions.
+
+Peak memory is only compared when both files record it for each benchmark alone
+(peak_memory_scope is "benchmark"); a peak over the life of the process also
+includes earlier benchmarks, so is shown but never flagged.
+
+Baselines are specific to the machine they were recorded on; use --update to
+store the current results as the new baseline.
+"""
+
+import csv
+import optparse
+import shutil
+import sys
+
+
+def ReadResults(filename):
+    """Read a benchmark results file into a dictionary keyed by benchmark name.
+
+    If a benchmark appears more than once, the last row is used.
+    """
+    results = {}
+    with open(filename) as results_file:
+        for row in csv.DictReader(results_file):
+            results[row['name']] = row
+    return results
+
+
+def IsPerBenchmarkMemory(row):
+    """Return whether the peak memory of a results row covers that benchmark alone."""
+    return row.get('peak_memory_scope') == 'benchmark'
+
+
+def Compare(results, baseline, tolerance):
+    """Print a comparison of two sets of results and return the number of regressions."""
+    num_regressions = 0
+    print('%-28s %14s %14s %8s %10s %10s' % ('name', 'cell steps/s', 'baseline', 'change',
+                                             'memory/Mb', 'baseline'))
+    for name in sorted(results):
+        if name not in baseline:
+            print('%-28s %14.1f %14s' % (name, float(results[name]['cell_steps_per_second']), 'new'))
+            continue
+        throughput = float(results[name]['cell_steps_per_second'])
+        base_throughput = float(baseline[name]['cell_steps_per_second'])
+        memory = float(results[name]['peak_memory_mb'])
+        base_memory = float(baseline[name]['peak_memory_mb'])
+
+        change = 0.0
+        if base_throughput > 0.0:
+            change = (throughput - base_throughput)/base_throughput
+        compare_memory = IsPerBenchmarkMemory(results[name]) and IsPerBenchmarkMemory(baseline[name])
+        regression = (change < -tolerance) or (compare_memory and memory > base_memory*(1.0 + tolerance))
+        if regression:
+            num_regressions += 1
+        note = ''
+        if regression:
+            note = '  REGRESSION'
+        elif not compare_memory:
+            note = '  (process-wide memory peak, not compared)'
+        print('%-28s %14.1f %14.1f %+7.1f%% %10.1f %10.1f%s' % (name, throughput, base_throughput, 100.0*change,
+                                                               memory, base_memory, note))
+    for name in sorted(baseline):
+        if name not in results:
+            print('%-28s %14s' % (name, 'missing'))
+    return num_regressions
+
+
+if __name__ == '__main__':
+    parser = optparse.OptionParser(usage='%prog [options] <results.csv> <baseline.csv>')
+    parser.add_option('--tolerance', type='float', default=0.1,
+                      help='fractional change in throughput or memory treated as a regression [default: %default]')
+    parser.add_option('--update', action='store_true', default=False,
+                      help='copy the results over the baseline instead of comparing them')
+    options, args = parser.parse_args()
+    if len(args) != 2:
+        parser.error('expected a results file and a baseline file')
+
+    if options.update:
+        shutil.copyfile(args[0], args[1])
+        print('Stored %s as baseline %s' % (args[0], args[1]))
+        sys.exit(0)
+
+    num_regressions = Compare(ReadResults(args[0]), ReadResults(args[1]), options.tolerance)
+    if num_regressions > 0:
+        print('%d benchmark(s) regressed by more than %g%%' % (num_regressions, 100.0*options.tolerance))
+        sys.exit(1)